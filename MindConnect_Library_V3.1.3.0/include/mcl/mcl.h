@@ -19,5 +19,6 @@
 
 #include "mcl/mcl_log_util.h"
 #include "mcl/mcl_communication.h"
+#include "mcl/mcl_memory.h"
 
 #endif //MCL_H_
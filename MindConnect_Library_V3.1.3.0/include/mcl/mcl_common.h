@@ -218,6 +218,9 @@ extern "C"
         MCL_ARRAY_IS_EMPTY,                           //!< There is no element in the array.
         MCL_PARTIALLY_WRITTEN,                        //!< Part of the data in store is written to the http request. There is still data left needs to be written.
         MCL_HTTP_REQUEST_FINALIZE_FAILED,             //!< Adding final closing boundary and Authentication header is failed.
+
+        // Error codes added in later releases, appended to keep the values of the codes above unchanged.
+        MCL_EXCHANGE_ASYNC_IS_ACTIVE,                 //!< Asynchronous exchange operations are in flight, a synchronous exchange can not be performed meanwhile.
         MCL_ERROR_CODE_END                            //!< End of error codes.
         //Do NOT add new error codes after MCL_ERROR_CODE_END!!!
     } E_MCL_ERROR_CODE;
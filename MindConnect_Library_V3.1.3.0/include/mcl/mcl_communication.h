@@ -30,6 +30,15 @@ extern "C"
      */
     typedef struct mcl_communication_t mcl_communication_t;
 
+    /**
+     * Callback function prototype called when an exchange operation started by #mcl_communication_exchange_async is completed.
+     *
+     * @param [in] code Result of the exchange operation. See #mcl_communication_exchange for possible values.
+     * @param [in] store The store given to #mcl_communication_exchange_async. Data which is successfully exchanged is removed from the store.
+     * @param [in] user_context User context given to #mcl_communication_exchange_async.
+     */
+    typedef void (*mcl_communication_exchange_callback_t)(E_MCL_ERROR_CODE code, mcl_store_t *store, void *user_context);
+
     /**
      * This function creates and initializes an object of type #mcl_communication_t
      * according to the configuration parameters passed in as an argument.
@@ -62,6 +71,9 @@ extern "C"
     /**
      * This function destroys the @c mcl_communication_t object and frees any memory allocated.
      *
+     * Callbacks of the exchange operations started by #mcl_communication_exchange_async and not completed yet are called with #MCL_FAIL.
+     * @p communication can not be used from these callbacks, calling this function again from them has no effect.
+     *
      * @param [in] communication Preinitialized @c mcl_communication_t object to destroy.
      * @return
      * <ul>
@@ -103,6 +115,9 @@ extern "C"
      * authentication key acquired earlier. Key rotation can be applied only when there is an authentication key available. Onboarding key
      * is not necessary for key rotation.
      *
+     * For #MCL_SECURITY_RSA_3072 security profile, the key pair generated by #mcl_communication_generate_next_key is used if there is one,
+     * otherwise a new key pair is generated within this function.
+     *
      * @param [in] communication @c mcl_communication_t object which is initialized and onboarded to MindSphere.
      * @return
      * <ul>
@@ -122,11 +137,35 @@ extern "C"
      * <li>#MCL_NETWORK_RECEIVE_FAIL in case of an error in receiving data from the network.</li>
      * <li>#MCL_UNAUTHORIZED if response status code of server is related to authorization.</li>
      * <li>#MCL_SERVER_FAIL if the server returns 500 response status code.</li>
+     * <li>#MCL_EXCHANGE_ASYNC_IS_ACTIVE if exchange operations started by #mcl_communication_exchange_async are not completed yet.</li>
      * <li>#MCL_FAIL in case of an internal error in MCL.</li>
      * </ul>
      */
     extern MCL_EXPORT E_MCL_ERROR_CODE mcl_communication_rotate_key(mcl_communication_t *communication);
 
+    /**
+     * This function generates the RSA key pair to be used by the next key rotation, so that #mcl_communication_rotate_key
+     * does not have to generate it. It is meant to be called from a worker thread of the agent since generating a 3072 bit key takes long.
+     *
+     * The critical section is entered only when the generated key pair is handed over to @p communication, other operations are not blocked during key generation.
+     * If this function is called concurrently with other functions using @p communication,
+     * critical section callbacks must be given in the configuration. The key pair is kept in memory only,
+     * it is not saved via the custom save function or to the registration information file until it is used by a key rotation.
+     * A key pair generated before replaces the previous one if it is not used yet.
+     *
+     * @param [in] communication @c mcl_communication_t object which is initialized with #MCL_SECURITY_RSA_3072 security profile.
+     * @return
+     * <ul>
+     * <li>#MCL_OK in case of success.</li>
+     * <li>#MCL_TRIGGERED_WITH_NULL if provided @p communication is NULL.</li>
+     * <li>#MCL_NOT_INITIALIZED if @p communication is not initialized.</li>
+     * <li>#MCL_OPERATION_IS_NOT_SUPPORTED if security profile of @p communication is not #MCL_SECURITY_RSA_3072.</li>
+     * <li>#MCL_OUT_OF_MEMORY if there is not enough memory in the system to proceed.</li>
+     * <li>#MCL_FAIL in case of an internal error in MCL.</li>
+     * </ul>
+     */
+    extern MCL_EXPORT E_MCL_ERROR_CODE mcl_communication_generate_next_key(mcl_communication_t *communication);
+
     /**
      * This function is used by the agent which is already onboarded to update security information.
      *
@@ -135,6 +174,7 @@ extern "C"
      * <ul>
      * <li>#MCL_OK in case of successful update.</li>
      * <li>#MCL_SECURITY_UP_TO_DATE if security information of the mcl_communication is already up to date.
+     * <li>#MCL_EXCHANGE_ASYNC_IS_ACTIVE if exchange operations started by #mcl_communication_exchange_async are not completed yet.</li>
      * <li>#MCL_FAIL in case of an internal error in MCL.</li>
      * </ul>
      */
@@ -168,6 +208,7 @@ extern "C"
      * <li>#MCL_BAD_REQUEST if response status code of server is 400.</li>
      * <li>#MCL_UNAUTHORIZED if response status code of server is 401.</li>
      * <li>#MCL_SERVER_FAIL if response status code of server is 500.</li>
+     * <li>#MCL_EXCHANGE_ASYNC_IS_ACTIVE if exchange operations started by #mcl_communication_exchange_async are not completed yet.</li>
      * <li>#MCL_FAIL in case of an internal error in MCL.</li>
      * </ul>
      */
@@ -188,6 +229,7 @@ extern "C"
      * <li>#MCL_NOT_ONBOARDED if the agent is not onboarded using @p communication.</li>
      * <li>#MCL_NO_ACCESS_TOKEN_EXISTS if @p communication does not have an access token.</li>
      * <li>#MCL_STORE_IS_EMPTY if @p store has no data.
+     * <li>#MCL_EXCHANGE_ASYNC_IS_ACTIVE if exchange operations started by #mcl_communication_exchange_async are not completed yet.</li>
      * <li>#MCL_COULD_NOT_RESOLVE_PROXY in case the proxy host name can not be resolved.</li>
      * <li>#MCL_COULD_NOT_RESOLVE_HOST in case the remote host name can not be resolved.</li>
      * <li>#MCL_SSL_HANDSHAKE_FAIL in case a problem occurs during SSL handshake.</li>
@@ -204,9 +246,63 @@ extern "C"
      */
     extern MCL_EXPORT E_MCL_ERROR_CODE mcl_communication_exchange(mcl_communication_t *communication, mcl_store_t *store, void **reserved);
 
+    /**
+     * This function starts exchanging data in @p store to MindSphere without blocking the calling thread.
+     *
+     * The exchange operation is progressed by #mcl_communication_poll which must be called periodically.
+     * @p callback is called from within #mcl_communication_poll when all data in @p store is exchanged or an error occurs.
+     * Several exchange operations with different stores can be in flight at the same time.
+     * @p store must not be modified or destroyed until @p callback is called.
+     * Streamable stores are not supported, use #mcl_communication_exchange for them.
+     * Other blocking functions sending requests with @p communication (#mcl_communication_exchange, #mcl_communication_process, #mcl_communication_get_access_token,
+     * #mcl_communication_rotate_key and #mcl_communication_update_security_information) return #MCL_EXCHANGE_ASYNC_IS_ACTIVE until callbacks of all exchange operations are called.
+     * If the access token is rejected, it is renewed once and the data left in @p store is exchanged again, as in #mcl_communication_process.
+     * The access token is not renewed while other exchange operations are in flight, @p callback is called with #MCL_UNAUTHORIZED then.
+     * Renewing the access token blocks the call to #mcl_communication_poll until the new access token is received.
+     *
+     * @param [in] communication Preinitialized @c mcl_communication_t object through which a connection is established to MindSphere.
+     * @param [in] store Container for the data to be uploaded to MindSphere.
+     * @param [in] callback Callback function to be called when the exchange operation is completed.
+     * @param [in] user_context User context passed to @p callback.
+     * @return
+     * <ul>
+     * <li>#MCL_OK in case the exchange operation is started.</li>
+     * <li>#MCL_TRIGGERED_WITH_NULL in case @p communication, @p store or @p callback is NULL.</li>
+     * <li>#MCL_OUT_OF_MEMORY in case there is not enough memory in the system to proceed.</li>
+     * <li>#MCL_NOT_INITIALIZED in case @p communication is not initialized.</li>
+     * <li>#MCL_NOT_ONBOARDED if the agent is not onboarded using @p communication.</li>
+     * <li>#MCL_NO_ACCESS_TOKEN_EXISTS if @p communication does not have an access token.</li>
+     * <li>#MCL_STORE_IS_EMPTY if @p store has no data.
+     * <li>#MCL_OPERATION_IS_NOT_SUPPORTED if @p store is streamable.</li>
+     * <li>#MCL_FAIL in case of an internal error in MCL.</li>
+     * </ul>
+     */
+    extern MCL_EXPORT E_MCL_ERROR_CODE mcl_communication_exchange_async(mcl_communication_t *communication, mcl_store_t *store, mcl_communication_exchange_callback_t callback,
+            void *user_context);
+
+    /**
+     * This function progresses the exchange operations started by #mcl_communication_exchange_async.
+     *
+     * Waits at most @p timeout milliseconds for network activity, sends and receives the pending data and
+     * calls the callbacks of the exchange operations which are completed.
+     *
+     * @param [in] communication Preinitialized @c mcl_communication_t object through which a connection is established to MindSphere.
+     * @param [in] timeout Maximum time in milliseconds to wait for network activity. 0 returns immediately.
+     * @param [out] pending_count Number of http requests still in flight. Optional, can be NULL.
+     * @return
+     * <ul>
+     * <li>#MCL_OK in case of success.</li>
+     * <li>#MCL_TRIGGERED_WITH_NULL in case @p communication is NULL.</li>
+     * <li>#MCL_NOT_INITIALIZED in case @p communication is not initialized.</li>
+     * <li>#MCL_FAIL in case of an internal error in MCL.</li>
+     * </ul>
+     */
+    extern MCL_EXPORT E_MCL_ERROR_CODE mcl_communication_poll(mcl_communication_t *communication, mcl_uint32_t timeout, mcl_size_t *pending_count);
+
 	/**
 	* This function exchanges data in @p store to MindSphere similar to #mcl_communication_exchange but additionally, 
 	* it performs a series of steps, such as get access token and key rotation if exchange fails.
+	* If the access token expires within #mcl_configuration_t.access_token_refresh_margin, it is renewed before exchange.
 	*
 	* @param [in] communication Preinitialized @c mcl_communication_t object through which a connection is established to MindSphere.
 	* @param [in] store Container for the data to be uploaded to MindSphere.
@@ -220,6 +316,7 @@ extern "C"
 	* <li>#MCL_NOT_ONBOARDED if the agent is not onboarded using @p communication.</li>
 	* <li>#MCL_NO_ACCESS_TOKEN_EXISTS if @p communication does not have an access token.</li>
 	* <li>#MCL_STORE_IS_EMPTY if @p store has no data.</li>
+	* <li>#MCL_EXCHANGE_ASYNC_IS_ACTIVE if exchange operations started by #mcl_communication_exchange_async are not completed yet.</li>
 	* <li>#MCL_COULD_NOT_RESOLVE_PROXY in case the proxy host name can not be resolved.</li>
 	* <li>#MCL_COULD_NOT_RESOLVE_HOST in case the remote host name can not be resolved.</li>
 	* <li>#MCL_SSL_HANDSHAKE_FAIL in case a problem occurs during SSL handshake.</li>
@@ -282,6 +379,22 @@ extern "C"
 	*/
 	extern MCL_EXPORT E_MCL_ERROR_CODE mcl_communication_get_last_token_time(mcl_communication_t *communication, char **token_time);
 
+	/**
+	* @brief Returns how many HTTP requests were sent over a newly opened connection and how many reused an existing connection.
+	*
+	* Connections are reused only if @c http_keep_alive is set in #mcl_configuration_t.
+	*
+	* @param [in] communication Preinitialized @c mcl_communication_t object through which a connection is established to MindSphere.
+	* @param [out] connections_opened Number of requests for which a new connection is opened.
+	* @param [out] connections_reused Number of requests for which an existing connection is reused.
+	* @return
+	* <ul>
+	* <li>#MCL_OK in case of success.</li>
+	* <li>#MCL_TRIGGERED_WITH_NULL if provided @p communication, @p connections_opened or @p connections_reused is NULL.</li>
+	* </ul>
+	*/
+	extern MCL_EXPORT E_MCL_ERROR_CODE mcl_communication_get_connection_statistics(mcl_communication_t *communication, mcl_size_t *connections_opened, mcl_size_t *connections_reused);
+
 #ifdef  __cplusplus
 }
 #endif
@@ -51,6 +51,12 @@ extern "C"
         mcl_save_registration_information_callback_t save_function;     //!< Custom function for saving registration information; if both load_function and save_function are non-null, custom functions will be used.
         mcl_enter_critical_section_callback_t enter_critical_section;   //!< Custom function for entering critical section (Optional, default is NULL).
         mcl_leave_critical_section_callback_t leave_critical_section;   //!< Custom function for leaving critical section (Optional, default is NULL).
+        mcl_bool_t http_keep_alive;                                     //!< Reuse the connection to MindSphere for consecutive HTTP requests instead of opening a new one for each request. Default value is MCL_TRUE.
+        mcl_uint32_t http_connection_idle_timeout;                      //!< Idle time (in seconds) after which a kept-alive connection is not reused anymore. Only used if http_keep_alive is MCL_TRUE. Default value is 60 seconds.
+        mcl_uint32_t http_connection_max_requests;                      //!< Maximum number of HTTP requests sent over a single connection before it is closed. 0 means unlimited. Only used if http_keep_alive is MCL_TRUE. Default value is 100.
+        mcl_bool_t tls_session_cache;                                   //!< Save the last TLS session to the file #store_path with ".tls" suffix so that a restarted agent resumes it instead of a full handshake. The file holds session secrets. Only used if #store_path is set and file system is available. Default value is MCL_FALSE.
+        mcl_uint32_t access_token_refresh_margin;                       //!< Time (in seconds) before expiry of the access token within which #mcl_communication_process renews the access token before exchanging, instead of uploading with a token which is about to be rejected. Default value is 60 seconds.
+        mcl_bool_t http_compression;                                    //!< Compress the payload of exchange requests with gzip (sent with "Content-Encoding: gzip"). Only used if the library is built with zlib. Default value is MCL_FALSE.
     } mcl_configuration_t;
 
     /**
@@ -73,7 +73,7 @@ extern "C"
      * @param [in] array Array json object.
      * @param [in] index Index of the item to get from @p array.
      * @param [out] item Result json object item.New memory space will be allocated for this parameter.
-     * Ownership passed to caller. Caller must free the space using MCL_FREE().
+     * Ownership passed to caller. Caller must free the space using #mcl_memory_free().
      * @return
      * <ul>
      * <li>#MCL_OK in case of success.</li>
@@ -246,7 +246,7 @@ extern "C"
      * @param [in] json_parent Root json object of @p json_child.
      * @param [in] child_name Name of the @p json_child object.
      * @param [out] json_child The json object which is going to be received. New memory space will be allocated for this parameter.
-     * Ownership passed to caller. Caller must free the space using MCL_FREE().
+     * Ownership passed to caller. Caller must free the space using #mcl_memory_free().
      * @return
      * <ul>
      * <li>#MCL_OK in case of success.</li>
@@ -312,7 +312,7 @@ extern "C"
      * @brief This function gets the string value of a given json object.
      *
      * @param [in] json_item Root object of @p string_value.
-     * @param [in] string_value String value of @p json_item. New memory space will be allocated for this parameter. Ownership passed to caller. Caller must free the space.
+     * @param [in] string_value String value of @p json_item. New memory space will be allocated for this parameter. Ownership passed to caller. Caller must free the space using #mcl_memory_free().
      * @return
      * <ul>
      * <li>#MCL_OK in case of success.</li>
@@ -326,7 +326,7 @@ extern "C"
      * @brief This function gives the string of @p root in json format.
      *
      * @param [in] root Root json object.
-     * @param [out] json_string The string of @p root in json format. New memory space will be allocated for this parameter. Ownership passed to caller. Caller must free the space.
+     * @param [out] json_string The string of @p root in json format. New memory space will be allocated for this parameter. Ownership passed to caller. Caller must free the space using #mcl_memory_free().
      * @return
      * <ul>
      * <li>#MCL_OK in case of success.</li>
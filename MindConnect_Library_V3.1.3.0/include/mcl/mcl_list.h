@@ -18,6 +18,7 @@
 #define MCL_LIST_H_
 
 #include "mcl/mcl_common.h"
+#include "mcl/mcl_memory.h"
 
 #ifdef  __cplusplus
 extern "C"
@@ -43,6 +44,7 @@ extern "C"
         mcl_list_node_t *last;           //!< Last node of the list.
         mcl_list_node_t *current;        //!< Current node of the list.
         mcl_size_t count;                //!< Node count of the list.
+        E_MCL_MEMORY_CATEGORY category;  //!< Category which the list and its nodes are accounted to.
     } mcl_list_t;
 
     /**
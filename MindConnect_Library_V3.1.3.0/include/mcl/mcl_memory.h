@@ -0,0 +1,225 @@
+/*!**********************************************************************
+*
+* @copyright Copyright (C) 2016 Siemens Aktiengesellschaft.\n
+*            All rights reserved.
+*
+*************************************************************************
+*
+* @file     mcl_memory.h
+* @date     Oct 17, 2026
+* @brief    Memory module interface header file.
+*
+* This module lets the user replace the functions which MCL allocates memory with and query how much memory MCL uses, in total per category
+* and, if MCL is built with MCL_MEMORY_TELEMETRY option, per call site.
+*
+************************************************************************/
+
+#ifndef MCL_MEMORY_H_
+#define MCL_MEMORY_H_
+
+#include "mcl/mcl_common.h"
+
+#ifdef  __cplusplus
+extern "C"
+{
+#endif
+
+    /**
+     * @brief Categories which memory allocated by MCL is accounted to.
+     */
+    typedef enum E_MCL_MEMORY_CATEGORY
+    {
+        MCL_MEMORY_CATEGORY_OTHER,    //!< Memory of common modules, strings and lists not created for another category and tables of the memory module.
+        MCL_MEMORY_CATEGORY_STORE,    //!< Memory of stores and the data added to them.
+        MCL_MEMORY_CATEGORY_HTTP,     //!< Memory of http requests, responses and their processing.
+        MCL_MEMORY_CATEGORY_JSON,     //!< Memory of json objects and json strings.
+        MCL_MEMORY_CATEGORY_SECURITY, //!< Memory of security information, keys and tokens.
+        MCL_MEMORY_CATEGORY_CURL,     //!< Memory allocated by libcurl.
+        MCL_MEMORY_CATEGORY_END
+    } E_MCL_MEMORY_CATEGORY;
+
+    /**
+     * @brief Callback function prototype to allocate memory.
+     *
+     * @param [in] context Context of the allocator, see #mcl_memory_allocator_t.
+     * @param [in] size Size of the memory to allocate.
+     * @return Allocated memory or NULL if there is not enough memory.
+     */
+    typedef void *(*mcl_memory_malloc_callback_t)(void *context, mcl_size_t size);
+
+    /**
+     * @brief Callback function prototype to resize memory allocated by the allocator.
+     *
+     * @param [in] context Context of the allocator, see #mcl_memory_allocator_t.
+     * @param [in] p Memory to resize, NULL to allocate new memory.
+     * @param [in] size New size of the memory.
+     * @return Resized memory or NULL if there is not enough memory, in which case @p p is not released.
+     */
+    typedef void *(*mcl_memory_realloc_callback_t)(void *context, void *p, mcl_size_t size);
+
+    /**
+     * @brief Callback function prototype to release memory allocated by the allocator.
+     *
+     * @param [in] context Context of the allocator, see #mcl_memory_allocator_t.
+     * @param [in] p Memory to release.
+     */
+    typedef void (*mcl_memory_free_callback_t)(void *context, void *p);
+
+    /**
+     * @brief Allocator which MCL allocates memory with, including the memory of libcurl and json objects.
+     */
+    typedef struct mcl_memory_allocator_t
+    {
+        mcl_memory_malloc_callback_t malloc_callback;   //!< Function to allocate memory.
+        mcl_memory_realloc_callback_t realloc_callback; //!< Function to resize memory.
+        mcl_memory_free_callback_t free_callback;       //!< Function to release memory.
+        void *context;                                  //!< Context passed to the functions of the allocator (Optional).
+    } mcl_memory_allocator_t;
+
+    /**
+     * @brief Memory usage of a category.
+     */
+    typedef struct mcl_memory_usage_t
+    {
+        mcl_size_t bytes; //!< Size of the memory currently allocated.
+        mcl_size_t count; //!< Number of allocations currently alive.
+    } mcl_memory_usage_t;
+
+    /**
+     * @brief Sets the allocator which MCL allocates memory with.
+     *
+     * This function must be called before any other function of MCL, since memory is always released with the allocator set at that time.
+     * Buffers given to the user by MCL are allocated with the allocator and must be released with #mcl_memory_free().
+     * Likewise, buffers whose ownership is passed to MCL (e.g. loaded registration information) must be allocated with the allocator.
+     *
+     * @param [in] allocator Allocator to use, NULL to use malloc, realloc and free of the C library. The allocator is copied.
+     * @return
+     * <ul>
+     * <li>#MCL_OK in case of success.</li>
+     * <li>#MCL_TRIGGERED_WITH_NULL if a function of @p allocator is NULL.</li>
+     * </ul>
+     */
+    extern MCL_EXPORT E_MCL_ERROR_CODE mcl_memory_set_allocator(const mcl_memory_allocator_t *allocator);
+
+    /**
+     * @brief Returns the memory currently allocated by MCL in a category.
+     *
+     * Memory of arenas and pools is accounted when it is taken from the allocator, not per object allocated from it.
+     * Buffers given to the user by MCL are accounted until they are released with #mcl_memory_free().
+     *
+     * @param [in] category Category to query.
+     * @param [out] usage Memory usage of @p category.
+     * @return
+     * <ul>
+     * <li>#MCL_OK in case of success.</li>
+     * <li>#MCL_TRIGGERED_WITH_NULL if @p usage is NULL.</li>
+     * <li>#MCL_INVALID_PARAMETER if @p category is not a valid category.</li>
+     * </ul>
+     */
+    extern MCL_EXPORT E_MCL_ERROR_CODE mcl_memory_get_usage(E_MCL_MEMORY_CATEGORY category, mcl_memory_usage_t *usage);
+
+    /**
+     * @brief Releases a buffer given to the user by MCL, e.g. a json string or a response payload.
+     *
+     * The buffer is released with the allocator set by #mcl_memory_set_allocator() and is no longer accounted to its category.
+     * Releasing such a buffer with the free function of the allocator directly leaves it accounted until its address is allocated again.
+     *
+     * @param [in] p Buffer to release. Nothing is done if it is NULL.
+     */
+    extern MCL_EXPORT void mcl_memory_free(void *p);
+
+    /**
+     * @brief Memory telemetry of all call sites, available if MCL is built with MCL_MEMORY_TELEMETRY option.
+     */
+    typedef struct mcl_memory_telemetry_t
+    {
+        mcl_size_t current_bytes;    //!< Size of the memory currently allocated.
+        mcl_size_t peak_bytes;       //!< Highest size of the memory allocated at once since the start or the last call of #mcl_memory_reset_peak().
+        mcl_size_t current_count;    //!< Number of allocations currently alive.
+        mcl_size_t allocation_count; //!< Number of allocations made so far, resizes included.
+        mcl_size_t call_site_count;  //!< Number of call sites which allocated memory so far.
+    } mcl_memory_telemetry_t;
+
+    /**
+     * @brief Memory telemetry of a call site, available if MCL is built with MCL_MEMORY_TELEMETRY option.
+     *
+     * Memory allocated by third party libraries through MCL (libcurl, json objects and OpenSSL) is attributed to a call site
+     * with the name of its category (e.g. "curl") and line 0.
+     */
+    typedef struct mcl_memory_call_site_t
+    {
+        const char *function;        //!< Name of the function which allocated the memory.
+        mcl_uint32_t line;           //!< Line of the allocation in @p function.
+        mcl_size_t current_bytes;    //!< Size of the memory currently allocated by the call site.
+        mcl_size_t peak_bytes;       //!< Highest size of the memory allocated by the call site at once.
+        mcl_size_t current_count;    //!< Number of allocations of the call site currently alive.
+        mcl_size_t allocation_count; //!< Number of allocations made by the call site so far.
+        mcl_size_t total_bytes;      //!< Sum of the sizes of all allocations made by the call site so far.
+        mcl_size_t largest_size;     //!< Size of the largest allocation made by the call site.
+    } mcl_memory_call_site_t;
+
+    /**
+     * @brief Returns the memory telemetry of all call sites.
+     *
+     * Telemetry counts the bytes requested by MCL, unlike #mcl_memory_get_usage() memory of arenas and pools is counted per object allocated from it.
+     * Resized memory is attributed to the call site which resized it.
+     *
+     * @param [out] telemetry Memory telemetry.
+     * @return
+     * <ul>
+     * <li>#MCL_OK in case of success.</li>
+     * <li>#MCL_TRIGGERED_WITH_NULL if @p telemetry is NULL.</li>
+     * <li>#MCL_OPERATION_IS_NOT_SUPPORTED if MCL is not built with MCL_MEMORY_TELEMETRY option.</li>
+     * </ul>
+     */
+    extern MCL_EXPORT E_MCL_ERROR_CODE mcl_memory_get_telemetry(mcl_memory_telemetry_t *telemetry);
+
+    /**
+     * @brief Returns the memory telemetry of a call site.
+     *
+     * Call sites are indexed in the order they allocated memory for the first time, see #mcl_memory_telemetry_t::call_site_count.
+     *
+     * @param [in] index Index of the call site.
+     * @param [out] call_site Memory telemetry of the call site.
+     * @return
+     * <ul>
+     * <li>#MCL_OK in case of success.</li>
+     * <li>#MCL_TRIGGERED_WITH_NULL if @p call_site is NULL.</li>
+     * <li>#MCL_INVALID_PARAMETER if there is no call site with @p index.</li>
+     * <li>#MCL_OPERATION_IS_NOT_SUPPORTED if MCL is not built with MCL_MEMORY_TELEMETRY option.</li>
+     * </ul>
+     */
+    extern MCL_EXPORT E_MCL_ERROR_CODE mcl_memory_get_call_site(mcl_size_t index, mcl_memory_call_site_t *call_site);
+
+    /**
+     * @brief Sets the peak bytes of the telemetry and all call sites to their current bytes, e.g. to measure the peak of a single exchange.
+     *
+     * @return
+     * <ul>
+     * <li>#MCL_OK in case of success.</li>
+     * <li>#MCL_OPERATION_IS_NOT_SUPPORTED if MCL is not built with MCL_MEMORY_TELEMETRY option.</li>
+     * </ul>
+     */
+    extern MCL_EXPORT E_MCL_ERROR_CODE mcl_memory_reset_peak(void);
+
+    /**
+     * @brief Dumps the memory telemetry of all call sites as a json string.
+     *
+     * The json object has the fields of #mcl_memory_telemetry_t and a "call_sites" array of objects with the fields of #mcl_memory_call_site_t.
+     *
+     * @param [out] json Json string, allocated with the allocator set by #mcl_memory_set_allocator(). The user must release it with #mcl_memory_free().
+     * @return
+     * <ul>
+     * <li>#MCL_OK in case of success.</li>
+     * <li>#MCL_TRIGGERED_WITH_NULL if @p json is NULL.</li>
+     * <li>#MCL_OUT_OF_MEMORY in case there is not enough memory in the system to proceed.</li>
+     * <li>#MCL_OPERATION_IS_NOT_SUPPORTED if MCL is not built with MCL_MEMORY_TELEMETRY option.</li>
+     * </ul>
+     */
+    extern MCL_EXPORT E_MCL_ERROR_CODE mcl_memory_dump_telemetry(char **json);
+
+#ifdef  __cplusplus
+}
+#endif
+
+#endif //MCL_MEMORY_H_
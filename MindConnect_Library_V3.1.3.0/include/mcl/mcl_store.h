@@ -38,6 +38,16 @@ extern "C"
 	*/
     typedef struct mcl_file_t mcl_file_t;
 
+    /**
+     * @brief Priority of the data in store.
+     */
+    typedef enum E_MCL_STORE_PRIORITY
+    {
+        MCL_STORE_PRIORITY_HIGH = 0, //!< Data is written to http requests before any low priority data.
+        MCL_STORE_PRIORITY_LOW,      //!< Data is written to the space left in http requests after high priority data.
+        MCL_STORE_PRIORITY_END
+    } E_MCL_STORE_PRIORITY;
+
     /**
      * This function creates and initializes an object of type #mcl_store_t.
      *
@@ -59,6 +69,55 @@ extern "C"
      */
     extern MCL_EXPORT E_MCL_ERROR_CODE mcl_store_initialize(mcl_bool_t streamable, mcl_store_t **store);
 
+    /**
+     * This function creates and initializes a persistent object of type #mcl_store_t.
+     *
+     * A persistent store writes a data to a write-ahead log in @p directory when the next data is added to the store, when an exchange
+     * operation is performed or when the store is destroyed, whichever comes first. Only the meta of the data is kept in memory afterwards.
+     * Data which could not be exchanged survives a restart: data left in @p directory by a previous store is added to the new store before
+     * any new data. Data is removed from the log when it is exchanged successfully.
+     *
+     * Files and stream data are not written to the log, they are handled as in a store initialized with #mcl_store_initialize().
+     * Data must not be modified after another data is added to the store or an exchange operation is performed on the store.
+     *
+     * @param [in] streamable Indicates if the content of this store will be exchanged using chunked Transfer-Encoding or not.
+     * @param [in] directory Existing directory to keep the write-ahead log of the store in. Only one store can use a directory at a time,
+     * the directory is locked against other processes until the store is destroyed.
+     * @param [out] store The newly initialized store.
+     * @return
+     * <ul>
+     * <li>#MCL_OK in case of success.</li>
+     * <li>#MCL_TRIGGERED_WITH_NULL in case @p directory or @p store is NULL.</li>
+     * <li>#MCL_NO_FILE_SUPPORT in case the system does not have a file system.</li>
+     * <li>#MCL_PATH_NOT_ACCESSIBLE in case @p directory is used by another process.</li>
+     * <li>#MCL_OUT_OF_MEMORY in case there is not enough memory in the system to proceed.</li>
+     * <li>#MCL_FAIL in case initialization of store fails.</li>
+     * </ul>
+     */
+    extern MCL_EXPORT E_MCL_ERROR_CODE mcl_store_initialize_persistent(mcl_bool_t streamable, const char *directory, mcl_store_t **store);
+
+    /**
+     * This function creates and initializes an object of type #mcl_store_t whose data is allocated from an arena.
+     *
+     * Data added to the store, time series values and event options are allocated from large blocks owned by the store instead of
+     * one by one from the heap. Memory of data removed from the store after it is exchanged is reused once the store becomes empty,
+     * and all blocks are released at once by #mcl_store_destroy().
+     * The blocks are not synchronized, so the store and its data must be used by one thread at a time. Other threads may use MCL meanwhile,
+     * their allocations are never made from the blocks of the store.
+     *
+     * @param [in] streamable Indicates if the content of this store will be exchanged using chunked Transfer-Encoding or not.
+     * @param [in] block_size Size of the blocks of the arena in bytes. Default size of 64 KB is used if zero.
+     * @param [out] store The newly initialized store.
+     * @return
+     * <ul>
+     * <li>#MCL_OK in case of success.</li>
+     * <li>#MCL_TRIGGERED_WITH_NULL in case @p store is NULL.</li>
+     * <li>#MCL_OUT_OF_MEMORY in case there is not enough memory in the system to proceed.</li>
+     * <li>#MCL_FAIL in case initialization of store fails.</li>
+     * </ul>
+     */
+    extern MCL_EXPORT E_MCL_ERROR_CODE mcl_store_initialize_with_arena(mcl_bool_t streamable, mcl_size_t block_size, mcl_store_t **store);
+
     /**
      * This function destroys the mcl_store_t object and frees any memory allocated.
      *
@@ -71,6 +130,27 @@ extern "C"
      */
     extern MCL_EXPORT E_MCL_ERROR_CODE mcl_store_destroy(mcl_store_t **store);
 
+    /**
+     * This function sets the priority of the data which will be created in @p store afterwards.
+     *
+     * Data created by mcl_store_new_* functions gets the priority set last, which is #MCL_STORE_PRIORITY_HIGH for a new store.
+     * During exchange operation, each http request is filled with high priority data first and the space left is used for low priority data.
+     * Low priority data which is left out of several http requests in a row is sent in the order it was created together with high priority data,
+     * so that it is not held back indefinitely on a congested link.
+     *
+     * Data left in the directory of a persistent store by a previous store is added with high priority.
+     *
+     * @param [in] store Preinitialized #mcl_store_t object.
+     * @param [in] priority Priority of the data to be created.
+     * @return
+     * <ul>
+     * <li>#MCL_OK in case of success.</li>
+     * <li>#MCL_TRIGGERED_WITH_NULL in case @p store is NULL.</li>
+     * <li>#MCL_INVALID_PARAMETER in case @p priority is not one of #E_MCL_STORE_PRIORITY values.</li>
+     * </ul>
+     */
+    extern MCL_EXPORT E_MCL_ERROR_CODE mcl_store_set_priority(mcl_store_t *store, E_MCL_STORE_PRIORITY priority);
+
     /**
      * This function creates and initializes a new #mcl_time_series_t structure.
      *
@@ -48,6 +48,31 @@ extern "C"
      */
     extern MCL_EXPORT E_MCL_ERROR_CODE mcl_time_series_new_value_set(mcl_time_series_t *time_series, const char *timestamp, mcl_time_series_value_set_t **value_set);
 
+    /**
+     * @brief This function creates a new #mcl_time_series_value_set_t with all values of a frame sampled at @p timestamp.
+     *
+     * It is equivalent to calling #mcl_time_series_new_value_set and then #mcl_time_series_add_value for each value, but validates
+     * the frame once and allocates memory for all values at once. Either all values of the frame are added or none.
+     * More values can still be added to the returned @p value_set.
+     *
+     * @param [in] time_series @p value_set is added to @p time_series .
+     * @param [in] timestamp Timestamp of the values in YYYY-MM-DDThh:mm:ss.sssZ format. Ex:2016-04-26T08:06:25.317Z.
+     * @param [in] value_count Number of elements in each of @p data_point_ids, @p values and @p quality_codes.
+     * @param [in] data_point_ids Ids of the data points the values are read from.
+     * @param [in] values The values read.
+     * @param [in] quality_codes The qualities of the values provided. Each must represent a valid number compatible with the standard.
+     * @param [out] value_set Contains the timestamp and the values of the frame.
+     * @return
+     * <ul>
+     * <li>#MCL_OK in case of success.</li>
+     * <li>#MCL_TRIGGERED_WITH_NULL if any input argument or any element of the arrays is NULL.</li>
+     * <li>#MCL_OUT_OF_MEMORY in case there is not enough memory in the system to proceed.</li>
+     * <li>#MCL_INVALID_PARAMETER in case timestamp is not valid in terms of format, length or time value.</li>
+     * </ul>
+     */
+    extern MCL_EXPORT E_MCL_ERROR_CODE mcl_time_series_add_frame(mcl_time_series_t *time_series, const char *timestamp, mcl_size_t value_count,
+            const char * const *data_point_ids, const char * const *values, const char * const *quality_codes, mcl_time_series_value_set_t **value_set);
+
     /**
      * @brief This function adds @p data_point_id, @p value and @p quality_code to #mcl_time_series_value_set_t.
      *
@@ -66,6 +91,64 @@ extern "C"
     extern MCL_EXPORT E_MCL_ERROR_CODE mcl_time_series_add_value(mcl_time_series_value_set_t *value_set, const char *data_point_id, const char *value,
             const char *quality_code);
 
+    /**
+     * @brief This function adds @p data_point_id, double @p value and @p quality_code to #mcl_time_series_value_set_t.
+     *
+     * The value is stored as a number and converted to its string representation only when the time series is serialized.
+     *
+     * @param [in] value_set Value set to which parameters are added.
+     * @param [in] data_point_id Id of the data point the value is read from.
+     * @param [in] value The value read. Must be a finite number.
+     * @param [in] quality_code The quality of the value provided. Must represent a valid number compatible with the standard.
+     * @return
+     * <ul>
+     * <li>#MCL_OK in case of success.</li>
+     * <li>#MCL_TRIGGERED_WITH_NULL if one of the provided parameters is NULL.</li>
+     * <li>#MCL_INVALID_PARAMETER if @p value is not a finite number.</li>
+     * <li>#MCL_OUT_OF_MEMORY in case there is not enough memory in the system to proceed.</li>
+     * </ul>
+     */
+    extern MCL_EXPORT E_MCL_ERROR_CODE mcl_time_series_add_double(mcl_time_series_value_set_t *value_set, const char *data_point_id, double value,
+            const char *quality_code);
+
+    /**
+     * @brief This function adds @p data_point_id, integer @p value and @p quality_code to #mcl_time_series_value_set_t.
+     *
+     * The value is stored as a number and converted to its string representation only when the time series is serialized.
+     *
+     * @param [in] value_set Value set to which parameters are added.
+     * @param [in] data_point_id Id of the data point the value is read from.
+     * @param [in] value The value read.
+     * @param [in] quality_code The quality of the value provided. Must represent a valid number compatible with the standard.
+     * @return
+     * <ul>
+     * <li>#MCL_OK in case of success.</li>
+     * <li>#MCL_TRIGGERED_WITH_NULL if one of the provided parameters is NULL.</li>
+     * <li>#MCL_OUT_OF_MEMORY in case there is not enough memory in the system to proceed.</li>
+     * </ul>
+     */
+    extern MCL_EXPORT E_MCL_ERROR_CODE mcl_time_series_add_int64(mcl_time_series_value_set_t *value_set, const char *data_point_id, mcl_int64_t value,
+            const char *quality_code);
+
+    /**
+     * @brief This function adds @p data_point_id, boolean @p value and @p quality_code to #mcl_time_series_value_set_t.
+     *
+     * The value is serialized as "true" or "false".
+     *
+     * @param [in] value_set Value set to which parameters are added.
+     * @param [in] data_point_id Id of the data point the value is read from.
+     * @param [in] value The value read.
+     * @param [in] quality_code The quality of the value provided. Must represent a valid number compatible with the standard.
+     * @return
+     * <ul>
+     * <li>#MCL_OK in case of success.</li>
+     * <li>#MCL_TRIGGERED_WITH_NULL if one of the provided parameters is NULL.</li>
+     * <li>#MCL_OUT_OF_MEMORY in case there is not enough memory in the system to proceed.</li>
+     * </ul>
+     */
+    extern MCL_EXPORT E_MCL_ERROR_CODE mcl_time_series_add_bool(mcl_time_series_value_set_t *value_set, const char *data_point_id, mcl_bool_t value,
+            const char *quality_code);
+
 #ifdef  __cplusplus
 }
 #endif
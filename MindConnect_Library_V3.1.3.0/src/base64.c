@@ -11,6 +11,8 @@
  *
  ************************************************************************/
 
+#define MEMORY_CATEGORY MCL_MEMORY_CATEGORY_SECURITY
+
 #include "base64.h"
 #include "memory.h"
 #include "log_util.h"
@@ -23,6 +23,9 @@
 // This function is used to log configuration which is used to initialize communication.
 static void _log_configuration(mcl_configuration_t *configuration);
 
+// This function is called by http processor when an exchange operation started by mcl_communication_exchange_async is completed.
+static void _exchange_async_callback(E_MCL_ERROR_CODE code, store_t *store, void *user_context);
+
 E_MCL_ERROR_CODE mcl_communication_initialize(mcl_configuration_t *configuration, mcl_communication_t **communication)
 {
     DEBUG_ENTRY("mcl_configuration_t *configuration = <%p>, mcl_communication_t **communication = <%p>", configuration, communication)
@@ -98,6 +101,7 @@ E_MCL_ERROR_CODE mcl_communication_initialize(mcl_configuration_t *configuration
     ASSERT_CODE_MESSAGE(MCL_NULL != *communication, MCL_OUT_OF_MEMORY, "Memory can not be allocated for communication object.");
 
     (*communication)->state.initialized = MCL_FALSE;
+    (*communication)->state.destroying = MCL_FALSE;
     (*communication)->http_processor = MCL_NULL;
     (*communication)->configuration.mindsphere_hostname = MCL_NULL;
     (*communication)->configuration.mindsphere_port = 0;
@@ -146,6 +150,20 @@ E_MCL_ERROR_CODE mcl_communication_initialize(mcl_configuration_t *configuration
     // Copy http_request_timeout to mcl_handle.
     (*communication)->configuration.http_request_timeout = configuration->http_request_timeout;
 
+    // Copy connection reuse settings to mcl_handle.
+    (*communication)->configuration.http_keep_alive = configuration->http_keep_alive;
+    (*communication)->configuration.http_connection_idle_timeout = configuration->http_connection_idle_timeout;
+    (*communication)->configuration.http_connection_max_requests = configuration->http_connection_max_requests;
+
+    // Copy TLS session cache setting to mcl_handle.
+    (*communication)->configuration.tls_session_cache = configuration->tls_session_cache;
+
+    // Copy access token refresh margin to mcl_handle.
+    (*communication)->configuration.access_token_refresh_margin = configuration->access_token_refresh_margin;
+
+    // Copy HTTP compression setting to mcl_handle.
+    (*communication)->configuration.http_compression = configuration->http_compression;
+
     // Check if proxy is used but do not return error if not used.
     if (MCL_NULL != configuration->proxy_hostname)
     {
@@ -245,8 +263,17 @@ E_MCL_ERROR_CODE mcl_communication_destroy(mcl_communication_t **communication)
     // Make sure input argument is not NULL.
     ASSERT_NOT_NULL(communication);
 
-    if (MCL_NULL != *communication)
+    if ((MCL_NULL != *communication) && (MCL_TRUE == (*communication)->state.destroying))
+    {
+        // Called from a callback of a pending exchange operation, the outer call releases the resources.
+        MCL_DEBUG("Communication handle is already being destroyed.");
+    }
+    else if (MCL_NULL != *communication)
     {
+        // Callbacks of the pending exchange operations are called while destroying the http processor, they can not use the handle.
+        (*communication)->state.destroying = MCL_TRUE;
+        (*communication)->state.initialized = MCL_FALSE;
+
         // Free configuration memory.
         string_destroy(&((*communication)->configuration.mindsphere_hostname));
         string_destroy(&((*communication)->configuration.mindsphere_certificate));
@@ -399,6 +426,24 @@ E_MCL_ERROR_CODE mcl_communication_rotate_key(mcl_communication_t *communication
     return result;
 }
 
+E_MCL_ERROR_CODE mcl_communication_generate_next_key(mcl_communication_t *communication)
+{
+    DEBUG_ENTRY("mcl_communication_t *communication = <%p>", communication)
+
+    E_MCL_ERROR_CODE result;
+
+    ASSERT_NOT_NULL(communication);
+
+    ASSERT_CODE_MESSAGE(MCL_TRUE == mcl_communication_is_initialized(communication), MCL_NOT_INITIALIZED, "Received communication handle is not initialized!");
+    ASSERT_CODE_MESSAGE(MCL_SECURITY_RSA_3072 == communication->configuration.security_profile, MCL_OPERATION_IS_NOT_SUPPORTED, "Key pair can be generated in advance only for RSA security profile!");
+
+    // Critical section is entered by http processor after the key pair is generated.
+    result = http_processor_generate_next_rsa_key(communication->http_processor);
+
+    DEBUG_LEAVE("retVal = <%d>", result);
+    return result;
+}
+
 E_MCL_ERROR_CODE mcl_communication_update_security_information(mcl_communication_t *communication)
 {
     DEBUG_ENTRY("mcl_communication_t *communication = <%p>", communication)
@@ -498,12 +543,79 @@ E_MCL_ERROR_CODE mcl_communication_exchange(mcl_communication_t *communication,
     return result;
 }
 
+E_MCL_ERROR_CODE mcl_communication_exchange_async(mcl_communication_t *communication, mcl_store_t *store, mcl_communication_exchange_callback_t callback, void *user_context)
+{
+    DEBUG_ENTRY("mcl_communication_t *communication = <%p>, mcl_store_t *store = <%p>, mcl_communication_exchange_callback_t callback = <%p>, void *user_context = <%p>",
+                communication, store, callback, user_context)
+
+    E_MCL_ERROR_CODE result;
+    communication_exchange_context_t *context;
+
+    // Initial checks :
+    ASSERT_NOT_NULL(communication);
+    ASSERT_NOT_NULL(store);
+    ASSERT_NOT_NULL(callback);
+
+    ASSERT_CODE_MESSAGE(MCL_TRUE == mcl_communication_is_initialized(communication), MCL_NOT_INITIALIZED, "Received communication handle is not initialized!");
+    ASSERT_CODE_MESSAGE(MCL_TRUE == mcl_communication_is_onboarded(communication), MCL_NOT_ONBOARDED, "Onboard operation is not performed yet on this mcl_communication handle!");
+    ASSERT_CODE_MESSAGE(MCL_NULL != communication->http_processor->security_handler->access_token, MCL_NO_ACCESS_TOKEN_EXISTS, "No access token exists.");
+    ASSERT_CODE_MESSAGE(MCL_FALSE == store->streamable, MCL_OPERATION_IS_NOT_SUPPORTED, "Asynchronous exchange of streamable store is not supported!");
+
+    MCL_NEW(context);
+    ASSERT_CODE_MESSAGE(MCL_NULL != context, MCL_OUT_OF_MEMORY, "Memory can not be allocated for exchange context.");
+
+    context->communication = communication;
+    context->callback = callback;
+    context->user_context = user_context;
+    context->access_token_renewed = MCL_FALSE;
+
+    result = http_processor_exchange_async(communication->http_processor, store, _exchange_async_callback, context);
+
+    if (MCL_OK != result)
+    {
+        MCL_FREE(context);
+    }
+
+    DEBUG_LEAVE("retVal = <%d>", result);
+    return result;
+}
+
+E_MCL_ERROR_CODE mcl_communication_poll(mcl_communication_t *communication, mcl_uint32_t timeout, mcl_size_t *pending_count)
+{
+    DEBUG_ENTRY("mcl_communication_t *communication = <%p>, mcl_uint32_t timeout = <%u>, mcl_size_t *pending_count = <%p>", communication, timeout, pending_count)
+
+    E_MCL_ERROR_CODE result;
+
+    ASSERT_NOT_NULL(communication);
+    ASSERT_CODE_MESSAGE(MCL_TRUE == mcl_communication_is_initialized(communication), MCL_NOT_INITIALIZED, "Received communication handle is not initialized!");
+
+    result = http_processor_perform(communication->http_processor, timeout, pending_count);
+
+    DEBUG_LEAVE("retVal = <%d>", result);
+    return result;
+}
+
 E_MCL_ERROR_CODE mcl_communication_process(mcl_communication_t *communication, mcl_store_t *store, void **reserved)
 {
     DEBUG_ENTRY("mcl_communication_t *communication = <%p>, mcl_store_t *store = <%p>, void **reserved = <%p>", communication, store, reserved)
 
 	E_MCL_ERROR_CODE result;
-	
+
+	ASSERT_NOT_NULL(communication);
+	ASSERT_NOT_NULL(store);
+
+	// Renew the access token before it expires, otherwise the whole store could be uploaded just to be rejected.
+	if ((MCL_TRUE == mcl_communication_is_initialized(communication)) && (MCL_NULL != communication->http_processor->security_handler->access_token)
+		&& (MCL_TRUE == http_processor_is_access_token_expiring(communication->http_processor)))
+	{
+		MCL_INFO("Access token is about to expire. Trying to renew access token before exchange.");
+		result = mcl_communication_get_access_token(communication);
+		if (MCL_OK != result)
+		{
+			MCL_INFO("Access token can not be renewed before exchange.");
+		}
+	}
+
 	result = mcl_communication_exchange(communication, store, NULL);
 
 	if (MCL_UNAUTHORIZED == result || MCL_NO_ACCESS_TOKEN_EXISTS == result)
@@ -667,6 +779,21 @@ E_MCL_ERROR_CODE mcl_communication_get_last_token_time(mcl_communication_t *comm
 	return code;
 }
 
+E_MCL_ERROR_CODE mcl_communication_get_connection_statistics(mcl_communication_t *communication, mcl_size_t *connections_opened, mcl_size_t *connections_reused)
+{
+    DEBUG_ENTRY("mcl_communication_t *communication = <%p>, mcl_size_t *connections_opened = <%p>, mcl_size_t *connections_reused = <%p>", communication,
+                connections_opened, connections_reused)
+
+    ASSERT_NOT_NULL(communication);
+    ASSERT_NOT_NULL(connections_opened);
+    ASSERT_NOT_NULL(connections_reused);
+
+    http_processor_get_connection_statistics(communication->http_processor, connections_opened, connections_reused);
+
+    DEBUG_LEAVE("retVal = <%d>", MCL_OK);
+    return MCL_OK;
+}
+
 static void _log_configuration(mcl_configuration_t *configuration)
 {
     DEBUG_ENTRY("mcl_configuration_t *configuration = <%p>", configuration)
@@ -748,6 +875,22 @@ static void _log_configuration(mcl_configuration_t *configuration)
 
     MCL_INFO("Maximum HTTP Payload Size: %u bytes", configuration->max_http_payload_size);
     MCL_INFO("HTTP Request Timeout: %u seconds", configuration->http_request_timeout);
+
+    if (MCL_TRUE == configuration->http_keep_alive)
+    {
+        MCL_INFO("HTTP Keep-Alive: Enabled");
+        MCL_INFO("HTTP Connection Idle Timeout: %u seconds", configuration->http_connection_idle_timeout);
+        MCL_INFO("HTTP Connection Max Requests: %u", configuration->http_connection_max_requests);
+    }
+    else
+    {
+        MCL_INFO("HTTP Keep-Alive: Disabled");
+    }
+
+    MCL_INFO("Access Token Refresh Margin: %u seconds", configuration->access_token_refresh_margin);
+
+    MCL_INFO("HTTP Compression: %s", (MCL_TRUE == configuration->http_compression) ? "Enabled" : "Disabled");
+
     MCL_INFO("User Agent: %s", configuration->user_agent);
 
     if (MCL_NULL != configuration->initial_access_token)
@@ -769,6 +912,7 @@ static void _log_configuration(mcl_configuration_t *configuration)
     {
         MCL_INFO("Security Information: File system will be used (not safe)");
         MCL_INFO("Store Path: %s", configuration->store_path);
+        MCL_INFO("TLS Session Cache: %s", (MCL_TRUE == configuration->tls_session_cache) ? "Enabled" : "Disabled");
     }
     else
     {
@@ -786,3 +930,44 @@ static void _log_configuration(mcl_configuration_t *configuration)
 
     DEBUG_LEAVE("retVal = void");
 }
+
+static void _exchange_async_callback(E_MCL_ERROR_CODE code, store_t *store, void *user_context)
+{
+    DEBUG_ENTRY("E_MCL_ERROR_CODE code = <%d>, store_t *store = <%p>, void *user_context = <%p>", code, store, user_context)
+
+    communication_exchange_context_t *context = (communication_exchange_context_t *)user_context;
+
+    // Same as mcl_communication_process, the access token is renewed once and the data left in the store is exchanged again.
+    // Renewing the access token blocks the call to mcl_communication_poll until the response is received.
+    if ((MCL_UNAUTHORIZED == code) && (MCL_FALSE == context->access_token_renewed) && (MCL_TRUE == context->communication->state.initialized))
+    {
+        MCL_INFO("Exchange has failed. Trying to renew access token.");
+        context->access_token_renewed = MCL_TRUE;
+        code = http_processor_get_access_token(context->communication->http_processor);
+
+        if (MCL_EXCHANGE_ASYNC_IS_ACTIVE == code)
+        {
+            MCL_INFO("Access token can not be renewed while other exchange operations are in flight.");
+            code = MCL_UNAUTHORIZED;
+        }
+
+        if (MCL_OK == code)
+        {
+            MCL_INFO("Access token is obtained. Trying to exchange again.");
+            code = http_processor_exchange_async(context->communication->http_processor, store, _exchange_async_callback, context);
+        }
+
+        if (MCL_OK == code)
+        {
+            DEBUG_LEAVE("retVal = void");
+            return;
+        }
+
+        MCL_INFO("Exchange has failed.");
+    }
+
+    context->callback(code, store, context->user_context);
+    MCL_FREE(context);
+
+    DEBUG_LEAVE("retVal = void");
+}
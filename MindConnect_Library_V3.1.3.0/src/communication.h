@@ -17,6 +17,7 @@
 #define COMMUNICATION_H_
 
 #include "http_processor.h"
+#include "mcl/mcl_communication.h"
 
 /**
  * This data structure holds information about the state of the MCL library.
@@ -24,6 +25,7 @@
 typedef struct state_t
 {
     mcl_bool_t initialized; //!< Status of MCL initialization.
+    mcl_bool_t destroying;  //!< MCL_TRUE while the communication handle is being destroyed.
 } state_t;
 
 /**
@@ -36,4 +38,15 @@ typedef struct mcl_communication_t
     state_t state;                    //!< MCL state.
 } communication_t;
 
+/**
+ * State of an exchange operation started by #mcl_communication_exchange_async, passed to http processor as the user context.
+ */
+typedef struct communication_exchange_context_t
+{
+    communication_t *communication;                 //!< Communication handle the exchange operation is started with.
+    mcl_communication_exchange_callback_t callback; //!< Callback of the user to be called when the exchange operation is completed.
+    void *user_context;                             //!< User context passed to callback.
+    mcl_bool_t access_token_renewed;                //!< MCL_TRUE if the access token is renewed once for this exchange operation.
+} communication_exchange_context_t;
+
 #endif //COMMUNICATION_H_
@@ -0,0 +1,110 @@
+/*!**********************************************************************
+ *
+ * @copyright Copyright (C) 2018 Siemens Aktiengesellschaft.\n
+ *            All rights reserved.
+ *
+ *************************************************************************
+ *
+ * @file     compression.h
+ * @date     Oct 17, 2018
+ * @brief    Compression module header file.
+ *
+ * Inner compression interface. Compresses data given in parts into gzip format without keeping the whole data in memory.
+ * Implementation file might change depending on the platform and will be in compression_XXX.c format.
+ *
+ ************************************************************************/
+
+#ifndef COMPRESSION_H_
+#define COMPRESSION_H_
+
+#include "mcl/mcl_common.h"
+
+/**
+ * @brief To be used to start compressing data into gzip format.
+ *
+ * @param [out] compression Compression state. Must be freed with #compression_destroy.
+ * @return
+ * <ul>
+ * <li>#MCL_OK in case of success.</li>
+ * <li>#MCL_OUT_OF_MEMORY in case there is not enough memory in the system to proceed.</li>
+ * <li>#MCL_FAIL if compression can not be started.</li>
+ * </ul>
+ */
+E_MCL_ERROR_CODE compression_initialize(void **compression);
+
+/**
+ * @brief To be used to give the next part of data to be compressed.
+ *
+ * @p input must stay valid until #compression_needs_input returns MCL_TRUE.
+ *
+ * @param [in] compression Compression state created by #compression_initialize.
+ * @param [in] input Next part of data to be compressed.
+ * @param [in] input_size Size of @p input.
+ * @param [in] last_input MCL_TRUE if @p input is the last part of data, compressed data is completed after it.
+ */
+void compression_set_input(void *compression, const mcl_uint8_t *input, mcl_size_t input_size, mcl_bool_t last_input);
+
+/**
+ * @brief To be used to check if all of the data given with #compression_set_input is consumed.
+ *
+ * @param [in] compression Compression state created by #compression_initialize.
+ * @return MCL_TRUE if the next part of data can be given, MCL_FALSE otherwise.
+ */
+mcl_bool_t compression_needs_input(void *compression);
+
+/**
+ * @brief To be used to get the next part of compressed data.
+ *
+ * Compressed data may be held back until enough input is given, so @p written_size can be zero even if input is consumed.
+ *
+ * @param [in] compression Compression state created by #compression_initialize.
+ * @param [out] output Buffer to write compressed data to.
+ * @param [in] output_size Size of @p output.
+ * @param [out] written_size Number of bytes written to @p output.
+ * @return
+ * <ul>
+ * <li>#MCL_OK in case of success.</li>
+ * <li>#MCL_FAIL if compression fails.</li>
+ * </ul>
+ */
+E_MCL_ERROR_CODE compression_deflate(void *compression, mcl_uint8_t *output, mcl_size_t output_size, mcl_size_t *written_size);
+
+/**
+ * @brief To be used to check if compressed data is completed.
+ *
+ * @param [in] compression Compression state created by #compression_initialize.
+ * @return MCL_TRUE if the last input is consumed and all compressed data is written, MCL_FALSE otherwise.
+ */
+mcl_bool_t compression_is_finished(void *compression);
+
+/**
+ * @brief To be used to get the total sizes of data compressed so far.
+ *
+ * @param [in] compression Compression state created by #compression_initialize.
+ * @param [out] input_size Total size of data consumed.
+ * @param [out] output_size Total size of compressed data written.
+ */
+void compression_get_sizes(void *compression, mcl_size_t *input_size, mcl_size_t *output_size);
+
+/**
+ * @brief To be used to start compressing the same or new data from the beginning again, e.g. to resend a compressed request.
+ *
+ * Memory of the compression state is kept, totals returned by #compression_get_sizes start from zero.
+ *
+ * @param [in] compression Compression state created by #compression_initialize.
+ * @return
+ * <ul>
+ * <li>#MCL_OK in case of success.</li>
+ * <li>#MCL_FAIL if compression can not be restarted.</li>
+ * </ul>
+ */
+E_MCL_ERROR_CODE compression_reset(void *compression);
+
+/**
+ * @brief To be used to free the compression state.
+ *
+ * @param [in] compression Compression state created by #compression_initialize.
+ */
+void compression_destroy(void **compression);
+
+#endif //COMPRESSION_H_
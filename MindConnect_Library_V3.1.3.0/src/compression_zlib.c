@@ -0,0 +1,200 @@
+/*!**********************************************************************
+ *
+ * @copyright Copyright (C) 2016 Siemens Aktiengesellschaft.\n
+ *            All rights reserved.
+ *
+ *************************************************************************
+ *
+ * @file     compression_zlib.c
+ * @date     Oct 17, 2026
+ * @brief    Compression zlib module implementation file.
+ *
+ ************************************************************************/
+
+#define MEMORY_CATEGORY MCL_MEMORY_CATEGORY_HTTP
+
+#include "compression_zlib.h"
+#include "memory.h"
+#include "definitions.h"
+#include "log_util.h"
+
+#include <zlib.h>
+
+// Adding 16 to window bits makes zlib write gzip header and trailer instead of zlib wrapper.
+#define GZIP_ENCODING 16
+
+// Window of 8K bytes and memory level 7 keep the deflate state below 100K bytes per request while repeated ids
+// and names of neighbouring parts of a payload are still found in the window.
+#define COMPRESSION_WINDOW_BITS 13
+#define COMPRESSION_MEMORY_LEVEL 7
+
+// Data structure behind the compression state handle.
+typedef struct compression_zlib_t
+{
+    z_stream stream;        //!< Zlib deflate stream.
+    mcl_bool_t last_input;  //!< MCL_TRUE if the last part of data is given.
+    mcl_bool_t finished;    //!< MCL_TRUE if compressed data is completed.
+} compression_zlib_t;
+
+// This function is the memory allocation function of zlib.
+static voidpf _zlib_allocate(voidpf opaque, uInt count, uInt size);
+
+// This function is the memory release function of zlib.
+static void _zlib_free(voidpf opaque, voidpf address);
+
+E_MCL_ERROR_CODE compression_initialize(void **compression)
+{
+    DEBUG_ENTRY("void **compression = <%p>", compression)
+
+    compression_zlib_t *state;
+    int result;
+
+    ASSERT_CODE_MESSAGE(MCL_NULL != MCL_NEW(state), MCL_OUT_OF_MEMORY, "Memory can not be allocated for compression.");
+
+    state->stream.zalloc = _zlib_allocate;
+    state->stream.zfree = _zlib_free;
+    state->stream.opaque = MCL_NULL;
+    state->stream.next_in = MCL_NULL;
+    state->stream.avail_in = 0;
+    state->last_input = MCL_FALSE;
+    state->finished = MCL_FALSE;
+
+    result = deflateInit2(&(state->stream), Z_DEFAULT_COMPRESSION, Z_DEFLATED, COMPRESSION_WINDOW_BITS + GZIP_ENCODING, COMPRESSION_MEMORY_LEVEL, Z_DEFAULT_STRATEGY);
+    ASSERT_STATEMENT_CODE_MESSAGE(Z_OK == result, MCL_FREE(state), (Z_MEM_ERROR == result) ? MCL_OUT_OF_MEMORY : MCL_FAIL, "Zlib deflate stream can not be initialized.");
+
+    *compression = state;
+
+    DEBUG_LEAVE("retVal = <%d>", MCL_OK);
+    return MCL_OK;
+}
+
+void compression_set_input(void *compression, const mcl_uint8_t *input, mcl_size_t input_size, mcl_bool_t last_input)
+{
+    DEBUG_ENTRY("void *compression = <%p>, const mcl_uint8_t *input = <%p>, mcl_size_t input_size = <%u>, mcl_bool_t last_input = <%d>", compression, input,
+                input_size, last_input)
+
+    compression_zlib_t *state = (compression_zlib_t *)compression;
+
+    state->stream.next_in = (Bytef *)input;
+    state->stream.avail_in = (uInt)input_size;
+    state->last_input = last_input;
+
+    DEBUG_LEAVE("retVal = void");
+}
+
+mcl_bool_t compression_needs_input(void *compression)
+{
+    VERBOSE_ENTRY("void *compression = <%p>", compression)
+
+    compression_zlib_t *state = (compression_zlib_t *)compression;
+    mcl_bool_t needs_input = ((0 == state->stream.avail_in) && (MCL_FALSE == state->last_input)) ? MCL_TRUE : MCL_FALSE;
+
+    VERBOSE_LEAVE("retVal = <%d>", needs_input);
+    return needs_input;
+}
+
+E_MCL_ERROR_CODE compression_deflate(void *compression, mcl_uint8_t *output, mcl_size_t output_size, mcl_size_t *written_size)
+{
+    DEBUG_ENTRY("void *compression = <%p>, mcl_uint8_t *output = <%p>, mcl_size_t output_size = <%u>, mcl_size_t *written_size = <%p>", compression, output,
+                output_size, written_size)
+
+    compression_zlib_t *state = (compression_zlib_t *)compression;
+    int result;
+
+    *written_size = 0;
+
+    if (MCL_TRUE == state->finished)
+    {
+        DEBUG_LEAVE("retVal = <%d>", MCL_OK);
+        return MCL_OK;
+    }
+
+    state->stream.next_out = output;
+    state->stream.avail_out = (uInt)output_size;
+
+    result = deflate(&(state->stream), (MCL_TRUE == state->last_input) ? Z_FINISH : Z_NO_FLUSH);
+
+    // Z_BUF_ERROR only means no progress was possible with the given buffers.
+    ASSERT_CODE_MESSAGE((Z_OK == result) || (Z_STREAM_END == result) || (Z_BUF_ERROR == result), MCL_FAIL, "Zlib deflate failed.");
+
+    *written_size = output_size - state->stream.avail_out;
+
+    if (Z_STREAM_END == result)
+    {
+        state->finished = MCL_TRUE;
+    }
+
+    DEBUG_LEAVE("retVal = <%d>", MCL_OK);
+    return MCL_OK;
+}
+
+mcl_bool_t compression_is_finished(void *compression)
+{
+    VERBOSE_ENTRY("void *compression = <%p>", compression)
+
+    compression_zlib_t *state = (compression_zlib_t *)compression;
+
+    VERBOSE_LEAVE("retVal = <%d>", state->finished);
+    return state->finished;
+}
+
+void compression_get_sizes(void *compression, mcl_size_t *input_size, mcl_size_t *output_size)
+{
+    VERBOSE_ENTRY("void *compression = <%p>, mcl_size_t *input_size = <%p>, mcl_size_t *output_size = <%p>", compression, input_size, output_size)
+
+    compression_zlib_t *state = (compression_zlib_t *)compression;
+
+    *input_size = (mcl_size_t)state->stream.total_in;
+    *output_size = (mcl_size_t)state->stream.total_out;
+
+    VERBOSE_LEAVE("retVal = void");
+}
+
+E_MCL_ERROR_CODE compression_reset(void *compression)
+{
+    DEBUG_ENTRY("void *compression = <%p>", compression)
+
+    compression_zlib_t *state = (compression_zlib_t *)compression;
+
+    ASSERT_CODE_MESSAGE(Z_OK == deflateReset(&(state->stream)), MCL_FAIL, "Zlib deflate stream can not be reset.");
+
+    state->stream.next_in = MCL_NULL;
+    state->stream.avail_in = 0;
+    state->last_input = MCL_FALSE;
+    state->finished = MCL_FALSE;
+
+    DEBUG_LEAVE("retVal = <%d>", MCL_OK);
+    return MCL_OK;
+}
+
+void compression_destroy(void **compression)
+{
+    DEBUG_ENTRY("void **compression = <%p>", compression)
+
+    if (MCL_NULL != *compression)
+    {
+        deflateEnd(&(((compression_zlib_t *)*compression)->stream));
+        MCL_FREE(*compression);
+    }
+
+    DEBUG_LEAVE("retVal = void");
+}
+
+static voidpf _zlib_allocate(voidpf opaque, uInt count, uInt size)
+{
+    VERBOSE_ENTRY("voidpf opaque = <%p>, uInt count = <%u>, uInt size = <%u>", opaque, count, size)
+
+    voidpf address = MCL_MALLOC((mcl_size_t)count * size);
+
+    VERBOSE_LEAVE("retVal = <%p>", address);
+    return address;
+}
+
+static void _zlib_free(voidpf opaque, voidpf address)
+{
+    VERBOSE_ENTRY("voidpf opaque = <%p>, voidpf address = <%p>", opaque, address)
+
+    MCL_FREE(address);
+
+    VERBOSE_LEAVE("retVal = void");
+}
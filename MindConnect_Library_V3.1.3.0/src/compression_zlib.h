@@ -0,0 +1,21 @@
+/*!**********************************************************************
+ *
+ * @copyright Copyright (C) 2018 Siemens Aktiengesellschaft.\n
+ *            All rights reserved.
+ *
+ *************************************************************************
+ *
+ * @file     compression_zlib.h
+ * @date     Oct 17, 2018
+ * @brief    Compression zlib module header file.
+ *
+ * Zlib based implementation of compression interface.
+ *
+ ************************************************************************/
+
+#ifndef COMPRESSION_ZLIB_H_
+#define COMPRESSION_ZLIB_H_
+
+#include "compression.h"
+
+#endif //COMPRESSION_ZLIB_H_
@@ -59,5 +59,11 @@
 /* Define to 1 if you have the <openssl/pem.h> header file. */
 #cmakedefine HAVE_OPENSSL_PEM_H_ 1
 
+/* Define to 1 if you have zlib. */
+#cmakedefine MCL_HAVE_ZLIB 1
+
+/* Define to 1 to track memory usage per call site. */
+#cmakedefine MCL_MEMORY_TELEMETRY 1
+
 /* Define to 1 if you have the <time.h> header file. */
 #cmakedefine HAVE_TIME_H_ 1
\ No newline at end of file
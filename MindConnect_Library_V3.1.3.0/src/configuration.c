@@ -38,6 +38,12 @@ E_MCL_ERROR_CODE mcl_configuration_initialize(mcl_configuration_t **configuratio
     (*configuration)->security_profile = MCL_SECURITY_SHARED_SECRET;
     (*configuration)->max_http_payload_size = DEFAULT_HTTP_PAYLOAD_SIZE;
     (*configuration)->http_request_timeout = DEFAULT_HTTP_REQUEST_TIMEOUT;
+    (*configuration)->http_keep_alive = MCL_TRUE;
+    (*configuration)->http_connection_idle_timeout = DEFAULT_HTTP_CONNECTION_IDLE_TIMEOUT;
+    (*configuration)->http_connection_max_requests = DEFAULT_HTTP_CONNECTION_MAX_REQUESTS;
+    (*configuration)->tls_session_cache = MCL_FALSE;
+    (*configuration)->access_token_refresh_margin = DEFAULT_ACCESS_TOKEN_REFRESH_MARGIN;
+    (*configuration)->http_compression = MCL_FALSE;
     (*configuration)->user_agent = MCL_NULL;
     (*configuration)->initial_access_token = MCL_NULL;
     (*configuration)->tenant = MCL_NULL;
@@ -35,6 +35,12 @@ typedef struct configuration_t
     E_MCL_SECURITY_PROFILE security_profile;    //!< Security levels #E_MCL_SECURITY_PROFILE.
     mcl_size_t max_http_payload_size;           //!< Not valid for streamable request. Default value is 16K Bytes. Minimum value is 400 Bytes and maximum value is the maximum value of mcl_size_t.
     mcl_uint32_t http_request_timeout;          //!< Timeout value (in seconds) for HTTP requests. Default timeout is 300 seconds.
+    mcl_bool_t http_keep_alive;                 //!< Reuse the connection to MindSphere for consecutive HTTP requests instead of opening a new one for each request.
+    mcl_uint32_t http_connection_idle_timeout;  //!< Idle time (in seconds) after which a kept-alive connection is not reused anymore.
+    mcl_uint32_t http_connection_max_requests;  //!< Maximum number of HTTP requests sent over a single connection before it is closed. 0 means unlimited.
+    mcl_bool_t tls_session_cache;               //!< Save the last TLS session to the file #store_path with ".tls" suffix to resume it after restart.
+    mcl_uint32_t access_token_refresh_margin;   //!< Time (in seconds) before expiry of the access token within which it is renewed before exchanging.
+    mcl_bool_t http_compression;                //!< Compress the payload of exchange requests with gzip.
     string_t *user_agent;                       //!< User agent.
     string_t *initial_access_token;             //!< Initial access token. Not used by the library if a registration access token is present in #store_path.
 	string_t *registration_endpoint;			//!< Uri for registration endpoint
@@ -11,6 +11,8 @@
 *
 ************************************************************************/
 
+#define MEMORY_CATEGORY MCL_MEMORY_CATEGORY_STORE
+
 #include "custom_data.h"
 #include "memory.h"
 #include "log_util.h"
@@ -11,6 +11,8 @@
 *
 ************************************************************************/
 
+#define MEMORY_CATEGORY MCL_MEMORY_CATEGORY_STORE
+
 #include "mcl/mcl_data_source_configuration.h"
 #include "data_source_configuration.h"
 #include "log_util.h"
@@ -187,13 +189,11 @@ E_MCL_ERROR_CODE mcl_data_source_configuration_get_id(mcl_data_source_configurat
     code = string_initialize(data_source_configuration->payload.configuration_id, &configuration_id_local);
     ASSERT_CODE_MESSAGE(MCL_OK == code, MCL_OUT_OF_MEMORY, "Not enough memory left to create configuration_id!");
 
-    *id = configuration_id_local->buffer;
-
     // Free string and remain buffer
-    MCL_FREE(configuration_id_local);
+    code = string_detach(&configuration_id_local, id);
 
-    DEBUG_LEAVE("retVal = <%d>", MCL_OK);
-    return MCL_OK;
+    DEBUG_LEAVE("retVal = <%d>", code);
+    return code;
 }
 
 void data_source_configuration_destroy(data_source_configuration_t **data_source_configuration)
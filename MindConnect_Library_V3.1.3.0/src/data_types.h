@@ -94,24 +94,48 @@ typedef struct item_meta_t
 // ----------------- time_series_payload_t -----------------------------
 
 /**
- * @brief This struct is used for building time_series.payload.values structure.
+ * @brief Type of a value in time series value set.
  */
-typedef struct mcl_time_series_value_t
+typedef enum E_TIME_SERIES_VALUE_TYPE
 {
-    string_t *data_point_id; //!< Id of the datapoint the value is read from.
-    string_t *value;         //!< The value read.
-    string_t *quality_code;  //!< The quality of the value provided.
-} time_series_value_t;
+    TIME_SERIES_VALUE_TYPE_STRING, //!< Value is given as a string.
+    TIME_SERIES_VALUE_TYPE_DOUBLE, //!< Value is a double.
+    TIME_SERIES_VALUE_TYPE_INT64,  //!< Value is a 64 bit signed integer.
+    TIME_SERIES_VALUE_TYPE_BOOL    //!< Value is a boolean.
+} E_TIME_SERIES_VALUE_TYPE;
+
+/**
+ * @brief Holds a time series value in its own type. It is formatted only when the payload is serialized.
+ */
+typedef union time_series_value_data_t
+{
+    mcl_size_t string_offset; //!< Offset of the string value in the string pool of the value set.
+    double double_value;      //!< Double value.
+    mcl_int64_t int64_value;  //!< 64 bit signed integer value.
+    mcl_bool_t bool_value;    //!< Boolean value.
+} time_series_value_data_t;
 
 /**
  * @brief This struct is used for building value set of time series.
+ *
+ * Values are kept in columns, i-th element of each column belongs to the i-th value. Strings of the value set
+ * (data point ids, quality codes and string values) are kept null terminated in a single string pool.
  */
 typedef struct mcl_time_series_value_set_t
 {
     string_t *timestamp; //!< Time of values in YYYY-MM-DDThh:mm:ss.sssZ format.
 
-    // time_series_value_t
-    list_t *values; //!< List of measurements made at the given timestamp.
+    mcl_size_t value_count;                //!< Number of values in the value set.
+    mcl_size_t value_capacity;             //!< Number of values the columns can hold.
+    E_TIME_SERIES_VALUE_TYPE *value_types; //!< Column of value types.
+    time_series_value_data_t *values;      //!< Column of values.
+    mcl_size_t *data_point_ids;            //!< Column of data point ids in the intern table of the parent time series.
+    mcl_size_t *quality_codes;             //!< Column of quality code offsets in the string pool.
+
+    char *string_pool;                     //!< Strings of the value set.
+    mcl_size_t string_pool_size;           //!< Used size of the string pool.
+    mcl_size_t string_pool_capacity;       //!< Allocated size of the string pool.
+
     time_series_t *parent; //!< Parent of this time series.
 } time_series_value_set_t;
 
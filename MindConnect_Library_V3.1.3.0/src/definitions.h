@@ -56,6 +56,15 @@
 // 300 seconds is default http request timeout value.
 #define DEFAULT_HTTP_REQUEST_TIMEOUT (300)
 
+// 60 seconds is default idle time after which a kept-alive connection is not reused.
+#define DEFAULT_HTTP_CONNECTION_IDLE_TIMEOUT (60)
+
+// 100 requests is default limit for the number of requests sent over a single connection.
+#define DEFAULT_HTTP_CONNECTION_MAX_REQUESTS (100)
+
+// 60 seconds is default time before expiry of the access token within which it is renewed before exchanging.
+#define DEFAULT_ACCESS_TOKEN_REFRESH_MARGIN (60)
+
 // JWT used in authorization header has an expiration time of 24 hours.
 #define JWT_EXPIRATION_TIME 86400
 
@@ -11,6 +11,8 @@
 *
 ************************************************************************/
 
+#define MEMORY_CATEGORY MCL_MEMORY_CATEGORY_STORE
+
 #include "definitions.h"
 #include "event.h"
 #include "log_util.h"
@@ -32,6 +34,7 @@ E_MCL_ERROR_CODE event_initialize(item_meta_t *meta, const char* type, const cha
 	}
 
 	(*event)->meta = meta;
+	(*event)->arena = memory_arena_get_current();
 
 	if (MCL_NULL == MCL_NEW((*event)->payload))
 	{
@@ -79,10 +82,14 @@ E_MCL_ERROR_CODE mcl_event_set_option(mcl_event_t *event, E_MCL_EVENT_OPTION opt
     DEBUG_ENTRY("mcl_event_t *event = <%p>, E_MCL_EVENT_OPTION option = <%d>, const void *value = <%p>", event, option, value)
 
     E_MCL_ERROR_CODE code;
+    memory_arena_t *arena;
 
     ASSERT_NOT_NULL(event);
     ASSERT_NOT_NULL(value);
 
+    // Options are allocated from the arena of the store if event is.
+    arena = memory_arena_set_current(event->arena);
+
     switch (option)
     {
         case MCL_EVENT_OPTION_CORRELATION_ID:
@@ -101,6 +108,8 @@ E_MCL_ERROR_CODE mcl_event_set_option(mcl_event_t *event, E_MCL_EVENT_OPTION opt
             code = MCL_INVALID_PARAMETER;
     }
 
+    memory_arena_set_current(arena);
+
     DEBUG_LEAVE("retVal = <%d>", code);
     return code;
 }
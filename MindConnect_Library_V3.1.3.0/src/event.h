@@ -25,6 +25,7 @@ typedef struct mcl_event_t
 {
     item_meta_t *meta;                             //!< Meta of event.
     event_payload_t *payload;                      //!< Payload of event.
+    memory_arena_t *arena;                         //!< Arena of the store which event is allocated from, NULL if it is allocated from the heap.
 } event_t;
 
 /**
@@ -11,6 +11,8 @@
 *
 ************************************************************************/
 
+#define MEMORY_CATEGORY MCL_MEMORY_CATEGORY_STORE
+
 #include "event_list.h"
 #include "definitions.h"
 #include "log_util.h"
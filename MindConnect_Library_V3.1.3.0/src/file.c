@@ -11,6 +11,8 @@
 *
 ************************************************************************/
 
+#define MEMORY_CATEGORY MCL_MEMORY_CATEGORY_STORE
+
 #include "file.h"
 #include "definitions.h"
 #include "memory.h"
@@ -15,6 +15,16 @@
 #include "log_util.h"
 #include "definitions.h"
 
+#include <fcntl.h>
+
+#if defined(WIN32) || defined(WIN64)
+#include <io.h>
+#include <share.h>
+#include <sys/locking.h>
+#else
+#include <unistd.h>
+#endif
+
 #if !defined(S_ISREG) && defined(S_IFMT) && defined(S_IFREG)
 #define S_ISREG(m) (((m) & S_IFMT) == S_IFREG)
 #endif
@@ -49,6 +59,61 @@ E_MCL_ERROR_CODE file_util_fopen_without_log(const char *file_name, const char *
     return return_code;
 }
 
+E_MCL_ERROR_CODE file_util_fopen_private(const char *file_name, void **file_descriptor)
+{
+    DEBUG_ENTRY("const char *file_name = <%s>, void **file_descriptor = <%p>", file_name, file_descriptor)
+
+    E_MCL_ERROR_CODE return_code = MCL_FAIL;
+    FILE *file = MCL_NULL;
+    int descriptor;
+
+#if defined(WIN32) || defined(WIN64)
+    // Access of other users is controlled by the ACL of the directory on Windows, the file is only made inaccessible to other processes while open.
+    if (0 != _sopen_s(&descriptor, file_name, _O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY, _SH_DENYRW, _S_IREAD | _S_IWRITE))
+    {
+        descriptor = -1;
+    }
+
+    if (-1 != descriptor)
+    {
+        file = _fdopen(descriptor, "wb");
+
+        if (MCL_NULL == file)
+        {
+            _close(descriptor);
+        }
+    }
+#else
+    descriptor = open(file_name, O_WRONLY | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR);
+
+    // Permissions given to open() apply only if the file is created, an existing file is restricted too.
+    if ((-1 != descriptor) && (0 != fchmod(descriptor, S_IRUSR | S_IWUSR)))
+    {
+        close(descriptor);
+        descriptor = -1;
+    }
+
+    if (-1 != descriptor)
+    {
+        file = fdopen(descriptor, "wb");
+
+        if (MCL_NULL == file)
+        {
+            close(descriptor);
+        }
+    }
+#endif
+
+    *file_descriptor = file;
+    if (MCL_NULL != file)
+    {
+        return_code = MCL_OK;
+    }
+
+    DEBUG_LEAVE("retVal = <%d>", return_code);
+    return return_code;
+}
+
 E_MCL_ERROR_CODE file_util_fclose(void *file_descriptor)
 {
     DEBUG_ENTRY("void *file_descriptor = <%p>", file_descriptor)
@@ -213,6 +278,151 @@ E_MCL_ERROR_CODE file_util_fflush_without_log(void *file_descriptor)
     return return_code;
 }
 
+E_MCL_ERROR_CODE file_util_fseek(void *file_descriptor, mcl_size_t offset)
+{
+    DEBUG_ENTRY("void *file_descriptor = <%p>, mcl_size_t offset = <%u>", file_descriptor, offset)
+
+    E_MCL_ERROR_CODE return_code = MCL_FAIL;
+
+    int result = fseek((FILE *)file_descriptor, (long)offset, SEEK_SET);
+    if (0 == result)
+    {
+        return_code = MCL_OK;
+    }
+    else
+    {
+        MCL_ERROR("Error in seek.");
+    }
+
+    DEBUG_LEAVE("retVal = <%d>", return_code);
+    return return_code;
+}
+
+E_MCL_ERROR_CODE file_util_ftell(void *file_descriptor, mcl_size_t *offset)
+{
+    DEBUG_ENTRY("void *file_descriptor = <%p>, mcl_size_t *offset = <%p>", file_descriptor, offset)
+
+    E_MCL_ERROR_CODE return_code = MCL_FAIL;
+
+    long result = ftell((FILE *)file_descriptor);
+    if (0 <= result)
+    {
+        *offset = (mcl_size_t)result;
+        return_code = MCL_OK;
+    }
+    else
+    {
+        MCL_ERROR("Error in tell.");
+    }
+
+    DEBUG_LEAVE("retVal = <%d>", return_code);
+    return return_code;
+}
+
+E_MCL_ERROR_CODE file_util_fsync(void *file_descriptor)
+{
+    DEBUG_ENTRY("void *file_descriptor = <%p>", file_descriptor)
+
+    E_MCL_ERROR_CODE return_code = file_util_fflush(file_descriptor);
+
+    int result;
+
+    if (MCL_OK == return_code)
+    {
+#if defined(WIN32) || defined(WIN64)
+        result = _commit(_fileno((FILE *)file_descriptor));
+#else
+        result = fsync(fileno((FILE *)file_descriptor));
+#endif
+
+        if (0 != result)
+        {
+            MCL_ERROR("Error in synchronizing file to storage.");
+            return_code = MCL_FAIL;
+        }
+    }
+
+    DEBUG_LEAVE("retVal = <%d>", return_code);
+    return return_code;
+}
+
+E_MCL_ERROR_CODE file_util_lock(void *file_descriptor)
+{
+    DEBUG_ENTRY("void *file_descriptor = <%p>", file_descriptor)
+
+    E_MCL_ERROR_CODE return_code = MCL_FAIL;
+
+    int result;
+
+    // First byte of the file is locked, the file does not need to have any content.
+#if defined(WIN32) || defined(WIN64)
+    fseek((FILE *)file_descriptor, 0, SEEK_SET);
+    result = _locking(_fileno((FILE *)file_descriptor), _LK_NBLCK, 1);
+#else
+    fseek((FILE *)file_descriptor, 0, SEEK_SET);
+    result = lockf(fileno((FILE *)file_descriptor), F_TLOCK, 1);
+#endif
+
+    if (0 == result)
+    {
+        return_code = MCL_OK;
+    }
+    else
+    {
+        MCL_DEBUG("File can not be locked.");
+    }
+
+    DEBUG_LEAVE("retVal = <%d>", return_code);
+    return return_code;
+}
+
+E_MCL_ERROR_CODE file_util_remove(const char *file_name)
+{
+    DEBUG_ENTRY("const char *file_name = <%s>", file_name)
+
+    E_MCL_ERROR_CODE return_code = MCL_FAIL;
+
+    int result = remove(file_name);
+    if (0 == result)
+    {
+        return_code = MCL_OK;
+    }
+    else
+    {
+        MCL_DEBUG("File can not be removed.");
+    }
+
+    DEBUG_LEAVE("retVal = <%d>", return_code);
+    return return_code;
+}
+
+E_MCL_ERROR_CODE file_util_rename(const char *old_name, const char *new_name)
+{
+    DEBUG_ENTRY("const char *old_name = <%s>, const char *new_name = <%s>", old_name, new_name)
+
+    E_MCL_ERROR_CODE return_code = MCL_FAIL;
+
+    int result;
+
+#if defined(WIN32) || defined(WIN64)
+    // rename() does not replace an existing file on Windows.
+    remove(new_name);
+#endif
+    result = rename(old_name, new_name);
+
+    if (0 == result)
+    {
+        return_code = MCL_OK;
+    }
+    else
+    {
+        MCL_ERROR("File can not be renamed.");
+    }
+
+    DEBUG_LEAVE("retVal = <%d>", return_code);
+    return return_code;
+}
+
 mcl_bool_t file_util_check_if_regular_file(const mcl_stat_t *file_attributes)
 {
     DEBUG_ENTRY("const mcl_stat_t *file_attributes = <%p>", file_attributes)
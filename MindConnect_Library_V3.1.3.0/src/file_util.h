@@ -54,6 +54,20 @@ E_MCL_ERROR_CODE file_util_fopen(const char *file_name, const char *mode, void *
  */
 E_MCL_ERROR_CODE file_util_fopen_without_log(const char *file_name, const char *mode, void **file_descriptor);
 
+/**
+ * This function creates the file @p file_name, or truncates it if it exists, and opens it for writing in binary mode.
+ * Only the owner of the file can read or write it.
+ *
+ * @param [in] file_name File name to open.
+ * @param [out] file_descriptor File descriptor for the file opened. This descriptor is used to process the file.
+ * @return
+ * <ul>
+ * <li>#MCL_OK in case of success.</li>
+ * <li>#MCL_FAIL in case the file can not be opened.</li>
+ * </ul>
+ */
+E_MCL_ERROR_CODE file_util_fopen_private(const char *file_name, void **file_descriptor);
+
 /**
  * This function is used to close the file opened beforehand.
  *
@@ -190,6 +204,85 @@ E_MCL_ERROR_CODE file_util_fflush(void *file_descriptor);
  */
 E_MCL_ERROR_CODE file_util_fflush_without_log(void *file_descriptor);
 
+/**
+ * This function sets the position of @p file_descriptor to @p offset bytes from the beginning of the file.
+ *
+ * @param [in] file_descriptor File descriptor obtained by opening the file.
+ * @param [in] offset New position in the file.
+ * @return
+ * <ul>
+ * <li>#MCL_OK in case of success.</li>
+ * <li>#MCL_FAIL in case of failure.</li>
+ * </ul>
+ */
+E_MCL_ERROR_CODE file_util_fseek(void *file_descriptor, mcl_size_t offset);
+
+/**
+ * This function gets the current position of @p file_descriptor as the number of bytes from the beginning of the file.
+ *
+ * @param [in] file_descriptor File descriptor obtained by opening the file.
+ * @param [out] offset Current position in the file.
+ * @return
+ * <ul>
+ * <li>#MCL_OK in case of success.</li>
+ * <li>#MCL_FAIL in case of failure.</li>
+ * </ul>
+ */
+E_MCL_ERROR_CODE file_util_ftell(void *file_descriptor, mcl_size_t *offset);
+
+/**
+ * This function flushes pending content of @p file_descriptor and waits until it is written to the storage medium.
+ *
+ * Unlike #file_util_fflush(), content synchronized by this function survives a power loss.
+ *
+ * @param [in] file_descriptor File descriptor obtained by opening the file.
+ * @return
+ * <ul>
+ * <li>#MCL_OK in case of success.</li>
+ * <li>#MCL_FAIL in case of failure.</li>
+ * </ul>
+ */
+E_MCL_ERROR_CODE file_util_fsync(void *file_descriptor);
+
+/**
+ * This function locks the file of @p file_descriptor against other processes without waiting.
+ *
+ * Lock is advisory, it is held until the file is closed or the process exits.
+ *
+ * @param [in] file_descriptor File descriptor obtained by opening the file in a writable mode.
+ * @return
+ * <ul>
+ * <li>#MCL_OK in case of success.</li>
+ * <li>#MCL_FAIL in case the file is locked by another process or can not be locked.</li>
+ * </ul>
+ */
+E_MCL_ERROR_CODE file_util_lock(void *file_descriptor);
+
+/**
+ * This function removes the file with the name @p file_name.
+ *
+ * @param [in] file_name Name of the file to remove.
+ * @return
+ * <ul>
+ * <li>#MCL_OK in case of success.</li>
+ * <li>#MCL_FAIL in case of failure.</li>
+ * </ul>
+ */
+E_MCL_ERROR_CODE file_util_remove(const char *file_name);
+
+/**
+ * This function renames the file @p old_name as @p new_name. If a file named @p new_name already exists, it is replaced.
+ *
+ * @param [in] old_name Current name of the file.
+ * @param [in] new_name New name of the file.
+ * @return
+ * <ul>
+ * <li>#MCL_OK in case of success.</li>
+ * <li>#MCL_FAIL in case of failure.</li>
+ * </ul>
+ */
+E_MCL_ERROR_CODE file_util_rename(const char *old_name, const char *new_name);
+
 /**
  * This function is used to check if file is a regular file.
  *
@@ -11,6 +11,8 @@
  *
  ************************************************************************/
 
+#define MEMORY_CATEGORY MCL_MEMORY_CATEGORY_SECURITY
+
 #include "hmac.h"
 #include "memory.h"
 #include "security.h"
@@ -24,21 +26,34 @@
 static const mcl_uint8_t hmac_ipad = 0x36;
 static const mcl_uint8_t hmac_opad = 0x5C;
 
+// Absorbs key XOR pad padded to HMAC_MAXIMUM_KEY_SIZE into the SHA256 state.
+static E_MCL_ERROR_CODE _absorb_padded_key(void *state, const mcl_uint8_t *key, mcl_size_t key_size, mcl_uint8_t pad);
+
 E_MCL_ERROR_CODE hmac_sha256(const mcl_uint8_t *data, mcl_size_t data_size, const mcl_uint8_t *key, mcl_size_t key_size, mcl_uint8_t **hash, mcl_size_t *hash_size)
 {
     DEBUG_ENTRY("const mcl_uint8_t *data = <%p>, mcl_size_t data_size = <%u>, const mcl_uint8_t *key = <%p>, mcl_size_t key_size = <%u>, mcl_uint8_t **hash = <%p>, mcl_size_t *hash_size = <%p>",
                 data, data_size, key, key_size, hash, hash_size)
 
+	hmac_sha256_t *hmac = MCL_NULL;
+    E_MCL_ERROR_CODE code = hmac_sha256_initialize(key, key_size, &hmac);
+
+    (MCL_OK == code) && (code = hmac_sha256_start(hmac));
+    (MCL_OK == code) && (code = hmac_sha256_update(hmac, data, data_size));
+    (MCL_OK == code) && (code = hmac_sha256_finish(hmac, hash, hash_size));
+
+    hmac_sha256_destroy(&hmac);
+
+    DEBUG_LEAVE("retVal = <%d>", code);
+    return code;
+}
+
+E_MCL_ERROR_CODE hmac_sha256_initialize(const mcl_uint8_t *key, mcl_size_t key_size, hmac_sha256_t **hmac)
+{
+    DEBUG_ENTRY("const mcl_uint8_t *key = <%p>, mcl_size_t key_size = <%u>, hmac_sha256_t **hmac = <%p>", key, key_size, hmac)
+
 	const mcl_uint8_t *key_local = key;
     E_MCL_ERROR_CODE code;
     mcl_size_t key_local_size = key_size;
-    mcl_size_t index = 0;
-	mcl_size_t key_ipad_size;
-	mcl_uint8_t *key_ipad;
-	mcl_size_t key_opad_size;
-	mcl_uint8_t *key_opad;
-	mcl_uint8_t *sha_output = MCL_NULL;
-	mcl_size_t sha_output_size;
 
     // If the key is too long, replace it by its hash sha256.
     mcl_uint8_t *key_resized = MCL_NULL;
@@ -57,111 +72,117 @@ E_MCL_ERROR_CODE hmac_sha256(const mcl_uint8_t *data, mcl_size_t data_size, cons
         key_local = key_resized;
     }
 
-    // allocate buffers for key_ipad/key_opad
-    MCL_DEBUG("Preparing buffers key_ipad and key_opad.");
+    MCL_NEW(*hmac);
+    ASSERT_STATEMENT_CODE_MESSAGE(MCL_NULL != *hmac, MCL_FREE(key_resized), MCL_OUT_OF_MEMORY, "Memory can not be allocated for HMAC handle!");
+    (*hmac)->inner_state = MCL_NULL;
+    (*hmac)->outer_state = MCL_NULL;
+    (*hmac)->state = MCL_NULL;
+
+    // Key XOR ipad and key XOR opad are hashed once here, calculations continue from these states.
+    MCL_DEBUG("Absorbing XORed key into inner and outer SHA256 states.");
+    code = security_sha256_initialize(&(*hmac)->inner_state);
+    (MCL_OK == code) && (code = security_sha256_initialize(&(*hmac)->outer_state));
+    (MCL_OK == code) && (code = security_sha256_initialize(&(*hmac)->state));
+    (MCL_OK == code) && (code = _absorb_padded_key((*hmac)->inner_state, key_local, key_local_size, hmac_ipad));
+    (MCL_OK == code) && (code = _absorb_padded_key((*hmac)->outer_state, key_local, key_local_size, hmac_opad));
 
-    key_ipad_size = HMAC_MAXIMUM_KEY_SIZE + data_size;
-    key_ipad = MCL_MALLOC(key_ipad_size);
+    MCL_FREE(key_resized);
 
-    if (MCL_NULL == key_ipad)
+    if (MCL_OK != code)
     {
-        if (key_resized == key_local)
-        {
-            MCL_FREE(key_resized);
-        }
-        MCL_ERROR_RETURN(MCL_OUT_OF_MEMORY, "Memory to hold input data for XOR operation with ipad couldn't be allocated!");
+        hmac_sha256_destroy(hmac);
+        MCL_ERROR_RETURN(code, "HMAC handle can not be initialized!");
     }
 
-    key_opad_size = HMAC_MAXIMUM_KEY_SIZE + HMAC_SHA256_SIZE;
-    key_opad = MCL_MALLOC(key_opad_size);
+    DEBUG_LEAVE("retVal = <%d>", MCL_OK);
+    return MCL_OK;
+}
 
-    if (MCL_NULL == key_opad)
-    {
-        MCL_FREE(key_ipad);
-        if (key_resized == key_local)
-        {
-            MCL_FREE(key_resized);
-        }
-        MCL_ERROR_RETURN(MCL_OUT_OF_MEMORY, "Memory to hold input data for XOR operation with opad couldn't be allocated!");
-    }
+E_MCL_ERROR_CODE hmac_sha256_start(hmac_sha256_t *hmac)
+{
+    DEBUG_ENTRY("hmac_sha256_t *hmac = <%p>", hmac)
 
-    // initialize buffers as long as the key is sized
-    for (index = 0; index < key_local_size; index++)
-    {
-        key_ipad[index] = key_local[index] ^ hmac_ipad;
-        key_opad[index] = key_local[index] ^ hmac_opad;
-    }
+    E_MCL_ERROR_CODE code = security_sha256_copy(hmac->state, hmac->inner_state);
 
-    // Release key_local if calculated new
-    if (key_resized == key_local)
-    {
-        MCL_FREE(key_resized);
-    }
+    DEBUG_LEAVE("retVal = <%d>", code);
+    return code;
+}
 
-    // initialize the rest with hmac_ipad/hamc_opad
-    for (index = key_local_size; index < HMAC_MAXIMUM_KEY_SIZE; index++)
-    {
-        key_ipad[index] = hmac_ipad;
-        key_opad[index] = hmac_opad;
-    }
+E_MCL_ERROR_CODE hmac_sha256_update(hmac_sha256_t *hmac, const mcl_uint8_t *data, mcl_size_t data_size)
+{
+    DEBUG_ENTRY("hmac_sha256_t *hmac = <%p>, const mcl_uint8_t *data = <%p>, mcl_size_t data_size = <%u>", hmac, data, data_size)
 
-    // copy given data
-    MCL_DEBUG("Copying data to buffer.");
-    string_util_memcpy(&key_ipad[HMAC_MAXIMUM_KEY_SIZE], data, data_size);
+    E_MCL_ERROR_CODE code = security_sha256_update(hmac->state, data, data_size);
 
-    // calculate SHA256 for key_ipad
-    MCL_DEBUG("Calculating first SHA256 from XORed key + data");
+    DEBUG_LEAVE("retVal = <%d>", code);
+    return code;
+}
 
-    code = security_hash_sha256(key_ipad, key_ipad_size, &sha_output, &sha_output_size);
+E_MCL_ERROR_CODE hmac_sha256_finish(hmac_sha256_t *hmac, mcl_uint8_t **hash, mcl_size_t *hash_size)
+{
+    DEBUG_ENTRY("hmac_sha256_t *hmac = <%p>, mcl_uint8_t **hash = <%p>, mcl_size_t *hash_size = <%p>", hmac, hash, hash_size)
 
-    if (MCL_OK != code)
-    {
-        MCL_FREE(key_ipad);
-        MCL_FREE(key_opad);
-        MCL_FREE(sha_output);
+	E_MCL_ERROR_CODE code;
+	mcl_uint8_t inner_hash[HMAC_SHA256_SIZE];
 
-        MCL_ERROR_RETURN(code, "SHA256 calculation for key_ipad failed!");
-    }
+    *hash_size = 0;
+    *hash = MCL_MALLOC(HMAC_SHA256_SIZE);
+    ASSERT_CODE_MESSAGE(MCL_NULL != *hash, MCL_OUT_OF_MEMORY, "Memory to hold HMAC SHA256 result couldn't be allocated!");
 
-    if (HMAC_SHA256_SIZE != sha_output_size)
-    {
-        MCL_FREE(key_ipad);
-        MCL_FREE(key_opad);
-        MCL_FREE(sha_output);
+    // SHA256(key XOR opad + SHA256(key XOR ipad + data))
+    code = security_sha256_finalize(hmac->state, inner_hash);
+    (MCL_OK == code) && (code = security_sha256_copy(hmac->state, hmac->outer_state));
+    (MCL_OK == code) && (code = security_sha256_update(hmac->state, inner_hash, HMAC_SHA256_SIZE));
+    (MCL_OK == code) && (code = security_sha256_finalize(hmac->state, *hash));
 
-        MCL_ERROR_RETURN(MCL_SHA256_CALCULATION_FAIL, "SHA256 calculation for key_ipad failed!");
+    if (MCL_OK != code)
+    {
+        MCL_FREE(*hash);
+        MCL_ERROR_RETURN(code, "HMAC SHA256 calculation failed!");
     }
 
-    // set SHA256 output to key_opad
-    MCL_DEBUG("Copying first SHA256 result to buffer.");
-    string_util_memcpy(&key_opad[HMAC_MAXIMUM_KEY_SIZE], sha_output, sha_output_size);
+    *hash_size = HMAC_SHA256_SIZE;
+    MCL_DEBUG("HMAC SHA256 calculated hash = <%p>, hash_size = <%u>", *hash, *hash_size);
 
-    // calculate SHA256 for key_opad
-    MCL_DEBUG("Calculating second SHA256 from XORed key + <first SHA256>");
-    code = security_hash_sha256(key_opad, key_opad_size, hash, hash_size);
+    DEBUG_LEAVE("retVal = <%d>", MCL_OK);
+    return MCL_OK;
+}
 
-    MCL_FREE(key_ipad);
-    MCL_FREE(key_opad);
-    MCL_FREE(sha_output);
+void hmac_sha256_destroy(hmac_sha256_t **hmac)
+{
+    DEBUG_ENTRY("hmac_sha256_t **hmac = <%p>", hmac)
 
-    if (MCL_OK != code)
+    if (MCL_NULL != *hmac)
     {
-        MCL_FREE(*hash);
-        *hash_size = 0;
-        MCL_ERROR_RETURN(code, "SHA256 calculation for key_opad failed!");
+        security_sha256_destroy(&(*hmac)->inner_state);
+        security_sha256_destroy(&(*hmac)->outer_state);
+        security_sha256_destroy(&(*hmac)->state);
+        MCL_FREE(*hmac);
     }
 
-    if ((MCL_NULL != *hash) && (HMAC_SHA256_SIZE != *hash_size))
+    DEBUG_LEAVE("retVal = void");
+}
+
+static E_MCL_ERROR_CODE _absorb_padded_key(void *state, const mcl_uint8_t *key, mcl_size_t key_size, mcl_uint8_t pad)
+{
+    DEBUG_ENTRY("void *state = <%p>, const mcl_uint8_t *key = <%p>, mcl_size_t key_size = <%u>, mcl_uint8_t pad = <%u>", state, key, key_size, pad)
+
+	E_MCL_ERROR_CODE code;
+	mcl_uint8_t padded_key[HMAC_MAXIMUM_KEY_SIZE];
+    mcl_size_t index;
+
+    for (index = 0; index < key_size; index++)
     {
-        MCL_FREE(*hash);
-        *hash_size = 0;
-        MCL_ERROR_RETURN(MCL_SHA256_CALCULATION_FAIL, "SHA256 calculation for key_opad failed!");
+        padded_key[index] = key[index] ^ pad;
     }
-    else
+
+    for (index = key_size; index < HMAC_MAXIMUM_KEY_SIZE; index++)
     {
-        MCL_DEBUG("HMAC SHA256 calculated hash = <%p>, hash_size = <%u>", *hash, *hash_size);
+        padded_key[index] = pad;
     }
 
-    DEBUG_LEAVE("retVal = <%d>", MCL_OK);
-    return MCL_OK;
+    code = security_sha256_update(state, padded_key, HMAC_MAXIMUM_KEY_SIZE);
+
+    DEBUG_LEAVE("retVal = <%d>", code);
+    return code;
 }
@@ -18,6 +18,16 @@
 
 #include "mcl/mcl_common.h"
 
+/**
+ * HMAC SHA256 handle keeping SHA256 states of the padded key to be reused for each calculation with the same key.
+ */
+typedef struct hmac_sha256_t
+{
+    void *inner_state; //!< SHA256 state after absorbing key XOR ipad.
+    void *outer_state; //!< SHA256 state after absorbing key XOR opad.
+    void *state;       //!< SHA256 state of the ongoing calculation.
+} hmac_sha256_t;
+
 /**
  * Calculates HMAC SHA256 for given data with provided secret @p key.
  * If secret @p key exceeds maximum allowed size of 64 bytes it will be reduced to 32 bytes.
@@ -39,4 +49,70 @@
  */
 E_MCL_ERROR_CODE hmac_sha256(const mcl_uint8_t *data, mcl_size_t data_size, const mcl_uint8_t *key, mcl_size_t key_size, mcl_uint8_t **hash, mcl_size_t *hash_size);
 
+/**
+ * Creates an HMAC SHA256 handle for the secret @p key. Key is padded and absorbed once here
+ * so that following calculations with the handle only hash the data.
+ * If secret @p key exceeds maximum allowed size of 64 bytes it will be reduced to its SHA256 hash.
+ *
+ * @param [in] key Secret key to be used during calculations.
+ * @param [in] key_size Size of @p key.
+ * @param [out] hmac Newly created handle. Must be freed with #hmac_sha256_destroy.
+ * @return
+ * <ul>
+ * <li>#MCL_OK in case of success.</li>
+ * <li>#MCL_INVALID_PARAMETER if @p key_size is zero.</li>
+ * <li>#MCL_OUT_OF_MEMORY in case there is not enough memory in the system to proceed.</li>
+ * <li>#MCL_SHA256_CALCULATION_FAIL if SHA256 calculation fails.</li>
+ * </ul>
+ */
+E_MCL_ERROR_CODE hmac_sha256_initialize(const mcl_uint8_t *key, mcl_size_t key_size, hmac_sha256_t **hmac);
+
+/**
+ * Starts a new HMAC SHA256 calculation with @p hmac. Data is given by #hmac_sha256_update in one or more parts.
+ *
+ * @param [in] hmac HMAC SHA256 handle.
+ * @return
+ * <ul>
+ * <li>#MCL_OK in case of success.</li>
+ * <li>#MCL_SHA256_CALCULATION_FAIL if SHA256 calculation fails.</li>
+ * </ul>
+ */
+E_MCL_ERROR_CODE hmac_sha256_start(hmac_sha256_t *hmac);
+
+/**
+ * Adds the next part of data to the HMAC SHA256 calculation started by #hmac_sha256_start.
+ *
+ * @param [in] hmac HMAC SHA256 handle.
+ * @param [in] data Next part of data to calculate HMAC SHA256 for.
+ * @param [in] data_size Size of @p data.
+ * @return
+ * <ul>
+ * <li>#MCL_OK in case of success.</li>
+ * <li>#MCL_SHA256_CALCULATION_FAIL if SHA256 calculation fails.</li>
+ * </ul>
+ */
+E_MCL_ERROR_CODE hmac_sha256_update(hmac_sha256_t *hmac, const mcl_uint8_t *data, mcl_size_t data_size);
+
+/**
+ * Ends the HMAC SHA256 calculation and returns its result. @p hmac can be started again for a new calculation.
+ *
+ * @param [in] hmac HMAC SHA256 handle.
+ * @param [out] hash A newly allocated memory which contains the result of HMAC SHA256.
+ * @param [out] hash_size Size of @p hash, which is 32 bytes.
+ * @return
+ * <ul>
+ * <li>#MCL_OK in case of success.</li>
+ * <li>#MCL_OUT_OF_MEMORY in case there is not enough memory in the system to proceed.</li>
+ * <li>#MCL_SHA256_CALCULATION_FAIL if SHA256 calculation fails.</li>
+ * </ul>
+ */
+E_MCL_ERROR_CODE hmac_sha256_finish(hmac_sha256_t *hmac, mcl_uint8_t **hash, mcl_size_t *hash_size);
+
+/**
+ * Frees the HMAC SHA256 handle.
+ *
+ * @param [in] hmac HMAC SHA256 handle to be freed. It is set to NULL.
+ */
+void hmac_sha256_destroy(hmac_sha256_t **hmac);
+
 #endif //HMAC_H_
@@ -25,10 +25,13 @@
 
 typedef mcl_size_t (*http_client_read_callback)(void *buffer, mcl_size_t size, mcl_size_t count, void *user_context);
 
+typedef void (*http_client_idle_callback)(void *user_context);
+
 typedef struct http_client_send_callback_info_t
 {
     http_client_read_callback read_callback;
     void *user_context;
+    http_client_idle_callback idle_callback;
 } http_client_send_callback_info_t;
 
 /**
@@ -36,6 +39,15 @@ typedef struct http_client_send_callback_info_t
  */
 typedef struct http_client_t http_client_t;
 
+/**
+ * @brief Callback function prototype called when an asynchronous send operation is completed.
+ *
+ * @param [in] code Result of the send operation. See #http_client_send for possible values.
+ * @param [in] http_response HTTP Response object if @p code is #MCL_OK, NULL otherwise. Ownership is passed to the callback.
+ * @param [in] user_context User context given to #http_client_send_async.
+ */
+typedef void (*http_client_send_complete_callback)(E_MCL_ERROR_CODE code, http_response_t *http_response, void *user_context);
+
 /**
  * @brief HTTP Client initializer.
  *
@@ -56,7 +68,9 @@ E_MCL_ERROR_CODE http_client_initialize(configuration_t *configuration, http_cli
  * @brief Send/Receive function.
  *
  * Using underlying implementation, it sends the given data to the pre-configured destination and returns the response.
- * This function is blocking until response received or timeout occurred.
+ * This function is blocking until response received or timeout occurred. Transfers started by #http_client_send_async
+ * are progressed while waiting. If @p callback_info has an idle callback, it is called each time the request is waiting
+ * for network activity, so that the caller can do other work while the request is in flight.
  *
  * @param [in] http_client HTTP Client Handler.
  * @param [in] http_request HTTP Request object.
@@ -80,6 +94,45 @@ E_MCL_ERROR_CODE http_client_initialize(configuration_t *configuration, http_cli
  */
 E_MCL_ERROR_CODE http_client_send(http_client_t *http_client, http_request_t *http_request, http_client_send_callback_info_t *callback_info, http_response_t **http_response);
 
+/**
+ * @brief Asynchronous send function.
+ *
+ * Starts sending the given request without blocking. The transfer is progressed by #http_client_perform
+ * and @p complete_callback is called from within #http_client_perform when the response is received or the transfer fails.
+ * @p http_request and @p callback_info must be kept valid until @p complete_callback is called.
+ *
+ * @param [in] http_client HTTP Client Handler.
+ * @param [in] http_request HTTP Request object.
+ * @param [in] callback_info Struct holding callback information. Refer to its definition @p http_client_send_callback_info_t.
+ * @param [in] complete_callback Callback function to be called when the transfer is completed.
+ * @param [in] user_context User context passed to @p complete_callback.
+ * @return
+ * <ul>
+ * <li>#MCL_OK in case the transfer is started.</li>
+ * <li>#MCL_OUT_OF_MEMORY in case there is not enough memory in the system to proceed.</li>
+ * <li>#MCL_FAIL in case the transfer can not be started.</li>
+ * </ul>
+ */
+E_MCL_ERROR_CODE http_client_send_async(http_client_t *http_client, http_request_t *http_request, http_client_send_callback_info_t *callback_info,
+        http_client_send_complete_callback complete_callback, void *user_context);
+
+/**
+ * @brief Progresses the transfers started by #http_client_send_async.
+ *
+ * Waits at most @p timeout milliseconds for network activity, performs the pending transfers and
+ * calls the completion callbacks of the transfers which are completed.
+ *
+ * @param [in] http_client HTTP Client Handler.
+ * @param [in] timeout Maximum time in milliseconds to wait for network activity.
+ * @param [out] pending_count Number of transfers still in flight. Optional, can be NULL.
+ * @return
+ * <ul>
+ * <li>#MCL_OK in case of success.</li>
+ * <li>#MCL_FAIL in case of an internal error of the underlying implementation.</li>
+ * </ul>
+ */
+E_MCL_ERROR_CODE http_client_perform(http_client_t *http_client, mcl_uint32_t timeout, mcl_size_t *pending_count);
+
 /**
  * @brief To destroy the HTTP Client Handler.
  *
@@ -89,6 +142,15 @@ E_MCL_ERROR_CODE http_client_send(http_client_t *http_client, http_request_t *ht
  */
 void http_client_destroy(http_client_t **http_client);
 
+/**
+ * @brief To get the connection reuse statistics of the HTTP Client Handler.
+ *
+ * @param [in] http_client HTTP Client Handler.
+ * @param [out] connections_opened Number of requests for which a new connection is opened.
+ * @param [out] connections_reused Number of requests for which an existing connection is reused.
+ */
+void http_client_get_connection_statistics(http_client_t *http_client, mcl_size_t *connections_opened, mcl_size_t *connections_reused);
+
 /**
  * @brief To get the implementation specific code for returning from callback function in order to terminate the send operation.
  *
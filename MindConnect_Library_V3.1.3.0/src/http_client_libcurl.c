@@ -13,16 +13,27 @@
  *
  ************************************************************************/
 
+#define MEMORY_CATEGORY MCL_MEMORY_CATEGORY_HTTP
+
 #include "http_client_libcurl.h"
 #include "log_util.h"
 #include "memory.h"
 #include "definitions.h"
+#include "time_util.h"
+#include "list.h"
+#include "file_util.h"
+#include "compression.h"
 
 #if (1 == HAVE_OPENSSL_SSL_H_)
 #include <openssl/ssl.h>
 #include <openssl/err.h>
 #endif
 
+#if OPENSSL_VERSION_NUMBER < 0x10100000L
+#define SSL_SESSION_up_ref(session) CRYPTO_add(&(session)->references, 1, CRYPTO_LOCK_SSL_SESSION)
+#define X509_STORE_up_ref(store) CRYPTO_add(&(store)->references, 1, CRYPTO_LOCK_X509_STORE)
+#endif
+
 #define CARRIAGE_RETURN '\r'
 #define LINE_FEED '\n'
 #define DOMAIN_SEPERATOR '\\'
@@ -38,16 +49,86 @@ typedef struct libcurl_payload_t
     mcl_size_t size;
 } libcurl_payload_t;
 
+// Data structure holding the state of a single transfer added to the libcurl multi handle.
+typedef struct http_client_transfer_t
+{
+    CURL *curl;                                           //!< Easy handle of the transfer.
+    struct curl_slist *request_header_list;               //!< List of request headers passed to libcurl.
+    string_array_t *response_header;                      //!< Received response header lines.
+    libcurl_payload_t response_payload;                   //!< Received response payload.
+    mcl_bool_t close_connection;                          //!< Connection is closed after this transfer if MCL_TRUE.
+    http_client_send_complete_callback complete_callback; //!< Callback to be called when the transfer is completed.
+    void *user_context;                                   //!< User context passed to complete_callback.
+    list_node_t *node;                                    //!< Node of the transfer in the list of in-flight transfers.
+    void *compression;                                    //!< Compression state if the request payload is compressed, otherwise null.
+    http_request_t *http_request;                         //!< Request whose payload is compressed if there is no read callback.
+    http_client_read_callback read_callback;              //!< Read callback giving the payload to be compressed, if any.
+    void *read_user_context;                              //!< User context passed to read_callback.
+    mcl_uint8_t *compression_input;                       //!< Buffer read_callback fills with the payload to be compressed.
+} http_client_transfer_t;
+
+// Data structure to collect the result of an asynchronous transfer for the blocking http_client_send function.
+typedef struct http_client_send_result_t
+{
+    mcl_bool_t completed;
+    E_MCL_ERROR_CODE code;
+    http_response_t *http_response;
+} http_client_send_result_t;
+
+// Maximum time in milliseconds to wait for socket activity in each iteration of the blocking http_client_send function.
+#define SEND_WAIT_TIMEOUT_MS 1000
+
+// Suffix appended to store path for the name of the file the last TLS session is saved to.
+#define TLS_SESSION_FILE_SUFFIX ".tls"
+
+// Suffix appended to the name of the TLS session file for the file the session is written to before it replaces the saved one.
+#define TLS_SESSION_TEMPORARY_FILE_SUFFIX ".tmp"
+
+// Size of the buffer the payload given by read callback is compressed from.
+#define COMPRESSION_INPUT_BUFFER_SIZE 16384
+
+// Saved TLS sessions larger than this are not loaded, a session with a ticket and a peer certificate chain is a few kilobytes.
+#define TLS_SESSION_FILE_MAX_SIZE 65536
+
 static mcl_bool_t curl_global_initialized = MCL_FALSE;
 
-static CURLcode _ssl_context_callback(CURL *curl, void *ssl_context, void *certificate);
+// Index of the http client in the extra data of TLS contexts.
+static int tls_context_index = -1;
+
+static E_MCL_ERROR_CODE _create_certificate_store(http_client_t *http_client);
+static void _load_default_certificates(http_client_t *http_client, X509_STORE *store);
+static CURLcode _ssl_context_callback(CURL *curl, void *ssl_context, void *http_client);
+static int _tls_new_session_callback(SSL *ssl, SSL_SESSION *session);
+static void _tls_info_callback(const SSL *ssl, int where, int ret);
+static E_MCL_ERROR_CODE _tls_session_initialize(http_client_t *http_client, string_t *store_path);
 static mcl_size_t _response_payload_callback(void *received_data, mcl_size_t size, mcl_size_t count, void *response_payload);
 static mcl_size_t _response_header_callback(void *received_data, mcl_size_t size, mcl_size_t count, void *response_header);
 static mcl_size_t _request_payload_callback_for_put(char *buffer, mcl_size_t size, mcl_size_t count, void *http_request);
+static mcl_size_t _request_payload_callback_for_fragments(char *buffer, mcl_size_t size, mcl_size_t count, void *http_request);
+static int _request_seek_callback_for_put(void *http_request, curl_off_t offset, int origin);
+static int _request_seek_callback_for_fragments(void *http_request, curl_off_t offset, int origin);
+#if (1 == MCL_HAVE_ZLIB)
+static mcl_size_t _request_payload_callback_for_compression(char *buffer, mcl_size_t size, mcl_size_t count, void *transfer);
+static int _request_seek_callback_for_compression(void *transfer, curl_off_t offset, int origin);
+#endif
 static mcl_bool_t _is_empty_line(char *line);
-static struct curl_slist *_set_request_options(CURL *curl, http_request_t *http_request, http_client_send_callback_info_t *callback_info);
+static struct curl_slist *_set_request_options(http_client_transfer_t *transfer, http_request_t *http_request, http_client_send_callback_info_t *callback_info);
+static mcl_bool_t _set_compression_options(http_client_transfer_t *transfer, http_request_t *http_request, http_client_send_callback_info_t *callback_info);
 static int _curl_debug_callback(CURL *curl, curl_infotype info_type, char *data, mcl_size_t size, void *debug_data);
 static E_MCL_ERROR_CODE _convert_to_mcl_error_code(CURLcode curl_code);
+static mcl_bool_t _prepare_connection(http_client_t *http_client, CURL *curl);
+static void _update_connection_statistics(http_client_t *http_client, CURL *curl, mcl_bool_t transfer_succeeded, mcl_bool_t close_connection);
+static E_MCL_ERROR_CODE _start_transfer(http_client_t *http_client, http_request_t *http_request, http_client_send_callback_info_t *callback_info,
+        http_client_send_complete_callback complete_callback, void *user_context, http_client_transfer_t **transfer);
+static void _complete_transfer(http_client_t *http_client, http_client_transfer_t *transfer, CURLcode curl_code);
+static void _release_transfer(http_client_t *http_client, http_client_transfer_t **transfer);
+static void _send_complete_callback(E_MCL_ERROR_CODE code, http_response_t *http_response, void *user_context);
+
+// Memory functions of libcurl, accounting its memory to its own category.
+static void *_curl_malloc(size_t size);
+static void *_curl_calloc(size_t count, size_t size);
+static void *_curl_realloc(void *p, size_t size);
+static char *_curl_strdup(const char *string);
 
 E_MCL_ERROR_CODE http_client_initialize(configuration_t *configuration, http_client_t **http_client)
 {
@@ -63,14 +144,58 @@ E_MCL_ERROR_CODE http_client_initialize(configuration_t *configuration, http_cli
     if (MCL_FALSE == curl_global_initialized)
     {
         curl_global_initialized = MCL_TRUE;
-        curl_global_init_mem(CURL_GLOBAL_DEFAULT, memory_malloc, memory_free, memory_realloc, string_util_strdup, memory_calloc);
+        curl_global_init_mem(CURL_GLOBAL_DEFAULT, _curl_malloc, memory_free, _curl_realloc, _curl_strdup, _curl_calloc);
+    }
+
+    if (-1 == tls_context_index)
+    {
+        tls_context_index = SSL_CTX_get_ex_new_index(0, MCL_NULL, MCL_NULL, MCL_NULL, MCL_NULL);
     }
 
     // Initialize curl object.
+    (*http_client)->multi = MCL_NULL;
+    (*http_client)->share = MCL_NULL;
+    (*http_client)->certificate = configuration->mindsphere_certificate;
+    (*http_client)->certificate_store = MCL_NULL;
+    (*http_client)->tls_session_path = MCL_NULL;
+    (*http_client)->tls_session = MCL_NULL;
+    (*http_client)->tls_session_data = MCL_NULL;
+    (*http_client)->tls_session_data_size = 0;
+    (*http_client)->new_session_callback = MCL_NULL;
+    (*http_client)->transfers = MCL_NULL;
+    (*http_client)->curl_in_use = MCL_FALSE;
     (*http_client)->curl = curl_easy_init();
-    ASSERT_CODE_MESSAGE(MCL_NULL != (*http_client)->curl, MCL_INITIALIZATION_FAIL, "Libcurl easy interface can not be initialized.");
+    ASSERT_STATEMENT_CODE_MESSAGE(MCL_NULL != (*http_client)->curl, MCL_FREE(*http_client), MCL_INITIALIZATION_FAIL, "Libcurl easy interface can not be initialized.");
     MCL_DEBUG("Libcurl easy interface is initialized.");
 
+    // Initialize curl multi object which drives all transfers of this http client.
+    (*http_client)->multi = curl_multi_init();
+    ASSERT_STATEMENT_CODE_MESSAGE(MCL_NULL != (*http_client)->multi, http_client_destroy(http_client), MCL_INITIALIZATION_FAIL,
+                                  "Libcurl multi interface can not be initialized.");
+    MCL_DEBUG("Libcurl multi interface is initialized.");
+
+    ASSERT_STATEMENT_CODE_MESSAGE(MCL_OK == list_initialize(&((*http_client)->transfers)), http_client_destroy(http_client), MCL_OUT_OF_MEMORY,
+                                  "Memory can not be allocated for the list of transfers.");
+
+    // Initialize curl share object so that the easy handles duplicated for concurrent transfers resume the TLS sessions of each other.
+    (*http_client)->share = curl_share_init();
+    ASSERT_STATEMENT_CODE_MESSAGE(MCL_NULL != (*http_client)->share, http_client_destroy(http_client), MCL_INITIALIZATION_FAIL,
+                                  "Libcurl share interface can not be initialized.");
+    curl_share_setopt((*http_client)->share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+
+    // Parse the certificate once here instead of each time libcurl creates a TLS context.
+    if (MCL_NULL != configuration->mindsphere_certificate)
+    {
+        _create_certificate_store(*http_client);
+    }
+
+    // Load the TLS session of the previous run if it is saved.
+    if ((MCL_TRUE == configuration->tls_session_cache) && (MCL_NULL != configuration->store_path))
+    {
+        ASSERT_STATEMENT_CODE_MESSAGE(MCL_OK == _tls_session_initialize(*http_client, configuration->store_path), http_client_destroy(http_client), MCL_OUT_OF_MEMORY,
+                                      "Memory can not be allocated for TLS session file name.");
+    }
+
     // Declare a local curl instance for code clarity.
     curl = (*http_client)->curl;
 
@@ -83,10 +208,11 @@ E_MCL_ERROR_CODE http_client_initialize(configuration_t *configuration, http_cli
 
     // Set server certificate.
     curl_easy_setopt(curl, CURLOPT_SSLCERTTYPE, SSL_CERTIFICATE_TYPE_PEM);
-    curl_easy_setopt(curl, CURLOPT_SSL_CTX_DATA, configuration->mindsphere_certificate);
+    curl_easy_setopt(curl, CURLOPT_SSL_CTX_DATA, *http_client);
     curl_easy_setopt(curl, CURLOPT_SSL_CTX_FUNCTION, *_ssl_context_callback);
     curl_easy_setopt(curl, CURLOPT_SSL_CIPHER_LIST, SUPPORTED_CIPHERS_LIST);
     curl_easy_setopt(curl, CURLOPT_SSLVERSION, CURL_SSLVERSION_TLSv1_2);
+    curl_easy_setopt(curl, CURLOPT_SHARE, (*http_client)->share);
 
     // Verify the server's SSL certificate.
     curl_easy_setopt(curl, CURLOPT_SSL_VERIFYHOST, 2);
@@ -114,8 +240,30 @@ E_MCL_ERROR_CODE http_client_initialize(configuration_t *configuration, http_cli
     // The headers specified in CURLOPT_HEADER will be used in requests to both servers and proxies.
     curl_easy_setopt(curl, CURLOPT_HEADEROPT, CURLHEADER_UNIFIED);
 
-    // Close the connection when done with the transfer.
-    curl_easy_setopt(curl, CURLOPT_FORBID_REUSE, 1);
+    // Set connection reuse options.
+    (*http_client)->keep_alive = configuration->http_keep_alive;
+    (*http_client)->idle_timeout = configuration->http_connection_idle_timeout;
+    (*http_client)->max_requests = configuration->http_connection_max_requests;
+    (*http_client)->connection_requests = 0;
+    (*http_client)->last_request_time = 0;
+    (*http_client)->connections_opened = 0;
+    (*http_client)->connections_reused = 0;
+
+    if (MCL_TRUE == configuration->http_keep_alive)
+    {
+        // Send TCP keep-alive probes so that the idle connection is not dropped silently by intermediate network devices.
+        curl_easy_setopt(curl, CURLOPT_TCP_KEEPALIVE, 1L);
+
+#if LIBCURL_VERSION_NUM >= 0x074100
+        // Do not reuse a connection which has been idle longer than the configured timeout.
+        curl_easy_setopt(curl, CURLOPT_MAXAGE_CONN, (long)configuration->http_connection_idle_timeout);
+#endif
+    }
+    else
+    {
+        // Close the connection when done with the transfer.
+        curl_easy_setopt(curl, CURLOPT_FORBID_REUSE, 1L);
+    }
 
     // Set proxy options if proxy is used.
     if (MCL_NULL != configuration->proxy_hostname)
@@ -159,64 +307,106 @@ E_MCL_ERROR_CODE http_client_send(http_client_t *http_client, http_request_t *ht
                 http_client, http_request, callback_info, http_response)
 
     E_MCL_ERROR_CODE return_code;
-    struct curl_slist *request_header_list;
-    string_array_t *response_header = MCL_NULL;
-    libcurl_payload_t *response_payload;
-    CURLcode curl_code;
-    mcl_int64_t response_code;
+    http_client_transfer_t *transfer = MCL_NULL;
+    http_client_send_result_t result;
 
-    // Set request options. If there are no request headers, this function returns null but the other options for the request are set anyway.
-    request_header_list = _set_request_options(http_client->curl, http_request, callback_info);
+    result.completed = MCL_FALSE;
+    result.code = MCL_FAIL;
+    result.http_response = MCL_NULL;
 
-    // Initialize a string array to store response header, clear the list of request headers if this initialization fails and return.
-    return_code = string_array_initialize(10, &response_header);
-    ASSERT_STATEMENT_CODE_MESSAGE(return_code == MCL_OK, curl_slist_free_all(request_header_list), return_code,
-                                  "String array for http response header can not be initialized.");
+    return_code = _start_transfer(http_client, http_request, callback_info, _send_complete_callback, &result, &transfer);
+    ASSERT_CODE_MESSAGE(MCL_OK == return_code, return_code, "Transfer can not be started.");
 
-    // Set pointer passed to the _response_header_callback function as fourth argument.
-    curl_easy_setopt(http_client->curl, CURLOPT_HEADERDATA, response_header);
+    // Drive the multi handle until this transfer is completed. Other transfers in flight are progressed as well.
+    while ((MCL_FALSE == result.completed) && (MCL_OK == return_code))
+    {
+        return_code = http_client_perform(http_client, SEND_WAIT_TIMEOUT_MS, MCL_NULL);
 
-    // Set pointer passed to the _response_callback function as fourth argument.
-    MCL_NEW(response_payload);
-    response_payload->data = MCL_NULL;
-    response_payload->size = 0;
-    curl_easy_setopt(http_client->curl, CURLOPT_WRITEDATA, response_payload);
+        // Let the caller use the time spent waiting for the response.
+        if ((MCL_FALSE == result.completed) && (MCL_NULL != callback_info) && (MCL_NULL != callback_info->idle_callback))
+        {
+            callback_info->idle_callback(callback_info->user_context);
+        }
+    }
 
-    // Perform the transfer.
-    MCL_INFO("Sending HTTP request...");
+    if (MCL_FALSE == result.completed)
+    {
+        // Transfer still refers to the local result, it must not outlive this function.
+        _release_transfer(http_client, &transfer);
+        MCL_ERROR_RETURN(return_code, "Libcurl multi interface failed while sending the request.");
+    }
 
-    curl_code = curl_easy_perform(http_client->curl);
-    return_code = _convert_to_mcl_error_code(curl_code);
-    MCL_INFO("HTTP request sent. Result code = <%u>", return_code);
+    ASSERT_CODE_MESSAGE(MCL_OK == result.code, result.code, "Http request can not be sent.");
+    *http_response = result.http_response;
+
+    DEBUG_LEAVE("retVal = <%d>", MCL_OK);
+    return MCL_OK;
+}
+
+E_MCL_ERROR_CODE http_client_send_async(http_client_t *http_client, http_request_t *http_request, http_client_send_callback_info_t *callback_info,
+        http_client_send_complete_callback complete_callback, void *user_context)
+{
+    DEBUG_ENTRY("http_client_t *http_client = <%p>, http_request_t *http_request = <%p>, http_client_send_callback_info_t *callback_info = <%p>, "
+                "http_client_send_complete_callback complete_callback = <%p>, void *user_context = <%p>", http_client, http_request, callback_info, complete_callback, user_context)
+
+    E_MCL_ERROR_CODE return_code;
+    http_client_transfer_t *transfer = MCL_NULL;
+
+    return_code = _start_transfer(http_client, http_request, callback_info, complete_callback, user_context, &transfer);
+
+    DEBUG_LEAVE("retVal = <%d>", return_code);
+    return return_code;
+}
+
+E_MCL_ERROR_CODE http_client_perform(http_client_t *http_client, mcl_uint32_t timeout, mcl_size_t *pending_count)
+{
+    DEBUG_ENTRY("http_client_t *http_client = <%p>, mcl_uint32_t timeout = <%u>, mcl_size_t *pending_count = <%p>", http_client, timeout, pending_count)
 
-    // Free the list of http request header.
-    curl_slist_free_all(request_header_list);
+    CURLMcode multi_code = CURLM_OK;
+    CURLMsg *message;
+    int running_count = 0;
+    int message_count = 0;
 
-    if (MCL_OK != return_code)
+    if (0 < http_client->transfers->count)
     {
-        string_array_destroy(&response_header);
-        MCL_FREE(response_payload->data);
-        MCL_FREE(response_payload);
-        MCL_ERROR_RETURN(return_code, "curl_easy_perform() failed: %s", curl_easy_strerror(curl_code));
-    }
+        // Wait for activity on any of the sockets of the transfers in flight or for the timeout of libcurl.
+        multi_code = curl_multi_wait(http_client->multi, MCL_NULL, 0, (int)timeout, MCL_NULL);
+        (CURLM_OK == multi_code) && (multi_code = curl_multi_perform(http_client->multi, &running_count));
+        ASSERT_CODE_MESSAGE(CURLM_OK == multi_code, MCL_FAIL, "Libcurl multi interface failed: %s", curl_multi_strerror(multi_code));
+
+        // Complete the transfers which are done.
+        while (MCL_NULL != (message = curl_multi_info_read(http_client->multi, &message_count)))
+        {
+            if (CURLMSG_DONE == message->msg)
+            {
+                http_client_transfer_t *transfer = MCL_NULL;
 
-    // Gather response into http_response object.
-    curl_easy_getinfo(http_client->curl, CURLINFO_RESPONSE_CODE, &response_code);
+                curl_easy_getinfo(message->easy_handle, CURLINFO_PRIVATE, (char **)&transfer);
+                _complete_transfer(http_client, transfer, message->data.result);
+            }
+        }
+    }
 
-    return_code = http_response_initialize(response_header, response_payload->data, response_payload->size, (E_MCL_HTTP_RESULT_CODE)response_code, http_response);
-    if (MCL_OK != return_code)
+    if (MCL_NULL != pending_count)
     {
-        string_array_destroy(&response_header);
-        MCL_FREE(response_payload->data);
-        MCL_FREE(response_payload);
-        MCL_ERROR_RETURN(return_code, "Http response can not be initialized.");
+        *pending_count = http_client->transfers->count;
     }
-    MCL_FREE(response_payload);
 
     DEBUG_LEAVE("retVal = <%d>", MCL_OK);
     return MCL_OK;
 }
 
+void http_client_get_connection_statistics(http_client_t *http_client, mcl_size_t *connections_opened, mcl_size_t *connections_reused)
+{
+    DEBUG_ENTRY("http_client_t *http_client = <%p>, mcl_size_t *connections_opened = <%p>, mcl_size_t *connections_reused = <%p>", http_client, connections_opened,
+                connections_reused)
+
+    *connections_opened = http_client->connections_opened;
+    *connections_reused = http_client->connections_reused;
+
+    DEBUG_LEAVE("retVal = void");
+}
+
 mcl_size_t http_client_get_callback_termination_code()
 {
     DEBUG_ENTRY("void")
@@ -233,7 +423,44 @@ void http_client_destroy(http_client_t **http_client)
 
     if (MCL_NULL != *http_client)
     {
+        // Complete the transfers still in flight with failure so that their owners can release their resources.
+        while ((MCL_NULL != (*http_client)->transfers) && (0 < (*http_client)->transfers->count))
+        {
+            http_client_transfer_t *transfer = (http_client_transfer_t *)(*http_client)->transfers->head->data;
+            http_client_send_complete_callback complete_callback = transfer->complete_callback;
+            void *user_context = transfer->user_context;
+
+            _release_transfer(*http_client, &transfer);
+            complete_callback(MCL_FAIL, MCL_NULL, user_context);
+        }
+
+        list_destroy(&((*http_client)->transfers));
+
+        if (MCL_NULL != (*http_client)->multi)
+        {
+            curl_multi_cleanup((*http_client)->multi);
+        }
+
         curl_easy_cleanup((*http_client)->curl);
+
+        // Share handle can be cleaned up only after all easy handles using it.
+        if (MCL_NULL != (*http_client)->share)
+        {
+            curl_share_cleanup((*http_client)->share);
+        }
+
+        if (MCL_NULL != (*http_client)->tls_session)
+        {
+            SSL_SESSION_free((*http_client)->tls_session);
+        }
+
+        if (MCL_NULL != (*http_client)->certificate_store)
+        {
+            X509_STORE_free((*http_client)->certificate_store);
+        }
+
+        MCL_FREE((*http_client)->tls_session_data);
+        string_destroy(&((*http_client)->tls_session_path));
         MCL_FREE(*http_client);
 
         MCL_DEBUG("Http client handle is destroyed.");
@@ -246,38 +473,294 @@ void http_client_destroy(http_client_t **http_client)
     DEBUG_LEAVE("retVal = void");
 }
 
-// This function is the callback which is called to set the SSL certificate given by the parameter "certificate".
-static CURLcode _ssl_context_callback(CURL *curl, void *ssl_context, void *certificate)
+// This function decides whether the connection can be reused for the next request and sets the corresponding curl options.
+// Returns MCL_TRUE if the connection will be closed after the next request.
+static mcl_bool_t _prepare_connection(http_client_t *http_client, CURL *curl)
 {
-    DEBUG_ENTRY("CURL *curl = <%p>, void *ssl_context = <%p>, void *certificate = <%p>", curl, ssl_context, certificate)
+    DEBUG_ENTRY("http_client_t *http_client = <%p>, CURL *curl = <%p>", http_client, curl)
 
-    string_t *certificate_local;
-    X509_STORE *store;
-    BIO *bio;
-    struct stack_st_X509_INFO *certificate_info;
-    mcl_size_t index;
+    mcl_bool_t close_connection = MCL_FALSE;
+
+    if (MCL_TRUE == http_client->keep_alive)
+    {
+        mcl_bool_t fresh_connection = MCL_FALSE;
+
+#if LIBCURL_VERSION_NUM < 0x074100
+        mcl_time_t current_time;
+
+        // CURLOPT_MAXAGE_CONN is not supported, check idle time of the connection here.
+        time_util_get_time(&current_time);
+        if ((0 < http_client->connection_requests) && ((mcl_time_t)http_client->idle_timeout <= (current_time - http_client->last_request_time)))
+        {
+            MCL_DEBUG("Connection has been idle for %d seconds, a new connection will be opened.", (int)(current_time - http_client->last_request_time));
+            fresh_connection = MCL_TRUE;
+            http_client->connection_requests = 0;
+        }
+        http_client->last_request_time = current_time;
+#endif
 
+        // Close the connection after this request if it reaches the maximum number of requests.
+        if ((0 < http_client->max_requests) && (http_client->max_requests <= http_client->connection_requests + 1))
+        {
+            MCL_DEBUG("Connection reached the maximum number of requests, it will be closed after this request.");
+            close_connection = MCL_TRUE;
+        }
 
-    if (MCL_NULL == certificate)
+        curl_easy_setopt(curl, CURLOPT_FRESH_CONNECT, (long)fresh_connection);
+        curl_easy_setopt(curl, CURLOPT_FORBID_REUSE, (long)close_connection);
+    }
+    else
     {
-        MCL_INFO("No certificate is provided by the user for peer verification. Continuing with the existing CA certificate store.");
-        return CURLE_OK;
+        close_connection = MCL_TRUE;
     }
 
-    certificate_local = (string_t *)certificate;
+    DEBUG_LEAVE("retVal = <%d>", close_connection);
+    return close_connection;
+}
+
+// This function updates the connection reuse statistics after a transfer.
+static void _update_connection_statistics(http_client_t *http_client, CURL *curl, mcl_bool_t transfer_succeeded, mcl_bool_t close_connection)
+{
+    DEBUG_ENTRY("http_client_t *http_client = <%p>, CURL *curl = <%p>, mcl_bool_t transfer_succeeded = <%d>, mcl_bool_t close_connection = <%d>", http_client, curl,
+                transfer_succeeded, close_connection)
+
+    long new_connections = 0;
 
-    // Get a pointer to the X509 certificate store (which may be empty!).
-    store = SSL_CTX_get_cert_store((SSL_CTX *)ssl_context);
+    // Number of new connections libcurl had to create for the previous transfer.
+    curl_easy_getinfo(curl, CURLINFO_NUM_CONNECTS, &new_connections);
+
+    if (0 < new_connections)
+    {
+        ++http_client->connections_opened;
+        http_client->connection_requests = 1;
+    }
+    else if (MCL_TRUE == transfer_succeeded)
+    {
+        ++http_client->connections_reused;
+        ++http_client->connection_requests;
+    }
+
+    // Libcurl does not keep the connection after a failed transfer.
+    if ((MCL_TRUE == close_connection) || (MCL_FALSE == transfer_succeeded))
+    {
+        http_client->connection_requests = 0;
+    }
+
+    MCL_DEBUG("Connections opened = <%u>, connections reused = <%u>.", http_client->connections_opened, http_client->connections_reused);
+
+    DEBUG_LEAVE("retVal = void");
+}
+
+// This function prepares an easy handle for the request, adds it to the multi handle and returns the transfer created.
+static E_MCL_ERROR_CODE _start_transfer(http_client_t *http_client, http_request_t *http_request, http_client_send_callback_info_t *callback_info,
+        http_client_send_complete_callback complete_callback, void *user_context, http_client_transfer_t **transfer)
+{
+    DEBUG_ENTRY("http_client_t *http_client = <%p>, http_request_t *http_request = <%p>, http_client_send_callback_info_t *callback_info = <%p>, "
+                "http_client_send_complete_callback complete_callback = <%p>, void *user_context = <%p>, http_client_transfer_t **transfer = <%p>",
+                http_client, http_request, callback_info, complete_callback, user_context, transfer)
+
+    E_MCL_ERROR_CODE return_code;
+    CURLMcode multi_code;
+
+    MCL_NEW(*transfer);
+    ASSERT_CODE_MESSAGE(MCL_NULL != *transfer, MCL_OUT_OF_MEMORY, "Memory can not be allocated for transfer.");
+
+    (*transfer)->request_header_list = MCL_NULL;
+    (*transfer)->response_header = MCL_NULL;
+    (*transfer)->response_payload.data = MCL_NULL;
+    (*transfer)->response_payload.size = 0;
+    (*transfer)->complete_callback = complete_callback;
+    (*transfer)->user_context = user_context;
+    (*transfer)->node = MCL_NULL;
+    (*transfer)->compression = MCL_NULL;
+    (*transfer)->http_request = MCL_NULL;
+    (*transfer)->read_callback = MCL_NULL;
+    (*transfer)->read_user_context = MCL_NULL;
+    (*transfer)->compression_input = MCL_NULL;
+
+    // Use the preconfigured easy handle if it is free, otherwise duplicate it for this transfer.
+    if (MCL_FALSE == http_client->curl_in_use)
+    {
+        (*transfer)->curl = http_client->curl;
+        http_client->curl_in_use = MCL_TRUE;
+    }
+    else
+    {
+        (*transfer)->curl = curl_easy_duphandle(http_client->curl);
+        ASSERT_STATEMENT_CODE_MESSAGE(MCL_NULL != (*transfer)->curl, MCL_FREE(*transfer), MCL_OUT_OF_MEMORY, "Libcurl easy handle can not be duplicated.");
+
+        // Share handle is not duplicated by libcurl.
+        curl_easy_setopt((*transfer)->curl, CURLOPT_SHARE, http_client->share);
+    }
+
+    // Set request options. If there are no request headers, this function returns null but the other options for the request are set anyway.
+    (*transfer)->request_header_list = _set_request_options(*transfer, http_request, callback_info);
+
+    // Decide whether the current connection can be reused for this request.
+    (*transfer)->close_connection = _prepare_connection(http_client, (*transfer)->curl);
+
+    // Initialize a string array to store response header.
+    return_code = string_array_initialize(10, &((*transfer)->response_header));
+    ASSERT_STATEMENT_CODE_MESSAGE(MCL_OK == return_code, _release_transfer(http_client, transfer), return_code, "String array for http response header can not be initialized.");
+
+    // Set pointers passed to the _response_header_callback and _response_payload_callback functions as fourth argument.
+    curl_easy_setopt((*transfer)->curl, CURLOPT_HEADERDATA, (*transfer)->response_header);
+    curl_easy_setopt((*transfer)->curl, CURLOPT_WRITEDATA, &((*transfer)->response_payload));
+    curl_easy_setopt((*transfer)->curl, CURLOPT_PRIVATE, (char *)*transfer);
+
+    return_code = list_add(http_client->transfers, *transfer);
+    ASSERT_STATEMENT_CODE_MESSAGE(MCL_OK == return_code, _release_transfer(http_client, transfer), return_code, "Transfer can not be added to the list.");
+    (*transfer)->node = http_client->transfers->last;
+
+    // Start the transfer.
+    MCL_INFO("Sending HTTP request...");
+    multi_code = curl_multi_add_handle(http_client->multi, (*transfer)->curl);
+    ASSERT_STATEMENT_CODE_MESSAGE(CURLM_OK == multi_code, _release_transfer(http_client, transfer), MCL_FAIL, "Transfer can not be added to libcurl multi handle.");
+
+    DEBUG_LEAVE("retVal = <%d>", MCL_OK);
+    return MCL_OK;
+}
+
+// This function gathers the response of a completed transfer, releases the transfer and notifies its owner.
+static void _complete_transfer(http_client_t *http_client, http_client_transfer_t *transfer, CURLcode curl_code)
+{
+    DEBUG_ENTRY("http_client_t *http_client = <%p>, http_client_transfer_t *transfer = <%p>, CURLcode curl_code = <%d>", http_client, transfer, curl_code)
+
+    E_MCL_ERROR_CODE return_code;
+    http_response_t *http_response = MCL_NULL;
+    mcl_int64_t response_code = 0;
+    http_client_send_complete_callback complete_callback = transfer->complete_callback;
+    void *user_context = transfer->user_context;
+
+    return_code = _convert_to_mcl_error_code(curl_code);
+    MCL_INFO("HTTP request sent. Result code = <%u>", return_code);
+
+    _update_connection_statistics(http_client, transfer->curl, (CURLE_OK == curl_code), transfer->close_connection);
+
+#if (1 == MCL_HAVE_ZLIB)
+    if (MCL_NULL != transfer->compression)
+    {
+        mcl_size_t payload_size;
+        mcl_size_t compressed_payload_size;
+
+        compression_get_sizes(transfer->compression, &payload_size, &compressed_payload_size);
+
+        if (0 != compressed_payload_size)
+        {
+            MCL_INFO("HTTP request payload of <%u> bytes is sent as <%u> bytes with gzip compression (ratio = <%.2f>).", payload_size, compressed_payload_size,
+                     (double)payload_size / (double)compressed_payload_size);
+        }
+    }
+#endif
+
+    if (MCL_OK == return_code)
+    {
+        // Gather response into http_response object. Response header and payload are owned by the response from now on.
+        curl_easy_getinfo(transfer->curl, CURLINFO_RESPONSE_CODE, &response_code);
+
+        return_code = http_response_initialize(transfer->response_header, transfer->response_payload.data, transfer->response_payload.size,
+                                               (E_MCL_HTTP_RESULT_CODE)response_code, &http_response);
+
+        if (MCL_OK == return_code)
+        {
+            transfer->response_header = MCL_NULL;
+            transfer->response_payload.data = MCL_NULL;
+        }
+        else
+        {
+            MCL_ERROR("Http response can not be initialized.");
+        }
+    }
+    else
+    {
+        MCL_ERROR("Libcurl transfer failed: %s", curl_easy_strerror(curl_code));
+    }
+
+    _release_transfer(http_client, &transfer);
+    complete_callback(return_code, http_response, user_context);
+
+    DEBUG_LEAVE("retVal = void");
+}
+
+// This function removes the transfer from the multi handle and frees all of its resources.
+static void _release_transfer(http_client_t *http_client, http_client_transfer_t **transfer)
+{
+    DEBUG_ENTRY("http_client_t *http_client = <%p>, http_client_transfer_t **transfer = <%p>", http_client, transfer)
+
+    curl_multi_remove_handle(http_client->multi, (*transfer)->curl);
+
+    if (MCL_NULL != (*transfer)->node)
+    {
+        list_remove(http_client->transfers, (*transfer)->node);
+    }
+
+    curl_slist_free_all((*transfer)->request_header_list);
+    string_array_destroy(&((*transfer)->response_header));
+    MCL_FREE((*transfer)->response_payload.data);
+#if (1 == MCL_HAVE_ZLIB)
+    compression_destroy(&((*transfer)->compression));
+#endif
+    MCL_FREE((*transfer)->compression_input);
+
+    if (http_client->curl == (*transfer)->curl)
+    {
+        http_client->curl_in_use = MCL_FALSE;
+    }
+    else
+    {
+        curl_easy_cleanup((*transfer)->curl);
+    }
+
+    MCL_FREE(*transfer);
+
+    DEBUG_LEAVE("retVal = void");
+}
+
+// This function is the completion callback of the transfers started by the blocking http_client_send function.
+static void _send_complete_callback(E_MCL_ERROR_CODE code, http_response_t *http_response, void *user_context)
+{
+    DEBUG_ENTRY("E_MCL_ERROR_CODE code = <%d>, http_response_t *http_response = <%p>, void *user_context = <%p>", code, http_response, user_context)
+
+    http_client_send_result_t *result = (http_client_send_result_t *)user_context;
+
+    result->completed = MCL_TRUE;
+    result->code = code;
+    result->http_response = http_response;
+
+    DEBUG_LEAVE("retVal = void");
+}
+
+// This function builds the certificate store from all PEM formatted certificates and CRLs of the http client.
+// Failure is reported when libcurl creates a TLS context, as it was when the certificate was parsed there.
+static E_MCL_ERROR_CODE _create_certificate_store(http_client_t *http_client)
+{
+    DEBUG_ENTRY("http_client_t *http_client = <%p>", http_client)
+
+    E_MCL_ERROR_CODE code = MCL_OK;
+    X509_STORE *store;
+    BIO *bio;
+    struct stack_st_X509_INFO *certificate_info;
+    mcl_size_t index;
 
     // Get BIO.
-    bio = BIO_new_mem_buf(certificate_local->buffer, (int)certificate_local->length);
-    ASSERT_CODE_MESSAGE(MCL_NULL != bio, CURLE_OUT_OF_MEMORY, "Memory for BIO could not be allocated!");
+    bio = BIO_new_mem_buf(http_client->certificate->buffer, (int)http_client->certificate->length);
+    ASSERT_CODE_MESSAGE(MCL_NULL != bio, MCL_OUT_OF_MEMORY, "Memory for BIO could not be allocated!");
 
     // Read certificate info
     certificate_info = PEM_X509_INFO_read_bio(bio, MCL_NULL, MCL_NULL, MCL_NULL);
 
     BIO_free(bio);
-    ASSERT_CODE_MESSAGE(MCL_NULL != certificate_info, CURLE_SSL_CERTPROBLEM, "Certificate info can not be read from memory");
+    ASSERT_CODE_MESSAGE(MCL_NULL != certificate_info, MCL_FAIL, "Certificate info can not be read from memory");
+
+    store = X509_STORE_new();
+    ASSERT_STATEMENT_CODE_MESSAGE(MCL_NULL != store, sk_X509_INFO_pop_free(certificate_info, X509_INFO_free), MCL_OUT_OF_MEMORY,
+                                  "Memory for certificate store could not be allocated!");
+
+    // Same verification flags libcurl sets to the store it creates, e.g. an intermediate certificate can be given as trust anchor.
+    X509_STORE_set_flags(store, X509_V_FLAG_PARTIAL_CHAIN | X509_V_FLAG_TRUSTED_FIRST);
+
+    // Given certificates are trusted in addition to the default CA certificate store, not instead of it.
+    _load_default_certificates(http_client, store);
 
     // Read all PEM formatted certificates from memory into an X509 structure that SSL can use.
     for (index = 0; index < sk_X509_INFO_num(certificate_info); index++)
@@ -288,12 +771,13 @@ static CURLcode _ssl_context_callback(CURL *curl, void *ssl_context, void *certi
             if (!X509_STORE_add_cert(store, temp_info->x509))
             {
                 // Ignore error X509_R_CERT_ALREADY_IN_HASH_TABLE which means the certificate is already in the store.
-                // That could happen if libcurl already loaded the certificate from a ca cert bundle set at libcurl build-time or runtime.
+                // That could happen if the certificate is in the default CA certificate store as well or if it is given more than once.
                 unsigned long error = ERR_peek_last_error();
 
                 if(ERR_GET_LIB(error) != ERR_LIB_X509 || ERR_GET_REASON(error) != X509_R_CERT_ALREADY_IN_HASH_TABLE)
                 {
-                    MCL_ERROR_RETURN(CURLE_SSL_CERTPROBLEM, "Certificate can not be added to store.");
+                    code = MCL_FAIL;
+                    MCL_ERROR("Certificate can not be added to store.");
                 }
                 else
                 {
@@ -303,17 +787,291 @@ static CURLcode _ssl_context_callback(CURL *curl, void *ssl_context, void *certi
         }
         else if (temp_info->crl)
         {
-            ASSERT_CODE_MESSAGE(0 != X509_STORE_add_crl(store, temp_info->crl), CURLE_SSL_CERTPROBLEM, "Certificate can not be added to store.");
+            if (!X509_STORE_add_crl(store, temp_info->crl))
+            {
+                code = MCL_FAIL;
+                MCL_ERROR("Certificate can not be added to store.");
+            }
         }
     }
 
     // Clean up.
     sk_X509_INFO_pop_free(certificate_info, X509_INFO_free);
 
+    if (MCL_OK == code)
+    {
+        http_client->certificate_store = store;
+    }
+    else
+    {
+        X509_STORE_free(store);
+    }
+
+    DEBUG_LEAVE("retVal = <%d>", code);
+    return code;
+}
+
+// This function loads the CA certificates libcurl would load into each TLS context by default into the store.
+static void _load_default_certificates(http_client_t *http_client, X509_STORE *store)
+{
+    DEBUG_ENTRY("http_client_t *http_client = <%p>, X509_STORE *store = <%p>", http_client, store)
+
+    char *ca_file = MCL_NULL;
+    char *ca_path = MCL_NULL;
+    int loaded;
+
+#if LIBCURL_VERSION_NUM >= 0x075400
+    // CA certificate bundle and directory libcurl is built with.
+    curl_easy_getinfo(http_client->curl, CURLINFO_CAINFO, &ca_file);
+    curl_easy_getinfo(http_client->curl, CURLINFO_CAPATH, &ca_path);
+#endif
+
+    if ((MCL_NULL != ca_file) || (MCL_NULL != ca_path))
+    {
+        loaded = X509_STORE_load_locations(store, ca_file, ca_path);
+    }
+    else
+    {
+        loaded = X509_STORE_set_default_paths(store);
+    }
+
+    if (!loaded)
+    {
+        // Libcurl fails the handshake itself if its CA certificate bundle can not be loaded.
+        MCL_INFO("Default CA certificate store can not be loaded, only the given certificates are trusted.");
+        ERR_clear_error();
+    }
+
+    DEBUG_LEAVE("retVal = void");
+}
+
+// This function is the callback which is called to set the SSL certificate of the http client and to hook TLS session caching into the TLS context.
+static CURLcode _ssl_context_callback(CURL *curl, void *ssl_context, void *http_client)
+{
+    DEBUG_ENTRY("CURL *curl = <%p>, void *ssl_context = <%p>, void *http_client = <%p>", curl, ssl_context, http_client)
+
+    http_client_t *http_client_local = (http_client_t *)http_client;
+
+    // Hook into the new sessions of the context to save them and to resume the saved session if libcurl does not have one.
+    if (MCL_NULL != http_client_local->tls_session_path)
+    {
+        SSL_CTX_set_ex_data((SSL_CTX *)ssl_context, tls_context_index, http_client_local);
+        SSL_CTX_set_session_cache_mode((SSL_CTX *)ssl_context, SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL);
+        http_client_local->new_session_callback = SSL_CTX_sess_get_new_cb((SSL_CTX *)ssl_context);
+        SSL_CTX_sess_set_new_cb((SSL_CTX *)ssl_context, _tls_new_session_callback);
+        SSL_CTX_set_info_callback((SSL_CTX *)ssl_context, _tls_info_callback);
+    }
+
+    if (MCL_NULL == http_client_local->certificate)
+    {
+        MCL_INFO("No certificate is provided by the user for peer verification. Continuing with the existing CA certificate store.");
+        return CURLE_OK;
+    }
+
+    // Certificate could not be parsed at initialization.
+    ASSERT_CODE_MESSAGE(MCL_NULL != http_client_local->certificate_store, CURLE_SSL_CERTPROBLEM, "Certificate info can not be read from memory");
+
+    // Replace the store of the context with the store built at initialization, which has the default CA certificates as well.
+    // Context takes its own reference to the store.
+    X509_STORE_up_ref(http_client_local->certificate_store);
+    SSL_CTX_set_cert_store((SSL_CTX *)ssl_context, http_client_local->certificate_store);
+
     DEBUG_LEAVE("retVal = <%d>", CURLE_OK);
     return CURLE_OK;
 }
 
+// This function is called by OpenSSL when a new TLS session is established. The session is saved for the next run and passed to libcurl.
+static int _tls_new_session_callback(SSL *ssl, SSL_SESSION *session)
+{
+    DEBUG_ENTRY("SSL *ssl = <%p>, SSL_SESSION *session = <%p>", ssl, session)
+
+    http_client_t *http_client = (http_client_t *)SSL_CTX_get_ex_data(SSL_get_SSL_CTX(ssl), tls_context_index);
+    int session_kept = 0;
+
+    if (MCL_NULL != http_client)
+    {
+        http_client_save_tls_session(http_client, session);
+
+        // Libcurl adds the session to its own cache and tells whether it keeps the reference.
+        if (MCL_NULL != http_client->new_session_callback)
+        {
+            session_kept = http_client->new_session_callback(ssl, session);
+        }
+    }
+
+    DEBUG_LEAVE("retVal = <%d>", session_kept);
+    return session_kept;
+}
+
+// This function is called by OpenSSL at state changes of the connection. The saved session is resumed when a handshake starts without a session.
+static void _tls_info_callback(const SSL *ssl, int where, int ret)
+{
+    VERBOSE_ENTRY("const SSL *ssl = <%p>, int where = <%d>, int ret = <%d>", ssl, where, ret)
+
+    if ((0 != (where & SSL_CB_HANDSHAKE_START)) && (MCL_NULL == SSL_get_session(ssl)))
+    {
+        http_client_t *http_client = (http_client_t *)SSL_CTX_get_ex_data(SSL_get_SSL_CTX(ssl), tls_context_index);
+
+        if ((MCL_NULL != http_client) && (MCL_NULL != http_client->tls_session))
+        {
+            MCL_DEBUG("Saved TLS session will be resumed.");
+            SSL_set_session((SSL *)ssl, http_client->tls_session);
+        }
+    }
+
+    VERBOSE_LEAVE("retVal = void");
+}
+
+// This function sets the name of the file the TLS sessions are saved to and loads the session saved in the previous run.
+// Failing to load the session is not an error, a full handshake is performed then.
+static E_MCL_ERROR_CODE _tls_session_initialize(http_client_t *http_client, string_t *store_path)
+{
+    DEBUG_ENTRY("http_client_t *http_client = <%p>, string_t *store_path = <%p>", http_client, store_path)
+
+#if (1 == HAVE_FILE_SYSTEM_)
+    E_MCL_ERROR_CODE code;
+    void *file_descriptor = MCL_NULL;
+    mcl_size_t path_length = store_path->length + sizeof(TLS_SESSION_FILE_SUFFIX) - 1;
+
+    code = string_initialize_new(MCL_NULL, path_length, &http_client->tls_session_path);
+    ASSERT_CODE_MESSAGE(MCL_OK == code, code, "Memory can not be allocated for TLS session file name.");
+    string_util_snprintf(http_client->tls_session_path->buffer, path_length + 1, "%s%s", store_path->buffer, TLS_SESSION_FILE_SUFFIX);
+
+    if (MCL_OK == file_util_fopen_without_log(http_client->tls_session_path->buffer, "rb", &file_descriptor))
+    {
+        mcl_stat_t file_attributes;
+        mcl_uint8_t *buffer = MCL_NULL;
+        mcl_size_t actual_count = 0;
+
+        code = file_util_fstat(file_descriptor, &file_attributes);
+
+        if ((MCL_OK == code) && (0 < file_attributes.st_size) && (TLS_SESSION_FILE_MAX_SIZE >= file_attributes.st_size))
+        {
+            buffer = MCL_MALLOC(file_attributes.st_size);
+        }
+
+        if (MCL_NULL != buffer)
+        {
+            file_util_fread(buffer, 1, file_attributes.st_size, file_descriptor, &actual_count);
+        }
+
+        if ((0 < actual_count) && ((mcl_size_t)file_attributes.st_size == actual_count))
+        {
+            const unsigned char *session_data = buffer;
+            http_client->tls_session = d2i_SSL_SESSION(MCL_NULL, &session_data, (long)actual_count);
+        }
+
+        file_util_fclose(file_descriptor);
+
+        if (MCL_NULL != http_client->tls_session)
+        {
+            // Content of the file is kept to skip saving the same session again.
+            http_client->tls_session_data = buffer;
+            http_client->tls_session_data_size = actual_count;
+            MCL_INFO("TLS session of the previous run is loaded.");
+        }
+        else
+        {
+            MCL_FREE(buffer);
+            MCL_WARN("TLS session file can not be read, a full handshake will be performed.");
+        }
+    }
+#else
+    MCL_INFO("There is no file system support, TLS sessions will not be saved.");
+#endif
+
+    DEBUG_LEAVE("retVal = <%d>", MCL_OK);
+    return MCL_OK;
+}
+
+void http_client_save_tls_session(http_client_t *http_client, struct ssl_session_st *session)
+{
+    DEBUG_ENTRY("http_client_t *http_client = <%p>, struct ssl_session_st *session = <%p>", http_client, session)
+
+#if (1 == HAVE_FILE_SYSTEM_)
+    void *file_descriptor = MCL_NULL;
+    int session_length = i2d_SSL_SESSION(session, MCL_NULL);
+    mcl_size_t temporary_path_size = http_client->tls_session_path->length + sizeof(TLS_SESSION_TEMPORARY_FILE_SUFFIX);
+    char *temporary_path = MCL_NULL;
+    mcl_uint8_t *buffer = MCL_NULL;
+    mcl_bool_t ok;
+
+    if (0 < session_length)
+    {
+        buffer = MCL_MALLOC(session_length);
+    }
+
+    ok = MCL_NULL != buffer;
+
+    if (MCL_TRUE == ok)
+    {
+        unsigned char *session_data = buffer;
+        ok = (session_length == i2d_SSL_SESSION(session, &session_data));
+    }
+
+    // Servers which do not issue tickets send the same session on every handshake, the file is not rewritten then.
+    if ((MCL_TRUE == ok) && (http_client->tls_session_data_size == (mcl_size_t)session_length) &&
+        (MCL_TRUE == string_util_memcmp(http_client->tls_session_data, buffer, session_length)))
+    {
+        MCL_DEBUG("TLS session is not changed, it is not saved again.");
+        MCL_FREE(buffer);
+    }
+    else
+    {
+        // Write a temporary file first and rename it so that the saved session is never left half written.
+        if (MCL_TRUE == ok)
+        {
+            temporary_path = MCL_MALLOC(temporary_path_size);
+            ok = MCL_NULL != temporary_path;
+        }
+
+        if (MCL_TRUE == ok)
+        {
+            string_util_snprintf(temporary_path, temporary_path_size, "%s%s", http_client->tls_session_path->buffer, TLS_SESSION_TEMPORARY_FILE_SUFFIX);
+            ok = (MCL_OK == file_util_fopen_private(temporary_path, &file_descriptor));
+        }
+
+        ok = ok && (MCL_OK == file_util_fwrite(buffer, 1, session_length, file_descriptor));
+        ok = ok && (MCL_OK == file_util_fsync(file_descriptor));
+        file_util_fclose(file_descriptor);
+        ok = ok && (MCL_OK == file_util_rename(temporary_path, http_client->tls_session_path->buffer));
+
+        // Keep the saved content to compare with the next session, or forget it if the file is left as it was.
+        MCL_FREE(http_client->tls_session_data);
+        http_client->tls_session_data_size = 0;
+
+        if (MCL_TRUE == ok)
+        {
+            http_client->tls_session_data = buffer;
+            http_client->tls_session_data_size = (mcl_size_t)session_length;
+            MCL_DEBUG("TLS session is saved.");
+        }
+        else
+        {
+            MCL_FREE(buffer);
+            MCL_WARN("TLS session can not be saved.");
+
+            if (MCL_NULL != temporary_path)
+            {
+                file_util_remove(temporary_path);
+            }
+        }
+
+        MCL_FREE(temporary_path);
+    }
+#endif
+
+    SSL_SESSION_up_ref(session);
+
+    if (MCL_NULL != http_client->tls_session)
+    {
+        SSL_SESSION_free(http_client->tls_session);
+    }
+    http_client->tls_session = session;
+
+    DEBUG_LEAVE("retVal = void");
+}
+
 // This function is the callback which is called once for the payload of the received response.
 // The function initializes an string_t from the received data in the buffer "received_data"
 // composed of "count" elements of each "size" bytes long and copies this string to the string array "response_payload".
@@ -410,6 +1168,144 @@ static mcl_size_t _request_payload_callback_for_put(char *buffer, mcl_size_t siz
     return payload_size;
 }
 
+// This function is the callback which is called when HTTP POST is requested for a request which has fragments.
+// The function takes in parameter "http_request" of type http_request_t and copies the next part of its body to "buffer".
+static mcl_size_t _request_payload_callback_for_fragments(char *buffer, mcl_size_t size, mcl_size_t count, void *http_request)
+{
+    DEBUG_ENTRY("char *buffer = <%p>, mcl_size_t size = <%u>, mcl_size_t count = <%u>, void *http_request = <%p>", buffer, size, count, http_request)
+
+    http_request_t *request = (http_request_t *)http_request;
+    mcl_size_t read_size = http_request_read_body(request, (mcl_uint8_t *)buffer, size * count);
+
+    // Nothing is read although the body is not completed, a fragment could not be read.
+    if ((0 == read_size) && ((request->read_offset < request->payload_size) || (request->read_fragment_index < request->fragment_count)))
+    {
+        MCL_ERROR("Request body can not be read.");
+        read_size = CURL_READFUNC_ABORT;
+    }
+
+    DEBUG_LEAVE("retVal = <%u>", read_size);
+    return read_size;
+}
+
+// This function is the callback which is called when libcurl rewinds the payload of HTTP PUT to resend the request.
+static int _request_seek_callback_for_put(void *http_request, curl_off_t offset, int origin)
+{
+    DEBUG_ENTRY("void *http_request = <%p>, curl_off_t offset = <%ld>, int origin = <%d>", http_request, (long)offset, origin)
+
+    http_request_t *request = (http_request_t *)http_request;
+    int seek_result = CURL_SEEKFUNC_CANTSEEK;
+
+    if ((SEEK_SET == origin) && (0 <= offset) && ((mcl_size_t)offset <= request->payload_size))
+    {
+        request->payload_offset = (mcl_size_t)offset;
+        seek_result = CURL_SEEKFUNC_OK;
+    }
+
+    DEBUG_LEAVE("retVal = <%d>", seek_result);
+    return seek_result;
+}
+
+// This function is the callback which is called when libcurl rewinds the body of HTTP POST for a request which has fragments to resend the request.
+// Body can only be read from its beginning again, libcurl does not seek elsewhere for a request it resends.
+static int _request_seek_callback_for_fragments(void *http_request, curl_off_t offset, int origin)
+{
+    DEBUG_ENTRY("void *http_request = <%p>, curl_off_t offset = <%ld>, int origin = <%d>", http_request, (long)offset, origin)
+
+    int seek_result = CURL_SEEKFUNC_CANTSEEK;
+
+    if ((SEEK_SET == origin) && (0 == offset))
+    {
+        seek_result = (MCL_OK == http_request_rewind_body((http_request_t *)http_request)) ? CURL_SEEKFUNC_OK : CURL_SEEKFUNC_FAIL;
+    }
+
+    DEBUG_LEAVE("retVal = <%d>", seek_result);
+    return seek_result;
+}
+
+#if (1 == MCL_HAVE_ZLIB)
+// This function is the callback which is called when HTTP POST is requested with compressed payload.
+// The function takes in parameter "transfer" of type http_client_transfer_t and writes the next part of compressed payload to "buffer".
+// Payload is read from the read callback of the transfer if there is one, otherwise from the body of its request.
+static mcl_size_t _request_payload_callback_for_compression(char *buffer, mcl_size_t size, mcl_size_t count, void *transfer)
+{
+    DEBUG_ENTRY("char *buffer = <%p>, mcl_size_t size = <%u>, mcl_size_t count = <%u>, void *transfer = <%p>", buffer, size, count, transfer)
+
+    http_client_transfer_t *compressed_transfer = (http_client_transfer_t *)transfer;
+    mcl_size_t written_size = 0;
+    mcl_size_t input_size;
+
+    // Deflate may hold back compressed data until enough input is given, zero is returned to libcurl only at the end of payload.
+    while ((0 == written_size) && (MCL_FALSE == compression_is_finished(compressed_transfer->compression)))
+    {
+        if (MCL_TRUE == compression_needs_input(compressed_transfer->compression))
+        {
+            if ((MCL_NULL == compressed_transfer->read_callback) && (0 == compressed_transfer->http_request->fragment_count))
+            {
+                compression_set_input(compressed_transfer->compression, (mcl_uint8_t *)compressed_transfer->http_request->payload,
+                                      compressed_transfer->http_request->payload_size, MCL_TRUE);
+            }
+            else
+            {
+                if (MCL_NULL == compressed_transfer->read_callback)
+                {
+                    input_size = _request_payload_callback_for_fragments((char *)compressed_transfer->compression_input, 1, COMPRESSION_INPUT_BUFFER_SIZE,
+                                                                         compressed_transfer->http_request);
+                }
+                else
+                {
+                    input_size = compressed_transfer->read_callback(compressed_transfer->compression_input, 1, COMPRESSION_INPUT_BUFFER_SIZE,
+                                                                    compressed_transfer->read_user_context);
+                }
+
+                if (CURL_READFUNC_ABORT == input_size)
+                {
+                    MCL_ERROR("Read callback aborted the transfer.");
+                    DEBUG_LEAVE("retVal = <%u>", input_size);
+                    return input_size;
+                }
+
+                compression_set_input(compressed_transfer->compression, compressed_transfer->compression_input, input_size, (0 == input_size) ? MCL_TRUE : MCL_FALSE);
+            }
+        }
+
+        if (MCL_OK != compression_deflate(compressed_transfer->compression, (mcl_uint8_t *)buffer, size * count, &written_size))
+        {
+            DEBUG_LEAVE("retVal = <%u>", CURL_READFUNC_ABORT);
+            return CURL_READFUNC_ABORT;
+        }
+    }
+
+    DEBUG_LEAVE("retVal = <%u>", written_size);
+    return written_size;
+}
+
+// This function is the callback which is called when libcurl rewinds the compressed payload of HTTP POST to resend the request.
+// Payload is compressed again from its beginning, payload given by the read callback of the user can not be read again.
+static int _request_seek_callback_for_compression(void *transfer, curl_off_t offset, int origin)
+{
+    DEBUG_ENTRY("void *transfer = <%p>, curl_off_t offset = <%ld>, int origin = <%d>", transfer, (long)offset, origin)
+
+    http_client_transfer_t *compressed_transfer = (http_client_transfer_t *)transfer;
+    int seek_result = CURL_SEEKFUNC_CANTSEEK;
+
+    if ((SEEK_SET == origin) && (0 == offset) && (MCL_NULL == compressed_transfer->read_callback))
+    {
+        E_MCL_ERROR_CODE code = compression_reset(compressed_transfer->compression);
+
+        if ((MCL_OK == code) && (0 != compressed_transfer->http_request->fragment_count))
+        {
+            code = http_request_rewind_body(compressed_transfer->http_request);
+        }
+
+        seek_result = (MCL_OK == code) ? CURL_SEEKFUNC_OK : CURL_SEEKFUNC_FAIL;
+    }
+
+    DEBUG_LEAVE("retVal = <%d>", seek_result);
+    return seek_result;
+}
+#endif
+
 // This function checks if the given line is an empty line or not.
 static mcl_bool_t _is_empty_line(char *line)
 {
@@ -422,10 +1318,12 @@ static mcl_bool_t _is_empty_line(char *line)
 }
 
 // This function sets the options for the http request and returns the curl list of request headers.
-static struct curl_slist *_set_request_options(CURL *curl, http_request_t *http_request, http_client_send_callback_info_t *callback_info)
+static struct curl_slist *_set_request_options(http_client_transfer_t *transfer, http_request_t *http_request, http_client_send_callback_info_t *callback_info)
 {
-    DEBUG_ENTRY("CURL *curl = <%p>, http_request_t *http_request = <%p>, http_client_send_callback_info_t *callback_info = <%p>", curl, http_request, callback_info)
+    DEBUG_ENTRY("http_client_transfer_t *transfer = <%p>, http_request_t *http_request = <%p>, http_client_send_callback_info_t *callback_info = <%p>", transfer,
+                http_request, callback_info)
 
+    CURL *curl = transfer->curl;
     struct curl_slist *request_header_list = MCL_NULL;
     string_t *request_header_line = MCL_NULL;
 	mcl_size_t index;
@@ -442,6 +1340,8 @@ static struct curl_slist *_set_request_options(CURL *curl, http_request_t *http_
     curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE, -1);
     curl_easy_setopt(curl, CURLOPT_INFILESIZE, -1);
     curl_easy_setopt(curl, CURLOPT_READDATA, MCL_NULL);
+    curl_easy_setopt(curl, CURLOPT_SEEKFUNCTION, MCL_NULL);
+    curl_easy_setopt(curl, CURLOPT_SEEKDATA, MCL_NULL);
     curl_easy_setopt(curl, CURLOPT_POSTFIELDS, MCL_NULL);
 
     switch (http_request->method)
@@ -454,8 +1354,26 @@ static struct curl_slist *_set_request_options(CURL *curl, http_request_t *http_
         case MCL_HTTP_POST :
             curl_easy_setopt(curl, CURLOPT_POST, 1);
 
+            if ((MCL_TRUE == http_request->compress_payload) && (MCL_TRUE == _set_compression_options(transfer, http_request, callback_info)))
+            {
+                // Size of compressed payload is not known in advance, use Transfer-Encoding : chunked
+                request_header_list = curl_slist_append(request_header_list, http_header_names[HTTP_HEADER_TRANSFER_ENCODING_CHUNKED].buffer);
+                request_header_list = curl_slist_append(request_header_list, http_header_names[HTTP_HEADER_CONTENT_ENCODING_GZIP].buffer);
+            }
+
             // If a callback function is present, use Transfer-Encoding : chunked:
-            if (MCL_NULL == callback_info)
+            else if (((MCL_NULL == callback_info) || (MCL_NULL == callback_info->read_callback)) && (0 != http_request->fragment_count))
+            {
+                // Body is composed from payload buffer and fragments while it is sent, its size is known in advance.
+                curl_easy_setopt(curl, CURLOPT_READFUNCTION, _request_payload_callback_for_fragments);
+                curl_easy_setopt(curl, CURLOPT_READDATA, http_request);
+
+                // Libcurl rewinds the body if it resends the request, e.g. when a kept-alive connection is closed by the server.
+                curl_easy_setopt(curl, CURLOPT_SEEKFUNCTION, _request_seek_callback_for_fragments);
+                curl_easy_setopt(curl, CURLOPT_SEEKDATA, http_request);
+                curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE, (long)http_request_get_body_size(http_request));
+            }
+            else if ((MCL_NULL == callback_info) || (MCL_NULL == callback_info->read_callback))
             {
                 // Normal http transfer without chunked encoding
                 curl_easy_setopt(curl, CURLOPT_POSTFIELDS, (void *)http_request->payload);
@@ -481,6 +1399,8 @@ static struct curl_slist *_set_request_options(CURL *curl, http_request_t *http_
             curl_easy_setopt(curl, CURLOPT_UPLOAD, 1);
             curl_easy_setopt(curl, CURLOPT_READFUNCTION, _request_payload_callback_for_put);
             curl_easy_setopt(curl, CURLOPT_READDATA, http_request);
+            curl_easy_setopt(curl, CURLOPT_SEEKFUNCTION, _request_seek_callback_for_put);
+            curl_easy_setopt(curl, CURLOPT_SEEKDATA, http_request);
             curl_easy_setopt(curl, CURLOPT_INFILESIZE, http_request->payload_size);
 
             // TODO Use CURLOPT_INFILESIZE_LARGE for data larger than 2GB. Shall we check it here?
@@ -512,6 +1432,58 @@ static struct curl_slist *_set_request_options(CURL *curl, http_request_t *http_
     return request_header_list;
 }
 
+// This function starts compression of the request payload and sets the read callback which compresses it while it is sent.
+// Payload is not buffered a second time, it is compressed part by part from the request or from the read callback as libcurl asks for data.
+// Returns MCL_FALSE if compression can not be started, the payload is sent uncompressed in that case.
+static mcl_bool_t _set_compression_options(http_client_transfer_t *transfer, http_request_t *http_request, http_client_send_callback_info_t *callback_info)
+{
+    DEBUG_ENTRY("http_client_transfer_t *transfer = <%p>, http_request_t *http_request = <%p>, http_client_send_callback_info_t *callback_info = <%p>", transfer,
+                http_request, callback_info)
+
+#if (1 == MCL_HAVE_ZLIB)
+    E_MCL_ERROR_CODE code = compression_initialize(&(transfer->compression));
+
+    if ((MCL_OK == code) && (MCL_NULL != callback_info) && (MCL_NULL != callback_info->read_callback))
+    {
+        transfer->read_callback = callback_info->read_callback;
+        transfer->read_user_context = callback_info->user_context;
+    }
+
+    // Input buffer is needed if the payload is not in a single buffer.
+    if ((MCL_OK == code) && ((MCL_NULL != transfer->read_callback) || (0 != http_request->fragment_count)))
+    {
+        transfer->compression_input = MCL_MALLOC(COMPRESSION_INPUT_BUFFER_SIZE);
+
+        if (MCL_NULL == transfer->compression_input)
+        {
+            compression_destroy(&(transfer->compression));
+            code = MCL_OUT_OF_MEMORY;
+        }
+    }
+
+    if (MCL_OK != code)
+    {
+        MCL_WARN("Payload compression can not be started, payload will be sent uncompressed.");
+        DEBUG_LEAVE("retVal = <%d>", MCL_FALSE);
+        return MCL_FALSE;
+    }
+
+    transfer->http_request = http_request;
+    curl_easy_setopt(transfer->curl, CURLOPT_READFUNCTION, _request_payload_callback_for_compression);
+    curl_easy_setopt(transfer->curl, CURLOPT_READDATA, transfer);
+    curl_easy_setopt(transfer->curl, CURLOPT_SEEKFUNCTION, _request_seek_callback_for_compression);
+    curl_easy_setopt(transfer->curl, CURLOPT_SEEKDATA, transfer);
+
+    DEBUG_LEAVE("retVal = <%d>", MCL_TRUE);
+    return MCL_TRUE;
+#else
+    MCL_WARN("MCL is built without zlib, payload will be sent uncompressed.");
+
+    DEBUG_LEAVE("retVal = <%d>", MCL_FALSE);
+    return MCL_FALSE;
+#endif
+}
+
 #if MCL_LOG_UTIL_LEVEL < LOG_UTIL_LEVEL_INFO
 static int _curl_debug_callback(CURL *curl, curl_infotype info_type, char *data, mcl_size_t size, void *debug_data)
 {
@@ -620,3 +1592,31 @@ static E_MCL_ERROR_CODE _convert_to_mcl_error_code(CURLcode curl_code)
     DEBUG_LEAVE("retVal = <%d>", mcl_code);
     return mcl_code;
 }
+
+static void *_curl_malloc(size_t size)
+{
+    return memory_category_malloc(MCL_MEMORY_CATEGORY_CURL, size);
+}
+
+static void *_curl_calloc(size_t count, size_t size)
+{
+    return memory_category_calloc(MCL_MEMORY_CATEGORY_CURL, count, size);
+}
+
+static void *_curl_realloc(void *p, size_t size)
+{
+    return memory_category_realloc(MCL_MEMORY_CATEGORY_CURL, p, size);
+}
+
+static char *_curl_strdup(const char *string)
+{
+    mcl_size_t size = string_util_strlen(string) + 1;
+    char *duplicate = memory_category_malloc(MCL_MEMORY_CATEGORY_CURL, size);
+
+    if (MCL_NULL != duplicate)
+    {
+        string_util_memcpy(duplicate, string, size);
+    }
+
+    return duplicate;
+}
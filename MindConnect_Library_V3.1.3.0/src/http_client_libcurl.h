@@ -18,6 +18,7 @@
 #define HTTP_CLIENT_LIBCURL_H_
 
 #include "http_client.h"
+#include "list.h"
 
 // define CURL_STATICLIB before including curl.h otherwise linker wont be able to find __impl_* functions
 
@@ -26,9 +27,43 @@
 #endif
 #include "curl/curl.h"
 
+// OpenSSL types used by http client, declared here to keep OpenSSL headers out of this file.
+struct ssl_st;
+struct ssl_session_st;
+struct x509_store_st;
+
 struct http_client_t
 {
-    CURL *curl; //!< Curl handle.
+    CURL *curl;                          //!< Curl handle.
+    CURLM *multi;                        //!< Curl multi handle driving all transfers.
+    CURLSH *share;                       //!< Curl share handle through which all easy handles use the same TLS session cache.
+    mcl_bool_t curl_in_use;              //!< MCL_TRUE if curl handle is used by a transfer in flight.
+    list_t *transfers;                   //!< List of transfers in flight.
+    mcl_bool_t keep_alive;               //!< Connection is kept open for the next request if MCL_TRUE.
+    mcl_uint32_t idle_timeout;           //!< Idle time (in seconds) after which the kept-alive connection is not reused.
+    mcl_uint32_t max_requests;           //!< Maximum number of requests sent over a single connection. 0 means unlimited.
+    mcl_uint32_t connection_requests;    //!< Number of requests sent over the current connection.
+    mcl_time_t last_request_time;        //!< Time of the last request, used to detect idle connections.
+    mcl_size_t connections_opened;       //!< Number of requests for which a new connection is opened.
+    mcl_size_t connections_reused;       //!< Number of requests for which an existing connection is reused.
+    string_t *certificate;               //!< Mindsphere certificate given by the user.
+    struct x509_store_st *certificate_store; //!< Certificate store built once from the default CA certificates and #certificate, shared by all TLS contexts.
+    string_t *tls_session_path;          //!< Path of the file the last TLS session is saved to. Null if TLS sessions are not saved.
+    struct ssl_session_st *tls_session;  //!< Last TLS session loaded from or saved to #tls_session_path, resumed if libcurl has none for the connection.
+    mcl_uint8_t *tls_session_data;       //!< Serialized #tls_session as it is in #tls_session_path, an unchanged session is not saved again.
+    mcl_size_t tls_session_data_size;    //!< Size of #tls_session_data.
+    int (*new_session_callback)(struct ssl_st *ssl, struct ssl_session_st *session); //!< New session callback of libcurl, called after the session is saved.
 };
 
+/**
+ * This function saves the TLS session to the file at tls_session_path of @p http_client and keeps it to resume.
+ *
+ * The file can only be accessed by its owner and is replaced at once, it is not written if the session is the same as the saved one.
+ * Failing to save the session is not an error, the session is kept in memory in any case.
+ *
+ * @param [in] http_client Http client handle whose tls_session_path is set.
+ * @param [in] session TLS session to save. Http client takes a reference of it.
+ */
+void http_client_save_tls_session(http_client_t *http_client, struct ssl_session_st *session);
+
 #endif //HTTP_CLIENT_LIBCURL_H_
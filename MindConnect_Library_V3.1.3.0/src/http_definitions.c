@@ -31,5 +31,6 @@ string_t http_header_names[HTTP_HEADER_NAMES_END] =
 	STRING_CONSTANT("Server-Time"),
     STRING_CONSTANT("If-Match"),
     STRING_CONSTANT("ETag"),
-    STRING_CONSTANT("Correlation-ID")
+    STRING_CONSTANT("Correlation-ID"),
+    STRING_CONSTANT("Content-Encoding: gzip")
 };
@@ -40,6 +40,7 @@ typedef enum E_HTTP_HEADER_NAMES
 	HTTP_HEADER_IF_MATCH,                  //!< Http If-Match header name.
 	HTTP_HEADER_ETAG,                      //!< Http Etag header name.
 	HTTP_HEADER_CORRELATION_ID,            //!< Http Correlation-ID header name.
+	HTTP_HEADER_CONTENT_ENCODING_GZIP,     //!< Http content encoding gzip header.
 	HTTP_HEADER_NAMES_END                  //!< End of http header names.
 } E_HTTP_HEADER_NAMES;
 
@@ -11,6 +11,8 @@
  *
  ************************************************************************/
 
+#define MEMORY_CATEGORY MCL_MEMORY_CATEGORY_HTTP
+
 #include "http_processor.h"
 #include "log_util.h"
 #include "memory.h"
@@ -52,6 +54,7 @@
 #define JSON_NAME_KTY "kty"
 #define JSON_NAME_KID "kid"
 #define JSON_NAME_ACCESS_TOKEN "access_token"
+#define JSON_NAME_EXPIRES_IN "expires_in"
 
 #define REGISTER_URI_PATH "/register"
 #define ACCESS_TOKEN_URI_PATH "/token"
@@ -65,6 +68,8 @@
 
 #define CORRELATION_ID_BYTE_LENGTH 16
 
+static const char correlation_id_characters[] = "0123456789abcdef";
+
 /**
  * @brief Enumeration for the Mindsphere endpoints.
  */
@@ -123,8 +128,11 @@ static E_MCL_ERROR_CODE _add_actual_range_to_file(http_response_t *response, fil
 // This function fills an http request with the provided store as much as it can.
 static E_MCL_ERROR_CODE _exchange_fill_http_request(http_processor_t *http_processor, store_t *store, http_request_t *request);
 
-// Used for preperation of store data. This means the meta and payload strings preperation from their respective structed objects and setting the state of the data to PREPARED:
-static E_MCL_ERROR_CODE _exchange_prepare_data(store_data_t *store_data);
+// Writes the data in a non-streamable store to the request picking the largest data which may fit into the space left. Gets called by _exchange_fill_http_request:
+static E_MCL_ERROR_CODE _exchange_pack_store_data(store_t *store, http_request_t *request, mcl_bool_t *added_any_at_all);
+
+// Writes the data in a streamable store to the request in the order of store lists. Gets called by _exchange_fill_http_request:
+static E_MCL_ERROR_CODE _exchange_stream_store_data(store_t *store, http_request_t *request, mcl_bool_t *added_any_at_all);
 
 // This function adds the provided store data to the request. Gets called by _exchange_fill_http_request:
 static E_MCL_ERROR_CODE _exchange_add_current_data_to_request(store_data_t *current_store_data, http_request_t *request);
@@ -135,6 +143,27 @@ static E_MCL_ERROR_CODE _exchange_add_current_data_to_request_by_streaming(store
 // This is http response evaluation function. Also updates the store data states based on response status.
 static E_MCL_ERROR_CODE _exchange_evaluate_response(store_t *store, E_MCL_ERROR_CODE send_result, http_response_t *response, void **reserved, string_t *correlation_id);
 
+// This function creates the next exchange http request from the data in the store and adds its correlation id header.
+static E_MCL_ERROR_CODE _exchange_prepare_request(http_processor_t *http_processor, store_t *store, http_request_t **request, string_t **correlation_id);
+
+// Takes an exchange request from the request pool of http processor and resets it, initializes a new one if the pool is empty.
+static E_MCL_ERROR_CODE _exchange_acquire_request(http_processor_t *http_processor, http_request_t **request);
+
+// Puts an exchange request back to the request pool of http processor, destroys it if the pool is full. Request is set to NULL.
+static void _exchange_release_request(http_processor_t *http_processor, http_request_t **request);
+
+// This function prepares the next http request of an asynchronous exchange operation and starts sending it.
+static E_MCL_ERROR_CODE _exchange_async_send_next(http_processor_exchange_context_t *context);
+
+// This is the http client completion callback for asynchronous exchange operation.
+static void _exchange_async_complete_callback(E_MCL_ERROR_CODE code, http_response_t *response, void *user_context);
+
+// This is the http client idle callback for exchange operation. Prepares the next http request while the previous one is in flight.
+static void _exchange_pipeline_idle_callback(void *user_context);
+
+// This function changes the state of the store data which are in current_state to new_state. Returns the number of store data changed.
+static mcl_size_t _exchange_set_store_data_state(store_t *store, E_STORE_DATA_STATE current_state, E_STORE_DATA_STATE new_state);
+
 // This function updates the state's of the data in the store based on the send operation result. If the send operation is failed data needs to be written again so its write counters reset.
 static E_MCL_ERROR_CODE _exchange_update_store_state(store_t *store, mcl_bool_t send_operation_successful);
 
@@ -165,6 +194,17 @@ static mcl_size_t _get_payload_from_buffer(void *destination, void *source, mcl_
 // Returns the number of actual written count. user_context is not currently used.
 static mcl_size_t _get_payload_from_file(void *destination, void *file_descriptor, mcl_size_t size, void *user_context);
 
+// This is the callback function given as an argument to http_request_add_tuple function to move the file back to read the payload again.
+// Returns MCL_OK if the position of the file is moved back by size. user_context is not currently used.
+static E_MCL_ERROR_CODE _rewind_payload_of_file(void *file_descriptor, mcl_size_t size, void *user_context);
+
+// This is the callback function given as an argument to http_request_add_tuple function to write the time series payload in json format.
+// Returns the number of actual written count. user_context is not currently used.
+static mcl_size_t _get_payload_from_time_series(void *destination, void *time_series_payload, mcl_size_t size, void *user_context);
+
+// Callback function to get payload of a persisted data from write-ahead log. User context is the offset in payload to read from, NULL for the beginning of payload.
+static mcl_size_t _get_payload_from_store_wal(void *destination, void *store_wal_record, mcl_size_t size, void *user_context);
+
 #if MCL_STREAM_ENABLED
 // This is the http client read callback for stream operation. This function fills the provided buffer with the http reqeust payload data generated from the store.
 mcl_size_t _stream_callback(void *buffer, mcl_size_t size, mcl_size_t count, void *user_context);
@@ -185,7 +225,7 @@ static E_MCL_ERROR_CODE _check_file_path(const char *file_name);
 // Use custom function for loading register info.
 static E_MCL_ERROR_CODE _custom_load_register_info(http_processor_t *http_processor);
 static E_MCL_ERROR_CODE _evaluate_response_codes(http_response_t *response);
-static E_MCL_ERROR_CODE _generate_correlation_id_string(string_t **correlation_id);
+static E_MCL_ERROR_CODE _generate_correlation_id_string(random_pool_t *random_pool, string_t **correlation_id);
 
 // Saves registration information.
 E_MCL_ERROR_CODE _save_registration_information(http_processor_t *http_processor);
@@ -214,6 +254,10 @@ E_MCL_ERROR_CODE http_processor_initialize(configuration_t *configuration, http_
     // This is necessary for an unexpected call to http_processor_destroy() function.
     (*http_processor)->http_client = MCL_NULL;
     (*http_processor)->security_handler = MCL_NULL;
+    (*http_processor)->random_pool = MCL_NULL;
+    (*http_processor)->request_pool_count = 0;
+    (*http_processor)->async_exchange_count = 0;
+    (*http_processor)->destroying = MCL_FALSE;
 
     // Set pointer to configuration parameters.
     (*http_processor)->configuration = configuration;
@@ -228,6 +272,11 @@ E_MCL_ERROR_CODE http_processor_initialize(configuration_t *configuration, http_
     ASSERT_STATEMENT_CODE_MESSAGE(MCL_OK == return_code, http_processor_destroy(http_processor), return_code, "Security handler initialization failed.");
     MCL_DEBUG("Security handler is successfully initialized.");
 
+    // Initialize random pool.
+    return_code = random_pool_initialize(&((*http_processor)->random_pool));
+    ASSERT_STATEMENT_CODE_MESSAGE(MCL_OK == return_code, http_processor_destroy(http_processor), return_code, "Random pool initialization failed.");
+    MCL_DEBUG("Random pool is successfully initialized.");
+
     // Load registration information via custom functions if both function pointers are not null
     // or via file system if the path is specified.
     if ((MCL_NULL != (*http_processor)->configuration->load_function.rsa && MCL_NULL != (*http_processor)->configuration->save_function.rsa) || MCL_NULL != (*http_processor)->configuration->store_path)
@@ -335,6 +384,10 @@ E_MCL_ERROR_CODE http_processor_register(http_processor_t *http_processor)
     mcl_size_t header_size = 6;
     E_MCL_HTTP_METHOD http_method;
 
+    ASSERT_CODE_MESSAGE(MCL_FALSE == http_processor->destroying, MCL_NOT_INITIALIZED, "Http processor is being destroyed.");
+    // Blocking requests progress the transfers in flight as well, their callbacks could change the security information in use meanwhile.
+    ASSERT_CODE_MESSAGE(0 == http_processor->async_exchange_count, MCL_EXCHANGE_ASYNC_IS_ACTIVE, "Asynchronous exchange operations are in flight!");
+
     // Determine if onboarding or key rotation is requested.
     if (MCL_NULL == http_processor->security_handler->registration_access_token)
     {
@@ -385,7 +438,7 @@ E_MCL_ERROR_CODE http_processor_register(http_processor_t *http_processor)
     }
 
     (MCL_OK == result) && (result = http_request_initialize(http_method, registration_uri, header_size, payload->length, HTTP_REQUEST_RESIZE_ENABLED, http_processor->configuration->user_agent,
-                 http_processor->configuration->max_http_payload_size, &http_request));
+                 http_processor->configuration->max_http_payload_size, http_processor->random_pool, &http_request));
 
     if (MCL_OK != result)
     {
@@ -401,7 +454,7 @@ E_MCL_ERROR_CODE http_processor_register(http_processor_t *http_processor)
     (MCL_OK == result) && (result = http_request_add_header(http_request, &http_header_names[HTTP_HEADER_ACCEPT], &content_type_values[CONTENT_TYPE_APPLICATION_JSON]));
     (MCL_OK == result) && (result = http_request_add_header(http_request, &http_header_names[HTTP_HEADER_AUTHORIZATION], access_token));
 
-    (MCL_OK == result) && (result = _generate_correlation_id_string(&correlation_id));
+    (MCL_OK == result) && (result = _generate_correlation_id_string(http_processor->random_pool, &correlation_id));
     (MCL_OK == result) && (result = http_request_add_header(http_request, &http_header_names[HTTP_HEADER_CORRELATION_ID], correlation_id));
 
     // Send the request and get the response.
@@ -479,6 +532,10 @@ E_MCL_ERROR_CODE http_processor_update_security_information(http_processor_t *ht
     char *public_key = MCL_NULL;
     char *private_key = MCL_NULL;
 
+    ASSERT_CODE_MESSAGE(MCL_FALSE == http_processor->destroying, MCL_NOT_INITIALIZED, "Http processor is being destroyed.");
+    // Security information must not be replaced while asynchronous exchange operations are using it.
+    ASSERT_CODE_MESSAGE(0 == http_processor->async_exchange_count, MCL_EXCHANGE_ASYNC_IS_ACTIVE, "Asynchronous exchange operations are in flight!");
+
     mcl_bool_t callbacks_are_used = (MCL_NULL != http_processor->configuration->load_function.shared_secret && MCL_NULL != http_processor->configuration->save_function.shared_secret);
     ASSERT_CODE_MESSAGE(MCL_TRUE == (callbacks_are_used || MCL_NULL != http_processor->configuration->store_path), MCL_FAIL, "There is no way to update security information.");
 
@@ -559,6 +616,8 @@ E_MCL_ERROR_CODE http_processor_update_security_information(http_processor_t *ht
         string_destroy(&(http_processor->security_handler->client_secret));
         MCL_FREE(http_processor->security_handler->rsa.public_key);
         MCL_FREE(http_processor->security_handler->rsa.private_key);
+        security_handler_reset_rsa_key(http_processor->security_handler);
+        security_handler_reset_hmac_key(http_processor->security_handler);
 
         http_processor->security_handler->registration_access_token = registration_access_token_string;
         http_processor->security_handler->client_secret = client_secret_string;
@@ -590,17 +649,23 @@ E_MCL_ERROR_CODE http_processor_get_access_token(http_processor_t *http_processo
     string_t *server_time_header = MCL_NULL;
     json_t *response_payload = MCL_NULL;
     json_t *access_token = MCL_NULL;
+    json_t *expires_in = MCL_NULL;
+    mcl_time_t request_time;
+
+    ASSERT_CODE_MESSAGE(MCL_FALSE == http_processor->destroying, MCL_NOT_INITIALIZED, "Http processor is being destroyed.");
+    // Access token must not be replaced while asynchronous exchange operations are using it, nor renewed from their callbacks in a nested blocking request.
+    ASSERT_CODE_MESSAGE(0 == http_processor->async_exchange_count, MCL_EXCHANGE_ASYNC_IS_ACTIVE, "Asynchronous exchange operations are in flight!");
 
     // Create access token request payload.
     code = _compose_access_token_request_payload(http_processor, &request_payload);
 
     // Initialize HTTP request.
     (MCL_OK == code) && (code = http_request_initialize(MCL_HTTP_POST, http_processor->configuration->access_token_endpoint, 2, request_payload->length, HTTP_REQUEST_RESIZE_ENABLED, http_processor->configuration->user_agent,
-        http_processor->configuration->max_http_payload_size, &request));
+        http_processor->configuration->max_http_payload_size, http_processor->random_pool, &request));
 
     // Add headers to the request.
     (MCL_OK == code) && (code = http_request_add_header(request, &http_header_names[HTTP_HEADER_CONTENT_TYPE], &content_type_values[CONTENT_TYPE_URL_ENCODED]));
-    (MCL_OK == code) && (code = _generate_correlation_id_string(&correlation_id));
+    (MCL_OK == code) && (code = _generate_correlation_id_string(http_processor->random_pool, &correlation_id));
     (MCL_OK == code) && (code = http_request_add_header(request, &http_header_names[HTTP_HEADER_CORRELATION_ID], correlation_id));
 
     // Add payload to the request.
@@ -610,6 +675,9 @@ E_MCL_ERROR_CODE http_processor_get_access_token(http_processor_t *http_processo
     }
     string_destroy(&request_payload);
 
+    // Lifetime of the access token is counted from the time of the request, so that it never ends later than server assumes.
+    time_util_get_time(&request_time);
+
     // Send the request.
     (MCL_OK == code) && (code = http_client_send(http_processor->http_client, request, MCL_NULL, &response));
     http_request_destroy(&request);
@@ -646,6 +714,20 @@ E_MCL_ERROR_CODE http_processor_get_access_token(http_processor_t *http_processo
     string_destroy(&http_processor->security_handler->access_token);
     (MCL_OK == code) && (code = json_util_get_string(access_token, &http_processor->security_handler->access_token));
 
+    // Lifetime of the access token is optional in the response, without it the access token is renewed only after it is rejected.
+    http_processor->security_handler->access_token_expiry = 0;
+    if ((MCL_OK == code) && (MCL_OK == json_util_get_object_item(response_payload, JSON_NAME_EXPIRES_IN, &expires_in)))
+    {
+        mcl_int32_t lifetime = 0;
+
+        json_util_get_number_value(expires_in, &lifetime);
+        if (0 < lifetime)
+        {
+            http_processor->security_handler->access_token_expiry = request_time + lifetime;
+        }
+    }
+
+    MCL_FREE(expires_in);
     MCL_FREE(access_token);
     json_util_destroy(&response_payload);
 
@@ -653,12 +735,71 @@ E_MCL_ERROR_CODE http_processor_get_access_token(http_processor_t *http_processo
     return code;
 }
 
+mcl_bool_t http_processor_is_access_token_expiring(http_processor_t *http_processor)
+{
+    DEBUG_ENTRY("http_processor_t *http_processor = <%p>", http_processor)
+
+    mcl_time_t current_time;
+    mcl_bool_t is_expiring = MCL_FALSE;
+
+    if (0 != http_processor->security_handler->access_token_expiry)
+    {
+        time_util_get_time(&current_time);
+        is_expiring = (current_time + (mcl_time_t)http_processor->configuration->access_token_refresh_margin >= http_processor->security_handler->access_token_expiry) ? MCL_TRUE : MCL_FALSE;
+    }
+
+    DEBUG_LEAVE("retVal = <%d>", is_expiring);
+    return is_expiring;
+}
+
+E_MCL_ERROR_CODE http_processor_generate_next_rsa_key(http_processor_t *http_processor)
+{
+    DEBUG_ENTRY("http_processor_t *http_processor = <%p>", http_processor)
+
+    E_MCL_ERROR_CODE code;
+    char *public_key = MCL_NULL;
+    char *private_key = MCL_NULL;
+    mcl_bool_t critical_section_callbacks_are_used = MCL_NULL != http_processor->configuration->enter_critical_section && MCL_NULL != http_processor->configuration->leave_critical_section;
+
+    // Generating a 3072 bit key takes seconds, other operations must not wait for it.
+    code = security_generate_rsa_key(&public_key, &private_key);
+    ASSERT_CODE_MESSAGE(MCL_OK == code, code, "RSA keys can not be generated.");
+
+    if (critical_section_callbacks_are_used)
+    {
+        code = http_processor->configuration->enter_critical_section();
+    }
+
+    if (MCL_OK == code)
+    {
+        security_handler_set_next_rsa_key(http_processor->security_handler, public_key, private_key);
+        MCL_DEBUG("RSA keys for the next key rotation are generated.");
+
+        if (critical_section_callbacks_are_used)
+        {
+            http_processor->configuration->leave_critical_section();
+        }
+    }
+    else
+    {
+        MCL_FREE(public_key);
+        MCL_FREE(private_key);
+    }
+
+    DEBUG_LEAVE("retVal = <%d>", code);
+    return code;
+}
+
 #if MCL_FILE_DOWNLOAD_ENABLED
 E_MCL_ERROR_CODE http_processor_download(http_processor_t *http_processor, mcl_uint8_t * buffer, mcl_size_t buffer_size, mcl_size_t start_byte, mcl_size_t end_byte, string_t *file_id, mcl_bool_t with_range, file_t **file)
 {
 	DEBUG_ENTRY("http_processor_t *http_processor = <%p>, mcl_uint8_t *buffer = <%p>, mcl_size_t start_byte = <%u>, mcl_size_t end_byte <%u>, string_t *file_id = <%p>, mcl_bool_t with_range = <%d>, file_t **file = <%p>",
 		http_processor, buffer, start_byte, end_byte, file_id, with_range, file)
 
+	ASSERT_CODE_MESSAGE(MCL_FALSE == http_processor->destroying, MCL_NOT_INITIALIZED, "Http processor is being destroyed.");
+	// Download progresses the transfers in flight as well, their completion callbacks would be called in the middle of it.
+	ASSERT_CODE_MESSAGE(0 == http_processor->async_exchange_count, MCL_EXCHANGE_ASYNC_IS_ACTIVE, "Asynchronous exchange operations are in flight!");
+
 	// Prepare local vars
 	http_request_t *request = MCL_NULL;
 	mcl_size_t header_size = 3;
@@ -670,7 +811,7 @@ E_MCL_ERROR_CODE http_processor_download(http_processor_t *http_processor, mcl_u
 	string_destroy(&uri_temp);
 
 	(MCL_OK == result) && (result = http_request_initialize(MCL_HTTP_GET, uri, header_size, 0, HTTP_REQUEST_RESIZE_ENABLED, http_processor->configuration->user_agent,
-		http_processor->configuration->max_http_payload_size, &request));
+		http_processor->configuration->max_http_payload_size, http_processor->random_pool, &request));
 	string_destroy(&uri);
 
 	// Add authentication header
@@ -685,7 +826,7 @@ E_MCL_ERROR_CODE http_processor_download(http_processor_t *http_processor, mcl_u
     (MCL_OK == result) && (MCL_TRUE == with_range) && (result = _add_range_header(request, start_byte, end_byte));
 
 	string_t *correlation_id = MCL_NULL;
-	(MCL_OK == result) && (result = _generate_correlation_id_string(&correlation_id));
+	(MCL_OK == result) && (result = _generate_correlation_id_string(http_processor->random_pool, &correlation_id));
 	(MCL_OK == result) && (result = http_request_add_header(request, &http_header_names[HTTP_HEADER_CORRELATION_ID], correlation_id));
 
 	// Send request
@@ -788,87 +929,130 @@ E_MCL_ERROR_CODE http_processor_exchange(http_processor_t *http_processor, store
     DEBUG_ENTRY("http_processor_t *http_processor = <%p>, store_t *store = <%p>, void **reserved = <%p>", http_processor, store, reserved)
 
 	E_MCL_ERROR_CODE result;
+	mcl_size_t sending_count;
 
-	// TODO : Below var values needs to be optimized :
-	mcl_size_t header_size = 3;
-	mcl_size_t payload_size = 200;
-
+    ASSERT_CODE_MESSAGE(MCL_FALSE == http_processor->destroying, MCL_NOT_INITIALIZED, "Http processor is being destroyed.");
+    ASSERT_CODE_MESSAGE(0 == http_processor->async_exchange_count, MCL_EXCHANGE_ASYNC_IS_ACTIVE, "Asynchronous exchange operations are in flight!");
     ASSERT_CODE_MESSAGE(0 < store->high_priority_list->count + store->low_priority_list->count, MCL_STORE_IS_EMPTY, "Received store doesn't have any data inside!");
 
+    // Next http request is prepared by the idle callback while the previous one is in flight :
+    http_processor_exchange_pipeline_t pipeline =
+    {
+        http_processor, store, MCL_NULL, MCL_NULL, MCL_FALSE
+    };
+    http_client_send_callback_info_t send_callback_info;
+    send_callback_info.read_callback = MCL_NULL;
+    send_callback_info.user_context = &pipeline;
+    send_callback_info.idle_callback = _exchange_pipeline_idle_callback;
+
     // Continue generating an http request and send, until no data left in the store OR an error received:
 	do
 	{
 		// Prepare local vars
-		http_request_t *request = MCL_NULL;
-		string_t *correlation_id = MCL_NULL;
+		http_request_t *request = pipeline.next_request;
+		string_t *correlation_id = pipeline.next_correlation_id;
+		http_response_t *response = MCL_NULL;
 
 		MCL_DEBUG("Start of a fill and send iteration");
 
-        result = http_request_initialize(MCL_HTTP_POST, http_processor->configuration->exchange_endpoint, header_size, payload_size, HTTP_REQUEST_RESIZE_ENABLED, http_processor->configuration->user_agent,
-            http_processor->configuration->max_http_payload_size, &request);
-
-		ASSERT_CODE_MESSAGE(MCL_OK == result, result, "Initializing HTTP Request has failed!");
-
-		result = _exchange_initialize_http_request_headers(http_processor, request, MCL_TRUE);
+		pipeline.next_request = MCL_NULL;
+		pipeline.next_correlation_id = MCL_NULL;
 
-        if (MCL_OK != result)
-        {
-            http_request_destroy(&request);
-            MCL_ERROR_RETURN(result, "Initializing HTTP Request headers failed!");
-        }
-
-		MCL_DEBUG("A new http_request has been initialized");
+		// Prepare the request now if it could not be prepared while the previous one was in flight :
+		result = (MCL_NULL == request) ? _exchange_prepare_request(http_processor, store, &request, &correlation_id) : MCL_OK;
 
-		result = _exchange_fill_http_request(http_processor, store, request);
-
-		(MCL_OK == result) && (result = _generate_correlation_id_string(&correlation_id));
-		(MCL_OK == result) && (result = http_request_add_header(request, &http_header_names[HTTP_HEADER_CORRELATION_ID], correlation_id));
-
-		if (MCL_OK == result)
+		if (MCL_OK != result)
 		{
-			// Check if http_request is ready to be sent.
-			// Send it if it is ready
-			// request ready to be sent :
-			http_response_t *response = MCL_NULL;
+			// error case. Return the error.
+			MCL_DEBUG("An error has been occured during http request preparation = <%d>. Terminating the exchange operation.", result);
+			break;
+		}
 
-			// Not checking the result of send operation. Result will be evaluated based on the response.
-			result = http_client_send(http_processor->http_client, request, MCL_NULL, &response);
+		// Data written to this request is being sent, the next request can be written meanwhile if there is data left :
+		sending_count = _exchange_set_store_data_state(store, DATA_STATE_WRITTEN, DATA_STATE_SENDING);
+		pipeline.prepare_next = (sending_count < store_get_data_count(store)) ? MCL_TRUE : MCL_FALSE;
 
-			// request can be destroyed now ;
-	        http_request_destroy(&request);
+		// Not checking the result of send operation. Result will be evaluated based on the response.
+		result = http_client_send(http_processor->http_client, request, &send_callback_info, &response);
+		pipeline.prepare_next = MCL_FALSE;
 
-	        // then evaluate the response :
-			result = _exchange_evaluate_response(store, result, response, NULL, correlation_id);
+		// request can be reused now ;
+		_exchange_release_request(http_processor, &request);
 
-			if (MCL_OK != result)
-			{
-	            string_destroy(&correlation_id);
-				MCL_DEBUG("Evaluating the result returned as failed. Terminating the exchange operation.");
-				break;
-			}
-		}
-		else
+		// then evaluate the response :
+		result = _exchange_evaluate_response(store, result, response, NULL, correlation_id);
+		string_destroy(&correlation_id);
+
+		if (MCL_OK != result)
 		{
-			// error case. Return the error.
-		    string_destroy(&correlation_id);
-			MCL_DEBUG("An error has been occured during http request preparation = <%d>. Terminating the exchange operation.", result);
-			http_request_destroy(&request);
+			MCL_DEBUG("Evaluating the result returned as failed. Terminating the exchange operation.");
 			break;
 		}
-
-		string_destroy(&correlation_id);
-	} 
+	}
 	while (0 < store_get_data_count(store));
 
+	// Drop the next request if the operation is terminated. Its data has already been rolled back by the response evaluation.
+	if (MCL_NULL != pipeline.next_request)
+	{
+		_exchange_release_request(http_processor, &pipeline.next_request);
+		string_destroy(&pipeline.next_correlation_id);
+	}
+
 	DEBUG_LEAVE("retVal = <%d>", result);
 	return result;
 }
 
+E_MCL_ERROR_CODE http_processor_exchange_async(http_processor_t *http_processor, store_t *store, http_processor_exchange_callback callback, void *user_context)
+{
+    DEBUG_ENTRY("http_processor_t *http_processor = <%p>, store_t *store = <%p>, http_processor_exchange_callback callback = <%p>, void *user_context = <%p>",
+                http_processor, store, callback, user_context)
+
+    E_MCL_ERROR_CODE result;
+    http_processor_exchange_context_t *context;
+
+    ASSERT_CODE_MESSAGE(MCL_FALSE == http_processor->destroying, MCL_NOT_INITIALIZED, "Http processor is being destroyed.");
+    ASSERT_CODE_MESSAGE(0 < store_get_data_count(store), MCL_STORE_IS_EMPTY, "Received store doesn't have any data inside!");
+
+    MCL_NEW(context);
+    ASSERT_CODE_MESSAGE(MCL_NULL != context, MCL_OUT_OF_MEMORY, "Memory can not be allocated for exchange context.");
+
+    context->http_processor = http_processor;
+    context->store = store;
+    context->request = MCL_NULL;
+    context->correlation_id = MCL_NULL;
+    context->callback = callback;
+    context->user_context = user_context;
+
+    // Start sending the first request, the rest is sent from the completion callback.
+    result = _exchange_async_send_next(context);
+    ASSERT_STATEMENT_CODE_MESSAGE(MCL_OK == result, MCL_FREE(context), result, "Asynchronous exchange operation can not be started.");
+    ++http_processor->async_exchange_count;
+
+    DEBUG_LEAVE("retVal = <%d>", MCL_OK);
+    return MCL_OK;
+}
+
+E_MCL_ERROR_CODE http_processor_perform(http_processor_t *http_processor, mcl_uint32_t timeout, mcl_size_t *pending_count)
+{
+    DEBUG_ENTRY("http_processor_t *http_processor = <%p>, mcl_uint32_t timeout = <%u>, mcl_size_t *pending_count = <%p>", http_processor, timeout, pending_count)
+
+    E_MCL_ERROR_CODE result;
+
+    ASSERT_CODE_MESSAGE(MCL_FALSE == http_processor->destroying, MCL_NOT_INITIALIZED, "Http processor is being destroyed.");
+
+    result = http_client_perform(http_processor->http_client, timeout, pending_count);
+
+    DEBUG_LEAVE("retVal = <%d>", result);
+    return result;
+}
+
 E_MCL_ERROR_CODE http_processor_stream(http_processor_t *http_processor, store_t *store, void **reserved)
 {
 #if MCL_STREAM_ENABLED
     DEBUG_ENTRY("http_processor_t *http_processor = <%p>, store_t *store = <%p>, void **reserved = <%p>", http_processor, store, reserved)
 
+    ASSERT_CODE_MESSAGE(MCL_FALSE == http_processor->destroying, MCL_NOT_INITIALIZED, "Http processor is being destroyed.");
+    ASSERT_CODE_MESSAGE(0 == http_processor->async_exchange_count, MCL_EXCHANGE_ASYNC_IS_ACTIVE, "Asynchronous exchange operations are in flight!");
     ASSERT_CODE_MESSAGE(0 < store->high_priority_list->count + store->low_priority_list->count, MCL_STORE_IS_EMPTY, "Received store doesn't have any data inside!");
 
     // 0- Prepare local vars
@@ -887,6 +1071,7 @@ E_MCL_ERROR_CODE http_processor_stream(http_processor_t *http_processor, store_t
     http_client_send_callback_info_t send_callback_info;
     send_callback_info.read_callback = _stream_callback;
     send_callback_info.user_context = &http_processor_callback_context;
+    send_callback_info.idle_callback = MCL_NULL;
 
 	E_MCL_ERROR_CODE result = MCL_FAIL;
 
@@ -894,7 +1079,7 @@ E_MCL_ERROR_CODE http_processor_stream(http_processor_t *http_processor, store_t
     {
         // Initialize a new http_request:
         result = http_request_initialize(MCL_HTTP_POST, http_processor->configuration->exchange_endpoint, header_size, payload_size, HTTP_REQUEST_RESIZE_DISABLED, http_processor->configuration->user_agent,
-                                         http_processor->configuration->max_http_payload_size, &request);
+                                         http_processor->configuration->max_http_payload_size, http_processor->random_pool, &request);
 
         ASSERT_CODE_MESSAGE(MCL_OK == result, result, "Initializing HTTP Request is failed!");
 
@@ -910,13 +1095,17 @@ E_MCL_ERROR_CODE http_processor_stream(http_processor_t *http_processor, store_t
         }
 
         string_t *correlation_id = MCL_NULL;
-        (MCL_OK == result) && (result = _generate_correlation_id_string(&correlation_id));
+        (MCL_OK == result) && (result = _generate_correlation_id_string(http_processor->random_pool, &correlation_id));
         (MCL_OK == result) && (result = http_request_add_header(request, &http_header_names[HTTP_HEADER_CORRELATION_ID], correlation_id));
         (MCL_OK == result) && (result = http_client_send(http_processor->http_client, request, &send_callback_info, &response));
 
         // clean up request :
         http_request_destroy(&request);
 
+        // data written by the stream callback has been sent with this request :
+        _exchange_set_store_data_state(store, DATA_STATE_WRITTEN, DATA_STATE_SENDING);
+        store_age_low_priority_data(store);
+
         // then evaluate the response :
         result = _exchange_evaluate_response(store, result, response, NULL, correlation_id);
         string_destroy(&correlation_id);
@@ -935,18 +1124,45 @@ E_MCL_ERROR_CODE http_processor_stream(http_processor_t *http_processor, store_t
 #endif // MCL_STREAM_ENABLED
 }
 
+void http_processor_get_connection_statistics(http_processor_t *http_processor, mcl_size_t *connections_opened, mcl_size_t *connections_reused)
+{
+    DEBUG_ENTRY("http_processor_t *http_processor = <%p>, mcl_size_t *connections_opened = <%p>, mcl_size_t *connections_reused = <%p>", http_processor, connections_opened,
+                connections_reused)
+
+    http_client_get_connection_statistics(http_processor->http_client, connections_opened, connections_reused);
+
+    DEBUG_LEAVE("retVal = void");
+}
+
 void http_processor_destroy(http_processor_t **http_processor)
 {
     DEBUG_ENTRY("http_processor_t **http_processor = <%p>", http_processor)
 
-    if (MCL_NULL != *http_processor)
+    if ((MCL_NULL != *http_processor) && (MCL_TRUE == (*http_processor)->destroying))
+    {
+        // Called from a callback of a pending exchange operation, the outer call releases the resources.
+        MCL_DEBUG("Http processor handle is already being destroyed.");
+    }
+    else if (MCL_NULL != *http_processor)
     {
+        // Callbacks of the pending exchange operations are called while destroying the http client, they can not start new operations.
+        (*http_processor)->destroying = MCL_TRUE;
+
         // Destroy http client handler.
         http_client_destroy(&((*http_processor)->http_client));
 
         // Destroy security handler.
         security_handler_destroy(&((*http_processor)->security_handler));
 
+        // Destroy requests kept for reuse.
+        while (0 < (*http_processor)->request_pool_count)
+        {
+            http_request_destroy(&((*http_processor)->request_pool[--(*http_processor)->request_pool_count]));
+        }
+
+        // Destroy random pool.
+        random_pool_destroy(&((*http_processor)->random_pool));
+
 		// TODO: Check whether or not below code should be in communication_destroy.
 		string_destroy(&((*http_processor)->configuration->access_token_endpoint));
 		string_destroy(&((*http_processor)->configuration->exchange_endpoint));
@@ -1114,8 +1330,23 @@ static E_MCL_ERROR_CODE _exchange_add_current_data_to_request_by_streaming(store
                         current_store_data->stream_info->payload_stream_index = 0;
                     }
                 }
+                else if (STORE_DATA_PERSISTED == current_store_data->type)
+                {
+                    MCL_DEBUG("Type is STORE_DATA_PERSISTED. Calling write-ahead log read callback function.");
+                    result = http_request_add_raw_data(request, _get_payload_from_store_wal, &current_store_data->stream_info->payload_stream_index, current_store_data->data,
+                                                       left_payload_size, MCL_NULL);
+                }
                 else
                 {
+                    // time series payload needs to be generated into a buffer to be written partially :
+                    if ((STORE_DATA_TIME_SERIES == current_store_data->type) && (MCL_NULL == current_store_data->payload_buffer))
+                    {
+                        current_store_data->payload_buffer = MCL_MALLOC(current_store_data->payload_size);
+                        ASSERT_CODE_MESSAGE(MCL_NULL != current_store_data->payload_buffer, MCL_OUT_OF_MEMORY, "Memory can not be allocated for time series payload.");
+                        json_write_time_series_payload(&((time_series_t *)current_store_data->data)->payload, (char *)current_store_data->payload_buffer,
+                                                       current_store_data->payload_size);
+                    }
+
                     MCL_DEBUG("Type is <standard types>. Calling memory read callback function.");
                     result = http_request_add_raw_data(request, _get_payload_from_buffer, MCL_NULL,
                                                        (void *)(current_store_data->payload_buffer + current_store_data->stream_info->payload_stream_index),
@@ -1176,16 +1407,31 @@ static E_MCL_ERROR_CODE _exchange_add_current_data_to_request(store_data_t *curr
                             "Get content type and id info failed!");
 
         // Check if the store item is file or not.
+        // Meta and payload of store data stay valid until the response is evaluated, so they are not copied into the request if
+        // they can be read while the request is being sent. File is read sequentially from its current position while sending.
+        // Time series json and persisted data are copied since their callbacks can not write their payloads in parts.
         if (STORE_DATA_FILE == current_store_data->type)
         {
             file_t *file = (file_t *)current_store_data->data;
-            result = http_request_add_tuple(request, current_store_data->meta, meta_content_type, _get_payload_from_file, MCL_NULL, file->descriptor,
-                                            current_store_data->payload_size, payload_content_type);
+            result = http_request_add_tuple(request, current_store_data->meta, meta_content_type, _get_payload_from_file, _rewind_payload_of_file, MCL_NULL, file->descriptor,
+                                            current_store_data->payload_size, payload_content_type, MCL_FALSE);
+        }
+        else if ((STORE_DATA_TIME_SERIES == current_store_data->type) && (MCL_NULL == current_store_data->payload_buffer))
+        {
+            time_series_t *time_series = (time_series_t *)current_store_data->data;
+            result = http_request_add_tuple(request, current_store_data->meta, meta_content_type, _get_payload_from_time_series, MCL_NULL, MCL_NULL, &time_series->payload,
+                                            current_store_data->payload_size, payload_content_type, MCL_TRUE);
+        }
+        else if (STORE_DATA_PERSISTED == current_store_data->type)
+        {
+            result = http_request_add_tuple(request, current_store_data->meta, meta_content_type, _get_payload_from_store_wal, MCL_NULL, MCL_NULL, current_store_data->data,
+                                            current_store_data->payload_size, payload_content_type, MCL_TRUE);
         }
         else
         {
-            result = http_request_add_tuple(request, current_store_data->meta, meta_content_type, _get_payload_from_buffer, MCL_NULL, current_store_data->payload_buffer,
-                                            current_store_data->payload_size, payload_content_type);
+            // Payload buffer is referenced as it is, no callback is needed.
+            result = http_request_add_tuple(request, current_store_data->meta, meta_content_type, MCL_NULL, MCL_NULL, MCL_NULL, current_store_data->payload_buffer,
+                                            current_store_data->payload_size, payload_content_type, MCL_FALSE);
         }
 
         // check the result and adjust written info of the data ::
@@ -1211,133 +1457,99 @@ static E_MCL_ERROR_CODE _exchange_add_current_data_to_request(store_data_t *curr
     return result;
 }
 
-static E_MCL_ERROR_CODE _exchange_prepare_data(store_data_t *store_data)
+E_MCL_ERROR_CODE _exchange_fill_http_request(http_processor_t *http_processor, store_t *store, http_request_t *request)
 {
-	DEBUG_ENTRY("store_data_t *store_data = <%p>", store_data)
+    DEBUG_ENTRY("http_processor_t *http_processor = <%p>, store_t *store = <%p>, http_request_t *request = <%p>", http_processor, store, request)
 
-	event_list_t *event_list;
-	string_t *payload_string = MCL_NULL;
+    E_MCL_ERROR_CODE add_result;
+    mcl_bool_t added_any_at_all = MCL_FALSE;
 
-    // generate the meta/payload string based on the type:
-    if (STORE_DATA_TIME_SERIES == store_data->type)
+    if (MCL_TRUE == store->streamable)
     {
-		time_series_t *time_series;
-		string_t *payload_string = MCL_NULL;
-
-        MCL_DEBUG("Item type = <time_series>");
-
-        time_series = (time_series_t *)store_data->data;
-
-        // generate the meta string :
-        ASSERT_CODE_MESSAGE(MCL_OK == json_from_item_meta(&time_series->meta, &store_data->meta), MCL_FAIL, "Get meta string from item meta for time_series has been failed!");
-
-        if (MCL_OK != json_from_time_series_payload(&time_series->payload, &payload_string))
-        {
-            string_destroy(&store_data->meta);
-            MCL_ERROR_RETURN(MCL_FAIL, "Get meta string from item meta for time_series has been failed!");
-        }
-        store_data->payload_buffer = (mcl_uint8_t *)payload_string->buffer;
-        store_data->payload_size = payload_string->length;
-
-        // only buffer of the string_t is used as the payload. string_t object needs to be freed. We don't use string_destroy because it also frees the buffer which we don't want.
-        MCL_FREE(payload_string);
+        add_result = _exchange_stream_store_data(store, request, &added_any_at_all);
     }
-    else if (STORE_DATA_EVENT_LIST == store_data->type)
+    else
     {
-        MCL_DEBUG("Item type = <event>");
-
-        event_list = (event_list_t *)store_data->data;
-
-        // generate the meta string :
-        ASSERT_CODE_MESSAGE(MCL_OK == json_from_item_meta(event_list->meta, &store_data->meta), MCL_FAIL, "Get meta string from item meta for event has been failed!");
-
-        if (MCL_OK != json_from_event_payload(event_list->events, &payload_string))
-        {
-            string_destroy(&store_data->meta);
-            MCL_ERROR_RETURN(MCL_FAIL, "Get meta string from item meta for event has been failed!");
-        }
-        store_data->payload_buffer = (mcl_uint8_t *)payload_string->buffer;
-        store_data->payload_size = payload_string->length;
-
-        // only buffer of the string_t is used as the payload. string_t object needs to be freed. We don't use string_destroy because it also frees the buffer which we don't want.
-        MCL_FREE(payload_string);
+        add_result = _exchange_pack_store_data(store, request, &added_any_at_all);
     }
-    else if (STORE_DATA_FILE == store_data->type)
-    {
-		file_t *file;
-
-        MCL_DEBUG("Item type = <file>");
-
-        file = (file_t *)store_data->data;
-
-        // generate the meta string :
-        ASSERT_CODE_MESSAGE(MCL_OK == json_from_item_meta(&file->meta, &store_data->meta), MCL_FAIL, "Get meta string from item meta for file has been failed!");
 
-        // get file size.
-        store_data->payload_size = file->payload.size;
-    }
-    else if (STORE_DATA_CUSTOM == store_data->type)
+    // Streaming is active or data couldn't be prepared :
+    if (MCL_OK != add_result)
     {
-		custom_data_t *custom_data;
-
-        MCL_DEBUG("Item type = <custom_data>");
-
-        custom_data = (custom_data_t *)store_data->data;
-
-        // generate the meta string :
-        ASSERT_CODE_MESSAGE(MCL_OK == json_from_item_meta(&custom_data->meta, &store_data->meta), MCL_FAIL, "Get meta string from item meta for custom_data has been failed!");
-
-        // custom data's payload will be its payload without any conversion :
-        store_data->payload_buffer = custom_data->payload.buffer;
-        store_data->payload_size = custom_data->payload.size;
+        DEBUG_LEAVE("retVal = <%d>", add_result);
+        return add_result;
     }
-    else if (STORE_DATA_STREAM == store_data->type)
-    {
-		stream_data_t *stream_data;
 
-        MCL_DEBUG("Item type = <stream_data>");
-
-        stream_data = (stream_data_t *)store_data->data;
-
-        // generate the meta string :
-        ASSERT_CODE_MESSAGE(MCL_OK == json_from_item_meta(&stream_data->base->meta, &store_data->meta), MCL_FAIL,
-                            "Get meta string from item meta for custom_data has been failed!");
-
-        // its payload will be read from the callback.
+    if (MCL_FALSE == added_any_at_all)
+    {
+        MCL_DEBUG("Not any of the data in the store could be added to the request. There is no suitable data in it.");
+        add_result = MCL_STORE_ITEM_EXCEEDS_MAX_HTTP_REQUEST_SIZE;
     }
-    else if (STORE_DATA_DATA_SOURCE_CONFIGURATION == store_data->type)
+    else
     {
-		data_source_configuration_t *data_source_configuration;
-		string_t *payload_string = MCL_NULL;
+        MCL_DEBUG("Http request is ready to send. Finalizing..");
+        add_result = _exchange_finalize_http_request(http_processor, request, MCL_FALSE);
+    }
 
-        MCL_DEBUG("Item type = <data_source_configuration>");
+    DEBUG_LEAVE("retVal = <%d>", add_result);
+    return add_result;
+}
 
-        data_source_configuration = (data_source_configuration_t *)store_data->data;
+static E_MCL_ERROR_CODE _exchange_pack_store_data(store_t *store, http_request_t *request, mcl_bool_t *added_any_at_all)
+{
+    DEBUG_ENTRY("store_t *store = <%p>, http_request_t *request = <%p>, mcl_bool_t *added_any_at_all = <%p>", store, request, added_any_at_all)
+
+    // Data waiting to be written is kept in size classes by the index of each store list. High priority data is written first,
+    // the space left is backfilled with low priority data.
+    //
+    // In every iteration the largest data with a size class less than the limit is tried. If it does not fit into the request,
+    // the limit is lowered to its size class, data of the same or larger size classes is not tried again for this request.
+    // This way every data is tried at most once and each try needs a search in a fixed number of size classes, instead of walking the store lists.
 
-        // generate the meta string :
-        ASSERT_CODE_MESSAGE(MCL_OK == json_from_item_meta(&data_source_configuration->meta, &store_data->meta), MCL_FAIL, "Get meta string from item meta for data source configuration has been failed!");
+    store_index_t *indexes[MCL_STORE_PRIORITY_END] = {&store->high_priority_index, &store->low_priority_index};
+	mcl_size_t size_class_limit = STORE_SIZE_CLASS_COUNT;
+	mcl_size_t index_number;
+	mcl_bool_t aborted = MCL_FALSE;
+	store_data_t *store_data;
+	E_MCL_ERROR_CODE add_result;
 
-        if (MCL_OK != json_from_data_source_configuration_payload(&data_source_configuration->payload, &payload_string))
+    for (index_number = 0; (MCL_FALSE == aborted) && (index_number < MCL_STORE_PRIORITY_END); index_number++)
+    {
+        // Prepare data ( Generate meta/payload strings ) which is not prepared yet, it is indexed by its size afterwards :
+        while (MCL_NULL != (store_data = indexes[index_number]->initial.head))
         {
-            string_destroy(&store_data->meta);
-            MCL_ERROR_RETURN(MCL_FAIL, "Get meta string from item meta for data source configuration has been failed!");
+            ASSERT_CODE_MESSAGE(MCL_OK == store_data_prepare(store, store_data), MCL_FAIL, "Preparation of store data has been failed!");
         }
-        store_data->payload_buffer = (mcl_uint8_t *)payload_string->buffer;
-        store_data->payload_size = payload_string->length;
 
-        // only buffer of the string_t is used as the payload. string_t object needs to be freed. We don't use string_destroy because it also frees the buffer which we don't want.
-        MCL_FREE(payload_string);
-    }
+        while ((MCL_FALSE == aborted) && (MCL_NULL != (store_data = store_index_find_prepared_data(indexes[index_number], size_class_limit))))
+        {
+            add_result = _exchange_add_current_data_to_request(store_data, request);
 
-    store_data_set_state(store_data, DATA_STATE_PREPARED);
+            if (MCL_OK == add_result)
+            {
+                MCL_DEBUG("Current data has been added to the http request successfully.");
+                *added_any_at_all = MCL_TRUE;
+            }
+            else if (MCL_HTTP_REQUEST_NO_MORE_SPACE == add_result)
+            {
+                MCL_DEBUG("There is not enough space left in the http request for current data. Only smaller data will be tried.");
+                size_class_limit = store_data_get_size_class(store_data);
+            }
+            else
+            {
+                MCL_DEBUG("Error response received from http request add operation. Aborting the operation!");
+                aborted = MCL_TRUE;
+            }
+        }
+    }
 
     DEBUG_LEAVE("retVal = <%d>", MCL_OK);
     return MCL_OK;
 }
 
-E_MCL_ERROR_CODE _exchange_fill_http_request(http_processor_t *http_processor, store_t *store, http_request_t *request)
+static E_MCL_ERROR_CODE _exchange_stream_store_data(store_t *store, http_request_t *request, mcl_bool_t *added_any_at_all)
 {
-    DEBUG_ENTRY("http_processor_t *http_processor = <%p>, store_t *store = <%p>, http_request_t *request = <%p>", http_processor, store, request)
+    DEBUG_ENTRY("store_t *store = <%p>, http_request_t *request = <%p>, mcl_bool_t *added_any_at_all = <%p>", store, request, added_any_at_all)
 
     // With a main loop, function will try to add one item from the lists in store in every iteration.
     //
@@ -1358,24 +1570,21 @@ E_MCL_ERROR_CODE _exchange_fill_http_request(http_processor_t *http_processor, s
     // If they couldn't be added to the request, at some point current_item will point to the NULL which means
     // every item in the list is tried.
     //
-    // In one iteration, if none of the items in the list is able to fit in the current request ( added_any == MCL_FALSE ), we break the loop.
-    // There is no point to try any further in this case.
+    // In one iteration, if none of the items in the list is able to fit in the current request ( added_any == MCL_FALSE ), we are done with that list.
+    // The high priority list is walked first. When no more high priority item fits, the space left is backfilled from the low priority list
+    // and we break the loop when no more low priority item fits either. There is no point to try any further in this case.
     //
 
     store_data_t *current_store_data = MCL_NULL;
 
-    // Initialize with store empty code; if there won't be any suitable data found in store ( no data in Prepared ) or the store is actually empty,
-    // this function will return MCL_STORE_IS_EMPTY.
-
     E_MCL_ERROR_CODE add_result;
     mcl_bool_t added_any = MCL_FALSE;
-    mcl_bool_t added_any_at_all = MCL_FALSE;
 
-    // TODO : Currently using only the high priority list
+    // High priority items are written first :
     list_t *current_list = store->high_priority_list;
 
-    // Set current node to list's current node:
-    list_node_t *current_list_node = current_list->current;
+    // Start from the beginning of the list:
+    list_node_t *current_list_node = current_list->head;
 
     MCL_DEBUG("Loop starting");
     do
@@ -1389,7 +1598,7 @@ E_MCL_ERROR_CODE _exchange_fill_http_request(http_processor_t *http_processor, s
             // Prepare data ( Generate meta/payload strings ) if it is not already prepared.
             if (DATA_STATE_INITIAL == store_data_get_state(current_store_data))
             {
-                ASSERT_CODE_MESSAGE(MCL_OK == _exchange_prepare_data(current_store_data), MCL_FAIL, "Generation of meta/payload buffers has been failed!");
+                ASSERT_CODE_MESSAGE(MCL_OK == store_data_prepare(store, current_store_data), MCL_FAIL, "Preparation of store data has been failed!");
             }
 
             // If data is not written already ( state == DATA_STATE_PREPARED ), try to add it :
@@ -1410,7 +1619,7 @@ E_MCL_ERROR_CODE _exchange_fill_http_request(http_processor_t *http_processor, s
                 {
                     MCL_DEBUG("Current data has been added to the http request successfully. We continue to add for other items in the list.");
                     added_any = MCL_TRUE;
-                    added_any_at_all = MCL_TRUE;
+                    *added_any_at_all = MCL_TRUE;
                 }
                 else if (MCL_HTTP_REQUEST_NO_MORE_SPACE == add_result)
                 {
@@ -1466,7 +1675,14 @@ E_MCL_ERROR_CODE _exchange_fill_http_request(http_processor_t *http_processor, s
             MCL_DEBUG("End of list reached in the list.");
 
             // reached list end. If we didn't add anything since the last trip on the list; it means there is no data left in the list to add
-            if (MCL_FALSE == added_any)
+            if ((MCL_FALSE == added_any) && (store->high_priority_list == current_list))
+            {
+                // No more high priority data fits in the request. Space left is backfilled with low priority data :
+                MCL_DEBUG("No high priority item has been added to the request in this iteration. Continuing with the low priority list.");
+                current_list = store->low_priority_list;
+                current_list_node = current_list->head;
+            }
+            else if (MCL_FALSE == added_any)
             {
                 // In this iteration we tried till the NULL node and not any data could be added to the request
                 // There is either no data left in the list or the no data is not suitable for the current
@@ -1490,19 +1706,171 @@ E_MCL_ERROR_CODE _exchange_fill_http_request(http_processor_t *http_processor, s
 
     MCL_DEBUG("Loop has ended.");
 
-    if (MCL_FALSE == added_any_at_all)
+    DEBUG_LEAVE("retVal = <%d>", MCL_OK);
+    return MCL_OK;
+}
+
+static E_MCL_ERROR_CODE _exchange_prepare_request(http_processor_t *http_processor, store_t *store, http_request_t **request, string_t **correlation_id)
+{
+    DEBUG_ENTRY("http_processor_t *http_processor = <%p>, store_t *store = <%p>, http_request_t **request = <%p>, string_t **correlation_id = <%p>", http_processor, store,
+                request, correlation_id)
+
+    E_MCL_ERROR_CODE result;
+
+    result = _exchange_acquire_request(http_processor, request);
+    ASSERT_CODE_MESSAGE(MCL_OK == result, result, "Initializing HTTP Request has failed!");
+
+    result = _exchange_initialize_http_request_headers(http_processor, *request, MCL_TRUE);
+    ASSERT_STATEMENT_CODE_MESSAGE(MCL_OK == result, _exchange_release_request(http_processor, request), result, "Initializing HTTP Request headers failed!");
+
+    MCL_DEBUG("A new http_request has been initialized");
+
+    result = _exchange_fill_http_request(http_processor, store, *request);
+
+    // Low priority data which did not make it into this request gets closer to be sent with high priority :
+    if (MCL_OK == result)
     {
-        MCL_DEBUG("Not any of the data in the store could be added to the request. There is no suitable data in it.");
-        add_result = MCL_STORE_ITEM_EXCEEDS_MAX_HTTP_REQUEST_SIZE;
+        store_age_low_priority_data(store);
+    }
+
+    (MCL_OK == result) && (result = _generate_correlation_id_string(http_processor->random_pool, correlation_id));
+    (MCL_OK == result) && (result = http_request_add_header(*request, &http_header_names[HTTP_HEADER_CORRELATION_ID], *correlation_id));
+
+    if (MCL_OK != result)
+    {
+        // Data written to the request will not be sent, it needs to be written again.
+        _exchange_set_store_data_state(store, DATA_STATE_WRITTEN, DATA_STATE_PREPARED);
+        string_destroy(correlation_id);
+        _exchange_release_request(http_processor, request);
+    }
+
+    DEBUG_LEAVE("retVal = <%d>", result);
+    return result;
+}
+
+static E_MCL_ERROR_CODE _exchange_acquire_request(http_processor_t *http_processor, http_request_t **request)
+{
+    DEBUG_ENTRY("http_processor_t *http_processor = <%p>, http_request_t **request = <%p>", http_processor, request)
+
+    E_MCL_ERROR_CODE result;
+
+    // Initial sizes only matter for the first requests, buffers of pooled requests grow up to max_http_payload_size as needed and are kept.
+    mcl_size_t header_size = 3;
+    mcl_size_t payload_size = 200;
+
+    if (0 < http_processor->request_pool_count)
+    {
+        *request = http_processor->request_pool[--http_processor->request_pool_count];
+        result = http_request_reset(*request);
+        ASSERT_STATEMENT_CODE_MESSAGE(MCL_OK == result, http_request_destroy(request), result, "Reusing HTTP Request has failed!");
     }
     else
     {
-        MCL_DEBUG("Http request is ready to send. Finalizing..");
-        add_result = _exchange_finalize_http_request(http_processor, request, MCL_FALSE);
+        result = http_request_initialize(MCL_HTTP_POST, http_processor->configuration->exchange_endpoint, header_size, payload_size, HTTP_REQUEST_RESIZE_ENABLED,
+                                         http_processor->configuration->user_agent, http_processor->configuration->max_http_payload_size, http_processor->random_pool, request);
+        ASSERT_CODE_MESSAGE(MCL_OK == result, result, "Initializing HTTP Request has failed!");
+
+        (*request)->reusable = MCL_TRUE;
     }
 
-    DEBUG_LEAVE("retVal = <%d>", add_result);
-    return add_result;
+    DEBUG_LEAVE("retVal = <%d>", MCL_OK);
+    return MCL_OK;
+}
+
+static void _exchange_release_request(http_processor_t *http_processor, http_request_t **request)
+{
+    DEBUG_ENTRY("http_processor_t *http_processor = <%p>, http_request_t **request = <%p>", http_processor, request)
+
+    if ((MCL_NULL != *request) && (HTTP_PROCESSOR_REQUEST_POOL_SIZE > http_processor->request_pool_count))
+    {
+        http_processor->request_pool[http_processor->request_pool_count++] = *request;
+        *request = MCL_NULL;
+    }
+    else
+    {
+        http_request_destroy(request);
+    }
+
+    DEBUG_LEAVE("retVal = void");
+}
+
+static E_MCL_ERROR_CODE _exchange_async_send_next(http_processor_exchange_context_t *context)
+{
+    DEBUG_ENTRY("http_processor_exchange_context_t *context = <%p>", context)
+
+    E_MCL_ERROR_CODE result;
+
+    result = _exchange_prepare_request(context->http_processor, context->store, &context->request, &context->correlation_id);
+    ASSERT_CODE_MESSAGE(MCL_OK == result, result, "Http request can not be prepared.");
+
+    _exchange_set_store_data_state(context->store, DATA_STATE_WRITTEN, DATA_STATE_SENDING);
+    result = http_client_send_async(context->http_processor->http_client, context->request, MCL_NULL, _exchange_async_complete_callback, context);
+
+    if (MCL_OK != result)
+    {
+        // Data written to the request is not sent, roll back the store data states.
+        _exchange_release_request(context->http_processor, &context->request);
+        _exchange_evaluate_response(context->store, result, MCL_NULL, MCL_NULL, context->correlation_id);
+        string_destroy(&context->correlation_id);
+    }
+
+    DEBUG_LEAVE("retVal = <%d>", result);
+    return result;
+}
+
+static void _exchange_async_complete_callback(E_MCL_ERROR_CODE code, http_response_t *response, void *user_context)
+{
+    DEBUG_ENTRY("E_MCL_ERROR_CODE code = <%d>, http_response_t *response = <%p>, void *user_context = <%p>", code, response, user_context)
+
+    E_MCL_ERROR_CODE result;
+    http_processor_exchange_context_t *context = (http_processor_exchange_context_t *)user_context;
+
+    // request can be reused now, then evaluate the response :
+    _exchange_release_request(context->http_processor, &context->request);
+    result = _exchange_evaluate_response(context->store, code, response, MCL_NULL, context->correlation_id);
+    string_destroy(&context->correlation_id);
+
+    // Continue with the next request if there is data left in the store and the http processor is not being destroyed.
+    if ((MCL_OK == result) && (0 < store_get_data_count(context->store)) && (MCL_FALSE == context->http_processor->destroying))
+    {
+        result = _exchange_async_send_next(context);
+
+        if (MCL_OK == result)
+        {
+            DEBUG_LEAVE("retVal = void");
+            return;
+        }
+    }
+
+    // The exchange operation is completed, a synchronous exchange can be performed from the callback if this is the last one.
+    --context->http_processor->async_exchange_count;
+    context->callback(result, context->store, context->user_context);
+    MCL_FREE(context);
+
+    DEBUG_LEAVE("retVal = void");
+}
+
+static void _exchange_pipeline_idle_callback(void *user_context)
+{
+    DEBUG_ENTRY("void *user_context = <%p>", user_context)
+
+    E_MCL_ERROR_CODE result;
+    http_processor_exchange_pipeline_t *pipeline = (http_processor_exchange_pipeline_t *)user_context;
+
+    // Next request is prepared only once for each request in flight.
+    if (MCL_TRUE == pipeline->prepare_next)
+    {
+        pipeline->prepare_next = MCL_FALSE;
+
+        result = _exchange_prepare_request(pipeline->http_processor, pipeline->store, &pipeline->next_request, &pipeline->next_correlation_id);
+
+        if (MCL_OK != result)
+        {
+            MCL_DEBUG("Next http request can not be prepared in advance = <%d>. It will be prepared after the response is received.", result);
+        }
+    }
+
+    DEBUG_LEAVE("retVal = void");
 }
 
 static E_MCL_ERROR_CODE _exchange_evaluate_response(store_t *store, E_MCL_ERROR_CODE send_result, http_response_t *response, void **reserved, string_t *correlation_id)
@@ -1563,7 +1931,7 @@ static E_MCL_ERROR_CODE _exchange_update_store_data_state(store_data_t *store_da
 
     E_STORE_DATA_STATE state = store_data_get_state(store_data);
 
-    if (DATA_STATE_WRITTEN == state)
+    if (DATA_STATE_SENDING == state)
     {
         if (MCL_TRUE == send_operation_successful)
         {
@@ -1576,6 +1944,11 @@ static E_MCL_ERROR_CODE _exchange_update_store_data_state(store_data_t *store_da
             store_data_set_state(store_data, DATA_STATE_PREPARED);
         }
     }
+    else if ((DATA_STATE_WRITTEN == state) && (MCL_FALSE == send_operation_successful))
+    {
+        // data has been written to the next request which will not be sent since the operation is terminated :
+        store_data_set_state(store_data, DATA_STATE_PREPARED);
+    }
     else
     {
         // no need to update the state
@@ -1590,52 +1963,81 @@ static E_MCL_ERROR_CODE _exchange_update_store_state(store_t *store, mcl_bool_t
 {
     DEBUG_ENTRY("store_t *store = <%p>, mcl_bool_t send_operation_successful = <%u>", store, send_operation_successful)
 
-    list_node_t *current_node = MCL_NULL;
-
-    list_reset(store->high_priority_list);
-    list_reset(store->low_priority_list);
+    store_data_t *store_data = store->in_flight.head;
+    store_data_t *next_store_data;
 
-    // high_priority_list
-    while (MCL_NULL != (current_node = list_next(store->high_priority_list)))
+    // Only the data written to a request can change state. Data which is rolled back leaves the in flight queue :
+    while (MCL_NULL != store_data)
     {
-        _exchange_update_store_data_state((store_data_t *)current_node->data, send_operation_successful);
+        next_store_data = store_data->queue_next;
+        _exchange_update_store_data_state(store_data, send_operation_successful);
+        store_data = next_store_data;
     }
 
-    // low_priority_list
-    while (MCL_NULL != (current_node = list_next(store->low_priority_list)))
+    DEBUG_LEAVE("retVal = <%d>", MCL_OK);
+    return MCL_OK;
+}
+
+static mcl_size_t _exchange_set_store_data_state(store_t *store, E_STORE_DATA_STATE current_state, E_STORE_DATA_STATE new_state)
+{
+    DEBUG_ENTRY("store_t *store = <%p>, E_STORE_DATA_STATE current_state = <%d>, E_STORE_DATA_STATE new_state = <%d>", store, current_state, new_state)
+
+    store_data_t *store_data = store->in_flight.head;
+    store_data_t *next_store_data;
+    mcl_size_t changed_count = 0;
+
+    // current_state is always a state of the data written to a request, so only the in flight queue is searched :
+    while (MCL_NULL != store_data)
     {
-        _exchange_update_store_data_state((store_data_t *)current_node->data, send_operation_successful);
+        next_store_data = store_data->queue_next;
+
+        if (current_state == store_data_get_state(store_data))
+        {
+            store_data_set_state(store_data, new_state);
+            changed_count++;
+        }
+
+        store_data = next_store_data;
     }
 
-    DEBUG_LEAVE("retVal = <%d>", MCL_OK);
-    return MCL_OK;
+    DEBUG_LEAVE("retVal = <%u>", changed_count);
+    return changed_count;
 }
 
 static E_MCL_ERROR_CODE _exchange_clear_sent_data_from_store(store_t *store)
 {
     DEBUG_ENTRY("store_t *store = <%p>", store)
 
-    // in every store_data item, remove the item if its state is sent
-    list_node_t *current_node = MCL_NULL;
+    // in every store_data item written to a request, remove the item if its state is sent
+    store_data_t *store_data = store->in_flight.head;
+    store_data_t *next_store_data;
 
-    // high priority list
-    while (MCL_NULL != (current_node = list_next(store->high_priority_list)))
+    while (MCL_NULL != store_data)
     {
-        if (DATA_STATE_SENT == store_data_get_state((store_data_t *)current_node->data))
+        next_store_data = store_data->queue_next;
+
+        if (DATA_STATE_SENT == store_data_get_state(store_data))
         {
-            store_data_remove(store->high_priority_list, current_node);
+            // Data is delivered even if its acknowledgement can not be written, at worst it is sent again after a restart.
+            if ((STORE_DATA_PERSISTED == store_data->type) && (MCL_OK != store_wal_acknowledge((store_wal_record_t *)store_data->data)))
+            {
+                MCL_WARN("Acknowledgement of sent data couldn't be written to store write-ahead log.");
+            }
+            store_data_remove(store_data->index->list, store_data->list_node);
         }
+
+        store_data = next_store_data;
     }
 
-    // low priority list
-    while (MCL_NULL != (current_node = list_next(store->low_priority_list)))
+    // Sent data is acknowledged in write-ahead log, segments which have no data left to send can be removed now :
+    if ((MCL_NULL != store->store_wal) && (MCL_OK != store_wal_trim(store->store_wal)))
     {
-        if (DATA_STATE_SENT == store_data_get_state((store_data_t *)current_node->data))
-        {
-            store_data_remove(store->low_priority_list, current_node);
-        }
+        MCL_WARN("Store write-ahead log couldn't be trimmed.");
     }
 
+    // Memory of the removed data can be reused if nothing is left in the store :
+    store_reclaim_memory(store);
+
     DEBUG_LEAVE("retVal = <%d>", MCL_OK);
     return MCL_OK;
 }
@@ -1714,6 +2116,18 @@ static E_MCL_ERROR_CODE _exchange_store_data_get_content_info(store_data_t *stor
         data_source_configuration = (data_source_configuration_t *)store_data->data;
         *meta_content_id = data_source_configuration->meta.content_id;
     }
+    else if (STORE_DATA_PERSISTED == store_data->type)
+    {
+		store_wal_record_t *record;
+
+        MCL_DEBUG("Item type = <persisted>");
+        record = (store_wal_record_t *)store_data->data;
+        *meta_content_type = &content_type_values[CONTENT_TYPE_META_JSON];
+        *payload_content_type = (STORE_DATA_CUSTOM == record->data_type) ? &content_type_values[CONTENT_TYPE_APPLICATION_OCTET_STREAM] : &content_type_values[CONTENT_TYPE_APPLICATION_JSON];
+
+        // content id is written to the log together with the meta.
+        *meta_content_id = record->content_id;
+    }
     else
     {
         MCL_DEBUG("Item type = <UNKNOWN(%d)>", store_data->type);
@@ -1745,6 +2159,9 @@ static E_MCL_ERROR_CODE _exchange_initialize_http_request_headers(http_processor
 
     ASSERT_CODE(MCL_OK == _add_authentication_header_to_request(http_processor, request, with_authentication), MCL_HTTP_REQUEST_FINALIZE_FAILED);
 
+    // Exchange payloads are compressed by http client while they are sent, Content-Encoding header is added there.
+    request->compress_payload = http_processor->configuration->http_compression;
+
     DEBUG_LEAVE("retVal = <%d>", result);
     return result;
 }
@@ -1806,6 +2223,48 @@ static mcl_size_t _get_payload_from_file(void *destination, void *file_descripto
     return actual_size_read;
 }
 
+static E_MCL_ERROR_CODE _rewind_payload_of_file(void *file_descriptor, mcl_size_t size, void *user_context)
+{
+    DEBUG_ENTRY("void *file_descriptor = <%p>, mcl_size_t size = <%u>, void *user_context = <%p>", file_descriptor, size, user_context)
+
+    mcl_size_t position = 0;
+    E_MCL_ERROR_CODE code = file_util_ftell(file_descriptor, &position);
+
+    (MCL_OK == code) && (code = (position < size) ? MCL_FAIL : file_util_fseek(file_descriptor, position - size));
+
+    DEBUG_LEAVE("retVal = <%d>", code);
+    return code;
+}
+
+static mcl_size_t _get_payload_from_time_series(void *destination, void *time_series_payload, mcl_size_t size, void *user_context)
+{
+    DEBUG_ENTRY("void *destination = <%p>, void *time_series_payload = <%p>, mcl_size_t size = <%u>, void *user_context = <%p>", destination, time_series_payload, size,
+                user_context)
+
+    mcl_size_t json_length = json_write_time_series_payload((time_series_payload_t *)time_series_payload, (char *)destination, size);
+
+    // time series might have been changed after its size is calculated, never report more than the size requested :
+    if (json_length > size)
+    {
+        MCL_ERROR("Time series payload has been changed after it is prepared. It is truncated.");
+        json_length = size;
+    }
+
+    DEBUG_LEAVE("retVal = <%u>", json_length);
+    return json_length;
+}
+
+static mcl_size_t _get_payload_from_store_wal(void *destination, void *store_wal_record, mcl_size_t size, void *user_context)
+{
+    DEBUG_ENTRY("void *destination = <%p>, void *store_wal_record = <%p>, mcl_size_t size = <%u>, void *user_context = <%p>", destination, store_wal_record, size, user_context)
+
+    mcl_size_t offset = (MCL_NULL == user_context) ? 0 : *((mcl_size_t *)user_context);
+    mcl_size_t actual_size_read = store_wal_read_payload((store_wal_record_t *)store_wal_record, offset, destination, size);
+
+    DEBUG_LEAVE("retVal = <%u>", actual_size_read);
+    return actual_size_read;
+}
+
 #if MCL_STREAM_ENABLED
 mcl_size_t _stream_callback(void *buffer, mcl_size_t size, mcl_size_t count, void *user_context)
 {
@@ -1910,6 +2369,7 @@ E_MCL_ERROR_CODE _process_registration_response_shared_secret(http_processor_t *
 
     if (ok)
     {
+        security_handler_reset_hmac_key(http_processor->security_handler);
         string_destroy(&http_processor->security_handler->client_id);
         string_destroy(&http_processor->security_handler->client_secret);
         string_destroy(&http_processor->security_handler->registration_access_token);
@@ -2234,6 +2694,7 @@ static E_MCL_ERROR_CODE _custom_load_register_info(http_processor_t *http_proces
 	if (MCL_SECURITY_SHARED_SECRET == http_processor->configuration->security_profile)
 	{
 		char *client_secret;
+		security_handler_reset_hmac_key(http_processor->security_handler);
 		code = http_processor->configuration->load_function.shared_secret(&client_id, &client_secret, &registration_access_token, &registration_uri);
 
 		if(MCL_OK == code)
@@ -2243,6 +2704,7 @@ static E_MCL_ERROR_CODE _custom_load_register_info(http_processor_t *http_proces
     }
 	else
 	{
+		security_handler_reset_rsa_key(http_processor->security_handler);
 		code = http_processor->configuration->load_function.rsa(&client_id, &(http_processor->security_handler->rsa.public_key), &(http_processor->security_handler->rsa.private_key), &registration_access_token, &registration_uri);
 	}
 
@@ -2318,13 +2780,13 @@ static E_MCL_ERROR_CODE _evaluate_response_codes(http_response_t *response)
     return code;
 }
 
-static E_MCL_ERROR_CODE _generate_correlation_id_string(string_t **correlation_id)
+static E_MCL_ERROR_CODE _generate_correlation_id_string(random_pool_t *random_pool, string_t **correlation_id)
 {
-	DEBUG_ENTRY("string_t **correlation_id = <%p>", correlation_id)
+	DEBUG_ENTRY("random_pool_t *random_pool = <%p>, string_t **correlation_id = <%p>", random_pool, correlation_id)
 
 	mcl_uint16_t index;
     uint8_t random_bytes[CORRELATION_ID_BYTE_LENGTH] = {0};
-    E_MCL_ERROR_CODE code = security_generate_random_bytes(random_bytes, CORRELATION_ID_BYTE_LENGTH);
+    E_MCL_ERROR_CODE code = random_pool_get_bytes(random_pool, random_bytes, CORRELATION_ID_BYTE_LENGTH);
 
     ASSERT_CODE(MCL_OK == code, code);
     code = string_initialize_new(MCL_NULL, CORRELATION_ID_BYTE_LENGTH * 2, correlation_id);
@@ -2333,8 +2795,8 @@ static E_MCL_ERROR_CODE _generate_correlation_id_string(string_t **correlation_i
 
     for(index = 0; index < CORRELATION_ID_BYTE_LENGTH; index++)
     {
-        code = string_util_snprintf(&((*correlation_id)->buffer[index * 2]), 3, "%02x", random_bytes[index]);
-        ASSERT_STATEMENT_CODE(MCL_OK == code, string_destroy(correlation_id), code);
+        (*correlation_id)->buffer[index * 2] = correlation_id_characters[random_bytes[index] >> 4];
+        (*correlation_id)->buffer[index * 2 + 1] = correlation_id_characters[random_bytes[index] & 0x0F];
     }
 
     DEBUG_LEAVE("retVal = <%d>", code);
@@ -25,6 +25,9 @@
 #include "file.h"
 #include "event_list.h"
 
+// Number of exchange requests kept for reuse : one in flight and one prepared meanwhile.
+#define HTTP_PROCESSOR_REQUEST_POOL_SIZE 2
+
 /**
  *  http processer handle struct
  */
@@ -33,6 +36,11 @@ typedef struct http_processor_t
     configuration_t *configuration;       //!< Configuration for mcl initialization.
     security_handler_t *security_handler; //!< Security handler.
     http_client_t *http_client;           //!< Http client handler.
+    random_pool_t *random_pool;           //!< Random pool for correlation ids and boundaries.
+    http_request_t *request_pool[HTTP_PROCESSOR_REQUEST_POOL_SIZE]; //!< Exchange requests kept for reuse.
+    mcl_size_t request_pool_count;        //!< Number of requests in request pool.
+    mcl_size_t async_exchange_count;      //!< Number of asynchronous exchange operations in flight.
+    mcl_bool_t destroying;                //!< MCL_TRUE while the http processor is being destroyed and callbacks of pending exchanges are called.
 } http_processor_t;
 
 typedef struct http_processor_stream_callback_context_t
@@ -44,6 +52,36 @@ typedef struct http_processor_stream_callback_context_t
     E_MCL_ERROR_CODE previous_result; //!< Previous result of callback.
 } http_processor_stream_callback_context_t;
 
+/**
+ * Callback function prototype called when an asynchronous exchange operation is completed.
+ */
+typedef void (*http_processor_exchange_callback)(E_MCL_ERROR_CODE code, store_t *store, void *user_context);
+
+/**
+ * State of an asynchronous exchange operation started by #http_processor_exchange_async.
+ *
+ * It is allocated when the operation starts and passed to the http client as the user context of each request,
+ * it is freed after @c callback is called.
+ */
+typedef struct http_processor_exchange_context_t
+{
+    http_processor_t *http_processor;          //!< Http processer handle.
+    store_t *store;                            //!< Holds references to data to exchange.
+    http_request_t *request;                   //!< Http request in flight.
+    string_t *correlation_id;                  //!< Correlation id of the http request in flight.
+    http_processor_exchange_callback callback; //!< Callback to be called when the exchange operation is completed.
+    void *user_context;                        //!< User context passed to callback.
+} http_processor_exchange_context_t;
+
+typedef struct http_processor_exchange_pipeline_t
+{
+    http_processor_t *http_processor;  //!< Http processer handle.
+    store_t *store;                    //!< Holds references to data to exchange.
+    http_request_t *next_request;      //!< Http request prepared while the previous one is in flight.
+    string_t *next_correlation_id;     //!< Correlation id of the next http request.
+    mcl_bool_t prepare_next;           //!< Whether the next http request should be prepared while waiting for the response.
+} http_processor_exchange_pipeline_t;
+
 typedef struct raw_data_context_t
 {
     mcl_size_t total_size; //!< Total size of raw data context.
@@ -91,6 +129,8 @@ E_MCL_ERROR_CODE http_processor_initialize(configuration_t *configuration, http_
  * <li>#MCL_UNAUTHORIZED if response status code of server is related to authorization.</li>
  * <li>#MCL_SERVER_FAIL if the the server returns 500 response status code.</li>
  * <li>#MCL_REGISTRATION_INFO_IS_NOT_SAVED if registration information can not be saved.</li>
+ * <li>#MCL_EXCHANGE_ASYNC_IS_ACTIVE if asynchronous exchange operations are in flight.</li>
+ * <li>#MCL_NOT_INITIALIZED if @p http_processor is being destroyed.</li>
  * <li>#MCL_FAIL in case of an internal error in MCL.</li>
  * </ul>
  */
@@ -104,6 +144,8 @@ E_MCL_ERROR_CODE http_processor_register(http_processor_t *http_processor);
  * <ul>
  * <li>#MCL_OK in case of successful update.</li>
  * <li>#MCL_SECURITY_UP_TO_DATE if security information of the mcl_communication is already up to date.
+ * <li>#MCL_EXCHANGE_ASYNC_IS_ACTIVE if asynchronous exchange operations are in flight.</li>
+ * <li>#MCL_NOT_INITIALIZED if @p http_processor is being destroyed.</li>
  * <li>#MCL_FAIL in case of an internal error in MCL.</li>
  * </ul>
  */
@@ -129,11 +171,38 @@ E_MCL_ERROR_CODE http_processor_update_security_information(http_processor_t *ht
  * <li>#MCL_BAD_REQUEST if response status code of server is 400.</li>
  * <li>#MCL_UNAUTHORIZED if response status code of server is 401.</li>
  * <li>#MCL_SERVER_FAIL if the response status code of server is 500.</li>
+ * <li>#MCL_EXCHANGE_ASYNC_IS_ACTIVE if asynchronous exchange operations are in flight.</li>
+ * <li>#MCL_NOT_INITIALIZED if @p http_processor is being destroyed.</li>
  * <li>#MCL_FAIL in case of an internal error in MCL.</li>
  * </ul>
  */
 E_MCL_ERROR_CODE http_processor_get_access_token(http_processor_t *http_processor);
 
+/**
+ * This function checks whether the access token expires within the access token refresh margin given in the configuration.
+ *
+ * @param [in] http_processor HTTP Processor handle to be used.
+ * @return #MCL_TRUE if the access token expires within the margin or has already expired,
+ * #MCL_FALSE if it does not or its lifetime was not given with the access token.
+ */
+mcl_bool_t http_processor_is_access_token_expiring(http_processor_t *http_processor);
+
+/**
+ * This function generates the RSA key pair to be used by the next key rotation.
+ *
+ * Key pair is generated without entering the critical section given in the configuration,
+ * critical section is entered only to hand the key pair over to the security handler.
+ *
+ * @param [in] http_processor HTTP Processor handle to be used.
+ * @return
+ * <ul>
+ * <li>#MCL_OK in case of success.</li>
+ * <li>#MCL_OUT_OF_MEMORY in case there is not enough memory in the system to proceed.</li>
+ * <li>#MCL_FAIL in case of an internal error in MCL.</li>
+ * </ul>
+ */
+E_MCL_ERROR_CODE http_processor_generate_next_rsa_key(http_processor_t *http_processor);
+
 /**
  * @brief Exchange operation logic.
  *
@@ -148,6 +217,8 @@ E_MCL_ERROR_CODE http_processor_get_access_token(http_processor_t *http_processo
  * <li>#MCL_OK in case of success.</li>
  * <li>#MCL_OUT_OF_MEMORY if there is not enough memory in the system to proceed.</li>
  * <li>#MCL_STORE_IS_EMPTY if @p store has no data.
+ * <li>#MCL_EXCHANGE_ASYNC_IS_ACTIVE if asynchronous exchange operations are in flight.</li>
+ * <li>#MCL_NOT_INITIALIZED if @p http_processor is being destroyed.</li>
  * <li>#MCL_COULD_NOT_RESOLVE_PROXY in case the proxy host name can not be resolved.</li>
  * <li>#MCL_COULD_NOT_RESOLVE_HOST in case the remote host name can not be resolved.</li>
  * <li>#MCL_SSL_HANDSHAKE_FAIL in case a problem occurs during SSL handshake.</li>
@@ -183,6 +254,8 @@ E_MCL_ERROR_CODE http_processor_exchange(http_processor_t *http_processor, store
  * <li>#MCL_OK in case of success.</li>
  * <li>#MCL_OUT_OF_MEMORY if there is not enough memory in the system to proceed.</li>
  * <li>#MCL_STORE_IS_EMPTY if @p store has no data.
+ * <li>#MCL_EXCHANGE_ASYNC_IS_ACTIVE if asynchronous exchange operations are in flight.</li>
+ * <li>#MCL_NOT_INITIALIZED if @p http_processor is being destroyed.</li>
  * <li>#MCL_COULD_NOT_RESOLVE_PROXY in case the proxy host name can not be resolved.</li>
  * <li>#MCL_COULD_NOT_RESOLVE_HOST in case the remote host name can not be resolved.</li>
  * <li>#MCL_SSL_HANDSHAKE_FAIL in case a problem occurs during SSL handshake.</li>
@@ -199,10 +272,59 @@ E_MCL_ERROR_CODE http_processor_exchange(http_processor_t *http_processor, store
  */
 E_MCL_ERROR_CODE http_processor_stream(http_processor_t *http_processor, store_t *store, void **reserved);
 
+/**
+ * @brief Asynchronous exchange function.
+ *
+ * Starts exchanging the data in the store without blocking. The exchange is progressed by #http_processor_perform
+ * which sends one http request after the other until the store is empty or an error occurs, then calls @p callback.
+ * @p store must not be used until @p callback is called. Streamable stores are not supported.
+ * #http_processor_exchange and #http_processor_stream can not be used until callbacks of all asynchronous exchange operations are called.
+ *
+ * @param [in] http_processor HTTP Processor handle to be used.
+ * @param [in] store The data to be exchanged will be read from this store.
+ * @param [in] callback Callback function to be called when the exchange operation is completed.
+ * @param [in] user_context User context passed to @p callback.
+ * @return
+ * <ul>
+ * <li>#MCL_OK in case the exchange operation is started.</li>
+ * <li>#MCL_OUT_OF_MEMORY if there is not enough memory in the system to proceed.</li>
+ * <li>#MCL_STORE_IS_EMPTY if @p store has no data.
+ * <li>#MCL_NOT_INITIALIZED if @p http_processor is being destroyed.</li>
+ * <li>#MCL_FAIL in case of an internal error in MCL.</li>
+ * </ul>
+ */
+E_MCL_ERROR_CODE http_processor_exchange_async(http_processor_t *http_processor, store_t *store, http_processor_exchange_callback callback, void *user_context);
+
+/**
+ * @brief Progresses the asynchronous exchange operations.
+ *
+ * @param [in] http_processor HTTP Processor handle to be used.
+ * @param [in] timeout Maximum time in milliseconds to wait for network activity.
+ * @param [out] pending_count Number of http requests still in flight. Optional, can be NULL.
+ * @return
+ * <ul>
+ * <li>#MCL_OK in case of success.</li>
+ * <li>#MCL_NOT_INITIALIZED if @p http_processor is being destroyed.</li>
+ * <li>#MCL_FAIL in case of an internal error in MCL.</li>
+ * </ul>
+ */
+E_MCL_ERROR_CODE http_processor_perform(http_processor_t *http_processor, mcl_uint32_t timeout, mcl_size_t *pending_count);
+
+/**
+ * @brief To get the connection reuse statistics of the underlying HTTP client.
+ *
+ * @param [in] http_processor HTTP Processor handle.
+ * @param [out] connections_opened Number of requests for which a new connection is opened.
+ * @param [out] connections_reused Number of requests for which an existing connection is reused.
+ */
+void http_processor_get_connection_statistics(http_processor_t *http_processor, mcl_size_t *connections_opened, mcl_size_t *connections_reused);
+
 /**
  * @brief To destroy the HTTP Processor Handler.
  *
  * Will release the resources of HTTP Processor. After destroy operation, handler shouldn't be used.
+ * Callbacks of asynchronous exchange operations in flight are called with #MCL_FAIL. Exchange operations started
+ * from these callbacks are refused and calling this function again from them has no effect.
  *
  * @param [in] http_processor HTTP Processor handle to be destroyed.
  */
@@ -11,6 +11,8 @@
  *
  ************************************************************************/
 
+#define MEMORY_CATEGORY MCL_MEMORY_CATEGORY_HTTP
+
 #include "data_types.h"
 #include "http_request.h"
 #include "log_util.h"
@@ -30,12 +32,17 @@ typedef enum E_MCL_BOUNDARY_TYPE
 char *boundary_characters = "1234567890abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ";
 mcl_size_t MCL_MAX_SIZE = (mcl_size_t)-1;
 
+// Random bytes not less than this limit are skipped while generating boundaries, so that each boundary character is equally likely.
+#define BOUNDARY_RANDOM_BYTE_LIMIT (256 - (256 % BOUNDARY_CHARACTER_COUNT))
+
 // 5 BOUNDARY_LINE_LENGTH : 1 Open main boundary, 3 open/close subboundary, 1 close main boundary
 // 1 CONTENT_TYPE_LINE_LENGTH : For the multipart/related main content type line
 // 1 MCL_NULL_CHAR_SIZE : For string terminating null char
 // 2 CONTENT_TYPE_HEADER_LENGTH : For tuple sections "Content-Type: " parts.
-// 4 NEW_LINE_LENGTH : 2 for each sub content-type headers.
-mcl_size_t OVERHEAD_FOR_TUPLE = (5 * BOUNDARY_LINE_LENGTH) + CONTENT_TYPE_LINE_LENGTH + (2 * CONTENT_TYPE_HEADER_LENGTH) + (4 * NEW_LINE_LENGTH) + MCL_NULL_CHAR_SIZE;
+// 7 NEW_LINE_LENGTH : 1 for each sub content-type header, 5 for blank lines after main content-type line, sub content-type headers, meta and payload.
+// 1 BOUNDARY_SIGN_LENGTH : For back sign of close subboundary.
+mcl_size_t OVERHEAD_FOR_TUPLE = (5 * BOUNDARY_LINE_LENGTH) + CONTENT_TYPE_LINE_LENGTH + (2 * CONTENT_TYPE_HEADER_LENGTH) + (7 * NEW_LINE_LENGTH) + BOUNDARY_SIGN_LENGTH
+                                + MCL_NULL_CHAR_SIZE;
 
 // 2 BOUNDARY_LINE_LENGTH : 1 Open main boundary, 1 close main boundary
 // 1 CONTENT_TYPE_LINE_LENGTH : For the multipart/related main content type line
@@ -65,9 +72,13 @@ mcl_size_t OVERHEAD_FOR_TUPLE_SUBSECTION_WITH_BOUNDARY_DEFINITION = BOUNDARY_LIN
 mcl_size_t OVERHEAD_FOR_TUPLE_SUBSECTION = BOUNDARY_LINE_LENGTH + CONTENT_TYPE_HEADER_LENGTH + (2 * NEW_LINE_LENGTH) + MCL_NULL_CHAR_SIZE;
 
 // Private Function Prototypes:
-static E_MCL_ERROR_CODE _generate_random_boundary(string_t **boundary);
+static E_MCL_ERROR_CODE _generate_random_boundary(random_pool_t *random_pool, char *boundary);
+static E_MCL_ERROR_CODE _create_random_boundary(random_pool_t *random_pool, string_t **boundary);
 static E_MCL_ERROR_CODE _add_boundary(mcl_uint8_t *payload, mcl_size_t *payload_offset, char *boundary, E_MCL_BOUNDARY_TYPE boundary_type);
-static E_MCL_ERROR_CODE _resize_payload_buffer_if_necessary(mcl_size_t required_empty_size, http_request_t *http_request, mcl_bool_t finalize);
+static E_MCL_ERROR_CODE _resize_payload_buffer_if_necessary(mcl_size_t required_empty_size, mcl_size_t fragment_size, http_request_t *http_request, mcl_bool_t finalize);
+static E_MCL_ERROR_CODE _reserve_fragments(http_request_t *http_request, mcl_size_t count);
+static void _add_fragment(http_request_t *http_request, mcl_size_t position, payload_copy_callback_t copy_callback, payload_rewind_callback_t rewind_callback, void *source,
+                          void *user_context, mcl_size_t size);
 static void _add_meta(string_t *meta, http_request_t *http_request, mcl_size_t *payload_offset);
 static void _add_payload(http_request_t *http_request, payload_copy_callback_t payload_copy_callback, void *user_context, mcl_uint8_t *payload, mcl_size_t payload_size,
                          mcl_size_t *payload_offset);
@@ -77,10 +88,10 @@ static void _add_blank_line(http_request_t *http_request, mcl_size_t *payload_of
 static mcl_size_t _get_available_space(http_request_t *http_request, mcl_size_t overhead);
 
 E_MCL_ERROR_CODE http_request_initialize(E_MCL_HTTP_METHOD method, string_t *uri, mcl_size_t header_size, mcl_size_t payload_size, mcl_bool_t resize_enabled,
-        string_t *user_agent, mcl_size_t max_http_payload_size, http_request_t **http_request)
+        string_t *user_agent, mcl_size_t max_http_payload_size, random_pool_t *random_pool, http_request_t **http_request)
 {
-    DEBUG_ENTRY("E_MCL_HTTP_METHOD method = <%d>, string_t *uri = <%p>, mcl_size_t header_size = <%u>, mcl_size_t payload_size = <%u>, mcl_bool_t resize_enabled = <%p>, string_t *user_agent = <%p>, mcl_size_t max_http_payload_size = <%u>, http_request_t **http_request = <%p>",
-                method, uri, header_size, payload_size, &resize_enabled, user_agent, max_http_payload_size, http_request)
+    DEBUG_ENTRY("E_MCL_HTTP_METHOD method = <%d>, string_t *uri = <%p>, mcl_size_t header_size = <%u>, mcl_size_t payload_size = <%u>, mcl_bool_t resize_enabled = <%p>, string_t *user_agent = <%p>, mcl_size_t max_http_payload_size = <%u>, random_pool_t *random_pool = <%p>, http_request_t **http_request = <%p>",
+                method, uri, header_size, payload_size, &resize_enabled, user_agent, max_http_payload_size, random_pool, http_request)
 
 	E_MCL_ERROR_CODE return_code;
     // Create new http_request object.
@@ -100,6 +111,17 @@ E_MCL_ERROR_CODE http_request_initialize(E_MCL_HTTP_METHOD method, string_t *uri
     (*http_request)->payload_offset = 0;
     (*http_request)->finalized = MCL_FALSE;
 	(*http_request)->max_http_payload_size = max_http_payload_size;
+    (*http_request)->random_pool = random_pool;
+    (*http_request)->compress_payload = MCL_FALSE;
+    (*http_request)->fragments = MCL_NULL;
+    (*http_request)->fragment_count = 0;
+    (*http_request)->fragment_capacity = 0;
+    (*http_request)->fragments_size = 0;
+    (*http_request)->read_offset = 0;
+    (*http_request)->read_fragment_index = 0;
+    (*http_request)->read_fragment_offset = 0;
+    (*http_request)->reusable = MCL_FALSE;
+    (*http_request)->payload_buffer_size = payload_size;
 
     // Initialize a string array for the request header. User-Agent is for all HTTP requests the same : header_size + 1
     return_code = string_array_initialize(header_size + 1, &((*http_request)->header));
@@ -121,7 +143,7 @@ E_MCL_ERROR_CODE http_request_initialize(E_MCL_HTTP_METHOD method, string_t *uri
     return_code = string_initialize(uri, &((*http_request)->uri));
     ASSERT_STATEMENT_CODE_MESSAGE(MCL_OK == return_code, http_request_destroy(http_request), return_code, "Memory can not be allocated for the URI of http request.");
 
-    return_code = _generate_random_boundary(&((*http_request)->boundary));
+    return_code = _create_random_boundary(random_pool, &((*http_request)->boundary));
     ASSERT_STATEMENT_CODE_MESSAGE(MCL_OK == return_code, http_request_destroy(http_request), return_code, "Random boundary generation failed.");
 
     DEBUG_LEAVE("retVal = <%d>", MCL_OK);
@@ -179,7 +201,7 @@ E_MCL_ERROR_CODE http_request_add_single(http_request_t *http_request, string_t
     mcl_size_t required_empty_size = OVERHEAD_FOR_SINGLE + content_type->length + content_id->length + meta_string->length + NEW_LINE_LENGTH + MCL_NULL_CHAR_SIZE;
 
     // Check if the empty space in payload buffer is enough.If not so, resize payload buffer if possible.
-    return_code = _resize_payload_buffer_if_necessary(required_empty_size, http_request, MCL_FALSE);
+    return_code = _resize_payload_buffer_if_necessary(required_empty_size, 0, http_request, MCL_FALSE);
     ASSERT_CODE_MESSAGE(MCL_OK == return_code, return_code, "Inadequate memory in payload buffer for HTTP message.");
 
     payload_offset_local = http_request->payload_offset;
@@ -212,20 +234,33 @@ E_MCL_ERROR_CODE http_request_add_single(http_request_t *http_request, string_t
 }
 
 E_MCL_ERROR_CODE http_request_add_tuple(http_request_t *http_request, string_t *meta, string_t *meta_content_type, payload_copy_callback_t payload_copy_callback,
-        void *user_context, void *payload, mcl_size_t payload_size, string_t *payload_content_type)
+        payload_rewind_callback_t payload_rewind_callback, void *user_context, void *payload, mcl_size_t payload_size, string_t *payload_content_type, mcl_bool_t copy_payload)
 {
-	DEBUG_ENTRY("http_request_t *http_request = <%p>, string_t *meta = <%p>, string_t *meta_content_type = <%p>, payload_copy_callback_t payload_copy_callback = <%p>, void *user_context = <%p>, void *payload = <%p>, mcl_size_t payload_size = <%u>, string_t *payload_content_type = <%p>",
-		http_request, meta, meta_content_type, payload_copy_callback, user_context, payload, payload_size, payload_content_type)
+	DEBUG_ENTRY("http_request_t *http_request = <%p>, string_t *meta = <%p>, string_t *meta_content_type = <%p>, payload_copy_callback_t payload_copy_callback = <%p>, payload_rewind_callback_t payload_rewind_callback = <%p>, void *user_context = <%p>, void *payload = <%p>, mcl_size_t payload_size = <%u>, string_t *payload_content_type = <%p>, mcl_bool_t copy_payload = <%d>",
+		http_request, meta, meta_content_type, payload_copy_callback, payload_rewind_callback, user_context, payload, payload_size, payload_content_type, copy_payload)
 
 	E_MCL_ERROR_CODE return_code;
-	string_t *sub_boundary = MCL_NULL;
+	char sub_boundary[BOUNDARY_LENGTH + MCL_NULL_CHAR_SIZE];
 	mcl_size_t payload_offset_local;
-    mcl_size_t required_empty_size = OVERHEAD_FOR_TUPLE + meta_content_type->length + payload_content_type->length + payload_size + meta->length;
+	mcl_size_t meta_position = 0;
+	mcl_size_t payload_position = 0;
+
+    // Meta and payload can be added as fragments only if the payload buffer is owned by the request.
+    mcl_bool_t add_fragments = ((MCL_FALSE == copy_payload) && (MCL_TRUE == http_request->resize_enabled)) ? MCL_TRUE : MCL_FALSE;
+    mcl_size_t fragment_size = (MCL_TRUE == add_fragments) ? (meta->length + payload_size) : 0;
+    mcl_size_t required_empty_size = OVERHEAD_FOR_TUPLE + meta_content_type->length + payload_content_type->length + payload_size + meta->length - fragment_size;
 
     // Check if the empty space in payload buffer is enough.If not so, resize payload buffer if possible.
-    return_code = _resize_payload_buffer_if_necessary(required_empty_size, http_request, MCL_FALSE);
+    return_code = _resize_payload_buffer_if_necessary(required_empty_size, fragment_size, http_request, MCL_FALSE);
     ASSERT_CODE_MESSAGE(MCL_OK == return_code, return_code, "Inadequate memory in payload buffer for HTTP message.");
 
+    // Reserve the fragments before composing so that adding them can not fail after the tuple is composed.
+    if (MCL_TRUE == add_fragments)
+    {
+        return_code = _reserve_fragments(http_request, 2);
+        ASSERT_CODE_MESSAGE(MCL_OK == return_code, return_code, "Memory can not be allocated for fragments of http request.");
+    }
+
     payload_offset_local = http_request->payload_offset;
 
     // Add opening main boundary.
@@ -233,60 +268,79 @@ E_MCL_ERROR_CODE http_request_add_tuple(http_request_t *http_request, string_t *
     ASSERT_CODE_MESSAGE(MCL_OK == return_code, return_code, "Boundary couldn't be composed.");
 
     // Create sub_boundary.
-    return_code = _generate_random_boundary(&sub_boundary);
+    return_code = _generate_random_boundary(http_request->random_pool, sub_boundary);
     ASSERT_CODE_MESSAGE(MCL_OK == return_code, return_code, "sub_boundary couldn't be composed.");
 
     // Add tuple content_type.
     return_code = _add_content_info(http_request, http_header_names[HTTP_HEADER_CONTENT_TYPE].buffer, content_type_values[CONTENT_TYPE_MULTIPART_RELATED].buffer,
-                                    &payload_offset_local, CONTENT_TYPE_LINE_LENGTH, sub_boundary->buffer);
-    ASSERT_STATEMENT_CODE_MESSAGE(MCL_OK == return_code, string_destroy(&sub_boundary), return_code, "content_type couldn't be composed.");
+                                    &payload_offset_local, CONTENT_TYPE_LINE_LENGTH, sub_boundary);
+    ASSERT_CODE_MESSAGE(MCL_OK == return_code, return_code, "content_type couldn't be composed.");
 
     // Add blank line.
     _add_blank_line(http_request, &payload_offset_local);
 
     // Add open sub_boundary.
-    return_code = _add_boundary(http_request->payload, &payload_offset_local, sub_boundary->buffer, MCL_OPEN_BOUNDARY);
-    ASSERT_STATEMENT_CODE_MESSAGE(MCL_OK == return_code, string_destroy(&sub_boundary), return_code, "sub_boundary couldn't be composed.");
+    return_code = _add_boundary(http_request->payload, &payload_offset_local, sub_boundary, MCL_OPEN_BOUNDARY);
+    ASSERT_CODE_MESSAGE(MCL_OK == return_code, return_code, "sub_boundary couldn't be composed.");
 
     // Add content_type.
     return_code = _add_content_info(http_request, http_header_names[HTTP_HEADER_CONTENT_TYPE].buffer, meta_content_type->buffer, &payload_offset_local,
                                     CONTENT_TYPE_HEADER_LENGTH + meta_content_type->length + NEW_LINE_LENGTH, MCL_NULL);
-    ASSERT_STATEMENT_CODE_MESSAGE(MCL_OK == return_code, string_destroy(&sub_boundary), return_code, "content_type couldn't be composed.");
+    ASSERT_CODE_MESSAGE(MCL_OK == return_code, return_code, "content_type couldn't be composed.");
 
     // Add blank line.
     _add_blank_line(http_request, &payload_offset_local);
 
     // Add meta.
-    _add_meta(meta, http_request, &payload_offset_local);
+    if (MCL_TRUE == add_fragments)
+    {
+        meta_position = payload_offset_local;
+        _add_blank_line(http_request, &payload_offset_local);
+    }
+    else
+    {
+        _add_meta(meta, http_request, &payload_offset_local);
+    }
 
     // Add open sub_boundary.
-    return_code = _add_boundary(http_request->payload, &payload_offset_local, sub_boundary->buffer, MCL_OPEN_BOUNDARY);
-    ASSERT_STATEMENT_CODE_MESSAGE(MCL_OK == return_code, string_destroy(&sub_boundary), return_code, "sub_boundary couldn't be composed.");
+    return_code = _add_boundary(http_request->payload, &payload_offset_local, sub_boundary, MCL_OPEN_BOUNDARY);
+    ASSERT_CODE_MESSAGE(MCL_OK == return_code, return_code, "sub_boundary couldn't be composed.");
 
     // Add payload content-type.
     return_code = _add_content_info(http_request, http_header_names[HTTP_HEADER_CONTENT_TYPE].buffer, payload_content_type->buffer, &payload_offset_local,
                                     CONTENT_TYPE_HEADER_LENGTH + payload_content_type->length + NEW_LINE_LENGTH, MCL_NULL);
-    ASSERT_STATEMENT_CODE_MESSAGE(MCL_OK == return_code, string_destroy(&sub_boundary), return_code, "payload content_type couldn't be composed.");
+    ASSERT_CODE_MESSAGE(MCL_OK == return_code, return_code, "payload content_type couldn't be composed.");
 
     // Add blank line.
     _add_blank_line(http_request, &payload_offset_local);
 
     // Add payload.
-    _add_payload(http_request, payload_copy_callback, user_context, payload, payload_size, &payload_offset_local);
+    if (MCL_TRUE == add_fragments)
+    {
+        payload_position = payload_offset_local;
+    }
+    else
+    {
+        _add_payload(http_request, payload_copy_callback, user_context, payload, payload_size, &payload_offset_local);
+    }
 
     // Add blank line.
     _add_blank_line(http_request, &payload_offset_local);
 
     // Add close sub_boundary.
-    return_code = _add_boundary(http_request->payload, &payload_offset_local, sub_boundary->buffer, MCL_CLOSE_BOUNDARY);
-    ASSERT_STATEMENT_CODE_MESSAGE(MCL_OK == return_code, string_destroy(&sub_boundary), return_code, "sub_boundary couldn't be composed.");
+    return_code = _add_boundary(http_request->payload, &payload_offset_local, sub_boundary, MCL_CLOSE_BOUNDARY);
+    ASSERT_CODE_MESSAGE(MCL_OK == return_code, return_code, "sub_boundary couldn't be composed.");
+
+    // Insert meta and payload into the composed tuple.
+    if (MCL_TRUE == add_fragments)
+    {
+        _add_fragment(http_request, meta_position, MCL_NULL, MCL_NULL, meta->buffer, MCL_NULL, meta->length);
+        _add_fragment(http_request, payload_position, payload_copy_callback, payload_rewind_callback, payload, user_context, payload_size);
+    }
 
     // Add memory size to be used to payload_offset.
     http_request->payload_offset = payload_offset_local;
 
-    // Destroy local sub_boundary.
-    string_destroy(&sub_boundary);
-
     DEBUG_LEAVE("retVal = <%d>", MCL_OK);
     return MCL_OK;
 }
@@ -302,7 +356,7 @@ E_MCL_ERROR_CODE http_request_start_tuple(http_request_t *http_request)
 	mcl_size_t payload_offset_local;
 
     // Check if the empty space in payload buffer is enough.If not so, resize payload buffer if possible.
-    return_code = _resize_payload_buffer_if_necessary(required_empty_size, http_request, MCL_FALSE);
+    return_code = _resize_payload_buffer_if_necessary(required_empty_size, 0, http_request, MCL_FALSE);
     ASSERT_CODE_MESSAGE(MCL_OK == return_code, return_code, "Inadequate memory in payload buffer for HTTP message.");
 
     payload_offset_local = http_request->payload_offset;
@@ -339,7 +393,7 @@ E_MCL_ERROR_CODE http_request_start_tuple_sub_section(http_request_t *http_reque
     }
 
     // Check if the empty space in payload buffer is enough.If not so, resize payload buffer if possible.
-    return_code = _resize_payload_buffer_if_necessary(required_empty_size, http_request, MCL_FALSE);
+    return_code = _resize_payload_buffer_if_necessary(required_empty_size, 0, http_request, MCL_FALSE);
     ASSERT_CODE_MESSAGE(MCL_OK == return_code, return_code, "Inadequate memory in payload buffer for HTTP message.");
 
     payload_offset_local = http_request->payload_offset;
@@ -347,7 +401,7 @@ E_MCL_ERROR_CODE http_request_start_tuple_sub_section(http_request_t *http_reque
     // Create sub_boundary if it is not created :
     if (MCL_NULL == *sub_boundary)
     {
-        return_code = _generate_random_boundary(sub_boundary);
+        return_code = _create_random_boundary(http_request->random_pool, sub_boundary);
         ASSERT_CODE_MESSAGE(MCL_OK == return_code, return_code, "sub_boundary couldn't be composed.");
 
         // Add tuple content_type.
@@ -384,7 +438,7 @@ E_MCL_ERROR_CODE http_request_end_tuple_sub_section(http_request_t *http_request
     mcl_size_t required_empty_size = BOUNDARY_LINE_LENGTH + MCL_NULL_CHAR_SIZE;
 
     // Check if the empty space in payload buffer is enough. If not so, resize payload buffer if possible.
-    return_code = _resize_payload_buffer_if_necessary(required_empty_size, http_request, MCL_FALSE);
+    return_code = _resize_payload_buffer_if_necessary(required_empty_size, 0, http_request, MCL_FALSE);
     ASSERT_CODE_MESSAGE(MCL_OK == return_code, return_code, "Inadequate memory in payload buffer for HTTP message.");
 
     payload_offset_local = http_request->payload_offset;
@@ -410,7 +464,7 @@ E_MCL_ERROR_CODE http_request_add_raw_data(http_request_t *http_request, payload
 	mcl_size_t payload_offset_local;
 
     // Check if the empty space in payload buffer is enough.If not so, resize payload buffer if possible.
-    return_code = _resize_payload_buffer_if_necessary(data_size, http_request, MCL_FALSE);
+    return_code = _resize_payload_buffer_if_necessary(data_size, 0, http_request, MCL_FALSE);
     ASSERT_CODE_MESSAGE(MCL_OK == return_code, return_code, "Inadequate memory in payload buffer for HTTP message.");
 
     payload_offset_local = http_request->payload_offset;
@@ -471,7 +525,7 @@ E_MCL_ERROR_CODE http_request_finalize(http_request_t *http_request)
 
     // Check if the empty space in payload buffer is enough.If not so, resize only as much as required.
     // If there is more memory space unused, release and shrink the payload buffer.
-    return_code = _resize_payload_buffer_if_necessary(required_empty_size, http_request, MCL_TRUE);
+    return_code = _resize_payload_buffer_if_necessary(required_empty_size, 0, http_request, MCL_TRUE);
     ASSERT_CODE_MESSAGE(MCL_OK == return_code, MCL_HTTP_REQUEST_FINALIZE_FAILED, "Inadequate memory in payload buffer for HTTP message.");
 
     // Add front sign of closing main boundary.
@@ -485,6 +539,149 @@ E_MCL_ERROR_CODE http_request_finalize(http_request_t *http_request)
     // Add back sign of closing main boundary.
     string_util_memcpy(&http_request->payload[http_request->payload_offset], BOUNDARY_SIGN, BOUNDARY_SIGN_LENGTH);
     http_request->payload_offset += BOUNDARY_SIGN_LENGTH;
+    http_request->finalized = MCL_TRUE;
+
+    DEBUG_LEAVE("retVal = <%d>", MCL_OK);
+    return MCL_OK;
+}
+
+mcl_size_t http_request_get_body_size(http_request_t *http_request)
+{
+    DEBUG_ENTRY("http_request_t *http_request = <%p>", http_request)
+
+    mcl_size_t body_size = http_request->payload_size + http_request->fragments_size;
+
+    DEBUG_LEAVE("retVal = <%u>", body_size);
+    return body_size;
+}
+
+mcl_size_t http_request_read_body(http_request_t *http_request, mcl_uint8_t *buffer, mcl_size_t size)
+{
+    DEBUG_ENTRY("http_request_t *http_request = <%p>, mcl_uint8_t *buffer = <%p>, mcl_size_t size = <%u>", http_request, buffer, size)
+
+    mcl_size_t written_size = 0;
+
+    while (written_size < size)
+    {
+        http_request_fragment_t *fragment = MCL_NULL;
+        mcl_size_t next_position = http_request->payload_size;
+        mcl_size_t part_size;
+
+        if (http_request->read_fragment_index < http_request->fragment_count)
+        {
+            fragment = &http_request->fragments[http_request->read_fragment_index];
+            next_position = fragment->position;
+        }
+
+        if (http_request->read_offset < next_position)
+        {
+            // Copy the part of payload buffer up to the next fragment.
+            part_size = next_position - http_request->read_offset;
+            part_size = (part_size > size - written_size) ? (size - written_size) : part_size;
+            string_util_memcpy(buffer + written_size, http_request->payload + http_request->read_offset, part_size);
+            http_request->read_offset += part_size;
+        }
+        else if (MCL_NULL != fragment)
+        {
+            // Read the next part of fragment data.
+            part_size = fragment->size - http_request->read_fragment_offset;
+            part_size = (part_size > size - written_size) ? (size - written_size) : part_size;
+
+            if (MCL_NULL == fragment->copy_callback)
+            {
+                string_util_memcpy(buffer + written_size, (mcl_uint8_t *)fragment->source + http_request->read_fragment_offset, part_size);
+            }
+            else if (0 != part_size)
+            {
+                part_size = fragment->copy_callback(buffer + written_size, fragment->source, part_size, fragment->user_context);
+                if (0 == part_size)
+                {
+                    MCL_ERROR("Data of fragment can not be read.");
+                    written_size = 0;
+                    break;
+                }
+            }
+
+            http_request->read_fragment_offset += part_size;
+
+            if (http_request->read_fragment_offset == fragment->size)
+            {
+                http_request->read_fragment_index++;
+                http_request->read_fragment_offset = 0;
+            }
+        }
+        else
+        {
+            // End of body.
+            break;
+        }
+
+        written_size += part_size;
+    }
+
+    DEBUG_LEAVE("retVal = <%u>", written_size);
+    return written_size;
+}
+
+E_MCL_ERROR_CODE http_request_rewind_body(http_request_t *http_request)
+{
+    DEBUG_ENTRY("http_request_t *http_request = <%p>", http_request)
+
+    E_MCL_ERROR_CODE return_code = MCL_OK;
+    mcl_size_t index;
+
+    // Move back the sources of the fragments which are read so far, last fragment might have been read partially.
+    for (index = 0; (MCL_OK == return_code) && (index < http_request->fragment_count) && (index <= http_request->read_fragment_index); ++index)
+    {
+        http_request_fragment_t *fragment = &http_request->fragments[index];
+        mcl_size_t read_size = (index < http_request->read_fragment_index) ? fragment->size : http_request->read_fragment_offset;
+
+        if ((MCL_NULL != fragment->copy_callback) && (0 != read_size))
+        {
+            return_code = (MCL_NULL == fragment->rewind_callback) ? MCL_FAIL : fragment->rewind_callback(fragment->source, read_size, fragment->user_context);
+        }
+    }
+
+    http_request->read_offset = 0;
+    http_request->read_fragment_index = 0;
+    http_request->read_fragment_offset = 0;
+
+    if (MCL_OK != return_code)
+    {
+        MCL_ERROR("Data of fragment can not be read again.");
+    }
+
+    DEBUG_LEAVE("retVal = <%d>", return_code);
+    return return_code;
+}
+
+E_MCL_ERROR_CODE http_request_reset(http_request_t *http_request)
+{
+    DEBUG_ENTRY("http_request_t *http_request = <%p>", http_request)
+
+    E_MCL_ERROR_CODE return_code;
+
+    // Keep User-Agent header only.
+    string_array_truncate(http_request->header, 1);
+
+    // Finalized request might have a payload size less than its buffer.
+    if (MCL_TRUE == http_request->finalized)
+    {
+        http_request->payload_size = http_request->payload_buffer_size;
+    }
+
+    http_request->payload_offset = 0;
+    http_request->finalized = MCL_FALSE;
+    http_request->compress_payload = MCL_FALSE;
+    http_request->fragment_count = 0;
+    http_request->fragments_size = 0;
+    http_request->read_offset = 0;
+    http_request->read_fragment_index = 0;
+    http_request->read_fragment_offset = 0;
+
+    // Each message has its own boundary, it has the same length so the string is reused.
+    return_code = _generate_random_boundary(http_request->random_pool, http_request->boundary->buffer);
+    ASSERT_CODE_MESSAGE(MCL_OK == return_code, return_code, "Random boundary generation failed.");
 
     DEBUG_LEAVE("retVal = <%d>", MCL_OK);
     return MCL_OK;
@@ -501,6 +698,7 @@ void http_request_destroy(http_request_t **http_request)
         string_destroy(&((*http_request)->uri));
         string_destroy(&((*http_request)->boundary));
         MCL_FREE((*http_request)->payload);
+        MCL_FREE((*http_request)->fragments);
         MCL_FREE(*http_request);
 
         MCL_DEBUG("Http request is destroyed successfully.");
@@ -515,7 +713,8 @@ void http_request_destroy(http_request_t **http_request)
 
 static mcl_size_t _get_available_space(http_request_t *http_request, mcl_size_t overhead)
 {
-    mcl_size_t limit = (http_request->resize_enabled) ? http_request->max_http_payload_size : http_request->payload_size;
+    // Fragments are not kept in payload buffer but they are part of the body.
+    mcl_size_t limit = (http_request->resize_enabled) ? (http_request->max_http_payload_size - http_request->fragments_size) : http_request->payload_size;
 
     // We do following check first to make sure the calculation is ok.
     // It is for the case : payload_offset + overhead is larger than the MAX_SIZE
@@ -532,30 +731,42 @@ static mcl_size_t _get_available_space(http_request_t *http_request, mcl_size_t
     return 0;
 }
 
-static E_MCL_ERROR_CODE _generate_random_boundary(string_t **boundary)
+static E_MCL_ERROR_CODE _generate_random_boundary(random_pool_t *random_pool, char *boundary)
 {
-	DEBUG_ENTRY("string_t **boundary = <%p>", boundary)
+	DEBUG_ENTRY("random_pool_t *random_pool = <%p>, char *boundary = <%p>", random_pool, boundary)
 
-	E_MCL_ERROR_CODE code;
-	mcl_size_t index;
-    code = string_initialize_new(MCL_NULL, BOUNDARY_LENGTH, boundary);
-    ASSERT_CODE_MESSAGE(MCL_OK == code, code, "String initialize fail for boundary.");
+	E_MCL_ERROR_CODE code = MCL_OK;
+	mcl_size_t index = 0;
 
     // Take (BOUNDARY_LENGTH) random characters from boundary_characters[] array and fill boundary buffer.
-    for (index = 0; index < BOUNDARY_LENGTH; index++)
+    while ((MCL_OK == code) && (index < BOUNDARY_LENGTH))
     {
-        mcl_uint32_t random_index = 0;
-        code = random_generate_number(&random_index);
-        if (MCL_OK == code)
-        {
-            (*boundary)->buffer[index] = boundary_characters[random_index % BOUNDARY_CHARACTER_COUNT];
-        }
-        else
+        mcl_uint8_t random_byte;
+        code = random_pool_get_bytes(random_pool, &random_byte, 1);
+
+        if ((MCL_OK == code) && (BOUNDARY_RANDOM_BYTE_LIMIT > random_byte))
         {
-            string_destroy(boundary);
-            break;
+            boundary[index++] = boundary_characters[random_byte % BOUNDARY_CHARACTER_COUNT];
         }
     }
+    boundary[index] = MCL_NULL_CHAR;
+
+    DEBUG_LEAVE("retVal = <%d>", code);
+    return code;
+}
+
+static E_MCL_ERROR_CODE _create_random_boundary(random_pool_t *random_pool, string_t **boundary)
+{
+	DEBUG_ENTRY("random_pool_t *random_pool = <%p>, string_t **boundary = <%p>", random_pool, boundary)
+
+	E_MCL_ERROR_CODE code = string_initialize_new(MCL_NULL, BOUNDARY_LENGTH, boundary);
+    ASSERT_CODE_MESSAGE(MCL_OK == code, code, "String initialize fail for boundary.");
+
+    code = _generate_random_boundary(random_pool, (*boundary)->buffer);
+    if (MCL_OK != code)
+    {
+        string_destroy(boundary);
+    }
 
     DEBUG_LEAVE("retVal = <%d>", code);
     return code;
@@ -590,15 +801,26 @@ static E_MCL_ERROR_CODE _add_boundary(mcl_uint8_t *payload, mcl_size_t *payload_
     return MCL_OK;
 }
 
-static E_MCL_ERROR_CODE _resize_payload_buffer_if_necessary(mcl_size_t required_empty_size, http_request_t *http_request, mcl_bool_t finalize)
+static E_MCL_ERROR_CODE _resize_payload_buffer_if_necessary(mcl_size_t required_empty_size, mcl_size_t fragment_size, http_request_t *http_request, mcl_bool_t finalize)
 {
-    DEBUG_ENTRY("mcl_size_t required_empty_size = <%u>, http_request_t *http_request = <%p>, mcl_bool_t finalize = <%d>", required_empty_size, http_request, finalize)
+    DEBUG_ENTRY("mcl_size_t required_empty_size = <%u>, mcl_size_t fragment_size = <%u>, http_request_t *http_request = <%p>, mcl_bool_t finalize = <%d>",
+                required_empty_size, fragment_size, http_request, finalize)
 
-    // Maximum allowed available size can be used after extending the payload buffer up to MAX_PAYLOAD_SIZE.
+    // Fragments are not kept in payload buffer but they are part of the body, so payload buffer can be extended only up to
+    // MAX_PAYLOAD_SIZE minus the size of existing fragments and the fragments to be added.
+    mcl_size_t max_payload_buffer_size = http_request->max_http_payload_size;
+
+    // Maximum allowed available size can be used after extending the payload buffer up to max_payload_buffer_size.
     mcl_size_t max_allowed_available_size = 0;
     if (MCL_TRUE == http_request->resize_enabled)
     {
-        max_allowed_available_size = http_request->max_http_payload_size - http_request->payload_offset;
+        if (http_request->max_http_payload_size - http_request->payload_offset < http_request->fragments_size + fragment_size)
+        {
+            MCL_ERROR_RETURN(MCL_HTTP_REQUEST_NO_MORE_SPACE, "Inadequate memory in payload buffer for HTTP message.");
+        }
+
+        max_payload_buffer_size = http_request->max_http_payload_size - http_request->fragments_size - fragment_size;
+        max_allowed_available_size = max_payload_buffer_size - http_request->payload_offset;
     }
     else
     {
@@ -612,11 +834,18 @@ static E_MCL_ERROR_CODE _resize_payload_buffer_if_necessary(mcl_size_t required_
         // else return no more space error.
         if (required_empty_size <= max_allowed_available_size)
         {
-            if (MCL_TRUE == http_request->resize_enabled)
+            if ((MCL_TRUE == http_request->reusable) && (required_empty_size <= http_request->payload_size - http_request->payload_offset))
+            {
+                MCL_DEBUG("Request is reusable. Not shrinking extra payload space.");
+                http_request->payload_buffer_size = http_request->payload_size;
+                http_request->payload_size = http_request->payload_offset + required_empty_size;
+            }
+            else if (MCL_TRUE == http_request->resize_enabled)
             {
                 MCL_RESIZE(http_request->payload, http_request->payload_offset + required_empty_size);
                 ASSERT_CODE_MESSAGE(MCL_NULL != http_request->payload, MCL_OUT_OF_MEMORY, "http_request->payload couldn't be resized as required_empty_size!");
                 http_request->payload_size = http_request->payload_offset + required_empty_size;
+                http_request->payload_buffer_size = http_request->payload_size;
             }
             else
             {
@@ -648,7 +877,7 @@ static E_MCL_ERROR_CODE _resize_payload_buffer_if_necessary(mcl_size_t required_
                 new_size = (mcl_size_t)(((1.0 * required_empty_size / http_request->payload_size + 1.0) * GROWTH_FACTOR) * http_request->payload_size);
             }
 
-            if ((new_size <= http_request->max_http_payload_size) && http_request->resize_enabled)
+            if ((new_size <= max_payload_buffer_size) && http_request->resize_enabled)
             {
                 MCL_RESIZE(http_request->payload, new_size);
                 ASSERT_CODE_MESSAGE(MCL_NULL != http_request->payload, MCL_OUT_OF_MEMORY, "http_request->payload couldn't be resized as new_size!");
@@ -657,9 +886,9 @@ static E_MCL_ERROR_CODE _resize_payload_buffer_if_necessary(mcl_size_t required_
             else if ((required_empty_size <= max_allowed_available_size) && http_request->resize_enabled)
             {
                 // if new_size is higher than MAX_PAYLOAD_SIZE, check if the empty space is enough for only required_empty_size, than resize with MAX_PAYLOAD_SIZE.
-                MCL_RESIZE(http_request->payload, http_request->max_http_payload_size);
+                MCL_RESIZE(http_request->payload, max_payload_buffer_size);
                 ASSERT_CODE_MESSAGE(MCL_NULL != http_request->payload, MCL_OUT_OF_MEMORY, "http_request->payload couldn't be resized as MAX_PAYLOAD_SIZE!");
-                http_request->payload_size = http_request->max_http_payload_size;
+                http_request->payload_size = max_payload_buffer_size;
             }
             else
             {
@@ -667,6 +896,11 @@ static E_MCL_ERROR_CODE _resize_payload_buffer_if_necessary(mcl_size_t required_
                 MCL_ERROR_RETURN(MCL_HTTP_REQUEST_NO_MORE_SPACE, "Inadequate memory in payload buffer for HTTP message.");
             }
         }
+        else if ((MCL_TRUE == http_request->resize_enabled) && (required_empty_size > max_allowed_available_size))
+        {
+            // Payload buffer has enough space but it can not be used since fragments take the rest of MAX_PAYLOAD_SIZE.
+            MCL_ERROR_RETURN(MCL_HTTP_REQUEST_NO_MORE_SPACE, "Inadequate memory in payload buffer for HTTP message.");
+        }
     }
 
     DEBUG_LEAVE("retVal = <%d>", MCL_OK);
@@ -694,7 +928,16 @@ static void _add_payload(http_request_t *http_request, payload_copy_callback_t p
                 http_request, payload_copy_callback, user_context, payload, payload_size, payload_offset)
 
     // Compose payload.
-    mcl_size_t count = payload_copy_callback(&http_request->payload[*payload_offset], payload, payload_size, user_context);
+    mcl_size_t count = payload_size;
+
+    if (MCL_NULL == payload_copy_callback)
+    {
+        string_util_memcpy(&http_request->payload[*payload_offset], payload, payload_size);
+    }
+    else
+    {
+        count = payload_copy_callback(&http_request->payload[*payload_offset], payload, payload_size, user_context);
+    }
 
     // Count might be different than the payload_size we requested:
     *payload_offset += count;
@@ -742,3 +985,48 @@ static void _add_blank_line(http_request_t *http_request, mcl_size_t *payload_of
 
     DEBUG_LEAVE("retVal = void");
 }
+
+static E_MCL_ERROR_CODE _reserve_fragments(http_request_t *http_request, mcl_size_t count)
+{
+    DEBUG_ENTRY("http_request_t *http_request = <%p>, mcl_size_t count = <%u>", http_request, count)
+
+    if (http_request->fragment_count + count > http_request->fragment_capacity)
+    {
+        mcl_size_t new_capacity = (mcl_size_t)((http_request->fragment_count + count) * GROWTH_FACTOR) + 1;
+        MCL_RESIZE(http_request->fragments, new_capacity * sizeof(http_request_fragment_t));
+
+        // Existing fragments are released if resize fails, request can not be used any more.
+        if (MCL_NULL == http_request->fragments)
+        {
+            http_request->fragment_count = 0;
+            http_request->fragment_capacity = 0;
+            MCL_ERROR_RETURN(MCL_OUT_OF_MEMORY, "Memory can not be allocated for fragments of http request.");
+        }
+
+        http_request->fragment_capacity = new_capacity;
+    }
+
+    DEBUG_LEAVE("retVal = <%d>", MCL_OK);
+    return MCL_OK;
+}
+
+static void _add_fragment(http_request_t *http_request, mcl_size_t position, payload_copy_callback_t copy_callback, payload_rewind_callback_t rewind_callback, void *source,
+                          void *user_context, mcl_size_t size)
+{
+    DEBUG_ENTRY("http_request_t *http_request = <%p>, mcl_size_t position = <%u>, payload_copy_callback_t copy_callback = <%p>, payload_rewind_callback_t rewind_callback = <%p>, void *source = <%p>, void *user_context = <%p>, mcl_size_t size = <%u>",
+                http_request, position, copy_callback, rewind_callback, source, user_context, size)
+
+    http_request_fragment_t *fragment = &http_request->fragments[http_request->fragment_count];
+
+    fragment->position = position;
+    fragment->copy_callback = copy_callback;
+    fragment->rewind_callback = rewind_callback;
+    fragment->source = source;
+    fragment->user_context = user_context;
+    fragment->size = size;
+
+    http_request->fragment_count++;
+    http_request->fragments_size += size;
+
+    DEBUG_LEAVE("retVal = void");
+}
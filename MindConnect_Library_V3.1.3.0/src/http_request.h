@@ -19,6 +19,7 @@
 
 #include "http_definitions.h"
 #include "string_array.h"
+#include "random.h"
 
 // "--".
 #define BOUNDARY_SIGN_LENGTH 2
@@ -71,6 +72,29 @@ typedef enum E_MCL_HTTP_METHOD
     MCL_HTTP_TRACE    //!< Http trace method.
 } E_MCL_HTTP_METHOD;
 
+typedef mcl_size_t (*payload_copy_callback_t)(void *destination, void *source, mcl_size_t size, void *user_context);
+
+/**
+ * Callback to move the read position of a source back by @p size bytes, i.e. to the data already copied by its #payload_copy_callback_t.
+ */
+typedef E_MCL_ERROR_CODE (*payload_rewind_callback_t)(void *source, mcl_size_t size, void *user_context);
+
+/**
+ * @brief Part of HTTP request body which is not copied into the payload buffer.
+ *
+ * Body of the request is the payload buffer with the data of each fragment inserted at its position.
+ * Data of the fragment is read while the request is sent.
+ */
+typedef struct http_request_fragment_t
+{
+    mcl_size_t position;                   //!< Offset in payload buffer the fragment is inserted at.
+    payload_copy_callback_t copy_callback; //!< Callback to read the data in consecutive parts. If NULL, source is a buffer in memory.
+    payload_rewind_callback_t rewind_callback; //!< Callback to move the source back to read the data again. If NULL, data read by copy_callback can not be read again.
+    void *source;                          //!< Source passed to copy_callback or the buffer itself.
+    void *user_context;                    //!< User context passed to copy_callback and rewind_callback.
+    mcl_size_t size;                       //!< Size of the data.
+} http_request_fragment_t;
+
 /**
  * @brief HTTP Request Handle
  *
@@ -88,10 +112,19 @@ typedef struct http_request_t
     mcl_size_t max_http_payload_size; //!< Maximum http payload size of http request.
     mcl_bool_t resize_enabled;        //!< The state or condition of being resizable.
     mcl_bool_t finalized;             //!< The state of http request.
+    random_pool_t *random_pool;       //!< Random pool boundaries are generated from.
+    mcl_bool_t compress_payload;      //!< Payload is compressed with gzip by http client while it is sent if MCL_TRUE.
+    http_request_fragment_t *fragments; //!< Parts of the body which are not copied into payload buffer.
+    mcl_size_t fragment_count;        //!< Number of fragments.
+    mcl_size_t fragment_capacity;     //!< Number of fragments memory is allocated for.
+    mcl_size_t fragments_size;        //!< Total size of the data of fragments.
+    mcl_size_t read_offset;           //!< Offset in payload buffer the body is read from by #http_request_read_body.
+    mcl_size_t read_fragment_index;   //!< Index of the fragment the body is read from by #http_request_read_body.
+    mcl_size_t read_fragment_offset;  //!< Offset in the data of the fragment the body is read from by #http_request_read_body.
+    mcl_bool_t reusable;              //!< Payload buffer is not shrunk by #http_request_finalize if MCL_TRUE, request is reused after #http_request_reset.
+    mcl_size_t payload_buffer_size;   //!< Size of payload buffer kept by #http_request_finalize of a reusable request.
 } http_request_t;
 
-typedef mcl_size_t (*payload_copy_callback_t)(void *destination, void *source, mcl_size_t size, void *user_context);
-
 /**
  * @brief HTTP Request Initializer
  *
@@ -104,6 +137,7 @@ typedef mcl_size_t (*payload_copy_callback_t)(void *destination, void *source, m
  * @param [in] resize_enabled Indicates that the http_request should resize its buffer in case necessary. Give this as MCL_FALSE in case the buffer is static.
  * @param [in] user_agent Value of HTTP header User-Agent for this request.
  * @param [in] max_http_payload_size Maximum payload size for one http request.
+ * @param [in] random_pool Random pool to generate boundaries from. If NULL, random bytes are generated for each boundary.
  * @param [out] http_request The newly initialized HTTP request.
  * @return
  * <ul>
@@ -113,7 +147,7 @@ typedef mcl_size_t (*payload_copy_callback_t)(void *destination, void *source, m
  * </ul>
  */
 E_MCL_ERROR_CODE http_request_initialize(E_MCL_HTTP_METHOD method, string_t *uri, mcl_size_t header_size, mcl_size_t payload_size, mcl_bool_t resize_enabled,
-        string_t *user_agent, mcl_size_t max_http_payload_size, http_request_t **http_request);
+        string_t *user_agent, mcl_size_t max_http_payload_size, random_pool_t *random_pool, http_request_t **http_request);
 
 /**
  * @brief To be used to add an HTTP header to the request with it's value.
@@ -165,14 +199,21 @@ E_MCL_ERROR_CODE http_request_add_single(http_request_t *http_request, string_t
  *
  * Note: Content-Type header should be included in the received meta and payload strings.
  *
+ * If @p copy_payload is MCL_FALSE, meta and payload are not copied into the payload buffer but added as fragments of the body
+ * which are read while the request is sent, so they must stay valid until then. @p payload_copy_callback is then called with
+ * consecutive parts of the payload and @p payload_rewind_callback is called if the body has to be read again to resend the request.
+ * Meta and payload are copied anyway if resizing of the payload buffer is disabled, since the buffer is not owned by the request in that case.
+ *
  * @param [in] http_request HTTP Request Handle to be used.
  * @param [in] meta Meta string to be added.
  * @param [in] meta_content_type HTTP Content Type header for meta section of the tuple. Sample : "application/vnd.siemens.mindsphere.meta+json".
- * @param [in] payload_copy_callback Callback function to be used to copy the payload to @p http_request.
- * @param [in] user_context User context pointer to pass to the callback function.
+ * @param [in] payload_copy_callback Callback function to be used to copy the payload to @p http_request. If NULL, @p payload is a buffer in memory.
+ * @param [in] payload_rewind_callback Callback function to be used to move @p payload back to read it again. NULL if @p payload can not be read again.
+ * @param [in] user_context User context pointer to pass to the callback functions.
  * @param [in] payload Payload string to be added.
  * @param [in] payload_size Size of the payload string to be added.
  * @param [in] payload_content_type HTTP Content Type header for the payload section of the tuple. Sample : "application/octet-stream ".
+ * @param [in] copy_payload MCL_TRUE to copy meta and payload into the payload buffer now, MCL_FALSE to read them while the request is sent.
  * @return
  * <ul>
  * <li>#MCL_OK in case of success.</li>
@@ -182,7 +223,7 @@ E_MCL_ERROR_CODE http_request_add_single(http_request_t *http_request, string_t
  * </ul>
  */
 E_MCL_ERROR_CODE http_request_add_tuple(http_request_t *http_request, string_t *meta, string_t *meta_content_type, payload_copy_callback_t payload_copy_callback,
-        void *user_context, void *payload, mcl_size_t payload_size, string_t *payload_content_type);
+        payload_rewind_callback_t payload_rewind_callback, void *user_context, void *payload, mcl_size_t payload_size, string_t *payload_content_type, mcl_bool_t copy_payload);
 
 /**
  * @brief To start a new tuple structure inside the http request body.
@@ -294,6 +335,8 @@ mcl_size_t http_request_get_available_space_for_single(http_request_t *http_requ
 /**
  * @brief Adds closing boundary to the payload and resizes the payload buffer to release unused memory space.
  *
+ * Payload buffer of a reusable request is resized only if it needs more space.
+ *
  * @param [in] http_request HTTP Request Handle to be used.
  * @return
  * <ul>
@@ -305,6 +348,55 @@ mcl_size_t http_request_get_available_space_for_single(http_request_t *http_requ
  */
 E_MCL_ERROR_CODE http_request_finalize(http_request_t *http_request);
 
+/**
+ * @brief To be used to get the size of the body of a finalized request including its fragments.
+ *
+ * @param [in] http_request HTTP Request Handle to be used.
+ * @return Returns the size of the body.
+ */
+mcl_size_t http_request_get_body_size(http_request_t *http_request);
+
+/**
+ * @brief To be used to read the next part of the body of a finalized request which has fragments.
+ *
+ * Parts of the payload buffer and data of the fragments are gathered in order into @p buffer.
+ *
+ * @param [in] http_request HTTP Request Handle to be used.
+ * @param [out] buffer Buffer to write the next part of the body to.
+ * @param [in] size Size of @p buffer.
+ * @return Returns the number of bytes written to @p buffer, 0 at the end of the body or if data of a fragment can not be read.
+ */
+mcl_size_t http_request_read_body(http_request_t *http_request, mcl_uint8_t *buffer, mcl_size_t size);
+
+/**
+ * @brief To be used to read the body of a finalized request which has fragments from its beginning again, e.g. to resend the request.
+ *
+ * Sources of the fragments read so far by a copy callback are moved back with their rewind callbacks.
+ *
+ * @param [in] http_request HTTP Request Handle to be used.
+ * @return
+ * <ul>
+ * <li>#MCL_OK in case of success.</li>
+ * <li>#MCL_FAIL if the source of a fragment read so far can not be moved back.</li>
+ * </ul>
+ */
+E_MCL_ERROR_CODE http_request_rewind_body(http_request_t *http_request);
+
+/**
+ * @brief To be used to reuse a request for a new message with the same method and URI.
+ *
+ * Headers other than User-Agent, payload and fragments are removed and a new boundary is generated.
+ * Memory of payload buffer and header array is kept.
+ *
+ * @param [in] http_request HTTP Request Handle to be used.
+ * @return
+ * <ul>
+ * <li>#MCL_OK in case of success.</li>
+ * <li>#MCL_FAIL in case random boundary can not be generated.</li>
+ * </ul>
+ */
+E_MCL_ERROR_CODE http_request_reset(http_request_t *http_request);
+
 /**
  * @brief To destroy the HTTP Request Handler.
  *
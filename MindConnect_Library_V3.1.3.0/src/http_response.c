@@ -11,6 +11,8 @@
  *
  ************************************************************************/
 
+#define MEMORY_CATEGORY MCL_MEMORY_CATEGORY_HTTP
+
 #include "http_response.h"
 #include "definitions.h"
 #include "memory.h"
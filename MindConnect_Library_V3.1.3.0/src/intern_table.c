@@ -0,0 +1,229 @@
+/*!**********************************************************************
+*
+* @copyright Copyright (C) 2016 Siemens Aktiengesellschaft.\n
+*            All rights reserved.
+*
+*************************************************************************
+*
+* @file     intern_table.c
+* @date     Oct 17, 2026
+* @brief    Intern table module implementation file.
+*
+************************************************************************/
+
+#define MEMORY_CATEGORY MCL_MEMORY_CATEGORY_STORE
+
+#include "intern_table.h"
+#include "memory.h"
+#include "definitions.h"
+#include "log_util.h"
+#include "string_util.h"
+
+// Multiplier of the hash function (64 bit golden ratio).
+#define HASH_MULTIPLIER 0x9E3779B97F4A7C15ull
+
+// Private Function Prototypes:
+static mcl_uint64_t _hash(const char *string, mcl_size_t *length);
+static mcl_size_t *_find_bucket(intern_table_t *intern_table, const char *string, mcl_size_t length, mcl_uint64_t hash);
+static E_MCL_ERROR_CODE _grow_strings(intern_table_t *intern_table);
+static E_MCL_ERROR_CODE _grow_buckets(intern_table_t *intern_table);
+
+E_MCL_ERROR_CODE intern_table_initialize(intern_table_t **intern_table)
+{
+    DEBUG_ENTRY("intern_table_t **intern_table = <%p>", intern_table)
+
+    MCL_NEW(*intern_table);
+    ASSERT_CODE_MESSAGE(MCL_NULL != *intern_table, MCL_OUT_OF_MEMORY, "Memory couldn't be allocated for intern table.");
+
+    (*intern_table)->strings = MCL_NULL;
+    (*intern_table)->count = 0;
+    (*intern_table)->capacity = 0;
+    (*intern_table)->bucket_count = DEFAULT_INTERN_TABLE_BUCKET_COUNT;
+    (*intern_table)->buckets = MCL_CALLOC(DEFAULT_INTERN_TABLE_BUCKET_COUNT, sizeof(mcl_size_t));
+    ASSERT_STATEMENT_CODE_MESSAGE(MCL_NULL != (*intern_table)->buckets, intern_table_destroy(intern_table), MCL_OUT_OF_MEMORY,
+                                  "Memory couldn't be allocated for intern table buckets.");
+
+    DEBUG_LEAVE("retVal = <%d>", MCL_OK);
+    return MCL_OK;
+}
+
+E_MCL_ERROR_CODE intern_table_add(intern_table_t *intern_table, const char *string, mcl_size_t *id)
+{
+    DEBUG_ENTRY("intern_table_t *intern_table = <%p>, const char *string = <%p>, mcl_size_t *id = <%p>", intern_table, string, id)
+
+	E_MCL_ERROR_CODE code = MCL_OK;
+	mcl_size_t length;
+	mcl_uint64_t hash = _hash(string, &length);
+	mcl_size_t *bucket = _find_bucket(intern_table, string, length, hash);
+	memory_arena_t *arena;
+
+    if (0 != *bucket)
+    {
+        *id = *bucket - 1;
+        DEBUG_LEAVE("retVal = <%d>", MCL_OK);
+        return MCL_OK;
+    }
+
+    // Interned strings outlive the data they are added for, so they are never allocated from the arena of a store.
+    arena = memory_arena_set_current(MCL_NULL);
+
+    // Keep at most three quarters of the buckets used so that probe sequences stay short.
+    if (4 * (intern_table->count + 1) > 3 * intern_table->bucket_count)
+    {
+        code = _grow_buckets(intern_table);
+        (MCL_OK == code) && (bucket = _find_bucket(intern_table, string, length, hash));
+    }
+
+    (MCL_OK == code) && (intern_table->count == intern_table->capacity) && (code = _grow_strings(intern_table));
+    (MCL_OK == code) && (code = string_initialize_new(string, length, &intern_table->strings[intern_table->count]));
+    memory_arena_set_current(arena);
+    ASSERT_CODE_MESSAGE(MCL_OK == code, code, "String couldn't be added to intern table.");
+
+    *id = intern_table->count;
+    *bucket = ++intern_table->count;
+
+    DEBUG_LEAVE("retVal = <%d>", MCL_OK);
+    return MCL_OK;
+}
+
+string_t *intern_table_get(intern_table_t *intern_table, mcl_size_t id)
+{
+    VERBOSE_ENTRY("intern_table_t *intern_table = <%p>, mcl_size_t id = <%u>", intern_table, id)
+
+    string_t *string = (id < intern_table->count) ? intern_table->strings[id] : MCL_NULL;
+
+    VERBOSE_LEAVE("retVal = <%p>", string);
+    return string;
+}
+
+void intern_table_destroy(intern_table_t **intern_table)
+{
+    DEBUG_ENTRY("intern_table_t **intern_table = <%p>", intern_table)
+
+	mcl_size_t index;
+
+    if (MCL_NULL != *intern_table)
+    {
+        for (index = 0; index < (*intern_table)->count; index++)
+        {
+            string_destroy(&(*intern_table)->strings[index]);
+        }
+
+        MCL_FREE((*intern_table)->strings);
+        MCL_FREE((*intern_table)->buckets);
+        MCL_FREE(*intern_table);
+    }
+
+    DEBUG_LEAVE("retVal = void");
+}
+
+// Private Functions:
+static mcl_uint64_t _hash(const char *string, mcl_size_t *length)
+{
+    VERBOSE_ENTRY("const char *string = <%p>, mcl_size_t *length = <%p>", string, length)
+
+	mcl_uint64_t hash;
+	mcl_uint64_t word;
+	mcl_size_t index;
+
+    *length = string_util_strlen(string);
+    hash = *length * HASH_MULTIPLIER;
+
+    // Ids are mostly GUIDs, hashing them eight bytes at a time is much faster than byte by byte.
+    for (index = 0; index + sizeof(word) <= *length; index += sizeof(word))
+    {
+        string_util_memcpy(&word, string + index, sizeof(word));
+        hash = (hash ^ word) * HASH_MULTIPLIER;
+        hash ^= hash >> 32;
+    }
+
+    for (; index < *length; index++)
+    {
+        hash = (hash ^ (mcl_uint8_t)string[index]) * HASH_MULTIPLIER;
+    }
+
+    hash ^= hash >> 29;
+
+    VERBOSE_LEAVE("retVal = <%llu>", (unsigned long long)hash);
+    return hash;
+}
+
+static mcl_size_t *_find_bucket(intern_table_t *intern_table, const char *string, mcl_size_t length, mcl_uint64_t hash)
+{
+    VERBOSE_ENTRY("intern_table_t *intern_table = <%p>, const char *string = <%p>, mcl_size_t length = <%u>, mcl_uint64_t hash = <%llu>", intern_table, string,
+                  length, (unsigned long long)hash)
+
+	mcl_size_t mask = intern_table->bucket_count - 1;
+	mcl_size_t index = (mcl_size_t)(hash & mask);
+
+    // Linear probing, returns either the bucket of the string or the empty bucket where it should be added.
+    while (0 != intern_table->buckets[index])
+    {
+        string_t *interned = intern_table->strings[intern_table->buckets[index] - 1];
+
+        if ((interned->length == length) && (MCL_TRUE == string_util_memcmp(interned->buffer, string, length)))
+        {
+            break;
+        }
+
+        index = (index + 1) & mask;
+    }
+
+    VERBOSE_LEAVE("retVal = <%p>", &intern_table->buckets[index]);
+    return &intern_table->buckets[index];
+}
+
+static E_MCL_ERROR_CODE _grow_strings(intern_table_t *intern_table)
+{
+    DEBUG_ENTRY("intern_table_t *intern_table = <%p>", intern_table)
+
+	mcl_size_t capacity = (0 == intern_table->capacity) ? DEFAULT_INTERN_TABLE_BUCKET_COUNT / 2 : 2 * intern_table->capacity;
+	string_t **strings = MCL_MALLOC(capacity * sizeof(string_t *));
+
+    ASSERT_CODE_MESSAGE(MCL_NULL != strings, MCL_OUT_OF_MEMORY, "Memory couldn't be allocated for interned strings.");
+
+    if (0 < intern_table->count)
+    {
+        string_util_memcpy(strings, intern_table->strings, intern_table->count * sizeof(string_t *));
+    }
+
+    MCL_FREE(intern_table->strings);
+    intern_table->strings = strings;
+    intern_table->capacity = capacity;
+
+    DEBUG_LEAVE("retVal = <%d>", MCL_OK);
+    return MCL_OK;
+}
+
+static E_MCL_ERROR_CODE _grow_buckets(intern_table_t *intern_table)
+{
+    DEBUG_ENTRY("intern_table_t *intern_table = <%p>", intern_table)
+
+	mcl_size_t bucket_count = 2 * intern_table->bucket_count;
+	mcl_size_t *buckets = MCL_CALLOC(bucket_count, sizeof(mcl_size_t));
+	mcl_size_t id;
+
+    ASSERT_CODE_MESSAGE(MCL_NULL != buckets, MCL_OUT_OF_MEMORY, "Memory couldn't be allocated for intern table buckets.");
+
+    MCL_FREE(intern_table->buckets);
+    intern_table->buckets = buckets;
+    intern_table->bucket_count = bucket_count;
+
+    // Strings are unique, so each one is placed into the first empty bucket of its probe sequence.
+    for (id = 0; id < intern_table->count; id++)
+    {
+        mcl_size_t length;
+        mcl_uint64_t hash = _hash(intern_table->strings[id]->buffer, &length);
+        mcl_size_t index = (mcl_size_t)(hash & (bucket_count - 1));
+
+        while (0 != buckets[index])
+        {
+            index = (index + 1) & (bucket_count - 1);
+        }
+
+        buckets[index] = id + 1;
+    }
+
+    DEBUG_LEAVE("retVal = <%d>", MCL_OK);
+    return MCL_OK;
+}
@@ -0,0 +1,82 @@
+/*!**********************************************************************
+*
+* @copyright Copyright (C) 2016 Siemens Aktiengesellschaft.\n
+*            All rights reserved.
+*
+*************************************************************************
+*
+* @file     intern_table.h
+* @date     Oct 17, 2026
+* @brief    Intern table module header file.
+*
+* Intern table keeps a single copy of each string added to it and identifies it with a small integer id.
+* Strings which are repeated many times (e.g. data point ids of time series values) are stored by their id instead of copying them.
+* Interned strings are never moved or removed until the table is destroyed, therefore pointers to them remain valid as long as the table lives.
+*
+************************************************************************/
+
+#ifndef INTERN_TABLE_H_
+#define INTERN_TABLE_H_
+
+#include "string_type.h"
+
+/**
+ * @brief Initial number of hash buckets of an intern table. Number of buckets is doubled when the table is three quarters full.
+ */
+#define DEFAULT_INTERN_TABLE_BUCKET_COUNT 64
+
+/**
+ * Intern table handle.
+ */
+typedef struct intern_table_t
+{
+    string_t **strings;      //!< Interned strings, index of a string in this array is its id.
+    mcl_size_t count;        //!< Number of interned strings.
+    mcl_size_t capacity;     //!< Number of strings that @p strings can hold.
+    mcl_size_t *buckets;     //!< Hash index of the strings. Holds id + 1 of a string, 0 for an empty bucket.
+    mcl_size_t bucket_count; //!< Number of buckets, always a power of two.
+} intern_table_t;
+
+/**
+ * @brief Initializes an empty intern table.
+ *
+ * @param [out] intern_table Initialized intern table handle.
+ * @return
+ * <ul>
+ * <li>#MCL_OK in case of success.</li>
+ * <li>#MCL_OUT_OF_MEMORY in case there is not enough memory in the system to proceed.</li>
+ * </ul>
+ */
+E_MCL_ERROR_CODE intern_table_initialize(intern_table_t **intern_table);
+
+/**
+ * @brief Returns the id of @p string, adding it to the table if it is not interned yet.
+ *
+ * @param [in] intern_table Intern table handle to operate.
+ * @param [in] string Null terminated string to intern.
+ * @param [out] id Id of the interned string.
+ * @return
+ * <ul>
+ * <li>#MCL_OK in case of success.</li>
+ * <li>#MCL_OUT_OF_MEMORY in case there is not enough memory in the system to proceed.</li>
+ * </ul>
+ */
+E_MCL_ERROR_CODE intern_table_add(intern_table_t *intern_table, const char *string, mcl_size_t *id);
+
+/**
+ * @brief Returns the interned string with @p id.
+ *
+ * @param [in] intern_table Intern table handle to operate.
+ * @param [in] id Id of the string returned by #intern_table_add().
+ * @return Interned string or NULL if there is no string with @p id.
+ */
+string_t *intern_table_get(intern_table_t *intern_table, mcl_size_t id);
+
+/**
+ * @brief Destroys the intern table and all strings in it.
+ *
+ * @param [in] intern_table Intern table handle to destroy.
+ */
+void intern_table_destroy(intern_table_t **intern_table);
+
+#endif //INTERN_TABLE_H_
@@ -11,6 +11,8 @@
  *
  ************************************************************************/
 
+#define MEMORY_CATEGORY MCL_MEMORY_CATEGORY_JSON
+
 #include "json.h"
 #include "json_util.h"
 #include "memory.h"
@@ -18,16 +20,32 @@
 #include "definitions.h"
 #include "event.h"
 #include "mcl/mcl_event.h"
+#include "string_util.h"
+#include "time_series.h"
+#include <locale.h>
+
+/**
+ * Writer used to generate json strings without building a json tree. Characters exceeding the buffer size are not written but counted in length.
+ */
+typedef struct json_writer_t
+{
+    char *buffer;      //!< Buffer to write json string to.
+    mcl_size_t size;   //!< Size of the buffer.
+    mcl_size_t length; //!< Length of json string generated so far.
+} json_writer_t;
 
 // Private Function Prototypes:
 static E_MCL_ERROR_CODE _add_string_field_to_object(json_t *parent_object,  char *field_name, const string_t *optional_field_to_be_added, mcl_bool_t is_mandatory);
 static E_MCL_ERROR_CODE _add_item_meta_details(item_meta_t *item_meta, json_t *root);
 static E_MCL_ERROR_CODE _add_item_meta_payload_details(item_meta_t *item_meta, json_t *payload);
 static E_MCL_ERROR_CODE _add_item_meta_payload(item_meta_t *item_meta, json_t *root);
-static E_MCL_ERROR_CODE _add_time_series_value_sets(list_t *value_sets, json_t *value_set_array);
-static E_MCL_ERROR_CODE _add_time_series_value_set(time_series_value_set_t *value_set, json_t *value_set_array);
-static E_MCL_ERROR_CODE _add_time_series_payload_values_array(list_t *values, json_t *value_set);
-static E_MCL_ERROR_CODE _add_time_series_payload_values_objects(time_series_value_t *value, json_t *values_array);
+static void _write_time_series_value_set(json_writer_t *writer, time_series_value_set_t *value_set);
+static void _write_time_series_value(json_writer_t *writer, time_series_value_set_t *value_set, mcl_size_t index);
+static mcl_size_t _format_time_series_value(time_series_value_set_t *value_set, mcl_size_t index, char *buffer, mcl_size_t buffer_size);
+static void _replace_decimal_point(char *buffer);
+static void _write_raw(json_writer_t *writer, const char *data, mcl_size_t size);
+static void _write_string(json_writer_t *writer, const char *string, mcl_size_t length);
+static void _write_field_name(json_writer_t *writer, const string_t *field_name);
 static E_MCL_ERROR_CODE _add_data_source_configuration_data_sources(list_t *data_source_list, json_t *payload_object);
 static E_MCL_ERROR_CODE _add_data_source_configuration_data_points(list_t *data_points, json_t *data_sources_object);
 
@@ -78,29 +96,54 @@ E_MCL_ERROR_CODE json_from_time_series_payload(time_series_payload_t *payload, s
 	DEBUG_ENTRY("time_series_payload_t *payload = <%p>, string_t **json_string = <%p>", payload, json_string)
 
 	E_MCL_ERROR_CODE code;
-	char *json_string_local = MCL_NULL;
-	json_t *value_set_array = MCL_NULL;
+	char *json_string_local;
+	mcl_size_t json_string_length;
 
-    MCL_DEBUG("Create payload array.");
+    // Calculate the length first, so that json string is written to a buffer of exact size.
+    json_string_length = json_write_time_series_payload(payload, MCL_NULL, 0);
 
-    code = json_util_initialize(JSON_ARRAY, &value_set_array);
-    ASSERT_CODE_MESSAGE(MCL_OK == code, code, "value_set_array couldn't be allocated in memory for json_string.");
+    json_string_local = MCL_MALLOC(json_string_length + 1);
+    ASSERT_CODE_MESSAGE(MCL_NULL != json_string_local, MCL_OUT_OF_MEMORY, "Memory can not be allocated for json_string.");
 
-    code = _add_time_series_value_sets(payload->value_sets, value_set_array);
-    ASSERT_STATEMENT_CODE_MESSAGE(MCL_OK == code, json_util_destroy(&value_set_array), code, "Time series payload couldn't be added.");
+    json_write_time_series_payload(payload, json_string_local, json_string_length);
+    json_string_local[json_string_length] = MCL_NULL_CHAR;
 
-    
-    code = json_util_to_string(value_set_array, &json_string_local);
-    ASSERT_STATEMENT_CODE_MESSAGE(MCL_OK == code, json_util_destroy(&value_set_array), code, "Json to string conversion failed!");
-
-    code = string_initialize_dynamic(json_string_local, 0, json_string);
+    code = string_initialize_dynamic(json_string_local, json_string_length, json_string);
+    ASSERT_STATEMENT_CODE_MESSAGE(MCL_OK == code, MCL_FREE(json_string_local), code, "Json string couldn't be initialized.");
 
     MCL_DEBUG("Generated json_string = <%s>", (*json_string)->buffer);
-    json_util_destroy(&value_set_array);
     DEBUG_LEAVE("retVal = <%d>", code);
     return code;
 }
 
+mcl_size_t json_write_time_series_payload(time_series_payload_t *payload, char *buffer, mcl_size_t buffer_size)
+{
+    DEBUG_ENTRY("time_series_payload_t *payload = <%p>, char *buffer = <%p>, mcl_size_t buffer_size = <%u>", payload, buffer, buffer_size)
+
+    json_writer_t writer = {buffer, buffer_size, 0};
+    list_node_t *current_value_set_node;
+    mcl_bool_t first = MCL_TRUE;
+
+    _write_raw(&writer, "[", 1);
+
+    list_reset(payload->value_sets);
+    while (MCL_NULL != (current_value_set_node = list_next(payload->value_sets)))
+    {
+        if (MCL_FALSE == first)
+        {
+            _write_raw(&writer, ",", 1);
+        }
+
+        _write_time_series_value_set(&writer, (time_series_value_set_t *)current_value_set_node->data);
+        first = MCL_FALSE;
+    }
+
+    _write_raw(&writer, "]", 1);
+
+    DEBUG_LEAVE("retVal = <%u>", writer.length);
+    return writer.length;
+}
+
 E_MCL_ERROR_CODE json_from_data_source_configuration_payload(data_source_configuration_payload_t *payload, string_t **json_string)
 {
 	DEBUG_ENTRY("data_source_configuration_payload_t *payload = <%p>, string_t **json_string = <%p>", payload, json_string)
@@ -260,95 +303,229 @@ static E_MCL_ERROR_CODE _add_event(event_t *event, json_t *event_list_array)
     return code;
 }
 
-static E_MCL_ERROR_CODE _add_time_series_value_sets(list_t *value_sets, json_t *value_set_array)
+static void _write_time_series_value_set(json_writer_t *writer, time_series_value_set_t *value_set)
 {
-    DEBUG_ENTRY("list_t *value_sets = <%p>, json_t *value_set_array = <%p>", value_sets, value_set_array)
+    DEBUG_ENTRY("json_writer_t *writer = <%p>, time_series_value_set_t *value_set = <%p>", writer, value_set)
+
+    mcl_size_t index;
 
-    list_node_t *current_payloads_node;
+    _write_raw(writer, "{", 1);
+    _write_field_name(writer, &payload_field_names[PAYLOAD_FIELD_TIMESTAMP]);
+    _write_string(writer, value_set->timestamp->buffer, value_set->timestamp->length);
+    _write_raw(writer, ",", 1);
+    _write_field_name(writer, &payload_field_names[PAYLOAD_FIELD_VALUES]);
+    _write_raw(writer, "[", 1);
 
-    list_reset(value_sets);
-    while (MCL_NULL != (current_payloads_node = list_next(value_sets)))
+    for (index = 0; index < value_set->value_count; index++)
     {
-        E_MCL_ERROR_CODE code = _add_time_series_value_set((time_series_value_set_t *)(current_payloads_node->data), value_set_array);
-        ASSERT_CODE_MESSAGE(MCL_OK == code, code, "Values objects couldn't be added to values array!");
+        if (0 < index)
+        {
+            _write_raw(writer, ",", 1);
+        }
+
+        _write_time_series_value(writer, value_set, index);
     }
 
-    DEBUG_LEAVE("retVal = <%d>", MCL_OK);
-    return MCL_OK;
+    _write_raw(writer, "]}", 2);
+
+    DEBUG_LEAVE("retVal = void");
 }
 
-static E_MCL_ERROR_CODE _add_time_series_value_set(time_series_value_set_t *value_set, json_t *value_set_array)
+static void _write_time_series_value(json_writer_t *writer, time_series_value_set_t *value_set, mcl_size_t index)
 {
-	DEBUG_ENTRY("time_series_value_set_t *value_set = <%p>, json_t *value_set_array = <%p>", value_set, value_set_array)
+    DEBUG_ENTRY("json_writer_t *writer = <%p>, time_series_value_set_t *value_set = <%p>, mcl_size_t index = <%u>", writer, value_set, index)
 
-	E_MCL_ERROR_CODE code;
-    json_t *value_set_local = MCL_NULL;
-    
-	code = json_util_initialize(JSON_OBJECT, &value_set_local);
+    // Large enough for the longest int64 and the longest round trip representation of a double.
+    char number_buffer[32];
+    string_t *data_point_id = intern_table_get(value_set->parent->intern_table, value_set->data_point_ids[index]);
+    const char *quality_code = value_set->string_pool + value_set->quality_codes[index];
+    const char *value;
+    mcl_size_t value_length;
 
-    (MCL_OK == code) && (code = json_util_add_string(value_set_local, payload_field_names[PAYLOAD_FIELD_TIMESTAMP].buffer, value_set->timestamp->buffer));
+    if (TIME_SERIES_VALUE_TYPE_STRING == value_set->value_types[index])
+    {
+        value = value_set->string_pool + value_set->values[index].string_offset;
+        value_length = string_util_strlen(value);
+    }
+    else
+    {
+        value = number_buffer;
+        value_length = _format_time_series_value(value_set, index, number_buffer, sizeof(number_buffer));
+    }
 
-    (MCL_OK == code) && (code = _add_time_series_payload_values_array(value_set->values, value_set_local));
+    _write_raw(writer, "{", 1);
+    _write_field_name(writer, &payload_field_names[PAYLOAD_FIELD_VALUES_DATA_POINT_ID]);
+    _write_string(writer, data_point_id->buffer, data_point_id->length);
+    _write_raw(writer, ",", 1);
+    _write_field_name(writer, &payload_field_names[PAYLOAD_FIELD_VALUES_VALUE]);
+    _write_string(writer, value, value_length);
+    _write_raw(writer, ",", 1);
+    _write_field_name(writer, &payload_field_names[PAYLOAD_FIELD_VALUES_QUALITY_CODE]);
+    _write_string(writer, quality_code, string_util_strlen(quality_code));
+    _write_raw(writer, "}", 1);
+
+    DEBUG_LEAVE("retVal = void");
+}
+
+static mcl_size_t _format_time_series_value(time_series_value_set_t *value_set, mcl_size_t index, char *buffer, mcl_size_t buffer_size)
+{
+    DEBUG_ENTRY("time_series_value_set_t *value_set = <%p>, mcl_size_t index = <%u>, char *buffer = <%p>, mcl_size_t buffer_size = <%u>", value_set, index, buffer,
+                buffer_size)
 
-    ASSERT_STATEMENT_CODE(MCL_OK == code, json_util_destroy(&value_set_local), code);
+    time_series_value_data_t *value = &value_set->values[index];
+    E_MCL_ERROR_CODE code = MCL_OK;
+    mcl_size_t length;
 
-    // Add value_set_local to value_set_array.
-    json_util_add_item_to_array(value_set_array, value_set_local);
+    switch (value_set->value_types[index])
+    {
+        case TIME_SERIES_VALUE_TYPE_DOUBLE :
 
-    // value_set_local is added to value_set_array. We can destroy value_set_local struct w/o destroying root_handle in it.
-    json_util_finish_object(&value_set_local);
+            // Use the shortest representation if it reads back as the same double, full precision otherwise.
+            code = string_util_snprintf(buffer, buffer_size, "%.15g", value->double_value);
+            if ((MCL_OK == code) && (string_util_strtod(buffer, MCL_NULL) != value->double_value))
+            {
+                code = string_util_snprintf(buffer, buffer_size, "%.17g", value->double_value);
+            }
 
-    DEBUG_LEAVE("retVal = <%d>", code);
-    return code;
+            // Formatting and the read back check above use the decimal point of the locale, json requires '.'.
+            if (MCL_OK == code)
+            {
+                _replace_decimal_point(buffer);
+            }
+            break;
+        case TIME_SERIES_VALUE_TYPE_INT64 :
+            code = string_util_snprintf(buffer, buffer_size, "%lld", (long long)value->int64_value);
+            break;
+        case TIME_SERIES_VALUE_TYPE_BOOL :
+            code = string_util_snprintf(buffer, buffer_size, "%s", (MCL_FALSE == value->bool_value) ? "false" : "true");
+            break;
+        default :
+            buffer[0] = MCL_NULL_CHAR;
+            break;
+    }
+
+    if (MCL_OK != code)
+    {
+        MCL_ERROR("Time series value couldn't be formatted.");
+        buffer[0] = MCL_NULL_CHAR;
+    }
+
+    length = string_util_strlen(buffer);
+
+    DEBUG_LEAVE("retVal = <%u>", length);
+    return length;
 }
 
-static E_MCL_ERROR_CODE _add_time_series_payload_values_array(list_t *values, json_t *value_set)
+static void _replace_decimal_point(char *buffer)
 {
-	DEBUG_ENTRY("list_t *values = <%p>, json_t *value_set = <%p>", values, value_set)
+    DEBUG_ENTRY("char *buffer = <%s>", buffer)
 
-	E_MCL_ERROR_CODE code;
-    json_t *values_array = MCL_NULL;
-	list_node_t *current_value_node;
-    
-	code = json_util_start_array(value_set, payload_field_names[PAYLOAD_FIELD_VALUES].buffer, &values_array);
-    ASSERT_CODE_MESSAGE(MCL_OK == code, code, "values_array object couldn't be allocated in memory for Json string.");
+    const char *decimal_point = localeconv()->decimal_point;
+    mcl_size_t decimal_point_length = string_util_strlen(decimal_point);
+    mcl_size_t index;
 
-    list_reset(values);
-    while (MCL_NULL != (current_value_node = list_next(values)))
+    // The decimal point of some locales takes more than one byte, the rest of the number is moved back then.
+    if (((1 != decimal_point_length) || ('.' != decimal_point[0])) && (0 != decimal_point_length) &&
+        (MCL_TRUE == string_util_find(buffer, decimal_point, &index)))
     {
-        code = _add_time_series_payload_values_objects((time_series_value_t *)current_value_node->data, values_array);
-        ASSERT_STATEMENT_CODE_MESSAGE(MCL_OK == code, json_util_finish_array(&values_array), code, "Values objects couldn't be added to values array!");
+        buffer[index] = '.';
+        for (index++; MCL_NULL_CHAR != buffer[index + decimal_point_length - 1]; index++)
+        {
+            buffer[index] = buffer[index + decimal_point_length - 1];
+        }
+        buffer[index] = MCL_NULL_CHAR;
     }
 
-    json_util_finish_array(&values_array);
+    DEBUG_LEAVE("retVal = void");
+}
 
-    DEBUG_LEAVE("retVal = <%d>", MCL_OK);
-    return MCL_OK;
+static void _write_raw(json_writer_t *writer, const char *data, mcl_size_t size)
+{
+    VERBOSE_ENTRY("json_writer_t *writer = <%p>, const char *data = <%p>, mcl_size_t size = <%u>", writer, data, size)
+
+    mcl_size_t size_to_write = 0;
+
+    if (writer->length < writer->size)
+    {
+        size_to_write = ((writer->size - writer->length) < size) ? (writer->size - writer->length) : size;
+        string_util_memcpy(writer->buffer + writer->length, data, size_to_write);
+    }
+
+    writer->length += size;
+
+    VERBOSE_LEAVE("retVal = void");
 }
 
-static E_MCL_ERROR_CODE _add_time_series_payload_values_objects(time_series_value_t *value, json_t *values_array)
+static void _write_string(json_writer_t *writer, const char *string, mcl_size_t length)
 {
-	DEBUG_ENTRY("time_series_value_t *value = <%p>, json_t *values_array = <%p>", value, values_array)
+    VERBOSE_ENTRY("json_writer_t *writer = <%p>, const char *string = <%p>, mcl_size_t length = <%u>", writer, string, length)
 
-	E_MCL_ERROR_CODE code;
-    json_t *values_object = MCL_NULL;
+    // Characters are escaped the same way as cJSON does, so that the output is identical to the one generated from a json tree.
+    static const char hex_digits[] = "0123456789abcdef";
+    mcl_size_t index;
+    mcl_size_t start = 0;
 
-    code = json_util_initialize(JSON_OBJECT, &values_object);
+    _write_raw(writer, "\"", 1);
 
-    // Add fields of values array in time series payload.
-    (MCL_OK == code) && (code = json_util_add_string(values_object, payload_field_names[PAYLOAD_FIELD_VALUES_DATA_POINT_ID].buffer, value->data_point_id->buffer));
-    (MCL_OK == code) && (code = json_util_add_string(values_object, payload_field_names[PAYLOAD_FIELD_VALUES_VALUE].buffer, value->value->buffer));
-    (MCL_OK == code) && (code = json_util_add_string(values_object, payload_field_names[PAYLOAD_FIELD_VALUES_QUALITY_CODE].buffer, value->quality_code->buffer));
+    for (index = 0; index < length; index++)
+    {
+        mcl_uint8_t character = (mcl_uint8_t)string[index];
+        char escaped[6] = {'\\', 'u', '0', '0', '0', '0'};
+        mcl_size_t escaped_size = 2;
 
-    ASSERT_STATEMENT_CODE_MESSAGE(MCL_OK == code, json_util_destroy(&values_object), code, "Values objects couldn't be added to values array!");
+        if ((31 < character) && ('"' != character) && ('\\' != character))
+        {
+            continue;
+        }
 
-    // Add values_object to values_array.
-    json_util_add_item_to_array(values_array, values_object);
+        switch (character)
+        {
+            case '"' :
+            case '\\' :
+                escaped[1] = (char)character;
+                break;
+            case '\b' :
+                escaped[1] = 'b';
+                break;
+            case '\f' :
+                escaped[1] = 'f';
+                break;
+            case '\n' :
+                escaped[1] = 'n';
+                break;
+            case '\r' :
+                escaped[1] = 'r';
+                break;
+            case '\t' :
+                escaped[1] = 't';
+                break;
+            default :
+                escaped[4] = hex_digits[character >> 4];
+                escaped[5] = hex_digits[character & 0x0F];
+                escaped_size = 6;
+                break;
+        }
 
-    json_util_finish_object(&values_object);
+        // Write the characters which do not need escaping at once, then the escaped one.
+        _write_raw(writer, string + start, index - start);
+        _write_raw(writer, escaped, escaped_size);
+        start = index + 1;
+    }
 
-    DEBUG_LEAVE("retVal = <%d>", MCL_OK);
-    return MCL_OK;
+    _write_raw(writer, string + start, length - start);
+    _write_raw(writer, "\"", 1);
+
+    VERBOSE_LEAVE("retVal = void");
+}
+
+static void _write_field_name(json_writer_t *writer, const string_t *field_name)
+{
+    VERBOSE_ENTRY("json_writer_t *writer = <%p>, const string_t *field_name = <%p>", writer, field_name)
+
+    _write_string(writer, field_name->buffer, field_name->length);
+    _write_raw(writer, ":", 1);
+
+    VERBOSE_LEAVE("retVal = void");
 }
 
 static E_MCL_ERROR_CODE _add_item_meta_details(item_meta_t *item_meta, json_t *root)
@@ -45,6 +45,20 @@ E_MCL_ERROR_CODE json_from_item_meta(item_meta_t *item_meta, string_t **json_str
  */
 E_MCL_ERROR_CODE json_from_time_series_payload(time_series_payload_t *payload, string_t **json_string);
 
+/**
+ * @brief Writes payload part of time series in json format directly to the given buffer.
+ *
+ * Json string is generated without building a json tree. At most @p buffer_size characters are written
+ * and terminating null character is not written. Calling with @p buffer_size 0 only calculates the length of the json string,
+ * which can be used to allocate or reserve a buffer of exact size.
+ *
+ * @param [in] payload Payload fields of time series is stored in this struct.
+ * @param [out] buffer Buffer to write json string to. Can be NULL if @p buffer_size is 0.
+ * @param [in] buffer_size Size of @p buffer.
+ * @return Length of the json string, which is greater than @p buffer_size if the buffer is not large enough.
+ */
+mcl_size_t json_write_time_series_payload(time_series_payload_t *payload, char *buffer, mcl_size_t buffer_size);
+
 /**
  * @brief Creates payload part of data source configuration in json format.
  *
@@ -11,6 +11,8 @@
 *
 ************************************************************************/
 
+#define MEMORY_CATEGORY MCL_MEMORY_CATEGORY_JSON
+
 #include "cJSON/cJSON.h"
 #include "json_util.h"
 #include "mcl/mcl_json_util.h"
@@ -22,6 +24,7 @@
 // Private Function Prototypes:
 static void _finish_json_item(json_t **json_item);
 static E_JSON_TYPE _convert_mcl_json_type_to_json_type(E_MCL_JSON_TYPE mcl_json_type);
+static void *_json_malloc(size_t size);
 
 static cJSON_Hooks cjson_hooks;
 
@@ -29,7 +32,7 @@ void json_util_initialize_json_library()
 {
     DEBUG_ENTRY("void")
 
-    cjson_hooks.malloc_fn = memory_malloc;
+    cjson_hooks.malloc_fn = _json_malloc;
     cjson_hooks.free_fn = memory_free;
     cJSON_InitHooks(&cjson_hooks);
 
@@ -694,13 +697,11 @@ E_MCL_ERROR_CODE mcl_json_util_get_string(mcl_json_t *json_item, char **string_v
     code = json_util_get_string(json_item, &string_value_local);
     ASSERT_CODE_MESSAGE(MCL_OK == code, code, "Memory can not be allocated for string_value_local.");
 
-    *string_value = string_value_local->buffer;
-
     // Free only the struct, its buffer should stay.
-    MCL_FREE(string_value_local);
+    code = string_detach(&string_value_local, string_value);
 
-    DEBUG_LEAVE("retVal = <%d>", MCL_OK);
-    return MCL_OK;
+    DEBUG_LEAVE("retVal = <%d>", code);
+    return code;
 }
 
 E_MCL_ERROR_CODE json_util_get_string(json_t *json_item, string_t **string_value)
@@ -876,3 +877,8 @@ static E_JSON_TYPE _convert_mcl_json_type_to_json_type(E_MCL_JSON_TYPE mcl_json_
     VERBOSE_LEAVE("retVal = <%d>", json_type);
     return json_type;
 }
+
+static void *_json_malloc(size_t size)
+{
+    return memory_category_malloc(MCL_MEMORY_CATEGORY_JSON, size);
+}
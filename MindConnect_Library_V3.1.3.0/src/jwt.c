@@ -11,6 +11,8 @@
  *
  ************************************************************************/
 
+#define MEMORY_CATEGORY MCL_MEMORY_CATEGORY_SECURITY
+
 #include "jwt.h"
 #include "log_util.h"
 #include "definitions.h"
@@ -334,7 +336,7 @@ static E_MCL_ERROR_CODE _calculate_signature(jwt_t *jwt, string_t *header_and_pa
     }
     else
     {
-        code = security_handler_rsa_sign(jwt->security_handler->rsa.private_key, header_and_payload->buffer, header_and_payload->length, &hash, &hash_size);
+        code = security_handler_rsa_sign(jwt->security_handler, header_and_payload->buffer, header_and_payload->length, &hash, &hash_size);
     }
     ASSERT_CODE_MESSAGE(MCL_OK == code, MCL_FAIL, "Can not sign JWT!");
 
@@ -136,13 +136,13 @@ void mcl_list_destroy_with_content(mcl_list_t **list, mcl_list_item_destroy_call
     DEBUG_LEAVE("retVal = void");
 }
 
-E_MCL_ERROR_CODE list_initialize(list_t **list)
+E_MCL_ERROR_CODE list_category_initialize(E_MCL_MEMORY_CATEGORY category, list_t **list)
 {
-    VERBOSE_ENTRY("list_t **list = <%p>", list)
+    VERBOSE_ENTRY("E_MCL_MEMORY_CATEGORY category = <%d>, list_t **list = <%p>", category, list)
 
 	list_t *list_local;
 	
-    MCL_NEW(*list);
+    MCL_CATEGORY_NEW(*list, category);
     ASSERT_CODE_MESSAGE(MCL_NULL != *list, MCL_OUT_OF_MEMORY, "Not enough memory to allocate new list_t!");
 
     // initialize the list:
@@ -151,6 +151,7 @@ E_MCL_ERROR_CODE list_initialize(list_t **list)
     list_local->current = MCL_NULL;
     list_local->head = MCL_NULL;
     list_local->last = MCL_NULL;
+    list_local->category = category;
 
     VERBOSE_LEAVE("retVal = <%d>", MCL_OK);
     return MCL_OK;
@@ -163,7 +164,7 @@ E_MCL_ERROR_CODE list_add(list_t *list, void *data)
 	list_node_t *new_node;
     ASSERT_CODE_MESSAGE(list->count < MCL_SIZE_MAX, MCL_LIMIT_EXCEEDED, "Index of the list is already at the maximum value. Not adding the new data!");
 
-    MCL_NEW(new_node);
+    MCL_CATEGORY_POOL_NEW(new_node, list->category);
     ASSERT_CODE_MESSAGE(MCL_NULL != new_node, MCL_OUT_OF_MEMORY, "Not enough memory to allocate new mcl_node!");
 
     new_node->data = data;
@@ -299,7 +300,7 @@ E_MCL_ERROR_CODE list_remove(list_t *list, list_node_t *node)
     MCL_VERBOSE("list handling ends");
 
     // now node connection handling and list handling is completed. we can free the node:
-    MCL_FREE(node);
+    MCL_POOL_FREE(node);
     MCL_VERBOSE("node is freed");
 
     VERBOSE_LEAVE("retVal = <%d>", MCL_OK);
@@ -395,7 +396,7 @@ void list_destroy_with_content(list_t **list, list_item_destroy_callback callbac
 
             node_to_free = current_node;
             current_node = node_to_free->next;
-            MCL_FREE(node_to_free);
+            MCL_POOL_FREE(node_to_free);
             MCL_DEBUG("%d. node has been freed..", index++);
         }
 
@@ -17,6 +17,7 @@
 #define LIST_H_
 
 #include "mcl/mcl_list.h"
+#include "memory.h"
 
 typedef mcl_list_node_t list_node_t;
 typedef mcl_list_t list_t;
@@ -28,6 +29,7 @@ typedef mcl_list_item_destroy_callback list_item_destroy_callback;
  *
  * Head, Last and Current pointers will be set to NULL. Count will be 0.
  *
+ * @param [in] category Category which the list and its nodes are accounted to.
  * @param [out] list Will point to the initialized #list_t object.
  * @return
  * <ul>
@@ -35,7 +37,12 @@ typedef mcl_list_item_destroy_callback list_item_destroy_callback;
  * <li>#MCL_OUT_OF_MEMORY in case there is not enough memory in the system to proceed.</li>
  * </ul>
  */
-E_MCL_ERROR_CODE list_initialize(list_t **list);
+E_MCL_ERROR_CODE list_category_initialize(E_MCL_MEMORY_CATEGORY category, list_t **list);
+
+/**
+ * @brief Calls #list_category_initialize() with the category of the calling module, see #MEMORY_CATEGORY.
+ */
+#define list_initialize(list) list_category_initialize(MEMORY_CATEGORY, list)
 
 /**
  * @brief Adds a new list item.
@@ -104,7 +104,8 @@ const char *error_code_strings[MCL_ERROR_CODE_END] =
 	"MCL_LIMIT_EXCEEDED",
 	"MCL_ARRAY_IS_EMPTY",
 	"MCL_PARTIALLY_WRITTEN",
-	"MCL_HTTP_REQUEST_FINALIZE_FAILED"
+	"MCL_HTTP_REQUEST_FINALIZE_FAILED",
+	"MCL_EXCHANGE_ASYNC_IS_ACTIVE"
 };
 
 #if (1 == HAVE_SYSLOG_H_)
@@ -19,15 +19,257 @@
 #include <stdlib.h>
 #endif
 
-void *memory_allocate(mcl_size_t bytes, const char *function, unsigned line)
+#include <string.h>
+
+#if (1 == MCL_MEMORY_TELEMETRY)
+#include <stdio.h>
+#endif
+
+// Allocations of an arena are aligned to this size, which suits any basic type.
+#define MEMORY_ARENA_ALIGNMENT 16
+
+// Size of the header in front of each allocation of an arena, keeping the size of the allocation.
+#define MEMORY_ARENA_HEADER_SIZE MEMORY_ARENA_ALIGNMENT
+
+#define MEMORY_ARENA_ALIGN(size) (((size) + (MEMORY_ARENA_ALIGNMENT - 1)) & ~((mcl_size_t)MEMORY_ARENA_ALIGNMENT - 1))
+#define MEMORY_ARENA_BLOCK_DATA(block) ((mcl_uint8_t *)(block) + MEMORY_ARENA_ALIGN(sizeof(memory_arena_block_t)))
+#define MEMORY_ARENA_ALLOCATION_SIZE(p) (*(mcl_size_t *)((mcl_uint8_t *)(p) - MEMORY_ARENA_HEADER_SIZE))
+
+// Objects of pools are aligned to this size and size classes are this much apart.
+#define MEMORY_POOL_ALIGNMENT 8
+#define MEMORY_POOL_CLASS_COUNT (MEMORY_POOL_MAX_OBJECT_SIZE / MEMORY_POOL_ALIGNMENT)
+
+// Size of the slabs which objects of a size class are carved out of.
+#define MEMORY_POOL_SLAB_SIZE 4096
+
+// Each object of a pool is preceded by a pointer to its slab, NULL if the object is allocated from the heap.
+// An object allocated from an arena is preceded by a pointer to its arena instead, which is told apart by its lowest bit set.
+#define MEMORY_POOL_HEADER_SIZE MEMORY_POOL_ALIGNMENT
+#define MEMORY_POOL_ARENA_TAG ((mcl_size_t)1)
+#define MEMORY_POOL_ALIGN(size) (((size) + (MEMORY_POOL_ALIGNMENT - 1)) & ~((mcl_size_t)MEMORY_POOL_ALIGNMENT - 1))
+#define MEMORY_POOL_SLAB_DATA(slab) ((mcl_uint8_t *)(slab) + MEMORY_POOL_ALIGN(sizeof(memory_pool_slab_t)))
+#define MEMORY_POOL_OBJECT_SLAB(p) (*(memory_pool_slab_t **)((mcl_uint8_t *)(p) - MEMORY_POOL_HEADER_SIZE))
+#define MEMORY_POOL_IS_ARENA_OBJECT(slab) (0 != ((mcl_size_t)(slab) & MEMORY_POOL_ARENA_TAG))
+#define MEMORY_POOL_TAG_ARENA(arena) ((memory_pool_slab_t *)((mcl_size_t)(arena) | MEMORY_POOL_ARENA_TAG))
+#define MEMORY_POOL_UNTAG_ARENA(slab) ((memory_arena_t *)((mcl_size_t)(slab) & ~MEMORY_POOL_ARENA_TAG))
+
+// Slab of a pool, objects of a size class and a category are carved out of it.
+typedef struct memory_pool_slab_t
+{
+    struct memory_pool_slab_t *previous; // Previous slab of the pool which has free objects.
+    struct memory_pool_slab_t *next;     // Next slab of the pool which has free objects.
+    void *free_objects;                  // Free objects of the slab, linked through the objects themselves.
+    mcl_size_t used_count;               // Number of objects of the slab in use.
+    mcl_size_t class_index;              // Size class of the objects.
+    E_MCL_MEMORY_CATEGORY category;      // Category which the slab is accounted to.
+} memory_pool_slab_t;
+
+// Pool of a size class and a category, full slabs are not linked to their pool until an object of them is released.
+typedef struct memory_pool_t
+{
+    memory_pool_slab_t *slabs; // Slabs which have free objects.
+} memory_pool_t;
+
+// Initial capacity of the table of tracked allocations, the table is doubled when it is half full.
+#define MEMORY_TRACKING_INITIAL_CAPACITY 256
+
+// Addresses are mixed so that allocations of the same size, which are a fixed distance apart, spread over the table.
+#define MEMORY_TRACKING_INDEX(p, mask) (_tracking_hash(p) & (mask))
+
+// Callbacks of the allocator are never called with a lock of this module held, so that they may take locks of their own or allocate through MCL.
+#if defined(WIN32) || defined(WIN64)
+#include <windows.h>
+typedef SRWLOCK memory_lock_t;
+#define MEMORY_LOCK_INITIALIZER SRWLOCK_INIT
+#define MEMORY_LOCK(lock) AcquireSRWLockExclusive(lock)
+#define MEMORY_UNLOCK(lock) ReleaseSRWLockExclusive(lock)
+#else
+#include <pthread.h>
+typedef pthread_mutex_t memory_lock_t;
+#define MEMORY_LOCK_INITIALIZER PTHREAD_MUTEX_INITIALIZER
+#define MEMORY_LOCK(lock) pthread_mutex_lock(lock)
+#define MEMORY_UNLOCK(lock) pthread_mutex_unlock(lock)
+#endif
+
+// Table of tracked allocations is shared by all threads, libcurl may allocate from its resolver threads.
+#define MEMORY_TRACKING_LOCK() MEMORY_LOCK(&_tracking_lock)
+#define MEMORY_TRACKING_UNLOCK() MEMORY_UNLOCK(&_tracking_lock)
+
+// Pools are shared by all threads, so that an object can be released by any thread and goes back to its own slab.
+#define MEMORY_POOL_LOCK() MEMORY_LOCK(&_pool_lock)
+#define MEMORY_POOL_UNLOCK() MEMORY_UNLOCK(&_pool_lock)
+
+// Current arena is kept per thread, so that allocations of other threads never go to the arena of a store.
+#if defined(_MSC_VER)
+#define MEMORY_THREAD_LOCAL __declspec(thread)
+#elif defined(__GNUC__) || defined(__clang__)
+#define MEMORY_THREAD_LOCAL __thread
+#elif defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 201112L) && !defined(__STDC_NO_THREADS__)
+#define MEMORY_THREAD_LOCAL _Thread_local
+#else
+#error "Thread local storage is required for the current arena."
+#endif
+
+#if (1 == MCL_MEMORY_TELEMETRY)
+#define MEMORY_TELEMETRY_INITIAL_CAPACITY 256
+#define MEMORY_TELEMETRY_INITIAL_SITE_CAPACITY 64
+
+// Formats of the json string dumped by mcl_memory_dump_telemetry(), call sites are written between them followed by "]}".
+#define MEMORY_TELEMETRY_JSON_FORMAT "{\"current_bytes\":%llu,\"peak_bytes\":%llu,\"current_count\":%llu,\"allocation_count\":%llu,\"call_site_count\":%llu,\"call_sites\":["
+#define MEMORY_TELEMETRY_CALL_SITE_JSON_FORMAT "%s{\"function\":\"%s\",\"line\":%llu,\"current_bytes\":%llu,\"peak_bytes\":%llu,\"current_count\":%llu,\"allocation_count\":%llu,\"total_bytes\":%llu,\"largest_size\":%llu}"
+
+// Telemetry is recorded only if MCL is built with MCL_MEMORY_TELEMETRY option.
+#define MEMORY_TELEMETRY_RECORD(p, size, function, line) _telemetry_record(p, size, function, line)
+#define MEMORY_TELEMETRY_FORGET(p) _telemetry_forget(p)
+#define MEMORY_TELEMETRY_FORGET_ARENA(arena) _telemetry_forget_arena(arena)
+#define MEMORY_TELEMETRY_HOOK_FUNCTION(category) _telemetry_hook_functions[category]
+#else
+#define MEMORY_TELEMETRY_RECORD(p, size, function, line)
+#define MEMORY_TELEMETRY_FORGET(p)
+#define MEMORY_TELEMETRY_FORGET_ARENA(arena)
+#define MEMORY_TELEMETRY_HOOK_FUNCTION(category) MCL_NULL
+#endif
+
+// Allocation tracked for accounting. Allocations have no header, since buffers allocated by MCL are released by the user and vice versa.
+typedef struct memory_tracking_entry_t
+{
+    const void *p;
+    mcl_size_t size;
+    E_MCL_MEMORY_CATEGORY category;
+} memory_tracking_entry_t;
+
+static void *_default_malloc(void *context, mcl_size_t size);
+static void *_default_realloc(void *context, void *p, mcl_size_t size);
+static void _default_free(void *context, void *p);
+
+// Allocator which all memory is taken from.
+static mcl_memory_allocator_t _allocator = {_default_malloc, _default_realloc, _default_free, MCL_NULL};
+
+// Memory usage of the categories.
+static mcl_memory_usage_t _usage[MCL_MEMORY_CATEGORY_END];
+
+// Open addressing table of tracked allocations with linear probing.
+static memory_tracking_entry_t *_tracking_entries = MCL_NULL;
+static mcl_size_t _tracking_capacity = 0;
+static mcl_size_t _tracking_count = 0;
+static memory_lock_t _tracking_lock = MEMORY_LOCK_INITIALIZER;
+
+// Pools of the size classes of each category.
+static memory_pool_t _pools[MCL_MEMORY_CATEGORY_END][MEMORY_POOL_CLASS_COUNT];
+static memory_lock_t _pool_lock = MEMORY_LOCK_INITIALIZER;
+
+// Arena which memory is allocated from by the calling thread, NULL if memory is allocated from the heap.
+static MEMORY_THREAD_LOCAL memory_arena_t *_current_arena = MCL_NULL;
+
+#if (1 == MCL_MEMORY_TELEMETRY)
+// Allocation tracked for telemetry with the index of the call site which allocated it.
+typedef struct memory_telemetry_entry_t
+{
+    const void *p;
+    mcl_size_t size;
+    mcl_size_t site;
+} memory_telemetry_entry_t;
+
+// Names of the call sites which allocations of third party libraries are attributed to, indexed by category.
+static const char *_telemetry_hook_functions[MCL_MEMORY_CATEGORY_END] = {"other", "store", "http", "json", "security", "curl"};
+
+// Telemetry of all call sites and of each call site. Guarded by the lock of the table of tracked allocations.
+static mcl_memory_telemetry_t _telemetry;
+static mcl_memory_call_site_t *_telemetry_sites = MCL_NULL;
+static mcl_size_t _telemetry_site_capacity = 0;
+
+// Open addressing table of call site indexes plus one, zero for an empty slot. It has twice as many slots as the capacity of call sites.
+static mcl_size_t *_telemetry_site_slots = MCL_NULL;
+
+// Open addressing table of allocations tracked for telemetry with linear probing.
+static memory_telemetry_entry_t *_telemetry_entries = MCL_NULL;
+static mcl_size_t _telemetry_capacity = 0;
+static mcl_size_t _telemetry_count = 0;
+#endif
+
+// Allocates memory from the arena or the heap if the arena is NULL.
+static void *_malloc(memory_arena_t *arena, E_MCL_MEMORY_CATEGORY category, mcl_size_t size, const char *function, unsigned line);
+
+// Allocates zero initialized memory from the arena or the heap if the arena is NULL.
+static void *_calloc(memory_arena_t *arena, E_MCL_MEMORY_CATEGORY category, mcl_size_t count, mcl_size_t bytes, const char *function, unsigned line);
+
+// Resizes memory in the arena if it is found there, otherwise in the heap. New memory is allocated from the arena or the heap if the arena is NULL.
+static void *_realloc(memory_arena_t *arena, E_MCL_MEMORY_CATEGORY category, void *p, mcl_size_t size, const char *function, unsigned line);
+
+// Allocates memory from the allocator and accounts it to the category.
+static void *_heap_allocate(E_MCL_MEMORY_CATEGORY category, mcl_size_t size);
+
+// Resizes memory with the allocator, memory keeps its category unless it is not tracked yet.
+static void *_heap_reallocate(E_MCL_MEMORY_CATEGORY category, void *p, mcl_size_t size);
+
+// Releases memory with the allocator and removes it from its category.
+static void _heap_release(void *p);
+
+// Returns the hash of the address for the table of tracked allocations.
+static mcl_size_t _tracking_hash(const void *p);
+
+// Tracks the allocation, an entry left for the same address by memory released without MCL's knowledge is replaced. Called with the lock held.
+static E_MCL_ERROR_CODE _tracking_add(const void *p, mcl_size_t size, E_MCL_MEMORY_CATEGORY category);
+
+// Stops tracking the allocation if it is tracked. Called with the lock held.
+static void _tracking_remove(const void *p);
+
+// Allocates memory for a table of this module, accounted as other memory. Called with the lock held, which is released while the allocator is called.
+static void *_table_allocate(mcl_size_t size);
+
+// Releases memory of a table of this module. Called with the lock held, which is released while the allocator is called.
+static void _table_release(void *p, mcl_size_t size);
+
+// Allocates a slab for the pool and links it to the pool. Called with the lock of the pools held, which is released while the slab is allocated.
+static memory_pool_slab_t *_pool_new_slab(memory_pool_t *pool, mcl_size_t class_index, E_MCL_MEMORY_CATEGORY category);
+
+// Unlinks the slab from its pool. Called with the lock of the pools held.
+static void _pool_unlink_slab(memory_pool_t *pool, memory_pool_slab_t *slab);
+
+// Allocates memory from the arena.
+static void *_arena_allocate(memory_arena_t *arena, mcl_size_t size);
+
+// Resizes memory in its own arena.
+static void *_arena_reallocate(memory_arena_block_t *block, void *p, mcl_size_t size);
+
+// Releases memory if it is the last allocation of its block.
+static void _arena_release(memory_arena_block_t *block, void *p);
+
+// Allocates a new block for the arena and adds it to the sorted blocks of the arena.
+static memory_arena_block_t *_arena_new_block(memory_arena_t *arena, mcl_size_t size);
+
+// Returns the block of the arena which the pointer is allocated from, NULL if it is not allocated from the arena.
+static memory_arena_block_t *_arena_find_block(const memory_arena_t *arena, const void *p);
+
+#if (1 == MCL_MEMORY_TELEMETRY)
+// Records the allocation for the telemetry of its call site.
+static void _telemetry_record(const void *p, mcl_size_t size, const char *function, unsigned line);
+
+// Removes the allocation from the telemetry of its call site if it is recorded. Returns the size of the allocation, zero if it is not recorded.
+static mcl_size_t _telemetry_forget(const void *p);
+
+// Removes all allocations of the arena from the telemetry. Called before the blocks of the arena are released.
+static void _telemetry_forget_arena(memory_arena_t *arena);
+
+// Returns the index of the call site, the call site is added if it is new. MCL_SIZE_MAX if there is not enough memory. Called with the lock held.
+static mcl_size_t _telemetry_find_site(const char *function, unsigned line);
+
+// Doubles the capacity of call sites. Called with the lock held.
+static E_MCL_ERROR_CODE _telemetry_grow_sites(void);
+
+// Removes the entry at the index from the table and its call site. Called with the lock held.
+static void _telemetry_remove_at(mcl_size_t index);
+#endif
+
+void *memory_allocate(mcl_size_t bytes, E_MCL_MEMORY_CATEGORY category, const char *function, unsigned line)
 {
-    VERBOSE_ENTRY("mcl_size_t bytes = <%u>, const char *function = <%s>, unsigned line = <%u>", bytes, function, line)
+    VERBOSE_ENTRY("mcl_size_t bytes = <%u>, E_MCL_MEMORY_CATEGORY category = <%d>, const char *function = <%s>, unsigned line = <%u>", bytes, category, function, line)
 
 	void *p = MCL_NULL;
 
     ASSERT_MESSAGE(0 != bytes, "Requested bytes size is equal to 0!");
 
-    p = memory_malloc(bytes);
+    p = _malloc(_current_arena, category, bytes, function, line);
 
     ASSERT_MESSAGE(MCL_NULL != p, "Memory couldn't be allocated!");
 
@@ -36,16 +278,16 @@ void *memory_allocate(mcl_size_t bytes, const char *function, unsigned line)
     return p;
 }
 
-void *memory_allocate_with_zero(mcl_size_t count, mcl_size_t bytes, const char *function, unsigned line)
+void *memory_allocate_with_zero(mcl_size_t count, mcl_size_t bytes, E_MCL_MEMORY_CATEGORY category, const char *function, unsigned line)
 {
-    VERBOSE_ENTRY("mcl_size_t count = <%u>, mcl_size_t bytes = <%u>, const char *function = <%s>, unsigned line = <%u>", count, bytes, function, line)
+    VERBOSE_ENTRY("mcl_size_t count = <%u>, mcl_size_t bytes = <%u>, E_MCL_MEMORY_CATEGORY category = <%d>, const char *function = <%s>, unsigned line = <%u>", count, bytes, category, function, line)
 
 	void *p;
 
     ASSERT_MESSAGE(0 != count, "Requested count size is equal to 0!");
     ASSERT_MESSAGE(0 != bytes, "Requested bytes size is equal to 0!");
 
-    p = memory_calloc(count, bytes);
+    p = _calloc(_current_arena, category, count, bytes, function, line);
 
     ASSERT_MESSAGE(p, "Memory couldn't be allocated!");
 
@@ -54,15 +296,15 @@ void *memory_allocate_with_zero(mcl_size_t count, mcl_size_t bytes, const char *
     return p;
 }
 
-void *memory_reallocate(void *p, mcl_size_t bytes, const char *function, unsigned line)
+void *memory_reallocate(void *p, mcl_size_t bytes, E_MCL_MEMORY_CATEGORY category, const char *function, unsigned line)
 {
-    VERBOSE_ENTRY("void *p = <%p>, mcl_size_t bytes = <%u>, const char *function = <%s>, unsigned line = <%u>", p, bytes, function, line)
+    VERBOSE_ENTRY("void *p = <%p>, mcl_size_t bytes = <%u>, E_MCL_MEMORY_CATEGORY category = <%d>, const char *function = <%s>, unsigned line = <%u>", p, bytes, category, function, line)
 
 	void *temp = MCL_NULL;
 
     ASSERT_MESSAGE(0 != bytes, "Requested bytes size is equal to 0!");
 
-    temp = memory_realloc(p, bytes);
+    temp = _realloc(_current_arena, category, p, bytes, function, line);
     if (MCL_NULL != temp)
     {
         p = temp;
@@ -98,29 +340,47 @@ void memory_release(void *p, const char *function, unsigned line)
 
 void *memory_malloc(mcl_size_t size)
 {
-    VERBOSE_ENTRY("mcl_size_t size = <%u>", size)
+    return _malloc(_current_arena, MCL_MEMORY_CATEGORY_OTHER, size, MEMORY_TELEMETRY_HOOK_FUNCTION(MCL_MEMORY_CATEGORY_OTHER), 0);
+}
+
+void *memory_calloc(mcl_size_t count, mcl_size_t bytes)
+{
+    return _calloc(_current_arena, MCL_MEMORY_CATEGORY_OTHER, count, bytes, MEMORY_TELEMETRY_HOOK_FUNCTION(MCL_MEMORY_CATEGORY_OTHER), 0);
+}
+
+void *memory_realloc(void *p, mcl_size_t bytes)
+{
+    return _realloc(_current_arena, MCL_MEMORY_CATEGORY_OTHER, p, bytes, MEMORY_TELEMETRY_HOOK_FUNCTION(MCL_MEMORY_CATEGORY_OTHER), 0);
+}
+
+// Third party libraries keep their memory beyond the scope an arena is current in, e.g. the state OpenSSL creates lazily
+// while a store generates a GUID, so their memory is always allocated from the heap.
+
+void *memory_category_malloc(E_MCL_MEMORY_CATEGORY category, mcl_size_t size)
+{
+    VERBOSE_ENTRY("E_MCL_MEMORY_CATEGORY category = <%d>, mcl_size_t size = <%u>", category, size)
 
-    void *p = malloc(size);
+    void *p = _malloc(MCL_NULL, category, size, MEMORY_TELEMETRY_HOOK_FUNCTION(category), 0);
 
     VERBOSE_LEAVE("retVal = <%p>", p);
     return p;
 }
 
-void *memory_calloc(mcl_size_t count, mcl_size_t bytes)
+void *memory_category_calloc(E_MCL_MEMORY_CATEGORY category, mcl_size_t count, mcl_size_t bytes)
 {
-    VERBOSE_ENTRY("mcl_size_t count = <%u>, mcl_size_t bytes = <%u>", count, bytes)
+    VERBOSE_ENTRY("E_MCL_MEMORY_CATEGORY category = <%d>, mcl_size_t count = <%u>, mcl_size_t bytes = <%u>", category, count, bytes)
 
-    void *p = calloc(count, bytes);
+    void *p = _calloc(MCL_NULL, category, count, bytes, MEMORY_TELEMETRY_HOOK_FUNCTION(category), 0);
 
     VERBOSE_LEAVE("retVal = <%p>", p);
     return p;
 }
 
-void *memory_realloc(void *p, mcl_size_t bytes)
+void *memory_category_realloc(E_MCL_MEMORY_CATEGORY category, void *p, mcl_size_t bytes)
 {
-    VERBOSE_ENTRY("void *p = <%p>, mcl_size_t bytes = <%u>", p, bytes)
+    VERBOSE_ENTRY("E_MCL_MEMORY_CATEGORY category = <%d>, void *p = <%p>, mcl_size_t bytes = <%u>", category, p, bytes)
 
-    p = realloc(p, bytes);
+    p = _realloc(MCL_NULL, category, p, bytes, MEMORY_TELEMETRY_HOOK_FUNCTION(category), 0);
 
     VERBOSE_LEAVE("retVal = <%p>", p);
     return p;
@@ -130,8 +390,1294 @@ void memory_free(void *p)
 {
     VERBOSE_ENTRY("void *p = <%p>", p)
 
+    // Memory of an arena is released while its arena is current, so only the current arena is searched.
+    memory_arena_block_t *block = (MCL_NULL == _current_arena) ? MCL_NULL : _arena_find_block(_current_arena, p);
+
     MCL_VERBOSE("Memory will be freed at location = <%p>.", p);
-    free(p);
+
+    MEMORY_TELEMETRY_FORGET(p);
+
+    if (MCL_NULL != block)
+    {
+        _arena_release(block, p);
+    }
+    else
+    {
+        _heap_release(p);
+    }
+
+    VERBOSE_LEAVE("retVal = void");
+}
+
+void *memory_pool_allocate(mcl_size_t bytes, E_MCL_MEMORY_CATEGORY category, const char *function, unsigned line)
+{
+    VERBOSE_ENTRY("mcl_size_t bytes = <%u>, E_MCL_MEMORY_CATEGORY category = <%d>, const char *function = <%s>, unsigned line = <%u>", bytes, category, function, line)
+
+    mcl_uint8_t *p = MCL_NULL;
+    mcl_size_t class_index = (bytes - 1) / MEMORY_POOL_ALIGNMENT;
+
+    if (MCL_NULL != _current_arena)
+    {
+        // Header keeps the arena, so that the object can be released while its arena is not current.
+        p = _arena_allocate(_current_arena, MEMORY_POOL_HEADER_SIZE + bytes);
+
+        if (MCL_NULL != p)
+        {
+            p += MEMORY_POOL_HEADER_SIZE;
+            MEMORY_POOL_OBJECT_SLAB(p) = MEMORY_POOL_TAG_ARENA(_current_arena);
+            MEMORY_TELEMETRY_RECORD(p, bytes, function, line);
+        }
+    }
+    else if ((0 == bytes) || (MEMORY_POOL_MAX_OBJECT_SIZE < bytes))
+    {
+        // Header tells memory_pool_release() that the object is not in a slab.
+        p = memory_allocate(MEMORY_POOL_HEADER_SIZE + bytes, category, function, line);
+
+        if (MCL_NULL != p)
+        {
+            p += MEMORY_POOL_HEADER_SIZE;
+            MEMORY_POOL_OBJECT_SLAB(p) = MCL_NULL;
+        }
+    }
+    else
+    {
+        memory_pool_t *pool = &_pools[category][class_index];
+        memory_pool_slab_t *slab;
+
+        MEMORY_POOL_LOCK();
+
+        slab = (MCL_NULL == pool->slabs) ? _pool_new_slab(pool, class_index, category) : pool->slabs;
+
+        if (MCL_NULL != slab)
+        {
+            p = slab->free_objects;
+            slab->free_objects = *(void **)p;
+            slab->used_count++;
+
+            if (MCL_NULL == slab->free_objects)
+            {
+                _pool_unlink_slab(pool, slab);
+            }
+        }
+
+        MEMORY_POOL_UNLOCK();
+
+        MEMORY_TELEMETRY_RECORD(p, bytes, function, line);
+    }
+
+    ASSERT_MESSAGE(MCL_NULL != p, "Memory couldn't be allocated!");
+
+    VERBOSE_LEAVE("retVal = <%p>", p);
+    return p;
+}
+
+void memory_pool_release(void *p, mcl_size_t bytes, const char *function, unsigned line)
+{
+    VERBOSE_ENTRY("void *p = <%p>, mcl_size_t bytes = <%u>, const char *function = <%s>, unsigned line = <%u>", p, bytes, function, line)
+
+    memory_pool_slab_t *slab = (MCL_NULL == p) ? MCL_NULL : MEMORY_POOL_OBJECT_SLAB(p);
+
+    if (MCL_NULL == p)
+    {
+        MCL_VERBOSE("Pointer is already NULL!");
+    }
+    else if (MCL_NULL == slab)
+    {
+        memory_release((mcl_uint8_t *)p - MEMORY_POOL_HEADER_SIZE, function, line);
+    }
+    else if (MEMORY_POOL_IS_ARENA_OBJECT(slab))
+    {
+        memory_arena_block_t *block = _arena_find_block(MEMORY_POOL_UNTAG_ARENA(slab), (mcl_uint8_t *)p - MEMORY_POOL_HEADER_SIZE);
+
+        MEMORY_TELEMETRY_FORGET(p);
+
+        if (MCL_NULL != block)
+        {
+            _arena_release(block, (mcl_uint8_t *)p - MEMORY_POOL_HEADER_SIZE);
+        }
+    }
+    else
+    {
+        memory_pool_t *pool = &_pools[slab->category][slab->class_index];
+
+        MEMORY_TELEMETRY_FORGET(p);
+
+        MEMORY_POOL_LOCK();
+
+        // A full slab is linked to its pool again, since it has a free object now.
+        if (MCL_NULL == slab->free_objects)
+        {
+            slab->previous = MCL_NULL;
+            slab->next = pool->slabs;
+            if (MCL_NULL != pool->slabs)
+            {
+                pool->slabs->previous = slab;
+            }
+            pool->slabs = slab;
+        }
+
+        *(void **)p = slab->free_objects;
+        slab->free_objects = p;
+        slab->used_count--;
+
+        // An empty slab is returned to the heap unless it is the last slab of its pool with free objects.
+        if ((0 == slab->used_count) && ((pool->slabs != slab) || (MCL_NULL != slab->next)))
+        {
+            _pool_unlink_slab(pool, slab);
+        }
+        else
+        {
+            slab = MCL_NULL;
+        }
+
+        MEMORY_POOL_UNLOCK();
+
+        _heap_release(slab);
+    }
+
+    VERBOSE_LEAVE("retVal = void");
+}
+
+E_MCL_ERROR_CODE memory_arena_initialize(mcl_size_t block_size, E_MCL_MEMORY_CATEGORY category, memory_arena_t **arena)
+{
+    DEBUG_ENTRY("mcl_size_t block_size = <%u>, E_MCL_MEMORY_CATEGORY category = <%d>, memory_arena_t **arena = <%p>", block_size, category, arena)
+
+    // Arena itself is allocated from the heap even if another arena is the current arena.
+    *arena = _heap_allocate(category, sizeof(memory_arena_t));
+    ASSERT_CODE_MESSAGE(MCL_NULL != *arena, MCL_OUT_OF_MEMORY, "Memory couldn't be allocated for arena.");
+
+    (*arena)->blocks = MCL_NULL;
+    (*arena)->sorted_blocks = MCL_NULL;
+    (*arena)->block_count = 0;
+    (*arena)->block_capacity = 0;
+    (*arena)->category = category;
+    (*arena)->block_size = (0 == block_size) ? DEFAULT_MEMORY_ARENA_BLOCK_SIZE : MEMORY_ARENA_ALIGN(block_size);
+
+    DEBUG_LEAVE("retVal = <%d>", MCL_OK);
+    return MCL_OK;
+}
+
+memory_arena_t *memory_arena_set_current(memory_arena_t *arena)
+{
+    VERBOSE_ENTRY("memory_arena_t *arena = <%p>", arena)
+
+    memory_arena_t *previous_arena = _current_arena;
+
+    _current_arena = arena;
+
+    VERBOSE_LEAVE("retVal = <%p>", previous_arena);
+    return previous_arena;
+}
+
+memory_arena_t *memory_arena_get_current(void)
+{
+    VERBOSE_ENTRY("void")
+
+    VERBOSE_LEAVE("retVal = <%p>", _current_arena);
+    return _current_arena;
+}
+
+mcl_bool_t memory_arena_contains(const memory_arena_t *arena, const void *p)
+{
+    VERBOSE_ENTRY("const memory_arena_t *arena = <%p>, const void *p = <%p>", arena, p)
+
+    mcl_bool_t contains = ((MCL_NULL != arena) && (MCL_NULL != _arena_find_block(arena, p))) ? MCL_TRUE : MCL_FALSE;
+
+    VERBOSE_LEAVE("retVal = <%d>", contains);
+    return contains;
+}
+
+void memory_arena_reset(memory_arena_t *arena)
+{
+    DEBUG_ENTRY("memory_arena_t *arena = <%p>", arena)
+
+    memory_arena_block_t *block;
+
+    MEMORY_TELEMETRY_FORGET_ARENA(arena);
+
+    while (MCL_NULL != arena->blocks)
+    {
+        block = arena->blocks;
+        arena->blocks = block->next;
+        _heap_release(block);
+    }
+
+    _heap_release(arena->sorted_blocks);
+    arena->sorted_blocks = MCL_NULL;
+    arena->block_count = 0;
+    arena->block_capacity = 0;
+
+    DEBUG_LEAVE("retVal = void");
+}
+
+void memory_arena_destroy(memory_arena_t **arena)
+{
+    DEBUG_ENTRY("memory_arena_t **arena = <%p>", arena)
+
+    if (MCL_NULL != *arena)
+    {
+        memory_arena_reset(*arena);
+
+        if (*arena == _current_arena)
+        {
+            _current_arena = MCL_NULL;
+        }
+
+        _heap_release(*arena);
+        *arena = MCL_NULL;
+    }
+
+    DEBUG_LEAVE("retVal = void");
+}
+
+static void *_malloc(memory_arena_t *arena, E_MCL_MEMORY_CATEGORY category, mcl_size_t size, const char *function, unsigned line)
+{
+    void *p = (MCL_NULL == arena) ? _heap_allocate(category, size) : _arena_allocate(arena, size);
+
+    MEMORY_TELEMETRY_RECORD(p, size, function, line);
+
+    return p;
+}
+
+static void *_calloc(memory_arena_t *arena, E_MCL_MEMORY_CATEGORY category, mcl_size_t count, mcl_size_t bytes, const char *function, unsigned line)
+{
+    void *p = MCL_NULL;
+
+    if ((0 == bytes) || (count <= MCL_SIZE_MAX / bytes))
+    {
+        p = _malloc(arena, category, count * bytes, function, line);
+    }
+
+    if (MCL_NULL != p)
+    {
+        memset(p, 0, count * bytes);
+    }
+
+    return p;
+}
+
+static void *_realloc(memory_arena_t *arena, E_MCL_MEMORY_CATEGORY category, void *p, mcl_size_t size, const char *function, unsigned line)
+{
+    memory_arena_block_t *block = (MCL_NULL == arena) ? MCL_NULL : _arena_find_block(arena, p);
+    void *new_p;
+
+#if (1 == MCL_MEMORY_TELEMETRY)
+    // Telemetry of the old address is removed before the allocator can give that address to another thread.
+    mcl_size_t old_size = _telemetry_forget(p);
+#endif
+
+    if (MCL_NULL != block)
+    {
+        new_p = _arena_reallocate(block, p, size);
+    }
+    else if ((MCL_NULL == p) && (MCL_NULL != arena))
+    {
+        new_p = _arena_allocate(arena, size);
+    }
+    else
+    {
+        new_p = _heap_reallocate(category, p, size);
+    }
+
+#if (1 == MCL_MEMORY_TELEMETRY)
+    // Memory which could not be resized is still valid and is recorded again.
+    if (MCL_NULL != new_p)
+    {
+        _telemetry_record(new_p, size, function, line);
+    }
+    else if (0 != old_size)
+    {
+        _telemetry_record(p, old_size, function, line);
+    }
+#endif
+
+    return new_p;
+}
+
+static memory_pool_slab_t *_pool_new_slab(memory_pool_t *pool, mcl_size_t class_index, E_MCL_MEMORY_CATEGORY category)
+{
+    VERBOSE_ENTRY("memory_pool_t *pool = <%p>, mcl_size_t class_index = <%u>, E_MCL_MEMORY_CATEGORY category = <%d>", pool, class_index, category)
+
+    mcl_size_t chunk_size = MEMORY_POOL_HEADER_SIZE + ((class_index + 1) * MEMORY_POOL_ALIGNMENT);
+    mcl_size_t chunk_count;
+    mcl_uint8_t *chunk;
+    memory_pool_slab_t *slab;
+
+    // Slabs are accounted to the category of their objects.
+    MEMORY_POOL_UNLOCK();
+    slab = _heap_allocate(category, MEMORY_POOL_SLAB_SIZE);
+    MEMORY_POOL_LOCK();
+
+    if (MCL_NULL == slab)
+    {
+        VERBOSE_LEAVE("retVal = <%p>", MCL_NULL);
+        return MCL_NULL;
+    }
+
+    slab->free_objects = MCL_NULL;
+    slab->used_count = 0;
+    slab->class_index = class_index;
+    slab->category = category;
+
+    // Objects are linked in the order of their addresses.
+    chunk_count = (MEMORY_POOL_SLAB_SIZE - (mcl_size_t)(MEMORY_POOL_SLAB_DATA(slab) - (mcl_uint8_t *)slab)) / chunk_size;
+    for (chunk = MEMORY_POOL_SLAB_DATA(slab) + ((chunk_count - 1) * chunk_size); chunk_count > 0; --chunk_count, chunk -= chunk_size)
+    {
+        MEMORY_POOL_OBJECT_SLAB(chunk + MEMORY_POOL_HEADER_SIZE) = slab;
+        *(void **)(chunk + MEMORY_POOL_HEADER_SIZE) = slab->free_objects;
+        slab->free_objects = chunk + MEMORY_POOL_HEADER_SIZE;
+    }
+
+    slab->previous = MCL_NULL;
+    slab->next = pool->slabs;
+    if (MCL_NULL != pool->slabs)
+    {
+        pool->slabs->previous = slab;
+    }
+    pool->slabs = slab;
+
+    VERBOSE_LEAVE("retVal = <%p>", slab);
+    return slab;
+}
+
+static void _pool_unlink_slab(memory_pool_t *pool, memory_pool_slab_t *slab)
+{
+    VERBOSE_ENTRY("memory_pool_t *pool = <%p>, memory_pool_slab_t *slab = <%p>", pool, slab)
+
+    if (MCL_NULL != slab->previous)
+    {
+        slab->previous->next = slab->next;
+    }
+    else
+    {
+        pool->slabs = slab->next;
+    }
+
+    if (MCL_NULL != slab->next)
+    {
+        slab->next->previous = slab->previous;
+    }
+
+    slab->previous = MCL_NULL;
+    slab->next = MCL_NULL;
 
     VERBOSE_LEAVE("retVal = void");
 }
+
+static void *_arena_allocate(memory_arena_t *arena, mcl_size_t size)
+{
+    VERBOSE_ENTRY("memory_arena_t *arena = <%p>, mcl_size_t size = <%u>", arena, size)
+
+    memory_arena_block_t *block = arena->blocks;
+    mcl_size_t required_size;
+    mcl_uint8_t *p;
+
+    if (size > MCL_SIZE_MAX - (2 * MEMORY_ARENA_ALIGNMENT))
+    {
+        VERBOSE_LEAVE("retVal = <%p>", MCL_NULL);
+        return MCL_NULL;
+    }
+
+    required_size = MEMORY_ARENA_HEADER_SIZE + MEMORY_ARENA_ALIGN(size);
+
+    if ((MCL_NULL == block) || (required_size > (block->size - block->used)))
+    {
+        // Large allocations get a block of their own, so that the space left in the current block is still used.
+        block = _arena_new_block(arena, (required_size > (arena->block_size / 4)) ? required_size : arena->block_size);
+    }
+
+    if (MCL_NULL == block)
+    {
+        VERBOSE_LEAVE("retVal = <%p>", MCL_NULL);
+        return MCL_NULL;
+    }
+
+    p = MEMORY_ARENA_BLOCK_DATA(block) + block->used + MEMORY_ARENA_HEADER_SIZE;
+    block->used += required_size;
+    MEMORY_ARENA_ALLOCATION_SIZE(p) = size;
+
+    VERBOSE_LEAVE("retVal = <%p>", p);
+    return p;
+}
+
+static void *_arena_reallocate(memory_arena_block_t *block, void *p, mcl_size_t size)
+{
+    VERBOSE_ENTRY("memory_arena_block_t *block = <%p>, void *p = <%p>, mcl_size_t size = <%u>", block, p, size)
+
+    mcl_size_t old_size = MEMORY_ARENA_ALLOCATION_SIZE(p);
+    mcl_size_t offset = (mcl_size_t)((mcl_uint8_t *)p - MEMORY_ARENA_BLOCK_DATA(block));
+    void *new_p = p;
+
+    if (size <= old_size)
+    {
+        VERBOSE_LEAVE("retVal = <%p>", p);
+        return p;
+    }
+
+    // The last allocation of a block grows in place if the block has enough space left.
+    if (((offset + MEMORY_ARENA_ALIGN(old_size)) == block->used) && (size <= (block->size - offset)))
+    {
+        block->used = offset + MEMORY_ARENA_ALIGN(size);
+        MEMORY_ARENA_ALLOCATION_SIZE(p) = size;
+    }
+    else
+    {
+        new_p = _arena_allocate(block->arena, size);
+
+        if (MCL_NULL != new_p)
+        {
+            memcpy(new_p, p, old_size);
+            _arena_release(block, p);
+        }
+    }
+
+    VERBOSE_LEAVE("retVal = <%p>", new_p);
+    return new_p;
+}
+
+static void _arena_release(memory_arena_block_t *block, void *p)
+{
+    VERBOSE_ENTRY("memory_arena_block_t *block = <%p>, void *p = <%p>", block, p)
+
+    mcl_size_t offset = (mcl_size_t)((mcl_uint8_t *)p - MEMORY_ARENA_BLOCK_DATA(block));
+
+    // Only the last allocation can be given back to its block, space of the others is released with the arena.
+    if ((offset + MEMORY_ARENA_ALIGN(MEMORY_ARENA_ALLOCATION_SIZE(p))) == block->used)
+    {
+        block->used = offset - MEMORY_ARENA_HEADER_SIZE;
+    }
+
+    VERBOSE_LEAVE("retVal = void");
+}
+
+static memory_arena_block_t *_arena_new_block(memory_arena_t *arena, mcl_size_t size)
+{
+    VERBOSE_ENTRY("memory_arena_t *arena = <%p>, mcl_size_t size = <%u>", arena, size)
+
+    memory_arena_block_t *block;
+    memory_arena_block_t **blocks;
+    mcl_size_t index;
+
+    if (arena->block_count == arena->block_capacity)
+    {
+        mcl_size_t capacity = (0 == arena->block_capacity) ? 16 : (2 * arena->block_capacity);
+
+        blocks = _heap_reallocate(arena->category, arena->sorted_blocks, capacity * sizeof(memory_arena_block_t *));
+        if (MCL_NULL == blocks)
+        {
+            VERBOSE_LEAVE("retVal = <%p>", MCL_NULL);
+            return MCL_NULL;
+        }
+
+        arena->sorted_blocks = blocks;
+        arena->block_capacity = capacity;
+    }
+
+    block = _heap_allocate(arena->category, MEMORY_ARENA_ALIGN(sizeof(memory_arena_block_t)) + size);
+    if (MCL_NULL == block)
+    {
+        VERBOSE_LEAVE("retVal = <%p>", MCL_NULL);
+        return MCL_NULL;
+    }
+
+    block->arena = arena;
+    block->size = size;
+    block->used = 0;
+
+    // A block of a large allocation is linked after the current block, so that allocations continue from the current block.
+    if ((arena->block_size != size) && (MCL_NULL != arena->blocks))
+    {
+        block->next = arena->blocks->next;
+        arena->blocks->next = block;
+    }
+    else
+    {
+        block->next = arena->blocks;
+        arena->blocks = block;
+    }
+
+    for (index = arena->block_count; (0 < index) && ((mcl_uint8_t *)arena->sorted_blocks[index - 1] > (mcl_uint8_t *)block); index--)
+    {
+        arena->sorted_blocks[index] = arena->sorted_blocks[index - 1];
+    }
+    arena->sorted_blocks[index] = block;
+    arena->block_count++;
+
+    VERBOSE_LEAVE("retVal = <%p>", block);
+    return block;
+}
+
+static memory_arena_block_t *_arena_find_block(const memory_arena_t *arena, const void *p)
+{
+    VERBOSE_ENTRY("const memory_arena_t *arena = <%p>, const void *p = <%p>", arena, p)
+
+    memory_arena_block_t **blocks = arena->sorted_blocks;
+    mcl_size_t low = 0;
+    mcl_size_t high = arena->block_count;
+    mcl_size_t middle;
+    memory_arena_block_t *block = MCL_NULL;
+
+    // Find the last block starting before p.
+    while (low < high)
+    {
+        middle = low + (high - low) / 2;
+
+        if ((const mcl_uint8_t *)blocks[middle] < (const mcl_uint8_t *)p)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+
+    if ((0 < low) && ((const mcl_uint8_t *)p < (MEMORY_ARENA_BLOCK_DATA(blocks[low - 1]) + blocks[low - 1]->size)))
+    {
+        block = blocks[low - 1];
+    }
+
+    VERBOSE_LEAVE("retVal = <%p>", block);
+    return block;
+}
+
+E_MCL_ERROR_CODE mcl_memory_set_allocator(const mcl_memory_allocator_t *allocator)
+{
+    DEBUG_ENTRY("const mcl_memory_allocator_t *allocator = <%p>", allocator)
+
+    if (MCL_NULL != allocator)
+    {
+        ASSERT_CODE_MESSAGE((MCL_NULL != allocator->malloc_callback) && (MCL_NULL != allocator->realloc_callback) && (MCL_NULL != allocator->free_callback),
+            MCL_TRIGGERED_WITH_NULL, "Functions of the allocator must not be NULL.");
+    }
+
+    MEMORY_TRACKING_LOCK();
+
+    if (MCL_NULL == allocator)
+    {
+        _allocator.malloc_callback = _default_malloc;
+        _allocator.realloc_callback = _default_realloc;
+        _allocator.free_callback = _default_free;
+        _allocator.context = MCL_NULL;
+    }
+    else
+    {
+        _allocator = *allocator;
+    }
+
+    MEMORY_TRACKING_UNLOCK();
+
+    DEBUG_LEAVE("retVal = <%d>", MCL_OK);
+    return MCL_OK;
+}
+
+E_MCL_ERROR_CODE mcl_memory_get_usage(E_MCL_MEMORY_CATEGORY category, mcl_memory_usage_t *usage)
+{
+    DEBUG_ENTRY("E_MCL_MEMORY_CATEGORY category = <%d>, mcl_memory_usage_t *usage = <%p>", category, usage)
+
+    ASSERT_NOT_NULL(usage);
+    ASSERT_CODE_MESSAGE((MCL_MEMORY_CATEGORY_OTHER <= category) && (MCL_MEMORY_CATEGORY_END > category), MCL_INVALID_PARAMETER, "Invalid memory category.");
+
+    MEMORY_TRACKING_LOCK();
+    *usage = _usage[category];
+    MEMORY_TRACKING_UNLOCK();
+
+    DEBUG_LEAVE("retVal = <%d>", MCL_OK);
+    return MCL_OK;
+}
+
+void mcl_memory_free(void *p)
+{
+    DEBUG_ENTRY("void *p = <%p>", p)
+
+    if (MCL_NULL != p)
+    {
+        memory_free(p);
+    }
+
+    DEBUG_LEAVE("retVal = void");
+}
+
+#if (1 == MCL_MEMORY_TELEMETRY)
+E_MCL_ERROR_CODE mcl_memory_get_telemetry(mcl_memory_telemetry_t *telemetry)
+{
+    DEBUG_ENTRY("mcl_memory_telemetry_t *telemetry = <%p>", telemetry)
+
+    ASSERT_NOT_NULL(telemetry);
+
+    MEMORY_TRACKING_LOCK();
+    *telemetry = _telemetry;
+    MEMORY_TRACKING_UNLOCK();
+
+    DEBUG_LEAVE("retVal = <%d>", MCL_OK);
+    return MCL_OK;
+}
+
+E_MCL_ERROR_CODE mcl_memory_get_call_site(mcl_size_t index, mcl_memory_call_site_t *call_site)
+{
+    DEBUG_ENTRY("mcl_size_t index = <%u>, mcl_memory_call_site_t *call_site = <%p>", index, call_site)
+
+    E_MCL_ERROR_CODE code = MCL_INVALID_PARAMETER;
+
+    ASSERT_NOT_NULL(call_site);
+
+    MEMORY_TRACKING_LOCK();
+    if (index < _telemetry.call_site_count)
+    {
+        *call_site = _telemetry_sites[index];
+        code = MCL_OK;
+    }
+    MEMORY_TRACKING_UNLOCK();
+
+    DEBUG_LEAVE("retVal = <%d>", code);
+    return code;
+}
+
+E_MCL_ERROR_CODE mcl_memory_reset_peak(void)
+{
+    DEBUG_ENTRY("void")
+
+    mcl_size_t index;
+
+    MEMORY_TRACKING_LOCK();
+    _telemetry.peak_bytes = _telemetry.current_bytes;
+    for (index = 0; index < _telemetry.call_site_count; index++)
+    {
+        _telemetry_sites[index].peak_bytes = _telemetry_sites[index].current_bytes;
+    }
+    MEMORY_TRACKING_UNLOCK();
+
+    DEBUG_LEAVE("retVal = <%d>", MCL_OK);
+    return MCL_OK;
+}
+
+E_MCL_ERROR_CODE mcl_memory_dump_telemetry(char **json)
+{
+    DEBUG_ENTRY("char **json = <%p>", json)
+
+    mcl_memory_telemetry_t telemetry;
+    mcl_memory_call_site_t *sites;
+    mcl_size_t index;
+    mcl_size_t size;
+    mcl_size_t offset;
+
+    ASSERT_NOT_NULL(json);
+
+    // Call sites are copied so that the json string is written without the lock held. Call sites are never removed, so at least this many are copied.
+    MEMORY_TRACKING_LOCK();
+    size = _telemetry.call_site_count;
+    MEMORY_TRACKING_UNLOCK();
+
+    sites = _heap_allocate(MCL_MEMORY_CATEGORY_OTHER, (size + 1) * sizeof(mcl_memory_call_site_t));
+    ASSERT_CODE_MESSAGE(MCL_NULL != sites, MCL_OUT_OF_MEMORY, "Memory couldn't be allocated for call sites.");
+
+    MEMORY_TRACKING_LOCK();
+    telemetry = _telemetry;
+    telemetry.call_site_count = size;
+    memcpy(sites, _telemetry_sites, size * sizeof(mcl_memory_call_site_t));
+    MEMORY_TRACKING_UNLOCK();
+
+    // Each number takes at most 20 digits.
+    size = sizeof(MEMORY_TELEMETRY_JSON_FORMAT) + (5 * 20);
+    for (index = 0; index < telemetry.call_site_count; index++)
+    {
+        size += sizeof(MEMORY_TELEMETRY_CALL_SITE_JSON_FORMAT) + strlen(sites[index].function) + (7 * 20);
+    }
+
+    *json = MCL_MALLOC(size);
+    if (MCL_NULL == *json)
+    {
+        _heap_release(sites);
+        MCL_ERROR_RETURN(MCL_OUT_OF_MEMORY, "Memory couldn't be allocated for json string.");
+    }
+
+    offset = snprintf(*json, size, MEMORY_TELEMETRY_JSON_FORMAT, (unsigned long long)telemetry.current_bytes, (unsigned long long)telemetry.peak_bytes,
+        (unsigned long long)telemetry.current_count, (unsigned long long)telemetry.allocation_count, (unsigned long long)telemetry.call_site_count);
+
+    for (index = 0; index < telemetry.call_site_count; index++)
+    {
+        offset += snprintf(*json + offset, size - offset, MEMORY_TELEMETRY_CALL_SITE_JSON_FORMAT, (0 == index) ? "" : ",", sites[index].function,
+            (unsigned long long)sites[index].line, (unsigned long long)sites[index].current_bytes, (unsigned long long)sites[index].peak_bytes,
+            (unsigned long long)sites[index].current_count, (unsigned long long)sites[index].allocation_count, (unsigned long long)sites[index].total_bytes,
+            (unsigned long long)sites[index].largest_size);
+    }
+    snprintf(*json + offset, size - offset, "]}");
+
+    _heap_release(sites);
+
+    DEBUG_LEAVE("retVal = <%d>", MCL_OK);
+    return MCL_OK;
+}
+#else
+E_MCL_ERROR_CODE mcl_memory_get_telemetry(mcl_memory_telemetry_t *telemetry)
+{
+    DEBUG_ENTRY("mcl_memory_telemetry_t *telemetry = <%p>", telemetry)
+
+    MCL_ERROR_RETURN(MCL_OPERATION_IS_NOT_SUPPORTED, "MCL is not built with memory telemetry.");
+}
+
+E_MCL_ERROR_CODE mcl_memory_get_call_site(mcl_size_t index, mcl_memory_call_site_t *call_site)
+{
+    DEBUG_ENTRY("mcl_size_t index = <%u>, mcl_memory_call_site_t *call_site = <%p>", index, call_site)
+
+    MCL_ERROR_RETURN(MCL_OPERATION_IS_NOT_SUPPORTED, "MCL is not built with memory telemetry.");
+}
+
+E_MCL_ERROR_CODE mcl_memory_reset_peak(void)
+{
+    DEBUG_ENTRY("void")
+
+    MCL_ERROR_RETURN(MCL_OPERATION_IS_NOT_SUPPORTED, "MCL is not built with memory telemetry.");
+}
+
+E_MCL_ERROR_CODE mcl_memory_dump_telemetry(char **json)
+{
+    DEBUG_ENTRY("char **json = <%p>", json)
+
+    MCL_ERROR_RETURN(MCL_OPERATION_IS_NOT_SUPPORTED, "MCL is not built with memory telemetry.");
+}
+#endif
+
+static void *_default_malloc(void *context, mcl_size_t size)
+{
+    return malloc(size);
+}
+
+static void *_default_realloc(void *context, void *p, mcl_size_t size)
+{
+    return realloc(p, size);
+}
+
+static void _default_free(void *context, void *p)
+{
+    free(p);
+}
+
+static void *_heap_allocate(E_MCL_MEMORY_CATEGORY category, mcl_size_t size)
+{
+    VERBOSE_ENTRY("E_MCL_MEMORY_CATEGORY category = <%d>, mcl_size_t size = <%u>", category, size)
+
+    void *p = _allocator.malloc_callback(_allocator.context, size);
+
+    if (MCL_NULL != p)
+    {
+        E_MCL_ERROR_CODE code;
+
+        MEMORY_TRACKING_LOCK();
+        code = _tracking_add(p, size, category);
+        MEMORY_TRACKING_UNLOCK();
+
+        if (MCL_OK != code)
+        {
+            _allocator.free_callback(_allocator.context, p);
+            p = MCL_NULL;
+        }
+    }
+
+    VERBOSE_LEAVE("retVal = <%p>", p);
+    return p;
+}
+
+static void *_heap_reallocate(E_MCL_MEMORY_CATEGORY category, void *p, mcl_size_t size)
+{
+    VERBOSE_ENTRY("E_MCL_MEMORY_CATEGORY category = <%d>, void *p = <%p>, mcl_size_t size = <%u>", category, p, size)
+
+    void *new_p;
+    mcl_size_t index;
+
+    if (MCL_NULL == p)
+    {
+        new_p = _heap_allocate(category, size);
+        VERBOSE_LEAVE("retVal = <%p>", new_p);
+        return new_p;
+    }
+
+    // Entry of the old address is looked up before the allocator can give that address to another thread.
+    MEMORY_TRACKING_LOCK();
+    if (0 != _tracking_capacity)
+    {
+        for (index = MEMORY_TRACKING_INDEX(p, _tracking_capacity - 1); MCL_NULL != _tracking_entries[index].p; index = (index + 1) & (_tracking_capacity - 1))
+        {
+            if (p == _tracking_entries[index].p)
+            {
+                category = _tracking_entries[index].category;
+                break;
+            }
+        }
+    }
+    MEMORY_TRACKING_UNLOCK();
+
+    new_p = _allocator.realloc_callback(_allocator.context, p, size);
+
+    if (MCL_NULL != new_p)
+    {
+        E_MCL_ERROR_CODE code;
+
+        MEMORY_TRACKING_LOCK();
+        _tracking_remove(p);
+        code = _tracking_add(new_p, size, category);
+        MEMORY_TRACKING_UNLOCK();
+
+        // Resized memory stays valid but is not accounted if the table of tracked allocations can not grow.
+        if (MCL_OK != code)
+        {
+            MCL_VERBOSE("Resized memory could not be tracked.");
+        }
+    }
+
+    VERBOSE_LEAVE("retVal = <%p>", new_p);
+    return new_p;
+}
+
+static void _heap_release(void *p)
+{
+    VERBOSE_ENTRY("void *p = <%p>", p)
+
+    if (MCL_NULL != p)
+    {
+        MEMORY_TRACKING_LOCK();
+        _tracking_remove(p);
+        MEMORY_TRACKING_UNLOCK();
+
+        _allocator.free_callback(_allocator.context, p);
+    }
+
+    VERBOSE_LEAVE("retVal = void");
+}
+
+static mcl_size_t _tracking_hash(const void *p)
+{
+    mcl_size_t hash = (mcl_size_t)p >> 4;
+
+    hash ^= hash >> 16;
+    hash *= 0x45d9f3b;
+    hash ^= hash >> 16;
+
+    return hash;
+}
+
+static E_MCL_ERROR_CODE _tracking_add(const void *p, mcl_size_t size, E_MCL_MEMORY_CATEGORY category)
+{
+    mcl_size_t index;
+
+    // Other threads may use the table while the lock is released to grow it, so the table is checked again after it has grown.
+    while ((_tracking_count + 1) * 2 > _tracking_capacity)
+    {
+        mcl_size_t capacity = (0 == _tracking_capacity) ? MEMORY_TRACKING_INITIAL_CAPACITY : (2 * _tracking_capacity);
+        memory_tracking_entry_t *entries = _table_allocate(capacity * sizeof(memory_tracking_entry_t));
+
+        if (MCL_NULL == entries)
+        {
+            return MCL_OUT_OF_MEMORY;
+        }
+
+        // The table is replaced unless another thread has grown it meanwhile, the table which is not used any more is released.
+        if (capacity > _tracking_capacity)
+        {
+            memory_tracking_entry_t *old_entries = _tracking_entries;
+            mcl_size_t old_capacity = _tracking_capacity;
+
+            memset(entries, 0, capacity * sizeof(memory_tracking_entry_t));
+
+            for (index = 0; index < old_capacity; index++)
+            {
+                if (MCL_NULL != old_entries[index].p)
+                {
+                    mcl_size_t new_index = MEMORY_TRACKING_INDEX(old_entries[index].p, capacity - 1);
+
+                    while (MCL_NULL != entries[new_index].p)
+                    {
+                        new_index = (new_index + 1) & (capacity - 1);
+                    }
+                    entries[new_index] = old_entries[index];
+                }
+            }
+
+            _tracking_entries = entries;
+            _tracking_capacity = capacity;
+            entries = old_entries;
+            capacity = old_capacity;
+        }
+
+        _table_release(entries, capacity * sizeof(memory_tracking_entry_t));
+    }
+
+    for (index = MEMORY_TRACKING_INDEX(p, _tracking_capacity - 1); MCL_NULL != _tracking_entries[index].p; index = (index + 1) & (_tracking_capacity - 1))
+    {
+        if (p == _tracking_entries[index].p)
+        {
+            break;
+        }
+    }
+
+    if (MCL_NULL != _tracking_entries[index].p)
+    {
+        _usage[_tracking_entries[index].category].bytes -= _tracking_entries[index].size;
+        _usage[_tracking_entries[index].category].count--;
+    }
+    else
+    {
+        _tracking_count++;
+    }
+
+    _tracking_entries[index].p = p;
+    _tracking_entries[index].size = size;
+    _tracking_entries[index].category = category;
+    _usage[category].bytes += size;
+    _usage[category].count++;
+
+    return MCL_OK;
+}
+
+static void _tracking_remove(const void *p)
+{
+    mcl_size_t mask = _tracking_capacity - 1;
+    mcl_size_t index;
+    mcl_size_t next;
+
+    if (0 == _tracking_capacity)
+    {
+        return;
+    }
+
+    for (index = MEMORY_TRACKING_INDEX(p, mask); p != _tracking_entries[index].p; index = (index + 1) & mask)
+    {
+        if (MCL_NULL == _tracking_entries[index].p)
+        {
+            // Memory allocated without MCL's knowledge, e.g. a buffer given by the user.
+            return;
+        }
+    }
+
+    _usage[_tracking_entries[index].category].bytes -= _tracking_entries[index].size;
+    _usage[_tracking_entries[index].category].count--;
+    _tracking_count--;
+
+    // Following entries of the cluster are shifted back, so that no entry is separated from its home index by an empty slot.
+    for (next = (index + 1) & mask; MCL_NULL != _tracking_entries[next].p; next = (next + 1) & mask)
+    {
+        mcl_size_t home = MEMORY_TRACKING_INDEX(_tracking_entries[next].p, mask);
+
+        if (((next - home) & mask) >= ((next - index) & mask))
+        {
+            _tracking_entries[index] = _tracking_entries[next];
+            index = next;
+        }
+    }
+    _tracking_entries[index].p = MCL_NULL;
+}
+
+static void *_table_allocate(mcl_size_t size)
+{
+    void *p;
+
+    MEMORY_TRACKING_UNLOCK();
+    p = _allocator.malloc_callback(_allocator.context, size);
+    MEMORY_TRACKING_LOCK();
+
+    if (MCL_NULL != p)
+    {
+        _usage[MCL_MEMORY_CATEGORY_OTHER].bytes += size;
+        _usage[MCL_MEMORY_CATEGORY_OTHER].count++;
+    }
+
+    return p;
+}
+
+static void _table_release(void *p, mcl_size_t size)
+{
+    if (MCL_NULL != p)
+    {
+        _usage[MCL_MEMORY_CATEGORY_OTHER].bytes -= size;
+        _usage[MCL_MEMORY_CATEGORY_OTHER].count--;
+
+        MEMORY_TRACKING_UNLOCK();
+        _allocator.free_callback(_allocator.context, p);
+        MEMORY_TRACKING_LOCK();
+    }
+}
+
+#if (1 == MCL_MEMORY_TELEMETRY)
+static void _telemetry_record(const void *p, mcl_size_t size, const char *function, unsigned line)
+{
+    mcl_size_t site;
+    mcl_size_t index;
+    mcl_memory_call_site_t *call_site;
+
+    if (MCL_NULL == p)
+    {
+        return;
+    }
+
+    MEMORY_TRACKING_LOCK();
+
+    site = _telemetry_find_site(function, line);
+
+    // Table is grown as the table of tracked allocations, see _tracking_add().
+    while ((MCL_SIZE_MAX != site) && ((_telemetry_count + 1) * 2 > _telemetry_capacity))
+    {
+        mcl_size_t capacity = (0 == _telemetry_capacity) ? MEMORY_TELEMETRY_INITIAL_CAPACITY : (2 * _telemetry_capacity);
+        memory_telemetry_entry_t *entries = _table_allocate(capacity * sizeof(memory_telemetry_entry_t));
+
+        if (MCL_NULL == entries)
+        {
+            site = MCL_SIZE_MAX;
+        }
+        else
+        {
+            if (capacity > _telemetry_capacity)
+            {
+                memory_telemetry_entry_t *old_entries = _telemetry_entries;
+                mcl_size_t old_capacity = _telemetry_capacity;
+
+                memset(entries, 0, capacity * sizeof(memory_telemetry_entry_t));
+
+                for (index = 0; index < old_capacity; index++)
+                {
+                    if (MCL_NULL != old_entries[index].p)
+                    {
+                        mcl_size_t new_index = MEMORY_TRACKING_INDEX(old_entries[index].p, capacity - 1);
+
+                        while (MCL_NULL != entries[new_index].p)
+                        {
+                            new_index = (new_index + 1) & (capacity - 1);
+                        }
+                        entries[new_index] = old_entries[index];
+                    }
+                }
+
+                _telemetry_entries = entries;
+                _telemetry_capacity = capacity;
+                entries = old_entries;
+                capacity = old_capacity;
+            }
+
+            _table_release(entries, capacity * sizeof(memory_telemetry_entry_t));
+        }
+    }
+
+    // Allocation is left out of the telemetry if the tables can not grow.
+    if (MCL_SIZE_MAX != site)
+    {
+        for (index = MEMORY_TRACKING_INDEX(p, _telemetry_capacity - 1); MCL_NULL != _telemetry_entries[index].p; index = (index + 1) & (_telemetry_capacity - 1))
+        {
+            if (p == _telemetry_entries[index].p)
+            {
+                // Entry left for the same address by memory released without MCL's knowledge.
+                _telemetry_remove_at(index);
+                break;
+            }
+        }
+
+        for (index = MEMORY_TRACKING_INDEX(p, _telemetry_capacity - 1); MCL_NULL != _telemetry_entries[index].p; index = (index + 1) & (_telemetry_capacity - 1))
+        {
+        }
+
+        _telemetry_entries[index].p = p;
+        _telemetry_entries[index].size = size;
+        _telemetry_entries[index].site = site;
+        _telemetry_count++;
+
+        call_site = &_telemetry_sites[site];
+        call_site->current_bytes += size;
+        call_site->current_count++;
+        call_site->allocation_count++;
+        call_site->total_bytes += size;
+        if (call_site->largest_size < size)
+        {
+            call_site->largest_size = size;
+        }
+        if (call_site->peak_bytes < call_site->current_bytes)
+        {
+            call_site->peak_bytes = call_site->current_bytes;
+        }
+
+        _telemetry.current_bytes += size;
+        _telemetry.current_count++;
+        _telemetry.allocation_count++;
+        if (_telemetry.peak_bytes < _telemetry.current_bytes)
+        {
+            _telemetry.peak_bytes = _telemetry.current_bytes;
+        }
+    }
+
+    MEMORY_TRACKING_UNLOCK();
+}
+
+static mcl_size_t _telemetry_forget(const void *p)
+{
+    mcl_size_t size = 0;
+    mcl_size_t index;
+
+    if (MCL_NULL == p)
+    {
+        return 0;
+    }
+
+    MEMORY_TRACKING_LOCK();
+
+    if (0 != _telemetry_capacity)
+    {
+        for (index = MEMORY_TRACKING_INDEX(p, _telemetry_capacity - 1); MCL_NULL != _telemetry_entries[index].p; index = (index + 1) & (_telemetry_capacity - 1))
+        {
+            if (p == _telemetry_entries[index].p)
+            {
+                size = _telemetry_entries[index].size;
+                _telemetry_remove_at(index);
+                break;
+            }
+        }
+    }
+
+    MEMORY_TRACKING_UNLOCK();
+
+    return size;
+}
+
+static void _telemetry_forget_arena(memory_arena_t *arena)
+{
+    mcl_size_t index = 0;
+
+    MEMORY_TRACKING_LOCK();
+
+    // An entry shifted back into the slot of a removed entry is checked before moving on.
+    while (index < _telemetry_capacity)
+    {
+        if ((MCL_NULL != _telemetry_entries[index].p) && (MCL_NULL != _arena_find_block(arena, _telemetry_entries[index].p)))
+        {
+            _telemetry_remove_at(index);
+        }
+        else
+        {
+            index++;
+        }
+    }
+
+    MEMORY_TRACKING_UNLOCK();
+}
+
+static mcl_size_t _telemetry_find_site(const char *function, unsigned line)
+{
+    mcl_size_t hash = _tracking_hash(function) ^ (line * 0x9e3779b1u);
+    mcl_size_t mask;
+    mcl_size_t index;
+
+    // Other threads may add call sites while the lock is released to grow the tables, so the call site is looked up again after they have grown.
+    for (;;)
+    {
+        mask = (2 * _telemetry_site_capacity) - 1;
+
+        if (0 != _telemetry_site_capacity)
+        {
+            for (index = hash & mask; 0 != _telemetry_site_slots[index]; index = (index + 1) & mask)
+            {
+                mcl_memory_call_site_t *call_site = &_telemetry_sites[_telemetry_site_slots[index] - 1];
+
+                if ((function == call_site->function) && (line == call_site->line))
+                {
+                    return _telemetry_site_slots[index] - 1;
+                }
+            }
+        }
+
+        if (_telemetry.call_site_count < _telemetry_site_capacity)
+        {
+            break;
+        }
+
+        if (MCL_OK != _telemetry_grow_sites())
+        {
+            return MCL_SIZE_MAX;
+        }
+    }
+
+    for (index = hash & mask; 0 != _telemetry_site_slots[index]; index = (index + 1) & mask)
+    {
+    }
+
+    memset(&_telemetry_sites[_telemetry.call_site_count], 0, sizeof(mcl_memory_call_site_t));
+    _telemetry_sites[_telemetry.call_site_count].function = function;
+    _telemetry_sites[_telemetry.call_site_count].line = line;
+    _telemetry_site_slots[index] = ++_telemetry.call_site_count;
+
+    return _telemetry.call_site_count - 1;
+}
+
+static E_MCL_ERROR_CODE _telemetry_grow_sites(void)
+{
+    mcl_size_t capacity = (0 == _telemetry_site_capacity) ? MEMORY_TELEMETRY_INITIAL_SITE_CAPACITY : (2 * _telemetry_site_capacity);
+    mcl_memory_call_site_t *sites = _table_allocate(capacity * sizeof(mcl_memory_call_site_t));
+    mcl_size_t *slots = (MCL_NULL == sites) ? MCL_NULL : _table_allocate(2 * capacity * sizeof(mcl_size_t));
+    mcl_size_t mask = (2 * capacity) - 1;
+    mcl_size_t index;
+
+    if (MCL_NULL == slots)
+    {
+        _table_release(sites, capacity * sizeof(mcl_memory_call_site_t));
+        return MCL_OUT_OF_MEMORY;
+    }
+
+    // Tables are replaced unless another thread has grown them meanwhile, the tables which are not used any more are released.
+    if (capacity > _telemetry_site_capacity)
+    {
+        mcl_memory_call_site_t *old_sites = _telemetry_sites;
+        mcl_size_t *old_slots = _telemetry_site_slots;
+        mcl_size_t old_capacity = _telemetry_site_capacity;
+
+        if (0 != _telemetry.call_site_count)
+        {
+            memcpy(sites, old_sites, _telemetry.call_site_count * sizeof(mcl_memory_call_site_t));
+        }
+        memset(slots, 0, 2 * capacity * sizeof(mcl_size_t));
+
+        for (index = 0; index < _telemetry.call_site_count; index++)
+        {
+            mcl_size_t slot = (_tracking_hash(sites[index].function) ^ (sites[index].line * 0x9e3779b1u)) & mask;
+
+            while (0 != slots[slot])
+            {
+                slot = (slot + 1) & mask;
+            }
+            slots[slot] = index + 1;
+        }
+
+        _telemetry_sites = sites;
+        _telemetry_site_slots = slots;
+        _telemetry_site_capacity = capacity;
+        sites = old_sites;
+        slots = old_slots;
+        capacity = old_capacity;
+    }
+
+    _table_release(sites, capacity * sizeof(mcl_memory_call_site_t));
+    _table_release(slots, 2 * capacity * sizeof(mcl_size_t));
+
+    return MCL_OK;
+}
+
+static void _telemetry_remove_at(mcl_size_t index)
+{
+    mcl_size_t mask = _telemetry_capacity - 1;
+    mcl_size_t next;
+    mcl_memory_call_site_t *call_site = &_telemetry_sites[_telemetry_entries[index].site];
+
+    call_site->current_bytes -= _telemetry_entries[index].size;
+    call_site->current_count--;
+    _telemetry.current_bytes -= _telemetry_entries[index].size;
+    _telemetry.current_count--;
+    _telemetry_count--;
+
+    // Following entries of the cluster are shifted back as in the table of tracked allocations.
+    for (next = (index + 1) & mask; MCL_NULL != _telemetry_entries[next].p; next = (next + 1) & mask)
+    {
+        mcl_size_t home = MEMORY_TRACKING_INDEX(_telemetry_entries[next].p, mask);
+
+        if (((next - home) & mask) >= ((next - index) & mask))
+        {
+            _telemetry_entries[index] = _telemetry_entries[next];
+            index = next;
+        }
+    }
+    _telemetry_entries[index].p = MCL_NULL;
+}
+#endif
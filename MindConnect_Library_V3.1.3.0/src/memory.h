@@ -17,38 +17,51 @@
 #define MEMORY_H_
 
 #include "mcl/mcl_common.h"
+#include "mcl/mcl_memory.h"
+
+/**
+ * @brief Category which memory allocated by a module with the memory macros is accounted to.
+ *
+ * Modules define it before including any header, memory of modules which do not define it is accounted to #MCL_MEMORY_CATEGORY_OTHER.
+ */
+#ifndef MEMORY_CATEGORY
+#define MEMORY_CATEGORY MCL_MEMORY_CATEGORY_OTHER
+#endif
 
 /**
  * This function is called to allocate memory. @see #memory_malloc() for more details.
  *
  * @param bytes Size of the space to be allocated.
+ * @param category Category which the memory is accounted to. Gathered with #MEMORY_CATEGORY macro.
  * @param function The name of the calling function. Gathered with __FUNCTION__ macro.
  * @param line The line of the calling function. Gathered with __LINE__ macro.
  * @return Pointer to the allocated memory space.
  */
-void *memory_allocate(mcl_size_t bytes, const char *function, unsigned line);
+void *memory_allocate(mcl_size_t bytes, E_MCL_MEMORY_CATEGORY category, const char *function, unsigned line);
 
 /**
  * This function is called to allocate memory and initialize it with zero. @see #memory_calloc() for more details.
  *
  * @param count Count of the object to be created. Total memory space will be (@p count*@p bytes)
  * @param bytes Size of the space to be allocated.
+ * @param category Category which the memory is accounted to. Gathered with #MEMORY_CATEGORY macro.
  * @param function The name of the calling function. Gathered with __FUNCTION__ macro.
  * @param line The line of the calling function. Gathered with __LINE__ macro.
  * @return Pointer to the allocated memory space.
  */
-void *memory_allocate_with_zero(mcl_size_t count, mcl_size_t bytes, const char *function, unsigned line);
+void *memory_allocate_with_zero(mcl_size_t count, mcl_size_t bytes, E_MCL_MEMORY_CATEGORY category, const char *function, unsigned line);
 
 /**
  * This function is called to reallocate memory. @see #memory_realloc() for more details.
  *
  * @param p The pointer to be reallocated.
  * @param bytes Size of the space to be allocated.
+ * @param category Category which the memory is accounted to if @p p is NULL. Gathered with #MEMORY_CATEGORY macro.
  * @param function The name of the calling function. Gathered with __FUNCTION__ macro.
  * @param line The line of the calling function. Gathered with __LINE__ macro.
  * @return Pointer to the reallocated memory space.
  */
-void *memory_reallocate(void *p, mcl_size_t bytes, const char *function, unsigned line);
+void *memory_reallocate(void *p, mcl_size_t bytes, E_MCL_MEMORY_CATEGORY category, const char *function, unsigned line);
 
 /**
  * This function is called to free memory. @see #memory_free() for more details.
@@ -62,7 +75,7 @@ void memory_release(void *p, const char *function, unsigned line);
 /**
  * @brief malloc wrapper
  *
- * If stddef.h is exists it uses the malloc function. If another implementation will be needed it can be added.
+ * Allocates with the allocator set by #mcl_memory_set_allocator() and accounts the memory to #MCL_MEMORY_CATEGORY_OTHER.
  *
  * @param size Size of the space to be allocated.
  * @return Pointer to the allocated memory space.
@@ -72,7 +85,7 @@ void *memory_malloc(mcl_size_t size);
 /**
  * @brief calloc wrapper
  *
- * If stddef.h is exists in the system it uses the calloc function. If another implementation will be needed it can be added.
+ * Allocates with the allocator set by #mcl_memory_set_allocator() and accounts the memory to #MCL_MEMORY_CATEGORY_OTHER.
  *
  * @param count Count of the object to be created. Total memory space will be (@p count*@p bytes)
  * @param bytes Size of the space to be allocated.
@@ -83,7 +96,7 @@ void *memory_calloc(mcl_size_t count, mcl_size_t bytes);
 /**
  * @brief realloc wrapper
  *
- * If stddef.h is exists in the system it uses the realloc function. If another implementation will be needed it can be added.
+ * Resizes with the allocator set by #mcl_memory_set_allocator(), new memory is accounted to #MCL_MEMORY_CATEGORY_OTHER.
  *
  * @param p The pointer to be reallocated.
  * @param bytes Size of the space to be allocated.
@@ -94,12 +107,170 @@ void *memory_realloc(void *p, mcl_size_t bytes);
 /**
  * @brief free wrapper
  *
- * If stddef.h is exists in the system it uses the free function. If another implementation will be needed it can be added.
+ * Releases with the allocator set by #mcl_memory_set_allocator().
  *
  * @param p The pointer to be freed.
  */
 void memory_free(void *p);
 
+/**
+ * @brief malloc wrapper accounting the memory to the given category, used as allocation hook of third party libraries.
+ *
+ * Memory is always allocated from the heap, never from the current arena.
+ *
+ * @param category Category which the memory is accounted to.
+ * @param size Size of the space to be allocated.
+ * @return Pointer to the allocated memory space.
+ */
+void *memory_category_malloc(E_MCL_MEMORY_CATEGORY category, mcl_size_t size);
+
+/**
+ * @brief calloc wrapper accounting the memory to the given category, used as allocation hook of third party libraries.
+ *
+ * Memory is always allocated from the heap, never from the current arena.
+ *
+ * @param category Category which the memory is accounted to.
+ * @param count Count of the object to be created. Total memory space will be (@p count*@p bytes)
+ * @param bytes Size of the space to be allocated.
+ * @return Pointer to the allocated memory space.
+ */
+void *memory_category_calloc(E_MCL_MEMORY_CATEGORY category, mcl_size_t count, mcl_size_t bytes);
+
+/**
+ * @brief realloc wrapper accounting new memory to the given category, used as allocation hook of third party libraries.
+ *
+ * Memory is always allocated from the heap, never from the current arena.
+ *
+ * @param category Category which the memory is accounted to if @p p is NULL.
+ * @param p The pointer to be reallocated.
+ * @param bytes Size of the space to be allocated.
+ * @return Pointer to the reallocated memory space.
+ */
+void *memory_category_realloc(E_MCL_MEMORY_CATEGORY category, void *p, mcl_size_t bytes);
+
+/**
+ * @brief Objects up to this size are allocated from the pools by #memory_pool_allocate(), larger ones from the heap.
+ */
+#define MEMORY_POOL_MAX_OBJECT_SIZE 64
+
+/**
+ * This function is called to allocate a small fixed size object such as a list node or a string handle.
+ *
+ * Objects are allocated from size classes of 8 bytes, carved out of slabs which are shared by all threads. Each object keeps
+ * a pointer to its slab, so that it returns to its slab whichever thread releases it. Each category has slabs of its own which
+ * are accounted to it, and a slab is returned to the heap once all its objects are released unless it is the last one of its pool.
+ * If an arena is the current arena, the object is allocated from the arena instead.
+ *
+ * @param bytes Size of the object.
+ * @param category Category which the object is accounted to. Gathered with #MEMORY_CATEGORY macro.
+ * @param function The name of the calling function. Gathered with __FUNCTION__ macro.
+ * @param line The line of the calling function. Gathered with __LINE__ macro.
+ * @return Pointer to the allocated object.
+ */
+void *memory_pool_allocate(mcl_size_t bytes, E_MCL_MEMORY_CATEGORY category, const char *function, unsigned line);
+
+/**
+ * This function is called to release an object allocated by #memory_pool_allocate().
+ *
+ * Objects allocated by #memory_pool_allocate() must not be released with #memory_release(). The object may be released by
+ * a thread other than the one which allocated it.
+ *
+ * @param p The object to be released.
+ * @param bytes Size of the object, same as the one given to #memory_pool_allocate().
+ * @param function The name of the calling function. Gathered with __FUNCTION__ macro.
+ * @param line The line of the calling function. Gathered with __LINE__ macro.
+ */
+void memory_pool_release(void *p, mcl_size_t bytes, const char *function, unsigned line);
+
+/**
+ * @brief Block of memory which allocations of an arena are made from. Allocations start after the block header.
+ */
+typedef struct memory_arena_block_t
+{
+    struct memory_arena_block_t *next; //!< Next block of the arena.
+    struct memory_arena_t *arena;      //!< Arena which the block belongs to.
+    mcl_size_t size;                   //!< Size of the space for allocations in the block.
+    mcl_size_t used;                   //!< Size of the space used by allocations.
+} memory_arena_block_t;
+
+/**
+ * @brief Arena handle.
+ *
+ * Each thread has a current arena of its own. While an arena is the current arena of a thread, #memory_malloc(), #memory_calloc() and
+ * #memory_realloc() of a NULL pointer called by that thread allocate from it. Allocation hooks of third party libraries (#memory_category_malloc() etc.)
+ * never allocate from it, since those libraries keep their memory beyond the scope the arena is current in. #memory_free() and #memory_realloc() look for the memory only
+ * in the current arena, so memory of an arena must be released or resized while its arena is current, otherwise it is taken as memory of
+ * the heap. Objects of #memory_pool_allocate() keep their arena and can be released while their arena is not current.
+ * #memory_free() of memory in an arena releases it only if it is the last allocation of its block, otherwise the memory is kept until
+ * the arena is reset or destroyed. An arena is not synchronized, so it must be used by one thread at a time.
+ */
+typedef struct memory_arena_t
+{
+    memory_arena_block_t *blocks;         //!< Blocks of the arena, allocations are made from the first one.
+    memory_arena_block_t **sorted_blocks; //!< Blocks of the arena sorted by address, so that the block of a pointer can be found by binary search.
+    mcl_size_t block_count;               //!< Number of blocks of the arena.
+    mcl_size_t block_capacity;            //!< Capacity of @p sorted_blocks.
+    mcl_size_t block_size;                //!< Size of the space for allocations in a block. Larger allocations get a block of their own.
+    E_MCL_MEMORY_CATEGORY category;       //!< Category which the blocks of the arena are accounted to.
+} memory_arena_t;
+
+/**
+ * @brief Initial size of the space for allocations in a block of an arena.
+ */
+#define DEFAULT_MEMORY_ARENA_BLOCK_SIZE (64 * 1024)
+
+/**
+ * @brief Initializes an empty arena. Blocks are allocated when the first allocation is made from the arena.
+ *
+ * @param [in] block_size Size of the space for allocations in a block. #DEFAULT_MEMORY_ARENA_BLOCK_SIZE is used if zero.
+ * @param [in] category Category which the arena and its blocks are accounted to.
+ * @param [out] arena Initialized arena handle.
+ * @return
+ * <ul>
+ * <li>#MCL_OK in case of success.</li>
+ * <li>#MCL_OUT_OF_MEMORY in case there is not enough memory in the system to proceed.</li>
+ * </ul>
+ */
+E_MCL_ERROR_CODE memory_arena_initialize(mcl_size_t block_size, E_MCL_MEMORY_CATEGORY category, memory_arena_t **arena);
+
+/**
+ * @brief Sets the arena which memory is allocated from by the calling thread.
+ *
+ * @param [in] arena Arena to allocate memory from, NULL to allocate memory from the heap.
+ * @return Previous current arena to be set again when allocations from @p arena are completed.
+ */
+memory_arena_t *memory_arena_set_current(memory_arena_t *arena);
+
+/**
+ * @brief Returns the arena which memory is allocated from by the calling thread.
+ *
+ * @return Current arena of the calling thread, NULL if memory is allocated from the heap.
+ */
+memory_arena_t *memory_arena_get_current(void);
+
+/**
+ * @brief Checks if @p p is allocated from @p arena.
+ *
+ * @param [in] arena Arena to be searched, may be NULL.
+ * @param [in] p Pointer to be looked up.
+ * @return #MCL_TRUE if @p p is allocated from @p arena, #MCL_FALSE otherwise.
+ */
+mcl_bool_t memory_arena_contains(const memory_arena_t *arena, const void *p);
+
+/**
+ * @brief Releases all blocks of the arena at once. Memory allocated from the arena must not be used afterwards.
+ *
+ * @param [in] arena Arena to reset.
+ */
+void memory_arena_reset(memory_arena_t *arena);
+
+/**
+ * @brief Releases all blocks of the arena and the arena itself.
+ *
+ * @param [in] arena Arena handle to destroy.
+ */
+void memory_arena_destroy(memory_arena_t **arena);
+
 /*
  * Usage examples for memory macros :
  * char *buf = MCL_MALLOC(100);
@@ -116,12 +287,29 @@ void memory_free(void *p);
  * --
  *
  * MCL_FREE(demo);
+ *
+ * --
+ *
+ * list_node_t *node;
+ * MCL_POOL_NEW(node);
+ * MCL_POOL_FREE(node);
  */
-#define MCL_MALLOC(bytes) memory_allocate(bytes,  __FUNCTION__, __LINE__)
+#define MCL_MALLOC(bytes) memory_allocate(bytes, MEMORY_CATEGORY, __FUNCTION__, __LINE__)
 #define MCL_NEW(p) ((p) = MCL_MALLOC((long)sizeof (*p)))
-#define MCL_CALLOC(count, bytes) memory_allocate_with_zero(count, bytes,  __FUNCTION__, __LINE__)
+#define MCL_CALLOC(count, bytes) memory_allocate_with_zero(count, bytes, MEMORY_CATEGORY, __FUNCTION__, __LINE__)
 #define MCL_NEW_WITH_ZERO(p) ((p) = MCL_CALLOC(1, (long)sizeof *(p)))
-#define MCL_RESIZE(p, bytes) ((p) = memory_reallocate(p, bytes, __FUNCTION__, __LINE__))
+#define MCL_RESIZE(p, bytes) ((p) = memory_reallocate(p, bytes, MEMORY_CATEGORY, __FUNCTION__, __LINE__))
 #define MCL_FREE(p) ((void)(memory_release((p), __FUNCTION__, (mcl_uint32_t)__LINE__), (p) = MCL_NULL))
+#define MCL_POOL_NEW(p) ((p) = memory_pool_allocate(sizeof(*(p)), MEMORY_CATEGORY, __FUNCTION__, __LINE__))
+#define MCL_POOL_FREE(p) ((void)(memory_pool_release((p), sizeof(*(p)), __FUNCTION__, (mcl_uint32_t)__LINE__), (p) = MCL_NULL))
+
+/*
+ * Common modules allocate memory for the category of their caller with the following macros :
+ * string->buffer = MCL_CATEGORY_MALLOC(length + 1, string->category);
+ */
+#define MCL_CATEGORY_MALLOC(bytes, category) memory_allocate(bytes, category, __FUNCTION__, __LINE__)
+#define MCL_CATEGORY_CALLOC(count, bytes, category) memory_allocate_with_zero(count, bytes, category, __FUNCTION__, __LINE__)
+#define MCL_CATEGORY_NEW(p, category) ((p) = MCL_CATEGORY_MALLOC((long)sizeof (*p), category))
+#define MCL_CATEGORY_POOL_NEW(p, category) ((p) = memory_pool_allocate(sizeof(*(p)), category, __FUNCTION__, __LINE__))
 
 #endif //MCL_MEMORY_H_
@@ -11,10 +11,13 @@
 *
 ************************************************************************/
 
+#define MEMORY_CATEGORY MCL_MEMORY_CATEGORY_SECURITY
+
 #include "random.h"
 #include "mcl/mcl_random.h"
 #include "memory.h"
 #include "security.h"
+#include "string_util.h"
 #include "definitions.h"
 #include "log_util.h"
 
@@ -22,22 +25,10 @@
 #include <stdlib.h>
 #endif
 
-#define GUID_LENGTH 36
-
-typedef union guid_t
-{
-    struct
-    {
-        mcl_uint32_t time_low;            //!< Lowest significant 32 bits of time.
-        mcl_uint16_t time_mid;            //!< Middle 16 bits of time.
-        mcl_uint16_t time_hi_and_version; //!< Version followed by 12 highest significant bits of time.
-        mcl_uint8_t clk_seq_hi_res;       //!< Variant followed by highest bits of clock sequence.
-        mcl_uint8_t clk_seq_low;          //!< Lowest significant bits of clock sequence.
-        mcl_uint8_t node[6];              //!< Node ID.
-    };
+// Number of random bytes in a GUID.
+#define GUID_BYTE_LENGTH 16
 
-    mcl_uint8_t rnd[16];                  //!< Random bytes.
-} guid_t;
+static const char hex_characters[] = "0123456789abcdef";
 
 E_MCL_ERROR_CODE mcl_random_generate_guid(char **guid)
 {
@@ -51,11 +42,10 @@ E_MCL_ERROR_CODE mcl_random_generate_guid(char **guid)
     code = random_generate_guid(&guid_string);
     ASSERT_CODE_MESSAGE(MCL_OK == code, code, "GUID can not be generated.");
 
-    *guid = guid_string->buffer;
-    MCL_FREE(guid_string);
+    code = string_detach(&guid_string, guid);
 
-    DEBUG_LEAVE("retVal = <%d>", MCL_OK);
-    return MCL_OK;
+    DEBUG_LEAVE("retVal = <%d>", code);
+    return code;
 }
 
 E_MCL_ERROR_CODE random_generate_number(mcl_uint32_t *random_number)
@@ -85,35 +75,108 @@ mcl_uint8_t *random_generate_array(mcl_size_t size)
 
 E_MCL_ERROR_CODE random_generate_guid(string_t **guid)
 {
-    E_MCL_ERROR_CODE code;
-    guid_t guid_content;
-	char *guid_string;
-
     DEBUG_ENTRY("string_t **guid = <%p>", guid)
 
-    guid_string = MCL_MALLOC(GUID_LENGTH + 1);
+    E_MCL_ERROR_CODE code;
+	char *guid_string = MCL_MALLOC(RANDOM_GUID_LENGTH + 1);
     ASSERT_CODE_MESSAGE(MCL_NULL != guid_string, MCL_OUT_OF_MEMORY, "Memory can not be allocated for GUID string.");
 
-    code = security_generate_random_bytes(guid_content.rnd, sizeof(guid_content));
+    code = random_pool_generate_guid(MCL_NULL, guid_string);
+    (MCL_OK == code) && (code = string_initialize_dynamic(guid_string, RANDOM_GUID_LENGTH, guid));
 
-    if (MCL_OK == code)
+    if (MCL_OK != code)
     {
-        guid_content.clk_seq_hi_res = (mcl_uint8_t)((guid_content.clk_seq_hi_res & 0x3F) | 0x80);
-        guid_content.time_hi_and_version = (mcl_uint16_t)((guid_content.time_hi_and_version & 0x0FFF) | 0x4000);
+        MCL_FREE(guid_string);
+    }
+
+    DEBUG_LEAVE("retVal = <%d>", code);
+    return code;
+}
+
+E_MCL_ERROR_CODE random_pool_initialize(random_pool_t **random_pool)
+{
+    DEBUG_ENTRY("random_pool_t **random_pool = <%p>", random_pool)
+
+    MCL_NEW(*random_pool);
+    ASSERT_CODE_MESSAGE(MCL_NULL != *random_pool, MCL_OUT_OF_MEMORY, "Memory can not be allocated for random pool.");
+
+    // Pool is empty, it is filled at the first request.
+    (*random_pool)->index = RANDOM_POOL_SIZE;
+
+    DEBUG_LEAVE("retVal = <%d>", MCL_OK);
+    return MCL_OK;
+}
 
-        code = string_util_snprintf(guid_string, GUID_LENGTH + 1, "%08x-%04x-%04x-%02x%02x-%02x%02x%02x%02x%02x%02x", guid_content.time_low, guid_content.time_mid,
-                                    guid_content.time_hi_and_version, guid_content.clk_seq_hi_res, guid_content.clk_seq_low, guid_content.node[0], guid_content.node[1],
-                                    guid_content.node[2], guid_content.node[3], guid_content.node[4], guid_content.node[5]);
-        ASSERT_STATEMENT_CODE_MESSAGE(MCL_OK == code, MCL_FREE(guid_string), code, "GUID structure can not be printed as string.");
+E_MCL_ERROR_CODE random_pool_get_bytes(random_pool_t *random_pool, mcl_uint8_t *buffer, mcl_size_t size)
+{
+    VERBOSE_ENTRY("random_pool_t *random_pool = <%p>, mcl_uint8_t *buffer = <%p>, mcl_size_t size = <%u>", random_pool, buffer, size)
+
+    E_MCL_ERROR_CODE code = MCL_OK;
 
-        code = string_initialize_dynamic(guid_string, GUID_LENGTH, guid);
-        ASSERT_STATEMENT_CODE_MESSAGE(MCL_OK == code, MCL_FREE(guid_string), code, "GUID string can not be initialized.");
+    if ((MCL_NULL == random_pool) || (RANDOM_POOL_SIZE < size))
+    {
+        code = security_generate_random_bytes(buffer, size);
     }
     else
     {
-        MCL_FREE(guid_string);
+        // Remaining bytes are dropped if they are not enough, each byte is used only once.
+        if (RANDOM_POOL_SIZE - random_pool->index < size)
+        {
+            MCL_DEBUG("Refilling random pool.");
+            code = security_generate_random_bytes(random_pool->buffer, RANDOM_POOL_SIZE);
+            random_pool->index = (MCL_OK == code) ? 0 : RANDOM_POOL_SIZE;
+        }
+
+        if (MCL_OK == code)
+        {
+            string_util_memcpy(buffer, &random_pool->buffer[random_pool->index], size);
+            random_pool->index += size;
+        }
     }
 
-    DEBUG_LEAVE("retVal = <%d>", code);
+    VERBOSE_LEAVE("retVal = <%d>", code);
     return code;
 }
+
+E_MCL_ERROR_CODE random_pool_generate_guid(random_pool_t *random_pool, char *guid)
+{
+    VERBOSE_ENTRY("random_pool_t *random_pool = <%p>, char *guid = <%p>", random_pool, guid)
+
+	mcl_uint8_t random_bytes[GUID_BYTE_LENGTH];
+	mcl_size_t index;
+	mcl_size_t guid_index = 0;
+    E_MCL_ERROR_CODE code = random_pool_get_bytes(random_pool, random_bytes, GUID_BYTE_LENGTH);
+
+    if (MCL_OK == code)
+    {
+        // Version 4 (random) GUID with variant 1 as described in RFC 4122.
+        random_bytes[6] = (mcl_uint8_t)((random_bytes[6] & 0x0F) | 0x40);
+        random_bytes[8] = (mcl_uint8_t)((random_bytes[8] & 0x3F) | 0x80);
+
+        // Format is xxxxxxxx-xxxx-xxxx-xxxx-xxxxxxxxxxxx.
+        for (index = 0; index < GUID_BYTE_LENGTH; index++)
+        {
+            if ((4 == index) || (6 == index) || (8 == index) || (10 == index))
+            {
+                guid[guid_index++] = '-';
+            }
+
+            guid[guid_index++] = hex_characters[random_bytes[index] >> 4];
+            guid[guid_index++] = hex_characters[random_bytes[index] & 0x0F];
+        }
+
+        guid[guid_index] = MCL_NULL_CHAR;
+    }
+
+    VERBOSE_LEAVE("retVal = <%d>", code);
+    return code;
+}
+
+void random_pool_destroy(random_pool_t **random_pool)
+{
+    DEBUG_ENTRY("random_pool_t **random_pool = <%p>", random_pool)
+
+    MCL_FREE(*random_pool);
+
+    DEBUG_LEAVE("retVal = void");
+}
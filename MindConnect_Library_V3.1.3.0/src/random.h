@@ -18,6 +18,22 @@
 
 #include "string_type.h"
 
+// Number of random bytes generated at once by a random pool.
+#define RANDOM_POOL_SIZE 1024
+
+// Length of a GUID string without the terminating null character.
+#define RANDOM_GUID_LENGTH 36
+
+/**
+ * Random pool which keeps a block of random bytes to serve many small requests with one call to the random number generator.
+ * Random bytes of the pool are meant for identifiers like GUIDs and boundaries, not for key material.
+ */
+typedef struct random_pool_t
+{
+    mcl_uint8_t buffer[RANDOM_POOL_SIZE]; //!< Random bytes generated at once.
+    mcl_size_t index;                     //!< Index of the first unused byte in buffer.
+} random_pool_t;
+
 /**
  * @brief Generates random integer number.
  *
@@ -53,4 +69,50 @@ mcl_uint8_t *random_generate_array(mcl_size_t size);
  */
 E_MCL_ERROR_CODE random_generate_guid(string_t **guid);
 
+/**
+ * @brief Initializes an empty random pool. Pool is filled at the first request.
+ *
+ * @param [out] random_pool Random pool to be created.
+ * @return
+ * <ul>
+ * <li>#MCL_OK in case of success.</li>
+ * <li>#MCL_OUT_OF_MEMORY in case there is not enough memory in the system to proceed.</li>
+ * </ul>
+ */
+E_MCL_ERROR_CODE random_pool_initialize(random_pool_t **random_pool);
+
+/**
+ * @brief Takes random bytes from the random pool, the pool is refilled when it runs out of bytes.
+ *
+ * @param [in] random_pool Random pool to take the bytes from. If NULL or @p size is greater than #RANDOM_POOL_SIZE, bytes are generated directly.
+ * @param [out] buffer Buffer to be filled with random bytes.
+ * @param [in] size Number of random bytes.
+ * @return
+ * <ul>
+ * <li>#MCL_OK in case of success.</li>
+ * <li>#MCL_FAIL in case of an internal error in random number generation.</li>
+ * </ul>
+ */
+E_MCL_ERROR_CODE random_pool_get_bytes(random_pool_t *random_pool, mcl_uint8_t *buffer, mcl_size_t size);
+
+/**
+ * @brief Generates random guid into the given buffer using random bytes from the random pool.
+ *
+ * @param [in] random_pool Random pool to take the bytes from. If NULL, bytes are generated directly.
+ * @param [out] guid Buffer of at least #RANDOM_GUID_LENGTH + 1 characters to receive the null terminated guid.
+ * @return
+ * <ul>
+ * <li>#MCL_OK in case of success.</li>
+ * <li>#MCL_FAIL in case of an internal error in random number generation.</li>
+ * </ul>
+ */
+E_MCL_ERROR_CODE random_pool_generate_guid(random_pool_t *random_pool, char *guid);
+
+/**
+ * @brief Destroys the random pool.
+ *
+ * @param [in] random_pool Random pool to be destroyed. It is set to NULL.
+ */
+void random_pool_destroy(random_pool_t **random_pool);
+
 #endif //RANDOM_H_
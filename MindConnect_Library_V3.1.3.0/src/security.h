@@ -29,6 +29,66 @@ void security_initialize(void);
  */
 E_MCL_ERROR_CODE security_hash_sha256(const mcl_uint8_t *data, mcl_size_t data_size, mcl_uint8_t **hash, mcl_size_t *hash_size);
 
+/**
+ * @brief To be used to start a SHA256 calculation over data given in parts.
+ *
+ * @param [out] sha256 SHA256 state to be fed by #security_sha256_update. Must be freed with #security_sha256_destroy.
+ * @return
+ * <ul>
+ * <li>#MCL_OK in case of success.</li>
+ * <li>#MCL_OUT_OF_MEMORY in case there is not enough memory in the system to proceed.</li>
+ * <li>#MCL_SHA256_CALCULATION_FAIL if SHA256 calculation fails.</li>
+ * </ul>
+ */
+E_MCL_ERROR_CODE security_sha256_initialize(void **sha256);
+
+/**
+ * @brief To be used to add the next part of data to a SHA256 calculation.
+ *
+ * @param [in] sha256 SHA256 state created by #security_sha256_initialize.
+ * @param [in] data Next part of data to be hashed.
+ * @param [in] data_size Size of @p data.
+ * @return
+ * <ul>
+ * <li>#MCL_OK in case of success.</li>
+ * <li>#MCL_SHA256_CALCULATION_FAIL if SHA256 calculation fails.</li>
+ * </ul>
+ */
+E_MCL_ERROR_CODE security_sha256_update(void *sha256, const mcl_uint8_t *data, mcl_size_t data_size);
+
+/**
+ * @brief To be used to overwrite a SHA256 state with another one, e.g. to continue from a state saved before.
+ *
+ * @param [in] destination SHA256 state to be overwritten.
+ * @param [in] source SHA256 state to be copied.
+ * @return
+ * <ul>
+ * <li>#MCL_OK in case of success.</li>
+ * <li>#MCL_SHA256_CALCULATION_FAIL if the state can not be copied.</li>
+ * </ul>
+ */
+E_MCL_ERROR_CODE security_sha256_copy(void *destination, const void *source);
+
+/**
+ * @brief To be used to end a SHA256 calculation.
+ *
+ * @param [in] sha256 SHA256 state fed by #security_sha256_update. It can not be updated after this call unless overwritten by #security_sha256_copy.
+ * @param [out] hash Buffer of 32 bytes to receive the SHA256 result.
+ * @return
+ * <ul>
+ * <li>#MCL_OK in case of success.</li>
+ * <li>#MCL_SHA256_CALCULATION_FAIL if SHA256 calculation fails.</li>
+ * </ul>
+ */
+E_MCL_ERROR_CODE security_sha256_finalize(void *sha256, mcl_uint8_t *hash);
+
+/**
+ * Frees the SHA256 state created by #security_sha256_initialize.
+ *
+ * @param [in] sha256 SHA256 state to be freed. It is set to NULL.
+ */
+void security_sha256_destroy(void **sha256);
+
 /**
  * @brief To be used to sign data with RSA key.
  *
@@ -48,6 +108,44 @@ E_MCL_ERROR_CODE security_hash_sha256(const mcl_uint8_t *data, mcl_size_t data_s
  */
 E_MCL_ERROR_CODE security_rsa_sign(char *rsa_key, char *data, mcl_size_t data_size, mcl_uint8_t **signature, mcl_size_t *signature_size);
 
+/**
+ * @brief To be used to decode RSA private key once for signing data more than once.
+ *
+ * @param [in] rsa_key Private key in PEM format.
+ * @param [out] private_key Decoded private key to be passed to #security_rsa_sign_with_key. Must be freed with #security_rsa_free_private_key.
+ * @return
+ * <ul>
+ * <li>#MCL_OK in case of success.</li>
+ * <li>#MCL_OUT_OF_MEMORY in case there is not enough memory in the system to proceed.</li>
+ * <li>#MCL_FAIL in case of an internal error in MCL.</li>
+ * </ul>
+ */
+E_MCL_ERROR_CODE security_rsa_load_private_key(char *rsa_key, void **private_key);
+
+/**
+ * @brief To be used to sign data with RSA key decoded by #security_rsa_load_private_key.
+ *
+ * @param [in] private_key Decoded private key to be used in signing.
+ * @param [in] data The data to be signed.
+ * @param [in] data_size Size of the data.
+ * @param [out] signature Generated signature.
+ * @param [out] signature_size Size of signature.
+ * @return
+ * <ul>
+ * <li>#MCL_OK in case of success.</li>
+ * <li>#MCL_OUT_OF_MEMORY in case there is not enough memory in the system to proceed.</li>
+ * <li>#MCL_FAIL in case of an internal error in MCL.</li>
+ * </ul>
+ */
+E_MCL_ERROR_CODE security_rsa_sign_with_key(void *private_key, char *data, mcl_size_t data_size, mcl_uint8_t **signature, mcl_size_t *signature_size);
+
+/**
+ * Frees the private key decoded by #security_rsa_load_private_key.
+ *
+ * @param [in] private_key Decoded private key to be freed. It is set to NULL.
+ */
+void security_rsa_free_private_key(void **private_key);
+
 /**
  * @brief To be used to generate the RSA public/private keys.
  *
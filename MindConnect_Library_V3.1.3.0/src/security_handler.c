@@ -11,6 +11,8 @@
  *
  ************************************************************************/
 
+#define MEMORY_CATEGORY MCL_MEMORY_CATEGORY_SECURITY
+
 #include "security_handler.h"
 #include "security.h"
 #include "base64.h"
@@ -35,11 +37,16 @@ E_MCL_ERROR_CODE security_handler_initialize(security_handler_t **security_handl
     (*security_handler)->rsa.private_key = MCL_NULL;
     (*security_handler)->rsa.public_key = MCL_NULL;
     (*security_handler)->rsa.session_key = MCL_NULL;
+    (*security_handler)->rsa.decoded_private_key = MCL_NULL;
+    (*security_handler)->next_public_key = MCL_NULL;
+    (*security_handler)->next_private_key = MCL_NULL;
     (*security_handler)->authentication_key_size = 0;
 	(*security_handler)->last_token_time = MCL_NULL;
     (*security_handler)->access_token = MCL_NULL;
+    (*security_handler)->access_token_expiry = 0;
     (*security_handler)->registration_access_token = MCL_NULL;
     (*security_handler)->client_secret = MCL_NULL;
+    (*security_handler)->hmac = MCL_NULL;
     (*security_handler)->registration_client_uri = MCL_NULL;
     (*security_handler)->client_id = MCL_NULL;
 
@@ -80,7 +87,18 @@ E_MCL_ERROR_CODE security_handler_hmac_sha256(security_handler_t *security_handl
     DEBUG_ENTRY("security_handler_t *security_handler = <%p>, const mcl_uint8_t *data = <%p>, mcl_size_t data_size = <%u>, mcl_uint8_t **hash = <%p>, mcl_size_t *hash_size = <%p>",
                 security_handler, data, data_size, hash, hash_size)
 
-    E_MCL_ERROR_CODE code = hmac_sha256((const mcl_uint8_t*)data, data_size, (const mcl_uint8_t*)security_handler->client_secret->buffer, security_handler->client_secret->length, hash, hash_size);
+    E_MCL_ERROR_CODE code = MCL_OK;
+
+    // Pad and hash the client secret only once, each calculation then continues from the saved SHA256 states.
+    if (MCL_NULL == security_handler->hmac)
+    {
+        code = hmac_sha256_initialize((const mcl_uint8_t *)security_handler->client_secret->buffer, security_handler->client_secret->length, &security_handler->hmac);
+    }
+
+    (MCL_OK == code) && (code = hmac_sha256_start(security_handler->hmac));
+    (MCL_OK == code) && (code = hmac_sha256_update(security_handler->hmac, data, data_size));
+    (MCL_OK == code) && (code = hmac_sha256_finish(security_handler->hmac, hash, hash_size));
+
     if (MCL_OK == code)
     {
         MCL_DEBUG("HMAC SHA256 calculation succeeded: hash = <%p>, hash_size = <%u>", *hash, *hash_size);
@@ -144,23 +162,84 @@ E_MCL_ERROR_CODE security_handler_generate_rsa_key(security_handler_t *security_
 {
     DEBUG_ENTRY("security_handler_t *security_handler = <%p>", security_handler)
 
-    E_MCL_ERROR_CODE code = security_generate_rsa_key(&security_handler->rsa.public_key, &security_handler->rsa.private_key);
+    E_MCL_ERROR_CODE code;
+
+    // Decoded private key belongs to the key being replaced.
+    security_handler_reset_rsa_key(security_handler);
+
+    if (MCL_NULL != security_handler->next_private_key)
+    {
+        MCL_DEBUG("RSA key pair generated in advance is used.");
+        security_handler->rsa.public_key = security_handler->next_public_key;
+        security_handler->rsa.private_key = security_handler->next_private_key;
+        security_handler->next_public_key = MCL_NULL;
+        security_handler->next_private_key = MCL_NULL;
+        code = MCL_OK;
+    }
+    else
+    {
+        code = security_generate_rsa_key(&security_handler->rsa.public_key, &security_handler->rsa.private_key);
+    }
 
     DEBUG_LEAVE("retVal = <%d>", code);
     return code;
 }
 
-E_MCL_ERROR_CODE security_handler_rsa_sign(char *rsa_key, char *data, mcl_size_t data_size, mcl_uint8_t **signature, mcl_size_t *signature_size)
+void security_handler_set_next_rsa_key(security_handler_t *security_handler, char *public_key, char *private_key)
+{
+    DEBUG_ENTRY("security_handler_t *security_handler = <%p>, char *public_key = <%p>, char *private_key = <%p>", security_handler, public_key, private_key)
+
+    MCL_FREE(security_handler->next_public_key);
+    MCL_FREE(security_handler->next_private_key);
+    security_handler->next_public_key = public_key;
+    security_handler->next_private_key = private_key;
+
+    DEBUG_LEAVE("retVal = void");
+}
+
+E_MCL_ERROR_CODE security_handler_rsa_sign(security_handler_t *security_handler, char *data, mcl_size_t data_size, mcl_uint8_t **signature, mcl_size_t *signature_size)
 {
-    DEBUG_ENTRY("char *rsa_key = <%s>, char *data = <%s>, mcl_size_t data_size = <%u>, mcl_uint8_t **signature = <%p>, mcl_size_t *signature_size = <%p>", rsa_key, data,
-                data_size, signature, signature_size)
+    DEBUG_ENTRY("security_handler_t *security_handler = <%p>, char *data = <%s>, mcl_size_t data_size = <%u>, mcl_uint8_t **signature = <%p>, mcl_size_t *signature_size = <%p>",
+                security_handler, data, data_size, signature, signature_size)
 
-    E_MCL_ERROR_CODE code = security_rsa_sign(rsa_key, data, data_size, signature, signature_size);
+    E_MCL_ERROR_CODE code = MCL_OK;
+
+    // Decode the private key only once, parsing a 3072 bit key in PEM format costs more than signing with it.
+    if (MCL_NULL == security_handler->rsa.decoded_private_key)
+    {
+        code = security_rsa_load_private_key(security_handler->rsa.private_key, &security_handler->rsa.decoded_private_key);
+    }
+
+    (MCL_OK == code) && (code = security_rsa_sign_with_key(security_handler->rsa.decoded_private_key, data, data_size, signature, signature_size));
 
     DEBUG_LEAVE("retVal = <%d>", code);
     return code;
 }
 
+void security_handler_reset_rsa_key(security_handler_t *security_handler)
+{
+    DEBUG_ENTRY("security_handler_t *security_handler = <%p>", security_handler)
+
+    if (MCL_NULL != security_handler->rsa.decoded_private_key)
+    {
+        security_rsa_free_private_key(&security_handler->rsa.decoded_private_key);
+    }
+
+    DEBUG_LEAVE("retVal = void");
+}
+
+void security_handler_reset_hmac_key(security_handler_t *security_handler)
+{
+    DEBUG_ENTRY("security_handler_t *security_handler = <%p>", security_handler)
+
+    if (MCL_NULL != security_handler->hmac)
+    {
+        hmac_sha256_destroy(&security_handler->hmac);
+    }
+
+    DEBUG_LEAVE("retVal = void");
+}
+
 void security_handler_destroy(security_handler_t **security_handler)
 {
     DEBUG_ENTRY("security_handler_t **security_handler = <%p>", security_handler)
@@ -175,10 +254,14 @@ void security_handler_destroy(security_handler_t **security_handler)
         string_destroy(&(*security_handler)->client_id);
         string_destroy(&(*security_handler)->last_token_time);
 
+        security_handler_reset_rsa_key(*security_handler);
+        security_handler_reset_hmac_key(*security_handler);
         MCL_FREE((*security_handler)->hmac_key);
         MCL_FREE((*security_handler)->rsa.private_key);
         MCL_FREE((*security_handler)->rsa.public_key);
         MCL_FREE((*security_handler)->rsa.session_key);
+        MCL_FREE((*security_handler)->next_private_key);
+        MCL_FREE((*security_handler)->next_public_key);
         MCL_FREE(*security_handler);
 
         MCL_DEBUG("Security handler is destroyed.");
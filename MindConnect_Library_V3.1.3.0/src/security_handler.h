@@ -18,6 +18,7 @@
 #define SECURITY_HANDLER_H_
 
 #include "string_type.h"
+#include "hmac.h"
 
 /**
  * @brief RSA Pair Struct holding public and private and session keys
@@ -28,6 +29,7 @@ typedef struct rsa_t
     mcl_size_t public_key_length;  //!< Public key length.
     char *private_key;             //!< Private key.
     mcl_size_t private_key_length; //!< Private key length.
+    void *decoded_private_key;     //!< Private key decoded for signing, kept until the private key changes.
     mcl_uint8_t *session_key;      //!< Session key.
     mcl_size_t session_key_length; //!< Session key length.
 } rsa_t;
@@ -43,6 +45,8 @@ typedef struct rsa_t
 typedef struct security_handler_t
 {
     rsa_t rsa;                           //!< Rsa handle.
+    char *next_public_key;               //!< Public key generated in advance for the next key rotation.
+    char *next_private_key;              //!< Private key generated in advance for the next key rotation.
     mcl_uint8_t *hmac_key;               //!< Hmac key.
     mcl_uint8_t *onboarding_key;         //!< Onboarding key.
     mcl_uint8_t *authentication_key;     //!< Authentication key.
@@ -50,7 +54,9 @@ typedef struct security_handler_t
     string_t *registration_access_token; //!< Registration access token.
     string_t *registration_client_uri;   //!< Registration client uri.
     string_t *client_secret;             //!< Client secret.
+    hmac_sha256_t *hmac;                 //!< HMAC handle keyed with client secret, kept until the client secret changes.
     string_t *access_token;              //!< Access token.
+    mcl_time_t access_token_expiry;      //!< Local time at which the access token expires, 0 if the lifetime of the access token is unknown.
 	string_t *last_token_time;			 //!< The time at which the last access token is received.
     string_t *client_id;                 //!< Client id.
 } security_handler_t;
@@ -99,6 +105,7 @@ E_MCL_ERROR_CODE security_handler_hash_sha256(const mcl_uint8_t *data, mcl_size_
 
 /**
  * Calculates HMAC SHA256 for given data with the authorization key of provided @p security_handler.
+ * Key is padded and hashed at the first call and reused by the next calls until #security_handler_reset_hmac_key is called.
  *
  * @param [in] security_handler Security handler to use its authorization key.
  * @param [in] data Data to calculate HMAC SHA256 for.
@@ -166,6 +173,7 @@ E_MCL_ERROR_CODE security_handler_base64_decode(const string_t *encoded_data, mc
  * @brief To be used to generate the RSA public/private key pairs.
  *
  * Generated key pairs will be stored in the received handler.
+ * If a key pair is generated in advance by #security_handler_set_next_rsa_key, that key pair is used instead of generating a new one.
  *
  * @param [in] security_handler Handler to be used.
  * @return
@@ -178,11 +186,22 @@ E_MCL_ERROR_CODE security_handler_base64_decode(const string_t *encoded_data, mc
 E_MCL_ERROR_CODE security_handler_generate_rsa_key(security_handler_t *security_handler);
 
 /**
- * @brief To be used to sign data with RSA key.
+ * @brief To be used to store the RSA key pair generated in advance for the next key rotation.
  *
- * Received key will be used to sign. Caller can use the generated RSA private key or the servers public key.
+ * The handler takes the ownership of the keys. The key pair stored before, if any, is replaced.
  *
- * @param [in] rsa_key The key to be used in signing.
+ * @param [in] security_handler Handler to be used.
+ * @param [in] public_key Public key generated by #security_generate_rsa_key.
+ * @param [in] private_key Private key generated by #security_generate_rsa_key.
+ */
+void security_handler_set_next_rsa_key(security_handler_t *security_handler, char *public_key, char *private_key);
+
+/**
+ * @brief To be used to sign data with RSA private key of the handler.
+ *
+ * Private key is decoded at the first call and reused by the next calls until #security_handler_reset_rsa_key is called.
+ *
+ * @param [in] security_handler Handler whose private key is used in signing.
  * @param [in] data The data to be signed.
  * @param [in] data_size Size of the data.
  * @param [out] signature Generated signature.
@@ -194,7 +213,21 @@ E_MCL_ERROR_CODE security_handler_generate_rsa_key(security_handler_t *security_
  * <li>#MCL_FAIL in case of an internal error in MCL.</li>
  * </ul>
  */
-E_MCL_ERROR_CODE security_handler_rsa_sign(char *rsa_key, char *data, mcl_size_t data_size, mcl_uint8_t **signature, mcl_size_t *signature_size);
+E_MCL_ERROR_CODE security_handler_rsa_sign(security_handler_t *security_handler, char *data, mcl_size_t data_size, mcl_uint8_t **signature, mcl_size_t *signature_size);
+
+/**
+ * Frees the decoded RSA private key of the handler. To be called when the private key of the handler is replaced.
+ *
+ * @param [in] security_handler Handler whose decoded private key is freed.
+ */
+void security_handler_reset_rsa_key(security_handler_t *security_handler);
+
+/**
+ * Frees the HMAC handle of the handler. To be called when the client secret of the handler is replaced.
+ *
+ * @param [in] security_handler Handler whose HMAC handle is freed.
+ */
+void security_handler_reset_hmac_key(security_handler_t *security_handler);
 
 /**
  * @brief To destroy the Security Handler.
@@ -11,6 +11,8 @@
  *
  ************************************************************************/
 
+#define MEMORY_CATEGORY MCL_MEMORY_CATEGORY_SECURITY
+
 #include "security_libcrypto.h"
 #include "memory.h"
 #include "definitions.h"
@@ -42,6 +44,8 @@
 #include <openssl/sha.h>
 #endif
 
+#include <openssl/evp.h>
+
 #if (1 == HAVE_OPENSSL_CRYPTO_H_)
 #include <openssl/crypto.h>
 #endif
@@ -61,11 +65,22 @@ static E_MCL_ERROR_CODE _get_rsa_public_key(RSA *rsa, char **public_key);
 // This function is used to get the private key in PEM format from OpenSSL RSA structure.
 static E_MCL_ERROR_CODE _get_rsa_private_key(RSA *rsa, char **private_key);
 
+// Memory functions of OpenSSL, accounting its memory to security category.
+#if OPENSSL_VERSION_NUMBER < 0x10100000L
+static void *_crypto_malloc(size_t size);
+static void *_crypto_realloc(void *p, size_t size);
+static void _crypto_free(void *p);
+#else
+static void *_crypto_malloc(size_t size, const char *file, int line);
+static void *_crypto_realloc(void *p, size_t size, const char *file, int line);
+static void _crypto_free(void *p, const char *file, int line);
+#endif
+
 void security_initialize(void)
 {
     DEBUG_ENTRY("void")
 
-    CRYPTO_set_mem_functions(memory_malloc, memory_realloc, memory_free);
+    CRYPTO_set_mem_functions(_crypto_malloc, _crypto_realloc, _crypto_free);
 
     DEBUG_LEAVE("retVal = void");
 }
@@ -91,24 +106,116 @@ E_MCL_ERROR_CODE security_hash_sha256(const mcl_uint8_t *data, mcl_size_t data_s
     return MCL_OK;
 }
 
+E_MCL_ERROR_CODE security_sha256_initialize(void **sha256)
+{
+    DEBUG_ENTRY("void **sha256 = <%p>", sha256)
+
+    // Low level SHA256 functions are deprecated since OpenSSL 3.0, digest context of EVP interface is used instead.
+	EVP_MD_CTX *context = EVP_MD_CTX_create();
+    ASSERT_CODE_MESSAGE(MCL_NULL != context, MCL_OUT_OF_MEMORY, "Memory allocation for SHA256 context failed!");
+
+    if (1 != EVP_DigestInit_ex(context, EVP_sha256(), MCL_NULL))
+    {
+        EVP_MD_CTX_destroy(context);
+        MCL_ERROR_RETURN(MCL_SHA256_CALCULATION_FAIL, "SHA256 context can not be initialized!");
+    }
+
+    *sha256 = context;
+
+    DEBUG_LEAVE("retVal = <%d>", MCL_OK);
+    return MCL_OK;
+}
+
+E_MCL_ERROR_CODE security_sha256_update(void *sha256, const mcl_uint8_t *data, mcl_size_t data_size)
+{
+    VERBOSE_ENTRY("void *sha256 = <%p>, const mcl_uint8_t *data = <%p>, mcl_size_t data_size = <%u>", sha256, data, data_size)
+
+    ASSERT_CODE_MESSAGE(1 == EVP_DigestUpdate((EVP_MD_CTX *)sha256, data, data_size), MCL_SHA256_CALCULATION_FAIL, "SHA256 update failed!");
+
+    VERBOSE_LEAVE("retVal = <%d>", MCL_OK);
+    return MCL_OK;
+}
+
+E_MCL_ERROR_CODE security_sha256_copy(void *destination, const void *source)
+{
+    VERBOSE_ENTRY("void *destination = <%p>, const void *source = <%p>", destination, source)
+
+    ASSERT_CODE_MESSAGE(1 == EVP_MD_CTX_copy_ex((EVP_MD_CTX *)destination, (const EVP_MD_CTX *)source), MCL_SHA256_CALCULATION_FAIL, "SHA256 state copy failed!");
+
+    VERBOSE_LEAVE("retVal = <%d>", MCL_OK);
+    return MCL_OK;
+}
+
+E_MCL_ERROR_CODE security_sha256_finalize(void *sha256, mcl_uint8_t *hash)
+{
+    VERBOSE_ENTRY("void *sha256 = <%p>, mcl_uint8_t *hash = <%p>", sha256, hash)
+
+    ASSERT_CODE_MESSAGE(1 == EVP_DigestFinal_ex((EVP_MD_CTX *)sha256, hash, MCL_NULL), MCL_SHA256_CALCULATION_FAIL, "SHA256 finalization failed!");
+
+    VERBOSE_LEAVE("retVal = <%d>", MCL_OK);
+    return MCL_OK;
+}
+
+void security_sha256_destroy(void **sha256)
+{
+    DEBUG_ENTRY("void **sha256 = <%p>", sha256)
+
+    // Digest context is cleansed by OpenSSL when it is freed.
+    if (MCL_NULL != *sha256)
+    {
+        EVP_MD_CTX_destroy((EVP_MD_CTX *)*sha256);
+        *sha256 = MCL_NULL;
+    }
+
+    DEBUG_LEAVE("retVal = void");
+}
+
 E_MCL_ERROR_CODE security_rsa_sign(char *rsa_key, char *data, mcl_size_t data_size, mcl_uint8_t **signature, mcl_size_t *signature_size)
 {
     DEBUG_ENTRY("char *rsa_key = <%s>, char *data = <%s>, mcl_size_t data_size = <%u>, mcl_uint8_t **signature = <%p>, mcl_size_t *signature_size = <%p>", rsa_key, data, data_size, signature, signature_size)
 
-	E_MCL_ERROR_CODE code = MCL_OK;
-    unsigned int sign_length = 0;
+	E_MCL_ERROR_CODE code;
+	void *private_key = MCL_NULL;
+
+    code = security_rsa_load_private_key(rsa_key, &private_key);
+    (MCL_OK == code) && (code = security_rsa_sign_with_key(private_key, data, data_size, signature, signature_size));
+    security_rsa_free_private_key(&private_key);
+
+    DEBUG_LEAVE("retVal = <%d>", code);
+    return code;
+}
+
+E_MCL_ERROR_CODE security_rsa_load_private_key(char *rsa_key, void **private_key)
+{
+    DEBUG_ENTRY("char *rsa_key = <%s>, void **private_key = <%p>", rsa_key, private_key)
+
 	BIO* bio;
 	RSA *rsa = MCL_NULL;
-	mcl_uint8_t *hash = MCL_NULL;
-	mcl_size_t hash_size = 0;
-	mcl_bool_t ok;
 
 	mcl_size_t length = string_util_strlen(rsa_key);
     bio = BIO_new_mem_buf(rsa_key, length);
     ASSERT_CODE_MESSAGE(MCL_NULL != bio, MCL_OUT_OF_MEMORY, "Memory can not be allocated for BIO.");
 
     rsa = PEM_read_bio_RSAPrivateKey(bio, &rsa, 0, MCL_NULL);
-    ASSERT_STATEMENT_CODE_MESSAGE(MCL_NULL != rsa, BIO_free(bio), MCL_FAIL, "RSA structure can not be generated.");
+    BIO_free(bio);
+    ASSERT_CODE_MESSAGE(MCL_NULL != rsa, MCL_FAIL, "RSA structure can not be generated.");
+
+    *private_key = rsa;
+
+    DEBUG_LEAVE("retVal = <%d>", MCL_OK);
+    return MCL_OK;
+}
+
+E_MCL_ERROR_CODE security_rsa_sign_with_key(void *private_key, char *data, mcl_size_t data_size, mcl_uint8_t **signature, mcl_size_t *signature_size)
+{
+    DEBUG_ENTRY("void *private_key = <%p>, char *data = <%s>, mcl_size_t data_size = <%u>, mcl_uint8_t **signature = <%p>, mcl_size_t *signature_size = <%p>", private_key, data, data_size, signature, signature_size)
+
+	E_MCL_ERROR_CODE code = MCL_OK;
+    unsigned int sign_length = 0;
+	RSA *rsa = (RSA *)private_key;
+	mcl_uint8_t *hash = MCL_NULL;
+	mcl_size_t hash_size = 0;
+	mcl_bool_t ok;
 
     ok = (MCL_NULL != (*signature = MCL_MALLOC(RSA_size(rsa))));
     ok = ok && (MCL_OK == security_hash_sha256(data, data_size, &hash, &hash_size));
@@ -122,13 +229,24 @@ E_MCL_ERROR_CODE security_rsa_sign(char *rsa_key, char *data, mcl_size_t data_si
 	}
 
 	MCL_FREE(hash);
-    RSA_free(rsa);
-    BIO_free(bio);
 
     DEBUG_LEAVE("retVal = <%d>", code);
     return code;
 }
 
+void security_rsa_free_private_key(void **private_key)
+{
+    DEBUG_ENTRY("void **private_key = <%p>", private_key)
+
+    if (MCL_NULL != *private_key)
+    {
+        RSA_free((RSA *)*private_key);
+        *private_key = MCL_NULL;
+    }
+
+    DEBUG_LEAVE("retVal = void");
+}
+
 E_MCL_ERROR_CODE security_generate_rsa_key(char **public_key, char **private_key)
 {
 	DEBUG_ENTRY("char **public_key = <%p>, char **private_key = <%p>", public_key, private_key)
@@ -234,12 +352,7 @@ static E_MCL_ERROR_CODE _base64_encode_big_number(BIGNUM *big_number, char **enc
 
     code = base64_url_encode(binary, binary_length, &binary_encoded);
 
-    if (MCL_OK == code)
-    {
-        *encoded = binary_encoded->buffer;
-    }
-
-    MCL_FREE(binary_encoded);
+    (MCL_OK == code) && (code = string_detach(&binary_encoded, encoded));
     MCL_FREE(binary);
 
     DEBUG_LEAVE("retVal = <%d>", code);
@@ -315,3 +428,30 @@ static E_MCL_ERROR_CODE _get_rsa_public_key(RSA *rsa, char **public_key)
     DEBUG_LEAVE("retVal = <%d>", code);
     return code;
 }
+
+#if OPENSSL_VERSION_NUMBER < 0x10100000L
+static void *_crypto_malloc(size_t size)
+#else
+static void *_crypto_malloc(size_t size, const char *file, int line)
+#endif
+{
+    return memory_category_malloc(MCL_MEMORY_CATEGORY_SECURITY, size);
+}
+
+#if OPENSSL_VERSION_NUMBER < 0x10100000L
+static void *_crypto_realloc(void *p, size_t size)
+#else
+static void *_crypto_realloc(void *p, size_t size, const char *file, int line)
+#endif
+{
+    return memory_category_realloc(MCL_MEMORY_CATEGORY_SECURITY, p, size);
+}
+
+#if OPENSSL_VERSION_NUMBER < 0x10100000L
+static void _crypto_free(void *p)
+#else
+static void _crypto_free(void *p, const char *file, int line)
+#endif
+{
+    memory_free(p);
+}
@@ -11,6 +11,8 @@
  *
  ************************************************************************/
 
+#define MEMORY_CATEGORY MCL_MEMORY_CATEGORY_STORE
+
 #include "store.h"
 #include "time_series.h"
 #include "custom_data.h"
@@ -18,18 +20,13 @@
 #include "data_source_configuration.h"
 #include "event_list.h"
 #include "file.h"
+#include "json.h"
 #include "log_util.h"
 #include "memory.h"
 #include "definitions.h"
 #include "mcl/mcl_store.h"
 #include "time_util.h"
 
-typedef enum E_STORE_DATA_PRIORITY
-{
-    PRIORITY_HIGH, //!< Represents the high priority data to be sent to MindSphere.
-    PRIORITY_LOW   //!< Represents the low priority data to be sent to MindSphere.
-} E_STORE_DATA_PRIORITY;
-
 typedef struct
 {
     char *type;    //!< Type of payload.
@@ -58,7 +55,35 @@ static mcl_int32_t _event_severity_values[EVENT_VERSION_END][MCL_EVENT_SEVERITY_
 // custom list destroyer ( destroys based on the type of the item ) for destroying high and low priority lists.
 void _store_list_destroy_callback(void **item);
 
-static E_MCL_ERROR_CODE _store_add_data(mcl_store_t *store, void *data, E_STORE_DATA_TYPE data_type, E_STORE_DATA_PRIORITY priority);
+// releases the data of a store data together with its payload buffer if it is owned by the store data.
+static void _store_data_release(store_data_t *store_data);
+
+// destroys the data which couldn't be added to the store, with the arena of the store current since the data is allocated from it.
+static void _store_data_discard(store_t *store, void **data, E_STORE_DATA_TYPE data_type);
+
+static E_MCL_ERROR_CODE _store_add_data(mcl_store_t *store, void *data, E_STORE_DATA_TYPE data_type, E_MCL_STORE_PRIORITY priority);
+
+// generates meta and payload of a store data from its structured object.
+static E_MCL_ERROR_CODE _store_data_generate(store_data_t *store_data);
+
+// writes a prepared store data to write-ahead log of the store.
+static E_MCL_ERROR_CODE _store_data_persist(store_t *store, store_data_t *store_data);
+
+// prepares and persists the data in a persistent store which is not prepared yet, the user is done with filling it.
+static void _store_persist_initial_data(store_t *store);
+
+// initializes the index of a store list.
+static void _store_index_initialize(store_index_t *index, list_t *list, store_data_queue_t *in_flight);
+
+// moves the store data to the queue for its current state if it is not already there.
+static void _store_data_requeue(store_data_t *store_data);
+
+// appends the store data to the end of the queue.
+static void _store_data_queue_add(store_data_queue_t *queue, store_data_t *store_data);
+
+// removes the store data from the queue it is in, if any.
+static void _store_data_queue_remove(store_data_t *store_data);
+static E_MCL_ERROR_CODE _store_add_persisted_data(store_wal_record_t *record, string_t *meta, void *user_context);
 static E_MCL_ERROR_CODE _compare_item_meta_of_event(void *data, const item_meta_payload_local_t *item_meta_payload);
 
 // Checks version format.
@@ -81,11 +106,28 @@ E_MCL_ERROR_CODE mcl_store_initialize(mcl_bool_t streamable, mcl_store_t **store
     MCL_NEW(*store);
     ASSERT_CODE_MESSAGE(MCL_NULL != *store, MCL_OUT_OF_MEMORY, "Memory for store could not be allocated!");
 
+    (*store)->high_priority_list = MCL_NULL;
+    (*store)->low_priority_list = MCL_NULL;
+    (*store)->intern_table = MCL_NULL;
+    (*store)->store_wal = MCL_NULL;
+    (*store)->arena = MCL_NULL;
+    (*store)->priority = MCL_STORE_PRIORITY_HIGH;
+    (*store)->aging_count = 0;
+    (*store)->in_flight.head = MCL_NULL;
+    (*store)->in_flight.last = MCL_NULL;
+
     // Initialize lists containing mcl data types
     code = list_initialize(&((*store)->high_priority_list));
     code = (MCL_OK == code) ? list_initialize(&((*store)->low_priority_list)) : MCL_FAIL;
     ASSERT_STATEMENT_CODE_MESSAGE(MCL_OK == code, mcl_store_destroy(store), MCL_FAIL, "Initialization of store lists failed!");
 
+    _store_index_initialize(&(*store)->high_priority_index, (*store)->high_priority_list, &(*store)->in_flight);
+    _store_index_initialize(&(*store)->low_priority_index, (*store)->low_priority_list, &(*store)->in_flight);
+
+    // Initialize intern table shared by time series in store.
+    code = intern_table_initialize(&(*store)->intern_table);
+    ASSERT_STATEMENT_CODE_MESSAGE(MCL_OK == code, mcl_store_destroy(store), code, "Initialization of store intern table failed!");
+
     // set streamable property :
     (*store)->streamable = streamable;
 
@@ -95,12 +137,56 @@ E_MCL_ERROR_CODE mcl_store_initialize(mcl_bool_t streamable, mcl_store_t **store
     return MCL_OK;
 }
 
+E_MCL_ERROR_CODE mcl_store_initialize_persistent(mcl_bool_t streamable, const char *directory, mcl_store_t **store)
+{
+	DEBUG_ENTRY("mcl_bool_t streamable = <%u>, const char *directory = <%p>, mcl_store_t **store = <%p>", streamable, directory, store)
+
+	E_MCL_ERROR_CODE code;
+
+    ASSERT_NOT_NULL(directory);
+
+    code = mcl_store_initialize(streamable, store);
+    ASSERT_CODE_MESSAGE(MCL_OK == code, code, "Initialization of store failed!");
+
+    code = store_wal_initialize(directory, &(*store)->store_wal);
+    ASSERT_STATEMENT_CODE_MESSAGE(MCL_OK == code, mcl_store_destroy(store), code, "Initialization of store write-ahead log failed!");
+
+    // Data left from the previous run is added to the store before any new data.
+    code = store_wal_replay((*store)->store_wal, _store_add_persisted_data, *store);
+    ASSERT_STATEMENT_CODE_MESSAGE(MCL_OK == code, mcl_store_destroy(store), code, "Replay of store write-ahead log failed!");
+
+    MCL_DEBUG("Persistent store has been initialized with <%u> data replayed.", store_get_data_count(*store));
+
+    DEBUG_LEAVE("retVal = <%d>", MCL_OK);
+    return MCL_OK;
+}
+
+E_MCL_ERROR_CODE mcl_store_initialize_with_arena(mcl_bool_t streamable, mcl_size_t block_size, mcl_store_t **store)
+{
+    DEBUG_ENTRY("mcl_bool_t streamable = <%u>, mcl_size_t block_size = <%u>, mcl_store_t **store = <%p>", streamable, block_size, store)
+
+	E_MCL_ERROR_CODE code;
+
+    code = mcl_store_initialize(streamable, store);
+    ASSERT_CODE_MESSAGE(MCL_OK == code, code, "Initialization of store failed!");
+
+    // Store itself, its lists and its intern table are allocated from the heap, only the data added to the store is allocated from the arena.
+    code = memory_arena_initialize(block_size, MCL_MEMORY_CATEGORY_STORE, &(*store)->arena);
+    ASSERT_STATEMENT_CODE_MESSAGE(MCL_OK == code, mcl_store_destroy(store), code, "Initialization of store arena failed!");
+
+    MCL_DEBUG("Store has been initialized with an arena of <%u> bytes blocks.", (*store)->arena->block_size);
+
+    DEBUG_LEAVE("retVal = <%d>", MCL_OK);
+    return MCL_OK;
+}
+
 E_MCL_ERROR_CODE mcl_store_new_time_series(mcl_store_t *store, const char *version, const char *configuration_id, const char *routing, mcl_time_series_t **time_series)
 {
 	DEBUG_ENTRY("mcl_store_t *store = <%p>, const char *version = <%p>, const char *configuration_id = <%p>, const char *routing = <%p>, mcl_time_series_t **time_series = <%p>",
 		store, version, configuration_id, routing, time_series)
 		
 	E_MCL_ERROR_CODE code;
+	memory_arena_t *arena;
 
     ASSERT_NOT_NULL(store);
     ASSERT_NOT_NULL(version);
@@ -111,12 +197,14 @@ E_MCL_ERROR_CODE mcl_store_new_time_series(mcl_store_t *store, const char *versi
     ASSERT_CODE_MESSAGE(MCL_TRUE == _is_valid_version(version), MCL_INVALID_PARAMETER, "Version format is not correct.");
 
     // Initialize a new time series.
-     code = time_series_initialize(version, configuration_id, routing, time_series);
+    arena = memory_arena_set_current(store->arena);
+    code = time_series_initialize(version, configuration_id, routing, store->intern_table, time_series);
+    memory_arena_set_current(arena);
     ASSERT_CODE_MESSAGE(MCL_OK == code, code, "Creation of new time_series store failed!");
 
     // Add new time_series to list, or if failed destroy it
-    code = _store_add_data(store, (void *)*time_series, STORE_DATA_TIME_SERIES, PRIORITY_HIGH);
-    ASSERT_STATEMENT_CODE_MESSAGE(MCL_OK == code, time_series_destroy(time_series), code, "Adding time_series to list failed!");
+    code = _store_add_data(store, (void *)*time_series, STORE_DATA_TIME_SERIES, store->priority);
+    ASSERT_STATEMENT_CODE_MESSAGE(MCL_OK == code, _store_data_discard(store, (void **)time_series, STORE_DATA_TIME_SERIES), code, "Adding time_series to list failed!");
 
     DEBUG_LEAVE("retVal = <%d>", code);
     return code;
@@ -132,6 +220,7 @@ E_MCL_ERROR_CODE mcl_store_new_event(mcl_store_t *store, const char *version, co
 	event_list_t *event_list = MCL_NULL;
     mcl_size_t index;
     store_data_t *store_data;
+    memory_arena_t *arena;
 
 	ASSERT_NOT_NULL(store);
     ASSERT_NOT_NULL(version);
@@ -161,20 +250,22 @@ E_MCL_ERROR_CODE mcl_store_new_event(mcl_store_t *store, const char *version, co
     // Set event version.
     item_meta_payload_local.version = (char *)version;
 
-    // Check if the necessary event set exists.
-    event_list_exists = list_exist(store->high_priority_list, (const void *)(&item_meta_payload_local), (list_compare_callback)_compare_item_meta_of_event,
+    // Check if the necessary event set exists in the list of the priority set for new data.
+    event_list_exists = list_exist((MCL_STORE_PRIORITY_HIGH == store->priority) ? store->high_priority_list : store->low_priority_list, (const void *)(&item_meta_payload_local), (list_compare_callback)_compare_item_meta_of_event,
                                              (void **)(&store_data));
 
     // If the event set does not exist, initialize the event and add to store.
     if (MCL_FAIL == event_list_exists)
     {
         // event set initialize
+        arena = memory_arena_set_current(store->arena);
         code = event_list_initialize(version, &event_list);
+        memory_arena_set_current(arena);
         ASSERT_CODE_MESSAGE(MCL_OK == code, code, "Creation of new event set failed!");
 
         // Add a new event set to store list.
-        code = _store_add_data(store, (void *)event_list, STORE_DATA_EVENT_LIST, PRIORITY_HIGH);
-        ASSERT_STATEMENT_CODE_MESSAGE(MCL_OK == code, event_list_destroy(&event_list), code, "Adding event set to store list failed!");
+        code = _store_add_data(store, (void *)event_list, STORE_DATA_EVENT_LIST, store->priority);
+        ASSERT_STATEMENT_CODE_MESSAGE(MCL_OK == code, _store_data_discard(store, (void **)&event_list, STORE_DATA_EVENT_LIST), code, "Adding event set to store list failed!");
     }
     else
     {
@@ -182,12 +273,22 @@ E_MCL_ERROR_CODE mcl_store_new_event(mcl_store_t *store, const char *version, co
     }
 
     // Initialize a new event.
+    arena = memory_arena_set_current(store->arena);
     code = event_initialize(event_list->meta, type, type_version, _event_severity_values[index][severity], timestamp, event);
-    ASSERT_CODE_MESSAGE(MCL_OK == code, code, "Creation of new event store failed!");
 
     // add event to event set
-    code = event_list_add_event(*event, event_list);
-    ASSERT_STATEMENT_CODE_MESSAGE(MCL_OK == code, event_destroy(event), code, "Creation of new event store failed!");
+    if (MCL_OK == code)
+    {
+        code = event_list_add_event(*event, event_list);
+
+        if (MCL_OK != code)
+        {
+            event_destroy(event);
+        }
+    }
+
+    memory_arena_set_current(arena);
+    ASSERT_CODE_MESSAGE(MCL_OK == code, code, "Creation of new event store failed!");
 
     DEBUG_LEAVE("retVal = <%d>", MCL_OK);
     return MCL_OK;
@@ -200,6 +301,7 @@ E_MCL_ERROR_CODE mcl_store_new_file(mcl_store_t *store, const char *version, con
 #if MCL_FILE_EXCHANGE_ENABLED
 	
 	E_MCL_ERROR_CODE code;
+	memory_arena_t *arena;
 
     ASSERT_NOT_NULL(store);
     ASSERT_NOT_NULL(version);
@@ -211,12 +313,14 @@ E_MCL_ERROR_CODE mcl_store_new_file(mcl_store_t *store, const char *version, con
     ASSERT_CODE_MESSAGE(MCL_TRUE == _is_valid_version(version), MCL_INVALID_PARAMETER, "Version format is not correct.");
 
     // Initialize a file item.
+    arena = memory_arena_set_current(store->arena);
     code = file_initialize(version, file_path, file_name, file_type, routing, file);
+    memory_arena_set_current(arena);
     ASSERT_CODE_MESSAGE(MCL_OK == code, code, "Creation of a new file item failed!");
 
     // Add new file item to store.
-    code = _store_add_data(store, (void *)*file, STORE_DATA_FILE, PRIORITY_HIGH);
-    ASSERT_STATEMENT_CODE_MESSAGE(MCL_OK == code, file_destroy(file), code, "Adding file item to store failed!");
+    code = _store_add_data(store, (void *)*file, STORE_DATA_FILE, store->priority);
+    ASSERT_STATEMENT_CODE_MESSAGE(MCL_OK == code, _store_data_discard(store, (void **)file, STORE_DATA_FILE), code, "Adding file item to store failed!");
 
     DEBUG_LEAVE("retVal = <%d>", MCL_OK);
     return MCL_OK;
@@ -233,6 +337,7 @@ E_MCL_ERROR_CODE mcl_store_new_custom_data(mcl_store_t *store, const char *versi
 		version, type, routing, custom_data)
 
 	E_MCL_ERROR_CODE code;
+	memory_arena_t *arena;
 
     ASSERT_NOT_NULL(store);
     ASSERT_NOT_NULL(custom_data);
@@ -240,13 +345,14 @@ E_MCL_ERROR_CODE mcl_store_new_custom_data(mcl_store_t *store, const char *versi
     ASSERT_NOT_NULL(type);
 
     // Initialize a new custom data
+    arena = memory_arena_set_current(store->arena);
     code = custom_data_initialize(version, type, routing, custom_data);
+    memory_arena_set_current(arena);
     ASSERT_CODE_MESSAGE(MCL_OK == code, code, "Creation of new custom data store failed!");
 
     // Add new custom data to list, or if failed destroy it
-    // TODO : Currently adding only to the high priority list
-    code = _store_add_data(store, (void *)*custom_data, STORE_DATA_CUSTOM, PRIORITY_HIGH);
-    ASSERT_STATEMENT_CODE_MESSAGE(MCL_OK == code, custom_data_destroy(custom_data), code, "Adding custom data to list failed!");
+    code = _store_add_data(store, (void *)*custom_data, STORE_DATA_CUSTOM, store->priority);
+    ASSERT_STATEMENT_CODE_MESSAGE(MCL_OK == code, _store_data_discard(store, (void **)custom_data, STORE_DATA_CUSTOM), code, "Adding custom data to list failed!");
 
     DEBUG_LEAVE("retVal = <%d>", code);
     return code;
@@ -259,6 +365,7 @@ E_MCL_ERROR_CODE mcl_store_new_stream_data(mcl_store_t *store, const char *versi
 		store, version, type, routing, stream_data_read_callback, user_context, stream_data)
 
 	E_MCL_ERROR_CODE code;
+	memory_arena_t *arena;
 
     ASSERT_NOT_NULL(store);
     ASSERT_CODE_MESSAGE(MCL_TRUE == store->streamable, MCL_INVALID_PARAMETER, "Store must be streamable to add this type of item!");
@@ -271,13 +378,14 @@ E_MCL_ERROR_CODE mcl_store_new_stream_data(mcl_store_t *store, const char *versi
     ASSERT_CODE_MESSAGE(MCL_TRUE == _is_valid_version(version), MCL_INVALID_PARAMETER, "Version format is not correct.");
 
     // Initialize a new stream data
+    arena = memory_arena_set_current(store->arena);
     code = stream_data_initialize(version, type, routing, stream_data_read_callback, user_context, stream_data);
+    memory_arena_set_current(arena);
     ASSERT_CODE_MESSAGE(MCL_OK == code, code, "Creation of new stream data store failed!");
 
     // Add new stream data to list, or if failed destroy it
-    // TODO : Currently adding only to the high priority list
-    code = _store_add_data(store, (void *)*stream_data, STORE_DATA_STREAM, PRIORITY_HIGH);
-    ASSERT_STATEMENT_CODE_MESSAGE(MCL_OK == code, stream_data_destroy(stream_data), code, "Adding stream data to list failed!");
+    code = _store_add_data(store, (void *)*stream_data, STORE_DATA_STREAM, store->priority);
+    ASSERT_STATEMENT_CODE_MESSAGE(MCL_OK == code, _store_data_discard(store, (void **)stream_data, STORE_DATA_STREAM), code, "Adding stream data to list failed!");
 
     DEBUG_LEAVE("retVal = <%d>", code);
     return code;
@@ -288,6 +396,7 @@ E_MCL_ERROR_CODE mcl_store_new_data_source_configuration(mcl_store_t *store, con
 	DEBUG_ENTRY("mcl_store_t *store = <%p>, const char *version = <%p>, mcl_data_source_configuration_t **data_source_configuration = <%p>", store, version, data_source_configuration)
 
 	E_MCL_ERROR_CODE code;
+	memory_arena_t *arena;
 
     ASSERT_NOT_NULL(store);
     ASSERT_NOT_NULL(version);
@@ -297,13 +406,14 @@ E_MCL_ERROR_CODE mcl_store_new_data_source_configuration(mcl_store_t *store, con
     ASSERT_CODE_MESSAGE(MCL_TRUE == _is_valid_version(version), MCL_INVALID_PARAMETER, "Version format is not correct.");
 
     // Initialize a new data_source_configuration
+    arena = memory_arena_set_current(store->arena);
     code = data_source_configuration_initialize(version, data_source_configuration);
+    memory_arena_set_current(arena);
     ASSERT_CODE_MESSAGE(MCL_OK == code, code, "Creation of new data source configuration failed!");
 
     // Add new data_source_configuration to list, or if failed destroy it
-    // TODO : Currently adding only to the high priority list
-    code = _store_add_data(store, (void *)*data_source_configuration, STORE_DATA_DATA_SOURCE_CONFIGURATION, PRIORITY_HIGH);
-    ASSERT_STATEMENT_CODE_MESSAGE(MCL_OK == code, data_source_configuration_destroy(data_source_configuration), code, "Adding data source configuration to list failed!");
+    code = _store_add_data(store, (void *)*data_source_configuration, STORE_DATA_DATA_SOURCE_CONFIGURATION, store->priority);
+    ASSERT_STATEMENT_CODE_MESSAGE(MCL_OK == code, _store_data_discard(store, (void **)data_source_configuration, STORE_DATA_DATA_SOURCE_CONFIGURATION), code, "Adding data source configuration to list failed!");
 
     DEBUG_LEAVE("retVal = <%d>", code);
     return code;
@@ -318,8 +428,22 @@ E_MCL_ERROR_CODE mcl_store_destroy(mcl_store_t **store)
 
     if (MCL_NULL != *store)
     {
+        // Data which is not sent yet is kept in write-ahead log for the next run.
+        if (MCL_NULL != (*store)->store_wal)
+        {
+            _store_persist_initial_data(*store);
+        }
+
         list_destroy_with_content(&(*store)->high_priority_list, _store_list_destroy_callback);
         list_destroy_with_content(&(*store)->low_priority_list, _store_list_destroy_callback);
+
+        // Time series refer to interned strings, so intern table is destroyed after them.
+        intern_table_destroy(&(*store)->intern_table);
+        store_wal_destroy(&(*store)->store_wal);
+
+        // Data is released one by one above only to close files and to free what is allocated from the heap during exchange,
+        // memory of the data in the arena is released here at once.
+        memory_arena_destroy(&(*store)->arena);
         MCL_FREE(*store);
     }
     else
@@ -331,12 +455,26 @@ E_MCL_ERROR_CODE mcl_store_destroy(mcl_store_t **store)
     return MCL_OK;
 }
 
+E_MCL_ERROR_CODE mcl_store_set_priority(mcl_store_t *store, E_MCL_STORE_PRIORITY priority)
+{
+    DEBUG_ENTRY("mcl_store_t *store = <%p>, E_MCL_STORE_PRIORITY priority = <%d>", store, priority)
+
+    ASSERT_NOT_NULL(store);
+    ASSERT_CODE_MESSAGE(priority >= MCL_STORE_PRIORITY_HIGH && priority < MCL_STORE_PRIORITY_END, MCL_INVALID_PARAMETER, "Invalid priority.");
+
+    store->priority = priority;
+
+    DEBUG_LEAVE("retVal = <%d>", MCL_OK);
+    return MCL_OK;
+}
+
 void store_data_set_state(store_data_t *store_data, E_STORE_DATA_STATE state)
 {
     DEBUG_ENTRY("store_data_t *store_data = <%p>, E_STORE_DATA_STATE state = <%d>", store_data, state)
 
     MCL_DEBUG("Updating state : %d --> %d", store_data->state, state);
     store_data->state = state;
+    _store_data_requeue(store_data);
 
     DEBUG_LEAVE("retVal = <void>");
     return;
@@ -363,6 +501,92 @@ E_MCL_ERROR_CODE store_data_remove(list_t *store_list, list_node_t *store_data_n
     return result;
 }
 
+E_MCL_ERROR_CODE store_data_prepare(store_t *store, store_data_t *store_data)
+{
+    DEBUG_ENTRY("store_t *store = <%p>, store_data_t *store_data = <%p>", store, store_data)
+
+    ASSERT_CODE_MESSAGE(MCL_OK == _store_data_generate(store_data), MCL_FAIL, "Generation of meta/payload buffers has been failed!");
+    store_data_set_state(store_data, DATA_STATE_PREPARED);
+
+    // Persistent store keeps prepared data in its write-ahead log. If it can not be written, data is still sent from memory.
+    if ((MCL_NULL != store->store_wal) && (MCL_OK != _store_data_persist(store, store_data)))
+    {
+        MCL_WARN("Store data couldn't be written to write-ahead log. It will be kept in memory.");
+    }
+
+    DEBUG_LEAVE("retVal = <%d>", MCL_OK);
+    return MCL_OK;
+}
+
+mcl_size_t store_data_get_size_class(store_data_t *store_data)
+{
+    VERBOSE_ENTRY("store_data_t *store_data = <%p>", store_data)
+
+	mcl_size_t size = store_data->payload_size + ((MCL_NULL == store_data->meta) ? 0 : store_data->meta->length);
+	mcl_size_t shift = 0;
+	mcl_size_t size_class;
+
+    // Sizes less than 8 have a class of their own. Larger sizes are classified by their highest bit and the two bits following it.
+    while (7 < (size >> shift))
+    {
+        shift++;
+    }
+    size_class = (4 * shift) + (size >> shift);
+
+    VERBOSE_LEAVE("retVal = <%u>", size_class);
+    return size_class;
+}
+
+store_data_t *store_index_find_prepared_data(store_index_t *index, mcl_size_t size_class_limit)
+{
+    VERBOSE_ENTRY("store_index_t *index = <%p>, mcl_size_t size_class_limit = <%u>", index, size_class_limit)
+
+	store_data_t *store_data = MCL_NULL;
+
+    while ((MCL_NULL == store_data) && (0 < size_class_limit))
+    {
+        store_data = index->prepared[--size_class_limit].head;
+    }
+
+    VERBOSE_LEAVE("retVal = <%p>", store_data);
+    return store_data;
+}
+
+void store_age_low_priority_data(store_t *store)
+{
+    DEBUG_ENTRY("store_t *store = <%p>", store)
+
+	list_node_t *current_node = store->low_priority_list->head;
+	list_node_t *next_node;
+	store_data_t *store_data;
+	E_STORE_DATA_STATE state;
+
+    store->aging_count++;
+
+    // Low priority list is in the order the data is added, so the data to be moved are at its beginning.
+    while ((MCL_NULL != current_node) && (DEFAULT_STORE_LOW_PRIORITY_MAX_AGE <= store->aging_count - ((store_data_t *)current_node->data)->aging_start))
+    {
+        next_node = current_node->next;
+        store_data = (store_data_t *)current_node->data;
+        state = store_data_get_state(store_data);
+
+        // Data in flight keeps its place, it is moved once it is rolled back if it can not be sent.
+        // Moved data is queued behind the high priority data already in the store, but ahead of the data created later.
+        if (((DATA_STATE_INITIAL == state) || (DATA_STATE_PREPARED == state)) && (MCL_OK == list_add(store->high_priority_list, store_data)))
+        {
+            MCL_DEBUG("Low priority data <%p> is moved to the high priority list.", store_data);
+            list_remove(store->low_priority_list, current_node);
+            store_data->list_node = store->high_priority_list->last;
+            store_data->index = &store->high_priority_index;
+            _store_data_requeue(store_data);
+        }
+
+        current_node = next_node;
+    }
+
+    DEBUG_LEAVE("retVal = <void>");
+}
+
 mcl_size_t store_get_data_count(store_t *store)
 {
     DEBUG_ENTRY("store_t *store = <%p>", store)
@@ -371,44 +595,104 @@ mcl_size_t store_get_data_count(store_t *store)
     return store->high_priority_list->count + store->low_priority_list->count;
 }
 
+void store_reclaim_memory(store_t *store)
+{
+    DEBUG_ENTRY("store_t *store = <%p>", store)
+
+    // Nothing in the arena is referred to once all data is removed, interned strings are never allocated from the arena.
+    if ((MCL_NULL != store->arena) && (0 == store_get_data_count(store)))
+    {
+        memory_arena_reset(store->arena);
+        MCL_DEBUG("Memory of the data removed from the store is released.");
+    }
+
+    DEBUG_LEAVE("retVal = void");
+}
+
 // Private Functions:
-static E_MCL_ERROR_CODE _store_add_data(mcl_store_t *store, void *data, E_STORE_DATA_TYPE data_type, E_STORE_DATA_PRIORITY priority)
+static E_MCL_ERROR_CODE _store_add_data(mcl_store_t *store, void *data, E_STORE_DATA_TYPE data_type, E_MCL_STORE_PRIORITY priority)
 {
-    DEBUG_ENTRY("mcl_store_t *store = <%p>, void *data = <%p>, E_STORE_DATA_TYPE data_type = <%d>, E_STORE_DATA_PRIORITY priority = <%d>", store, data, data_type, priority)
+    DEBUG_ENTRY("mcl_store_t *store = <%p>, void *data = <%p>, E_STORE_DATA_TYPE data_type = <%d>, E_MCL_STORE_PRIORITY priority = <%d>", store, data, data_type, priority)
 
 	E_MCL_ERROR_CODE code;
     store_data_t *store_data;
 	list_t *list_to_add;
-	
+	memory_arena_t *arena;
+
+    // User is done with the data added before, it is written to the log so that only the data being filled is kept in memory.
+    if ((MCL_NULL != store->store_wal) && (STORE_DATA_PERSISTED != data_type))
+    {
+        _store_persist_initial_data(store);
+    }
+
+    arena = memory_arena_set_current(store->arena);
     MCL_NEW(store_data);
+    memory_arena_set_current(arena);
     ASSERT_CODE_MESSAGE(MCL_NULL != store_data, MCL_OUT_OF_MEMORY, "Not enough memory to create store_data!");
 
     store_data->data = data;
     store_data->type = data_type;
+    store_data->arena = store->arena;
     store_data->meta = MCL_NULL;
     store_data->payload_buffer = MCL_NULL;
     store_data->payload_size = 0;
     store_data->stream_info = MCL_NULL;
     store_data->state = DATA_STATE_INITIAL;
+    store_data->aging_start = store->aging_count;
+    store_data->index = (MCL_STORE_PRIORITY_HIGH == priority) ? &store->high_priority_index : &store->low_priority_index;
+    store_data->queue = MCL_NULL;
+    store_data->queue_previous = MCL_NULL;
+    store_data->queue_next = MCL_NULL;
 
-    list_to_add = (PRIORITY_HIGH == priority) ? store->high_priority_list : store->low_priority_list;
+    list_to_add = store_data->index->list;
 
+    arena = memory_arena_set_current(store->arena);
     code = list_add(list_to_add, store_data);
-    ASSERT_STATEMENT_CODE_MESSAGE(MCL_OK == code, MCL_FREE(store_data), code, "Add to list failed!");
+
+    if (MCL_OK != code)
+    {
+        MCL_FREE(store_data);
+    }
+
+    memory_arena_set_current(arena);
+    ASSERT_CODE_MESSAGE(MCL_OK == code, code, "Add to list failed!");
+
+    // Index the data to be prepared :
+    store_data->list_node = list_to_add->last;
+    _store_data_requeue(store_data);
 
     DEBUG_LEAVE("retVal = <%d>", MCL_OK);
     return MCL_OK;
 }
 
-void _store_list_destroy_callback(void **item)
+static E_MCL_ERROR_CODE _store_add_persisted_data(store_wal_record_t *record, string_t *meta, void *user_context)
 {
-    DEBUG_ENTRY("void **item = <%p>", item)
+    DEBUG_ENTRY("store_wal_record_t *record = <%p>, string_t *meta = <%p>, void *user_context = <%p>", record, meta, user_context)
 
-    // common destroy :
-    store_data_t *store_data = (store_data_t *)*item;
+	store_t *store = (store_t *)user_context;
+	store_data_t *store_data;
+	E_MCL_ERROR_CODE code = _store_add_data(store, record, STORE_DATA_PERSISTED, MCL_STORE_PRIORITY_HIGH);
 
-    // destroy meta string :
-    string_destroy(&store_data->meta);
+    if (MCL_OK != code)
+    {
+        store_wal_record_destroy(&record);
+        string_destroy(&meta);
+        MCL_ERROR_RETURN(code, "Persisted data couldn't be added to store.");
+    }
+
+    // Persisted data is already prepared, its payload is read from the log when it is written to a request.
+    store_data = (store_data_t *)store->high_priority_list->last->data;
+    store_data->meta = meta;
+    store_data->payload_size = record->payload_size;
+    store_data_set_state(store_data, DATA_STATE_PREPARED);
+
+    DEBUG_LEAVE("retVal = <%d>", MCL_OK);
+    return MCL_OK;
+}
+
+static void _store_data_release(store_data_t *store_data)
+{
+    DEBUG_ENTRY("store_data_t *store_data = <%p>", store_data)
 
     // destroy payload string ( only if it is not file or custom or stream. payload for those is just a pointer to their payload and it will be freed by them ):
     if ((MCL_NULL != store_data->payload_buffer)
@@ -416,6 +700,7 @@ void _store_list_destroy_callback(void **item)
     {
         MCL_FREE(store_data->payload_buffer);
     }
+    store_data->payload_buffer = MCL_NULL;
 
     // type based data destroy :
     if (STORE_DATA_TIME_SERIES == store_data->type)
@@ -448,11 +733,234 @@ void _store_list_destroy_callback(void **item)
         MCL_DEBUG("Item type is data source configuration, calling its destroy function.");
         data_source_configuration_destroy((data_source_configuration_t **)&(store_data->data));
     }
+    else if (STORE_DATA_PERSISTED == store_data->type)
+    {
+        MCL_DEBUG("Item type is persisted data, destroying its write-ahead log record.");
+        store_wal_record_destroy((store_wal_record_t **)&(store_data->data));
+    }
     else
     {
         MCL_FATAL("Received type of store list item is unknown!");
     }
 
+    DEBUG_LEAVE("retVal = void");
+}
+
+static E_MCL_ERROR_CODE _store_data_generate(store_data_t *store_data)
+{
+	DEBUG_ENTRY("store_data_t *store_data = <%p>", store_data)
+
+	E_MCL_ERROR_CODE code;
+	event_list_t *event_list;
+	string_t *payload_string = MCL_NULL;
+	char *payload_buffer;
+
+    // generate the meta/payload string based on the type:
+    if (STORE_DATA_TIME_SERIES == store_data->type)
+    {
+		time_series_t *time_series;
+
+        MCL_DEBUG("Item type = <time_series>");
+
+        time_series = (time_series_t *)store_data->data;
+
+        // generate the meta string :
+        ASSERT_CODE_MESSAGE(MCL_OK == json_from_item_meta(&time_series->meta, &store_data->meta), MCL_FAIL, "Get meta string from item meta for time_series has been failed!");
+
+        // only the size of the payload is calculated here. payload will be written directly to the http request :
+        store_data->payload_size = json_write_time_series_payload(&time_series->payload, MCL_NULL, 0);
+    }
+    else if (STORE_DATA_EVENT_LIST == store_data->type)
+    {
+        MCL_DEBUG("Item type = <event>");
+
+        event_list = (event_list_t *)store_data->data;
+
+        // generate the meta string :
+        ASSERT_CODE_MESSAGE(MCL_OK == json_from_item_meta(event_list->meta, &store_data->meta), MCL_FAIL, "Get meta string from item meta for event has been failed!");
+
+        if (MCL_OK != json_from_event_payload(event_list->events, &payload_string))
+        {
+            string_destroy(&store_data->meta);
+            MCL_ERROR_RETURN(MCL_FAIL, "Get meta string from item meta for event has been failed!");
+        }
+        store_data->payload_size = payload_string->length;
+
+        // only buffer of the string_t is used as the payload. string_t object needs to be freed. We don't use string_destroy because it also frees the buffer which we don't want.
+        code = string_detach(&payload_string, &payload_buffer);
+        ASSERT_STATEMENT_CODE_MESSAGE(MCL_OK == code, string_destroy(&store_data->meta), code, "Payload buffer could not be detached from payload string!");
+        store_data->payload_buffer = (mcl_uint8_t *)payload_buffer;
+    }
+    else if (STORE_DATA_FILE == store_data->type)
+    {
+		file_t *file;
+
+        MCL_DEBUG("Item type = <file>");
+
+        file = (file_t *)store_data->data;
+
+        // generate the meta string :
+        ASSERT_CODE_MESSAGE(MCL_OK == json_from_item_meta(&file->meta, &store_data->meta), MCL_FAIL, "Get meta string from item meta for file has been failed!");
+
+        // get file size.
+        store_data->payload_size = file->payload.size;
+    }
+    else if (STORE_DATA_CUSTOM == store_data->type)
+    {
+		custom_data_t *custom_data;
+
+        MCL_DEBUG("Item type = <custom_data>");
+
+        custom_data = (custom_data_t *)store_data->data;
+
+        // generate the meta string :
+        ASSERT_CODE_MESSAGE(MCL_OK == json_from_item_meta(&custom_data->meta, &store_data->meta), MCL_FAIL, "Get meta string from item meta for custom_data has been failed!");
+
+        // custom data's payload will be its payload without any conversion :
+        store_data->payload_buffer = custom_data->payload.buffer;
+        store_data->payload_size = custom_data->payload.size;
+    }
+    else if (STORE_DATA_STREAM == store_data->type)
+    {
+		stream_data_t *stream_data;
+
+        MCL_DEBUG("Item type = <stream_data>");
+
+        stream_data = (stream_data_t *)store_data->data;
+
+        // generate the meta string :
+        ASSERT_CODE_MESSAGE(MCL_OK == json_from_item_meta(&stream_data->base->meta, &store_data->meta), MCL_FAIL,
+                            "Get meta string from item meta for custom_data has been failed!");
+
+        // its payload will be read from the callback.
+    }
+    else if (STORE_DATA_DATA_SOURCE_CONFIGURATION == store_data->type)
+    {
+		data_source_configuration_t *data_source_configuration;
+		string_t *payload_string = MCL_NULL;
+
+        MCL_DEBUG("Item type = <data_source_configuration>");
+
+        data_source_configuration = (data_source_configuration_t *)store_data->data;
+
+        // generate the meta string :
+        ASSERT_CODE_MESSAGE(MCL_OK == json_from_item_meta(&data_source_configuration->meta, &store_data->meta), MCL_FAIL, "Get meta string from item meta for data source configuration has been failed!");
+
+        if (MCL_OK != json_from_data_source_configuration_payload(&data_source_configuration->payload, &payload_string))
+        {
+            string_destroy(&store_data->meta);
+            MCL_ERROR_RETURN(MCL_FAIL, "Get meta string from item meta for data source configuration has been failed!");
+        }
+        store_data->payload_size = payload_string->length;
+
+        // only buffer of the string_t is used as the payload. string_t object needs to be freed. We don't use string_destroy because it also frees the buffer which we don't want.
+        code = string_detach(&payload_string, &payload_buffer);
+        ASSERT_STATEMENT_CODE_MESSAGE(MCL_OK == code, string_destroy(&store_data->meta), code, "Payload buffer could not be detached from payload string!");
+        store_data->payload_buffer = (mcl_uint8_t *)payload_buffer;
+    }
+
+    DEBUG_LEAVE("retVal = <%d>", MCL_OK);
+    return MCL_OK;
+}
+
+static E_MCL_ERROR_CODE _store_data_persist(store_t *store, store_data_t *store_data)
+{
+    DEBUG_ENTRY("store_t *store = <%p>, store_data_t *store_data = <%p>", store, store_data)
+
+	E_MCL_ERROR_CODE code = MCL_OK;
+	store_wal_record_t *record = MCL_NULL;
+	string_t *content_id = MCL_NULL;
+	memory_arena_t *arena;
+
+    // Files are already on a disk and streams are read from the user when they are sent.
+    if ((STORE_DATA_FILE == store_data->type) || (STORE_DATA_STREAM == store_data->type) || (STORE_DATA_PERSISTED == store_data->type))
+    {
+        MCL_DEBUG("Store data of type <%d> is not written to write-ahead log.", store_data->type);
+        DEBUG_LEAVE("retVal = <%d>", MCL_OK);
+        return MCL_OK;
+    }
+
+    // Content id is written with the meta, tuples of the replayed data refer to it.
+    if (STORE_DATA_TIME_SERIES == store_data->type)
+    {
+        content_id = ((time_series_t *)store_data->data)->meta.content_id;
+    }
+    else if (STORE_DATA_EVENT_LIST == store_data->type)
+    {
+        content_id = ((event_list_t *)store_data->data)->meta->content_id;
+    }
+    else if (STORE_DATA_CUSTOM == store_data->type)
+    {
+        content_id = ((custom_data_t *)store_data->data)->meta.content_id;
+    }
+    else if (STORE_DATA_DATA_SOURCE_CONFIGURATION == store_data->type)
+    {
+        content_id = ((data_source_configuration_t *)store_data->data)->meta.content_id;
+    }
+
+    // time series payload is written directly to the request normally, it needs to be generated into a buffer to be written to the log :
+    if ((STORE_DATA_TIME_SERIES == store_data->type) && (MCL_NULL == store_data->payload_buffer))
+    {
+        store_data->payload_buffer = MCL_MALLOC(store_data->payload_size);
+        code = (MCL_NULL == store_data->payload_buffer) ? MCL_OUT_OF_MEMORY : MCL_OK;
+        (MCL_OK == code) && json_write_time_series_payload(&((time_series_t *)store_data->data)->payload, (char *)store_data->payload_buffer, store_data->payload_size);
+    }
+
+    (MCL_OK == code) && (code = store_wal_append(store->store_wal, (mcl_uint32_t)store_data->type, content_id, store_data->meta, store_data->payload_buffer,
+                                                 store_data->payload_size, &record));
+    ASSERT_CODE_MESSAGE(MCL_OK == code, code, "Store data couldn't be written to write-ahead log.");
+
+    // Payload will be read back from the log, only the meta is kept in memory.
+    arena = memory_arena_set_current(store_data->arena);
+    _store_data_release(store_data);
+    memory_arena_set_current(arena);
+    store_data->data = record;
+    store_data->type = STORE_DATA_PERSISTED;
+
+    DEBUG_LEAVE("retVal = <%d>", MCL_OK);
+    return MCL_OK;
+}
+
+static void _store_persist_initial_data(store_t *store)
+{
+    DEBUG_ENTRY("store_t *store = <%p>", store)
+
+	store_index_t *indexes[MCL_STORE_PRIORITY_END] = {&store->high_priority_index, &store->low_priority_index};
+	store_data_t *store_data;
+	mcl_size_t index_number;
+
+    for (index_number = 0; index_number < MCL_STORE_PRIORITY_END; index_number++)
+    {
+        // Data leaves the initial queue once it is prepared. Data which can not be prepared is left to the exchange to report.
+        store_data = indexes[index_number]->initial.head;
+        while ((MCL_NULL != store_data) && (MCL_OK == store_data_prepare(store, store_data)))
+        {
+            store_data = indexes[index_number]->initial.head;
+        }
+    }
+
+    DEBUG_LEAVE("retVal = void");
+}
+
+void _store_list_destroy_callback(void **item)
+{
+    DEBUG_ENTRY("void **item = <%p>", item)
+
+    // common destroy :
+    store_data_t *store_data = (store_data_t *)*item;
+
+    // Data is released while the arena of its store is current, so that memory of the data is found in the arena.
+    memory_arena_t *arena = memory_arena_set_current(store_data->arena);
+
+    // remove from the index :
+    _store_data_queue_remove(store_data);
+
+    // destroy meta string :
+    string_destroy(&store_data->meta);
+
+    // destroy data and payload :
+    _store_data_release(store_data);
+
     // clean up stream info :
     if (MCL_NULL != store_data->stream_info)
     {
@@ -461,10 +969,135 @@ void _store_list_destroy_callback(void **item)
     }
 
     MCL_FREE(store_data);
+    memory_arena_set_current(arena);
+
+    DEBUG_LEAVE("retVal = void");
+}
+
+static void _store_data_discard(store_t *store, void **data, E_STORE_DATA_TYPE data_type)
+{
+    DEBUG_ENTRY("store_t *store = <%p>, void **data = <%p>, E_STORE_DATA_TYPE data_type = <%d>", store, data, data_type)
+
+	store_data_t store_data;
+	memory_arena_t *arena;
+
+    store_data.data = *data;
+    store_data.type = data_type;
+    store_data.payload_buffer = MCL_NULL;
+
+    arena = memory_arena_set_current(store->arena);
+    _store_data_release(&store_data);
+    memory_arena_set_current(arena);
+
+    *data = MCL_NULL;
+
+    DEBUG_LEAVE("retVal = void");
+}
+
+static void _store_index_initialize(store_index_t *index, list_t *list, store_data_queue_t *in_flight)
+{
+    DEBUG_ENTRY("store_index_t *index = <%p>, list_t *list = <%p>, store_data_queue_t *in_flight = <%p>", index, list, in_flight)
+
+	mcl_size_t size_class;
+
+    index->list = list;
+    index->in_flight = in_flight;
+    index->initial.head = MCL_NULL;
+    index->initial.last = MCL_NULL;
+
+    for (size_class = 0; size_class < STORE_SIZE_CLASS_COUNT; size_class++)
+    {
+        index->prepared[size_class].head = MCL_NULL;
+        index->prepared[size_class].last = MCL_NULL;
+    }
 
     DEBUG_LEAVE("retVal = void");
 }
 
+static void _store_data_requeue(store_data_t *store_data)
+{
+    VERBOSE_ENTRY("store_data_t *store_data = <%p>", store_data)
+
+	store_data_queue_t *queue;
+
+    if (DATA_STATE_INITIAL == store_data->state)
+    {
+        queue = &store_data->index->initial;
+    }
+    else if (DATA_STATE_PREPARED == store_data->state)
+    {
+        queue = &store_data->index->prepared[store_data_get_size_class(store_data)];
+    }
+    else
+    {
+        queue = store_data->index->in_flight;
+    }
+
+    // Data keeps its place if its queue does not change (e.g. written data is being sent).
+    if (queue != store_data->queue)
+    {
+        _store_data_queue_remove(store_data);
+        _store_data_queue_add(queue, store_data);
+    }
+
+    VERBOSE_LEAVE("retVal = void");
+}
+
+static void _store_data_queue_add(store_data_queue_t *queue, store_data_t *store_data)
+{
+    VERBOSE_ENTRY("store_data_queue_t *queue = <%p>, store_data_t *store_data = <%p>", queue, store_data)
+
+    store_data->queue = queue;
+    store_data->queue_previous = queue->last;
+    store_data->queue_next = MCL_NULL;
+
+    if (MCL_NULL == queue->last)
+    {
+        queue->head = store_data;
+    }
+    else
+    {
+        queue->last->queue_next = store_data;
+    }
+    queue->last = store_data;
+
+    VERBOSE_LEAVE("retVal = void");
+}
+
+static void _store_data_queue_remove(store_data_t *store_data)
+{
+    VERBOSE_ENTRY("store_data_t *store_data = <%p>", store_data)
+
+	store_data_queue_t *queue = store_data->queue;
+
+    if (MCL_NULL != queue)
+    {
+        if (MCL_NULL == store_data->queue_previous)
+        {
+            queue->head = store_data->queue_next;
+        }
+        else
+        {
+            store_data->queue_previous->queue_next = store_data->queue_next;
+        }
+
+        if (MCL_NULL == store_data->queue_next)
+        {
+            queue->last = store_data->queue_previous;
+        }
+        else
+        {
+            store_data->queue_next->queue_previous = store_data->queue_previous;
+        }
+
+        store_data->queue = MCL_NULL;
+        store_data->queue_previous = MCL_NULL;
+        store_data->queue_next = MCL_NULL;
+    }
+
+    VERBOSE_LEAVE("retVal = void");
+}
+
 static E_MCL_ERROR_CODE _compare_item_meta_of_event(void *data, const item_meta_payload_local_t *item_meta_payload)
 {
     DEBUG_ENTRY("void *data = <%p>, const item_meta_payload_local_t *item_meta_payload = <%p>", data, item_meta_payload)
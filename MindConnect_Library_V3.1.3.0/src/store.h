@@ -14,6 +14,15 @@
 #ifndef STORE_H_
 #define STORE_H_
 #include "data_types.h"
+#include "intern_table.h"
+#include "store_wal.h"
+#include "memory.h"
+#include "mcl/mcl_store.h"
+
+/**
+ * @brief Low priority data which is left out of this many http requests in a row is moved to the high priority list.
+ */
+#define DEFAULT_STORE_LOW_PRIORITY_MAX_AGE 8
 
 /**
  * Data type of a data in the store.
@@ -25,7 +34,8 @@ typedef enum E_STORE_DATA_TYPE
     STORE_DATA_FILE,                     //!< Type of the data in the store is file.
     STORE_DATA_CUSTOM,                   //!< Type of the data in the store is custom data.
     STORE_DATA_STREAM,                   //!< Type of the data in the store is stream.
-    STORE_DATA_DATA_SOURCE_CONFIGURATION //!< Type of the data in the store is data source configuration.
+    STORE_DATA_DATA_SOURCE_CONFIGURATION, //!< Type of the data in the store is data source configuration.
+    STORE_DATA_PERSISTED                  //!< Data in the store is written to write-ahead log of the store. Only its meta is kept in memory.
 } E_STORE_DATA_TYPE;
 
 /**
@@ -37,9 +47,38 @@ typedef enum E_STORE_DATA_STATE
     DATA_STATE_PREPARED,        //!< Prepared. Means its meta and payload strings has been prepared.
     DATA_STATE_WRITTEN,         //!< Current data has been written to the current http request as a whole.
     DATA_STATE_STREAMING,       //!< Streaming is active. Current data has been partially written to the current http request or about to be written.
+    DATA_STATE_SENDING,         //!< Http request which current data has been written to is being sent. Next http request can be written meanwhile.
     DATA_STATE_SENT //!< This data has been successfully sent to the server. Can be deleted from the store.
 } E_STORE_DATA_STATE;
 
+/**
+ * @brief Number of size classes prepared store data is indexed by. Each power of two size range is divided into four classes.
+ */
+#define STORE_SIZE_CLASS_COUNT (4 * (8 * sizeof(mcl_size_t) - 1))
+
+/**
+ * Queue of store data linked through the store data themselves.
+ */
+typedef struct store_data_queue_t
+{
+    struct store_data_t *head; //!< First store data in the queue.
+    struct store_data_t *last; //!< Last store data in the queue.
+} store_data_queue_t;
+
+/**
+ * Index of the store data in a store list which are waiting to be written to an http request.
+ *
+ * Store data which are not prepared yet are kept in the order they are added. Prepared store data are kept in size classes
+ * so that the data fitting best into the space left in an http request can be found without walking the store list.
+ */
+typedef struct store_index_t
+{
+    list_t *list;                                        //!< Store list of the indexed store data.
+    store_data_queue_t *in_flight;                       //!< Queue of the store for store data which are written to an http request.
+    store_data_queue_t initial;                          //!< Store data in DATA_STATE_INITIAL.
+    store_data_queue_t prepared[STORE_SIZE_CLASS_COUNT]; //!< Store data in DATA_STATE_PREPARED by size class.
+} store_index_t;
+
 typedef struct store_data_stream_info_t
 {
     mcl_size_t meta_stream_index;    //!< Index of meta stream.
@@ -58,17 +97,25 @@ typedef struct store_data_stream_info_t
  * <li>file_t *</li>
  * <li>custom_data_t *</li>
  * <li>stream_data_t *</li>
+ * <li>store_wal_record_t *</li>
  * </ul>
  */
 typedef struct store_data_t
 {
     void *data;                            //!< Data to be added to the store.
     E_STORE_DATA_TYPE type;                //!< Type of data in the store.
+    memory_arena_t *arena;                 //!< Arena of the store which the data is allocated from, NULL if the data is allocated from the heap.
     E_STORE_DATA_STATE state;              //!< State of data in the store.
     string_t *meta;                        //!< Meta of the store as json string.
     mcl_uint8_t *payload_buffer;           //!< Payload of the store.
     mcl_size_t payload_size;               //!< Size of the payload in the store.
     store_data_stream_info_t *stream_info; //!< Stream information.
+    mcl_size_t aging_start;                //!< Aging count of the store when this data is added to the low priority list.
+    list_node_t *list_node;                //!< Node of this data in its store list.
+    store_index_t *index;                  //!< Index of the store list this data is in.
+    store_data_queue_t *queue;             //!< Queue of @p index or the in flight queue this data is in, NULL if none.
+    struct store_data_t *queue_previous;   //!< Previous store data in @p queue.
+    struct store_data_t *queue_next;       //!< Next store data in @p queue.
 } store_data_t;
 
 /**
@@ -81,11 +128,30 @@ typedef struct mcl_store_t
     list_t *high_priority_list; //!< Contains high priority store_data_t data.
 
     list_t *low_priority_list;  //!< Contains low priority store_data_t data.
+
+    intern_table_t *intern_table; //!< Data point ids and configuration ids of the time series in store.
+
+    store_wal_t *store_wal;       //!< Write-ahead log of a persistent store, NULL if the store is kept in memory only.
+
+    memory_arena_t *arena;        //!< Arena the data of the store is allocated from, NULL if the data is allocated from the heap.
+
+    E_MCL_STORE_PRIORITY priority; //!< Priority of the data to be added to the store.
+
+    mcl_size_t aging_count;        //!< Number of http requests filled from the store, low priority data is aged by it.
+
+    store_index_t high_priority_index; //!< Index of the data in high priority list waiting to be written.
+
+    store_index_t low_priority_index;  //!< Index of the data in low priority list waiting to be written.
+
+    store_data_queue_t in_flight;      //!< Data which are written to an http request and not rolled back or removed yet, in the order they are written.
 } store_t;
 
 /**
  * This function is used to set the state of the store data.
  *
+ * Store data is moved to the queue for its new state in the index of its store list. Data written to an http request is
+ * moved to the in flight queue of the store.
+ *
  * @param [in] store_data Current store data.
  * @param [in] state New state of the data.
  */
@@ -114,6 +180,51 @@ E_STORE_DATA_STATE store_data_get_state(store_data_t *store_data);
  */
 E_MCL_ERROR_CODE store_data_remove(list_t *store_list, list_node_t *store_data_node);
 
+/**
+ * This function is used to prepare a store data to be sent. Its meta and payload are generated and its state is set to #DATA_STATE_PREPARED.
+ *
+ * Data in a persistent store is written to the write-ahead log after it is prepared. It is replaced by its write-ahead log record and only its meta
+ * is kept in memory. Files and streams are not written to the log. If the data can not be written, it is kept in memory to be sent.
+ *
+ * @param [in] store The store handle.
+ * @param [in] store_data Store data in #DATA_STATE_INITIAL.
+ * @return
+ * <ul>
+ * <li>#MCL_OK in case of success.</li>
+ * <li>#MCL_FAIL in case meta or payload of the data can not be generated.</li>
+ * </ul>
+ */
+E_MCL_ERROR_CODE store_data_prepare(store_t *store, store_data_t *store_data);
+
+/**
+ * This function is used to get the size class of a prepared store data.
+ *
+ * @param [in] store_data Prepared store data.
+ * @return Returns the size class of the store data. Larger data has a larger or the same size class.
+ */
+mcl_size_t store_data_get_size_class(store_data_t *store_data);
+
+/**
+ * This function is used to find the largest prepared store data in an index with a size class less than @p size_class_limit.
+ *
+ * Data in the same size class are found in the order they are prepared.
+ *
+ * @param [in] index The index of a store list.
+ * @param [in] size_class_limit Size classes starting from this one are not searched.
+ * @return Returns the store data found, NULL if there is none.
+ */
+store_data_t *store_index_find_prepared_data(store_index_t *index, mcl_size_t size_class_limit);
+
+/**
+ * This function is used to age the low priority data after an http request is filled.
+ *
+ * Low priority data which is waiting to be written while #DEFAULT_STORE_LOW_PRIORITY_MAX_AGE http requests are filled is moved to the end of the
+ * high priority list so that it can not be starved by high priority data.
+ *
+ * @param [in] store The store handle.
+ */
+void store_age_low_priority_data(store_t *store);
+
 /**
  * This function is used to get the count of items in store.
  *
@@ -122,4 +233,13 @@ E_MCL_ERROR_CODE store_data_remove(list_t *store_list, list_node_t *store_data_n
  */
 mcl_size_t store_get_data_count(store_t *store);
 
+/**
+ * This function is used to reuse the memory of the data removed from the store.
+ *
+ * Memory of removed data stays in the arena of the store until there is no data left in the store. Does nothing for a store without an arena.
+ *
+ * @param [in] store The store handle.
+ */
+void store_reclaim_memory(store_t *store);
+
 #endif //STORE_H_
@@ -0,0 +1,830 @@
+/*!**********************************************************************
+*
+* @copyright Copyright (C) 2016 Siemens Aktiengesellschaft.\n
+*            All rights reserved.
+*
+*************************************************************************
+*
+* @file     store_wal.c
+* @date     Oct 17, 2026
+* @brief    Store write-ahead log module implementation file.
+*
+************************************************************************/
+
+#define MEMORY_CATEGORY MCL_MEMORY_CATEGORY_STORE
+
+#include "store_wal.h"
+#include "memory.h"
+#include "definitions.h"
+#include "log_util.h"
+#include "string_util.h"
+#include "file_util.h"
+
+// Marks the beginning of every record in a segment.
+#define RECORD_MAGIC 0x4D434C57u
+
+// Room for the file names appended to the directory (e.g. "/mcl_store_4294967295.wal").
+#define PATH_SUFFIX_SIZE 32
+
+// Initial number of segments the segment array can hold.
+#define INITIAL_SEGMENT_CAPACITY 8
+
+// Initial number of records the replay array can hold.
+#define INITIAL_REPLAY_CAPACITY 64
+
+// Size of the buffer payloads are read into while their checksums are verified.
+#define CHECKSUM_BUFFER_SIZE 256
+
+// Offset basis and prime of 32 bit FNV-1a hash which is used as record checksum.
+#define CHECKSUM_OFFSET_BASIS 2166136261u
+#define CHECKSUM_PRIME 16777619u
+
+typedef enum E_RECORD_KIND
+{
+    RECORD_KIND_DATA = 1,       //!< Record holds meta and payload of a store data.
+    RECORD_KIND_ACKNOWLEDGEMENT //!< Record marks a data record as acknowledged.
+} E_RECORD_KIND;
+
+typedef struct record_header_t
+{
+    mcl_uint32_t magic;        //!< Always RECORD_MAGIC.
+    mcl_uint32_t kind;         //!< One of E_RECORD_KIND.
+    mcl_uint32_t data_type;       //!< Type of the store data for data records.
+    mcl_uint32_t content_id_size; //!< Size of the content id of the meta following the header.
+    mcl_uint32_t meta_size;       //!< Size of the meta following the content id.
+    mcl_uint32_t payload_size;    //!< Size of the payload following the meta.
+    mcl_uint32_t checksum;        //!< Checksum of the fields above, content id, meta and payload.
+} record_header_t;
+
+typedef struct acknowledgement_t
+{
+    mcl_uint32_t segment_index; //!< Segment of the acknowledged record.
+    mcl_uint32_t offset;        //!< Offset of the acknowledged record in its segment.
+} acknowledgement_t;
+
+typedef struct replayed_record_t
+{
+    mcl_uint32_t segment_index; //!< Segment of the record.
+    mcl_size_t offset;          //!< Offset of the record in its segment.
+    store_wal_record_t *record; //!< Record read from the log, NULL if it is acknowledged.
+    string_t *meta;             //!< Meta of the record.
+} replayed_record_t;
+
+// Private Function Prototypes:
+static mcl_uint32_t _checksum(mcl_uint32_t checksum, const void *data, mcl_size_t size);
+static void _compose_path(store_wal_t *store_wal, const char *file_name);
+static void _compose_segment_path(store_wal_t *store_wal, mcl_uint32_t segment_index);
+static void _load_head(store_wal_t *store_wal);
+static E_MCL_ERROR_CODE _save_head(store_wal_t *store_wal, mcl_uint32_t first_segment_index);
+static E_MCL_ERROR_CODE _add_segment(store_wal_t *store_wal, mcl_uint32_t segment_index);
+static store_wal_segment_t *_get_segment(store_wal_t *store_wal, mcl_uint32_t segment_index);
+static E_MCL_ERROR_CODE _start_segment(store_wal_t *store_wal);
+static E_MCL_ERROR_CODE _lock_directory(store_wal_t *store_wal);
+static E_MCL_ERROR_CODE _write_record(store_wal_t *store_wal, record_header_t *header, const void *content_id, const void *meta, const void *payload, mcl_size_t *offset);
+static E_MCL_ERROR_CODE _replay_segment(void *file_descriptor, mcl_uint32_t segment_index, replayed_record_t **records, mcl_size_t *count, mcl_size_t *capacity);
+static E_MCL_ERROR_CODE _add_replayed_record(replayed_record_t **records, mcl_size_t *count, mcl_size_t *capacity, mcl_uint32_t segment_index, mcl_size_t offset,
+        store_wal_record_t *record, string_t *meta);
+static mcl_bool_t _read_and_verify(void *file_descriptor, record_header_t *header, char *content_id, char *meta, void *payload);
+static replayed_record_t *_find_replayed_record(replayed_record_t *records, mcl_size_t count, const acknowledgement_t *acknowledgement);
+
+E_MCL_ERROR_CODE store_wal_initialize(const char *directory, store_wal_t **store_wal)
+{
+    DEBUG_ENTRY("const char *directory = <%s>, store_wal_t **store_wal = <%p>", directory, store_wal)
+
+#if (1 == HAVE_FILE_SYSTEM_)
+	mcl_size_t directory_length = string_util_strlen(directory);
+
+    MCL_NEW(*store_wal);
+    ASSERT_CODE_MESSAGE(MCL_NULL != *store_wal, MCL_OUT_OF_MEMORY, "Memory couldn't be allocated for store write-ahead log.");
+
+    (*store_wal)->lock_descriptor = MCL_NULL;
+    (*store_wal)->segments = MCL_NULL;
+    (*store_wal)->segment_count = 0;
+    (*store_wal)->segment_capacity = 0;
+    (*store_wal)->next_segment_index = 0;
+    (*store_wal)->append_descriptor = MCL_NULL;
+    (*store_wal)->append_size = 0;
+    (*store_wal)->read_descriptor = MCL_NULL;
+    (*store_wal)->read_segment_index = 0;
+    (*store_wal)->path_size = directory_length + PATH_SUFFIX_SIZE;
+    (*store_wal)->path = MCL_MALLOC((*store_wal)->path_size);
+    (*store_wal)->directory = MCL_MALLOC(directory_length + 1);
+    ASSERT_STATEMENT_CODE_MESSAGE((MCL_NULL != (*store_wal)->path) && (MCL_NULL != (*store_wal)->directory), store_wal_destroy(store_wal), MCL_OUT_OF_MEMORY,
+                                  "Memory couldn't be allocated for store write-ahead log paths.");
+
+    string_util_memcpy((*store_wal)->directory, directory, directory_length + 1);
+
+    // Segments are appended and removed by a single handle, another process must not use the same directory.
+    ASSERT_STATEMENT_CODE_MESSAGE(MCL_OK == _lock_directory(*store_wal), store_wal_destroy(store_wal), MCL_PATH_NOT_ACCESSIBLE,
+                                  "Store write-ahead log directory couldn't be locked, it may be used by another process.");
+
+    // Segments before the one recorded in the head file are all acknowledged and removed.
+    _load_head(*store_wal);
+
+    DEBUG_LEAVE("retVal = <%d>", MCL_OK);
+    return MCL_OK;
+#else
+    *store_wal = MCL_NULL;
+    MCL_ERROR_RETURN(MCL_NO_FILE_SUPPORT, "There is no file system support.");
+#endif
+}
+
+E_MCL_ERROR_CODE store_wal_replay(store_wal_t *store_wal, store_wal_replay_callback_t callback, void *user_context)
+{
+    DEBUG_ENTRY("store_wal_t *store_wal = <%p>, store_wal_replay_callback_t callback = <%p>, void *user_context = <%p>", store_wal, callback, user_context)
+
+	E_MCL_ERROR_CODE code = MCL_OK;
+	replayed_record_t *records = MCL_NULL;
+	mcl_size_t count = 0;
+	mcl_size_t capacity = 0;
+	mcl_size_t index;
+	mcl_uint32_t segment_index = store_wal->next_segment_index;
+	void *file_descriptor = MCL_NULL;
+
+    // Segments are consecutive, the first one missing is the one to be started next.
+    _compose_segment_path(store_wal, segment_index);
+    while ((MCL_OK == code) && (MCL_OK == file_util_fopen_without_log(store_wal->path, "rb", &file_descriptor)))
+    {
+        code = _add_segment(store_wal, segment_index);
+        (MCL_OK == code) && (code = _replay_segment(file_descriptor, segment_index, &records, &count, &capacity));
+        file_util_fclose(file_descriptor);
+
+        _compose_segment_path(store_wal, ++segment_index);
+    }
+    store_wal->next_segment_index = segment_index;
+
+    MCL_INFO("<%u> segment(s) of store write-ahead log have been replayed.", store_wal->segment_count);
+
+    // Hand over the records which are not acknowledged in the order they are appended.
+    for (index = 0; index < count; index++)
+    {
+        if (MCL_NULL == records[index].record)
+        {
+            continue;
+        }
+
+        if (MCL_OK == code)
+        {
+            _get_segment(store_wal, records[index].record->segment_index)->pending_count++;
+            records[index].record->store_wal = store_wal;
+            code = callback(records[index].record, records[index].meta, user_context);
+        }
+        else
+        {
+            store_wal_record_destroy(&records[index].record);
+            string_destroy(&records[index].meta);
+        }
+    }
+    MCL_FREE(records);
+
+    (MCL_OK == code) && (code = store_wal_trim(store_wal));
+
+    DEBUG_LEAVE("retVal = <%d>", code);
+    return code;
+}
+
+E_MCL_ERROR_CODE store_wal_append(store_wal_t *store_wal, mcl_uint32_t data_type, const string_t *content_id, const string_t *meta, const mcl_uint8_t *payload,
+                                  mcl_size_t payload_size, store_wal_record_t **record)
+{
+    DEBUG_ENTRY("store_wal_t *store_wal = <%p>, mcl_uint32_t data_type = <%u>, const string_t *content_id = <%p>, const string_t *meta = <%p>, const mcl_uint8_t *payload = <%p>, mcl_size_t payload_size = <%u>, store_wal_record_t **record = <%p>",
+                store_wal, data_type, content_id, meta, payload, payload_size, record)
+
+	E_MCL_ERROR_CODE code;
+	record_header_t header;
+	mcl_size_t offset = 0;
+
+    header.magic = RECORD_MAGIC;
+    header.kind = RECORD_KIND_DATA;
+    header.data_type = data_type;
+    header.content_id_size = (MCL_NULL == content_id) ? 0 : (mcl_uint32_t)content_id->length;
+    header.meta_size = (mcl_uint32_t)meta->length;
+    header.payload_size = (mcl_uint32_t)payload_size;
+
+    MCL_NEW(*record);
+    ASSERT_CODE_MESSAGE(MCL_NULL != *record, MCL_OUT_OF_MEMORY, "Memory couldn't be allocated for store write-ahead log record.");
+
+    (*record)->content_id = MCL_NULL;
+    code = (MCL_NULL == content_id) ? MCL_OK : string_initialize(content_id, &(*record)->content_id);
+
+    // Data records are synchronized right away, the caller releases the data from memory once it is appended.
+    (MCL_OK == code) && (code = _write_record(store_wal, &header, (MCL_NULL == content_id) ? MCL_NULL : content_id->buffer, meta->buffer, payload, &offset));
+    (MCL_OK == code) && (code = file_util_fsync(store_wal->append_descriptor));
+    ASSERT_STATEMENT_CODE_MESSAGE(MCL_OK == code, store_wal_record_destroy(record), code, "Store data couldn't be appended to write-ahead log.");
+
+    (*record)->store_wal = store_wal;
+    (*record)->segment_index = store_wal->segments[store_wal->segment_count - 1].index;
+    (*record)->offset = offset;
+    (*record)->data_type = data_type;
+    (*record)->meta_size = meta->length;
+    (*record)->payload_size = payload_size;
+    store_wal->segments[store_wal->segment_count - 1].pending_count++;
+
+    DEBUG_LEAVE("retVal = <%d>", MCL_OK);
+    return MCL_OK;
+}
+
+mcl_size_t store_wal_read_payload(store_wal_record_t *record, mcl_size_t offset, void *destination, mcl_size_t size)
+{
+    DEBUG_ENTRY("store_wal_record_t *record = <%p>, mcl_size_t offset = <%u>, void *destination = <%p>, mcl_size_t size = <%u>", record, offset, destination, size)
+
+	store_wal_t *store_wal = record->store_wal;
+	mcl_size_t actual_count = 0;
+	E_MCL_ERROR_CODE code = MCL_OK;
+
+    // Records are mostly read in the order they are appended, keep the last segment read open.
+    if ((MCL_NULL == store_wal->read_descriptor) || (store_wal->read_segment_index != record->segment_index))
+    {
+        file_util_fclose(store_wal->read_descriptor);
+        _compose_segment_path(store_wal, record->segment_index);
+        code = file_util_fopen(store_wal->path, "rb", &store_wal->read_descriptor);
+        store_wal->read_segment_index = record->segment_index;
+    }
+
+    (MCL_OK == code) && (code = file_util_fseek(store_wal->read_descriptor, record->offset + sizeof(record_header_t) + ((MCL_NULL == record->content_id) ? 0 : record->content_id->length) + record->meta_size + offset));
+
+    if (MCL_OK == code)
+    {
+        file_util_fread(destination, 1, size, store_wal->read_descriptor, &actual_count);
+    }
+    else
+    {
+        MCL_ERROR("Payload couldn't be read from store write-ahead log.");
+    }
+
+    DEBUG_LEAVE("retVal = <%u>", actual_count);
+    return actual_count;
+}
+
+E_MCL_ERROR_CODE store_wal_acknowledge(store_wal_record_t *record)
+{
+    DEBUG_ENTRY("store_wal_record_t *record = <%p>", record)
+
+	E_MCL_ERROR_CODE code;
+	store_wal_t *store_wal = record->store_wal;
+	store_wal_segment_t *segment;
+	record_header_t header;
+	acknowledgement_t acknowledgement;
+	mcl_size_t offset = 0;
+
+    acknowledgement.segment_index = record->segment_index;
+    acknowledgement.offset = (mcl_uint32_t)record->offset;
+
+    header.magic = RECORD_MAGIC;
+    header.kind = RECORD_KIND_ACKNOWLEDGEMENT;
+    header.data_type = 0;
+    header.content_id_size = 0;
+    header.meta_size = 0;
+    header.payload_size = sizeof(acknowledgement);
+
+    // Acknowledgement is flushed, so that it is not lost if the agent stops. It is synchronized to the storage medium when the log is trimmed.
+    code = _write_record(store_wal, &header, MCL_NULL, MCL_NULL, &acknowledgement, &offset);
+    (MCL_OK == code) && (code = file_util_fflush(store_wal->append_descriptor));
+
+    // Even if the acknowledgement couldn't be written, the data is delivered. At worst it is sent again after a restart.
+    segment = _get_segment(store_wal, record->segment_index);
+    if ((MCL_NULL != segment) && (0 < segment->pending_count))
+    {
+        segment->pending_count--;
+    }
+
+    DEBUG_LEAVE("retVal = <%d>", code);
+    return code;
+}
+
+E_MCL_ERROR_CODE store_wal_trim(store_wal_t *store_wal)
+{
+    DEBUG_ENTRY("store_wal_t *store_wal = <%p>", store_wal)
+
+	E_MCL_ERROR_CODE code = MCL_OK;
+	mcl_size_t trim_count = 0;
+	mcl_size_t index;
+	mcl_size_t removable_count = store_wal->segment_count;
+
+    if (MCL_NULL != store_wal->append_descriptor)
+    {
+        // Segment being appended is never removed. Acknowledgements in it are synchronized before the segments they refer to are removed.
+        removable_count--;
+        code = file_util_fsync(store_wal->append_descriptor);
+    }
+
+    while ((trim_count < removable_count) && (0 == store_wal->segments[trim_count].pending_count))
+    {
+        trim_count++;
+    }
+
+    // Head is moved past the segments before they are removed, so that a restart in between never looks for them.
+    (MCL_OK == code) && (0 < trim_count) && (code = _save_head(store_wal, (trim_count < store_wal->segment_count) ? store_wal->segments[trim_count].index : store_wal->next_segment_index));
+
+    if ((MCL_OK == code) && (0 < trim_count))
+    {
+        for (index = 0; index < trim_count; index++)
+        {
+            if ((MCL_NULL != store_wal->read_descriptor) && (store_wal->read_segment_index == store_wal->segments[index].index))
+            {
+                file_util_fclose(store_wal->read_descriptor);
+                store_wal->read_descriptor = MCL_NULL;
+            }
+
+            _compose_segment_path(store_wal, store_wal->segments[index].index);
+            file_util_remove(store_wal->path);
+        }
+
+        for (index = trim_count; index < store_wal->segment_count; index++)
+        {
+            store_wal->segments[index - trim_count] = store_wal->segments[index];
+        }
+        store_wal->segment_count -= trim_count;
+
+        MCL_DEBUG("<%u> acknowledged segment(s) of store write-ahead log have been removed.", trim_count);
+    }
+
+    DEBUG_LEAVE("retVal = <%d>", code);
+    return code;
+}
+
+void store_wal_record_destroy(store_wal_record_t **record)
+{
+    DEBUG_ENTRY("store_wal_record_t **record = <%p>", record)
+
+    if (MCL_NULL != *record)
+    {
+        string_destroy(&(*record)->content_id);
+        MCL_FREE(*record);
+    }
+
+    DEBUG_LEAVE("retVal = void");
+}
+
+void store_wal_destroy(store_wal_t **store_wal)
+{
+    DEBUG_ENTRY("store_wal_t **store_wal = <%p>", store_wal)
+
+    if (MCL_NULL != *store_wal)
+    {
+        file_util_fclose((*store_wal)->append_descriptor);
+        file_util_fclose((*store_wal)->read_descriptor);
+        file_util_fclose((*store_wal)->lock_descriptor);
+        MCL_FREE((*store_wal)->segments);
+        MCL_FREE((*store_wal)->path);
+        MCL_FREE((*store_wal)->directory);
+        MCL_FREE(*store_wal);
+    }
+
+    DEBUG_LEAVE("retVal = void");
+}
+
+// Private Functions:
+static mcl_uint32_t _checksum(mcl_uint32_t checksum, const void *data, mcl_size_t size)
+{
+    VERBOSE_ENTRY("mcl_uint32_t checksum = <%u>, const void *data = <%p>, mcl_size_t size = <%u>", checksum, data, size)
+
+	const mcl_uint8_t *bytes = (const mcl_uint8_t *)data;
+	mcl_size_t index;
+
+    for (index = 0; index < size; index++)
+    {
+        checksum = (checksum ^ bytes[index]) * CHECKSUM_PRIME;
+    }
+
+    VERBOSE_LEAVE("retVal = <%u>", checksum);
+    return checksum;
+}
+
+static void _compose_path(store_wal_t *store_wal, const char *file_name)
+{
+    VERBOSE_ENTRY("store_wal_t *store_wal = <%p>, const char *file_name = <%s>", store_wal, file_name)
+
+    string_util_snprintf(store_wal->path, store_wal->path_size, "%s/%s", store_wal->directory, file_name);
+
+    VERBOSE_LEAVE("retVal = void");
+}
+
+static void _compose_segment_path(store_wal_t *store_wal, mcl_uint32_t segment_index)
+{
+    VERBOSE_ENTRY("store_wal_t *store_wal = <%p>, mcl_uint32_t segment_index = <%u>", store_wal, segment_index)
+
+    string_util_snprintf(store_wal->path, store_wal->path_size, "%s/mcl_store_%u.wal", store_wal->directory, (unsigned int)segment_index);
+
+    VERBOSE_LEAVE("retVal = void");
+}
+
+static void _load_head(store_wal_t *store_wal)
+{
+    DEBUG_ENTRY("store_wal_t *store_wal = <%p>", store_wal)
+
+	void *file_descriptor = MCL_NULL;
+	char line[PATH_SUFFIX_SIZE];
+
+    // Head file is replaced by a temporary file. If the agent stopped right before the replacement, the temporary file is the latest one.
+    _compose_path(store_wal, "mcl_store.head");
+    if (MCL_OK != file_util_fopen_without_log(store_wal->path, "r", &file_descriptor))
+    {
+        _compose_path(store_wal, "mcl_store.head.tmp");
+        file_util_fopen_without_log(store_wal->path, "r", &file_descriptor);
+    }
+
+    if ((MCL_NULL != file_descriptor) && (MCL_OK == file_util_fgets(line, sizeof(line), file_descriptor)))
+    {
+        store_wal->next_segment_index = (mcl_uint32_t)string_util_strtol(line, 10, MCL_NULL);
+    }
+    else
+    {
+        MCL_DEBUG("There is no store write-ahead log head in the directory, starting from the first segment.");
+    }
+
+    file_util_fclose(file_descriptor);
+
+    DEBUG_LEAVE("retVal = void");
+}
+
+static E_MCL_ERROR_CODE _save_head(store_wal_t *store_wal, mcl_uint32_t first_segment_index)
+{
+    DEBUG_ENTRY("store_wal_t *store_wal = <%p>, mcl_uint32_t first_segment_index = <%u>", store_wal, first_segment_index)
+
+	E_MCL_ERROR_CODE code;
+	void *file_descriptor = MCL_NULL;
+	char line[PATH_SUFFIX_SIZE];
+	char *temporary_path;
+
+    // Write a temporary file first and rename it, so that the head is never seen half written.
+    code = string_util_snprintf(line, sizeof(line), "%u\n", (unsigned int)first_segment_index);
+    temporary_path = MCL_MALLOC(store_wal->path_size);
+    ASSERT_CODE_MESSAGE(MCL_NULL != temporary_path, MCL_OUT_OF_MEMORY, "Memory couldn't be allocated for store write-ahead log head path.");
+
+    _compose_path(store_wal, "mcl_store.head.tmp");
+    string_util_memcpy(temporary_path, store_wal->path, store_wal->path_size);
+    _compose_path(store_wal, "mcl_store.head");
+
+    (MCL_OK == code) && (code = file_util_fopen(temporary_path, "w", &file_descriptor));
+    (MCL_OK == code) && (code = file_util_fputs(line, file_descriptor));
+    (MCL_OK == code) && (code = file_util_fsync(file_descriptor));
+    file_util_fclose(file_descriptor);
+    (MCL_OK == code) && (code = file_util_rename(temporary_path, store_wal->path));
+
+    MCL_FREE(temporary_path);
+
+    DEBUG_LEAVE("retVal = <%d>", code);
+    return code;
+}
+
+static E_MCL_ERROR_CODE _add_segment(store_wal_t *store_wal, mcl_uint32_t segment_index)
+{
+    DEBUG_ENTRY("store_wal_t *store_wal = <%p>, mcl_uint32_t segment_index = <%u>", store_wal, segment_index)
+
+    if (store_wal->segment_count == store_wal->segment_capacity)
+    {
+		mcl_size_t capacity = (0 == store_wal->segment_capacity) ? INITIAL_SEGMENT_CAPACITY : 2 * store_wal->segment_capacity;
+		store_wal_segment_t *segments = MCL_MALLOC(capacity * sizeof(store_wal_segment_t));
+        ASSERT_CODE_MESSAGE(MCL_NULL != segments, MCL_OUT_OF_MEMORY, "Memory couldn't be allocated for store write-ahead log segments.");
+
+        if (0 != store_wal->segment_count)
+        {
+            string_util_memcpy(segments, store_wal->segments, store_wal->segment_count * sizeof(store_wal_segment_t));
+        }
+
+        MCL_FREE(store_wal->segments);
+        store_wal->segments = segments;
+        store_wal->segment_capacity = capacity;
+    }
+
+    store_wal->segments[store_wal->segment_count].index = segment_index;
+    store_wal->segments[store_wal->segment_count].pending_count = 0;
+    store_wal->segment_count++;
+
+    DEBUG_LEAVE("retVal = <%d>", MCL_OK);
+    return MCL_OK;
+}
+
+static store_wal_segment_t *_get_segment(store_wal_t *store_wal, mcl_uint32_t segment_index)
+{
+    VERBOSE_ENTRY("store_wal_t *store_wal = <%p>, mcl_uint32_t segment_index = <%u>", store_wal, segment_index)
+
+	store_wal_segment_t *segment = MCL_NULL;
+
+    // Segments are consecutive, position of a segment is its distance to the first one.
+    if ((0 != store_wal->segment_count) && (segment_index >= store_wal->segments[0].index)
+        && ((mcl_size_t)(segment_index - store_wal->segments[0].index) < store_wal->segment_count))
+    {
+        segment = &store_wal->segments[segment_index - store_wal->segments[0].index];
+    }
+
+    VERBOSE_LEAVE("retVal = <%p>", segment);
+    return segment;
+}
+
+static E_MCL_ERROR_CODE _start_segment(store_wal_t *store_wal)
+{
+    DEBUG_ENTRY("store_wal_t *store_wal = <%p>", store_wal)
+
+	E_MCL_ERROR_CODE code;
+
+    file_util_fclose(store_wal->append_descriptor);
+    store_wal->append_descriptor = MCL_NULL;
+    store_wal->append_size = 0;
+
+    _compose_segment_path(store_wal, store_wal->next_segment_index);
+    code = file_util_fopen(store_wal->path, "wb", &store_wal->append_descriptor);
+    ASSERT_CODE_MESSAGE(MCL_OK == code, MCL_FILE_CANNOT_BE_OPENED, "Store write-ahead log segment couldn't be created.");
+
+    code = _add_segment(store_wal, store_wal->next_segment_index);
+    if (MCL_OK != code)
+    {
+        file_util_fclose(store_wal->append_descriptor);
+        store_wal->append_descriptor = MCL_NULL;
+        file_util_remove(store_wal->path);
+        MCL_ERROR_RETURN(code, "Store write-ahead log segment couldn't be added.");
+    }
+
+    store_wal->next_segment_index++;
+
+    DEBUG_LEAVE("retVal = <%d>", MCL_OK);
+    return MCL_OK;
+}
+
+static E_MCL_ERROR_CODE _lock_directory(store_wal_t *store_wal)
+{
+    DEBUG_ENTRY("store_wal_t *store_wal = <%p>", store_wal)
+
+	E_MCL_ERROR_CODE code;
+
+    // Lock file is never removed, lock on it is released when it is closed or the process exits.
+    _compose_path(store_wal, "mcl_store.lock");
+    code = file_util_fopen(store_wal->path, "ab", &store_wal->lock_descriptor);
+    (MCL_OK == code) && (code = file_util_lock(store_wal->lock_descriptor));
+
+    DEBUG_LEAVE("retVal = <%d>", code);
+    return code;
+}
+
+static E_MCL_ERROR_CODE _write_record(store_wal_t *store_wal, record_header_t *header, const void *content_id, const void *meta, const void *payload, mcl_size_t *offset)
+{
+    DEBUG_ENTRY("store_wal_t *store_wal = <%p>, record_header_t *header = <%p>, const void *content_id = <%p>, const void *meta = <%p>, const void *payload = <%p>, mcl_size_t *offset = <%p>",
+                store_wal, header, content_id, meta, payload, offset)
+
+	E_MCL_ERROR_CODE code = MCL_OK;
+
+    header->checksum = _checksum(CHECKSUM_OFFSET_BASIS, header, sizeof(record_header_t) - sizeof(header->checksum));
+    header->checksum = _checksum(header->checksum, content_id, header->content_id_size);
+    header->checksum = _checksum(header->checksum, meta, header->meta_size);
+    header->checksum = _checksum(header->checksum, payload, header->payload_size);
+
+    if ((MCL_NULL == store_wal->append_descriptor) || (DEFAULT_STORE_WAL_SEGMENT_SIZE <= store_wal->append_size))
+    {
+        code = _start_segment(store_wal);
+    }
+
+    (MCL_OK == code) && (code = file_util_fwrite(header, sizeof(record_header_t), 1, store_wal->append_descriptor));
+    (MCL_OK == code) && (0 != header->content_id_size) && (code = file_util_fwrite(content_id, 1, header->content_id_size, store_wal->append_descriptor));
+    (MCL_OK == code) && (0 != header->meta_size) && (code = file_util_fwrite(meta, 1, header->meta_size, store_wal->append_descriptor));
+    (MCL_OK == code) && (0 != header->payload_size) && (code = file_util_fwrite(payload, 1, header->payload_size, store_wal->append_descriptor));
+
+    if (MCL_OK == code)
+    {
+        *offset = store_wal->append_size;
+        store_wal->append_size += sizeof(record_header_t) + header->content_id_size + header->meta_size + header->payload_size;
+    }
+    else if (MCL_NULL != store_wal->append_descriptor)
+    {
+        // Segment ends with a partial record now, next record is appended to a new segment.
+        file_util_fclose(store_wal->append_descriptor);
+        store_wal->append_descriptor = MCL_NULL;
+    }
+
+    DEBUG_LEAVE("retVal = <%d>", code);
+    return code;
+}
+
+static E_MCL_ERROR_CODE _replay_segment(void *file_descriptor, mcl_uint32_t segment_index, replayed_record_t **records, mcl_size_t *count, mcl_size_t *capacity)
+{
+    DEBUG_ENTRY("void *file_descriptor = <%p>, mcl_uint32_t segment_index = <%u>, replayed_record_t **records = <%p>, mcl_size_t *count = <%p>, mcl_size_t *capacity = <%p>",
+                file_descriptor, segment_index, records, count, capacity)
+
+	E_MCL_ERROR_CODE code;
+	mcl_size_t offset = 0;
+	mcl_size_t actual_count = 0;
+	mcl_size_t segment_size;
+	mcl_size_t left_size;
+	mcl_stat_t file_attributes;
+	record_header_t header;
+
+    code = file_util_fstat(file_descriptor, &file_attributes);
+    ASSERT_CODE_MESSAGE(MCL_OK == code, code, "Size of store write-ahead log segment can not be read.");
+    segment_size = (mcl_size_t)file_attributes.st_size;
+
+    while (MCL_OK == code)
+    {
+        file_util_fread(&header, sizeof(record_header_t), 1, file_descriptor, &actual_count);
+        if ((1 != actual_count) || (RECORD_MAGIC != header.magic))
+        {
+            break;
+        }
+
+        // Sizes in the header are not verified by the checksum yet, a record which does not fit in the rest of the segment is corrupt or truncated.
+        left_size = segment_size - offset - sizeof(record_header_t);
+        if ((header.content_id_size > left_size) || (header.meta_size > left_size - header.content_id_size)
+            || (header.payload_size > left_size - header.content_id_size - header.meta_size))
+        {
+            MCL_INFO("Record at offset <%u> of store write-ahead log segment <%u> exceeds the segment, replay of the segment is stopped.", offset, segment_index);
+            break;
+        }
+
+        if (RECORD_KIND_DATA == header.kind)
+        {
+			char *content_id_buffer = MCL_MALLOC((mcl_size_t)header.content_id_size + 1);
+			char *meta_buffer = MCL_MALLOC((mcl_size_t)header.meta_size + 1);
+			store_wal_record_t *record = MCL_NULL;
+			string_t *meta = MCL_NULL;
+
+            ASSERT_STATEMENT_CODE_MESSAGE(MCL_NULL != meta_buffer, MCL_FREE(content_id_buffer), MCL_OUT_OF_MEMORY, "Memory couldn't be allocated for replayed meta.");
+            ASSERT_STATEMENT_CODE_MESSAGE(MCL_NULL != content_id_buffer, MCL_FREE(meta_buffer), MCL_OUT_OF_MEMORY, "Memory couldn't be allocated for replayed content id.");
+
+            if (MCL_FALSE == _read_and_verify(file_descriptor, &header, content_id_buffer, meta_buffer, MCL_NULL))
+            {
+                MCL_FREE(content_id_buffer);
+                MCL_FREE(meta_buffer);
+                break;
+            }
+            content_id_buffer[header.content_id_size] = MCL_NULL_CHAR;
+            meta_buffer[header.meta_size] = MCL_NULL_CHAR;
+
+            MCL_NEW(record);
+            code = (MCL_NULL == record) ? MCL_OUT_OF_MEMORY : MCL_OK;
+            if (MCL_OK == code)
+            {
+                record->store_wal = MCL_NULL;
+                record->segment_index = segment_index;
+                record->offset = offset;
+                record->data_type = header.data_type;
+                record->content_id = MCL_NULL;
+                record->meta_size = header.meta_size;
+                record->payload_size = header.payload_size;
+
+                if (0 == header.content_id_size)
+                {
+                    MCL_FREE(content_id_buffer);
+                }
+                else
+                {
+                    code = string_initialize_dynamic(content_id_buffer, header.content_id_size, &record->content_id);
+                }
+            }
+            (MCL_OK == code) && (code = string_initialize_dynamic(meta_buffer, header.meta_size, &meta));
+            (MCL_OK == code) && (code = _add_replayed_record(records, count, capacity, segment_index, offset, record, meta));
+
+            if (MCL_OK != code)
+            {
+                if ((MCL_NULL == record) || (MCL_NULL == record->content_id))
+                {
+                    MCL_FREE(content_id_buffer);
+                }
+                if (MCL_NULL == meta)
+                {
+                    MCL_FREE(meta_buffer);
+                }
+                string_destroy(&meta);
+                store_wal_record_destroy(&record);
+            }
+        }
+        else if ((RECORD_KIND_ACKNOWLEDGEMENT == header.kind) && (0 == header.content_id_size) && (0 == header.meta_size) && (sizeof(acknowledgement_t) == header.payload_size))
+        {
+			acknowledgement_t acknowledgement;
+			replayed_record_t *replayed_record;
+
+            if (MCL_FALSE == _read_and_verify(file_descriptor, &header, MCL_NULL, MCL_NULL, &acknowledgement))
+            {
+                break;
+            }
+
+            replayed_record = _find_replayed_record(*records, *count, &acknowledgement);
+            if ((MCL_NULL != replayed_record) && (MCL_NULL != replayed_record->record))
+            {
+                store_wal_record_destroy(&replayed_record->record);
+                string_destroy(&replayed_record->meta);
+            }
+        }
+        else
+        {
+            break;
+        }
+
+        offset += sizeof(record_header_t) + header.content_id_size + header.meta_size + header.payload_size;
+    }
+
+    DEBUG_LEAVE("retVal = <%d>", code);
+    return code;
+}
+
+static E_MCL_ERROR_CODE _add_replayed_record(replayed_record_t **records, mcl_size_t *count, mcl_size_t *capacity, mcl_uint32_t segment_index, mcl_size_t offset,
+        store_wal_record_t *record, string_t *meta)
+{
+    VERBOSE_ENTRY("replayed_record_t **records = <%p>, mcl_size_t *count = <%p>, mcl_size_t *capacity = <%p>, mcl_uint32_t segment_index = <%u>, mcl_size_t offset = <%u>, store_wal_record_t *record = <%p>, string_t *meta = <%p>",
+                  records, count, capacity, segment_index, offset, record, meta)
+
+    if (*count == *capacity)
+    {
+		mcl_size_t new_capacity = (0 == *capacity) ? INITIAL_REPLAY_CAPACITY : 2 * (*capacity);
+		replayed_record_t *new_records = MCL_MALLOC(new_capacity * sizeof(replayed_record_t));
+        ASSERT_CODE_MESSAGE(MCL_NULL != new_records, MCL_OUT_OF_MEMORY, "Memory couldn't be allocated for replayed records.");
+
+        if (0 != *count)
+        {
+            string_util_memcpy(new_records, *records, (*count) * sizeof(replayed_record_t));
+        }
+
+        MCL_FREE(*records);
+        *records = new_records;
+        *capacity = new_capacity;
+    }
+
+    (*records)[*count].segment_index = segment_index;
+    (*records)[*count].offset = offset;
+    (*records)[*count].record = record;
+    (*records)[*count].meta = meta;
+    (*count)++;
+
+    VERBOSE_LEAVE("retVal = <%d>", MCL_OK);
+    return MCL_OK;
+}
+
+static mcl_bool_t _read_and_verify(void *file_descriptor, record_header_t *header, char *content_id, char *meta, void *payload)
+{
+    DEBUG_ENTRY("void *file_descriptor = <%p>, record_header_t *header = <%p>, char *content_id = <%p>, char *meta = <%p>, void *payload = <%p>", file_descriptor, header,
+                content_id, meta, payload)
+
+	mcl_uint32_t checksum = _checksum(CHECKSUM_OFFSET_BASIS, header, sizeof(record_header_t) - sizeof(header->checksum));
+	mcl_uint8_t buffer[CHECKSUM_BUFFER_SIZE];
+	mcl_size_t left_size = header->payload_size;
+	mcl_size_t chunk_size;
+	mcl_size_t actual_count = 0;
+	mcl_bool_t complete = MCL_TRUE;
+
+    if (0 != header->content_id_size)
+    {
+        file_util_fread(content_id, 1, header->content_id_size, file_descriptor, &actual_count);
+        checksum = _checksum(checksum, content_id, actual_count);
+        complete = (actual_count == header->content_id_size) ? MCL_TRUE : MCL_FALSE;
+    }
+
+    if ((MCL_TRUE == complete) && (0 != header->meta_size))
+    {
+        file_util_fread(meta, 1, header->meta_size, file_descriptor, &actual_count);
+        checksum = _checksum(checksum, meta, actual_count);
+        complete = (actual_count == header->meta_size) ? MCL_TRUE : MCL_FALSE;
+    }
+
+    // Payload is kept only if a buffer is given, otherwise it is read in chunks just to verify the checksum.
+    if ((MCL_TRUE == complete) && (MCL_NULL != payload))
+    {
+        file_util_fread(payload, 1, left_size, file_descriptor, &actual_count);
+        checksum = _checksum(checksum, payload, actual_count);
+        complete = (actual_count == left_size) ? MCL_TRUE : MCL_FALSE;
+        left_size = 0;
+    }
+
+    while ((MCL_TRUE == complete) && (0 != left_size))
+    {
+        chunk_size = (left_size < CHECKSUM_BUFFER_SIZE) ? left_size : CHECKSUM_BUFFER_SIZE;
+        file_util_fread(buffer, 1, chunk_size, file_descriptor, &actual_count);
+        checksum = _checksum(checksum, buffer, actual_count);
+        complete = (actual_count == chunk_size) ? MCL_TRUE : MCL_FALSE;
+        left_size -= actual_count;
+    }
+
+    complete = ((MCL_TRUE == complete) && (checksum == header->checksum)) ? MCL_TRUE : MCL_FALSE;
+
+    DEBUG_LEAVE("retVal = <%d>", complete);
+    return complete;
+}
+
+static replayed_record_t *_find_replayed_record(replayed_record_t *records, mcl_size_t count, const acknowledgement_t *acknowledgement)
+{
+    VERBOSE_ENTRY("replayed_record_t *records = <%p>, mcl_size_t count = <%u>, const acknowledgement_t *acknowledgement = <%p>", records, count, acknowledgement)
+
+	mcl_size_t low = 0;
+	mcl_size_t high = count;
+	mcl_size_t middle;
+	replayed_record_t *found = MCL_NULL;
+
+    // Records are replayed in the order they are appended, so they are sorted by segment index and offset.
+    while ((low < high) && (MCL_NULL == found))
+    {
+        middle = low + (high - low) / 2;
+
+        if ((records[middle].segment_index < acknowledgement->segment_index)
+            || ((records[middle].segment_index == acknowledgement->segment_index) && (records[middle].offset < acknowledgement->offset)))
+        {
+            low = middle + 1;
+        }
+        else if ((records[middle].segment_index == acknowledgement->segment_index) && (records[middle].offset == acknowledgement->offset))
+        {
+            found = &records[middle];
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+
+    VERBOSE_LEAVE("retVal = <%p>", found);
+    return found;
+}
@@ -0,0 +1,188 @@
+/*!**********************************************************************
+*
+* @copyright Copyright (C) 2016 Siemens Aktiengesellschaft.\n
+*            All rights reserved.
+*
+*************************************************************************
+*
+* @file     store_wal.h
+* @date     Oct 17, 2026
+* @brief    Store write-ahead log module header file.
+*
+* Write-ahead log keeps the prepared meta and payload of store data in append-only segment files under a directory.
+* Store data which is written to the log can be released from memory and it survives a restart of the agent.
+* When a store data is acknowledged by the server, an acknowledgement record is appended to the log.
+* Segments are removed from the oldest one on as soon as every store data inside them is acknowledged.
+* Directory is locked against other processes as long as the write-ahead log handle exists.
+*
+************************************************************************/
+
+#ifndef STORE_WAL_H_
+#define STORE_WAL_H_
+
+#include "string_type.h"
+
+/**
+ * @brief A new segment is started when the size of the segment being appended reaches this size in bytes.
+ */
+#define DEFAULT_STORE_WAL_SEGMENT_SIZE (1024 * 1024)
+
+/**
+ * Segment of write-ahead log.
+ */
+typedef struct store_wal_segment_t
+{
+    mcl_uint32_t index;       //!< Index of the segment which is also used in its file name.
+    mcl_size_t pending_count; //!< Number of store data in the segment which are not acknowledged yet.
+} store_wal_segment_t;
+
+/**
+ * Write-ahead log handle.
+ */
+typedef struct store_wal_t
+{
+    char *directory;                 //!< Directory of the segment files.
+    void *lock_descriptor;           //!< File descriptor of the lock file in the directory, the directory is locked as long as it is open.
+    char *path;                      //!< Buffer to compose file names in.
+    mcl_size_t path_size;            //!< Size of @p path.
+    store_wal_segment_t *segments;   //!< Segments which are not removed yet, oldest first. Indexes of segments are consecutive.
+    mcl_size_t segment_count;        //!< Number of segments.
+    mcl_size_t segment_capacity;     //!< Number of segments that @p segments can hold.
+    mcl_uint32_t next_segment_index; //!< Index of the next segment to be started.
+    void *append_descriptor;         //!< File descriptor of the last segment to append records to, NULL if no segment is started since initialization.
+    mcl_size_t append_size;          //!< Size of the last segment.
+    void *read_descriptor;           //!< File descriptor of the segment which payload is read from last time.
+    mcl_uint32_t read_segment_index; //!< Index of the segment @p read_descriptor belongs to.
+} store_wal_t;
+
+/**
+ * Location and size of a store data in write-ahead log.
+ */
+typedef struct store_wal_record_t
+{
+    store_wal_t *store_wal;     //!< Write-ahead log the record belongs to.
+    mcl_uint32_t segment_index; //!< Index of the segment of the record.
+    mcl_size_t offset;          //!< Offset of the record in its segment.
+    mcl_uint32_t data_type;     //!< Type of the store data the record is written for.
+    string_t *content_id;       //!< Content id of the meta of the store data, NULL if it has none.
+    mcl_size_t meta_size;       //!< Size of the meta of the store data.
+    mcl_size_t payload_size;    //!< Size of the payload of the store data.
+} store_wal_record_t;
+
+/**
+ * Callback type to receive the records which are not acknowledged yet during replay of write-ahead log.
+ * Ownership of @p record and @p meta is passed to the callback, @p record is destroyed by #store_wal_record_destroy().
+ */
+typedef E_MCL_ERROR_CODE (*store_wal_replay_callback_t)(store_wal_record_t *record, string_t *meta, void *user_context);
+
+/**
+ * @brief Initializes a write-ahead log with segment files under @p directory.
+ *
+ * Segment files left from a previous run are not read until #store_wal_replay() is called.
+ *
+ * @param [in] directory Existing directory for the segment files.
+ * @param [out] store_wal Initialized write-ahead log handle.
+ * @return
+ * <ul>
+ * <li>#MCL_OK in case of success.</li>
+ * <li>#MCL_NO_FILE_SUPPORT in case the system does not have a file system.</li>
+ * <li>#MCL_OUT_OF_MEMORY in case there is not enough memory in the system to proceed.</li>
+ * <li>#MCL_PATH_NOT_ACCESSIBLE in case the directory can not be locked, e.g. because it is used by another process.</li>
+ * </ul>
+ */
+E_MCL_ERROR_CODE store_wal_initialize(const char *directory, store_wal_t **store_wal);
+
+/**
+ * @brief Reads the segment files left from a previous run and passes each store data which is not acknowledged to @p callback in the order they are appended.
+ *
+ * Must be called once right after #store_wal_initialize(). A record which is not written completely (e.g. because of a power loss) ends the replay of its segment.
+ *
+ * @param [in] store_wal Write-ahead log handle to operate.
+ * @param [in] callback Callback to receive the records.
+ * @param [in] user_context User context passed to @p callback.
+ * @return
+ * <ul>
+ * <li>#MCL_OK in case of success.</li>
+ * <li>#MCL_OUT_OF_MEMORY in case there is not enough memory in the system to proceed.</li>
+ * <li>Error code returned by @p callback in case it fails.</li>
+ * </ul>
+ */
+E_MCL_ERROR_CODE store_wal_replay(store_wal_t *store_wal, store_wal_replay_callback_t callback, void *user_context);
+
+/**
+ * @brief Appends meta and payload of a store data to write-ahead log.
+ *
+ * Record is synchronized to the storage medium before this function returns.
+ *
+ * @param [in] store_wal Write-ahead log handle to operate.
+ * @param [in] data_type Type of the store data.
+ * @param [in] content_id Content id of the meta of the store data, NULL if it has none.
+ * @param [in] meta Meta of the store data.
+ * @param [in] payload Payload of the store data.
+ * @param [in] payload_size Size of @p payload.
+ * @param [out] record Record of the appended store data.
+ * @return
+ * <ul>
+ * <li>#MCL_OK in case of success.</li>
+ * <li>#MCL_OUT_OF_MEMORY in case there is not enough memory in the system to proceed.</li>
+ * <li>#MCL_FILE_CANNOT_BE_OPENED in case a new segment file can not be created.</li>
+ * <li>#MCL_FAIL in case the record can not be written.</li>
+ * </ul>
+ */
+E_MCL_ERROR_CODE store_wal_append(store_wal_t *store_wal, mcl_uint32_t data_type, const string_t *content_id, const string_t *meta, const mcl_uint8_t *payload,
+                                  mcl_size_t payload_size, store_wal_record_t **record);
+
+/**
+ * @brief Reads payload of a record from its segment.
+ *
+ * @param [in] record Record to read payload of.
+ * @param [in] offset Offset in the payload to start reading from.
+ * @param [out] destination Buffer to read payload into.
+ * @param [in] size Number of bytes to read.
+ * @return Number of bytes read.
+ */
+mcl_size_t store_wal_read_payload(store_wal_record_t *record, mcl_size_t offset, void *destination, mcl_size_t size);
+
+/**
+ * @brief Marks a record as acknowledged by the server.
+ *
+ * Acknowledgement is flushed right away, so that it survives a restart of the agent. It is synchronized to the storage medium
+ * by #store_wal_trim(), an acknowledgement lost by a power loss before that only causes the store data to be sent again.
+ *
+ * @param [in] record Record to acknowledge. Record itself is not destroyed.
+ * @return
+ * <ul>
+ * <li>#MCL_OK in case of success.</li>
+ * <li>#MCL_FILE_CANNOT_BE_OPENED in case a new segment file can not be created.</li>
+ * <li>#MCL_FAIL in case the acknowledgement can not be written.</li>
+ * </ul>
+ */
+E_MCL_ERROR_CODE store_wal_acknowledge(store_wal_record_t *record);
+
+/**
+ * @brief Synchronizes acknowledgements to the storage medium and removes the oldest segments which have no pending store data left.
+ *
+ * @param [in] store_wal Write-ahead log handle to operate.
+ * @return
+ * <ul>
+ * <li>#MCL_OK in case of success.</li>
+ * <li>#MCL_FAIL in case the log can not be updated.</li>
+ * </ul>
+ */
+E_MCL_ERROR_CODE store_wal_trim(store_wal_t *store_wal);
+
+/**
+ * @brief Destroys a record together with its content id. Record is not acknowledged.
+ *
+ * @param [in] record Record to destroy.
+ */
+void store_wal_record_destroy(store_wal_record_t **record);
+
+/**
+ * @brief Closes segment files, unlocks the directory and destroys the write-ahead log handle. Segment files are kept to be replayed later.
+ *
+ * @param [in] store_wal Write-ahead log handle to destroy.
+ */
+void store_wal_destroy(store_wal_t **store_wal);
+
+#endif //STORE_WAL_H_
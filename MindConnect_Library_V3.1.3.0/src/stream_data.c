@@ -11,6 +11,8 @@
 *
 ************************************************************************/
 
+#define MEMORY_CATEGORY MCL_MEMORY_CATEGORY_STORE
+
 #include "mcl/mcl_common.h"
 #include "mcl/mcl_custom_data.h"
 #include "stream_data.h"
@@ -171,6 +171,28 @@ string_t *string_array_to_string(string_array_t *array)
     return final_string;
 }
 
+void string_array_truncate(string_array_t *array, mcl_size_t count)
+{
+    DEBUG_ENTRY("string_array_t *array = <%p>, mcl_size_t count = <%u>", array, count)
+
+    while (array->index > count)
+    {
+        string_array_item_t *item = &(array->items[--array->index]);
+
+        array->total_length -= item->string->length;
+
+        if (MCL_TRUE == item->destroy)
+        {
+            string_destroy(&(item->string));
+        }
+
+        item->string = MCL_NULL;
+        item->destroy = MCL_FALSE;
+    }
+
+    DEBUG_LEAVE("retVal = void");
+}
+
 void string_array_destroy(string_array_t **array)
 {
     DEBUG_ENTRY("string_array_t **array = <%p>", array)
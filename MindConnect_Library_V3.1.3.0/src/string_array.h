@@ -132,6 +132,16 @@ string_t *string_array_get(string_array_t *array, mcl_size_t index);
  */
 string_t *string_array_to_string(string_array_t *array);
 
+/**
+ * @brief To remove the string items at and after a specified index.
+ *
+ * Removed items are destroyed according to their @c destroy flags. Memory of the array is kept for the items added later.
+ *
+ * @param [in] array String array handle to operate.
+ * @param [in] count Number of items to keep. Nothing is removed if it is not less than the number of items in the array.
+ */
+void string_array_truncate(string_array_t *array, mcl_size_t count);
+
 /**
  * @brief Destroys the string array handle.
  *
@@ -21,14 +21,16 @@ const char *hex_table = "0123456789ABCDEF";
 /// Private Function Prototypes:
 E_MCL_ERROR_CODE _initialize(string_t *string, const char *value, mcl_size_t value_length);
 
-E_MCL_ERROR_CODE string_initialize(const string_t *other, string_t **string)
+E_MCL_ERROR_CODE string_category_initialize(E_MCL_MEMORY_CATEGORY category, const string_t *other, string_t **string)
 {
-    VERBOSE_ENTRY("const string_t *other = <%p>, string_t **string = <%p>", other, string)
+    VERBOSE_ENTRY("E_MCL_MEMORY_CATEGORY category = <%d>, const string_t *other = <%p>, string_t **string = <%p>", category, other, string)
 
 	E_MCL_ERROR_CODE result;
-    MCL_NEW(*string);
+    MCL_CATEGORY_POOL_NEW(*string, category);
     ASSERT_CODE_MESSAGE(MCL_NULL != *string, MCL_OUT_OF_MEMORY, "Not enough memory to allocate for string_t!");
 
+    (*string)->category = (mcl_uint8_t)category;
+
     (*string)->type = MCL_STRING_COPY_DESTROY;
 
     result = _initialize(*string, other->buffer, other->length);
@@ -36,21 +38,23 @@ E_MCL_ERROR_CODE string_initialize(const string_t *other, string_t **string)
     if (MCL_OK != result)
     {
         MCL_ERROR("_initialize_with_option() failed!. Freeing the string_t!");
-        MCL_FREE(*string);
+        MCL_POOL_FREE(*string);
     }
 
     VERBOSE_LEAVE("retVal = <%d>", result);
     return result;
 }
 
-E_MCL_ERROR_CODE string_initialize_new(const char *value, mcl_size_t value_length, string_t **string)
+E_MCL_ERROR_CODE string_category_initialize_new(E_MCL_MEMORY_CATEGORY category, const char *value, mcl_size_t value_length, string_t **string)
 {
-    VERBOSE_ENTRY("const char *value = <%s>, mcl_size_t value_length = <%u>, string_t **string = <%p>", value, value_length, string)
+    VERBOSE_ENTRY("E_MCL_MEMORY_CATEGORY category = <%d>, const char *value = <%s>, mcl_size_t value_length = <%u>, string_t **string = <%p>", category, value, value_length, string)
 
 	E_MCL_ERROR_CODE result;
-    MCL_NEW(*string);
+    MCL_CATEGORY_POOL_NEW(*string, category);
     ASSERT_CODE_MESSAGE(MCL_NULL != *string, MCL_OUT_OF_MEMORY, "Not enough memory to allocate for string_t!");
 
+    (*string)->category = (mcl_uint8_t)category;
+
     (*string)->type = MCL_STRING_COPY_DESTROY;
 
     result = _initialize(*string, value, value_length);
@@ -58,21 +62,23 @@ E_MCL_ERROR_CODE string_initialize_new(const char *value, mcl_size_t value_lengt
     if (MCL_OK != result)
     {
         MCL_ERROR("_initialize_with_option() failed!. Freeing the string_t!");
-        MCL_FREE(*string);
+        MCL_POOL_FREE(*string);
     }
 
     VERBOSE_LEAVE("retVal = <%d>", result);
     return result;
 }
 
-E_MCL_ERROR_CODE string_initialize_dynamic(const char *value, mcl_size_t value_length, string_t **string)
+E_MCL_ERROR_CODE string_category_initialize_dynamic(E_MCL_MEMORY_CATEGORY category, const char *value, mcl_size_t value_length, string_t **string)
 {
-    VERBOSE_ENTRY("const char *value = <%s>, mcl_size_t value_length = <%u>, string_t **string = <%p>", value, value_length, string)
+    VERBOSE_ENTRY("E_MCL_MEMORY_CATEGORY category = <%d>, const char *value = <%s>, mcl_size_t value_length = <%u>, string_t **string = <%p>", category, value, value_length, string)
 
 	E_MCL_ERROR_CODE result;
-    MCL_NEW(*string);
+    MCL_CATEGORY_POOL_NEW(*string, category);
     ASSERT_CODE_MESSAGE(MCL_NULL != *string, MCL_OUT_OF_MEMORY, "Not enough memory to allocate for string_t!");
 
+    (*string)->category = (mcl_uint8_t)category;
+
     (*string)->type = MCL_STRING_NOT_COPY_DESTROY;
 
     result = _initialize(*string, value, value_length);
@@ -80,21 +86,23 @@ E_MCL_ERROR_CODE string_initialize_dynamic(const char *value, mcl_size_t value_l
     if (MCL_OK != result)
     {
         MCL_ERROR("_initialize_with_option() failed!. Freeing the string_t!");
-        MCL_FREE(*string);
+        MCL_POOL_FREE(*string);
     }
 
     VERBOSE_LEAVE("retVal = <%d>", result);
     return result;
 }
 
-E_MCL_ERROR_CODE string_initialize_static(const char *value, mcl_size_t value_length, string_t **string)
+E_MCL_ERROR_CODE string_category_initialize_static(E_MCL_MEMORY_CATEGORY category, const char *value, mcl_size_t value_length, string_t **string)
 {
-    VERBOSE_ENTRY("const char *value = <%s>, mcl_size_t value_length = <%u>, string_t **string = <%p>", value, value_length, string)
+    VERBOSE_ENTRY("E_MCL_MEMORY_CATEGORY category = <%d>, const char *value = <%s>, mcl_size_t value_length = <%u>, string_t **string = <%p>", category, value, value_length, string)
 
 	E_MCL_ERROR_CODE result;
-    MCL_NEW(*string);
+    MCL_CATEGORY_POOL_NEW(*string, category);
     ASSERT_CODE_MESSAGE(MCL_NULL != *string, MCL_OUT_OF_MEMORY, "Not enough memory to allocate for string_t!");
 
+    (*string)->category = (mcl_uint8_t)category;
+
     (*string)->type = MCL_STRING_NOT_COPY_NOT_DESTROY;
 
     result = _initialize(*string, value, value_length);
@@ -102,7 +110,7 @@ E_MCL_ERROR_CODE string_initialize_static(const char *value, mcl_size_t value_le
     if (MCL_OK != result)
     {
         MCL_ERROR("_initialize_with_option() failed!. Freeing the string_t!");
-        MCL_FREE(*string);
+        MCL_POOL_FREE(*string);
     }
 
     VERBOSE_LEAVE("retVal = <%d>", result);
@@ -189,7 +197,7 @@ E_MCL_ERROR_CODE string_split(string_t *string, const char token, list_t **strin
 	string_t *current_part;
 	mcl_size_t index;
 
-    result = list_initialize(string_list);
+    result = list_category_initialize((E_MCL_MEMORY_CATEGORY)string->category, string_list);
     ASSERT_CODE_MESSAGE(MCL_OK == result, result, "mcl_list initialize failed!");
 
     list = *string_list;
@@ -205,7 +213,7 @@ E_MCL_ERROR_CODE string_split(string_t *string, const char token, list_t **strin
             // add contents of temp_buffer into the list ( if any ):
             if (temp_length > 0)
             {
-                if (MCL_OK != (result = string_initialize_new(temp_buffer, temp_length, &current_part)))
+                if (MCL_OK != (result = string_category_initialize_new((E_MCL_MEMORY_CATEGORY)string->category, temp_buffer, temp_length, &current_part)))
                 {
                     MCL_ERROR("string_initialize_new failed!");
                     temp_length = 0;
@@ -240,7 +248,7 @@ E_MCL_ERROR_CODE string_split(string_t *string, const char token, list_t **strin
     // check if there is still something to add :
     if ((MCL_OK == result) && ((temp_length > 0) && (MCL_NULL_CHAR != *temp_buffer)))
     {
-        if (MCL_OK != (result = string_initialize_new(temp_buffer, temp_length, &current_part)))
+        if (MCL_OK != (result = string_category_initialize_new((E_MCL_MEMORY_CATEGORY)string->category, temp_buffer, temp_length, &current_part)))
         {
             MCL_ERROR("string_initialize_new failed!");
         }
@@ -302,7 +310,12 @@ void string_release(string_t *string)
     if (MCL_NULL != string->buffer)
     {
         // free the buffer according to the type :
-        if ((MCL_STRING_COPY_DESTROY == string->type) || (MCL_STRING_NOT_COPY_DESTROY == string->type))
+        if (string->inline_buffer == string->buffer)
+        {
+            MCL_VERBOSE("Content is stored inline. Not freeing the buffer.");
+            string->buffer = MCL_NULL;
+        }
+        else if ((MCL_STRING_COPY_DESTROY == string->type) || (MCL_STRING_NOT_COPY_DESTROY == string->type))
         {
             MCL_VERBOSE("Type is MCL_STRING_COPY_DESTROY or MCL_STRING_NOT_COPY_DESTROY. Freeing the buffer.");
             MCL_FREE(string->buffer);
@@ -330,12 +343,44 @@ void string_destroy(string_t **string)
     if (MCL_NULL != *string)
     {
         string_release(*string);
-        MCL_FREE(*string);
+        MCL_POOL_FREE(*string);
     }
 
     VERBOSE_LEAVE("retVal = void");
 }
 
+E_MCL_ERROR_CODE string_detach(string_t **string, char **buffer)
+{
+    VERBOSE_ENTRY("string_t **string = <%p>, char **buffer = <%p>", string, buffer)
+
+    E_MCL_ERROR_CODE code = MCL_OK;
+
+    if ((*string)->inline_buffer == (*string)->buffer)
+    {
+        MCL_VERBOSE("Content is stored inline. It will be copied into a new buffer.");
+
+        *buffer = MCL_CATEGORY_MALLOC((*string)->length + 1, (E_MCL_MEMORY_CATEGORY)(*string)->category);
+
+        if (MCL_NULL != *buffer)
+        {
+            string_util_memcpy(*buffer, (*string)->buffer, (*string)->length + 1);
+        }
+        else
+        {
+            code = MCL_OUT_OF_MEMORY;
+        }
+    }
+    else
+    {
+        *buffer = (*string)->buffer;
+    }
+
+    MCL_POOL_FREE(*string);
+
+    VERBOSE_LEAVE("retVal = <%d>", code);
+    return code;
+}
+
 E_MCL_ERROR_CODE _initialize(string_t *string, const char *value, mcl_size_t value_length)
 {
     VERBOSE_ENTRY("string_t *string = <%p>, const char *value = <%s>, mcl_size_t value_length = <%u>", string, value, value_length)
@@ -362,8 +407,8 @@ E_MCL_ERROR_CODE _initialize(string_t *string, const char *value, mcl_size_t val
         {
             MCL_VERBOSE("Copy Flag is TRUE : Given value parameter will be copied into the buffer");
 
-            // allocate buffer
-            string->buffer = MCL_MALLOC(length + 1);
+            // use the inline buffer for short contents, allocate buffer otherwise
+            string->buffer = (STRING_INLINE_BUFFER_SIZE > length) ? string->inline_buffer : MCL_CATEGORY_MALLOC(length + 1, (E_MCL_MEMORY_CATEGORY)string->category);
             ASSERT_CODE_MESSAGE(MCL_NULL != string->buffer, MCL_OUT_OF_MEMORY, "Memory couldn't be allocated for string_t");
 
             // set empty right away otherwise might corrupts the mem in _strncpy since it tries to log the input parameters:
@@ -392,7 +437,7 @@ E_MCL_ERROR_CODE _initialize(string_t *string, const char *value, mcl_size_t val
     {
         MCL_VERBOSE("NULL value received, but new string with given length (> 0) requested. Buffer for string will be allocated and zero-terminated. Buffer remains uninitialized.");
 
-        string->buffer = MCL_MALLOC(value_length + 1);
+        string->buffer = (STRING_INLINE_BUFFER_SIZE > value_length) ? string->inline_buffer : MCL_CATEGORY_MALLOC(value_length + 1, (E_MCL_MEMORY_CATEGORY)string->category);
         ASSERT_CODE_MESSAGE(MCL_NULL != string->buffer, MCL_OUT_OF_MEMORY, "Memory couldn't be allocated for string_t");
 
         string->length = value_length;
@@ -420,7 +465,7 @@ E_MCL_ERROR_CODE string_concatenate(string_t *string_1, string_t *string_2, stri
     E_MCL_ERROR_CODE code = MCL_FAIL;
     mcl_size_t result_length = string_1->length + string_2->length;
 
-    if (MCL_OK == (code = string_initialize_new(MCL_NULL, result_length, result)))
+    if (MCL_OK == (code = string_category_initialize_new((E_MCL_MEMORY_CATEGORY)string_1->category, MCL_NULL, result_length, result)))
     {
         code = string_util_snprintf((*result)->buffer, result_length + 1, "%s%s", string_1->buffer, string_2->buffer);
         ASSERT_STATEMENT_CODE_MESSAGE(MCL_OK == code, string_destroy(result), code, "Cannot concatenate strings.");
@@ -446,7 +491,7 @@ E_MCL_ERROR_CODE string_replace(string_t *source, const char *old_string, const
     new_string_length = string_util_strlen(new_string);
 	target_string_length = source->length - old_string_length + new_string_length;
 
-	target_string = MCL_CALLOC(target_string_length + 1, 1);
+	target_string = MCL_CATEGORY_CALLOC(target_string_length + 1, 1, (E_MCL_MEMORY_CATEGORY)source->category);
 	ASSERT_CODE_MESSAGE(MCL_NULL != target_string, MCL_OUT_OF_MEMORY, "Could not allocate memory for target_string");
 
 	register_keyword_found = string_util_find(source->buffer, old_string, &start_index);
@@ -456,7 +501,7 @@ E_MCL_ERROR_CODE string_replace(string_t *source, const char *old_string, const
 	string_util_strncat(target_string, new_string, new_string_length);
 	string_util_strncat(target_string, source->buffer + start_index + old_string_length, source->length - (start_index + old_string_length));
 
-	code = string_initialize_dynamic(target_string, target_string_length, result);
+	code = string_category_initialize_dynamic((E_MCL_MEMORY_CATEGORY)source->category, target_string, target_string_length, result);
 
 	VERBOSE_LEAVE("retVal = <%d>", code);
 	return code;
@@ -473,7 +518,7 @@ E_MCL_ERROR_CODE string_concatenate_cstr(string_t *string, char *c_string, strin
     c_string_length = string_util_strlen(c_string);
     result_length = string->length + c_string_length;
 
-	code = string_initialize_new(MCL_NULL, result_length, result);
+	code = string_category_initialize_new((E_MCL_MEMORY_CATEGORY)string->category, MCL_NULL, result_length, result);
     (code == MCL_OK) && (code = string_util_snprintf((*result)->buffer, result_length + 1, "%s%s", string->buffer, c_string));
     ASSERT_STATEMENT_CODE_MESSAGE(MCL_OK == code, string_destroy(result), code, "Cannot concatenate strings.");
 
@@ -19,6 +19,7 @@
 
 #include "list.h"
 #include "string_util.h"
+#include "memory.h"
 
 extern const char *hex_table;
 
@@ -37,14 +38,26 @@ typedef enum E_MCL_STRING_TYPE
     MCL_STRING_NOT_COPY_NOT_DESTROY //!< Strings with this type will <b>NOT</b> allocate its buffer during initialization (buffer only points of the initial value) and <b>NOT</b> free its buffer during destroy (freeing the buffer will be responsibility of the caller).
 } E_MCL_STRING_TYPE;
 
+/**
+ * @brief Size of the buffer inside #string_t which short contents of #MCL_STRING_COPY_DESTROY strings are copied into.
+ *
+ * A GUID, a timestamp or a quality code fits into it together with its terminating null character.
+ */
+#define STRING_INLINE_BUFFER_SIZE 40
+
 /**
  * #string_t object definition.
+ *
+ * Contents of #MCL_STRING_COPY_DESTROY strings shorter than #STRING_INLINE_BUFFER_SIZE are copied into @p inline_buffer and
+ * @p buffer points to it, so @p buffer is always used to access the content. A #string_t must therefore not be copied by value.
  */
 typedef struct string_t
 {
     char *buffer;           //!< Buffer of string handle.
     mcl_size_t length;      //!< Length of buffer.
     E_MCL_STRING_TYPE type; //!< Type of copy and destroy.
+    mcl_uint8_t category;   //!< #E_MCL_MEMORY_CATEGORY which the string and its buffer are accounted to.
+    char inline_buffer[STRING_INLINE_BUFFER_SIZE]; //!< Buffer for short contents, not used by constant strings.
 } string_t;
 
 /**
@@ -52,6 +65,7 @@ typedef struct string_t
  *
  * The content of the buffer of the @p other string will be copied into the new string's buffer. The type of the string will be #MCL_STRING_COPY_DESTROY.
  *
+ * @param [in] category Category which the string and its buffer are accounted to.
  * @param [in] other Other #string_t object to initialize from.
  * @param [out] string Will point to the initialized #string_t object.
  * @return
@@ -60,7 +74,12 @@ typedef struct string_t
  * <li>#MCL_OUT_OF_MEMORY in case there is not enough memory in the system to proceed.</li>
  * </ul>
  */
-E_MCL_ERROR_CODE string_initialize(const string_t *other, string_t **string);
+E_MCL_ERROR_CODE string_category_initialize(E_MCL_MEMORY_CATEGORY category, const string_t *other, string_t **string);
+
+/**
+ * @brief Calls #string_category_initialize() with the category of the calling module, see #MEMORY_CATEGORY.
+ */
+#define string_initialize(other, string) string_category_initialize(MEMORY_CATEGORY, other, string)
 
 /**
  * @brief Initializes a <i>new</i> #string_t object with the given value and length.
@@ -75,6 +94,7 @@ E_MCL_ERROR_CODE string_initialize(const string_t *other, string_t **string);
  *
  * @warning The given @p value must be a zero-terminated C string.
  *
+ * @param [in] category Category which the string and its buffer are accounted to.
  * @param [in] value The content to initialize the string with. If it is not NULL it will be copied into the buffer of the string. If it is NULL, an empty string with NULL buffer will be created.
  * @param [in] value_length The length of the @p value. If this length is non zero it will be accepted as the correct length of the string. If the length is not known can be passed as zero and initialize function will calculate the length itself.
  * @param [out] string Will point to the initialized #string_t object.
@@ -84,7 +104,12 @@ E_MCL_ERROR_CODE string_initialize(const string_t *other, string_t **string);
  * <li>#MCL_OUT_OF_MEMORY in case there is not enough memory in the system to proceed.</li>
  * </ul>
  */
-E_MCL_ERROR_CODE string_initialize_new(const char *value, mcl_size_t value_length, string_t **string);
+E_MCL_ERROR_CODE string_category_initialize_new(E_MCL_MEMORY_CATEGORY category, const char *value, mcl_size_t value_length, string_t **string);
+
+/**
+ * @brief Calls #string_category_initialize_new() with the category of the calling module, see #MEMORY_CATEGORY.
+ */
+#define string_initialize_new(value, value_length, string) string_category_initialize_new(MEMORY_CATEGORY, value, value_length, string)
 
 /**
  * @brief Initializes a <i>dynamic</i> #string_t object with the given value and length.
@@ -100,6 +125,7 @@ E_MCL_ERROR_CODE string_initialize_new(const char *value, mcl_size_t value_lengt
  *
  * @warning The given @p value must be a zero-terminated C string.
  *
+ * @param [in] category Category which the string and its buffer are accounted to.
  * @param [in] value The content to initialize the string with. If it is not NULL it will be copied into the buffer of the string. If it is NULL, an empty string with NULL buffer will be created.
  * @param [in] value_length The length of the @p value. If this length is non zero it will be accepted as the correct length of the string. If the length is not known can be passed as zero and initialize function will calculate the length itself.
  * @param [out] string Will point to the initialized #string_t object.
@@ -109,7 +135,12 @@ E_MCL_ERROR_CODE string_initialize_new(const char *value, mcl_size_t value_lengt
  * <li>#MCL_OUT_OF_MEMORY in case there is not enough memory in the system to proceed.</li>
  * </ul>
  */
-E_MCL_ERROR_CODE string_initialize_dynamic(const char *value, mcl_size_t value_length, string_t **string);
+E_MCL_ERROR_CODE string_category_initialize_dynamic(E_MCL_MEMORY_CATEGORY category, const char *value, mcl_size_t value_length, string_t **string);
+
+/**
+ * @brief Calls #string_category_initialize_dynamic() with the category of the calling module, see #MEMORY_CATEGORY.
+ */
+#define string_initialize_dynamic(value, value_length, string) string_category_initialize_dynamic(MEMORY_CATEGORY, value, value_length, string)
 
 /**
  * @brief Initializes a <i>static</i> #string_t object with the given value and length.
@@ -127,6 +158,7 @@ E_MCL_ERROR_CODE string_initialize_dynamic(const char *value, mcl_size_t value_l
  *
  * @warning The given @p value must be a zero-terminated C string.
  *
+ * @param [in] category Category which the string and its buffer are accounted to.
  * @param [in] value The content to initialize the string with. If it is not NULL it will be copied into the buffer of the string. If it is NULL, an empty string with NULL buffer will be created.
  * @param [in] value_length The length of the @p value. If this length is non zero it will be accepted as the correct length of the string. If the length is not known can be passed as zero and initialize function will calculate the length itself.
  * @param [out] string Will point to the initialized #string_t object.
@@ -136,7 +168,12 @@ E_MCL_ERROR_CODE string_initialize_dynamic(const char *value, mcl_size_t value_l
  * <li>#MCL_OUT_OF_MEMORY in case there is not enough memory in the system to proceed.</li>
  * </ul>
  */
-E_MCL_ERROR_CODE string_initialize_static(const char *value, mcl_size_t value_length, string_t **string);
+E_MCL_ERROR_CODE string_category_initialize_static(E_MCL_MEMORY_CATEGORY category, const char *value, mcl_size_t value_length, string_t **string);
+
+/**
+ * @brief Calls #string_category_initialize_static() with the category of the calling module, see #MEMORY_CATEGORY.
+ */
+#define string_initialize_static(value, value_length, string) string_category_initialize_static(MEMORY_CATEGORY, value, value_length, string)
 
 /**
  * @brief Sets the buffer of the string with a new value.
@@ -185,6 +222,8 @@ E_MCL_ERROR_CODE string_compare_with_cstr(const string_t *string, const char *ot
 /**
  * @brief Splits the string with the given char and returns the result as an #list_t of #string_t's.
  *
+ * The list and the split strings are accounted to the category of @p string.
+ *
  * @param [in] string String handler to split.
  * @param [in] token Char value to split the string.
  * @param [out] string_list The prepared list containing the splitted strings.
@@ -231,9 +270,27 @@ void string_release(string_t *string);
  */
 void string_destroy(string_t **string);
 
+/**
+ * @brief Destroys the string handler but keeps its buffer.
+ *
+ * String handlers must be destroyed by the string module, this function is used when only the buffer of a string is needed.
+ * If the content is stored inside the string handler, it is copied into a new buffer.
+ *
+ * @param [in] string Address of the string handler to destroy. It's value will be set to #MCL_NULL after destroying, also in case of failure.
+ * @param [out] buffer Buffer of the string, which is owned by the caller afterwards. #MCL_NULL if the buffer of the string is #MCL_NULL.
+ * @return
+ * <ul>
+ * <li>#MCL_OK in case of success.</li>
+ * <li>#MCL_OUT_OF_MEMORY in case there is not enough memory in the system to proceed.</li>
+ * </ul>
+ */
+E_MCL_ERROR_CODE string_detach(string_t **string, char **buffer);
+
 /**
  * @brief Concatenates two strings of type @c string_t into a @c string_t.
  *
+ * The result is accounted to the category of @p string.
+ *
  * @param [in]  string String to which the @p cstring will be concatenated.
  * @param [in]  c_string Char array which will be concatenated to @p string.
  * @param [out] result The string that is result of the concatenation.
@@ -248,6 +305,8 @@ E_MCL_ERROR_CODE string_concatenate_cstr(string_t *string, char *c_string, strin
 /**
  * @brief Concatenates a C string (i.e. a char array)
  *
+ * The result is accounted to the category of @p string_1.
+ *
  * @param [in]  string_1 String to which the @p string_2 will be concatenated.
  * @param [in]  string_2 String which will be concatenated to @p string_1.
  * @param [out] result The string that is result of the concatenation.
@@ -262,6 +321,8 @@ E_MCL_ERROR_CODE string_concatenate(string_t *string_1, string_t *string_2, stri
 /**
 * @brief Replaces @p old_string with @p new_string.
 *
+* The result is accounted to the category of @p source.
+*
 * @param [in]  source The string in which the replacement will be done.
 * @param [in]  old_string Part of @p source that will be replaced.
 * @param [in]  new_string New string which will be replaced with @p old_string.
@@ -12,6 +12,7 @@
 ************************************************************************/
 
 #include "string_util.h"
+#include "memory.h"
 #include "log_util.h"
 #include "definitions.h"
 #include <string.h>
@@ -141,13 +142,14 @@ char *string_util_strdup(const char *string)
 {
     DEBUG_ENTRY("const char *string = <%s>", string)
 
-    char *result;
+    // Duplicate is allocated with the memory module, so that it can be released with MCL_FREE whichever allocator is set.
+    mcl_size_t size = string_util_strlen(string) + 1;
+    char *result = MCL_MALLOC(size);
 
-#if defined(WIN32) || defined(WIN64)
-    result = _strdup(string);
-#else
-    result = strdup(string);
-#endif
+    if (MCL_NULL != result)
+    {
+        string_util_memcpy(result, string, size);
+    }
 
     DEBUG_LEAVE("retVal = <%p>", result);
     return result;
@@ -238,3 +240,13 @@ long string_util_strtol(const char *source, int base, char **end_pointer)
     DEBUG_LEAVE("retVal = <%u>", result);
     return result;
 }
+
+double string_util_strtod(const char *source, char **end_pointer)
+{
+    DEBUG_ENTRY("char* source = <%p>, char *end_pointer = <%p>", source, end_pointer)
+
+    double result = strtod(source, end_pointer);
+
+    DEBUG_LEAVE("retVal = <%f>", result);
+    return result;
+}
@@ -108,7 +108,7 @@ void string_util_memcpy(void *destination, const void *source, mcl_size_t count)
  * @brief Standard library <b>strdup</b> wrapper.
  *
  * @param [in] string String to duplicate.
- * @return A duplicate of the input @c string.
+ * @return A duplicate of the input @c string, to be released with MCL_FREE.
  */
 char *string_util_strdup(const char *string);
 
@@ -150,4 +150,13 @@ mcl_bool_t string_util_is_space(char character);
  */
 long string_util_strtol(const char *source, int base, char **end_pointer);
 
+/**
+ * @brief Returns the first occurrence of a floating point value in @p source string.
+ *
+ * @param [in] source String that contains the floating point value as string.
+ * @param [out] end_pointer The pointer that points to the one past the last index of floating point value.
+ * @return If a number if found it's value is returned. Otherwise it returns 0.
+ */
+double string_util_strtod(const char *source, char **end_pointer);
+
 #endif //STRING_UTIL_H_
@@ -11,22 +11,37 @@
  *
  ************************************************************************/
 
+#define MEMORY_CATEGORY MCL_MEMORY_CATEGORY_STORE
+
 #include "time_series.h"
 #include "definitions.h"
 #include "memory.h"
 #include "log_util.h"
 #include "mcl/mcl_time_series.h"
 #include "time_util.h"
+#include "string_util.h"
+#include <math.h>
 
 // Private Function Prototypes:
 static E_MCL_ERROR_CODE _initialize_meta(const char *version, const char *configuration_id, const char *routing, time_series_t *time_series);
-static void _destroy_value_set_value(time_series_value_t **value);
+static E_MCL_ERROR_CODE _create_value_set(time_series_t *time_series, const char *timestamp, mcl_size_t value_capacity, mcl_size_t string_pool_capacity,
+                                          time_series_value_set_t **value_set);
+static E_MCL_ERROR_CODE _add_value(time_series_value_set_t *value_set, const char *data_point_id, E_TIME_SERIES_VALUE_TYPE type, time_series_value_data_t value,
+                                   const char *string_value, const char *quality_code);
+static E_MCL_ERROR_CODE _reserve_values(time_series_value_set_t *value_set, mcl_size_t value_capacity);
+static E_MCL_ERROR_CODE _reserve_string_pool(time_series_value_set_t *value_set, mcl_size_t string_pool_capacity);
+static mcl_size_t _add_string_to_pool(time_series_value_set_t *value_set, const char *string, mcl_size_t size);
+static void _append_value(time_series_value_set_t *value_set, E_TIME_SERIES_VALUE_TYPE type, time_series_value_data_t value, mcl_size_t data_point_id,
+                          const char *quality_code, mcl_size_t quality_code_size);
+static time_series_value_set_t *_get_previous_value_set(time_series_value_set_t *value_set);
+static E_MCL_ERROR_CODE _intern_data_point_id(time_series_value_set_t *value_set, time_series_value_set_t *previous_value_set, const char *data_point_id,
+                                              mcl_size_t *id);
 static void _destroy_value_set(time_series_value_set_t **value_set);
 
-E_MCL_ERROR_CODE time_series_initialize(const char *version, const char *configuration_id, const char *routing, time_series_t **time_series)
+E_MCL_ERROR_CODE time_series_initialize(const char *version, const char *configuration_id, const char *routing, intern_table_t *intern_table, time_series_t **time_series)
 {
-	DEBUG_ENTRY("const char *version = <%s>, const char *configuration_id = <%s>, const char *routing = <%p>, time_series_t **time_series = <%p>", version, configuration_id,
-		routing, time_series)
+	DEBUG_ENTRY("const char *version = <%s>, const char *configuration_id = <%s>, const char *routing = <%p>, intern_table_t *intern_table = <%p>, "
+		"time_series_t **time_series = <%p>", version, configuration_id, routing, intern_table, time_series)
 
 	E_MCL_ERROR_CODE code;
     MCL_NEW(*time_series);
@@ -40,6 +55,8 @@ E_MCL_ERROR_CODE time_series_initialize(const char *version, const char *configu
     (*time_series)->meta.payload.version = MCL_NULL;
     (*time_series)->meta.payload.details.time_series_details.configuration_id = MCL_NULL;
     (*time_series)->payload.value_sets = MCL_NULL;
+    (*time_series)->intern_table = intern_table;
+    (*time_series)->arena = memory_arena_get_current();
 
     code = _initialize_meta(version, configuration_id, routing, *time_series);
     ASSERT_STATEMENT_CODE_MESSAGE(MCL_OK == code, time_series_destroy(time_series), code, "Initializing time series meta fields fails.");
@@ -57,6 +74,7 @@ E_MCL_ERROR_CODE mcl_time_series_new_value_set(mcl_time_series_t *time_series, c
 	DEBUG_ENTRY("mcl_time_series_t *time_series = <%p>, const char *timestamp = <%p>, mcl_time_series_value_set_t **value_set = <%p>", time_series, timestamp, value_set)
 	
 	E_MCL_ERROR_CODE code;
+	memory_arena_t *arena;
     ASSERT_NOT_NULL(time_series);
     ASSERT_NOT_NULL(timestamp);
     ASSERT_NOT_NULL(value_set);
@@ -64,24 +82,94 @@ E_MCL_ERROR_CODE mcl_time_series_new_value_set(mcl_time_series_t *time_series, c
     // Validate timestamp.
     ASSERT_CODE_MESSAGE(time_util_validate_timestamp(timestamp), MCL_INVALID_PARAMETER, "Timestamp validation failed.");
 
-    MCL_NEW(*value_set);
-    ASSERT_CODE_MESSAGE(MCL_NULL != *value_set, MCL_OUT_OF_MEMORY, "Memory couldn't be allocated for value_set.");
+    // Value set is allocated from the arena of the store if time series is.
+    arena = memory_arena_set_current(time_series->arena);
+    code = _create_value_set(time_series, timestamp, 0, 0, value_set);
 
-    // Initialize timestamp.
-    code = string_initialize_new(timestamp, 0, &(*value_set)->timestamp);
-    ASSERT_STATEMENT_CODE_MESSAGE(MCL_OK == code, _destroy_value_set(value_set), code, "String initialize fail for timestamp.");
+    // Add new value_set to value_sets.
+    if (MCL_OK == code)
+    {
+        MCL_DEBUG("New value_set will be added to value_sets.");
+        code = list_add(time_series->payload.value_sets, *value_set);
 
-    // Initialize values.
-    code = list_initialize(&(*value_set)->values);
-    ASSERT_STATEMENT_CODE_MESSAGE(MCL_OK == code, _destroy_value_set(value_set), code, "List initialize fail for values.");
+        if (MCL_OK != code)
+        {
+            _destroy_value_set(value_set);
+        }
+    }
 
-    // Link value_set to a parent time_series
-    (*value_set)->parent = time_series;
+    memory_arena_set_current(arena);
+    ASSERT_CODE_MESSAGE(MCL_OK == code, code, "Value set couldn't be created.");
 
-    // Add new value_set to value_sets.
-    MCL_DEBUG("New value_set will be added to value_sets.");
-    code = list_add(time_series->payload.value_sets, *value_set);
-    ASSERT_STATEMENT_CODE_MESSAGE(MCL_OK == code, _destroy_value_set(value_set), code, "Adding value_set to the list failed.");
+    DEBUG_LEAVE("retVal = <%d>", MCL_OK);
+    return MCL_OK;
+}
+
+E_MCL_ERROR_CODE mcl_time_series_add_frame(mcl_time_series_t *time_series, const char *timestamp, mcl_size_t value_count, const char * const *data_point_ids,
+                                           const char * const *values, const char * const *quality_codes, mcl_time_series_value_set_t **value_set)
+{
+    DEBUG_ENTRY("mcl_time_series_t *time_series = <%p>, const char *timestamp = <%p>, mcl_size_t value_count = <%u>, const char * const *data_point_ids = <%p>, "
+                "const char * const *values = <%p>, const char * const *quality_codes = <%p>, mcl_time_series_value_set_t **value_set = <%p>", time_series, timestamp,
+                value_count, data_point_ids, values, quality_codes, value_set)
+
+	E_MCL_ERROR_CODE code;
+	mcl_size_t index;
+	mcl_size_t string_pool_size = 0;
+	time_series_value_data_t value_data;
+	time_series_value_set_t *previous_value_set;
+	memory_arena_t *arena;
+
+    ASSERT_NOT_NULL(time_series);
+    ASSERT_NOT_NULL(timestamp);
+    ASSERT_NOT_NULL(data_point_ids);
+    ASSERT_NOT_NULL(values);
+    ASSERT_NOT_NULL(quality_codes);
+    ASSERT_NOT_NULL(value_set);
+
+    // Validate the whole frame before anything is allocated so that a frame is either added completely or not at all.
+    ASSERT_CODE_MESSAGE(time_util_validate_timestamp(timestamp), MCL_INVALID_PARAMETER, "Timestamp validation failed.");
+
+    for (index = 0; index < value_count; index++)
+    {
+        ASSERT_CODE_MESSAGE((MCL_NULL != data_point_ids[index]) && (MCL_NULL != values[index]) && (MCL_NULL != quality_codes[index]), MCL_TRIGGERED_WITH_NULL,
+                            "Frame contains a NULL data point id, value or quality code.");
+
+        string_pool_size += string_util_strlen(values[index]) + string_util_strlen(quality_codes[index]) + (2 * MCL_NULL_CHAR_SIZE);
+    }
+
+    // Frame is allocated from the arena of the store if time series is.
+    arena = memory_arena_set_current(time_series->arena);
+    code = _create_value_set(time_series, timestamp, value_count, string_pool_size, value_set);
+    memory_arena_set_current(arena);
+    ASSERT_CODE_MESSAGE(MCL_OK == code, code, "Value set couldn't be created for the frame.");
+    previous_value_set = _get_previous_value_set(*value_set);
+
+    // Space is reserved for all values, only interning a new data point id can fail.
+    for (index = 0; (MCL_OK == code) && (index < value_count); index++)
+    {
+        mcl_size_t data_point_id;
+
+        code = _intern_data_point_id(*value_set, previous_value_set, data_point_ids[index], &data_point_id);
+
+        if (MCL_OK == code)
+        {
+            value_data.string_offset = _add_string_to_pool(*value_set, values[index], string_util_strlen(values[index]) + MCL_NULL_CHAR_SIZE);
+            _append_value(*value_set, TIME_SERIES_VALUE_TYPE_STRING, value_data, data_point_id, quality_codes[index],
+                          string_util_strlen(quality_codes[index]) + MCL_NULL_CHAR_SIZE);
+        }
+    }
+
+    // Value set is added to time series only if the complete frame is in it.
+    arena = memory_arena_set_current(time_series->arena);
+    (MCL_OK == code) && (code = list_add(time_series->payload.value_sets, *value_set));
+
+    if (MCL_OK != code)
+    {
+        _destroy_value_set(value_set);
+    }
+
+    memory_arena_set_current(arena);
+    ASSERT_CODE_MESSAGE(MCL_OK == code, code, "Frame couldn't be added to time series.");
 
     DEBUG_LEAVE("retVal = <%d>", MCL_OK);
     return MCL_OK;
@@ -93,31 +181,77 @@ E_MCL_ERROR_CODE mcl_time_series_add_value(mcl_time_series_value_set_t *value_se
                 data_point_id, value, quality_code)
 
 	E_MCL_ERROR_CODE code;
-	time_series_value_t *value_local;
+	time_series_value_data_t value_data;
 
     ASSERT_NOT_NULL(value_set);
     ASSERT_NOT_NULL(data_point_id);
     ASSERT_NOT_NULL(value);
     ASSERT_NOT_NULL(quality_code);
 
-    MCL_NEW(value_local);
-    ASSERT_CODE_MESSAGE(MCL_NULL != value_local, MCL_OUT_OF_MEMORY, "Not enough memory to allocate new value_local.");
+    // Offset of the string value is set when it is added to the string pool.
+    value_data.string_offset = 0;
+    code = _add_value(value_set, data_point_id, TIME_SERIES_VALUE_TYPE_STRING, value_data, value, quality_code);
+
+    DEBUG_LEAVE("retVal = <%d>", code);
+    return code;
+}
+
+E_MCL_ERROR_CODE mcl_time_series_add_double(mcl_time_series_value_set_t *value_set, const char *data_point_id, double value, const char *quality_code)
+{
+    DEBUG_ENTRY("mcl_time_series_value_set_t *value_set = <%p>, const char *data_point_id = <%p>, double value = <%f>, const char *quality_code = <%p>", value_set,
+                data_point_id, value, quality_code)
+
+	E_MCL_ERROR_CODE code;
+	time_series_value_data_t value_data;
+
+    ASSERT_NOT_NULL(value_set);
+    ASSERT_NOT_NULL(data_point_id);
+    ASSERT_NOT_NULL(quality_code);
+    ASSERT_CODE_MESSAGE(!isnan(value) && !isinf(value), MCL_INVALID_PARAMETER, "Value must be a finite number.");
+
+    value_data.double_value = value;
+    code = _add_value(value_set, data_point_id, TIME_SERIES_VALUE_TYPE_DOUBLE, value_data, MCL_NULL, quality_code);
 
-    code = string_initialize_new(data_point_id, 0, &value_local->data_point_id);
-    ASSERT_STATEMENT_CODE_MESSAGE(MCL_OK == code, _destroy_value_set_value(&value_local), code, "String initialize fail for data_point_id");
+    DEBUG_LEAVE("retVal = <%d>", code);
+    return code;
+}
+
+E_MCL_ERROR_CODE mcl_time_series_add_int64(mcl_time_series_value_set_t *value_set, const char *data_point_id, mcl_int64_t value, const char *quality_code)
+{
+    DEBUG_ENTRY("mcl_time_series_value_set_t *value_set = <%p>, const char *data_point_id = <%p>, mcl_int64_t value = <%lld>, const char *quality_code = <%p>", value_set,
+                data_point_id, (long long)value, quality_code)
 
-    code = string_initialize_new(value, 0, &value_local->value);
-    ASSERT_STATEMENT_CODE_MESSAGE(MCL_OK == code, _destroy_value_set_value(&value_local), code, "String initialize fail for value");
+	E_MCL_ERROR_CODE code;
+	time_series_value_data_t value_data;
 
-    code = string_initialize_new(quality_code, 0, &value_local->quality_code);
-    ASSERT_STATEMENT_CODE_MESSAGE(MCL_OK == code, _destroy_value_set_value(&value_local), code, "String initialize fail for quality_code");
+    ASSERT_NOT_NULL(value_set);
+    ASSERT_NOT_NULL(data_point_id);
+    ASSERT_NOT_NULL(quality_code);
 
-    code = list_add(value_set->values, value_local);
-    ASSERT_STATEMENT_CODE_MESSAGE(MCL_OK == code, _destroy_value_set_value(&value_local), code, "Adding value to the list failed.");
+    value_data.int64_value = value;
+    code = _add_value(value_set, data_point_id, TIME_SERIES_VALUE_TYPE_INT64, value_data, MCL_NULL, quality_code);
 
-    MCL_DEBUG("New value added into values array. Current index = <%d>", value_set->values->count);
-    DEBUG_LEAVE("retVal = <%d>", MCL_OK);
-    return MCL_OK;
+    DEBUG_LEAVE("retVal = <%d>", code);
+    return code;
+}
+
+E_MCL_ERROR_CODE mcl_time_series_add_bool(mcl_time_series_value_set_t *value_set, const char *data_point_id, mcl_bool_t value, const char *quality_code)
+{
+    DEBUG_ENTRY("mcl_time_series_value_set_t *value_set = <%p>, const char *data_point_id = <%p>, mcl_bool_t value = <%u>, const char *quality_code = <%p>", value_set,
+                data_point_id, value, quality_code)
+
+	E_MCL_ERROR_CODE code;
+	time_series_value_data_t value_data;
+
+    ASSERT_NOT_NULL(value_set);
+    ASSERT_NOT_NULL(data_point_id);
+    ASSERT_NOT_NULL(quality_code);
+
+    value_data.bool_value = (MCL_FALSE == value) ? MCL_FALSE : MCL_TRUE;
+    code = _add_value(value_set, data_point_id, TIME_SERIES_VALUE_TYPE_BOOL, value_data, MCL_NULL, quality_code);
+
+    DEBUG_LEAVE("retVal = <%d>", code);
+    return code;
 }
 
 void time_series_destroy(time_series_t **time_series)
@@ -147,6 +281,8 @@ static E_MCL_ERROR_CODE _initialize_meta(const char *version, const char *config
                 routing, time_series)
 
     // Note that null check for version, configuration_id and time_series is already done by the caller of this function.
+    mcl_size_t configuration_id_handle;
+    string_t *interned_configuration_id = MCL_NULL;
 
     // Set meta.type.
     E_MCL_ERROR_CODE code = string_initialize_static(meta_field_values[META_FIELD_TYPE_ITEM].buffer, meta_field_values[META_FIELD_TYPE_ITEM].length, &time_series->meta.type);
@@ -172,24 +308,262 @@ static E_MCL_ERROR_CODE _initialize_meta(const char *version, const char *config
     code = string_initialize_new(version, 0, &time_series->meta.payload.version);
     ASSERT_CODE_MESSAGE(MCL_OK == code, code, "String initialize fail for meta.payload.version.");
 
-    // Set configuration_id.
-    code = string_initialize_new(configuration_id, 0, &time_series->meta.payload.details.time_series_details.configuration_id);
+    // Set configuration_id. It refers to the interned string since time series of a store mostly share the same configuration.
+    code = intern_table_add(time_series->intern_table, configuration_id, &configuration_id_handle);
+    (MCL_OK == code) && (interned_configuration_id = intern_table_get(time_series->intern_table, configuration_id_handle));
+    (MCL_OK == code) && (code = string_initialize_static(interned_configuration_id->buffer, interned_configuration_id->length,
+                                                         &time_series->meta.payload.details.time_series_details.configuration_id));
     ASSERT_CODE_MESSAGE(MCL_OK == code, code, "String initialize fail for configuration id.");
 
     DEBUG_LEAVE("retVal = <%d>", MCL_OK);
     return MCL_OK;
 }
 
-static void _destroy_value_set_value(time_series_value_t **value)
+static E_MCL_ERROR_CODE _create_value_set(time_series_t *time_series, const char *timestamp, mcl_size_t value_capacity, mcl_size_t string_pool_capacity,
+                                          time_series_value_set_t **value_set)
 {
-    DEBUG_ENTRY("time_series_value_t **value = <%p>", value)
+    DEBUG_ENTRY("time_series_t *time_series = <%p>, const char *timestamp = <%p>, mcl_size_t value_capacity = <%u>, mcl_size_t string_pool_capacity = <%u>, "
+                "time_series_value_set_t **value_set = <%p>", time_series, timestamp, value_capacity, string_pool_capacity, value_set)
 
-    string_destroy(&(*value)->data_point_id);
-    string_destroy(&(*value)->value);
-    string_destroy(&(*value)->quality_code);
-    MCL_FREE(*value);
+	E_MCL_ERROR_CODE code;
 
-    DEBUG_LEAVE("retVal = void");
+    MCL_NEW(*value_set);
+    ASSERT_CODE_MESSAGE(MCL_NULL != *value_set, MCL_OUT_OF_MEMORY, "Memory couldn't be allocated for value_set.");
+
+    // Columns and string pool are allocated when the first value is added unless capacity is requested.
+    // Value set is not added to time series here, so that the caller can fill it before it becomes visible.
+    (*value_set)->value_count = 0;
+    (*value_set)->value_capacity = 0;
+    (*value_set)->value_types = MCL_NULL;
+    (*value_set)->values = MCL_NULL;
+    (*value_set)->data_point_ids = MCL_NULL;
+    (*value_set)->quality_codes = MCL_NULL;
+    (*value_set)->string_pool = MCL_NULL;
+    (*value_set)->string_pool_size = 0;
+    (*value_set)->string_pool_capacity = 0;
+    (*value_set)->timestamp = MCL_NULL;
+
+    // Initialize timestamp.
+    code = string_initialize_new(timestamp, 0, &(*value_set)->timestamp);
+
+    // Reserve requested capacity.
+    (MCL_OK == code) && (0 < value_capacity) && (code = _reserve_values(*value_set, value_capacity));
+    (MCL_OK == code) && (0 < string_pool_capacity) && (code = _reserve_string_pool(*value_set, string_pool_capacity));
+    ASSERT_STATEMENT_CODE_MESSAGE(MCL_OK == code, _destroy_value_set(value_set), code, "Value set couldn't be initialized.");
+
+    // Link value_set to a parent time_series
+    (*value_set)->parent = time_series;
+
+    DEBUG_LEAVE("retVal = <%d>", MCL_OK);
+    return MCL_OK;
+}
+
+static E_MCL_ERROR_CODE _add_value(time_series_value_set_t *value_set, const char *data_point_id, E_TIME_SERIES_VALUE_TYPE type, time_series_value_data_t value,
+                                   const char *string_value, const char *quality_code)
+{
+    DEBUG_ENTRY("time_series_value_set_t *value_set = <%p>, const char *data_point_id = <%p>, E_TIME_SERIES_VALUE_TYPE type = <%d>, const char *string_value = <%p>, "
+                "const char *quality_code = <%p>", value_set, data_point_id, type, string_value, quality_code)
+
+	E_MCL_ERROR_CODE code;
+	mcl_size_t data_point_id_handle;
+	mcl_size_t quality_code_size = string_util_strlen(quality_code) + MCL_NULL_CHAR_SIZE;
+	mcl_size_t string_value_size = (MCL_NULL == string_value) ? 0 : (string_util_strlen(string_value) + MCL_NULL_CHAR_SIZE);
+	memory_arena_t *arena;
+
+    // Make sure there is enough space for the new value before changing anything. Interning alone does not change the value set.
+    // Columns and string pool grow in the arena of the store if value set is allocated from it.
+    arena = memory_arena_set_current(value_set->parent->arena);
+    code = _intern_data_point_id(value_set, _get_previous_value_set(value_set), data_point_id, &data_point_id_handle);
+    (MCL_OK == code) && (code = _reserve_values(value_set, value_set->value_count + 1));
+    (MCL_OK == code) && (code = _reserve_string_pool(value_set, value_set->string_pool_size + quality_code_size + string_value_size));
+    memory_arena_set_current(arena);
+    ASSERT_CODE_MESSAGE(MCL_OK == code, code, "Memory couldn't be allocated for the new value.");
+
+    if (MCL_NULL != string_value)
+    {
+        value.string_offset = _add_string_to_pool(value_set, string_value, string_value_size);
+    }
+
+    _append_value(value_set, type, value, data_point_id_handle, quality_code, quality_code_size);
+
+    MCL_DEBUG("New value added into values array. Current index = <%d>", value_set->value_count);
+    DEBUG_LEAVE("retVal = <%d>", MCL_OK);
+    return MCL_OK;
+}
+
+static E_MCL_ERROR_CODE _reserve_values(time_series_value_set_t *value_set, mcl_size_t value_capacity)
+{
+    DEBUG_ENTRY("time_series_value_set_t *value_set = <%p>, mcl_size_t value_capacity = <%u>", value_set, value_capacity)
+
+	E_TIME_SERIES_VALUE_TYPE *value_types;
+	time_series_value_data_t *values;
+	mcl_size_t *data_point_ids;
+	mcl_size_t *quality_codes;
+	mcl_size_t new_capacity;
+
+    if (value_capacity <= value_set->value_capacity)
+    {
+        DEBUG_LEAVE("retVal = <%d>", MCL_OK);
+        return MCL_OK;
+    }
+
+    // Grow geometrically to keep the cost of adding a value constant on average.
+    new_capacity = (0 == value_set->value_capacity) ? DEFAULT_VALUES_COUNT : (2 * value_set->value_capacity);
+    new_capacity = (new_capacity < value_capacity) ? value_capacity : new_capacity;
+
+    value_types = MCL_MALLOC(new_capacity * sizeof(E_TIME_SERIES_VALUE_TYPE));
+    values = MCL_MALLOC(new_capacity * sizeof(time_series_value_data_t));
+    data_point_ids = MCL_MALLOC(new_capacity * sizeof(mcl_size_t));
+    quality_codes = MCL_MALLOC(new_capacity * sizeof(mcl_size_t));
+
+    // Columns are replaced only if all of them can be allocated.
+    if ((MCL_NULL == value_types) || (MCL_NULL == values) || (MCL_NULL == data_point_ids) || (MCL_NULL == quality_codes))
+    {
+        MCL_FREE(value_types);
+        MCL_FREE(values);
+        MCL_FREE(data_point_ids);
+        MCL_FREE(quality_codes);
+        MCL_ERROR_RETURN(MCL_OUT_OF_MEMORY, "Memory couldn't be allocated for value columns.");
+    }
+
+    if (0 < value_set->value_count)
+    {
+        string_util_memcpy(value_types, value_set->value_types, value_set->value_count * sizeof(E_TIME_SERIES_VALUE_TYPE));
+        string_util_memcpy(values, value_set->values, value_set->value_count * sizeof(time_series_value_data_t));
+        string_util_memcpy(data_point_ids, value_set->data_point_ids, value_set->value_count * sizeof(mcl_size_t));
+        string_util_memcpy(quality_codes, value_set->quality_codes, value_set->value_count * sizeof(mcl_size_t));
+    }
+
+    MCL_FREE(value_set->value_types);
+    MCL_FREE(value_set->values);
+    MCL_FREE(value_set->data_point_ids);
+    MCL_FREE(value_set->quality_codes);
+
+    value_set->value_types = value_types;
+    value_set->values = values;
+    value_set->data_point_ids = data_point_ids;
+    value_set->quality_codes = quality_codes;
+    value_set->value_capacity = new_capacity;
+
+    DEBUG_LEAVE("retVal = <%d>", MCL_OK);
+    return MCL_OK;
+}
+
+static E_MCL_ERROR_CODE _reserve_string_pool(time_series_value_set_t *value_set, mcl_size_t string_pool_capacity)
+{
+    DEBUG_ENTRY("time_series_value_set_t *value_set = <%p>, mcl_size_t string_pool_capacity = <%u>", value_set, string_pool_capacity)
+
+	char *string_pool;
+	mcl_size_t new_capacity;
+
+    if (string_pool_capacity <= value_set->string_pool_capacity)
+    {
+        DEBUG_LEAVE("retVal = <%d>", MCL_OK);
+        return MCL_OK;
+    }
+
+    new_capacity = (0 == value_set->string_pool_capacity) ? (DEFAULT_VALUES_COUNT * (DEFAULT_VALUE_SIZE + DEFAULT_QUALITY_CODE_SIZE))
+                   : (2 * value_set->string_pool_capacity);
+    new_capacity = (new_capacity < string_pool_capacity) ? string_pool_capacity : new_capacity;
+
+    string_pool = MCL_MALLOC(new_capacity);
+    ASSERT_CODE_MESSAGE(MCL_NULL != string_pool, MCL_OUT_OF_MEMORY, "Memory couldn't be allocated for string pool.");
+
+    if (0 < value_set->string_pool_size)
+    {
+        string_util_memcpy(string_pool, value_set->string_pool, value_set->string_pool_size);
+    }
+
+    MCL_FREE(value_set->string_pool);
+    value_set->string_pool = string_pool;
+    value_set->string_pool_capacity = new_capacity;
+
+    DEBUG_LEAVE("retVal = <%d>", MCL_OK);
+    return MCL_OK;
+}
+
+static mcl_size_t _add_string_to_pool(time_series_value_set_t *value_set, const char *string, mcl_size_t size)
+{
+    DEBUG_ENTRY("time_series_value_set_t *value_set = <%p>, const char *string = <%p>, mcl_size_t size = <%u>", value_set, string, size)
+
+    // Space is already reserved by the caller, size includes the null character.
+    mcl_size_t offset = value_set->string_pool_size;
+
+    string_util_memcpy(value_set->string_pool + offset, string, size);
+    value_set->string_pool_size += size;
+
+    DEBUG_LEAVE("retVal = <%u>", offset);
+    return offset;
+}
+
+static void _append_value(time_series_value_set_t *value_set, E_TIME_SERIES_VALUE_TYPE type, time_series_value_data_t value, mcl_size_t data_point_id,
+                          const char *quality_code, mcl_size_t quality_code_size)
+{
+    VERBOSE_ENTRY("time_series_value_set_t *value_set = <%p>, E_TIME_SERIES_VALUE_TYPE type = <%d>, mcl_size_t data_point_id = <%u>, const char *quality_code = <%p>, "
+                  "mcl_size_t quality_code_size = <%u>", value_set, type, data_point_id, quality_code, quality_code_size)
+
+    // Space is already reserved by the caller for the columns and the strings, data point id is already interned.
+    mcl_size_t index = value_set->value_count;
+
+    value_set->value_types[index] = type;
+    value_set->values[index] = value;
+    value_set->data_point_ids[index] = data_point_id;
+    value_set->quality_codes[index] = _add_string_to_pool(value_set, quality_code, quality_code_size);
+    value_set->value_count++;
+
+    VERBOSE_LEAVE("retVal = void");
+}
+
+static time_series_value_set_t *_get_previous_value_set(time_series_value_set_t *value_set)
+{
+    VERBOSE_ENTRY("time_series_value_set_t *value_set = <%p>", value_set)
+
+	list_node_t *last = value_set->parent->payload.value_sets->last;
+	time_series_value_set_t *previous_value_set = MCL_NULL;
+
+    // Value set is either the last one in time series or not added to time series yet.
+    if ((MCL_NULL != last) && (last->data == value_set))
+    {
+        last = last->prev;
+    }
+
+    if (MCL_NULL != last)
+    {
+        previous_value_set = (time_series_value_set_t *)last->data;
+    }
+
+    VERBOSE_LEAVE("retVal = <%p>", previous_value_set);
+    return previous_value_set;
+}
+
+static E_MCL_ERROR_CODE _intern_data_point_id(time_series_value_set_t *value_set, time_series_value_set_t *previous_value_set, const char *data_point_id,
+                                              mcl_size_t *id)
+{
+    VERBOSE_ENTRY("time_series_value_set_t *value_set = <%p>, time_series_value_set_t *previous_value_set = <%p>, const char *data_point_id = <%p>, mcl_size_t *id = <%p>",
+                  value_set, previous_value_set, data_point_id, id)
+
+	E_MCL_ERROR_CODE code = MCL_OK;
+	mcl_size_t index = value_set->value_count;
+	string_t *hint = MCL_NULL;
+
+    // Values are usually added in the same order of data points for each timestamp,
+    // so data point id at the same index of the previous value set is checked before looking up the intern table.
+    if ((MCL_NULL != previous_value_set) && (index < previous_value_set->value_count))
+    {
+        hint = intern_table_get(value_set->parent->intern_table, previous_value_set->data_point_ids[index]);
+    }
+
+    if ((MCL_NULL != hint) && (MCL_OK == string_util_strncmp(hint->buffer, data_point_id, hint->length + MCL_NULL_CHAR_SIZE)))
+    {
+        *id = previous_value_set->data_point_ids[index];
+    }
+    else
+    {
+        code = intern_table_add(value_set->parent->intern_table, data_point_id, id);
+    }
+
+    VERBOSE_LEAVE("retVal = <%d>", code);
+    return code;
 }
 
 static void _destroy_value_set(time_series_value_set_t **value_set)
@@ -197,9 +571,12 @@ static void _destroy_value_set(time_series_value_set_t **value_set)
     DEBUG_ENTRY("time_series_value_set_t **value_set = <%p>", value_set)
 
     string_destroy(&(*value_set)->timestamp);
-    list_destroy_with_content(&(*value_set)->values, (list_item_destroy_callback)_destroy_value_set_value);
+    MCL_FREE((*value_set)->value_types);
+    MCL_FREE((*value_set)->values);
+    MCL_FREE((*value_set)->data_point_ids);
+    MCL_FREE((*value_set)->quality_codes);
+    MCL_FREE((*value_set)->string_pool);
     MCL_FREE(*value_set);
 
     DEBUG_LEAVE("retVal = void");
 }
-
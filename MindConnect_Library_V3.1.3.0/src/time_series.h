@@ -15,6 +15,7 @@
 #define TIME_SERIES_H_
 
 #include "data_types.h"
+#include "intern_table.h"
 
 /**
  * @brief This struct is used for building the complete message of time series event.
@@ -23,6 +24,8 @@ typedef struct mcl_time_series_t
 {
     item_meta_t meta;              //!< Meta of time series.
     time_series_payload_t payload; //!< Payload of time series.
+    intern_table_t *intern_table;  //!< Intern table of the store which data point ids and configuration id are interned in.
+    memory_arena_t *arena;         //!< Arena of the store which time series is allocated from, NULL if it is allocated from the heap.
 } time_series_t;
 
 /**
@@ -33,6 +36,7 @@ typedef struct mcl_time_series_t
  * @param [in] version Version number of time series event.
  * @param [in] configuration_id Unique identifier of the configuration.
  * @param [in] routing Routing information in meta description of @p time_series. This parameter is optional and can be NULL.
+ * @param [in] intern_table Intern table for data point ids and configuration id. It must not be destroyed before @p time_series.
  * @param [out] time_series Pointer address of initialized time series data struct.
  * @return
  * <ul>
@@ -40,7 +44,7 @@ typedef struct mcl_time_series_t
  * <li>#MCL_OUT_OF_MEMORY in case there is not enough memory in the system to proceed.</li>
  * </ul>
  */
-E_MCL_ERROR_CODE time_series_initialize(const char *version, const char *configuration_id, const char *routing, time_series_t **time_series);
+E_MCL_ERROR_CODE time_series_initialize(const char *version, const char *configuration_id, const char *routing, intern_table_t *intern_table, time_series_t **time_series);
 
 /**
  * @brief To destroy the @c time_series_t data struct.
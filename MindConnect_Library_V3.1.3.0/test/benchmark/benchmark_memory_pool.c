@@ -0,0 +1,134 @@
+/*!**********************************************************************
+*
+* @copyright Copyright (C) 2016 Siemens Aktiengesellschaft.\n
+*            All rights reserved.
+*
+*************************************************************************
+*
+* @file     benchmark_memory_pool.c
+* @date     Oct 17, 2026
+* @brief    Benchmark counting heap allocations made while a time series of 100k values is built and destroyed.
+*
+* Heap allocations are counted by interposing malloc family with glibc, only the elapsed time is measured on other platforms.
+* Run the benchmark on builds before and after a change of memory management to compare allocation counts.
+* Peak of the memory requested by MCL is printed if MCL is built with MCL_MEMORY_TELEMETRY option.
+*
+************************************************************************/
+
+#include "mcl/mcl.h"
+#include <stdio.h>
+#include <time.h>
+
+#define VALUES_PER_SET 100
+#define VALUE_SETS 1000
+
+#if defined(__GLIBC__)
+#define COUNT_ALLOCATIONS 1
+
+extern void *__libc_malloc(size_t size);
+extern void *__libc_calloc(size_t count, size_t size);
+extern void *__libc_realloc(void *p, size_t size);
+extern void __libc_free(void *p);
+
+static int counting = 0;
+static unsigned long allocation_count = 0;
+static unsigned long free_count = 0;
+
+void *malloc(size_t size)
+{
+    allocation_count += counting;
+    return __libc_malloc(size);
+}
+
+void *calloc(size_t count, size_t size)
+{
+    allocation_count += counting;
+    return __libc_calloc(count, size);
+}
+
+void *realloc(void *p, size_t size)
+{
+    allocation_count += counting;
+    return __libc_realloc(p, size);
+}
+
+void free(void *p)
+{
+    free_count += (counting && (NULL != p));
+    __libc_free(p);
+}
+#else
+#define COUNT_ALLOCATIONS 0
+static int counting = 0;
+static unsigned long allocation_count = 0;
+static unsigned long free_count = 0;
+#endif
+
+static char data_point_id_buffer[VALUES_PER_SET][37];
+static char value_buffer[VALUES_PER_SET][11];
+
+static E_MCL_ERROR_CODE build_time_series(mcl_store_t *store)
+{
+    mcl_time_series_t *time_series = NULL;
+    int set;
+    E_MCL_ERROR_CODE code = mcl_store_new_time_series(store, "1.0", "e3217e2b-7036-49f2-9814-4c38542cd781", NULL, &time_series);
+
+    for (set = 0; (MCL_OK == code) && (set < VALUE_SETS); set++)
+    {
+        mcl_time_series_value_set_t *value_set;
+        int index;
+
+        code = mcl_time_series_new_value_set(time_series, "2016-04-26T08:06:25.317Z", &value_set);
+
+        for (index = 0; (MCL_OK == code) && (index < VALUES_PER_SET); index++)
+        {
+            code = mcl_time_series_add_value(value_set, data_point_id_buffer[index], value_buffer[index], "00000000");
+        }
+    }
+
+    return code;
+}
+
+int main(void)
+{
+    mcl_store_t *store = NULL;
+    mcl_memory_telemetry_t telemetry;
+    clock_t start;
+    clock_t elapsed;
+    int index;
+    E_MCL_ERROR_CODE code;
+
+    for (index = 0; index < VALUES_PER_SET; index++)
+    {
+        snprintf(data_point_id_buffer[index], sizeof(data_point_id_buffer[index]), "e50ab7ca-fd5d-11e5-8000-001b1bc1%04d", index);
+        snprintf(value_buffer[index], sizeof(value_buffer[index]), "%d", 1000 + index);
+    }
+
+    mcl_memory_reset_peak();
+    start = clock();
+    counting = 1;
+    code = mcl_store_initialize(MCL_FALSE, &store);
+    (MCL_OK == code) && (code = build_time_series(store));
+    mcl_store_destroy(&store);
+    counting = 0;
+    elapsed = clock() - start;
+
+    if (MCL_OK != code)
+    {
+        printf("Building time series failed with code %d.\n", code);
+        return 1;
+    }
+
+    if (COUNT_ALLOCATIONS)
+    {
+        printf("Heap allocations : %lu (%.2f per value)\n", allocation_count, (double)allocation_count / (VALUE_SETS * VALUES_PER_SET));
+        printf("Heap releases    : %lu\n", free_count);
+    }
+    if (MCL_OK == mcl_memory_get_telemetry(&telemetry))
+    {
+        printf("Peak bytes       : %lu (%.2f per value)\n", (unsigned long)telemetry.peak_bytes, (double)telemetry.peak_bytes / (VALUE_SETS * VALUES_PER_SET));
+    }
+    printf("Elapsed          : %.1f ns per value\n", (1e9 * elapsed / CLOCKS_PER_SEC) / ((double)VALUE_SETS * VALUES_PER_SET));
+
+    return 0;
+}
@@ -0,0 +1,156 @@
+/*!**********************************************************************
+*
+* @copyright Copyright (C) 2016 Siemens Aktiengesellschaft.\n
+*            All rights reserved.
+*
+*************************************************************************
+*
+* @file     benchmark_store_packing.c
+* @date     Oct 17, 2026
+* @brief    Benchmark comparing the size-indexed selection of store data with a list scan when packing http requests.
+*
+* Every store data is packed into a request of DEFAULT_HTTP_PAYLOAD_SIZE bytes. Serialization of store data is left out, only the cost to find
+* the next store data which fits into the space left in the request is measured.
+*
+************************************************************************/
+
+#include "mcl/mcl.h"
+#include "store.h"
+#include "definitions.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define MAX_PAYLOAD_SIZE 2000
+
+static mcl_uint8_t payload[MAX_PAYLOAD_SIZE];
+
+// Writes store data from the index picking the largest one which may fit into the space left, as _exchange_pack_store_data() does.
+static mcl_size_t pack_from_index(store_t *store)
+{
+    mcl_size_t space = DEFAULT_HTTP_PAYLOAD_SIZE;
+    mcl_size_t size_class_limit = STORE_SIZE_CLASS_COUNT;
+    mcl_size_t packed_count = 0;
+    store_data_t *store_data;
+
+    while (MCL_NULL != (store_data = store_index_find_prepared_data(&store->high_priority_index, size_class_limit)))
+    {
+        if (store_data->payload_size <= space)
+        {
+            space -= store_data->payload_size;
+            store_data_set_state(store_data, DATA_STATE_WRITTEN);
+            packed_count++;
+        }
+        else
+        {
+            size_class_limit = store_data_get_size_class(store_data);
+        }
+    }
+
+    return packed_count;
+}
+
+// Writes store data walking the store list and starting over from its head as long as anything is written in the last walk.
+static mcl_size_t pack_from_list(store_t *store)
+{
+    mcl_size_t space = DEFAULT_HTTP_PAYLOAD_SIZE;
+    mcl_size_t packed_count = 0;
+    mcl_bool_t added_any = MCL_TRUE;
+    list_node_t *node;
+
+    while (MCL_TRUE == added_any)
+    {
+        added_any = MCL_FALSE;
+
+        for (node = store->high_priority_list->head; MCL_NULL != node; node = node->next)
+        {
+            store_data_t *store_data = (store_data_t *)node->data;
+
+            if ((DATA_STATE_PREPARED == store_data->state) && (store_data->payload_size <= space))
+            {
+                space -= store_data->payload_size;
+                store_data_set_state(store_data, DATA_STATE_WRITTEN);
+                packed_count++;
+                added_any = MCL_TRUE;
+            }
+        }
+    }
+
+    return packed_count;
+}
+
+static double run(mcl_size_t (*pack)(store_t *store), int store_data_count)
+{
+    clock_t total = 0;
+    store_t *store = MCL_NULL;
+    mcl_size_t packed_count;
+    int index;
+    E_MCL_ERROR_CODE code = mcl_store_initialize(MCL_FALSE, (mcl_store_t **)&store);
+
+    srand(1);
+    for (index = 0; (MCL_OK == code) && (index < store_data_count); index++)
+    {
+        mcl_custom_data_t *custom_data = MCL_NULL;
+        mcl_size_t payload_size = 16 + (rand() % (MAX_PAYLOAD_SIZE - 16));
+        store_data_t *store_data;
+
+        code = mcl_store_new_custom_data(store, "1.0", "custom_data_type", NULL, &custom_data);
+        (MCL_OK == code) && (code = mcl_custom_data_set_payload(custom_data, payload, payload_size));
+
+        if (MCL_OK == code)
+        {
+            store_data = (store_data_t *)store->high_priority_list->last->data;
+            store_data->payload_size = payload_size;
+            store_data_set_state(store_data, DATA_STATE_PREPARED);
+        }
+    }
+
+    while ((MCL_OK == code) && (0 < store->high_priority_list->count))
+    {
+        clock_t start = clock();
+        packed_count = pack(store);
+        total += clock() - start;
+
+        // Written store data is sent, remove it from the store :
+        while (MCL_NULL != store->in_flight.head)
+        {
+            store_data_remove(store->high_priority_list, store->in_flight.head->list_node);
+        }
+
+        if (0 == packed_count)
+        {
+            code = MCL_FAIL;
+        }
+    }
+
+    mcl_store_destroy((mcl_store_t **)&store);
+
+    if (MCL_OK != code)
+    {
+        printf("Packing failed with code %d.\n", code);
+        return -1;
+    }
+
+    // Milliseconds to pack every store data.
+    return (1e3 * total) / CLOCKS_PER_SEC;
+}
+
+int main(void)
+{
+    int store_data_counts[] = {10000, 100000};
+    int index;
+    int result = 0;
+
+    for (index = 0; index < 2; index++)
+    {
+        double index_time = run(pack_from_index, store_data_counts[index]);
+        double list_time = run(pack_from_list, store_data_counts[index]);
+
+        printf("%6d store data, size-indexed selection : %10.1f ms\n", store_data_counts[index], index_time);
+        printf("%6d store data, list scan selection    : %10.1f ms\n", store_data_counts[index], list_time);
+
+        ((0 > index_time) || (0 > list_time)) && (result = 1);
+    }
+
+    return result;
+}
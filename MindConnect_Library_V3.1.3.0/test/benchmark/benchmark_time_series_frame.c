@@ -0,0 +1,107 @@
+/*!**********************************************************************
+*
+* @copyright Copyright (C) 2016 Siemens Aktiengesellschaft.\n
+*            All rights reserved.
+*
+*************************************************************************
+*
+* @file     benchmark_time_series_frame.c
+* @date     Oct 17, 2026
+* @brief    Benchmark comparing per value ingestion with frame ingestion of time series values.
+*
+************************************************************************/
+
+#include "mcl/mcl.h"
+#include <stdio.h>
+#include <time.h>
+
+#define FRAME_SIZE 32
+#define FRAMES_PER_ROUND 1000
+#define ROUNDS 20
+
+static const char *timestamp = "2016-04-26T08:06:25.317Z";
+static const char *data_point_ids[FRAME_SIZE];
+static const char *values[FRAME_SIZE];
+static const char *quality_codes[FRAME_SIZE];
+static char data_point_id_buffer[FRAME_SIZE][37];
+static char value_buffer[FRAME_SIZE][11];
+
+static E_MCL_ERROR_CODE add_frame_value_by_value(mcl_time_series_t *time_series)
+{
+    mcl_time_series_value_set_t *value_set;
+    E_MCL_ERROR_CODE code = mcl_time_series_new_value_set(time_series, timestamp, &value_set);
+    int index;
+
+    for (index = 0; (MCL_OK == code) && (index < FRAME_SIZE); index++)
+    {
+        code = mcl_time_series_add_value(value_set, data_point_ids[index], values[index], quality_codes[index]);
+    }
+
+    return code;
+}
+
+static E_MCL_ERROR_CODE add_frame_at_once(mcl_time_series_t *time_series)
+{
+    mcl_time_series_value_set_t *value_set;
+
+    return mcl_time_series_add_frame(time_series, timestamp, FRAME_SIZE, data_point_ids, values, quality_codes, &value_set);
+}
+
+static double run(E_MCL_ERROR_CODE (*add_frame)(mcl_time_series_t *time_series))
+{
+    clock_t total = 0;
+    int round;
+
+    for (round = 0; round < ROUNDS; round++)
+    {
+        mcl_store_t *store = NULL;
+        mcl_time_series_t *time_series = NULL;
+        clock_t start;
+        int frame;
+        E_MCL_ERROR_CODE code = mcl_store_initialize(MCL_FALSE, &store);
+
+        (MCL_OK == code) && (code = mcl_store_new_time_series(store, "1.0", "e3217e2b-7036-49f2-9814-4c38542cd781", NULL, &time_series));
+
+        start = clock();
+        for (frame = 0; (MCL_OK == code) && (frame < FRAMES_PER_ROUND); frame++)
+        {
+            code = add_frame(time_series);
+        }
+        total += clock() - start;
+
+        mcl_store_destroy(&store);
+
+        if (MCL_OK != code)
+        {
+            printf("Adding frame failed with code %d.\n", code);
+            return -1;
+        }
+    }
+
+    // Nanoseconds per value.
+    return (1e9 * total / CLOCKS_PER_SEC) / ((double)ROUNDS * FRAMES_PER_ROUND * FRAME_SIZE);
+}
+
+int main(void)
+{
+    int index;
+    double value_by_value;
+    double frame;
+
+    for (index = 0; index < FRAME_SIZE; index++)
+    {
+        snprintf(data_point_id_buffer[index], sizeof(data_point_id_buffer[index]), "e50ab7ca-fd5d-11e5-8000-001b1bc1%04d", index);
+        snprintf(value_buffer[index], sizeof(value_buffer[index]), "%d", 1000 + index);
+        data_point_ids[index] = data_point_id_buffer[index];
+        values[index] = value_buffer[index];
+        quality_codes[index] = "00000000";
+    }
+
+    value_by_value = run(add_frame_value_by_value);
+    frame = run(add_frame_at_once);
+
+    printf("mcl_time_series_new_value_set + mcl_time_series_add_value : %8.1f ns per value\n", value_by_value);
+    printf("mcl_time_series_add_frame                                 : %8.1f ns per value\n", frame);
+
+    return ((0 > value_by_value) || (0 > frame)) ? 1 : 0;
+}
@@ -0,0 +1,192 @@
+/*!**********************************************************************
+*
+* @copyright Copyright (C) 2018 Siemens Aktiengesellschaft.\n
+*            All rights reserved.
+*
+*************************************************************************
+*
+* @file     test_compression_zlib.c
+* @date     Oct 17, 2018
+* @brief    This file contains test case functions to test compression zlib module.
+*
+************************************************************************/
+
+#include "compression.h"
+#include "compression_zlib.h"
+#include "memory.h"
+#include "unity.h"
+#include "definitions.h"
+#include <zlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#define PAYLOAD_BUFFER_SIZE 8192
+#define OUTPUT_PART_SIZE 64
+
+static char payload[PAYLOAD_BUFFER_SIZE];
+static mcl_size_t payload_size;
+static mcl_uint8_t compressed[PAYLOAD_BUFFER_SIZE];
+static mcl_uint8_t decompressed[PAYLOAD_BUFFER_SIZE];
+
+// Deflates all remaining input of the compression into compressed buffer in small parts and returns the total size written.
+static mcl_size_t _deflate_all(void *compression, mcl_size_t offset);
+
+// Inflates gzip data and returns the size of decompressed data.
+static mcl_size_t _inflate(mcl_uint8_t *data, mcl_size_t data_size);
+
+void setUp(void)
+{
+    mcl_size_t index;
+
+    // Time series like payload with repeated ids and quality codes.
+    payload_size = 0;
+    for (index = 0; index < 64; index++)
+    {
+        payload_size += sprintf(payload + payload_size, "{\"dataPointId\":\"a1b2c3d4-e5f6-4a7b-8c9d-0e1f2a3b4c5d\",\"value\":\"%u\",\"qualityCode\":\"00000000\"},",
+                                (unsigned int)index);
+    }
+}
+
+void tearDown(void)
+{
+}
+
+/**
+ * GIVEN : Compression is initialized.
+ * WHEN  : Whole payload is given as the last input and compressed data is read in small parts.
+ * THEN  : Compressed data is gzip of the payload and much smaller than the payload.
+ */
+void test_deflate_001(void)
+{
+    void *compression = MCL_NULL;
+    mcl_size_t compressed_size;
+    mcl_size_t input_size;
+    mcl_size_t output_size;
+
+    E_MCL_ERROR_CODE code = compression_initialize(&compression);
+    TEST_ASSERT_EQUAL_MESSAGE(MCL_OK, code, "compression_initialize() failed.");
+    TEST_ASSERT_TRUE_MESSAGE(compression_needs_input(compression), "Input is expected before any input is given.");
+
+    compression_set_input(compression, (mcl_uint8_t *)payload, payload_size, MCL_TRUE);
+    TEST_ASSERT_FALSE_MESSAGE(compression_needs_input(compression), "Input is expected after the last input is given.");
+
+    compressed_size = _deflate_all(compression, 0);
+    TEST_ASSERT_TRUE_MESSAGE(compression_is_finished(compression), "Compression is not finished after the last input.");
+    TEST_ASSERT_TRUE_MESSAGE(compressed_size * 5 < payload_size, "Payload is not compressed well.");
+
+    compression_get_sizes(compression, &input_size, &output_size);
+    TEST_ASSERT_EQUAL_MESSAGE(payload_size, input_size, "Input size is wrong.");
+    TEST_ASSERT_EQUAL_MESSAGE(compressed_size, output_size, "Output size is wrong.");
+
+    TEST_ASSERT_EQUAL_MESSAGE(payload_size, _inflate(compressed, compressed_size), "Size of decompressed payload is wrong.");
+    TEST_ASSERT_EQUAL_MEMORY_MESSAGE(payload, decompressed, payload_size, "Decompressed payload is wrong.");
+
+    compression_destroy(&compression);
+    TEST_ASSERT_NULL_MESSAGE(compression, "Compression is not null after destroy.");
+}
+
+/**
+ * GIVEN : Compression is initialized.
+ * WHEN  : Payload is given in parts, as a read callback gives it, followed by an empty last input.
+ * THEN  : Compressed data is gzip of the whole payload.
+ */
+void test_deflate_002(void)
+{
+    void *compression = MCL_NULL;
+    mcl_size_t compressed_size = 0;
+    mcl_size_t offset;
+    mcl_size_t part_size;
+
+    E_MCL_ERROR_CODE code = compression_initialize(&compression);
+    TEST_ASSERT_EQUAL_MESSAGE(MCL_OK, code, "compression_initialize() failed.");
+
+    for (offset = 0; offset < payload_size; offset += part_size)
+    {
+        part_size = ((payload_size - offset) > 1000) ? 1000 : (payload_size - offset);
+        compression_set_input(compression, (mcl_uint8_t *)payload + offset, part_size, MCL_FALSE);
+        compressed_size = _deflate_all(compression, compressed_size);
+        TEST_ASSERT_TRUE_MESSAGE(compression_needs_input(compression), "Input is not consumed.");
+        TEST_ASSERT_FALSE_MESSAGE(compression_is_finished(compression), "Compression is finished before the last input.");
+    }
+
+    compression_set_input(compression, MCL_NULL, 0, MCL_TRUE);
+    compressed_size = _deflate_all(compression, compressed_size);
+    TEST_ASSERT_TRUE_MESSAGE(compression_is_finished(compression), "Compression is not finished after the last input.");
+
+    TEST_ASSERT_EQUAL_MESSAGE(payload_size, _inflate(compressed, compressed_size), "Size of decompressed payload is wrong.");
+    TEST_ASSERT_EQUAL_MEMORY_MESSAGE(payload, decompressed, payload_size, "Decompressed payload is wrong.");
+
+    compression_destroy(&compression);
+}
+
+/**
+ * GIVEN : Compression of a payload is partly read, as when libcurl rewinds the request to resend it.
+ * WHEN  : Compression is reset and the payload is given again.
+ * THEN  : Compressed data is gzip of the payload alone and sizes are counted from the reset.
+ */
+void test_reset_001(void)
+{
+    void *compression = MCL_NULL;
+    mcl_size_t compressed_size;
+    mcl_size_t written_size;
+    mcl_size_t input_size;
+    mcl_size_t output_size;
+
+    E_MCL_ERROR_CODE code = compression_initialize(&compression);
+    TEST_ASSERT_EQUAL_MESSAGE(MCL_OK, code, "compression_initialize() failed.");
+
+    compression_set_input(compression, (mcl_uint8_t *)payload, payload_size, MCL_TRUE);
+    code = compression_deflate(compression, compressed, OUTPUT_PART_SIZE, &written_size);
+    TEST_ASSERT_EQUAL_MESSAGE(MCL_OK, code, "compression_deflate() failed.");
+
+    code = compression_reset(compression);
+    TEST_ASSERT_EQUAL_MESSAGE(MCL_OK, code, "compression_reset() failed.");
+    TEST_ASSERT_TRUE_MESSAGE(compression_needs_input(compression), "Input is not expected after reset.");
+    TEST_ASSERT_FALSE_MESSAGE(compression_is_finished(compression), "Compression is finished after reset.");
+
+    compression_set_input(compression, (mcl_uint8_t *)payload, payload_size, MCL_TRUE);
+    compressed_size = _deflate_all(compression, 0);
+
+    compression_get_sizes(compression, &input_size, &output_size);
+    TEST_ASSERT_EQUAL_MESSAGE(payload_size, input_size, "Input size is not counted from reset.");
+    TEST_ASSERT_EQUAL_MESSAGE(compressed_size, output_size, "Output size is not counted from reset.");
+
+    TEST_ASSERT_EQUAL_MESSAGE(payload_size, _inflate(compressed, compressed_size), "Size of decompressed payload is wrong.");
+    TEST_ASSERT_EQUAL_MEMORY_MESSAGE(payload, decompressed, payload_size, "Decompressed payload is wrong.");
+
+    compression_destroy(&compression);
+}
+
+static mcl_size_t _deflate_all(void *compression, mcl_size_t offset)
+{
+    mcl_size_t written_size;
+
+    do
+    {
+        E_MCL_ERROR_CODE code = compression_deflate(compression, compressed + offset, OUTPUT_PART_SIZE, &written_size);
+        TEST_ASSERT_EQUAL_MESSAGE(MCL_OK, code, "compression_deflate() failed.");
+        offset += written_size;
+    } while (0 != written_size);
+
+    return offset;
+}
+
+static mcl_size_t _inflate(mcl_uint8_t *data, mcl_size_t data_size)
+{
+    z_stream stream;
+    int result;
+
+    memset(&stream, 0, sizeof(stream));
+    TEST_ASSERT_EQUAL(Z_OK, inflateInit2(&stream, 15 + 16));
+
+    stream.next_in = data;
+    stream.avail_in = (uInt)data_size;
+    stream.next_out = decompressed;
+    stream.avail_out = sizeof(decompressed);
+
+    result = inflate(&stream, Z_FINISH);
+    inflateEnd(&stream);
+    TEST_ASSERT_EQUAL_MESSAGE(Z_STREAM_END, result, "Compressed data is not a complete gzip stream.");
+
+    return sizeof(decompressed) - stream.avail_out;
+}
@@ -60,6 +60,24 @@ void test_initialize_002(void)
     // Test http_request_timeout
     TEST_ASSERT_EQUAL_INT_MESSAGE(DEFAULT_HTTP_REQUEST_TIMEOUT, configuration->http_request_timeout, "http_request_timeout is wrong.");
 
+    // Test http_keep_alive
+    TEST_ASSERT_EQUAL_INT_MESSAGE(MCL_TRUE, configuration->http_keep_alive, "http_keep_alive is wrong.");
+
+    // Test http_connection_idle_timeout
+    TEST_ASSERT_EQUAL_INT_MESSAGE(DEFAULT_HTTP_CONNECTION_IDLE_TIMEOUT, configuration->http_connection_idle_timeout, "http_connection_idle_timeout is wrong.");
+
+    // Test http_connection_max_requests
+    TEST_ASSERT_EQUAL_INT_MESSAGE(DEFAULT_HTTP_CONNECTION_MAX_REQUESTS, configuration->http_connection_max_requests, "http_connection_max_requests is wrong.");
+
+    // Test tls_session_cache
+    TEST_ASSERT_EQUAL_INT_MESSAGE(MCL_FALSE, configuration->tls_session_cache, "tls_session_cache is wrong.");
+
+    // Test access_token_refresh_margin
+    TEST_ASSERT_EQUAL_INT_MESSAGE(DEFAULT_ACCESS_TOKEN_REFRESH_MARGIN, configuration->access_token_refresh_margin, "access_token_refresh_margin is wrong.");
+
+    // Test http_compression
+    TEST_ASSERT_EQUAL_INT_MESSAGE(MCL_FALSE, configuration->http_compression, "http_compression is wrong.");
+
     mcl_configuration_destroy(&configuration);
 }
 
@@ -29,6 +29,7 @@
 #include "security.h"
 #include "security_libcrypto.h"
 #include "time_util.h"
+#include <pthread.h>
 
 E_MCL_ERROR_CODE code;
 
@@ -53,6 +54,9 @@ event_list_t *event_list = MCL_NULL;
 
 void setUp(void)
 {
+    // Memory of OpenSSL is allocated through MCL as it is in http processor.
+    security_initialize();
+
     code = event_list_initialize(payload_version, &event_list);
     TEST_ASSERT_EQUAL_MESSAGE(MCL_OK, code, "Initialization failed for event list.");
 }
@@ -240,3 +244,62 @@ void test_destroy_002(void)
 
     mcl_json_util_destroy(&details);
 }
+
+typedef struct event_in_arena_result_t
+{
+    mcl_bool_t event_in_arena;
+    mcl_size_t security_count_before;
+    mcl_size_t security_count_after;
+    E_MCL_ERROR_CODE initialize_code;
+    E_MCL_ERROR_CODE guid_code;
+} event_in_arena_result_t;
+
+// Creates the first event of the thread with an arena as the current arena, so OpenSSL creates the random state of the thread meanwhile.
+static void *_initialize_event_in_arena(void *context)
+{
+    event_in_arena_result_t *result = (event_in_arena_result_t *)context;
+    memory_arena_t *arena = MCL_NULL;
+    event_t *arena_event = MCL_NULL;
+    string_t *guid = MCL_NULL;
+    mcl_memory_usage_t usage;
+
+    memory_arena_initialize(0, MCL_MEMORY_CATEGORY_STORE, &arena);
+
+    mcl_memory_get_usage(MCL_MEMORY_CATEGORY_SECURITY, &usage);
+    result->security_count_before = usage.count;
+
+    memory_arena_set_current(arena);
+    result->initialize_code = event_initialize(event_list->meta, event_payload_type, event_payload_version, severity, timestamp, &arena_event);
+    memory_arena_set_current(MCL_NULL);
+    result->event_in_arena = memory_arena_contains(arena, arena_event);
+
+    mcl_memory_get_usage(MCL_MEMORY_CATEGORY_SECURITY, &usage);
+    result->security_count_after = usage.count;
+
+    // Event is released with the arena, the random state of OpenSSL must survive it.
+    memory_arena_reset(arena);
+    result->guid_code = random_generate_guid(&guid);
+    string_destroy(&guid);
+    memory_arena_destroy(&arena);
+
+    return MCL_NULL;
+}
+
+/**
+ * GIVEN : A thread which has not generated random numbers yet and an arena which is its current arena.
+ * WHEN  : event_initialize() is called and the arena is reset afterwards.
+ * THEN  : Event is allocated from the arena, memory OpenSSL allocates for the thread is allocated from the heap and is still usable after the reset.
+ */
+void test_initialize_002(void)
+{
+    pthread_t thread;
+    event_in_arena_result_t result;
+
+    TEST_ASSERT_EQUAL_MESSAGE(0, pthread_create(&thread, MCL_NULL, _initialize_event_in_arena, &result), "Thread could not be created.");
+    pthread_join(thread, MCL_NULL);
+
+    TEST_ASSERT_EQUAL_MESSAGE(MCL_OK, result.initialize_code, "event_initialize() failed.");
+    TEST_ASSERT_TRUE_MESSAGE(result.event_in_arena, "Event is not allocated from the arena.");
+    TEST_ASSERT_TRUE_MESSAGE(result.security_count_after > result.security_count_before, "Memory of OpenSSL is not allocated from the heap.");
+    TEST_ASSERT_EQUAL_MESSAGE(MCL_OK, result.guid_code, "Random number can not be generated after the arena is reset.");
+}
@@ -17,6 +17,11 @@
 #include "string_util.h"
 #include "definitions.h"
 
+#if !defined(WIN32) && !defined(WIN64)
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
 char *file_name = "temp.txt";
 char *data_written = "123456";
 mcl_size_t data_size = 6;
@@ -166,3 +171,143 @@ void test_fstat_001(void)
     return_code = file_util_fclose(file_descriptor);
     TEST_ASSERT_MESSAGE(MCL_OK == return_code, "File can not be closed.");
 }
+
+/**
+ * GIVEN : A file is opened in read mode and data known a priori is already written to the file.
+ * WHEN  : file_util_ftell is called after a part of the file is read and after file_util_fseek is called.
+ * THEN  : MCL_OK is returned and the position is the size read and the offset sought respectively.
+ */
+void test_ftell_001(void)
+{
+    void *file_descriptor = MCL_NULL;
+    char data_read[4];
+    mcl_size_t actual_data_size = 0;
+    mcl_size_t offset = 0;
+
+    E_MCL_ERROR_CODE return_code = file_util_fopen(file_name, "w", &file_descriptor);
+    TEST_ASSERT_MESSAGE(MCL_OK == return_code, "No support for file handling.");
+    file_util_fputs(data_written, file_descriptor);
+    file_util_fclose(file_descriptor);
+
+    return_code = file_util_fopen(file_name, "r", &file_descriptor);
+    TEST_ASSERT_MESSAGE(MCL_OK == return_code, "No support for file handling.");
+
+    file_util_fread(data_read, sizeof(char), 4, file_descriptor, &actual_data_size);
+    return_code = file_util_ftell(file_descriptor, &offset);
+    TEST_ASSERT_MESSAGE(MCL_OK == return_code, "file_util_ftell() does not return MCL_OK.");
+    TEST_ASSERT_EQUAL_MESSAGE(4, offset, "Position is not the size read.");
+
+    return_code = file_util_fseek(file_descriptor, 1);
+    TEST_ASSERT_MESSAGE(MCL_OK == return_code, "file_util_fseek() does not return MCL_OK.");
+    file_util_ftell(file_descriptor, &offset);
+    TEST_ASSERT_EQUAL_MESSAGE(1, offset, "Position is not the offset sought.");
+
+    return_code = file_util_fclose(file_descriptor);
+    TEST_ASSERT_MESSAGE(MCL_OK == return_code, "File can not be closed.");
+}
+
+/**
+ * GIVEN : A file is opened in write mode and data is written to the file.
+ * WHEN  : file_util_fsync is called.
+ * THEN  : MCL_OK is returned and the data can be read from the file while it is still open.
+ */
+void test_fsync_001(void)
+{
+    void *file_descriptor = MCL_NULL;
+    void *read_descriptor = MCL_NULL;
+    char data_read[7] = {0};
+    mcl_size_t actual_data_size = 0;
+
+    E_MCL_ERROR_CODE return_code = file_util_fopen(file_name, "w", &file_descriptor);
+    TEST_ASSERT_MESSAGE(MCL_OK == return_code, "No support for file handling.");
+    file_util_fputs(data_written, file_descriptor);
+
+    return_code = file_util_fsync(file_descriptor);
+    TEST_ASSERT_MESSAGE(MCL_OK == return_code, "file_util_fsync() does not return MCL_OK.");
+
+    file_util_fopen(file_name, "r", &read_descriptor);
+    file_util_fread(data_read, sizeof(char), data_size, read_descriptor, &actual_data_size);
+    file_util_fclose(read_descriptor);
+    file_util_fclose(file_descriptor);
+
+    TEST_ASSERT_EQUAL_MESSAGE(data_size, actual_data_size, "Size of data synchronized is wrong.");
+    TEST_ASSERT_EQUAL_STRING_MESSAGE(data_written, data_read, "Data synchronized is wrong.");
+}
+
+#if !defined(WIN32) && !defined(WIN64)
+// Locks are held per process, so the file is locked from a child process. Returns MCL_TRUE if the lock result is expected_code.
+static mcl_bool_t _lock_in_child_process(E_MCL_ERROR_CODE expected_code)
+{
+    int status = 0;
+    pid_t child = fork();
+
+    if (0 == child)
+    {
+        void *child_descriptor = MCL_NULL;
+
+        file_util_fopen(file_name, "a", &child_descriptor);
+        _exit((expected_code == file_util_lock(child_descriptor)) ? 0 : 1);
+    }
+
+    return ((-1 != child) && (child == waitpid(child, &status, 0)) && WIFEXITED(status) && (0 == WEXITSTATUS(status))) ? MCL_TRUE : MCL_FALSE;
+}
+#endif
+
+/**
+ * GIVEN : A file is locked by this process.
+ * WHEN  : Another process calls file_util_lock for the same file, before and after the file is closed by this process.
+ * THEN  : MCL_FAIL is returned while the file is open in this process, MCL_OK is returned after it is closed.
+ */
+void test_lock_001(void)
+{
+#if !defined(WIN32) && !defined(WIN64)
+    void *file_descriptor = MCL_NULL;
+
+    E_MCL_ERROR_CODE return_code = file_util_fopen(file_name, "a", &file_descriptor);
+    TEST_ASSERT_MESSAGE(MCL_OK == return_code, "No support for file handling.");
+
+    return_code = file_util_lock(file_descriptor);
+    TEST_ASSERT_MESSAGE(MCL_OK == return_code, "file_util_lock() does not return MCL_OK.");
+    TEST_ASSERT_MESSAGE(MCL_TRUE == _lock_in_child_process(MCL_FAIL), "File locked by this process is locked by another process too.");
+
+    file_util_fclose(file_descriptor);
+    TEST_ASSERT_MESSAGE(MCL_TRUE == _lock_in_child_process(MCL_OK), "File closed by this process can not be locked by another process.");
+
+    file_util_remove(file_name);
+#else
+    TEST_IGNORE_MESSAGE("Test is not supported on this platform.");
+#endif
+}
+
+/**
+ * GIVEN : A file which can be read and written by everyone.
+ * WHEN  : file_util_fopen_private is called for the file.
+ * THEN  : MCL_OK is returned, the file is truncated and only its owner can read or write it.
+ */
+void test_fopen_private_001(void)
+{
+#if !defined(WIN32) && !defined(WIN64)
+    void *file_descriptor = MCL_NULL;
+    mcl_stat_t file_attributes;
+
+    E_MCL_ERROR_CODE return_code = file_util_fopen(file_name, "w", &file_descriptor);
+    TEST_ASSERT_MESSAGE(MCL_OK == return_code, "No support for file handling.");
+    file_util_fwrite(data_written, 1, data_size, file_descriptor);
+    file_util_fclose(file_descriptor);
+    chmod(file_name, S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP | S_IROTH | S_IWOTH);
+
+    return_code = file_util_fopen_private(file_name, &file_descriptor);
+    TEST_ASSERT_MESSAGE(MCL_OK == return_code, "file_util_fopen_private() does not return MCL_OK.");
+    TEST_ASSERT_NOT_NULL_MESSAGE(file_descriptor, "File descriptor is Null.");
+
+    return_code = file_util_fstat(file_descriptor, &file_attributes);
+    TEST_ASSERT_MESSAGE(MCL_OK == return_code, "file_util_fstat() does not return MCL_OK.");
+    TEST_ASSERT_EQUAL_MESSAGE(S_IRUSR | S_IWUSR, file_attributes.st_mode & (S_IRWXU | S_IRWXG | S_IRWXO), "File can be accessed by others than its owner.");
+    TEST_ASSERT_EQUAL_MESSAGE(0, file_attributes.st_size, "Existing file is not truncated.");
+
+    file_util_fclose(file_descriptor);
+    file_util_remove(file_name);
+#else
+    TEST_IGNORE_MESSAGE("Test is not supported on this platform.");
+#endif
+}
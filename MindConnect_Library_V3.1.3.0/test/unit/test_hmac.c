@@ -121,3 +121,41 @@ void test_sha256_003(void)
 	string_destroy(&data);
 	string_destroy(&key);
 }
+
+/**
+ * GIVEN : HMAC SHA256 handle is initialized with a secret key.
+ * WHEN  : Two calculations are done with the handle, the second one with data given in parts.
+ * THEN  : Both results must be equal to the result of HMAC SHA256 calculation done at once.
+ */
+void test_sha256_context_001(void)
+{
+    hmac_sha256_t *hmac = MCL_NULL;
+    mcl_uint8_t *hash = MCL_NULL;
+    mcl_size_t hash_size = 0;
+    mcl_uint8_t *hash_once = MCL_NULL;
+    mcl_size_t hash_once_size = 0;
+
+    E_MCL_ERROR_CODE code = hmac_sha256((mcl_uint8_t *)"header.payload", 14, (mcl_uint8_t *)"123", 3, &hash_once, &hash_once_size);
+    TEST_ASSERT_MESSAGE(MCL_OK == code, "Expected return code not received");
+
+    code = hmac_sha256_initialize((mcl_uint8_t *)"123", 3, &hmac);
+    TEST_ASSERT_MESSAGE(MCL_OK == code, "Expected return code not received");
+
+    TEST_ASSERT_MESSAGE(MCL_OK == hmac_sha256_start(hmac), "HMAC calculation can not be started.");
+    TEST_ASSERT_MESSAGE(MCL_OK == hmac_sha256_update(hmac, (mcl_uint8_t *)"header.payload", 14), "Expected return code not received");
+    TEST_ASSERT_MESSAGE(MCL_OK == hmac_sha256_finish(hmac, &hash, &hash_size), "Expected return code not received");
+    TEST_ASSERT_MESSAGE(32 == hash_size, "Hash size must be 32 bytes long!");
+    TEST_ASSERT_EQUAL_UINT8_ARRAY_MESSAGE(hash_once, hash, 32, "Result of HMAC handle differs from HMAC calculated at once!");
+    MCL_FREE(hash);
+
+    TEST_ASSERT_MESSAGE(MCL_OK == hmac_sha256_start(hmac), "HMAC calculation can not be started.");
+    TEST_ASSERT_MESSAGE(MCL_OK == hmac_sha256_update(hmac, (mcl_uint8_t *)"header.", 7), "Expected return code not received");
+    TEST_ASSERT_MESSAGE(MCL_OK == hmac_sha256_update(hmac, (mcl_uint8_t *)"payload", 7), "Expected return code not received");
+    TEST_ASSERT_MESSAGE(MCL_OK == hmac_sha256_finish(hmac, &hash, &hash_size), "Expected return code not received");
+    TEST_ASSERT_EQUAL_UINT8_ARRAY_MESSAGE(hash_once, hash, 32, "Result of reused HMAC handle differs from HMAC calculated at once!");
+
+    MCL_FREE(hash);
+    MCL_FREE(hash_once);
+    hmac_sha256_destroy(&hmac);
+    TEST_ASSERT_NULL_MESSAGE(hmac, "HMAC handle is not set to NULL.");
+}
@@ -24,6 +24,58 @@
 #include "definitions.h"
 #include "mock_http_response.h"
 #include "mock_http_response.h"
+#include "compression_zlib.h"
+#include "http_request.h"
+#include "file_util.h"
+
+#include <openssl/ssl.h>
+
+#if (1 == MCL_HAVE_ZLIB)
+#include <zlib.h>
+#endif
+
+#if !defined(WIN32) && !defined(WIN64)
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <string.h>
+#include <stdlib.h>
+#define TEST_SERVER_SUPPORTED 1
+#endif
+
+#define TEST_SERVER_MAX_CONNECTIONS 8
+#define TEST_SERVER_BUFFER_SIZE 4096
+#define TEST_SERVER_MAX_ITERATIONS 500
+#define TEST_FRAGMENT_PAYLOAD "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+#define TEST_FRAGMENT_FILE_NAME "http_client_fragment.txt"
+#define TEST_TLS_SESSION_STORE_PATH "http_client_store"
+#define TEST_TLS_SESSION_FILE_NAME TEST_TLS_SESSION_STORE_PATH ".tls"
+#define TEST_TLS_SESSION_TEMPORARY_FILE_NAME TEST_TLS_SESSION_FILE_NAME ".tmp"
+
+// Minimal HTTP/1.1 server on the loopback interface. It is served from the test thread between the calls of http_client_perform.
+typedef struct test_server_t
+{
+    int listener;
+    mcl_uint16_t port;
+    int connections[TEST_SERVER_MAX_CONNECTIONS];
+    char buffers[TEST_SERVER_MAX_CONNECTIONS][TEST_SERVER_BUFFER_SIZE];
+    mcl_size_t buffer_sizes[TEST_SERVER_MAX_CONNECTIONS];
+    mcl_size_t accepted_count;
+    mcl_size_t received_count;
+    mcl_size_t request_count;
+    mcl_size_t drop_request;
+    char body[TEST_SERVER_BUFFER_SIZE];
+    mcl_size_t body_size;
+} test_server_t;
+
+// Source of payload which can only be read in consecutive parts like a file.
+typedef struct test_sequential_source_t
+{
+    const char *data;
+    mcl_size_t position;
+} test_sequential_source_t;
 
 configuration_t *configuration = MCL_NULL;
 http_client_t *http_client = MCL_NULL;
@@ -81,6 +133,12 @@ void setUp(void)
 
     configuration->mindsphere_port = 443;
     configuration->security_profile = MCL_SECURITY_SHARED_SECRET;
+    configuration->http_keep_alive = MCL_TRUE;
+    configuration->http_connection_idle_timeout = DEFAULT_HTTP_CONNECTION_IDLE_TIMEOUT;
+    configuration->http_connection_max_requests = DEFAULT_HTTP_CONNECTION_MAX_REQUESTS;
+    configuration->http_request_timeout = 30;
+    configuration->tls_session_cache = MCL_FALSE;
+    configuration->store_path = MCL_NULL;
 
     http_client = MCL_NULL;
 }
@@ -106,6 +164,751 @@ void test_initialize_001(void)
     http_client_destroy(&http_client);
 }
 
+/**
+ * GIVEN : User provides a certificate and libcurl has a default CA certificate bundle.
+ * WHEN  : Http client is initialized.
+ * THEN  : Certificate store of the http client has the default CA certificates in addition to the given certificate.
+ */
+void test_initialize_002(void)
+{
+    char *ca_file = MCL_NULL;
+    CURL *curl = curl_easy_init();
+
+    curl_easy_getinfo(curl, CURLINFO_CAINFO, &ca_file);
+    if ((MCL_NULL == ca_file) || (0 != access(ca_file, R_OK)))
+    {
+        curl_easy_cleanup(curl);
+        TEST_IGNORE_MESSAGE("Libcurl has no default CA certificate bundle.");
+    }
+    curl_easy_cleanup(curl);
+
+    E_MCL_ERROR_CODE result = http_client_initialize(configuration, &http_client);
+    TEST_ASSERT_EQUAL_MESSAGE(MCL_OK, result, "http_client_initialize() does not return MCL_OK.");
+    TEST_ASSERT_NOT_NULL_MESSAGE(http_client->certificate_store, "Certificate store is not built.");
+    TEST_ASSERT_MESSAGE(1 < sk_X509_OBJECT_num(X509_STORE_get0_objects(http_client->certificate_store)), "Default CA certificates are not in the certificate store.");
+
+    http_client_destroy(&http_client);
+}
+
+/**
+ * GIVEN : Http client is initialized.
+ * WHEN  : Connection statistics are requested before any request is sent.
+ * THEN  : Both opened and reused connection counts are zero.
+ */
+void test_get_connection_statistics_001(void)
+{
+    mcl_size_t connections_opened = 1;
+    mcl_size_t connections_reused = 1;
+    E_MCL_ERROR_CODE result = http_client_initialize(configuration, &http_client);
+    TEST_ASSERT_MESSAGE(MCL_OK == result, "http_client_initialize() does not return MCL_OK.");
+
+    http_client_get_connection_statistics(http_client, &connections_opened, &connections_reused);
+
+    TEST_ASSERT_EQUAL_MESSAGE(0, connections_opened, "Opened connection count is not zero.");
+    TEST_ASSERT_EQUAL_MESSAGE(0, connections_reused, "Reused connection count is not zero.");
+
+    http_client_destroy(&http_client);
+}
+
+
+#if (1 == TEST_SERVER_SUPPORTED)
+static void _test_server_start(test_server_t *server)
+{
+    struct sockaddr_in address;
+    socklen_t address_length = sizeof(address);
+
+    memset(server, 0, sizeof(test_server_t));
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    server->listener = socket(AF_INET, SOCK_STREAM, 0);
+    TEST_ASSERT_MESSAGE(-1 != server->listener, "Socket of test server can not be created.");
+    TEST_ASSERT_MESSAGE(0 == bind(server->listener, (struct sockaddr *)&address, sizeof(address)), "Test server can not be bound to loopback interface.");
+    TEST_ASSERT_MESSAGE(0 == listen(server->listener, TEST_SERVER_MAX_CONNECTIONS), "Test server can not listen.");
+    TEST_ASSERT_MESSAGE(0 == getsockname(server->listener, (struct sockaddr *)&address, &address_length), "Port of test server can not be read.");
+    fcntl(server->listener, F_SETFL, O_NONBLOCK);
+
+    server->port = ntohs(address.sin_port);
+}
+
+static void _test_server_stop(test_server_t *server)
+{
+    mcl_size_t index;
+
+    for (index = 0; index < server->accepted_count; ++index)
+    {
+        if (-1 != server->connections[index])
+        {
+            close(server->connections[index]);
+        }
+    }
+
+    close(server->listener);
+}
+
+// Returns the size of the request whose header is header_size bytes at the beginning of buffer and copies its body to body.
+// Body of the request is either of the size given by Content-Length or chunked. Zero is returned if the request is not received completely.
+static mcl_size_t _test_server_read_request(char *buffer, mcl_size_t buffer_size, mcl_size_t header_size, char *body, mcl_size_t *body_size)
+{
+    char *content_length = strstr(buffer, "Content-Length: ");
+    char *transfer_encoding = strstr(buffer, "Transfer-Encoding: chunked");
+    mcl_size_t position = header_size;
+
+    *body_size = 0;
+
+    if ((MCL_NULL != transfer_encoding) && ((mcl_size_t)(transfer_encoding - buffer) < header_size))
+    {
+        for (;;)
+        {
+            char *line_end = strstr(buffer + position, "\r\n");
+            mcl_size_t chunk_size;
+
+            if (MCL_NULL == line_end)
+            {
+                return 0;
+            }
+
+            chunk_size = (mcl_size_t)strtoul(buffer + position, MCL_NULL, 16);
+            position = (mcl_size_t)(line_end - buffer) + 2;
+
+            // Chunk is followed by CRLF, last chunk of size zero is followed by an empty trailer.
+            if (buffer_size < position + chunk_size + 2)
+            {
+                return 0;
+            }
+
+            if (0 == chunk_size)
+            {
+                return position + 2;
+            }
+
+            memcpy(body + *body_size, buffer + position, chunk_size);
+            *body_size += chunk_size;
+            position += chunk_size + 2;
+        }
+    }
+
+    if ((MCL_NULL != content_length) && ((mcl_size_t)(content_length - buffer) < header_size))
+    {
+        *body_size = (mcl_size_t)strtoul(content_length + 16, MCL_NULL, 10);
+    }
+
+    if (buffer_size < header_size + *body_size)
+    {
+        return 0;
+    }
+
+    memcpy(body, buffer + header_size, *body_size);
+
+    return header_size + *body_size;
+}
+
+// Accepts new connections and responds to each complete request received so far with an empty 200 response.
+// Connection of the request whose number is drop_request is closed without a response, as a server closing an idle connection would.
+static void _test_server_serve(test_server_t *server)
+{
+    static const char response[] = "HTTP/1.1 200 OK\r\nContent-Length: 0\r\n\r\n";
+    char body[TEST_SERVER_BUFFER_SIZE];
+    int connection;
+    mcl_size_t index;
+
+    while ((TEST_SERVER_MAX_CONNECTIONS > server->accepted_count) && (-1 != (connection = accept(server->listener, MCL_NULL, MCL_NULL))))
+    {
+        fcntl(connection, F_SETFL, O_NONBLOCK);
+        server->connections[server->accepted_count] = connection;
+        server->buffer_sizes[server->accepted_count] = 0;
+        ++server->accepted_count;
+    }
+
+    for (index = 0; index < server->accepted_count; ++index)
+    {
+        char *buffer = server->buffers[index];
+        char *header_end;
+        ssize_t received;
+
+        if (-1 == server->connections[index])
+        {
+            continue;
+        }
+
+        received = recv(server->connections[index], buffer + server->buffer_sizes[index], TEST_SERVER_BUFFER_SIZE - server->buffer_sizes[index] - 1, 0);
+
+        if (0 == received)
+        {
+            // Client closed the connection.
+            close(server->connections[index]);
+            server->connections[index] = -1;
+            continue;
+        }
+
+        if (0 < received)
+        {
+            server->buffer_sizes[index] += (mcl_size_t)received;
+            buffer[server->buffer_sizes[index]] = '\0';
+        }
+
+        while ((-1 != server->connections[index]) && (MCL_NULL != (header_end = strstr(buffer, "\r\n\r\n"))))
+        {
+            mcl_size_t header_size = (mcl_size_t)(header_end - buffer) + 4;
+            mcl_size_t body_size;
+            mcl_size_t request_size = _test_server_read_request(buffer, server->buffer_sizes[index], header_size, body, &body_size);
+
+            if (0 == request_size)
+            {
+                break;
+            }
+
+            ++server->received_count;
+            memcpy(server->body, body, body_size);
+            server->body_size = body_size;
+
+            if (server->received_count == server->drop_request)
+            {
+                close(server->connections[index]);
+                server->connections[index] = -1;
+            }
+            else
+            {
+                send(server->connections[index], response, sizeof(response) - 1, 0);
+                ++server->request_count;
+
+                memmove(buffer, buffer + request_size, server->buffer_sizes[index] - request_size + 1);
+                server->buffer_sizes[index] -= request_size;
+            }
+        }
+    }
+}
+
+static void _test_complete_callback(E_MCL_ERROR_CODE code, http_response_t *http_response, void *user_context)
+{
+    *((mcl_bool_t *)user_context) = MCL_TRUE;
+}
+
+static mcl_size_t _test_get_payload_from_sequential_source(void *destination, void *source, mcl_size_t size, void *user_context)
+{
+    test_sequential_source_t *sequential_source = (test_sequential_source_t *)source;
+
+    memcpy(destination, sequential_source->data + sequential_source->position, size);
+    sequential_source->position += size;
+
+    return size;
+}
+
+static E_MCL_ERROR_CODE _test_rewind_sequential_source(void *source, mcl_size_t size, void *user_context)
+{
+    ((test_sequential_source_t *)source)->position -= size;
+
+    return MCL_OK;
+}
+
+static mcl_size_t _test_get_payload_from_file(void *destination, void *file_descriptor, mcl_size_t size, void *user_context)
+{
+    mcl_size_t actual_size_read = 0;
+
+    file_util_fread(destination, 1, size, file_descriptor, &actual_size_read);
+
+    return actual_size_read;
+}
+
+static E_MCL_ERROR_CODE _test_rewind_payload_of_file(void *file_descriptor, mcl_size_t size, void *user_context)
+{
+    mcl_size_t position = 0;
+    E_MCL_ERROR_CODE code = file_util_ftell(file_descriptor, &position);
+
+    (MCL_OK == code) && (code = file_util_fseek(file_descriptor, position - size));
+
+    return code;
+}
+
+// Creates a request to the test server without a body.
+static http_request_t *_test_create_request(test_server_t *server, E_MCL_HTTP_METHOD method)
+{
+    http_request_t *http_request;
+
+    MCL_NEW(http_request);
+    memset(http_request, 0, sizeof(http_request_t));
+    http_request->method = method;
+    string_array_initialize(1, &(http_request->header));
+    string_initialize_new(MCL_NULL, 32, &(http_request->uri));
+    string_util_snprintf(http_request->uri->buffer, 33, "http://127.0.0.1:%u/", (unsigned)server->port);
+    http_request->uri->length = string_util_strlen(http_request->uri->buffer);
+
+    return http_request;
+}
+
+// Sets the body of the request to "<<" and ">>" around a fragment read by copy_callback from source.
+static void _test_set_fragment_body(http_request_t *http_request, payload_copy_callback_t copy_callback, payload_rewind_callback_t rewind_callback, void *source)
+{
+    static mcl_uint8_t payload[] = "<<>>";
+
+    http_request->payload = payload;
+    http_request->payload_size = 4;
+    http_request->fragments = MCL_MALLOC(sizeof(http_request_fragment_t));
+    http_request->fragments->position = 2;
+    http_request->fragments->copy_callback = copy_callback;
+    http_request->fragments->rewind_callback = rewind_callback;
+    http_request->fragments->source = source;
+    http_request->fragments->user_context = MCL_NULL;
+    http_request->fragments->size = sizeof(TEST_FRAGMENT_PAYLOAD) - 1;
+    http_request->fragment_count = 1;
+    http_request->fragment_capacity = 1;
+    http_request->fragments_size = http_request->fragments->size;
+}
+
+static void _test_destroy_request(http_request_t **http_request)
+{
+    string_array_destroy(&((*http_request)->header));
+    string_destroy(&((*http_request)->uri));
+    MCL_FREE((*http_request)->fragments);
+    MCL_FREE(*http_request);
+}
+
+// Sends the request to the test server and serves it until the request is completed.
+static void _test_send_request(test_server_t *server, http_request_t *http_request)
+{
+    mcl_bool_t completed = MCL_FALSE;
+    mcl_size_t iteration;
+    E_MCL_ERROR_CODE result;
+
+    // Response is not needed by the tests, the client releases the received header if the response can not be initialized.
+    // Response is initialized only if the transfer succeeds, so the expectation fails the test otherwise.
+    http_response_initialize_ExpectAnyArgsAndReturn(MCL_FAIL);
+
+    result = http_client_send_async(http_client, http_request, MCL_NULL, _test_complete_callback, &completed);
+    TEST_ASSERT_MESSAGE(MCL_OK == result, "http_client_send_async() does not return MCL_OK.");
+
+    for (iteration = 0; (MCL_FALSE == completed) && (TEST_SERVER_MAX_ITERATIONS > iteration); ++iteration)
+    {
+        http_client_perform(http_client, 10, MCL_NULL);
+        _test_server_serve(server);
+    }
+
+    TEST_ASSERT_MESSAGE(MCL_TRUE == completed, "Request is not completed.");
+}
+#endif
+
+/**
+ * GIVEN : Http client is initialized with keep-alive and no limit on the number of requests per connection.
+ * WHEN  : Three requests are sent one after another.
+ * THEN  : A single connection is opened and reused for the last two requests.
+ */
+void test_send_async_001(void)
+{
+#if (1 == TEST_SERVER_SUPPORTED)
+    test_server_t server;
+    http_request_t *http_request;
+    mcl_size_t connections_opened = 0;
+    mcl_size_t connections_reused = 0;
+    mcl_size_t index;
+
+    _test_server_start(&server);
+    configuration->mindsphere_port = server.port;
+    configuration->http_connection_max_requests = 0;
+    TEST_ASSERT_MESSAGE(MCL_OK == http_client_initialize(configuration, &http_client), "http_client_initialize() does not return MCL_OK.");
+
+    http_request = _test_create_request(&server, MCL_HTTP_GET);
+    for (index = 0; index < 3; ++index)
+    {
+        _test_send_request(&server, http_request);
+    }
+    _test_destroy_request(&http_request);
+
+    http_client_get_connection_statistics(http_client, &connections_opened, &connections_reused);
+    http_client_destroy(&http_client);
+    _test_server_stop(&server);
+
+    TEST_ASSERT_EQUAL_MESSAGE(3, server.request_count, "Server did not receive all requests.");
+    TEST_ASSERT_EQUAL_MESSAGE(1, server.accepted_count, "Connection is not reused.");
+    TEST_ASSERT_EQUAL_MESSAGE(1, connections_opened, "Opened connection count is wrong.");
+    TEST_ASSERT_EQUAL_MESSAGE(2, connections_reused, "Reused connection count is wrong.");
+#else
+    TEST_IGNORE_MESSAGE("Test server is not supported on this platform.");
+#endif
+}
+
+/**
+ * GIVEN : Http client is initialized with keep-alive and at most 2 requests per connection.
+ * WHEN  : Five requests are sent one after another.
+ * THEN  : Connection is closed after every second request, three connections are opened and two are reused.
+ */
+void test_send_async_002(void)
+{
+#if (1 == TEST_SERVER_SUPPORTED)
+    test_server_t server;
+    http_request_t *http_request;
+    mcl_size_t connections_opened = 0;
+    mcl_size_t connections_reused = 0;
+    mcl_size_t index;
+
+    _test_server_start(&server);
+    configuration->mindsphere_port = server.port;
+    configuration->http_connection_max_requests = 2;
+    TEST_ASSERT_MESSAGE(MCL_OK == http_client_initialize(configuration, &http_client), "http_client_initialize() does not return MCL_OK.");
+
+    http_request = _test_create_request(&server, MCL_HTTP_GET);
+    for (index = 0; index < 5; ++index)
+    {
+        _test_send_request(&server, http_request);
+    }
+    _test_destroy_request(&http_request);
+
+    http_client_get_connection_statistics(http_client, &connections_opened, &connections_reused);
+    http_client_destroy(&http_client);
+    _test_server_stop(&server);
+
+    TEST_ASSERT_EQUAL_MESSAGE(5, server.request_count, "Server did not receive all requests.");
+    TEST_ASSERT_EQUAL_MESSAGE(3, server.accepted_count, "Connection is not rolled over after maximum number of requests.");
+    TEST_ASSERT_EQUAL_MESSAGE(3, connections_opened, "Opened connection count is wrong.");
+    TEST_ASSERT_EQUAL_MESSAGE(2, connections_reused, "Reused connection count is wrong.");
+#else
+    TEST_IGNORE_MESSAGE("Test server is not supported on this platform.");
+#endif
+}
+
+/**
+ * GIVEN : Http client is initialized without keep-alive.
+ * WHEN  : Two requests are sent one after another.
+ * THEN  : A new connection is opened for each request.
+ */
+void test_send_async_003(void)
+{
+#if (1 == TEST_SERVER_SUPPORTED)
+    test_server_t server;
+    http_request_t *http_request;
+    mcl_size_t connections_opened = 0;
+    mcl_size_t connections_reused = 0;
+
+    _test_server_start(&server);
+    configuration->mindsphere_port = server.port;
+    configuration->http_keep_alive = MCL_FALSE;
+    TEST_ASSERT_MESSAGE(MCL_OK == http_client_initialize(configuration, &http_client), "http_client_initialize() does not return MCL_OK.");
+
+    http_request = _test_create_request(&server, MCL_HTTP_GET);
+    _test_send_request(&server, http_request);
+    _test_send_request(&server, http_request);
+    _test_destroy_request(&http_request);
+
+    http_client_get_connection_statistics(http_client, &connections_opened, &connections_reused);
+    http_client_destroy(&http_client);
+    _test_server_stop(&server);
+
+    TEST_ASSERT_EQUAL_MESSAGE(2, server.request_count, "Server did not receive all requests.");
+    TEST_ASSERT_EQUAL_MESSAGE(2, server.accepted_count, "Connection is reused although keep-alive is disabled.");
+    TEST_ASSERT_EQUAL_MESSAGE(2, connections_opened, "Opened connection count is wrong.");
+    TEST_ASSERT_EQUAL_MESSAGE(0, connections_reused, "Reused connection count is wrong.");
+#else
+    TEST_IGNORE_MESSAGE("Test server is not supported on this platform.");
+#endif
+}
+
+#if (1 == TEST_SERVER_SUPPORTED)
+// Starts the test server and sends a GET request to open a connection. Server drops the next request it receives on the kept-alive connection.
+static void _test_open_connection(test_server_t *server)
+{
+    http_request_t *http_request;
+
+    _test_server_start(server);
+    server->drop_request = 2;
+    configuration->mindsphere_port = server->port;
+    TEST_ASSERT_MESSAGE(MCL_OK == http_client_initialize(configuration, &http_client), "http_client_initialize() does not return MCL_OK.");
+
+    http_request = _test_create_request(server, MCL_HTTP_GET);
+    _test_send_request(server, http_request);
+    _test_destroy_request(&http_request);
+}
+
+static void _test_close_connection(test_server_t *server)
+{
+    http_client_destroy(&http_client);
+    _test_server_stop(server);
+}
+
+// Sends a GET request to open a connection, then the POST request with a fragment which the server receives on the kept-alive connection and drops.
+static void _test_send_fragment_request(test_server_t *server, mcl_bool_t compress_payload, payload_copy_callback_t copy_callback,
+                                        payload_rewind_callback_t rewind_callback, void *source)
+{
+    http_request_t *http_request;
+
+    _test_open_connection(server);
+
+    http_request = _test_create_request(server, MCL_HTTP_POST);
+    http_request->compress_payload = compress_payload;
+    _test_set_fragment_body(http_request, copy_callback, rewind_callback, source);
+    _test_send_request(server, http_request);
+    _test_destroy_request(&http_request);
+
+    _test_close_connection(server);
+}
+#endif
+
+#if (1 == TEST_SERVER_SUPPORTED) && (1 == MCL_HAVE_ZLIB)
+// Decompresses gzip data received by the test server and returns the size of decompressed data.
+static mcl_size_t _test_gunzip(char *compressed, mcl_size_t compressed_size, char *output, mcl_size_t output_size)
+{
+    z_stream stream;
+    int result;
+
+    memset(&stream, 0, sizeof(stream));
+    TEST_ASSERT_MESSAGE(Z_OK == inflateInit2(&stream, 16 + MAX_WBITS), "Zlib inflate stream can not be initialized.");
+
+    stream.next_in = (Bytef *)compressed;
+    stream.avail_in = (uInt)compressed_size;
+    stream.next_out = (Bytef *)output;
+    stream.avail_out = (uInt)output_size;
+    result = inflate(&stream, Z_FINISH);
+    inflateEnd(&stream);
+
+    TEST_ASSERT_MESSAGE(Z_STREAM_END == result, "Body received is not a complete gzip stream.");
+
+    return output_size - stream.avail_out;
+}
+#endif
+
+/**
+ * GIVEN : Http client is initialized with keep-alive and a connection is opened by a previous request.
+ * WHEN  : A POST request with a fragment read by a callback is sent and the server closes the kept-alive connection after receiving it.
+ * THEN  : Body is rewound and the request is resent on a new connection, server receives the complete body.
+ */
+void test_send_async_004(void)
+{
+#if (1 == TEST_SERVER_SUPPORTED)
+    test_server_t server;
+    test_sequential_source_t source = {TEST_FRAGMENT_PAYLOAD, 0};
+    const char *expected_body = "<<" TEST_FRAGMENT_PAYLOAD ">>";
+
+    _test_send_fragment_request(&server, MCL_FALSE, _test_get_payload_from_sequential_source, _test_rewind_sequential_source, &source);
+
+    TEST_ASSERT_EQUAL_MESSAGE(3, server.received_count, "Request is not resent.");
+    TEST_ASSERT_EQUAL_MESSAGE(2, server.accepted_count, "Request is not resent on a new connection.");
+    TEST_ASSERT_EQUAL_MESSAGE(string_util_strlen(expected_body), server.body_size, "Size of body received is wrong.");
+    TEST_ASSERT_EQUAL_MEMORY_MESSAGE(expected_body, server.body, server.body_size, "Body received is wrong.");
+#else
+    TEST_IGNORE_MESSAGE("Test server is not supported on this platform.");
+#endif
+}
+
+/**
+ * GIVEN : Http client is initialized with keep-alive and a connection is opened by a previous request.
+ * WHEN  : A POST request with a fragment read from a file is sent and the server closes the kept-alive connection after receiving it.
+ * THEN  : File is moved back and the request is resent on a new connection, server receives the complete body.
+ */
+void test_send_async_005(void)
+{
+#if (1 == TEST_SERVER_SUPPORTED)
+    test_server_t server;
+    void *file_descriptor = MCL_NULL;
+    const char *expected_body = "<<" TEST_FRAGMENT_PAYLOAD ">>";
+
+    TEST_ASSERT_MESSAGE(MCL_OK == file_util_fopen(TEST_FRAGMENT_FILE_NAME, "w", &file_descriptor), "No support for file handling.");
+    file_util_fputs(TEST_FRAGMENT_PAYLOAD, file_descriptor);
+    file_util_fclose(file_descriptor);
+    file_util_fopen(TEST_FRAGMENT_FILE_NAME, "r", &file_descriptor);
+
+    _test_send_fragment_request(&server, MCL_FALSE, _test_get_payload_from_file, _test_rewind_payload_of_file, file_descriptor);
+
+    file_util_fclose(file_descriptor);
+    file_util_remove(TEST_FRAGMENT_FILE_NAME);
+
+    TEST_ASSERT_EQUAL_MESSAGE(3, server.received_count, "Request is not resent.");
+    TEST_ASSERT_EQUAL_MESSAGE(2, server.accepted_count, "Request is not resent on a new connection.");
+    TEST_ASSERT_EQUAL_MESSAGE(string_util_strlen(expected_body), server.body_size, "Size of body received is wrong.");
+    TEST_ASSERT_EQUAL_MEMORY_MESSAGE(expected_body, server.body, server.body_size, "Body received is wrong.");
+#else
+    TEST_IGNORE_MESSAGE("Test server is not supported on this platform.");
+#endif
+}
+
+/**
+ * GIVEN : Http client is initialized with keep-alive and a connection is opened by a previous request.
+ * WHEN  : A POST request with compressed payload is sent and the server closes the kept-alive connection after receiving it.
+ * THEN  : Payload is compressed again from its beginning and the request is resent on a new connection, server receives the complete gzip body.
+ */
+void test_send_async_006(void)
+{
+#if (1 == TEST_SERVER_SUPPORTED) && (1 == MCL_HAVE_ZLIB)
+    test_server_t server;
+    http_request_t *http_request;
+    static mcl_uint8_t payload[] = TEST_FRAGMENT_PAYLOAD TEST_FRAGMENT_PAYLOAD TEST_FRAGMENT_PAYLOAD TEST_FRAGMENT_PAYLOAD;
+    char received_payload[TEST_SERVER_BUFFER_SIZE];
+    mcl_size_t received_payload_size;
+
+    _test_open_connection(&server);
+
+    http_request = _test_create_request(&server, MCL_HTTP_POST);
+    http_request->compress_payload = MCL_TRUE;
+    http_request->payload = payload;
+    http_request->payload_size = sizeof(payload) - 1;
+    _test_send_request(&server, http_request);
+    _test_destroy_request(&http_request);
+
+    _test_close_connection(&server);
+
+    TEST_ASSERT_EQUAL_MESSAGE(3, server.received_count, "Request is not resent.");
+    TEST_ASSERT_EQUAL_MESSAGE(2, server.accepted_count, "Request is not resent on a new connection.");
+
+    received_payload_size = _test_gunzip(server.body, server.body_size, received_payload, sizeof(received_payload));
+    TEST_ASSERT_EQUAL_MESSAGE(sizeof(payload) - 1, received_payload_size, "Size of decompressed body received is wrong.");
+    TEST_ASSERT_EQUAL_MEMORY_MESSAGE(payload, received_payload, received_payload_size, "Decompressed body received is wrong.");
+#else
+    TEST_IGNORE_MESSAGE("Test server or zlib is not supported on this platform.");
+#endif
+}
+
+/**
+ * GIVEN : Http client is initialized with keep-alive and a connection is opened by a previous request.
+ * WHEN  : A POST request with compressed payload and a fragment read by a callback is sent and the server closes the kept-alive connection after receiving it.
+ * THEN  : Compression and fragment are rewound and the request is resent on a new connection, server receives the complete gzip body.
+ */
+void test_send_async_007(void)
+{
+#if (1 == TEST_SERVER_SUPPORTED) && (1 == MCL_HAVE_ZLIB)
+    test_server_t server;
+    test_sequential_source_t source = {TEST_FRAGMENT_PAYLOAD, 0};
+    const char *expected_payload = "<<" TEST_FRAGMENT_PAYLOAD ">>";
+    char received_payload[TEST_SERVER_BUFFER_SIZE];
+    mcl_size_t received_payload_size;
+
+    _test_send_fragment_request(&server, MCL_TRUE, _test_get_payload_from_sequential_source, _test_rewind_sequential_source, &source);
+
+    TEST_ASSERT_EQUAL_MESSAGE(3, server.received_count, "Request is not resent.");
+    TEST_ASSERT_EQUAL_MESSAGE(2, server.accepted_count, "Request is not resent on a new connection.");
+
+    received_payload_size = _test_gunzip(server.body, server.body_size, received_payload, sizeof(received_payload));
+    TEST_ASSERT_EQUAL_MESSAGE(string_util_strlen(expected_payload), received_payload_size, "Size of decompressed body received is wrong.");
+    TEST_ASSERT_EQUAL_MEMORY_MESSAGE(expected_payload, received_payload, received_payload_size, "Decompressed body received is wrong.");
+#else
+    TEST_IGNORE_MESSAGE("Test server or zlib is not supported on this platform.");
+#endif
+}
+
+// Creates a TLS 1.2 session which can be serialized, bytes of its id and master key are all @p seed.
+static SSL_SESSION *_test_new_tls_session(unsigned char seed)
+{
+    unsigned char session_id[SSL_MAX_SSL_SESSION_ID_LENGTH];
+    unsigned char master_key[SSL_MAX_MASTER_KEY_LENGTH];
+    const unsigned char cipher_id[] = {0xC0, 0x2F};
+    SSL_CTX *ssl_context = SSL_CTX_new(TLS_client_method());
+    SSL *ssl = SSL_new(ssl_context);
+    SSL_SESSION *session = SSL_SESSION_new();
+
+    memset(session_id, seed, sizeof(session_id));
+    memset(master_key, seed, sizeof(master_key));
+    SSL_SESSION_set1_id(session, session_id, sizeof(session_id));
+    SSL_SESSION_set1_master_key(session, master_key, sizeof(master_key));
+    SSL_SESSION_set_protocol_version(session, TLS1_2_VERSION);
+    SSL_SESSION_set_cipher(session, SSL_CIPHER_find(ssl, cipher_id));
+
+    SSL_free(ssl);
+    SSL_CTX_free(ssl_context);
+
+    return session;
+}
+
+// Checks that the session loaded by a new http client is the same as @p session.
+static void _test_assert_tls_session_loaded(SSL_SESSION *session)
+{
+    unsigned char expected[TEST_SERVER_BUFFER_SIZE];
+    unsigned char actual[TEST_SERVER_BUFFER_SIZE];
+    unsigned char *expected_end = expected;
+    unsigned char *actual_end = actual;
+    http_client_t *loading_http_client = MCL_NULL;
+
+    http_client_initialize(configuration, &loading_http_client);
+    TEST_ASSERT_NOT_NULL_MESSAGE(loading_http_client, "Http client can not be initialized.");
+    TEST_ASSERT_NOT_NULL_MESSAGE(loading_http_client->tls_session, "Saved TLS session is not loaded.");
+
+    i2d_SSL_SESSION(session, &expected_end);
+    i2d_SSL_SESSION(loading_http_client->tls_session, &actual_end);
+    TEST_ASSERT_EQUAL_MESSAGE(expected_end - expected, actual_end - actual, "Size of loaded TLS session is wrong.");
+    TEST_ASSERT_EQUAL_MEMORY_MESSAGE(expected, actual, expected_end - expected, "Loaded TLS session is not the saved one.");
+
+    http_client_destroy(&loading_http_client);
+}
+
+/**
+ * GIVEN : Http client is initialized with TLS session cache and there is no saved session.
+ * WHEN  : A TLS session is saved twice and a new http client is initialized.
+ * THEN  : Only the owner can access the session file, no temporary file is left, the second save does not replace the file
+ *         and the new http client loads the saved session.
+ */
+void test_save_tls_session_001(void)
+{
+#if (1 == HAVE_FILE_SYSTEM_) && (1 == TEST_SERVER_SUPPORTED)
+    SSL_SESSION *session = _test_new_tls_session(0x5A);
+    struct stat first_attributes;
+    struct stat second_attributes;
+
+    file_util_remove(TEST_TLS_SESSION_FILE_NAME);
+    configuration->tls_session_cache = MCL_TRUE;
+    string_initialize_static(TEST_TLS_SESSION_STORE_PATH, 0, &(configuration->store_path));
+
+    http_client_initialize(configuration, &http_client);
+    TEST_ASSERT_NOT_NULL_MESSAGE(http_client, "Http client can not be initialized.");
+    TEST_ASSERT_NULL_MESSAGE(http_client->tls_session, "TLS session is loaded although there is no saved session.");
+
+    http_client_save_tls_session(http_client, session);
+    TEST_ASSERT_EQUAL_MESSAGE(0, stat(TEST_TLS_SESSION_FILE_NAME, &first_attributes), "TLS session file is not created.");
+    TEST_ASSERT_EQUAL_MESSAGE(S_IRUSR | S_IWUSR, first_attributes.st_mode & (S_IRWXU | S_IRWXG | S_IRWXO), "TLS session file can be accessed by others than its owner.");
+    TEST_ASSERT_NOT_EQUAL_MESSAGE(0, stat(TEST_TLS_SESSION_TEMPORARY_FILE_NAME, &second_attributes), "Temporary TLS session file is left.");
+
+    // The file is replaced by rename, a new file would have a different inode.
+    http_client_save_tls_session(http_client, session);
+    TEST_ASSERT_EQUAL_MESSAGE(0, stat(TEST_TLS_SESSION_FILE_NAME, &second_attributes), "TLS session file is removed.");
+    TEST_ASSERT_EQUAL_MESSAGE(first_attributes.st_ino, second_attributes.st_ino, "Unchanged TLS session is saved again.");
+
+    http_client_destroy(&http_client);
+    _test_assert_tls_session_loaded(session);
+
+    SSL_SESSION_free(session);
+    string_destroy(&(configuration->store_path));
+    file_util_remove(TEST_TLS_SESSION_FILE_NAME);
+#else
+    TEST_IGNORE_MESSAGE("File system or file permissions are not supported on this platform.");
+#endif
+}
+
+/**
+ * GIVEN : Http client loaded a saved TLS session.
+ * WHEN  : A different TLS session is saved and a new http client is initialized.
+ * THEN  : The session file is replaced and the new http client loads the different session.
+ */
+void test_save_tls_session_002(void)
+{
+#if (1 == HAVE_FILE_SYSTEM_) && (1 == TEST_SERVER_SUPPORTED)
+    SSL_SESSION *first_session = _test_new_tls_session(0x11);
+    SSL_SESSION *second_session = _test_new_tls_session(0x22);
+    struct stat first_attributes;
+    struct stat second_attributes;
+
+    file_util_remove(TEST_TLS_SESSION_FILE_NAME);
+    configuration->tls_session_cache = MCL_TRUE;
+    string_initialize_static(TEST_TLS_SESSION_STORE_PATH, 0, &(configuration->store_path));
+
+    http_client_initialize(configuration, &http_client);
+    TEST_ASSERT_NOT_NULL_MESSAGE(http_client, "Http client can not be initialized.");
+    http_client_save_tls_session(http_client, first_session);
+    http_client_destroy(&http_client);
+    TEST_ASSERT_EQUAL_MESSAGE(0, stat(TEST_TLS_SESSION_FILE_NAME, &first_attributes), "TLS session file is not created.");
+
+    http_client_initialize(configuration, &http_client);
+    TEST_ASSERT_NOT_NULL_MESSAGE(http_client, "Http client can not be initialized.");
+    TEST_ASSERT_NOT_NULL_MESSAGE(http_client->tls_session, "Saved TLS session is not loaded.");
+    http_client_save_tls_session(http_client, second_session);
+    http_client_destroy(&http_client);
+    TEST_ASSERT_EQUAL_MESSAGE(0, stat(TEST_TLS_SESSION_FILE_NAME, &second_attributes), "TLS session file is removed.");
+    TEST_ASSERT_NOT_EQUAL_MESSAGE(first_attributes.st_ino, second_attributes.st_ino, "Changed TLS session does not replace the saved one.");
+
+    _test_assert_tls_session_loaded(second_session);
+
+    SSL_SESSION_free(first_session);
+    SSL_SESSION_free(second_session);
+    string_destroy(&(configuration->store_path));
+    file_util_remove(TEST_TLS_SESSION_FILE_NAME);
+#else
+    TEST_IGNORE_MESSAGE("File system or file permissions are not supported on this platform.");
+#endif
+}
 
 //// INFO The following function is used to test the functionality of the http_client although it is not considered as unit test.
 ///**
@@ -53,11 +53,14 @@ mcl_time_t current_time = 0;
 char *registration_file_name = "registrationFile.txt";
 FILE *registration_file = NULL;
 mcl_uint8_t update_security_001_state = 0;
+mcl_size_t critical_section_count = 0;
 
 static E_MCL_ERROR_CODE _custom_load_reg_info_func(char **client_id, char **client_secret, char **registration_access_token, char **registration_uri);
 static E_MCL_ERROR_CODE _custom_save_reg_info_func(const char *client_id, const char *client_secret, const char *registration_access_token, const char *registration_uri);
 static E_MCL_ERROR_CODE load_for_update_security_test(char **client_id, char **client_secret, char **registration_access_token, char **registration_uri);
 static E_MCL_ERROR_CODE save_for_update_security_test(const char *client_id, const char *client_secret, const char *registration_access_token, const char *registration_uri);
+static E_MCL_ERROR_CODE _enter_critical_section(void);
+static void _leave_critical_section(void);
 
 void setUp(void)
 {
@@ -67,6 +70,7 @@ void setUp(void)
 	configuration->access_token_endpoint = MCL_NULL;
 	configuration->registration_endpoint = MCL_NULL;
 	configuration->exchange_endpoint = MCL_NULL;
+	configuration->http_compression = MCL_FALSE;
 	string_initialize_new("https://brsm-MindConnectCom.cfapps.industrycloud-staging.siemens.com", 0, &configuration->mindsphere_hostname);
 	MCL_NEW(jwt);
 	jwt->header = MCL_NULL;
@@ -92,6 +96,9 @@ void setUp(void)
 
 	current_time = jwt->issued_at + 100;
 
+	// Security handler is mocked, HMAC handle is dropped whenever client secret is replaced.
+	security_handler_reset_hmac_key_Ignore();
+
 	remove(registration_file_name);
 	registration_file = fopen(registration_file_name, "w");
 	fputs("3c7e43b1-b09d-4c4c-b110-7b0d53699154\n", registration_file);
@@ -879,6 +886,8 @@ void test_register_005(void)
 	MCL_NEW(http_processor);
 	http_processor->configuration = configuration;
 	http_processor->security_handler = security_handler;
+	http_processor->async_exchange_count = 0;
+	http_processor->destroying = MCL_FALSE;
 
 	http_request_initialize_IgnoreAndReturn(MCL_FAIL);
 	http_request_destroy_Ignore();
@@ -1126,6 +1135,7 @@ void test_update_security_001(void)
     TEST_ASSERT_NOT_NULL_MESSAGE(http_processor, "Http processor is null after initialization.");
 
     update_security_001_state = 1;
+    security_handler_reset_rsa_key_Ignore();
 
     result = http_processor_update_security_information(http_processor);
     TEST_ASSERT_MESSAGE(MCL_OK == result, "http_processor_update_security_information() does not return MCL_OK.");
@@ -1141,6 +1151,36 @@ void test_update_security_001(void)
     MCL_FREE(security_handler);
 }
 
+/**
+ * GIVEN : Initialized http processor with critical section callbacks.
+ * WHEN  : http_processor_generate_next_rsa_key() is called.
+ * THEN  : Key pair is generated outside of the critical section and handed over to security handler inside of it.
+ */
+void test_generate_next_rsa_key_001(void)
+{
+    http_processor_t http_processor;
+    security_handler_t security_handler;
+    char public_key[] = "public";
+    char private_key[] = "private";
+    char *public_key_pointer = public_key;
+    char *private_key_pointer = private_key;
+
+    configuration->enter_critical_section = _enter_critical_section;
+    configuration->leave_critical_section = _leave_critical_section;
+    http_processor.configuration = configuration;
+    http_processor.security_handler = &security_handler;
+    critical_section_count = 0;
+
+    security_generate_rsa_key_ExpectAnyArgsAndReturn(MCL_OK);
+    security_generate_rsa_key_ReturnThruPtr_public_key(&public_key_pointer);
+    security_generate_rsa_key_ReturnThruPtr_private_key(&private_key_pointer);
+    security_handler_set_next_rsa_key_Expect(&security_handler, public_key, private_key);
+
+    E_MCL_ERROR_CODE result = http_processor_generate_next_rsa_key(&http_processor);
+    TEST_ASSERT_EQUAL(MCL_OK, result);
+    TEST_ASSERT_EQUAL_MESSAGE(0, critical_section_count, "Critical section is not left.");
+}
+
 static E_MCL_ERROR_CODE _custom_load_reg_info_func(char **client_id, char **client_secret, char **registration_access_token, char **registration_uri)
 {
     *client_id = MCL_NULL;
@@ -1185,3 +1225,17 @@ static E_MCL_ERROR_CODE save_for_update_security_test(const char *client_id, con
 {
     return MCL_OK;
 }
+
+static E_MCL_ERROR_CODE _enter_critical_section(void)
+{
+    // Critical section is not expected to be entered twice.
+    TEST_ASSERT_EQUAL(0, critical_section_count);
+    critical_section_count++;
+
+    return MCL_OK;
+}
+
+static void _leave_critical_section(void)
+{
+    critical_section_count--;
+}
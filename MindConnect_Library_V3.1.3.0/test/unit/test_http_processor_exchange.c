@@ -37,6 +37,9 @@
 #include "definitions.h"
 #include "mcl/mcl_store.h"
 #include "json_util.h"
+#include "intern_table.h"
+#include "store_wal.h"
+#include "file_util.h"
 #include "mock_event_list.h"
 #include "mock_time_util.h"
 
@@ -54,32 +57,87 @@ char *routing = "vnd.kuka.FingerprintAnalizer";
 security_handler_t *security_handler = MCL_NULL;
 event_list_t *event_list = MCL_NULL;
 
+// Transfer started by the asynchronous exchange and the results of the exchange callback.
+http_client_send_complete_callback pending_complete_callback = MCL_NULL;
+void *pending_user_context = MCL_NULL;
+mcl_size_t exchange_callback_count = 0;
+E_MCL_ERROR_CODE exchange_callback_code = MCL_FAIL;
+E_MCL_ERROR_CODE reentrant_exchange_code = MCL_OK;
+mcl_uint8_t async_payload[] = {'0', '1', '2', '3', '4', '5', '6', '7', '8', '9'};
+
 string_t *new_meta_json_string()
 {
-    string_t *meta_json_string;
-    MCL_NEW(meta_json_string);
-    meta_json_string->buffer = MCL_MALLOC(17);
-    meta_json_string->buffer[0] = MCL_NULL_CHAR;
-    string_util_strncat(meta_json_string->buffer, "meta_json_string", 16);
-
-    // meta_json_string->buffer = "meta_json_string";
-    meta_json_string->length = 16;
-    meta_json_string->type = MCL_STRING_COPY_DESTROY;
+    string_t *meta_json_string = MCL_NULL;
+
+    // String handles are released to the pools, so they must be created by the string module.
+    string_initialize_new("meta_json_string", 16, &meta_json_string);
     return meta_json_string;
 }
 
-string_t *new_time_series_payload_json_string()
+// Keeps the transfer started by the asynchronous exchange to complete it later.
+static E_MCL_ERROR_CODE _send_async_stub(http_client_t *http_client, http_request_t *http_request, http_client_send_callback_info_t *callback_info,
+    http_client_send_complete_callback complete_callback, void *user_context, int cmock_num_calls)
+{
+    pending_complete_callback = complete_callback;
+    pending_user_context = user_context;
+
+    return MCL_OK;
+}
+
+// Completes the transfer in flight with failure like the http client does when it is destroyed.
+static void _http_client_destroy_stub(http_client_t **http_client, int cmock_num_calls)
+{
+    http_client_send_complete_callback complete_callback = pending_complete_callback;
+
+    pending_complete_callback = MCL_NULL;
+    if (MCL_NULL != complete_callback)
+    {
+        complete_callback(MCL_FAIL, MCL_NULL, pending_user_context);
+    }
+}
+
+static void _exchange_callback(E_MCL_ERROR_CODE code, store_t *store, void *user_context)
 {
-    string_t *payload_json_string;
-    MCL_NEW(payload_json_string);
-    payload_json_string->buffer = MCL_MALLOC(20);
-    payload_json_string->buffer[0] = MCL_NULL_CHAR;
-    string_util_strncat(payload_json_string->buffer, "payload_json_string", 19);
-
-    // meta_json_string->buffer = "meta_json_string";
-    payload_json_string->length = 19;
-    payload_json_string->type = MCL_STRING_COPY_DESTROY;
-    return payload_json_string;
+    ++exchange_callback_count;
+    exchange_callback_code = code;
+}
+
+// Tries to use and destroy the http processor again from the callback.
+static void _reentrant_exchange_callback(E_MCL_ERROR_CODE code, store_t *store, void *user_context)
+{
+    _exchange_callback(code, store, user_context);
+    reentrant_exchange_code = http_processor_exchange_async(http_processor, store, _exchange_callback, MCL_NULL);
+    http_processor_destroy(&http_processor);
+}
+
+// Starts an asynchronous exchange of a store with a custom data, the transfer is kept in flight.
+static void _start_exchange_async(mcl_store_t **store, http_processor_exchange_callback callback)
+{
+    mcl_custom_data_t *custom_data = MCL_NULL;
+    string_t *json_meta = new_meta_json_string();
+
+    E_MCL_ERROR_CODE result = mcl_store_initialize(MCL_FALSE, store);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(MCL_OK, result, "mcl_store_initialize failed!");
+
+    result = mcl_store_new_custom_data(*store, "1.0", "custom_data_type_1", routing, &custom_data);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(MCL_OK, result, "New custom data from the store failed!");
+    custom_data->payload.buffer = async_payload;
+    custom_data->payload.size = sizeof(async_payload);
+
+    json_from_item_meta_ExpectAnyArgsAndReturn(MCL_OK);
+    json_from_item_meta_ReturnThruPtr_json_string(&json_meta);
+    http_request_initialize_ExpectAnyArgsAndReturn(MCL_OK);
+    http_request_initialize_ReturnThruPtr_http_request(&http_request);
+    http_request_add_header_IgnoreAndReturn(MCL_OK);
+    http_request_finalize_IgnoreAndReturn(MCL_OK);
+    security_generate_random_bytes_ExpectAnyArgsAndReturn(MCL_OK);
+    http_request_add_tuple_IgnoreAndReturn(MCL_OK);
+    http_request_destroy_Ignore();
+    http_client_send_async_StubWithCallback(_send_async_stub);
+
+    result = http_processor_exchange_async(http_processor, *store, callback, MCL_NULL);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(MCL_OK, result, "Asynchronous exchange operation is not started!");
+    TEST_ASSERT_NOT_NULL_MESSAGE(pending_complete_callback, "Transfer is not started!");
 }
 
 void setUp(void)
@@ -93,6 +151,7 @@ void setUp(void)
     configuration->store_path = MCL_NULL;
     configuration->load_function.rsa = MCL_NULL;
     configuration->save_function.rsa = MCL_NULL;
+    configuration->http_compression = MCL_FALSE;
     string_initialize_new("InitialAccessToken", 0, &configuration->initial_access_token);
 
     MCL_NEW(security_handler);
@@ -135,10 +194,16 @@ void setUp(void)
 
     // general mocks :
     http_client_initialize_IgnoreAndReturn(MCL_OK);
-    http_client_destroy_Ignore();
+    http_client_destroy_StubWithCallback(_http_client_destroy_stub);
     security_handler_initialize_IgnoreAndReturn(MCL_OK);
     security_handler_destroy_Ignore();
     security_initialize_Ignore();
+
+    pending_complete_callback = MCL_NULL;
+    pending_user_context = MCL_NULL;
+    exchange_callback_count = 0;
+    exchange_callback_code = MCL_FAIL;
+    reentrant_exchange_code = MCL_OK;
 }
 
 void tearDown(void)
@@ -255,6 +320,145 @@ void test_exchange_002(void)
     mcl_store_destroy(&store);
 }
 
+// GIVEN : http_processor initialized - store initialized - no data added to store.
+// WHEN  : http_processor_exchange_async triggered with empty store.
+// THEN  : Expect exchange operation not to be started.
+void test_exchange_async_001(void)
+{
+    E_MCL_ERROR_CODE result = http_processor_initialize(configuration, &http_processor);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(MCL_OK, result, "http_processor_initialize failed!");
+
+    // create a store
+    mcl_store_t *store = MCL_NULL;
+    result = mcl_store_initialize(MCL_FALSE, &store);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(MCL_OK, result, "mcl_store_initialize failed!");
+
+    result = http_processor_exchange_async(http_processor, store, MCL_NULL, MCL_NULL);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(MCL_STORE_IS_EMPTY, result, "Exchange operation is started with empty store!");
+
+    http_processor_destroy(&http_processor);
+    mcl_store_destroy(&store);
+}
+
+// GIVEN : http_processor initialized - store initialized - 1 custom data added to store.
+// WHEN  : http client can not start the asynchronous transfer.
+// THEN  : Error is returned and the custom data remains in the store to be sent again.
+void test_exchange_async_002(void)
+{
+    E_MCL_ERROR_CODE result = http_processor_initialize(configuration, &http_processor);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(MCL_OK, result, "http_processor_initialize failed!");
+
+    http_processor->security_handler = security_handler;
+
+    // create a store
+    mcl_store_t *store = MCL_NULL;
+    result = mcl_store_initialize(MCL_FALSE, &store);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(MCL_OK, result, "mcl_store_initialize failed!");
+
+    // add a custom data to the store :
+    mcl_uint8_t payload[] =
+    {
+        '0', '1', '2', '3', '4', '5', '6', '7', '8', '9'
+    };
+    mcl_custom_data_t *custom_data = MCL_NULL;
+    result = mcl_store_new_custom_data(store, "1.0", "custom_data_type_1", routing, &custom_data);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(MCL_OK, result, "New custom data from the store failed!");
+    custom_data->payload.buffer = payload;
+    custom_data->payload.size = sizeof(payload) / sizeof(payload[0]);
+
+    json_from_item_meta_ExpectAnyArgsAndReturn(MCL_OK);
+    string_t *json_meta = new_meta_json_string();
+    json_from_item_meta_ReturnThruPtr_json_string(&json_meta);
+
+    http_request_initialize_ExpectAnyArgsAndReturn(MCL_OK);
+    http_request_initialize_ReturnThruPtr_http_request(&http_request);
+    http_request_add_header_IgnoreAndReturn(MCL_OK);
+    http_request_finalize_IgnoreAndReturn(MCL_OK);
+    security_generate_random_bytes_ExpectAnyArgsAndReturn(MCL_OK);
+    http_request_add_tuple_IgnoreAndReturn(MCL_OK);
+    http_request_destroy_Ignore();
+
+    // Transfer can not be started :
+    http_client_send_async_ExpectAnyArgsAndReturn(MCL_FAIL);
+
+    result = http_processor_exchange_async(http_processor, store, MCL_NULL, MCL_NULL);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(MCL_FAIL, result, "Exchange operation is started although transfer failed!");
+
+    // custom data is still in the store and ready to be written again :
+    TEST_ASSERT_EQUAL_INT_MESSAGE(1, store->high_priority_list->count, "Custom data is removed from the store!");
+    TEST_ASSERT_EQUAL_INT_MESSAGE(DATA_STATE_PREPARED, ((store_data_t *)store->high_priority_list->head->data)->state, "Store data state is not rolled back!");
+
+    http_processor_destroy(&http_processor);
+    mcl_store_destroy(&store);
+}
+
+// GIVEN : http_processor initialized - an asynchronous exchange of 1 custom data is in flight.
+// WHEN  : http_processor_exchange and other blocking operations are triggered before and after the asynchronous exchange is completed.
+// THEN  : Blocking operations are refused while the asynchronous one is in flight, the asynchronous exchange completes successfully.
+void test_exchange_async_003(void)
+{
+    mcl_store_t *store = MCL_NULL;
+    E_MCL_ERROR_CODE result = http_processor_initialize(configuration, &http_processor);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(MCL_OK, result, "http_processor_initialize failed!");
+
+    http_processor->security_handler = security_handler;
+    _start_exchange_async(&store, _exchange_callback);
+
+    result = http_processor_exchange(http_processor, store, NULL);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(MCL_EXCHANGE_ASYNC_IS_ACTIVE, result, "Synchronous exchange is performed while an asynchronous one is in flight!");
+
+    result = http_processor_get_access_token(http_processor);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(MCL_EXCHANGE_ASYNC_IS_ACTIVE, result, "Access token is renewed while an asynchronous exchange is in flight!");
+
+    result = http_processor_register(http_processor);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(MCL_EXCHANGE_ASYNC_IS_ACTIVE, result, "Key is rotated while an asynchronous exchange is in flight!");
+
+    result = http_processor_update_security_information(http_processor);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(MCL_EXCHANGE_ASYNC_IS_ACTIVE, result, "Security information is updated while an asynchronous exchange is in flight!");
+
+    // Transfer is completed successfully :
+    http_client_send_complete_callback complete_callback = pending_complete_callback;
+    success_response->payload = "";
+    http_response_destroy_Ignore();
+    event_list_destroy_Ignore();
+    pending_complete_callback = MCL_NULL;
+    complete_callback(MCL_OK, success_response, pending_user_context);
+
+    TEST_ASSERT_EQUAL_INT_MESSAGE(1, exchange_callback_count, "Exchange callback is not called once!");
+    TEST_ASSERT_EQUAL_INT_MESSAGE(MCL_OK, exchange_callback_code, "Asynchronous exchange operation failed!");
+    TEST_ASSERT_EQUAL_INT_MESSAGE(0, store_get_data_count(store), "Custom data is not removed from the store!");
+
+    result = http_processor_exchange(http_processor, store, NULL);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(MCL_STORE_IS_EMPTY, result, "Synchronous exchange is refused after the asynchronous one is completed!");
+
+    http_processor_destroy(&http_processor);
+    mcl_store_destroy(&store);
+}
+
+// GIVEN : http_processor initialized - an asynchronous exchange of 1 custom data is in flight.
+// WHEN  : http_processor is destroyed and the exchange callback starts a new exchange and destroys the http processor again.
+// THEN  : Exchange callback is called once with failure, the new exchange is refused, http processor is destroyed once and the data remains in the store.
+void test_exchange_async_004(void)
+{
+    mcl_store_t *store = MCL_NULL;
+    E_MCL_ERROR_CODE result = http_processor_initialize(configuration, &http_processor);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(MCL_OK, result, "http_processor_initialize failed!");
+
+    http_processor->security_handler = security_handler;
+    _start_exchange_async(&store, _reentrant_exchange_callback);
+
+    http_processor_destroy(&http_processor);
+
+    TEST_ASSERT_NULL_MESSAGE(http_processor, "Http processor is not destroyed!");
+    TEST_ASSERT_EQUAL_INT_MESSAGE(1, exchange_callback_count, "Exchange callback is not called once!");
+    TEST_ASSERT_EQUAL_INT_MESSAGE(MCL_FAIL, exchange_callback_code, "Pending exchange is not failed!");
+    TEST_ASSERT_EQUAL_INT_MESSAGE(MCL_NOT_INITIALIZED, reentrant_exchange_code, "Exchange is started while the http processor is being destroyed!");
+    TEST_ASSERT_EQUAL_INT_MESSAGE(1, store->high_priority_list->count, "Custom data is removed from the store!");
+    TEST_ASSERT_EQUAL_INT_MESSAGE(DATA_STATE_PREPARED, ((store_data_t *)store->high_priority_list->head->data)->state, "Store data state is not rolled back!");
+
+    mcl_store_destroy(&store);
+}
+
 // GIVEN : http_processor initialized - store initialized - 2 custom data added to store - no communication problem
 // WHEN  : Payload size of the 2 custom data is less than the MAX http payload size.
 // THEN  : Exchange operation would successfully add the custom data to the request and send it
@@ -399,8 +603,7 @@ void test_exchange_004(void)
 
     http_request_finalize_IgnoreAndReturn(MCL_OK);
 
-	// Correlation-ID
-	security_generate_random_bytes_ExpectAnyArgsAndReturn(MCL_OK);
+	// Correlation-IDs of both requests are served from a single random pool refill.
 	security_generate_random_bytes_ExpectAnyArgsAndReturn(MCL_OK);
 
     // 3- Custom data will be added to the http_request by add_tuple : 2 times :
@@ -411,12 +614,6 @@ void test_exchange_004(void)
     // chunking will be tried. this is for it to be failed :
     http_request_get_available_space_for_tuple_IgnoreAndReturn(0);
 
-    // http_processor_exchange mechanism will start over and try to add again and that should return error too. With that it will decide we can't add anything anymore :
-    http_request_add_tuple_IgnoreAndReturn(MCL_HTTP_REQUEST_NO_MORE_SPACE);
-
-    // chunking will be tried. this is for it to be failed :
-    http_request_get_available_space_for_tuple_IgnoreAndReturn(0);
-
     // 4- Prepared http_request will be sent using http_client_send : 1 time :
     http_client_send_ExpectAnyArgsAndReturn(MCL_OK);
     http_client_send_ReturnThruPtr_http_response(&success_response);
@@ -425,9 +622,8 @@ void test_exchange_004(void)
     http_response_destroy_Ignore();
     http_request_destroy_Ignore();
 
-    // 6- Another http_request will be created for the second custom_data: 1 time :
-    http_request_initialize_ExpectAnyArgsAndReturn(MCL_OK);
-    http_request_initialize_ReturnThruPtr_http_request(&http_request);
+    // 6- The first http_request will be reset and reused for the second custom_data: 1 time :
+    http_request_reset_ExpectAndReturn(http_request, MCL_OK);
 
     // 6.1- Add content-type header:
     http_request_add_header_IgnoreAndReturn(MCL_OK);
@@ -678,8 +874,7 @@ void test_exchange_007(void)
 
     http_request_finalize_IgnoreAndReturn(MCL_OK);
 
-	// Correlation-ID
-	security_generate_random_bytes_ExpectAnyArgsAndReturn(MCL_OK);
+	// Correlation-IDs of both requests are served from a single random pool refill.
 	security_generate_random_bytes_ExpectAnyArgsAndReturn(MCL_OK);
 
     // 3- Custom data will be added to the http_request by add_tuple : 2 times :
@@ -690,12 +885,6 @@ void test_exchange_007(void)
     // chunking will be tried. this is for it to be failed :
     http_request_get_available_space_for_tuple_IgnoreAndReturn(0);
 
-    // http_processor_exchange mechanism will start over and try to add again and that should return error too. With that it will decide we can't add anything anymore :
-    http_request_add_tuple_IgnoreAndReturn(MCL_HTTP_REQUEST_NO_MORE_SPACE);
-
-    // chunking will be tried. this is for it to be failed :
-    http_request_get_available_space_for_tuple_IgnoreAndReturn(0);
-
     // 4- Prepared http_request will be sent using http_client_send : 1 time :
     http_client_send_ExpectAnyArgsAndReturn(MCL_OK);
     http_client_send_ReturnThruPtr_http_response(&success_response);
@@ -704,9 +893,8 @@ void test_exchange_007(void)
     http_response_destroy_Ignore();
     http_request_destroy_Ignore();
 
-    // 6- Another http_request will be created for the second custom_data: 1 time :
-    http_request_initialize_ExpectAnyArgsAndReturn(MCL_OK);
-    http_request_initialize_ReturnThruPtr_http_request(&http_request_2);
+    // 6- The first http_request will be reset and reused for the second custom_data: 1 time :
+    http_request_reset_ExpectAndReturn(http_request, MCL_OK);
 
     // 6.1- Add content-type header:
     http_request_add_header_IgnoreAndReturn(MCL_OK);
@@ -776,10 +964,7 @@ void test_exchange_008(void)
 
     string_t *json_meta = new_meta_json_string();
     json_from_item_meta_ReturnThruPtr_json_string(&json_meta);
-    json_from_time_series_payload_ExpectAnyArgsAndReturn(MCL_OK);
-
-    string_t *json_payload = new_time_series_payload_json_string();
-    json_from_time_series_payload_ReturnThruPtr_json_string(&json_payload);
+    json_write_time_series_payload_ExpectAnyArgsAndReturn(19);
 
     // 2- An http_request will be created : 1 time :
     http_request_initialize_ExpectAnyArgsAndReturn(MCL_OK);
@@ -874,14 +1059,8 @@ void test_exchange_009(void)
     string_t *json_meta_2 = new_meta_json_string();
     json_from_item_meta_ReturnThruPtr_json_string(&json_meta_2);
 
-    json_from_time_series_payload_ExpectAnyArgsAndReturn(MCL_OK);
-
-    string_t *json_payload = new_time_series_payload_json_string();
-    json_from_time_series_payload_ReturnThruPtr_json_string(&json_payload);
-    json_from_time_series_payload_ExpectAnyArgsAndReturn(MCL_OK);
-
-    string_t *json_payload_2 = new_time_series_payload_json_string();
-    json_from_time_series_payload_ReturnThruPtr_json_string(&json_payload_2);
+    json_write_time_series_payload_ExpectAnyArgsAndReturn(19);
+    json_write_time_series_payload_ExpectAnyArgsAndReturn(19);
 
     // 2- An http_request will be created : 1 time :
     http_request_initialize_ExpectAnyArgsAndReturn(MCL_OK);
@@ -980,14 +1159,8 @@ void test_exchange_010(void)
     string_t *json_meta_2 = new_meta_json_string();
     json_from_item_meta_ReturnThruPtr_json_string(&json_meta_2);
 
-    json_from_time_series_payload_ExpectAnyArgsAndReturn(MCL_OK);
-
-    string_t *json_payload = new_time_series_payload_json_string();
-    json_from_time_series_payload_ReturnThruPtr_json_string(&json_payload);
-    json_from_time_series_payload_ExpectAnyArgsAndReturn(MCL_OK);
-
-    string_t *json_payload_2 = new_time_series_payload_json_string();
-    json_from_time_series_payload_ReturnThruPtr_json_string(&json_payload_2);
+    json_write_time_series_payload_ExpectAnyArgsAndReturn(19);
+    json_write_time_series_payload_ExpectAnyArgsAndReturn(19);
 
     // 2- An http_request will be created : 1 time :
     http_request_initialize_ExpectAnyArgsAndReturn(MCL_OK);
@@ -1008,9 +1181,6 @@ void test_exchange_010(void)
     http_request_add_tuple_IgnoreAndReturn(MCL_OK);
     http_request_add_tuple_IgnoreAndReturn(MCL_HTTP_REQUEST_NO_MORE_SPACE);
 
-    // http_processor_exchange mechanism will start over and try to add again and that should return error too. With that it will decide we can't add anything anymore :
-    http_request_add_tuple_IgnoreAndReturn(MCL_HTTP_REQUEST_NO_MORE_SPACE);
-
     // 4- Prepared http_request will be sent using http_client_send : 1 time :
     success_response->payload = "";
     http_client_send_ExpectAnyArgsAndReturn(MCL_OK);
@@ -1020,9 +1190,8 @@ void test_exchange_010(void)
     http_response_destroy_Ignore();
     http_request_destroy_Ignore();
 
-    // 6- Another http_request will be created for the second time_series: 1 time :
-    http_request_initialize_ExpectAnyArgsAndReturn(MCL_OK);
-    http_request_initialize_ReturnThruPtr_http_request(&http_request);
+    // 6- The first http_request will be reset and reused for the second time_series: 1 time :
+    http_request_reset_ExpectAndReturn(http_request, MCL_OK);
 
     // 6.1- Add content-type header:
     http_request_add_header_IgnoreAndReturn(MCL_OK);
@@ -1031,8 +1200,7 @@ void test_exchange_010(void)
 
     http_request_finalize_IgnoreAndReturn(MCL_OK);
 
-	// Correlation-ID
-	security_generate_random_bytes_ExpectAnyArgsAndReturn(MCL_OK);
+	// Correlation-ID is served from the random pool filled for the first request.
 
     // 7- // 3- time series will be added to the http_request by add_tuple : 1 times : Successful this time :
     http_request_add_tuple_IgnoreAndReturn(MCL_OK);
@@ -1094,10 +1262,7 @@ void test_exchange_011(void)
 
     string_t *json_meta = new_meta_json_string();
     json_from_item_meta_ReturnThruPtr_json_string(&json_meta);
-    json_from_time_series_payload_ExpectAnyArgsAndReturn(MCL_OK);
-
-    string_t *json_payload = new_time_series_payload_json_string();
-    json_from_time_series_payload_ReturnThruPtr_json_string(&json_payload);
+    json_write_time_series_payload_ExpectAnyArgsAndReturn(19);
 
     // 2- An http_request will be created : 1 time :
     http_request_initialize_ExpectAnyArgsAndReturn(MCL_OK);
@@ -1192,14 +1357,8 @@ void test_exchange_012(void)
     string_t *json_meta_2 = new_meta_json_string();
     json_from_item_meta_ReturnThruPtr_json_string(&json_meta_2);
 
-    json_from_time_series_payload_ExpectAnyArgsAndReturn(MCL_OK);
-
-    string_t *json_payload = new_time_series_payload_json_string();
-    json_from_time_series_payload_ReturnThruPtr_json_string(&json_payload);
-    json_from_time_series_payload_ExpectAnyArgsAndReturn(MCL_OK);
-
-    string_t *json_payload_2 = new_time_series_payload_json_string();
-    json_from_time_series_payload_ReturnThruPtr_json_string(&json_payload_2);
+    json_write_time_series_payload_ExpectAnyArgsAndReturn(19);
+    json_write_time_series_payload_ExpectAnyArgsAndReturn(19);
 
     // 2- An http_request will be created : 1 time :
     http_request_initialize_ExpectAnyArgsAndReturn(MCL_OK);
@@ -1299,14 +1458,8 @@ void test_exchange_013(void)
     string_t *json_meta_2 = new_meta_json_string();
     json_from_item_meta_ReturnThruPtr_json_string(&json_meta_2);
 
-    json_from_time_series_payload_ExpectAnyArgsAndReturn(MCL_OK);
-
-    string_t *json_payload = new_time_series_payload_json_string();
-    json_from_time_series_payload_ReturnThruPtr_json_string(&json_payload);
-    json_from_time_series_payload_ExpectAnyArgsAndReturn(MCL_OK);
-
-    string_t *json_payload_2 = new_time_series_payload_json_string();
-    json_from_time_series_payload_ReturnThruPtr_json_string(&json_payload_2);
+    json_write_time_series_payload_ExpectAnyArgsAndReturn(19);
+    json_write_time_series_payload_ExpectAnyArgsAndReturn(19);
 
     // 2- An http_request will be created : 1 time :
     http_request_initialize_ExpectAnyArgsAndReturn(MCL_OK);
@@ -1327,9 +1480,6 @@ void test_exchange_013(void)
     http_request_add_tuple_IgnoreAndReturn(MCL_OK);
     http_request_add_tuple_IgnoreAndReturn(MCL_HTTP_REQUEST_NO_MORE_SPACE);
 
-    // http_processor_exchange mechanism will start over and try to add again and that should return error too. With that it will decide we can't add anything anymore :
-    http_request_add_tuple_IgnoreAndReturn(MCL_HTTP_REQUEST_NO_MORE_SPACE);
-
     // 4- Prepared http_request will be sent using http_client_send : 1 time :
     http_client_send_ExpectAnyArgsAndReturn(MCL_OK);
     http_client_send_ReturnThruPtr_http_response(&success_response);
@@ -1338,9 +1488,8 @@ void test_exchange_013(void)
     http_response_destroy_Ignore();
     http_request_destroy_Ignore();
 
-    // 6- Another http_request will be created for the second time_series: 1 time :
-    http_request_initialize_ExpectAnyArgsAndReturn(MCL_OK);
-    http_request_initialize_ReturnThruPtr_http_request(&http_request_2);
+    // 6- The first http_request will be reset and reused for the second time_series: 1 time :
+    http_request_reset_ExpectAndReturn(http_request, MCL_OK);
 
     // 6.1- Add content-type header:
     http_request_add_header_IgnoreAndReturn(MCL_OK);
@@ -1349,8 +1498,7 @@ void test_exchange_013(void)
 
     http_request_finalize_IgnoreAndReturn(MCL_OK);
 
-	// Correlation-ID
-	security_generate_random_bytes_ExpectAnyArgsAndReturn(MCL_OK);
+	// Correlation-ID is served from the random pool filled for the first request.
 
     // 7- // 3- time series will be added to the http_request by add_tuple : 1 times : Successful this time :
     http_request_add_tuple_IgnoreAndReturn(MCL_OK);
@@ -1432,11 +1580,8 @@ void test_exchange_014(void)
     string_t *json_meta_2 = new_meta_json_string();
     json_from_item_meta_ReturnThruPtr_json_string(&json_meta_2);
 
-    // json_from_time_series_payload will be called only for time_series data :
-    json_from_time_series_payload_ExpectAnyArgsAndReturn(MCL_OK);
-
-    string_t *json_payload = new_time_series_payload_json_string();
-    json_from_time_series_payload_ReturnThruPtr_json_string(&json_payload);
+    // json_write_time_series_payload will be called only for time_series data :
+    json_write_time_series_payload_ExpectAnyArgsAndReturn(19);
 
     // 2- An http_request will be created : 1 time :
     http_request_initialize_ExpectAnyArgsAndReturn(MCL_OK);
@@ -1456,7 +1601,6 @@ void test_exchange_014(void)
     // Second one will return error telling no more space left in the request
     http_request_add_tuple_IgnoreAndReturn(MCL_OK);
     http_request_add_tuple_IgnoreAndReturn(MCL_HTTP_REQUEST_NO_MORE_SPACE);
-    http_request_add_tuple_IgnoreAndReturn(MCL_HTTP_REQUEST_NO_MORE_SPACE);
 
     // 4- Prepared http_request will be sent using http_client_send : 1 time :
     http_client_send_ExpectAnyArgsAndReturn(MCL_OK);
@@ -1467,8 +1611,7 @@ void test_exchange_014(void)
     http_request_destroy_Ignore();
 
     // 6- Prepared http_request will be sent using http_client_send : 1 time :
-    http_request_initialize_ExpectAnyArgsAndReturn(MCL_OK);
-    http_request_initialize_ReturnThruPtr_http_request(&http_request_2);
+    http_request_reset_ExpectAndReturn(http_request, MCL_OK);
     http_request_add_tuple_IgnoreAndReturn(MCL_OK);
     http_request_add_header_IgnoreAndReturn(MCL_OK);
     http_request_add_header_IgnoreAndReturn(MCL_OK);
@@ -1476,8 +1619,7 @@ void test_exchange_014(void)
 
     http_request_finalize_IgnoreAndReturn(MCL_OK);
 
-	// Correlation-ID
-	security_generate_random_bytes_ExpectAnyArgsAndReturn(MCL_OK);
+	// Correlation-ID is served from the random pool filled for the first request.
 
     http_client_send_ExpectAnyArgsAndReturn(MCL_OK);
     http_client_send_ReturnThruPtr_http_response(&fail_response);
@@ -1570,3 +1712,220 @@ void test_exchange_015(void)
 	http_processor_destroy(&http_processor);
 	mcl_store_destroy(&store);
 }
+
+// GIVEN : http_processor initialized - store initialized - 1 custom data added to store.
+// WHEN  : First exchange fails with a communication error and exchange is triggered again.
+// THEN  : Data being sent is rolled back by the first exchange and is sent by the second one.
+void test_exchange_016(void)
+{
+    E_MCL_ERROR_CODE result = http_processor_initialize(configuration, &http_processor);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(MCL_OK, result, "http_processor_initialize failed!");
+
+    http_processor->security_handler = security_handler;
+
+    // create a store
+    mcl_store_t *store = MCL_NULL;
+    result = mcl_store_initialize(MCL_FALSE, &store);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(MCL_OK, result, "mcl_store_initialize failed!");
+
+    // add a custom data to the store :
+    mcl_uint8_t payload[] =
+    {
+        '0', '1', '2', '3', '4', '5', '6', '7', '8', '9'
+    };
+    mcl_custom_data_t *custom_data = MCL_NULL;
+    result = mcl_store_new_custom_data(store, "1.0", "custom_data_type_1", routing, &custom_data);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(MCL_OK, result, "New custom data from the store failed!");
+    custom_data->payload.buffer = payload;
+    custom_data->payload.size = sizeof(payload) / sizeof(payload[0]);
+
+    // define mocks before calling exchange :
+    // 1- json_from_item_meta will be called for custom_data->meta : 1 time :
+    json_from_item_meta_ExpectAnyArgsAndReturn(MCL_OK);
+
+    string_t *json_meta = new_meta_json_string();
+    json_from_item_meta_ReturnThruPtr_json_string(&json_meta);
+
+    // 2- An http_request will be created for the first exchange and reused by the second one :
+    http_request_initialize_ExpectAnyArgsAndReturn(MCL_OK);
+    http_request_initialize_ReturnThruPtr_http_request(&http_request);
+    http_request_reset_ExpectAndReturn(http_request, MCL_OK);
+
+    http_request_add_header_IgnoreAndReturn(MCL_OK);
+    http_request_finalize_IgnoreAndReturn(MCL_OK);
+    security_generate_random_bytes_IgnoreAndReturn(MCL_OK);
+    http_request_add_tuple_IgnoreAndReturn(MCL_OK);
+
+    // 3- First send fails, second one succeeds :
+    http_client_send_ExpectAnyArgsAndReturn(MCL_COULD_NOT_CONNECT);
+    http_client_send_ExpectAnyArgsAndReturn(MCL_OK);
+    http_client_send_ReturnThruPtr_http_response(&success_response);
+
+    http_response_destroy_Ignore();
+    http_request_destroy_Ignore();
+    event_list_destroy_Ignore();
+
+    result = http_processor_exchange(http_processor, store, NULL);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(MCL_COULD_NOT_CONNECT, result, "Exchange operation should have failed!");
+    TEST_ASSERT_EQUAL_INT_MESSAGE(1, store->high_priority_list->count, "Data is removed from the store eventhough operation is failed!");
+    TEST_ASSERT_EQUAL_INT_MESSAGE(DATA_STATE_PREPARED, ((store_data_t *)store->high_priority_list->head->data)->state, "Data is not rolled back to prepared state!");
+
+    result = http_processor_exchange(http_processor, store, NULL);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(MCL_OK, result, "Exchange operation failed!");
+    TEST_ASSERT_EQUAL_INT_MESSAGE(0, store->high_priority_list->count, "Data is not removed from the store after it is sent!");
+
+    http_processor_destroy(&http_processor);
+    mcl_store_destroy(&store);
+}
+
+// GIVEN : http_processor initialized - store initialized - 1 low priority custom data added to store before 1 high priority custom data.
+// WHEN  : Exchange is called and only one custom data fits in an http request.
+// THEN  : High priority custom data is sent with the first request and low priority custom data is written to the second one.
+void test_exchange_017(void)
+{
+    E_MCL_ERROR_CODE result = http_processor_initialize(configuration, &http_processor);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(MCL_OK, result, "http_processor_initialize failed!");
+
+    http_processor->security_handler = security_handler;
+
+    // create a store
+    mcl_store_t *store = MCL_NULL;
+    result = mcl_store_initialize(MCL_FALSE, &store);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(MCL_OK, result, "mcl_store_initialize failed!");
+
+    // add a low priority and a high priority custom data to the store :
+    mcl_uint8_t payload[] =
+    {
+        '0', '1', '2', '3', '4', '5', '6', '7', '8', '9'
+    };
+    mcl_custom_data_t *low_custom_data = MCL_NULL;
+    mcl_custom_data_t *high_custom_data = MCL_NULL;
+    mcl_store_set_priority(store, MCL_STORE_PRIORITY_LOW);
+    result = mcl_store_new_custom_data(store, "1.0", "custom_data_type_1", routing, &low_custom_data);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(MCL_OK, result, "New custom data from the store failed!");
+    low_custom_data->payload.buffer = payload;
+    low_custom_data->payload.size = sizeof(payload) / sizeof(payload[0]);
+
+    mcl_store_set_priority(store, MCL_STORE_PRIORITY_HIGH);
+    result = mcl_store_new_custom_data(store, "1.0", "custom_data_type_2", routing, &high_custom_data);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(MCL_OK, result, "New custom data from the store failed!");
+    high_custom_data->payload.buffer = payload;
+    high_custom_data->payload.size = sizeof(payload) / sizeof(payload[0]);
+
+    // define mocks before calling exchange :
+    // 1- json_from_item_meta will be called for high priority custom data first :
+    string_t *high_json_meta = new_meta_json_string();
+    string_t *low_json_meta = new_meta_json_string();
+    json_from_item_meta_ExpectAnyArgsAndReturn(MCL_OK);
+    json_from_item_meta_ReturnThruPtr_json_string(&high_json_meta);
+    json_from_item_meta_ExpectAnyArgsAndReturn(MCL_OK);
+    json_from_item_meta_ReturnThruPtr_json_string(&low_json_meta);
+
+    // 2- An http_request will be created for the first custom data and reused for the second one :
+    http_request_initialize_ExpectAnyArgsAndReturn(MCL_OK);
+    http_request_initialize_ReturnThruPtr_http_request(&http_request);
+    http_request_reset_ExpectAndReturn(http_request, MCL_OK);
+
+    http_request_add_header_IgnoreAndReturn(MCL_OK);
+    http_request_finalize_IgnoreAndReturn(MCL_OK);
+    security_generate_random_bytes_IgnoreAndReturn(MCL_OK);
+
+    // 3- High priority custom data fills the first request, low priority one is written to the second request :
+    http_request_add_tuple_ExpectAnyArgsAndReturn(MCL_OK);
+    http_request_add_tuple_ExpectAnyArgsAndReturn(MCL_HTTP_REQUEST_NO_MORE_SPACE);
+    http_request_add_tuple_ExpectAnyArgsAndReturn(MCL_OK);
+
+    // 4- First send succeeds, second one fails :
+    http_client_send_ExpectAnyArgsAndReturn(MCL_OK);
+    http_client_send_ReturnThruPtr_http_response(&success_response);
+    http_client_send_ExpectAnyArgsAndReturn(MCL_COULD_NOT_CONNECT);
+
+    http_response_destroy_Ignore();
+    http_request_destroy_Ignore();
+    event_list_destroy_Ignore();
+
+    result = http_processor_exchange(http_processor, store, NULL);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(MCL_COULD_NOT_CONNECT, result, "Exchange operation should have failed!");
+    TEST_ASSERT_EQUAL_INT_MESSAGE(0, store->high_priority_list->count, "High priority data is not sent with the first request!");
+    TEST_ASSERT_EQUAL_INT_MESSAGE(1, store->low_priority_list->count, "Low priority data is removed from the store eventhough it is not sent!");
+    TEST_ASSERT_EQUAL_INT_MESSAGE(2, store->aging_count - ((store_data_t *)store->low_priority_list->head->data)->aging_start, "Low priority data is not aged by each request!");
+
+    http_processor_destroy(&http_processor);
+    mcl_store_destroy(&store);
+}
+
+// GIVEN : http_processor initialized - persistent store initialized - 2 custom data added to store, the first one with a content id.
+// WHEN  : Exchange fails with a communication error and the store is initialized again from the same directory.
+// THEN  : First custom data is written to write-ahead log when the second one is added and both are replayed with their content id.
+void test_exchange_018(void)
+{
+    E_MCL_ERROR_CODE result = http_processor_initialize(configuration, &http_processor);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(MCL_OK, result, "http_processor_initialize failed!");
+
+    http_processor->security_handler = security_handler;
+
+    // create a persistent store
+    mcl_store_t *store = MCL_NULL;
+    result = mcl_store_initialize_persistent(MCL_FALSE, ".", &store);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(MCL_OK, result, "mcl_store_initialize_persistent failed!");
+
+    // add two custom data to the store :
+    mcl_uint8_t payload[] =
+    {
+        '0', '1', '2', '3', '4', '5', '6', '7', '8', '9'
+    };
+    mcl_custom_data_t *custom_data_1 = MCL_NULL;
+    mcl_custom_data_t *custom_data_2 = MCL_NULL;
+    result = mcl_store_new_custom_data(store, "1.0", "custom_data_type_1", routing, &custom_data_1);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(MCL_OK, result, "New custom data from the store failed!");
+    custom_data_1->payload.buffer = payload;
+    custom_data_1->payload.size = sizeof(payload) / sizeof(payload[0]);
+    string_initialize_new("content_id_1", 0, &((custom_data_t *)custom_data_1)->meta.content_id);
+
+    // 1- json_from_item_meta will be called for the first custom data when the second one is added, and for the second one by exchange :
+    string_t *json_meta_1 = new_meta_json_string();
+    string_t *json_meta_2 = new_meta_json_string();
+    json_from_item_meta_ExpectAnyArgsAndReturn(MCL_OK);
+    json_from_item_meta_ReturnThruPtr_json_string(&json_meta_1);
+
+    result = mcl_store_new_custom_data(store, "1.0", "custom_data_type_2", routing, &custom_data_2);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(MCL_OK, result, "New custom data from the store failed!");
+    custom_data_2->payload.buffer = payload;
+    custom_data_2->payload.size = sizeof(payload) / sizeof(payload[0]);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(STORE_DATA_PERSISTED, ((store_data_t *)store->high_priority_list->head->data)->type, "First data is not persisted when the second one is added!");
+
+    json_from_item_meta_ExpectAnyArgsAndReturn(MCL_OK);
+    json_from_item_meta_ReturnThruPtr_json_string(&json_meta_2);
+
+    // 2- Both data are written to the request but the request can not be sent :
+    http_request_initialize_ExpectAnyArgsAndReturn(MCL_OK);
+    http_request_initialize_ReturnThruPtr_http_request(&http_request);
+    http_request_add_header_IgnoreAndReturn(MCL_OK);
+    http_request_finalize_IgnoreAndReturn(MCL_OK);
+    security_generate_random_bytes_IgnoreAndReturn(MCL_OK);
+    http_request_add_tuple_IgnoreAndReturn(MCL_OK);
+    http_client_send_ExpectAnyArgsAndReturn(MCL_COULD_NOT_CONNECT);
+    http_response_destroy_Ignore();
+    http_request_destroy_Ignore();
+
+    result = http_processor_exchange(http_processor, store, NULL);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(MCL_COULD_NOT_CONNECT, result, "Exchange operation should have failed!");
+
+    mcl_store_destroy(&store);
+
+    // Store initialized again from the same directory has both data :
+    result = mcl_store_initialize_persistent(MCL_FALSE, ".", &store);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(MCL_OK, result, "mcl_store_initialize_persistent failed!");
+    TEST_ASSERT_EQUAL_INT_MESSAGE(2, store->high_priority_list->count, "Data is not replayed from write-ahead log!");
+
+    store_wal_record_t *record = (store_wal_record_t *)((store_data_t *)store->high_priority_list->head->data)->data;
+    TEST_ASSERT_NOT_NULL_MESSAGE(record->content_id, "Content id is not replayed!");
+    TEST_ASSERT_EQUAL_STRING("content_id_1", record->content_id->buffer);
+
+    http_processor_destroy(&http_processor);
+    mcl_store_destroy(&store);
+
+    remove("./mcl_store_0.wal");
+    remove("./mcl_store.head");
+    remove("./mcl_store.lock");
+}
@@ -24,8 +24,19 @@
 #include "definitions.h"
 #include "security.h"
 #include "security_libcrypto.h"
+#include "file_util.h"
 
 #define USER_AGENT "MCL/0.9.0.0"
+#define FRAGMENT_PAYLOAD "ABCDEFGHIJKLMNOPQRST"
+#define FRAGMENT_PAYLOAD_SIZE 20
+#define FRAGMENT_FILE_NAME "http_request_fragment.txt"
+
+// Source of payload which can only be read in consecutive parts like a file.
+typedef struct sequential_source_t
+{
+    const char *data;
+    mcl_size_t position;
+} sequential_source_t;
 
 http_request_t *http_request = MCL_NULL;
 string_t *host = MCL_NULL;
@@ -61,8 +72,54 @@ mcl_size_t _get_payload_from_buffer(void *destination, void *source, mcl_size_t
     return size;
 }
 
+mcl_size_t _get_payload_from_sequential_source(void *destination, void *source, mcl_size_t size, void *user_context)
+{
+    sequential_source_t *sequential_source = (sequential_source_t *)source;
+
+    string_util_memcpy(destination, sequential_source->data + sequential_source->position, size);
+    sequential_source->position += size;
+
+    return size;
+}
+
+E_MCL_ERROR_CODE _rewind_sequential_source(void *source, mcl_size_t size, void *user_context)
+{
+    sequential_source_t *sequential_source = (sequential_source_t *)source;
+
+    if (sequential_source->position < size)
+    {
+        return MCL_FAIL;
+    }
+
+    sequential_source->position -= size;
+
+    return MCL_OK;
+}
+
+mcl_size_t _get_payload_from_file(void *destination, void *file_descriptor, mcl_size_t size, void *user_context)
+{
+    mcl_size_t actual_size_read = 0;
+
+    file_util_fread(destination, 1, size, file_descriptor, &actual_size_read);
+
+    return actual_size_read;
+}
+
+E_MCL_ERROR_CODE _rewind_payload_of_file(void *file_descriptor, mcl_size_t size, void *user_context)
+{
+    mcl_size_t position = 0;
+    E_MCL_ERROR_CODE code = file_util_ftell(file_descriptor, &position);
+
+    (MCL_OK == code) && (code = file_util_fseek(file_descriptor, position - size));
+
+    return code;
+}
+
 // Private Function Prototypes:
 static void _replace_all_random_generated_boundaries_with_known_string(http_request_t *http_request);
+static void _add_fragment_tuple(payload_copy_callback_t copy_callback, payload_rewind_callback_t rewind_callback, void *payload, string_t **meta_string);
+static mcl_size_t _read_body(mcl_size_t part_size, mcl_size_t max_size, mcl_uint8_t *body);
+static void _assert_fragment_body(mcl_uint8_t *body, mcl_size_t body_size);
 
 /**
  * GIVEN : Host, uri and **http_request are not null and payload_size is zero.
@@ -71,7 +128,7 @@ static void _replace_all_random_generated_boundaries_with_known_string(http_requ
  */
 void test_initialize_001(void)
 {
-    E_MCL_ERROR_CODE result = http_request_initialize(method, uri, header_size, payload_size, HTTP_REQUEST_RESIZE_ENABLED, user_agent, max_http_payload_size,
+    E_MCL_ERROR_CODE result = http_request_initialize(method, uri, header_size, payload_size, HTTP_REQUEST_RESIZE_ENABLED, user_agent, max_http_payload_size, MCL_NULL,
                                   &http_request);
 
     TEST_ASSERT_MESSAGE(MCL_OK == result, "http_request_initialize() function returns error.");
@@ -95,7 +152,7 @@ void test_initialize_002(void)
 {
     payload_size = 10;
 
-    E_MCL_ERROR_CODE result = http_request_initialize(method, uri, header_size, payload_size, HTTP_REQUEST_RESIZE_ENABLED, user_agent, max_http_payload_size,
+    E_MCL_ERROR_CODE result = http_request_initialize(method, uri, header_size, payload_size, HTTP_REQUEST_RESIZE_ENABLED, user_agent, max_http_payload_size, MCL_NULL,
                                   &http_request);
 
     TEST_ASSERT_MESSAGE(MCL_OK == result, "http_request_initialize() function returns error.");
@@ -122,7 +179,7 @@ void test_initialize_002(void)
 void test_add_header_001(void)
 {
     // Initialize header request.
-    http_request_initialize(method, uri, header_size, payload_size, HTTP_REQUEST_RESIZE_ENABLED, user_agent, max_http_payload_size, &http_request);
+    http_request_initialize(method, uri, header_size, payload_size, HTTP_REQUEST_RESIZE_ENABLED, user_agent, max_http_payload_size, MCL_NULL, &http_request);
 
     // Initialize header name.
     string_t *header_name = MCL_NULL;
@@ -176,7 +233,7 @@ void test_add_single_001(void)
     mcl_size_t payload_size = 5000;
 
     // Initialize header request.
-    http_request_initialize(method, uri, header_size, payload_size, HTTP_REQUEST_RESIZE_ENABLED, user_agent, max_http_payload_size, &http_request);
+    http_request_initialize(method, uri, header_size, payload_size, HTTP_REQUEST_RESIZE_ENABLED, user_agent, max_http_payload_size, MCL_NULL, &http_request);
 
     // Initialize content_id.
     string_t *content_id = MCL_NULL;
@@ -219,7 +276,7 @@ void test_add_single_002(void)
     mcl_size_t payload_size = 100;
 
     // Initialize header request.
-    http_request_initialize(method, uri, header_size, payload_size, HTTP_REQUEST_RESIZE_ENABLED, user_agent, max_http_payload_size, &http_request);
+    http_request_initialize(method, uri, header_size, payload_size, HTTP_REQUEST_RESIZE_ENABLED, user_agent, max_http_payload_size, MCL_NULL, &http_request);
 
     // Initialize content_id.
     string_t *content_id = MCL_NULL;
@@ -263,7 +320,7 @@ void test_add_single_003(void)
 	mcl_size_t very_large_http_payload_size = 10000000;
 
 	// Initialize header request.
-	http_request_initialize(method, uri, header_size, payload_size, HTTP_REQUEST_RESIZE_ENABLED, user_agent, very_large_http_payload_size, &http_request);
+	http_request_initialize(method, uri, header_size, payload_size, HTTP_REQUEST_RESIZE_ENABLED, user_agent, very_large_http_payload_size, MCL_NULL, &http_request);
 
 	// Initialize content_id.
 	string_t *content_id = MCL_NULL;
@@ -296,7 +353,7 @@ void test_add_tuple_001(void)
     mcl_size_t payload_size_local = 1000;
 
     // Initialize header request.
-    http_request_initialize(method, uri, header_size, payload_size_local, HTTP_REQUEST_RESIZE_ENABLED, user_agent, max_http_payload_size, &http_request);
+    http_request_initialize(method, uri, header_size, payload_size_local, HTTP_REQUEST_RESIZE_ENABLED, user_agent, max_http_payload_size, MCL_NULL, &http_request);
 
     // Initialize meta_string.
     string_t *meta_string = MCL_NULL;
@@ -307,8 +364,8 @@ void test_add_tuple_001(void)
     mcl_size_t payload_size = 2;
 
     // Add a tuple to http_request with Null http_request parameter.
-    E_MCL_ERROR_CODE result = http_request_add_tuple(http_request, meta_string, &content_type_values[CONTENT_TYPE_META_JSON], _get_payload_from_buffer, MCL_NULL, payload,
-                                  payload_size, &content_type_values[CONTENT_TYPE_TEXT_PLAIN]);
+    E_MCL_ERROR_CODE result = http_request_add_tuple(http_request, meta_string, &content_type_values[CONTENT_TYPE_META_JSON], _get_payload_from_buffer, MCL_NULL, MCL_NULL, payload,
+                                  payload_size, &content_type_values[CONTENT_TYPE_TEXT_PLAIN], MCL_TRUE);
     TEST_ASSERT_MESSAGE(MCL_OK == result, "http_request_add_tuple() function failed.");
 
     // Replace random generated boundary with known string to be able to compare the rest of the payload successfully.
@@ -337,7 +394,7 @@ void test_add_tuple_002(void)
     mcl_size_t payload_size_local = 100;
 
     // Initialize header request.
-    http_request_initialize(method, uri, header_size, payload_size_local, HTTP_REQUEST_RESIZE_ENABLED, user_agent, max_http_payload_size, &http_request);
+    http_request_initialize(method, uri, header_size, payload_size_local, HTTP_REQUEST_RESIZE_ENABLED, user_agent, max_http_payload_size, MCL_NULL, &http_request);
 
     // Initialize meta_string.
     string_t *meta_string = MCL_NULL;
@@ -348,8 +405,8 @@ void test_add_tuple_002(void)
     mcl_size_t payload_size = 2;
 
     // Add a tuple to http_request with Null http_request parameter.
-    E_MCL_ERROR_CODE result = http_request_add_tuple(http_request, meta_string, &content_type_values[CONTENT_TYPE_META_JSON], _get_payload_from_buffer, MCL_NULL, payload,
-                                  payload_size, &content_type_values[CONTENT_TYPE_TEXT_PLAIN]);
+    E_MCL_ERROR_CODE result = http_request_add_tuple(http_request, meta_string, &content_type_values[CONTENT_TYPE_META_JSON], _get_payload_from_buffer, MCL_NULL, MCL_NULL, payload,
+                                  payload_size, &content_type_values[CONTENT_TYPE_TEXT_PLAIN], MCL_TRUE);
     TEST_ASSERT_MESSAGE(MCL_OK == result, "http_request_add_tuple() function failed.");
 
     // Replace random generated boundary with known string to be able to compare the rest of the payload successfully.
@@ -379,7 +436,7 @@ void test_add_tuple_003(void)
     mcl_size_t payload_size_local = max_http_payload_size - 10;
 
     // Initialize header request.
-    http_request_initialize(method, uri, header_size, payload_size_local, HTTP_REQUEST_RESIZE_ENABLED, user_agent, max_http_payload_size, &http_request);
+    http_request_initialize(method, uri, header_size, payload_size_local, HTTP_REQUEST_RESIZE_ENABLED, user_agent, max_http_payload_size, MCL_NULL, &http_request);
 
     // Initialize meta_string.
     string_t *meta_string = MCL_NULL;
@@ -393,8 +450,8 @@ void test_add_tuple_003(void)
     http_request->payload_offset = max_http_payload_size - 15;
 
     // Add a tuple to http_request with Null http_request parameter.
-    E_MCL_ERROR_CODE result = http_request_add_tuple(http_request, meta_string, &content_type_values[CONTENT_TYPE_META_JSON], _get_payload_from_buffer, MCL_NULL, payload,
-                                  payload_size, &content_type_values[CONTENT_TYPE_TEXT_PLAIN]);
+    E_MCL_ERROR_CODE result = http_request_add_tuple(http_request, meta_string, &content_type_values[CONTENT_TYPE_META_JSON], _get_payload_from_buffer, MCL_NULL, MCL_NULL, payload,
+                                  payload_size, &content_type_values[CONTENT_TYPE_TEXT_PLAIN], MCL_TRUE);
     TEST_ASSERT_MESSAGE(MCL_HTTP_REQUEST_NO_MORE_SPACE == result, "http_request_add_tuple() function didn't return MCL_HTTP_REQUEST_NO_MORE_SPACE.");
 
     // Payload buffer can't be resized by the required memory, since that exceeds max_http_payload_size.
@@ -404,6 +461,65 @@ void test_add_tuple_003(void)
     string_destroy(&meta_string);
 }
 
+/**
+ * GIVEN : Initialized #http_request.
+ * WHEN  : http_request_add_tuple() is called with copy_payload MCL_FALSE and the body is read in small parts.
+ * THEN  : Meta and payload are not copied to payload buffer, the body read is the same as the body composed with copies.
+ */
+void test_add_tuple_004(void)
+{
+    mcl_size_t payload_size_local = 1000;
+    mcl_size_t boundary_start_addresses[5] = {2, 67, 95, 293, 351};
+    mcl_uint8_t body[512];
+    mcl_size_t body_size = 0;
+    mcl_size_t read_size;
+
+    // Initialize header request.
+    http_request_initialize(method, uri, header_size, payload_size_local, HTTP_REQUEST_RESIZE_ENABLED, user_agent, max_http_payload_size, MCL_NULL, &http_request);
+
+    // Initialize meta_string.
+    string_t *meta_string = MCL_NULL;
+    string_initialize_new("{\"type\":\"chunk\",\"version\":\"1.0\",\"details\":{\"chunkSetId\":\"98fcf48a-102f-11e6-a148-3e1d05defe78\",\"chunkNo\":0}}", 0, &meta_string);
+
+    // Random numbers. 0x41 = 'A'.
+    mcl_uint8_t payload[] = { 0x41, 0x41 };
+    mcl_size_t payload_size = 2;
+
+    // Add a tuple to http_request, payload is referenced as a memory buffer.
+    E_MCL_ERROR_CODE result = http_request_add_tuple(http_request, meta_string, &content_type_values[CONTENT_TYPE_META_JSON], MCL_NULL, MCL_NULL, MCL_NULL, payload,
+                                  payload_size, &content_type_values[CONTENT_TYPE_TEXT_PLAIN], MCL_FALSE);
+    TEST_ASSERT_MESSAGE(MCL_OK == result, "http_request_add_tuple() function failed.");
+
+    result = http_request_finalize(http_request);
+    TEST_ASSERT_MESSAGE(MCL_OK == result, "http_request_finalize() function failed.");
+
+    TEST_ASSERT_EQUAL_MESSAGE(2, http_request->fragment_count, "Meta and payload are not added as fragments.");
+    TEST_ASSERT_EQUAL_MESSAGE(meta_string->length + payload_size, http_request->fragments_size, "Size of fragments is wrong.");
+    TEST_ASSERT_EQUAL_MESSAGE(http_request->payload_size + meta_string->length + payload_size, http_request_get_body_size(http_request), "Body size is wrong.");
+
+    // Read the body in parts smaller than any of the fragments and framing between them.
+    do
+    {
+        read_size = http_request_read_body(http_request, body + body_size, 7);
+        body_size += read_size;
+    } while (0 != read_size);
+
+    TEST_ASSERT_EQUAL_MESSAGE(http_request_get_body_size(http_request), body_size, "Size of body read is wrong.");
+
+    for (int i = 0; i < 5; ++i)
+    {
+        string_util_memcpy(&body[boundary_start_addresses[i]], "xxxxxxxxxxxxxxxxxxxxxx", BOUNDARY_LENGTH);
+    }
+
+    char *expected =
+        "--xxxxxxxxxxxxxxxxxxxxxx\r\nContent-Type: multipart/related;boundary=xxxxxxxxxxxxxxxxxxxxxx\r\n\r\n--xxxxxxxxxxxxxxxxxxxxxx\r\nContent-Type: application/vnd.siemens.mindsphere.meta+json\r\n\r\n{\"type\":\"chunk\",\"version\":\"1.0\",\"details\":{\"chunkSetId\":\"98fcf48a-102f-11e6-a148-3e1d05defe78\",\"chunkNo\":0}}\r\n--xxxxxxxxxxxxxxxxxxxxxx\r\nContent-Type: text/plain\r\n\r\nAA\r\n--xxxxxxxxxxxxxxxxxxxxxx--\r\n";
+
+    TEST_ASSERT_EQUAL_UINT8_ARRAY_MESSAGE((mcl_uint8_t *)expected, body, string_util_strlen(expected), "Body content is wrong.");
+
+    // Clean up.
+    string_destroy(&meta_string);
+}
+
 /**
  * GIVEN : Initialized http_request.
  * WHEN  : Payload size is more than required memory and http_request_finalize() is called, unused memory space is released.
@@ -415,7 +531,7 @@ void test_finalize_001(void)
     mcl_size_t payload_size = 500;
 
     // Initialize header request.
-    http_request_initialize(method, uri, header_size, payload_size, HTTP_REQUEST_RESIZE_ENABLED, user_agent, max_http_payload_size, &http_request);
+    http_request_initialize(method, uri, header_size, payload_size, HTTP_REQUEST_RESIZE_ENABLED, user_agent, max_http_payload_size, MCL_NULL, &http_request);
 
     E_MCL_ERROR_CODE result = http_request_finalize(http_request);
     TEST_ASSERT_MESSAGE(MCL_OK == result, "http_request_finalize() function failed.");
@@ -447,7 +563,7 @@ void test_finalize_002(void)
     mcl_size_t payload_size = 20;
 
     // Initialize header request.
-    http_request_initialize(method, uri, header_size, payload_size, HTTP_REQUEST_RESIZE_ENABLED, user_agent, max_http_payload_size, &http_request);
+    http_request_initialize(method, uri, header_size, payload_size, HTTP_REQUEST_RESIZE_ENABLED, user_agent, max_http_payload_size, MCL_NULL, &http_request);
 
     E_MCL_ERROR_CODE result = http_request_finalize(http_request);
     TEST_ASSERT_MESSAGE(MCL_OK == result, "http_request_finalize() function failed.");
@@ -476,7 +592,7 @@ void test_finalize_003(void)
     mcl_size_t payload_size = max_http_payload_size - 10;
 
     // Initialize header request.
-    http_request_initialize(method, uri, header_size, payload_size, HTTP_REQUEST_RESIZE_ENABLED, user_agent, max_http_payload_size, &http_request);
+    http_request_initialize(method, uri, header_size, payload_size, HTTP_REQUEST_RESIZE_ENABLED, user_agent, max_http_payload_size, MCL_NULL, &http_request);
 
     // Simulate payload is filled, and offset is set to a big value.
     http_request->payload_offset = max_http_payload_size - 15;
@@ -499,7 +615,7 @@ void test_finalize_004(void)
     mcl_size_t payload_size = 26;
 
     // Initialize header request.
-    http_request_initialize(method, uri, header_size, payload_size, HTTP_REQUEST_RESIZE_ENABLED, user_agent, max_http_payload_size, &http_request);
+    http_request_initialize(method, uri, header_size, payload_size, HTTP_REQUEST_RESIZE_ENABLED, user_agent, max_http_payload_size, MCL_NULL, &http_request);
 
     E_MCL_ERROR_CODE result = http_request_finalize(http_request);
     TEST_ASSERT_MESSAGE(MCL_OK == result, "http_request_finalize() function failed.");
@@ -508,6 +624,146 @@ void test_finalize_004(void)
     TEST_ASSERT_EQUAL_MESSAGE(payload_size, http_request->payload_size, "Payload size shouldn't have been resized.");
 }
 
+/**
+ * GIVEN : A reusable http request with a header and a tuple is finalized.
+ * WHEN  : http_request_reset() is called.
+ * THEN  : MCL_OK is returned, payload buffer and header array are kept and only User-Agent header is left.
+ */
+void test_reset_001(void)
+{
+    mcl_size_t payload_size_local = 1000;
+
+    // Initialize header request.
+    http_request_initialize(method, uri, header_size, payload_size_local, HTTP_REQUEST_RESIZE_ENABLED, user_agent, max_http_payload_size, MCL_NULL, &http_request);
+    http_request->reusable = MCL_TRUE;
+
+    string_t *meta_string = MCL_NULL;
+    string_initialize_new("{\"type\":\"chunk\",\"version\":\"1.0\"}", 0, &meta_string);
+    mcl_uint8_t payload[] = { 0x41, 0x41 };
+
+    E_MCL_ERROR_CODE result = http_request_add_header(http_request, &http_header_names[HTTP_HEADER_CONTENT_TYPE], &content_type_values[CONTENT_TYPE_MULTIPART_MIXED]);
+    TEST_ASSERT_MESSAGE(MCL_OK == result, "http_request_add_header() function failed.");
+
+    result = http_request_add_tuple(http_request, meta_string, &content_type_values[CONTENT_TYPE_META_JSON], MCL_NULL, MCL_NULL, MCL_NULL, payload, sizeof(payload),
+                                    &content_type_values[CONTENT_TYPE_TEXT_PLAIN], MCL_FALSE);
+    TEST_ASSERT_MESSAGE(MCL_OK == result, "http_request_add_tuple() function failed.");
+
+    result = http_request_finalize(http_request);
+    TEST_ASSERT_MESSAGE(MCL_OK == result, "http_request_finalize() function failed.");
+
+    mcl_uint8_t *payload_buffer = http_request->payload;
+    string_array_item_t *header_items = http_request->header->items;
+    char first_boundary[BOUNDARY_LENGTH];
+    string_util_memcpy(first_boundary, http_request->boundary->buffer, BOUNDARY_LENGTH);
+
+    // Buffer of reusable request is not shrunk.
+    TEST_ASSERT_EQUAL_MESSAGE(payload_size_local, http_request->payload_buffer_size, "Payload buffer of reusable request is shrunk.");
+
+    result = http_request_reset(http_request);
+    TEST_ASSERT_MESSAGE(MCL_OK == result, "http_request_reset() function failed.");
+
+    TEST_ASSERT_EQUAL_PTR_MESSAGE(payload_buffer, http_request->payload, "Payload buffer is not kept.");
+    TEST_ASSERT_EQUAL_PTR_MESSAGE(header_items, http_request->header->items, "Header array is not kept.");
+    TEST_ASSERT_EQUAL_MESSAGE(payload_size_local, http_request->payload_size, "Payload size is not restored.");
+    TEST_ASSERT_EQUAL_MESSAGE(0, http_request->payload_offset, "Payload offset is not reset.");
+    TEST_ASSERT_EQUAL_MESSAGE(0, http_request->fragment_count, "Fragments are not removed.");
+    TEST_ASSERT_EQUAL_MESSAGE(0, http_request->fragments_size, "Size of fragments is not reset.");
+    TEST_ASSERT_EQUAL_MESSAGE(1, http_request->header->index, "Headers other than User-Agent are not removed.");
+    TEST_ASSERT_EQUAL_STRING_MESSAGE("User-Agent: " USER_AGENT, string_array_get(http_request->header, 0)->buffer, "User-Agent header is not kept.");
+    TEST_ASSERT_EQUAL_MESSAGE(BOUNDARY_LENGTH, http_request->boundary->length, "Boundary length is changed.");
+    TEST_ASSERT_MESSAGE(MCL_OK != string_util_strncmp(first_boundary, http_request->boundary->buffer, BOUNDARY_LENGTH), "New boundary is not generated.");
+
+    // Clean up.
+    string_destroy(&meta_string);
+}
+
+/**
+ * GIVEN : A finalized http request whose payload is added as a fragment read by a callback in consecutive parts.
+ * WHEN  : http_request_read_body() is called with parts smaller than the fragments, http_request_rewind_body() is called and the body is read again.
+ * THEN  : The same body is read both times and the source is moved back to its beginning by the rewind callback.
+ */
+void test_read_body_001(void)
+{
+    sequential_source_t source = {FRAGMENT_PAYLOAD, 0};
+    string_t *meta_string = MCL_NULL;
+    mcl_uint8_t body[512];
+    mcl_size_t body_size;
+
+    _add_fragment_tuple(_get_payload_from_sequential_source, _rewind_sequential_source, &source, &meta_string);
+
+    body_size = _read_body(7, sizeof(body), body);
+    _assert_fragment_body(body, body_size);
+    TEST_ASSERT_EQUAL_MESSAGE(FRAGMENT_PAYLOAD_SIZE, source.position, "Source is not read completely.");
+
+    E_MCL_ERROR_CODE result = http_request_rewind_body(http_request);
+    TEST_ASSERT_MESSAGE(MCL_OK == result, "http_request_rewind_body() function failed.");
+    TEST_ASSERT_EQUAL_MESSAGE(0, source.position, "Source is not moved back to its beginning.");
+
+    body_size = _read_body(5, sizeof(body), body);
+    _assert_fragment_body(body, body_size);
+
+    // Clean up.
+    string_destroy(&meta_string);
+}
+
+/**
+ * GIVEN : A finalized http request whose payload is added as a fragment read from a file.
+ * WHEN  : Body is read up to the middle of the payload, http_request_rewind_body() is called and the body is read again.
+ * THEN  : File is moved back by the part of the payload read and the complete body is read.
+ */
+void test_read_body_002(void)
+{
+    void *file_descriptor = MCL_NULL;
+    string_t *meta_string = MCL_NULL;
+    mcl_uint8_t body[512];
+    mcl_size_t body_size;
+
+    E_MCL_ERROR_CODE result = file_util_fopen(FRAGMENT_FILE_NAME, "w", &file_descriptor);
+    TEST_ASSERT_MESSAGE(MCL_OK == result, "No support for file handling.");
+    file_util_fputs(FRAGMENT_PAYLOAD, file_descriptor);
+    file_util_fclose(file_descriptor);
+    file_util_fopen(FRAGMENT_FILE_NAME, "r", &file_descriptor);
+
+    _add_fragment_tuple(_get_payload_from_file, _rewind_payload_of_file, file_descriptor, &meta_string);
+
+    // Payload starts after the body composed so far and meta, read 5 bytes of it.
+    _read_body(http_request->fragments[1].position + meta_string->length + 5, http_request->fragments[1].position + meta_string->length + 5, body);
+    TEST_ASSERT_EQUAL_MESSAGE(1, http_request->read_fragment_index, "Body is not read up to the payload.");
+    TEST_ASSERT_EQUAL_MESSAGE(5, http_request->read_fragment_offset, "Payload is not read partially.");
+
+    result = http_request_rewind_body(http_request);
+    TEST_ASSERT_MESSAGE(MCL_OK == result, "http_request_rewind_body() function failed.");
+
+    body_size = _read_body(7, sizeof(body), body);
+    _assert_fragment_body(body, body_size);
+
+    // Clean up.
+    file_util_fclose(file_descriptor);
+    file_util_remove(FRAGMENT_FILE_NAME);
+    string_destroy(&meta_string);
+}
+
+/**
+ * GIVEN : A finalized http request whose payload is added as a fragment read by a callback without a rewind callback.
+ * WHEN  : http_request_rewind_body() is called after the payload is read.
+ * THEN  : MCL_FAIL is returned.
+ */
+void test_rewind_body_001(void)
+{
+    sequential_source_t source = {FRAGMENT_PAYLOAD, 0};
+    string_t *meta_string = MCL_NULL;
+    mcl_uint8_t body[512];
+
+    _add_fragment_tuple(_get_payload_from_sequential_source, MCL_NULL, &source, &meta_string);
+    _read_body(sizeof(body), sizeof(body), body);
+
+    E_MCL_ERROR_CODE result = http_request_rewind_body(http_request);
+    TEST_ASSERT_MESSAGE(MCL_FAIL == result, "http_request_rewind_body() does not return MCL_FAIL.");
+
+    // Clean up.
+    string_destroy(&meta_string);
+}
+
 /**
  * GIVEN : An http request is initialized successfully.
  * WHEN  : http_request_destroy() is called.
@@ -515,7 +771,7 @@ void test_finalize_004(void)
  */
 void test_destroy_001(void)
 {
-    http_request_initialize(method, uri, header_size, payload_size, HTTP_REQUEST_RESIZE_ENABLED, user_agent, max_http_payload_size, &http_request);
+    http_request_initialize(method, uri, header_size, payload_size, HTTP_REQUEST_RESIZE_ENABLED, user_agent, max_http_payload_size, MCL_NULL, &http_request);
 
     http_request_destroy(&http_request);
 
@@ -529,7 +785,7 @@ void test_destroy_001(void)
  */
 void test_start_tuple(void)
 {
-    E_MCL_ERROR_CODE result = http_request_initialize(method, uri, header_size, payload_size, HTTP_REQUEST_RESIZE_ENABLED, user_agent, max_http_payload_size,
+    E_MCL_ERROR_CODE result = http_request_initialize(method, uri, header_size, payload_size, HTTP_REQUEST_RESIZE_ENABLED, user_agent, max_http_payload_size, MCL_NULL,
                                   &http_request);
     TEST_ASSERT(MCL_OK == result);
 
@@ -547,7 +803,7 @@ void test_start_tuple(void)
  */
 void test_start_tuple_sub_section(void)
 {
-    E_MCL_ERROR_CODE result = http_request_initialize(method, uri, header_size, payload_size, HTTP_REQUEST_RESIZE_ENABLED, user_agent, max_http_payload_size, &http_request);
+    E_MCL_ERROR_CODE result = http_request_initialize(method, uri, header_size, payload_size, HTTP_REQUEST_RESIZE_ENABLED, user_agent, max_http_payload_size, MCL_NULL, &http_request);
     TEST_ASSERT(MCL_OK == result);
 
 	string_t content_type = STRING_CONSTANT("application / vnd.siemens.mindsphere.meta + json");
@@ -576,3 +832,52 @@ static void _replace_all_random_generated_boundaries_with_known_string(http_requ
         string_util_memcpy(&http_request->payload[boundary_start_addresses[i]], "xxxxxxxxxxxxxxxxxxxxxx", BOUNDARY_LENGTH);
     }
 }
+
+// Initializes the http request with a tuple whose meta and payload are fragments and finalizes it.
+static void _add_fragment_tuple(payload_copy_callback_t copy_callback, payload_rewind_callback_t rewind_callback, void *payload, string_t **meta_string)
+{
+    http_request_initialize(method, uri, header_size, 1000, HTTP_REQUEST_RESIZE_ENABLED, user_agent, max_http_payload_size, MCL_NULL, &http_request);
+
+    string_initialize_new("{\"type\":\"chunk\",\"version\":\"1.0\",\"details\":{\"chunkSetId\":\"98fcf48a-102f-11e6-a148-3e1d05defe78\",\"chunkNo\":0}}", 0, meta_string);
+
+    E_MCL_ERROR_CODE result = http_request_add_tuple(http_request, *meta_string, &content_type_values[CONTENT_TYPE_META_JSON], copy_callback, rewind_callback, MCL_NULL,
+                                                     payload, FRAGMENT_PAYLOAD_SIZE, &content_type_values[CONTENT_TYPE_TEXT_PLAIN], MCL_FALSE);
+    TEST_ASSERT_MESSAGE(MCL_OK == result, "http_request_add_tuple() function failed.");
+
+    result = http_request_finalize(http_request);
+    TEST_ASSERT_MESSAGE(MCL_OK == result, "http_request_finalize() function failed.");
+    TEST_ASSERT_EQUAL_MESSAGE(2, http_request->fragment_count, "Meta and payload are not added as fragments.");
+}
+
+// Reads the body of the http request in parts of part_size until its end or until max_size bytes are read.
+static mcl_size_t _read_body(mcl_size_t part_size, mcl_size_t max_size, mcl_uint8_t *body)
+{
+    mcl_size_t body_size = 0;
+    mcl_size_t read_size;
+
+    do
+    {
+        read_size = http_request_read_body(http_request, body + body_size, (part_size < max_size - body_size) ? part_size : (max_size - body_size));
+        body_size += read_size;
+    } while ((0 != read_size) && (body_size < max_size));
+
+    return body_size;
+}
+
+// Checks the body of the tuple added by _add_fragment_tuple.
+static void _assert_fragment_body(mcl_uint8_t *body, mcl_size_t body_size)
+{
+    mcl_size_t boundary_start_addresses[5] = {2, 67, 95, 293, 369};
+
+    char *expected =
+        "--xxxxxxxxxxxxxxxxxxxxxx\r\nContent-Type: multipart/related;boundary=xxxxxxxxxxxxxxxxxxxxxx\r\n\r\n--xxxxxxxxxxxxxxxxxxxxxx\r\nContent-Type: application/vnd.siemens.mindsphere.meta+json\r\n\r\n{\"type\":\"chunk\",\"version\":\"1.0\",\"details\":{\"chunkSetId\":\"98fcf48a-102f-11e6-a148-3e1d05defe78\",\"chunkNo\":0}}\r\n--xxxxxxxxxxxxxxxxxxxxxx\r\nContent-Type: text/plain\r\n\r\n" FRAGMENT_PAYLOAD "\r\n--xxxxxxxxxxxxxxxxxxxxxx--\r\n";
+
+    TEST_ASSERT_EQUAL_MESSAGE(http_request_get_body_size(http_request), body_size, "Size of body read is wrong.");
+
+    for (int i = 0; i < 5; ++i)
+    {
+        string_util_memcpy(&body[boundary_start_addresses[i]], "xxxxxxxxxxxxxxxxxxxxxx", BOUNDARY_LENGTH);
+    }
+
+    TEST_ASSERT_EQUAL_UINT8_ARRAY_MESSAGE((mcl_uint8_t *)expected, body, string_util_strlen(expected), "Body content is wrong.");
+}
@@ -0,0 +1,108 @@
+/*!**********************************************************************
+*
+* @copyright Copyright (C) 2016 Siemens Aktiengesellschaft.\n
+*            All rights reserved.
+*
+*************************************************************************
+*
+* @file     test_intern_table.c
+* @date     Oct 17, 2026
+* @brief    Unit test cases for intern_table module.
+*
+************************************************************************/
+
+#include "mcl/mcl_common.h"
+#include "intern_table.h"
+#include "string_util.h"
+#include "definitions.h"
+#include "memory.h"
+#include "unity.h"
+#include "string_type.h"
+
+intern_table_t *intern_table = MCL_NULL;
+
+void setUp(void)
+{
+    intern_table_initialize(&intern_table);
+}
+
+void tearDown(void)
+{
+    intern_table_destroy(&intern_table);
+}
+
+/**
+ * GIVEN : Empty intern table.
+ * WHEN  : Two different strings are added, one of them twice.
+ * THEN  : Each different string gets its own id and adding the same string again returns the same id.
+ */
+void test_add_001(void)
+{
+    mcl_size_t id_1;
+    mcl_size_t id_2;
+    mcl_size_t id_3;
+
+    TEST_ASSERT_NOT_NULL_RETURN(intern_table);
+
+    TEST_ASSERT_EQUAL(MCL_OK, intern_table_add(intern_table, "e50ab7ca-fd5d-11e5-8000-001b1bc14a1d", &id_1));
+    TEST_ASSERT_EQUAL(MCL_OK, intern_table_add(intern_table, "e50ab7ca-fd5d-11e5-8000-001b1bc14a1e", &id_2));
+    TEST_ASSERT_EQUAL(MCL_OK, intern_table_add(intern_table, "e50ab7ca-fd5d-11e5-8000-001b1bc14a1d", &id_3));
+
+    TEST_ASSERT_NOT_EQUAL_MESSAGE(id_1, id_2, "Different strings have the same id.");
+    TEST_ASSERT_EQUAL_MESSAGE(id_1, id_3, "Same string has different ids.");
+    TEST_ASSERT_EQUAL_MESSAGE(2, intern_table->count, "Interned string count is wrong.");
+    TEST_ASSERT_EQUAL_STRING("e50ab7ca-fd5d-11e5-8000-001b1bc14a1d", intern_table_get(intern_table, id_1)->buffer);
+    TEST_ASSERT_EQUAL_STRING("e50ab7ca-fd5d-11e5-8000-001b1bc14a1e", intern_table_get(intern_table, id_2)->buffer);
+}
+
+/**
+ * GIVEN : Empty intern table.
+ * WHEN  : More strings than the initial bucket count are added.
+ * THEN  : Table grows, all strings keep their ids and interned strings are not moved.
+ */
+void test_add_002(void)
+{
+    char string[16];
+    mcl_size_t index;
+    mcl_size_t id;
+    const char *first_string_buffer;
+
+    TEST_ASSERT_NOT_NULL_RETURN(intern_table);
+
+    for (index = 0; index < 4 * DEFAULT_INTERN_TABLE_BUCKET_COUNT; index++)
+    {
+        string_util_snprintf(string, sizeof(string), "id_%u", (unsigned int)index);
+        TEST_ASSERT_EQUAL(MCL_OK, intern_table_add(intern_table, string, &id));
+        TEST_ASSERT_EQUAL_MESSAGE(index, id, "Id of a new string is wrong.");
+
+        if (0 == index)
+        {
+            first_string_buffer = intern_table_get(intern_table, id)->buffer;
+        }
+    }
+
+    for (index = 0; index < 4 * DEFAULT_INTERN_TABLE_BUCKET_COUNT; index++)
+    {
+        string_util_snprintf(string, sizeof(string), "id_%u", (unsigned int)index);
+        TEST_ASSERT_EQUAL(MCL_OK, intern_table_add(intern_table, string, &id));
+        TEST_ASSERT_EQUAL_MESSAGE(index, id, "Id of an interned string changed.");
+    }
+
+    TEST_ASSERT_EQUAL_MESSAGE(4 * DEFAULT_INTERN_TABLE_BUCKET_COUNT, intern_table->count, "Interned string count is wrong.");
+    TEST_ASSERT_EQUAL_PTR_MESSAGE(first_string_buffer, intern_table_get(intern_table, 0)->buffer, "Interned string is moved.");
+}
+
+/**
+ * GIVEN : Intern table with one string.
+ * WHEN  : A string with an unknown id is requested.
+ * THEN  : NULL is returned.
+ */
+void test_get_001(void)
+{
+    mcl_size_t id;
+
+    TEST_ASSERT_NOT_NULL_RETURN(intern_table);
+
+    intern_table_add(intern_table, "id", &id);
+    TEST_ASSERT_NULL(intern_table_get(intern_table, id + 1));
+}
@@ -35,6 +35,8 @@
 #include "time_util.h"
 #include "mcl/mcl_event.h"
 #include "mcl_data_source_configuration.h"
+#include "intern_table.h"
+#include <locale.h>
 
 char *timestamp = "2016-04-26T08:06:25.317Z";
 char *timestamp_2 = "2016-04-26T08:06:25.317Z";
@@ -48,6 +50,7 @@ char *configuration_id = "e3217e2b-7036-49f2-9814-4c38542cd781";
 char *payload_version = "1.0";
 char *routing = "vnd.kuka.FingerprintAnalizer";
 string_t *json_string = MCL_NULL;
+intern_table_t *intern_table = MCL_NULL;
 mcl_size_t duration = 42;
 char *description = "Test Rack in ERL M with MindConnectNano";
 
@@ -81,11 +84,13 @@ char *example_json_string =
 
 void setUp(void)
 {
+    intern_table_initialize(&intern_table);
 }
 
 void tearDown(void)
 {
     string_destroy(&json_string);
+    intern_table_destroy(&intern_table);
 }
 
 /**
@@ -96,7 +101,7 @@ void tearDown(void)
 void test_json_from_item_meta_001(void)
 {
     time_series_t *time_series;
-    time_series_initialize(payload_version, configuration_id, MCL_NULL, &time_series);
+    time_series_initialize(payload_version, configuration_id, MCL_NULL, intern_table, &time_series);
     TEST_ASSERT_NOT_NULL_RETURN(time_series);
 
     MCL_DEBUG("Call json_from_item_meta function");
@@ -365,7 +370,7 @@ void test_json_from_item_meta_006(void)
 void test_json_from_time_series_payload_001(void)
 {
     time_series_t *time_series;
-    time_series_initialize(payload_version, configuration_id, routing, &time_series);
+    time_series_initialize(payload_version, configuration_id, routing, intern_table, &time_series);
 
     mcl_time_series_value_set_t *value_set_1;
     mcl_time_series_new_value_set(time_series, timestamp, &value_set_1);
@@ -387,6 +392,116 @@ void test_json_from_time_series_payload_001(void)
     time_series_destroy(&time_series);
 }
 
+/**
+ * GIVEN : Initialized time_series whose value contains characters to be escaped.
+ * WHEN  : json_write_time_series_payload is called first to calculate the length and then with a buffer of that size.
+ * THEN  : It writes the escaped json string for the payload part of time series without a terminating null character.
+ */
+void test_json_write_time_series_payload_001(void)
+{
+    time_series_t *time_series;
+    time_series_initialize(payload_version, configuration_id, routing, intern_table, &time_series);
+
+    mcl_time_series_value_set_t *value_set;
+    mcl_time_series_new_value_set(time_series, timestamp, &value_set);
+    mcl_time_series_add_value(value_set, data_point_id, "\"quoted\"\n\\\x01", quality_code);
+
+    char *expected_json_string =
+        "[{\"timestamp\":\"2016-04-26T08:06:25.317Z\",\"values\":[{\"dataPointId\":\"e50ab7ca-fd5d-11e5-8000-001b1bc14a1d\",\"value\":\"\\\"quoted\\\"\\n\\\\\\u0001\",\"qualityCode\":\"00000000\"}]}]";
+    mcl_size_t expected_length = string_util_strlen(expected_json_string);
+
+    mcl_size_t length = json_write_time_series_payload(&time_series->payload, MCL_NULL, 0);
+    TEST_ASSERT_EQUAL_MESSAGE(expected_length, length, "Calculated length is wrong.");
+
+    char *buffer = MCL_MALLOC(length + 1);
+    buffer[length] = 'X';
+
+    length = json_write_time_series_payload(&time_series->payload, buffer, length);
+    TEST_ASSERT_EQUAL_MESSAGE(expected_length, length, "Written length is wrong.");
+    TEST_ASSERT_EQUAL_MEMORY_MESSAGE(expected_json_string, buffer, expected_length, "json string fail.");
+    TEST_ASSERT_EQUAL_MESSAGE('X', buffer[length], "Buffer is overrun.");
+
+    // Buffer smaller than the json string is not overrun :
+    buffer[10] = 'X';
+    length = json_write_time_series_payload(&time_series->payload, buffer, 10);
+    TEST_ASSERT_EQUAL_MESSAGE(expected_length, length, "Length is wrong for small buffer.");
+    TEST_ASSERT_EQUAL_MESSAGE('X', buffer[10], "Small buffer is overrun.");
+
+    MCL_FREE(buffer);
+    time_series_destroy(&time_series);
+}
+
+/**
+ * GIVEN : Time series with double, int64 and bool values.
+ * WHEN  : json_write_time_series_payload is called.
+ * THEN  : Values are formatted as strings in the json, doubles with the shortest representation which reads back as the same number.
+ */
+void test_json_write_time_series_payload_002(void)
+{
+    time_series_t *time_series;
+    time_series_initialize(payload_version, configuration_id, routing, intern_table, &time_series);
+
+    mcl_time_series_value_set_t *value_set;
+    mcl_time_series_new_value_set(time_series, timestamp, &value_set);
+    mcl_time_series_add_double(value_set, "a", 12.5, quality_code);
+    mcl_time_series_add_double(value_set, "b", 0.1 + 0.2, quality_code);
+    mcl_time_series_add_int64(value_set, "c", -9000000000LL, quality_code);
+    mcl_time_series_add_bool(value_set, "d", MCL_FALSE, quality_code);
+
+    char *expected_json_string = "[{\"timestamp\":\"2016-04-26T08:06:25.317Z\",\"values\":["
+        "{\"dataPointId\":\"a\",\"value\":\"12.5\",\"qualityCode\":\"00000000\"},"
+        "{\"dataPointId\":\"b\",\"value\":\"0.30000000000000004\",\"qualityCode\":\"00000000\"},"
+        "{\"dataPointId\":\"c\",\"value\":\"-9000000000\",\"qualityCode\":\"00000000\"},"
+        "{\"dataPointId\":\"d\",\"value\":\"false\",\"qualityCode\":\"00000000\"}]}]";
+    mcl_size_t expected_length = string_util_strlen(expected_json_string);
+
+    mcl_size_t length = json_write_time_series_payload(&time_series->payload, MCL_NULL, 0);
+    TEST_ASSERT_EQUAL_MESSAGE(expected_length, length, "Calculated length is wrong.");
+
+    char *buffer = MCL_MALLOC(length);
+    length = json_write_time_series_payload(&time_series->payload, buffer, length);
+    TEST_ASSERT_EQUAL_MESSAGE(expected_length, length, "Written length is wrong.");
+    TEST_ASSERT_EQUAL_MEMORY_MESSAGE(expected_json_string, buffer, expected_length, "json string fail.");
+
+    MCL_FREE(buffer);
+    time_series_destroy(&time_series);
+}
+
+/**
+ * GIVEN : Time series with a double value and a locale whose decimal point is a comma.
+ * WHEN  : json_write_time_series_payload is called.
+ * THEN  : The double is written with '.' as decimal point.
+ */
+void test_json_write_time_series_payload_003(void)
+{
+    if ((MCL_NULL == setlocale(LC_NUMERIC, "de_DE.UTF-8")) && (MCL_NULL == setlocale(LC_NUMERIC, "de_DE")) && (MCL_NULL == setlocale(LC_NUMERIC, "German")))
+    {
+        TEST_IGNORE_MESSAGE("No locale with comma as decimal point is installed.");
+    }
+
+    time_series_t *time_series;
+    time_series_initialize(payload_version, configuration_id, routing, intern_table, &time_series);
+
+    mcl_time_series_value_set_t *value_set;
+    mcl_time_series_new_value_set(time_series, timestamp, &value_set);
+    mcl_time_series_add_double(value_set, "a", 12.5, quality_code);
+
+    char *expected_json_string = "[{\"timestamp\":\"2016-04-26T08:06:25.317Z\",\"values\":["
+        "{\"dataPointId\":\"a\",\"value\":\"12.5\",\"qualityCode\":\"00000000\"}]}]";
+    mcl_size_t expected_length = string_util_strlen(expected_json_string);
+
+    mcl_size_t length = json_write_time_series_payload(&time_series->payload, MCL_NULL, 0);
+    char *buffer = MCL_MALLOC(length);
+    length = json_write_time_series_payload(&time_series->payload, buffer, length);
+    setlocale(LC_NUMERIC, "C");
+
+    TEST_ASSERT_EQUAL_MESSAGE(expected_length, length, "Written length is wrong.");
+    TEST_ASSERT_EQUAL_MEMORY_MESSAGE(expected_json_string, buffer, expected_length, "json string fail.");
+
+    MCL_FREE(buffer);
+    time_series_destroy(&time_series);
+}
+
 /**
  * GIVEN : Initialized payload of data source configuration without optional fields.
  * WHEN  : json_from_data_source_configuration_payload is called.
@@ -21,6 +21,14 @@
 #include "unity.h"
 #include "string_util.h"
 
+// Data of list nodes in the tests.
+typedef struct test_list_value_t
+{
+    string_t *data_point_id;
+    string_t *value;
+    string_t *quality_code;
+} test_list_value_t;
+
 mcl_list_t *list;
 
 void setUp(void)
@@ -78,7 +86,7 @@ void test_add_001(void)
 {
     TEST_ASSERT_NOT_NULL_MESSAGE(list, "mcl_list_t couldn't be initialized!");
 
-    time_series_value_t value;
+    test_list_value_t value;
 
     string_initialize_static("1", 0, &value.data_point_id);
     string_initialize_static("2", 0, &value.quality_code);
@@ -96,7 +104,7 @@ void test_add_001(void)
     TEST_ASSERT_NOT_NULL_MESSAGE(next_node, "next node received as NULL!");
     TEST_ASSERT_NOT_NULL_MESSAGE(next_node->data, "data in received next node is NULL!");
 
-    time_series_value_t *value_from_list = (time_series_value_t *)next_node->data;
+    test_list_value_t *value_from_list = (test_list_value_t *)next_node->data;
 
     TEST_ASSERT_EQUAL_STRING_MESSAGE("1", value_from_list->data_point_id->buffer, "Received data_point_id is not as expected!");
     TEST_ASSERT_EQUAL_STRING_MESSAGE("2", value_from_list->quality_code->buffer, "Received quality_code is not as expected!");
@@ -116,7 +124,7 @@ void test_add_002(void)
 {
     TEST_ASSERT_NOT_NULL_MESSAGE(list, "mcl_list_t couldn't be initialized!");
 
-    time_series_value_t value;
+    test_list_value_t value;
 
     string_initialize_static("1", 0, &value.data_point_id);
     string_initialize_static("2", 0, &value.quality_code);
@@ -147,7 +155,7 @@ void test_remove_001(void)
 {
     TEST_ASSERT_NOT_NULL_MESSAGE(list, "mcl_list_t couldn't be initialized!");
 
-    time_series_value_t value;
+    test_list_value_t value;
 
     string_initialize_static("1", 0, &value.data_point_id);
     string_initialize_static("2", 0, &value.quality_code);
@@ -183,7 +191,7 @@ void test_remove_002(void)
 {
     TEST_ASSERT_NOT_NULL_MESSAGE(list, "mcl_list_t couldn't be initialized!");
 
-    time_series_value_t value;
+    test_list_value_t value;
 
     string_initialize_static("1", 0, &value.data_point_id);
     string_initialize_static("2", 0, &value.quality_code);
@@ -223,7 +231,7 @@ void test_remove_003(void)
 {
     TEST_ASSERT_NOT_NULL_MESSAGE(list, "mcl_list_t couldn't be initialized!");
 
-    time_series_value_t value;
+    test_list_value_t value;
 
     string_initialize_static("1", 0, &value.data_point_id);
     string_initialize_static("2", 0, &value.quality_code);
@@ -305,7 +313,7 @@ void test_reset_001(void)
 {
     TEST_ASSERT_NOT_NULL_MESSAGE(list, "mcl_list_t couldn't be initialized!");
 
-    time_series_value_t value;
+    test_list_value_t value;
 
     string_initialize_static("1", 0, &value.data_point_id);
     string_initialize_static("2", 0, &value.quality_code);
@@ -339,7 +347,7 @@ void test_reset_001(void)
  */
 void test_exist_001(void)
 {
-    time_series_value_t value;
+    test_list_value_t value;
 
     string_initialize_static("1", 0, &value.data_point_id);
     string_initialize_static("2", 0, &value.quality_code);
@@ -367,7 +375,7 @@ void test_exist_001(void)
  */
 void test_exist_002(void)
 {
-    time_series_value_t value;
+    test_list_value_t value;
 
     string_initialize_static("1", 0, &value.data_point_id);
     string_initialize_static("2", 0, &value.quality_code);
@@ -396,7 +404,7 @@ void test_destroy_001(void)
 {
     TEST_ASSERT_NOT_NULL_MESSAGE(list, "mcl_list_t couldn't be initialized!");
 
-    time_series_value_t value;
+    test_list_value_t value;
 
     string_initialize_static("1", 0, &value.data_point_id);
     string_initialize_static("2", 0, &value.quality_code);
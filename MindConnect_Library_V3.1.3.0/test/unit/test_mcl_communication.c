@@ -28,6 +28,92 @@
 mcl_communication_t *communication = MCL_NULL;
 mcl_configuration_t *configuration = MCL_NULL;
 
+// Exchange operation started by mcl_communication_exchange_async and the results of the user callback.
+http_processor_exchange_callback pending_exchange_callback = MCL_NULL;
+void *pending_exchange_user_context = MCL_NULL;
+mcl_size_t exchange_async_count = 0;
+mcl_size_t exchange_callback_count = 0;
+E_MCL_ERROR_CODE exchange_callback_code = MCL_FAIL;
+void *exchange_callback_user_context = MCL_NULL;
+E_MCL_ERROR_CODE reentrant_exchange_code = MCL_OK;
+
+// Keeps the callback of the exchange operation started in http processor to complete it later.
+static E_MCL_ERROR_CODE _http_processor_exchange_async_stub(http_processor_t *http_processor, store_t *store, http_processor_exchange_callback callback, void *user_context,
+    int cmock_num_calls)
+{
+    ++exchange_async_count;
+    pending_exchange_callback = callback;
+    pending_exchange_user_context = user_context;
+
+    return MCL_OK;
+}
+
+// Completes the pending exchange operation with failure like http processor does when it is destroyed.
+static void _http_processor_destroy_stub(http_processor_t **http_processor, int cmock_num_calls)
+{
+    if (MCL_NULL != pending_exchange_callback)
+    {
+        pending_exchange_callback(MCL_FAIL, MCL_NULL, pending_exchange_user_context);
+    }
+}
+
+static void _exchange_callback(E_MCL_ERROR_CODE code, mcl_store_t *store, void *user_context)
+{
+    ++exchange_callback_count;
+    exchange_callback_code = code;
+    exchange_callback_user_context = user_context;
+}
+
+// Tries to use and destroy the communication again from the callback.
+static void _reentrant_exchange_callback(E_MCL_ERROR_CODE code, mcl_store_t *store, void *user_context)
+{
+    mcl_store_t dummy_store;
+    dummy_store.streamable = MCL_FALSE;
+
+    _exchange_callback(code, store, user_context);
+    reentrant_exchange_code = mcl_communication_exchange_async(communication, &dummy_store, _exchange_callback, MCL_NULL);
+    mcl_communication_destroy(&communication);
+}
+
+// Initializes communication with an http processor which has an access token.
+static http_processor_t *_initialize_for_exchange_async(void)
+{
+    http_processor_t *http_processor = MCL_NULL;
+
+    configuration->mindsphere_hostname = "mindsphere";
+    configuration->mindsphere_port = 10;
+    configuration->user_agent = "custom agent v1.0";
+    configuration->initial_access_token = "InitialAccessToken";
+    configuration->tenant = "br-smk1";
+
+    MCL_NEW(http_processor);
+    MCL_NEW(http_processor->security_handler);
+    MCL_NEW(http_processor->security_handler->registration_access_token);
+    MCL_NEW(http_processor->security_handler->access_token);
+    http_processor_initialize_ExpectAnyArgsAndReturn(MCL_OK);
+    http_processor_initialize_ReturnThruPtr_http_processor(&http_processor);
+
+    mcl_communication_initialize(configuration, &communication);
+
+    pending_exchange_callback = MCL_NULL;
+    pending_exchange_user_context = MCL_NULL;
+    exchange_async_count = 0;
+    exchange_callback_count = 0;
+    exchange_callback_code = MCL_FAIL;
+    exchange_callback_user_context = MCL_NULL;
+    reentrant_exchange_code = MCL_OK;
+
+    return http_processor;
+}
+
+static void _clean_up_for_exchange_async(http_processor_t *http_processor)
+{
+    MCL_FREE(http_processor->security_handler->access_token);
+    MCL_FREE(http_processor->security_handler->registration_access_token);
+    MCL_FREE(http_processor->security_handler);
+    MCL_FREE(http_processor);
+}
+
 void setUp(void)
 {
     mcl_configuration_initialize(&configuration);
@@ -396,6 +482,48 @@ void test_get_last_token_time_001()
 	MCL_FREE(token_time);
 }
 
+/**
+* GIVEN : Communication is initialized and some requests are sent.
+* WHEN  : #mcl_communication_get_connection_statistics() is called.
+* THEN  : MCL_OK is returned with the statistics of the http client.
+*/
+void test_get_connection_statistics_001()
+{
+	communication_t communication;
+	http_processor_t processor;
+	mcl_size_t connections_opened = 0;
+	mcl_size_t connections_reused = 0;
+	mcl_size_t expected_opened = 1;
+	mcl_size_t expected_reused = 4;
+
+	communication.http_processor = &processor;
+
+	http_processor_get_connection_statistics_ExpectAnyArgs();
+	http_processor_get_connection_statistics_ReturnThruPtr_connections_opened(&expected_opened);
+	http_processor_get_connection_statistics_ReturnThruPtr_connections_reused(&expected_reused);
+
+	E_MCL_ERROR_CODE code = mcl_communication_get_connection_statistics(&communication, &connections_opened, &connections_reused);
+
+	TEST_ASSERT_EQUAL(MCL_OK, code);
+	TEST_ASSERT_EQUAL(expected_opened, connections_opened);
+	TEST_ASSERT_EQUAL(expected_reused, connections_reused);
+}
+
+/**
+* GIVEN : Communication is initialized.
+* WHEN  : #mcl_communication_get_connection_statistics() is called with NULL output parameter.
+* THEN  : MCL_TRIGGERED_WITH_NULL is returned.
+*/
+void test_get_connection_statistics_002()
+{
+	communication_t communication;
+	mcl_size_t connections_opened = 0;
+
+	E_MCL_ERROR_CODE code = mcl_communication_get_connection_statistics(&communication, &connections_opened, MCL_NULL);
+
+	TEST_ASSERT_EQUAL(MCL_TRIGGERED_WITH_NULL, code);
+}
+
 /**
 * GIVEN : Communication is initialized and onboarded.
 * WHEN  : #mcl_communication_rotate_key() is called.
@@ -460,6 +588,58 @@ void test_rotate_key_001()
     MCL_FREE(http_processor);
 }
 
+/**
+* GIVEN : Communication is initialized with RSA security profile.
+* WHEN  : #mcl_communication_generate_next_key() is called.
+* THEN  : Key pair is generated by http processor and MCL_OK is returned.
+*/
+void test_generate_next_key_001()
+{
+    configuration->mindsphere_hostname = "mindsphere";
+    configuration->mindsphere_port = 10;
+    configuration->mindsphere_certificate = "3iu2ned298ijdm";
+    configuration->security_profile = MCL_SECURITY_RSA_3072;
+    configuration->user_agent = "custom agent v1.0";
+    configuration->initial_access_token = "InitialAccessToken";
+    configuration->tenant = "br-smk1";
+
+    http_processor_t *http_processor;
+    MCL_NEW(http_processor);
+    http_processor_initialize_ExpectAnyArgsAndReturn(MCL_OK);
+    http_processor_initialize_ReturnThruPtr_http_processor(&http_processor);
+
+    mcl_communication_initialize(configuration, &communication);
+
+    http_processor_generate_next_rsa_key_ExpectAndReturn(http_processor, MCL_OK);
+
+    E_MCL_ERROR_CODE result = mcl_communication_generate_next_key(communication);
+    TEST_ASSERT_EQUAL(MCL_OK, result);
+
+    MCL_FREE(http_processor);
+}
+
+/**
+* GIVEN : Communication is initialized with shared secret security profile.
+* WHEN  : #mcl_communication_generate_next_key() is called.
+* THEN  : MCL_OPERATION_IS_NOT_SUPPORTED is returned.
+*/
+void test_generate_next_key_002()
+{
+    configuration->mindsphere_hostname = "mindsphere";
+    configuration->mindsphere_port = 10;
+    configuration->mindsphere_certificate = "3iu2ned298ijdm";
+    configuration->security_profile = MCL_SECURITY_SHARED_SECRET;
+    configuration->user_agent = "custom agent v1.0";
+    configuration->initial_access_token = "InitialAccessToken";
+    configuration->tenant = "br-smk1";
+    http_processor_initialize_IgnoreAndReturn(MCL_OK);
+
+    mcl_communication_initialize(configuration, &communication);
+
+    E_MCL_ERROR_CODE result = mcl_communication_generate_next_key(communication);
+    TEST_ASSERT_EQUAL(MCL_OPERATION_IS_NOT_SUPPORTED, result);
+}
+
 /**
 * GIVEN : Communication is initialized and onboarded.
 * WHEN  : #mcl_communication_exchange() is called.
@@ -517,6 +697,185 @@ void test_exchange_001()
     MCL_FREE(http_processor);
 }
 
+/**
+* GIVEN : Communication is initialized and onboarded.
+* WHEN  : #mcl_communication_exchange_async() is called with a non-streamable store.
+* THEN  : MCL_OK is returned and the exchange is started by http processor.
+*/
+void test_exchange_async_001()
+{
+    configuration->mindsphere_hostname = "mindsphere";
+    configuration->mindsphere_port = 10;
+    configuration->user_agent = "custom agent v1.0";
+    configuration->initial_access_token = "InitialAccessToken";
+    configuration->tenant = "br-smk1";
+
+    // Mock http_processor_initialize with http_processor->security_handler->registration_access_token not null.
+    http_processor_t *http_processor = MCL_NULL;
+    MCL_NEW(http_processor);
+    MCL_NEW(http_processor->security_handler);
+    MCL_NEW(http_processor->security_handler->registration_access_token);
+    MCL_NEW(http_processor->security_handler->access_token);
+    http_processor_initialize_ExpectAnyArgsAndReturn(MCL_OK);
+    http_processor_initialize_ReturnThruPtr_http_processor(&http_processor);
+
+    // Initialize mcl_communication.
+    mcl_communication_initialize(configuration, &communication);
+
+    mcl_store_t dummy_store;
+    dummy_store.streamable = MCL_FALSE;
+
+    // Mock http_processor_exchange_async.
+    http_processor_exchange_async_ExpectAnyArgsAndReturn(MCL_OK);
+
+    E_MCL_ERROR_CODE result = mcl_communication_exchange_async(communication, &dummy_store, (mcl_communication_exchange_callback_t)test_exchange_async_001, MCL_NULL);
+    TEST_ASSERT_EQUAL(MCL_OK, result);
+
+    // Streamable store is not supported.
+    dummy_store.streamable = MCL_TRUE;
+    result = mcl_communication_exchange_async(communication, &dummy_store, (mcl_communication_exchange_callback_t)test_exchange_async_001, MCL_NULL);
+    TEST_ASSERT_EQUAL(MCL_OPERATION_IS_NOT_SUPPORTED, result);
+
+    // Mock http_processor_perform.
+    http_processor_perform_ExpectAnyArgsAndReturn(MCL_OK);
+
+    result = mcl_communication_poll(communication, 0, MCL_NULL);
+    TEST_ASSERT_EQUAL(MCL_OK, result);
+
+    // Clean up.
+    MCL_FREE(http_processor->security_handler->access_token);
+    MCL_FREE(http_processor->security_handler->registration_access_token);
+    MCL_FREE(http_processor->security_handler);
+    MCL_FREE(http_processor);
+}
+
+/**
+* GIVEN : Uninitialized communication.
+* WHEN  : #mcl_communication_exchange_async() is called with NULL callback.
+* THEN  : MCL_TRIGGERED_WITH_NULL is returned.
+*/
+void test_exchange_async_002()
+{
+    mcl_store_t dummy_store;
+    communication_t dummy_communication;
+
+    E_MCL_ERROR_CODE result = mcl_communication_exchange_async(&dummy_communication, &dummy_store, MCL_NULL, MCL_NULL);
+    TEST_ASSERT_EQUAL(MCL_TRIGGERED_WITH_NULL, result);
+}
+
+/**
+* GIVEN : Communication is initialized and an exchange operation is started by #mcl_communication_exchange_async().
+* WHEN  : Http processor completes the exchange with MCL_UNAUTHORIZED.
+* THEN  : Access token is renewed, the exchange is started again and the callback is called once with the result of the second exchange.
+*/
+void test_exchange_async_003()
+{
+    http_processor_t *http_processor = _initialize_for_exchange_async();
+    mcl_store_t dummy_store;
+    dummy_store.streamable = MCL_FALSE;
+
+    http_processor_exchange_async_StubWithCallback(_http_processor_exchange_async_stub);
+
+    E_MCL_ERROR_CODE result = mcl_communication_exchange_async(communication, &dummy_store, _exchange_callback, &dummy_store);
+    TEST_ASSERT_EQUAL(MCL_OK, result);
+
+    // Access token is rejected, it is renewed and the exchange is started again :
+    http_processor_get_access_token_ExpectAndReturn(http_processor, MCL_OK);
+    pending_exchange_callback(MCL_UNAUTHORIZED, &dummy_store, pending_exchange_user_context);
+    TEST_ASSERT_EQUAL_MESSAGE(2, exchange_async_count, "Exchange is not started again after access token is renewed.");
+    TEST_ASSERT_EQUAL_MESSAGE(0, exchange_callback_count, "Callback is called before the exchange is completed.");
+
+    pending_exchange_callback(MCL_OK, &dummy_store, pending_exchange_user_context);
+    TEST_ASSERT_EQUAL_MESSAGE(1, exchange_callback_count, "Callback is not called once.");
+    TEST_ASSERT_EQUAL(MCL_OK, exchange_callback_code);
+    TEST_ASSERT_EQUAL_PTR_MESSAGE(&dummy_store, exchange_callback_user_context, "User context is not passed to callback.");
+
+    _clean_up_for_exchange_async(http_processor);
+}
+
+/**
+* GIVEN : Communication is initialized and an exchange operation is started by #mcl_communication_exchange_async().
+* WHEN  : Http processor completes the exchange with MCL_UNAUTHORIZED again after the access token is renewed.
+* THEN  : Access token is renewed only once and the callback is called with MCL_UNAUTHORIZED.
+*/
+void test_exchange_async_004()
+{
+    http_processor_t *http_processor = _initialize_for_exchange_async();
+    mcl_store_t dummy_store;
+    dummy_store.streamable = MCL_FALSE;
+
+    http_processor_exchange_async_StubWithCallback(_http_processor_exchange_async_stub);
+
+    E_MCL_ERROR_CODE result = mcl_communication_exchange_async(communication, &dummy_store, _exchange_callback, MCL_NULL);
+    TEST_ASSERT_EQUAL(MCL_OK, result);
+
+    http_processor_get_access_token_ExpectAndReturn(http_processor, MCL_OK);
+    pending_exchange_callback(MCL_UNAUTHORIZED, &dummy_store, pending_exchange_user_context);
+    pending_exchange_callback(MCL_UNAUTHORIZED, &dummy_store, pending_exchange_user_context);
+
+    TEST_ASSERT_EQUAL_MESSAGE(2, exchange_async_count, "Exchange is started more than once again.");
+    TEST_ASSERT_EQUAL_MESSAGE(1, exchange_callback_count, "Callback is not called once.");
+    TEST_ASSERT_EQUAL(MCL_UNAUTHORIZED, exchange_callback_code);
+
+    _clean_up_for_exchange_async(http_processor);
+}
+
+/**
+* GIVEN : Communication is initialized and an exchange operation is started by #mcl_communication_exchange_async().
+* WHEN  : Http processor completes the exchange with MCL_UNAUTHORIZED while other exchange operations are in flight.
+* THEN  : Access token can not be renewed and the callback is called with MCL_UNAUTHORIZED.
+*/
+void test_exchange_async_005()
+{
+    http_processor_t *http_processor = _initialize_for_exchange_async();
+    mcl_store_t dummy_store;
+    dummy_store.streamable = MCL_FALSE;
+
+    http_processor_exchange_async_StubWithCallback(_http_processor_exchange_async_stub);
+
+    E_MCL_ERROR_CODE result = mcl_communication_exchange_async(communication, &dummy_store, _exchange_callback, MCL_NULL);
+    TEST_ASSERT_EQUAL(MCL_OK, result);
+
+    http_processor_get_access_token_ExpectAndReturn(http_processor, MCL_EXCHANGE_ASYNC_IS_ACTIVE);
+    pending_exchange_callback(MCL_UNAUTHORIZED, &dummy_store, pending_exchange_user_context);
+
+    TEST_ASSERT_EQUAL_MESSAGE(1, exchange_async_count, "Exchange is started again without a new access token.");
+    TEST_ASSERT_EQUAL_MESSAGE(1, exchange_callback_count, "Callback is not called once.");
+    TEST_ASSERT_EQUAL(MCL_UNAUTHORIZED, exchange_callback_code);
+
+    _clean_up_for_exchange_async(http_processor);
+}
+
+/**
+* GIVEN : Communication is initialized and an exchange operation is started by #mcl_communication_exchange_async().
+* WHEN  : Communication is destroyed and the callback starts a new exchange and destroys the communication again.
+* THEN  : Callback is called once with MCL_FAIL, the new exchange is refused and the communication is destroyed once.
+*/
+void test_exchange_async_006()
+{
+    http_processor_t *http_processor = _initialize_for_exchange_async();
+    mcl_store_t dummy_store;
+    dummy_store.streamable = MCL_FALSE;
+
+    http_processor_exchange_async_StubWithCallback(_http_processor_exchange_async_stub);
+
+    E_MCL_ERROR_CODE result = mcl_communication_exchange_async(communication, &dummy_store, _reentrant_exchange_callback, MCL_NULL);
+    TEST_ASSERT_EQUAL(MCL_OK, result);
+
+    // Http processor calls the callback of the pending exchange while it is destroyed :
+    http_processor_destroy_StubWithCallback(_http_processor_destroy_stub);
+    result = mcl_communication_destroy(&communication);
+
+    TEST_ASSERT_EQUAL(MCL_OK, result);
+    TEST_ASSERT_NULL_MESSAGE(communication, "Communication is not destroyed.");
+    TEST_ASSERT_EQUAL_MESSAGE(1, exchange_callback_count, "Callback is not called once.");
+    TEST_ASSERT_EQUAL(MCL_FAIL, exchange_callback_code);
+    TEST_ASSERT_EQUAL_MESSAGE(MCL_NOT_INITIALIZED, reentrant_exchange_code, "Exchange is started while communication is being destroyed.");
+    TEST_ASSERT_EQUAL_MESSAGE(1, exchange_async_count, "Exchange is started while communication is being destroyed.");
+
+    _clean_up_for_exchange_async(http_processor);
+}
+
 /**
 * GIVEN : Communication is initialized and onboarded.
 * WHEN  : #mcl_communication_process() is called.
@@ -561,6 +920,9 @@ void test_process_001()
 	mcl_store_t dummy_store;
 	dummy_store.streamable = MCL_FALSE;
 
+	// Mock http_processor_is_access_token_expiring.
+	http_processor_is_access_token_expiring_IgnoreAndReturn(MCL_FALSE);
+
 	// Mock http_processor_exchange.
 	http_processor_exchange_IgnoreAndReturn(MCL_OK);
 
@@ -659,6 +1021,9 @@ void test_process_004()
 	// Mock http_processor_get_access_token.
 	http_processor_get_access_token_IgnoreAndReturn(MCL_OK);
 
+	// Mock http_processor_is_access_token_expiring.
+	http_processor_is_access_token_expiring_IgnoreAndReturn(MCL_FALSE);
+
 	// Mock http_processor_exchange.
 	http_processor_exchange_IgnoreAndReturn(MCL_UNAUTHORIZED);
 	http_processor_exchange_IgnoreAndReturn(MCL_OK);
@@ -722,6 +1087,9 @@ void test_process_005()
 	// Mock http_processor_register.
 	http_processor_register_IgnoreAndReturn(MCL_OK);
 
+	// Mock http_processor_is_access_token_expiring.
+	http_processor_is_access_token_expiring_IgnoreAndReturn(MCL_FALSE);
+
 	// Mock http_processor_exchange.
 	http_processor_exchange_IgnoreAndReturn(MCL_UNAUTHORIZED);
 	http_processor_exchange_IgnoreAndReturn(MCL_OK);
@@ -739,3 +1107,53 @@ void test_process_005()
 	MCL_FREE(http_processor->security_handler);
 	MCL_FREE(http_processor);
 }
+
+/**
+* GIVEN : Communication is initialized and access token expires within refresh margin.
+* WHEN  : #mcl_communication_process() is called.
+* THEN  : New access token is acquired before exchange, exchange is done once successfully.
+*/
+void test_process_006()
+{
+	E_MCL_ERROR_CODE result;
+
+	configuration->mindsphere_hostname = "mindsphere";
+	configuration->mindsphere_port = 10;
+	configuration->mindsphere_certificate = "3iu2ned298ijdm";
+	configuration->security_profile = MCL_SECURITY_SHARED_SECRET;
+	configuration->user_agent = "custom agent v1.0";
+	configuration->initial_access_token = "InitialAccessToken";
+	configuration->tenant = "br-smk1";
+
+	// Mock http_processor_initialize with http_processor->security_handler->registration_access_token not null.
+	http_processor_t *http_processor = MCL_NULL;
+	MCL_NEW(http_processor);
+	MCL_NEW(http_processor->security_handler);
+	MCL_NEW(http_processor->security_handler->registration_access_token);
+
+	char *dummy_token = "dummy_access_token";
+	string_initialize_new(dummy_token, 0, &(http_processor->security_handler->access_token));
+
+	http_processor_initialize_ExpectAnyArgsAndReturn(MCL_OK);
+	http_processor_initialize_ReturnThruPtr_http_processor(&http_processor);
+
+	// Initialize mcl_communication.
+	mcl_communication_initialize(configuration, &communication);
+
+	// Access token is renewed before the exchange, so exchange is called only once.
+	http_processor_is_access_token_expiring_ExpectAndReturn(http_processor, MCL_TRUE);
+	http_processor_get_access_token_ExpectAndReturn(http_processor, MCL_OK);
+	http_processor_exchange_ExpectAnyArgsAndReturn(MCL_OK);
+
+	mcl_store_t dummy_store;
+	dummy_store.streamable = MCL_FALSE;
+
+	result = mcl_communication_process(communication, &dummy_store, NULL);
+	TEST_ASSERT_MESSAGE(MCL_OK == result, "Exchange has failed.");
+
+	// Clean up.
+	string_destroy(&(http_processor->security_handler->access_token));
+	MCL_FREE(http_processor->security_handler->registration_access_token);
+	MCL_FREE(http_processor->security_handler);
+	MCL_FREE(http_processor);
+}
@@ -14,10 +14,16 @@
 #include "mcl/mcl_common.h"
 #include "time_series.h"
 #include "memory.h"
+#include "string_type.h"
+#include "string_util.h"
+#include "list.h"
 #include "definitions.h"
 #include "log_util.h"
 #include "unity.h"
 #include "data_types.h"
+#include <string.h>
+#include <stdlib.h>
+#include <pthread.h>
 
 void setUp(void)
 {
@@ -251,3 +257,493 @@ void test_new_with_zero_001(void)
 
     TEST_ASSERT_NULL_MESSAGE(demo, "Pointer is NOT NULL after freeing!");
 }
+
+/**
+ * GIVEN : An arena is initialized.
+ * WHEN  : Memory is allocated while the arena is the current arena and after it is not.
+ * THEN  : Memory is allocated from the arena only while it is current and is found in the arena.
+ */
+void test_arena_001(void)
+{
+    memory_arena_t *arena = MCL_NULL;
+    memory_arena_t *previous_arena;
+    char *arena_buffer;
+    char *zero_buffer;
+    char *heap_buffer;
+    E_MCL_ERROR_CODE code = memory_arena_initialize(0, MCL_MEMORY_CATEGORY_OTHER, &arena);
+
+    TEST_ASSERT_EQUAL_MESSAGE(MCL_OK, code, "memory_arena_initialize() failed.");
+    TEST_ASSERT_EQUAL_MESSAGE(DEFAULT_MEMORY_ARENA_BLOCK_SIZE, arena->block_size, "Default block size is not used.");
+
+    previous_arena = memory_arena_set_current(arena);
+    arena_buffer = MCL_MALLOC(10);
+    zero_buffer = MCL_CALLOC(4, 8);
+    TEST_ASSERT_EQUAL_PTR_MESSAGE(arena, memory_arena_set_current(previous_arena), "Arena is not the current arena.");
+    heap_buffer = MCL_MALLOC(10);
+
+    TEST_ASSERT_NULL_MESSAGE(previous_arena, "There must be no current arena initially.");
+    TEST_ASSERT_TRUE_MESSAGE(memory_arena_contains(arena, arena_buffer), "Buffer is not allocated from the arena.");
+    TEST_ASSERT_TRUE_MESSAGE(memory_arena_contains(arena, zero_buffer), "Zeroed buffer is not allocated from the arena.");
+    TEST_ASSERT_FALSE_MESSAGE(memory_arena_contains(arena, heap_buffer), "Buffer is allocated from the arena after it is not current.");
+    TEST_ASSERT_EQUAL_MESSAGE(0, ((mcl_size_t)arena_buffer) % 16, "Arena allocation is not aligned.");
+
+    for (int i = 0; i < 32; i++)
+    {
+        TEST_ASSERT_EQUAL_INT_MESSAGE(0, zero_buffer[i], "Buffer allocated from arena with MCL_CALLOC is not zero.");
+    }
+
+    // Memory of the arena is released while the arena is current, heap memory is still released to the heap meanwhile.
+    memory_arena_set_current(arena);
+    MCL_FREE(arena_buffer);
+    MCL_FREE(zero_buffer);
+    MCL_FREE(heap_buffer);
+    memory_arena_set_current(previous_arena);
+    memory_arena_destroy(&arena);
+    TEST_ASSERT_NULL_MESSAGE(arena, "Arena is not NULL after destroy.");
+}
+
+/**
+ * GIVEN : Memory is allocated from an arena.
+ * WHEN  : Memory is resized and released while the arena is the current arena.
+ * THEN  : Memory is resized in the same arena keeping its content, released last allocation is reused.
+ */
+void test_arena_002(void)
+{
+    memory_arena_t *arena = MCL_NULL;
+    char *first;
+    char *second;
+    char *third;
+    char *released_address;
+
+    memory_arena_initialize(256, MCL_MEMORY_CATEGORY_OTHER, &arena);
+    memory_arena_set_current(arena);
+    first = MCL_MALLOC(8);
+    second = MCL_MALLOC(8);
+
+    memcpy(first, "abcdefg", 8);
+    memcpy(second, "1234567", 8);
+
+    // Last allocation grows in place, others are moved.
+    TEST_ASSERT_EQUAL_PTR_MESSAGE(second, MCL_RESIZE(second, 40), "Last allocation is not resized in place.");
+    first = MCL_RESIZE(first, 40);
+    TEST_ASSERT_TRUE_MESSAGE(memory_arena_contains(arena, first), "Resized buffer is not in the arena.");
+    TEST_ASSERT_EQUAL_STRING_MESSAGE("abcdefg", first, "Content is lost after resize.");
+    TEST_ASSERT_EQUAL_STRING_MESSAGE("1234567", second, "Content is lost after resize in place.");
+
+    // Large allocation gets a block of its own.
+    third = memory_realloc(first, 1024);
+    TEST_ASSERT_TRUE_MESSAGE(memory_arena_contains(arena, third), "Large buffer is not in the arena.");
+    TEST_ASSERT_EQUAL_STRING_MESSAGE("abcdefg", third, "Content is lost after resize to a large buffer.");
+
+    // Released last allocation of the current block is reused.
+    MCL_FREE(third);
+    first = MCL_MALLOC(16);
+    released_address = first;
+    MCL_FREE(first);
+    third = MCL_MALLOC(16);
+    memory_arena_set_current(MCL_NULL);
+    TEST_ASSERT_EQUAL_PTR_MESSAGE(released_address, third, "Released last allocation is not reused.");
+
+    memory_arena_reset(arena);
+    TEST_ASSERT_NULL_MESSAGE(arena->blocks, "Blocks are not released after reset.");
+    TEST_ASSERT_FALSE_MESSAGE(memory_arena_contains(arena, second), "Memory is still found in the arena after reset.");
+
+    memory_arena_destroy(&arena);
+}
+
+static void *_arena_thread_allocate(void *context)
+{
+    char **buffer = (char **)context;
+
+    *buffer = MCL_MALLOC(10);
+
+    return MCL_NULL;
+}
+
+/**
+ * GIVEN : An arena is the current arena of a thread.
+ * WHEN  : Another thread allocates memory.
+ * THEN  : Memory of the other thread is allocated from the heap.
+ */
+void test_arena_003(void)
+{
+    memory_arena_t *arena = MCL_NULL;
+    char *buffer = MCL_NULL;
+    pthread_t thread;
+
+    memory_arena_initialize(256, MCL_MEMORY_CATEGORY_OTHER, &arena);
+    memory_arena_set_current(arena);
+
+    TEST_ASSERT_EQUAL_MESSAGE(0, pthread_create(&thread, MCL_NULL, _arena_thread_allocate, &buffer), "Thread could not be created.");
+    pthread_join(thread, MCL_NULL);
+
+    TEST_ASSERT_EQUAL_PTR_MESSAGE(arena, memory_arena_get_current(), "Arena is not the current arena of this thread.");
+    TEST_ASSERT_NOT_NULL_MESSAGE(buffer, "Buffer could not be allocated by the other thread.");
+    TEST_ASSERT_FALSE_MESSAGE(memory_arena_contains(arena, buffer), "Buffer of the other thread is allocated from the arena.");
+
+    // Heap memory is released while the arena is current.
+    MCL_FREE(buffer);
+    memory_arena_set_current(MCL_NULL);
+    memory_arena_destroy(&arena);
+}
+
+/**
+ * GIVEN : Small objects are allocated from the pools.
+ * WHEN  : Objects are released and allocated again.
+ * THEN  : Released object of the same size class is reused, larger objects and objects allocated while an arena is current are not pooled.
+ */
+void test_pool_001(void)
+{
+    memory_arena_t *arena = MCL_NULL;
+    char *small;
+    char *large;
+    char *in_arena;
+    char *released_address;
+
+    small = memory_pool_allocate(24, MCL_MEMORY_CATEGORY_OTHER, __FUNCTION__, __LINE__);
+    TEST_ASSERT_NOT_NULL_MESSAGE(small, "Object could not be allocated from the pool.");
+    TEST_ASSERT_EQUAL_INT_MESSAGE(0, (mcl_size_t)small % 8, "Pooled object is not aligned.");
+    released_address = small;
+    memory_pool_release(small, 24, __FUNCTION__, __LINE__);
+
+    // Object of the same size class reuses the released object.
+    small = memory_pool_allocate(20, MCL_MEMORY_CATEGORY_OTHER, __FUNCTION__, __LINE__);
+    TEST_ASSERT_EQUAL_PTR_MESSAGE(released_address, small, "Released object is not reused.");
+    memory_pool_release(small, 20, __FUNCTION__, __LINE__);
+
+    // Objects larger than the pooled size are allocated from the heap.
+    large = memory_pool_allocate(MEMORY_POOL_MAX_OBJECT_SIZE + 1, MCL_MEMORY_CATEGORY_OTHER, __FUNCTION__, __LINE__);
+    TEST_ASSERT_NOT_NULL_MESSAGE(large, "Large object could not be allocated.");
+    memory_pool_release(large, MEMORY_POOL_MAX_OBJECT_SIZE + 1, __FUNCTION__, __LINE__);
+
+    // Current arena takes precedence over the pools.
+    memory_arena_initialize(256, MCL_MEMORY_CATEGORY_OTHER, &arena);
+    memory_arena_set_current(arena);
+    in_arena = memory_pool_allocate(24, MCL_MEMORY_CATEGORY_OTHER, __FUNCTION__, __LINE__);
+    memory_arena_set_current(MCL_NULL);
+    TEST_ASSERT_TRUE_MESSAGE(memory_arena_contains(arena, in_arena), "Object is not allocated from the current arena.");
+
+    // Object keeps its arena, so it is released while the arena is not current.
+    memory_pool_release(in_arena, 24, __FUNCTION__, __LINE__);
+
+    small = memory_pool_allocate(24, MCL_MEMORY_CATEGORY_OTHER, __FUNCTION__, __LINE__);
+    TEST_ASSERT_EQUAL_PTR_MESSAGE(released_address, small, "Object released to the arena is put into the pool.");
+    memory_pool_release(small, 24, __FUNCTION__, __LINE__);
+
+    memory_arena_destroy(&arena);
+}
+
+#define POOL_THREAD_OBJECT_COUNT 1000
+
+static void *_pool_thread_objects[POOL_THREAD_OBJECT_COUNT];
+
+static void *_pool_thread_allocate(void *context)
+{
+    mcl_size_t index;
+
+    for (index = 0; index < POOL_THREAD_OBJECT_COUNT; ++index)
+    {
+        _pool_thread_objects[index] = memory_pool_allocate(24, MCL_MEMORY_CATEGORY_CURL, __FUNCTION__, __LINE__);
+    }
+
+    return MCL_NULL;
+}
+
+/**
+ * GIVEN : Objects are allocated from the pools by a thread which then exits.
+ * WHEN  : Objects are released by another thread.
+ * THEN  : Objects return to their slabs and empty slabs are returned to the heap.
+ */
+void test_pool_002(void)
+{
+    mcl_memory_usage_t initial_usage;
+    mcl_memory_usage_t usage;
+    mcl_size_t index;
+    pthread_t thread;
+
+    mcl_memory_get_usage(MCL_MEMORY_CATEGORY_CURL, &initial_usage);
+
+    TEST_ASSERT_EQUAL_MESSAGE(0, pthread_create(&thread, MCL_NULL, _pool_thread_allocate, MCL_NULL), "Thread could not be created.");
+    pthread_join(thread, MCL_NULL);
+
+    mcl_memory_get_usage(MCL_MEMORY_CATEGORY_CURL, &usage);
+    TEST_ASSERT_TRUE_MESSAGE(initial_usage.count + 1 < usage.count, "Objects are not allocated from more than one slab.");
+
+    for (index = 0; index < POOL_THREAD_OBJECT_COUNT; ++index)
+    {
+        TEST_ASSERT_NOT_NULL_MESSAGE(_pool_thread_objects[index], "Object could not be allocated from the pool.");
+        memory_pool_release(_pool_thread_objects[index], 24, __FUNCTION__, __LINE__);
+    }
+
+    // Only the last slab of the pool is kept.
+    mcl_memory_get_usage(MCL_MEMORY_CATEGORY_CURL, &usage);
+    TEST_ASSERT_TRUE_MESSAGE(initial_usage.count + 1 >= usage.count, "Empty slabs are not returned to the heap.");
+
+    // Released objects are reused by this thread.
+    _pool_thread_objects[0] = memory_pool_allocate(24, MCL_MEMORY_CATEGORY_CURL, __FUNCTION__, __LINE__);
+    mcl_memory_get_usage(MCL_MEMORY_CATEGORY_CURL, &usage);
+    TEST_ASSERT_TRUE_MESSAGE(initial_usage.count + 1 >= usage.count, "Released objects are not reused.");
+    memory_pool_release(_pool_thread_objects[0], 24, __FUNCTION__, __LINE__);
+}
+
+/**
+ * GIVEN : No initial condition.
+ * WHEN  : Memory is allocated, resized and released in a category.
+ * THEN  : Usage of the category follows the allocations, usage of other categories does not change.
+ */
+void test_usage_001(void)
+{
+    mcl_memory_usage_t initial_usage;
+    mcl_memory_usage_t initial_json_usage;
+    mcl_memory_usage_t usage;
+    char *buffer;
+
+    mcl_memory_get_usage(MCL_MEMORY_CATEGORY_STORE, &initial_usage);
+    mcl_memory_get_usage(MCL_MEMORY_CATEGORY_JSON, &initial_json_usage);
+
+    buffer = memory_allocate(100, MCL_MEMORY_CATEGORY_STORE, __FUNCTION__, __LINE__);
+    mcl_memory_get_usage(MCL_MEMORY_CATEGORY_STORE, &usage);
+    TEST_ASSERT_EQUAL_MESSAGE(initial_usage.bytes + 100, usage.bytes, "Allocated bytes are not accounted.");
+    TEST_ASSERT_EQUAL_MESSAGE(initial_usage.count + 1, usage.count, "Allocation is not counted.");
+
+    // Resized memory stays in its category.
+    buffer = memory_reallocate(buffer, 300, MCL_MEMORY_CATEGORY_JSON, __FUNCTION__, __LINE__);
+    mcl_memory_get_usage(MCL_MEMORY_CATEGORY_STORE, &usage);
+    TEST_ASSERT_EQUAL_MESSAGE(initial_usage.bytes + 300, usage.bytes, "Resized bytes are not accounted.");
+    TEST_ASSERT_EQUAL_MESSAGE(initial_usage.count + 1, usage.count, "Resize is counted as a new allocation.");
+    mcl_memory_get_usage(MCL_MEMORY_CATEGORY_JSON, &usage);
+    TEST_ASSERT_EQUAL_MESSAGE(initial_json_usage.bytes, usage.bytes, "Resized memory is accounted to another category.");
+
+    MCL_FREE(buffer);
+    mcl_memory_get_usage(MCL_MEMORY_CATEGORY_STORE, &usage);
+    TEST_ASSERT_EQUAL_MESSAGE(initial_usage.bytes, usage.bytes, "Released bytes are still accounted.");
+    TEST_ASSERT_EQUAL_MESSAGE(initial_usage.count, usage.count, "Released allocation is still counted.");
+
+    TEST_ASSERT_EQUAL_MESSAGE(MCL_TRIGGERED_WITH_NULL, mcl_memory_get_usage(MCL_MEMORY_CATEGORY_STORE, MCL_NULL), "NULL usage is accepted.");
+    TEST_ASSERT_EQUAL_MESSAGE(MCL_INVALID_PARAMETER, mcl_memory_get_usage(MCL_MEMORY_CATEGORY_END, &usage), "Invalid category is accepted.");
+}
+
+/**
+ * GIVEN : No initial condition.
+ * WHEN  : A string and a list are created for a category, a node is added to the list, then they are destroyed.
+ * THEN  : String, its buffer, the list and its node are accounted to the category instead of other memory.
+ */
+void test_usage_002(void)
+{
+    const char *value = "Content of the string which is too long to be stored inline.";
+    mcl_memory_usage_t initial_usage;
+    mcl_memory_usage_t usage;
+    string_t *string = MCL_NULL;
+    list_t *list = MCL_NULL;
+
+    mcl_memory_get_usage(MCL_MEMORY_CATEGORY_SECURITY, &initial_usage);
+
+    TEST_ASSERT_EQUAL_MESSAGE(MCL_OK, string_category_initialize_new(MCL_MEMORY_CATEGORY_SECURITY, value, 0, &string), "String could not be initialized.");
+    TEST_ASSERT_EQUAL_MESSAGE(MCL_OK, list_category_initialize(MCL_MEMORY_CATEGORY_SECURITY, &list), "List could not be initialized.");
+    TEST_ASSERT_EQUAL_MESSAGE(MCL_OK, list_add(list, string), "String could not be added to the list.");
+
+    // Buffer, list and the slabs of the string handle and the node.
+    mcl_memory_get_usage(MCL_MEMORY_CATEGORY_SECURITY, &usage);
+    TEST_ASSERT_EQUAL_MESSAGE(initial_usage.count + 4, usage.count, "Allocations are not accounted to the category.");
+    TEST_ASSERT_TRUE_MESSAGE(initial_usage.bytes + strlen(value) + 1 + sizeof(list_t) <= usage.bytes, "Allocated bytes are not accounted to the category.");
+
+    // Last slab of each pool is kept for reuse.
+    initial_usage = usage;
+    list_destroy_with_content(&list, (list_item_destroy_callback)string_destroy);
+    mcl_memory_get_usage(MCL_MEMORY_CATEGORY_SECURITY, &usage);
+    TEST_ASSERT_EQUAL_MESSAGE(initial_usage.count - 2, usage.count, "Released allocations are still accounted.");
+    TEST_ASSERT_EQUAL_MESSAGE(initial_usage.bytes - (strlen(value) + 1 + sizeof(list_t)), usage.bytes, "Released bytes are still accounted.");
+}
+
+/**
+ * GIVEN : A buffer is allocated by MCL for the user.
+ * WHEN  : User releases the buffer with mcl_memory_free().
+ * THEN  : Buffer is no longer accounted to its category.
+ */
+void test_free_001(void)
+{
+    mcl_memory_usage_t initial_usage;
+    mcl_memory_usage_t usage;
+    char *buffer;
+
+    mcl_memory_get_usage(MCL_MEMORY_CATEGORY_HTTP, &initial_usage);
+
+    buffer = memory_category_malloc(MCL_MEMORY_CATEGORY_HTTP, 100);
+    TEST_ASSERT_NOT_NULL_MESSAGE(buffer, "Buffer could not be allocated.");
+
+    mcl_memory_free(buffer);
+    mcl_memory_get_usage(MCL_MEMORY_CATEGORY_HTTP, &usage);
+    TEST_ASSERT_EQUAL_MESSAGE(initial_usage.bytes, usage.bytes, "Released bytes are still accounted.");
+    TEST_ASSERT_EQUAL_MESSAGE(initial_usage.count, usage.count, "Released buffer is still counted.");
+
+    mcl_memory_free(MCL_NULL);
+}
+
+typedef struct counting_allocator_context_t
+{
+    int malloc_count;
+    int realloc_count;
+    int free_count;
+} counting_allocator_context_t;
+
+static void *_counting_malloc(void *context, mcl_size_t size)
+{
+    ((counting_allocator_context_t *)context)->malloc_count++;
+    return malloc(size);
+}
+
+static void *_counting_realloc(void *context, void *p, mcl_size_t size)
+{
+    ((counting_allocator_context_t *)context)->realloc_count++;
+    return realloc(p, size);
+}
+
+static void _counting_free(void *context, void *p)
+{
+    ((counting_allocator_context_t *)context)->free_count++;
+    free(p);
+}
+
+/**
+ * GIVEN : An allocator is set.
+ * WHEN  : Memory is allocated, resized and released.
+ * THEN  : Functions of the allocator are called with its context until the default allocator is set again.
+ */
+void test_set_allocator_001(void)
+{
+    counting_allocator_context_t context = {0, 0, 0};
+    mcl_memory_allocator_t allocator = {_counting_malloc, _counting_realloc, _counting_free, MCL_NULL};
+    char *buffer;
+
+    allocator.context = &context;
+    TEST_ASSERT_EQUAL_MESSAGE(MCL_OK, mcl_memory_set_allocator(&allocator), "Allocator could not be set.");
+
+    buffer = MCL_MALLOC(32);
+    MCL_RESIZE(buffer, 1024);
+    MCL_FREE(buffer);
+
+    TEST_ASSERT_EQUAL_MESSAGE(MCL_OK, mcl_memory_set_allocator(MCL_NULL), "Default allocator could not be set.");
+    TEST_ASSERT_TRUE_MESSAGE(1 <= context.malloc_count, "Allocator is not used for allocation.");
+    TEST_ASSERT_EQUAL_MESSAGE(1, context.realloc_count, "Allocator is not used for resize.");
+    TEST_ASSERT_EQUAL_MESSAGE(1, context.free_count, "Allocator is not used for release.");
+
+    buffer = MCL_MALLOC(32);
+    MCL_FREE(buffer);
+    TEST_ASSERT_EQUAL_MESSAGE(1, context.free_count, "Allocator is used after the default allocator is set.");
+
+    allocator.free_callback = MCL_NULL;
+    TEST_ASSERT_EQUAL_MESSAGE(MCL_TRIGGERED_WITH_NULL, mcl_memory_set_allocator(&allocator), "Allocator without free function is accepted.");
+}
+
+static void *_querying_malloc(void *context, mcl_size_t size)
+{
+    mcl_memory_usage_t usage;
+
+    // Deadlocks if the allocator is called with the lock of the memory module held.
+    mcl_memory_get_usage(MCL_MEMORY_CATEGORY_OTHER, &usage);
+    return _counting_malloc(context, size);
+}
+
+static void _querying_free(void *context, void *p)
+{
+    mcl_memory_usage_t usage;
+
+    mcl_memory_get_usage(MCL_MEMORY_CATEGORY_OTHER, &usage);
+    _counting_free(context, p);
+}
+
+/**
+ * GIVEN : An allocator which queries the memory usage is set.
+ * WHEN  : So many buffers are allocated and released that the table of tracked allocations grows.
+ * THEN  : Allocator is not called with the lock of the memory module held and all buffers are released.
+ */
+void test_set_allocator_002(void)
+{
+    counting_allocator_context_t context = {0, 0, 0};
+    mcl_memory_allocator_t allocator = {_querying_malloc, _counting_realloc, _querying_free, MCL_NULL};
+    mcl_memory_usage_t initial_usage;
+    mcl_memory_usage_t usage;
+    char *buffers[1024];
+    int index;
+
+    allocator.context = &context;
+    TEST_ASSERT_EQUAL_MESSAGE(MCL_OK, mcl_memory_set_allocator(&allocator), "Allocator could not be set.");
+    mcl_memory_get_usage(MCL_MEMORY_CATEGORY_JSON, &initial_usage);
+
+    for (index = 0; index < 1024; index++)
+    {
+        buffers[index] = memory_allocate(16, MCL_MEMORY_CATEGORY_JSON, __FUNCTION__, __LINE__);
+        TEST_ASSERT_NOT_NULL_MESSAGE(buffers[index], "Buffer could not be allocated.");
+    }
+
+    mcl_memory_get_usage(MCL_MEMORY_CATEGORY_JSON, &usage);
+    TEST_ASSERT_EQUAL_MESSAGE(initial_usage.count + 1024, usage.count, "Allocations are not counted.");
+
+    for (index = 0; index < 1024; index++)
+    {
+        MCL_FREE(buffers[index]);
+    }
+
+    mcl_memory_get_usage(MCL_MEMORY_CATEGORY_JSON, &usage);
+    TEST_ASSERT_EQUAL_MESSAGE(initial_usage.count, usage.count, "Released allocations are still counted.");
+    TEST_ASSERT_TRUE_MESSAGE(1024 < context.malloc_count, "Table of tracked allocations is not allocated with the allocator.");
+
+    TEST_ASSERT_EQUAL_MESSAGE(MCL_OK, mcl_memory_set_allocator(MCL_NULL), "Default allocator could not be set.");
+}
+
+/**
+ * GIVEN : No initial condition.
+ * WHEN  : Memory is allocated, resized and released at two call sites.
+ * THEN  : Telemetry of the call sites follows the allocations if MCL is built with memory telemetry, otherwise telemetry is not supported.
+ */
+void test_telemetry_001(void)
+{
+    mcl_memory_telemetry_t telemetry;
+    char *json = MCL_NULL;
+
+#if (1 == MCL_MEMORY_TELEMETRY)
+    mcl_memory_telemetry_t initial_telemetry;
+    mcl_memory_call_site_t call_site;
+    mcl_size_t peak_bytes[2] = {0, 0};
+    mcl_size_t index;
+    char *buffer;
+
+    TEST_ASSERT_EQUAL_MESSAGE(MCL_OK, mcl_memory_reset_peak(), "Peak could not be reset.");
+    TEST_ASSERT_EQUAL_MESSAGE(MCL_OK, mcl_memory_get_telemetry(&initial_telemetry), "Telemetry could not be queried.");
+
+    buffer = memory_allocate(100, MCL_MEMORY_CATEGORY_OTHER, __FUNCTION__, 1);
+    buffer = memory_reallocate(buffer, 300, MCL_MEMORY_CATEGORY_OTHER, __FUNCTION__, 2);
+
+    mcl_memory_get_telemetry(&telemetry);
+    TEST_ASSERT_EQUAL_MESSAGE(initial_telemetry.current_bytes + 300, telemetry.current_bytes, "Resized bytes are not counted.");
+    TEST_ASSERT_EQUAL_MESSAGE(initial_telemetry.current_count + 1, telemetry.current_count, "Resize is counted as a new live allocation.");
+    TEST_ASSERT_EQUAL_MESSAGE(initial_telemetry.allocation_count + 2, telemetry.allocation_count, "Allocations are not counted.");
+
+    MCL_FREE(buffer);
+    mcl_memory_get_telemetry(&telemetry);
+    TEST_ASSERT_EQUAL_MESSAGE(initial_telemetry.current_bytes, telemetry.current_bytes, "Released bytes are still counted.");
+    TEST_ASSERT_EQUAL_MESSAGE(initial_telemetry.current_bytes + 300, telemetry.peak_bytes, "Peak bytes are wrong.");
+
+    for (index = 0; MCL_OK == mcl_memory_get_call_site(index, &call_site); index++)
+    {
+        if ((0 == strcmp(__FUNCTION__, call_site.function)) && (1 <= call_site.line) && (2 >= call_site.line))
+        {
+            TEST_ASSERT_EQUAL_MESSAGE(0, call_site.current_bytes, "Released bytes are still counted for the call site.");
+            TEST_ASSERT_EQUAL_MESSAGE(1, call_site.allocation_count, "Allocation is not counted for the call site.");
+            TEST_ASSERT_EQUAL_MESSAGE(call_site.peak_bytes, call_site.largest_size, "Largest size is wrong.");
+            peak_bytes[call_site.line - 1] = call_site.peak_bytes;
+        }
+    }
+    TEST_ASSERT_EQUAL_MESSAGE(telemetry.call_site_count, index, "Call sites can not be iterated.");
+    TEST_ASSERT_EQUAL_MESSAGE(100, peak_bytes[0], "Peak bytes of the allocating call site are wrong.");
+    TEST_ASSERT_EQUAL_MESSAGE(300, peak_bytes[1], "Peak bytes of the resizing call site are wrong.");
+
+    TEST_ASSERT_EQUAL_MESSAGE(MCL_OK, mcl_memory_dump_telemetry(&json), "Telemetry could not be dumped.");
+    TEST_ASSERT_NOT_NULL_MESSAGE(strstr(json, "{\"function\":\"test_telemetry_001\",\"line\":2,\"current_bytes\":0,\"peak_bytes\":300,"), "Call site is not dumped.");
+    TEST_ASSERT_EQUAL_MESSAGE('}', json[strlen(json) - 1], "Json string is not terminated.");
+    MCL_FREE(json);
+#else
+    TEST_ASSERT_EQUAL_MESSAGE(MCL_OPERATION_IS_NOT_SUPPORTED, mcl_memory_get_telemetry(&telemetry), "Telemetry is supported without memory telemetry.");
+    TEST_ASSERT_EQUAL_MESSAGE(MCL_OPERATION_IS_NOT_SUPPORTED, mcl_memory_dump_telemetry(&json), "Telemetry is dumped without memory telemetry.");
+#endif
+}
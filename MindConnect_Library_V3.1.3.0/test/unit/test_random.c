@@ -183,3 +183,53 @@ void test_generate_guid_001()
 
     TEST_ASSERT_EQUAL(MCL_OK, code);
 }
+
+/**
+ * GIVEN : Initialized random pool.
+ * WHEN  : Random bytes are requested from the pool more than once.
+ * THEN  : MCL_OK is returned and consecutive requests receive different bytes.
+ */
+void test_pool_get_bytes_001()
+{
+    random_pool_t *random_pool = MCL_NULL;
+    mcl_uint8_t bytes_1[16];
+    mcl_uint8_t bytes_2[16];
+    E_MCL_ERROR_CODE code = random_pool_initialize(&random_pool);
+    TEST_ASSERT_EQUAL(MCL_OK, code);
+
+    code = random_pool_get_bytes(random_pool, bytes_1, sizeof(bytes_1));
+    TEST_ASSERT_EQUAL(MCL_OK, code);
+
+    code = random_pool_get_bytes(random_pool, bytes_2, sizeof(bytes_2));
+    TEST_ASSERT_EQUAL(MCL_OK, code);
+
+    TEST_ASSERT_EQUAL_MESSAGE(MCL_FALSE, string_util_memcmp(bytes_1, bytes_2, sizeof(bytes_1)), "Random pool returned the same bytes twice!");
+
+    random_pool_destroy(&random_pool);
+    TEST_ASSERT_NULL(random_pool);
+}
+
+/**
+ * GIVEN : Initialized random pool.
+ * WHEN  : Random guid is generated using the pool.
+ * THEN  : MCL_OK is returned and guid is in version 4 format.
+ */
+void test_pool_generate_guid_001()
+{
+    random_pool_t *random_pool = MCL_NULL;
+    char guid[RANDOM_GUID_LENGTH + 1];
+    E_MCL_ERROR_CODE code = random_pool_initialize(&random_pool);
+    TEST_ASSERT_EQUAL(MCL_OK, code);
+
+    code = random_pool_generate_guid(random_pool, guid);
+    TEST_ASSERT_EQUAL(MCL_OK, code);
+
+    TEST_ASSERT_EQUAL(RANDOM_GUID_LENGTH, string_util_strlen(guid));
+    TEST_ASSERT_EQUAL('-', guid[8]);
+    TEST_ASSERT_EQUAL('-', guid[13]);
+    TEST_ASSERT_EQUAL('4', guid[14]);
+    TEST_ASSERT_EQUAL('-', guid[18]);
+    TEST_ASSERT_EQUAL('-', guid[23]);
+
+    random_pool_destroy(&random_pool);
+}
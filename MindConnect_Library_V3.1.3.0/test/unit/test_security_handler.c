@@ -20,6 +20,7 @@
 #include "definitions.h"
 #include "mock_base64.h"
 #include "mock_security.h"
+#include "mock_hmac.h"
 
 security_handler_t *security_handler = MCL_NULL;
 
@@ -177,3 +178,104 @@ void test_generate_rsa_key_001(void)
 
     security_handler_destroy(&security_handler);
 }
+
+/**
+* GIVEN : Initialized security handler with a key pair generated in advance.
+* WHEN  : security_handler_generate_rsa_key is called.
+* THEN  : MCL_OK is returned. Key pair generated in advance is used without generating a new one.
+*/
+void test_generate_rsa_key_002(void)
+{
+    char *public_key = MCL_MALLOC(4);
+    char *private_key = MCL_MALLOC(4);
+    E_MCL_ERROR_CODE result = security_handler_initialize(&security_handler);
+    TEST_ASSERT_EQUAL(MCL_OK, result);
+
+    security_handler_set_next_rsa_key(security_handler, public_key, private_key);
+
+    // security_generate_rsa_key is not expected to be called.
+    result = security_handler_generate_rsa_key(security_handler);
+    TEST_ASSERT_EQUAL(MCL_OK, result);
+    TEST_ASSERT_EQUAL_PTR(public_key, security_handler->rsa.public_key);
+    TEST_ASSERT_EQUAL_PTR(private_key, security_handler->rsa.private_key);
+    TEST_ASSERT_NULL(security_handler->next_public_key);
+    TEST_ASSERT_NULL(security_handler->next_private_key);
+
+    security_handler_destroy(&security_handler);
+}
+
+/**
+* GIVEN : Initialized security handler with RSA private key.
+* WHEN  : security_handler_rsa_sign is called twice, then the key is rotated and security_handler_rsa_sign is called again.
+* THEN  : Private key is decoded once for the first two signatures and once again after rotation.
+*/
+void test_rsa_sign_001(void)
+{
+    int decoded_key_1 = 1;
+    int decoded_key_2 = 2;
+    void *decoded_key_1_pointer = &decoded_key_1;
+    void *decoded_key_2_pointer = &decoded_key_2;
+    mcl_uint8_t *signature = MCL_NULL;
+    mcl_size_t signature_size = 0;
+    E_MCL_ERROR_CODE result = security_handler_initialize(&security_handler);
+    TEST_ASSERT_EQUAL(MCL_OK, result);
+
+    security_rsa_load_private_key_ExpectAnyArgsAndReturn(MCL_OK);
+    security_rsa_load_private_key_ReturnThruPtr_private_key(&decoded_key_1_pointer);
+    security_rsa_sign_with_key_ExpectAndReturn(&decoded_key_1, "data", 4, &signature, &signature_size, MCL_OK);
+    security_rsa_sign_with_key_ExpectAndReturn(&decoded_key_1, "data", 4, &signature, &signature_size, MCL_OK);
+
+    TEST_ASSERT_EQUAL(MCL_OK, security_handler_rsa_sign(security_handler, "data", 4, &signature, &signature_size));
+    TEST_ASSERT_EQUAL(MCL_OK, security_handler_rsa_sign(security_handler, "data", 4, &signature, &signature_size));
+    TEST_ASSERT_EQUAL_PTR_MESSAGE(&decoded_key_1, security_handler->rsa.decoded_private_key, "Decoded private key is not kept.");
+
+    security_rsa_free_private_key_Expect(&security_handler->rsa.decoded_private_key);
+    security_generate_rsa_key_IgnoreAndReturn(MCL_OK);
+    TEST_ASSERT_EQUAL(MCL_OK, security_handler_generate_rsa_key(security_handler));
+
+    // Mock does not reset the decoded key.
+    security_handler->rsa.decoded_private_key = MCL_NULL;
+
+    security_rsa_load_private_key_ExpectAnyArgsAndReturn(MCL_OK);
+    security_rsa_load_private_key_ReturnThruPtr_private_key(&decoded_key_2_pointer);
+    security_rsa_sign_with_key_ExpectAndReturn(&decoded_key_2, "data", 4, &signature, &signature_size, MCL_OK);
+    TEST_ASSERT_EQUAL(MCL_OK, security_handler_rsa_sign(security_handler, "data", 4, &signature, &signature_size));
+
+    security_handler->rsa.decoded_private_key = MCL_NULL;
+    security_handler_destroy(&security_handler);
+}
+
+/**
+* GIVEN : Initialized security handler with client secret.
+* WHEN  : security_handler_hmac_sha256 is called twice.
+* THEN  : HMAC handle is initialized with the client secret once and reused for the second calculation.
+*/
+void test_hmac_sha256_001(void)
+{
+    hmac_sha256_t hmac;
+    hmac_sha256_t *hmac_pointer = &hmac;
+    mcl_uint8_t *hash = MCL_NULL;
+    mcl_size_t hash_size = 0;
+    E_MCL_ERROR_CODE result = security_handler_initialize(&security_handler);
+    TEST_ASSERT_EQUAL(MCL_OK, result);
+    string_initialize_new("secret", 0, &security_handler->client_secret);
+
+    hmac_sha256_initialize_ExpectAndReturn((const mcl_uint8_t *)security_handler->client_secret->buffer, 6, &security_handler->hmac, MCL_OK);
+    hmac_sha256_initialize_ReturnThruPtr_hmac(&hmac_pointer);
+    hmac_sha256_start_ExpectAndReturn(&hmac, MCL_OK);
+    hmac_sha256_update_ExpectAndReturn(&hmac, (const mcl_uint8_t *)"data", 4, MCL_OK);
+    hmac_sha256_finish_ExpectAndReturn(&hmac, &hash, &hash_size, MCL_OK);
+    hmac_sha256_start_ExpectAndReturn(&hmac, MCL_OK);
+    hmac_sha256_update_ExpectAndReturn(&hmac, (const mcl_uint8_t *)"data", 4, MCL_OK);
+    hmac_sha256_finish_ExpectAndReturn(&hmac, &hash, &hash_size, MCL_OK);
+
+    TEST_ASSERT_EQUAL(MCL_OK, security_handler_hmac_sha256(security_handler, (const mcl_uint8_t *)"data", 4, &hash, &hash_size));
+    TEST_ASSERT_EQUAL(MCL_OK, security_handler_hmac_sha256(security_handler, (const mcl_uint8_t *)"data", 4, &hash, &hash_size));
+    TEST_ASSERT_EQUAL_PTR_MESSAGE(&hmac, security_handler->hmac, "HMAC handle is not kept.");
+
+    hmac_sha256_destroy_Expect(&security_handler->hmac);
+    security_handler_reset_hmac_key(security_handler);
+
+    security_handler->hmac = MCL_NULL;
+    security_handler_destroy(&security_handler);
+}
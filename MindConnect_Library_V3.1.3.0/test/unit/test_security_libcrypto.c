@@ -187,6 +187,35 @@ void test_rsa_sign_001(void)
     MCL_FREE(signature);
 }
 
+/**
+ * GIVEN : Data to be signed and RSA key decoded once.
+ * WHEN  : Data is signed twice with the decoded RSA key.
+ * THEN  : MCL_OK is returned and the same signature is generated both times.
+ */
+void test_rsa_sign_with_key_001(void)
+{
+    char *data = "eyJhbGciOiJSUzI1NiIsInR5cCI6IkpXVCJ9.eyJpc3MiOiJkYmE4YmFiNy0yODZkLTRiODUtNTUyMS00OTliYmViMWE1OGQifQ";
+    void *private_key = MCL_NULL;
+    unsigned char *signature_1 = MCL_NULL;
+    unsigned char *signature_2 = MCL_NULL;
+    mcl_size_t signature_length_1 = 0;
+    mcl_size_t signature_length_2 = 0;
+
+    TEST_ASSERT_EQUAL(MCL_OK, security_rsa_load_private_key(private_key_1, &private_key));
+    TEST_ASSERT_NOT_NULL(private_key);
+
+    TEST_ASSERT_EQUAL(MCL_OK, security_rsa_sign_with_key(private_key, data, strlen(data), &signature_1, &signature_length_1));
+    TEST_ASSERT_EQUAL(MCL_OK, security_rsa_sign_with_key(private_key, data, strlen(data), &signature_2, &signature_length_2));
+    TEST_ASSERT_EQUAL(signature_length_1, signature_length_2);
+    TEST_ASSERT_EQUAL_MEMORY(signature_1, signature_2, signature_length_1);
+
+    security_rsa_free_private_key(&private_key);
+    TEST_ASSERT_NULL(private_key);
+
+    MCL_FREE(signature_1);
+    MCL_FREE(signature_2);
+}
+
 /**
  * GIVEN : RSA public key.
  * WHEN  : Modulus and public exponent are extracted.
@@ -29,6 +29,8 @@
 #include "data_types.h"
 #include "mcl/mcl_store.h"
 #include "time_util.h"
+#include "intern_table.h"
+#include "store_wal.h"
 
 char *type = "customType";
 char *version = "1.0";
@@ -81,6 +83,69 @@ void test_initialize_002()
     TEST_ASSERT_MESSAGE(MCL_TRIGGERED_WITH_NULL == code, "Expected code not returned from mcl_store_initialize()!");
 }
 
+/**
+ * GIVEN : Store is initialized with an arena.
+ * WHEN  : Adding a new time_series to store is called.
+ * THEN  : Store data is allocated from the arena of the store while the store itself is not.
+ */
+void test_initialize_with_arena_001()
+{
+    mcl_time_series_t *time_series = MCL_NULL;
+    mcl_time_series_t *new_time_series = MCL_NULL;
+    mcl_store_t *store = MCL_NULL;
+    E_MCL_ERROR_CODE code;
+
+    MCL_NEW(time_series);
+    time_series_initialize_ExpectAnyArgsAndReturn(MCL_OK);
+    time_series_initialize_ReturnThruPtr_time_series(&time_series);
+
+    code = mcl_store_initialize_with_arena(MCL_FALSE, 0, &store);
+    TEST_ASSERT_MESSAGE(MCL_OK == code, "Expected code MCL_OK not returned from mcl_store_initialize_with_arena()!");
+    TEST_ASSERT_NOT_NULL_MESSAGE(store->arena, "Store arena is not initialized.");
+    TEST_ASSERT_FALSE_MESSAGE(memory_arena_contains(store->arena, store), "Store must not be allocated from its arena.");
+
+    code = mcl_store_new_time_series(store, "1.0", "e3217e2b-7036-49f2-9814-4c38542cd781", MCL_NULL, &new_time_series);
+    TEST_ASSERT_MESSAGE(MCL_OK == code, "Expected code not returned from mcl_store_new_time_series()!");
+    TEST_ASSERT_TRUE_MESSAGE(memory_arena_contains(store->arena, store->high_priority_list->head), "List node is not allocated from store arena.");
+    TEST_ASSERT_TRUE_MESSAGE(memory_arena_contains(store->arena, store->high_priority_list->head->data), "Store data is not allocated from store arena.");
+    TEST_ASSERT_NULL_MESSAGE(memory_arena_set_current(MCL_NULL), "Store arena is still the current arena.");
+
+    MCL_FREE(time_series);
+    time_series_destroy_Ignore();
+    mcl_store_destroy(&store);
+    TEST_ASSERT_NULL_MESSAGE(store, "Store is not NULL after destroy.");
+}
+
+/**
+ * GIVEN : Store with an arena has a single data.
+ * WHEN  : Memory is reclaimed before and after the data is removed from the store.
+ * THEN  : Blocks of the arena are released only when the store is empty.
+ */
+void test_reclaim_memory_001()
+{
+    mcl_time_series_t *time_series = MCL_NULL;
+    mcl_time_series_t *new_time_series = MCL_NULL;
+    mcl_store_t *store = MCL_NULL;
+
+    MCL_NEW(time_series);
+    time_series_initialize_ExpectAnyArgsAndReturn(MCL_OK);
+    time_series_initialize_ReturnThruPtr_time_series(&time_series);
+    time_series_destroy_Ignore();
+
+    mcl_store_initialize_with_arena(MCL_FALSE, 0, &store);
+    mcl_store_new_time_series(store, "1.0", "e3217e2b-7036-49f2-9814-4c38542cd781", MCL_NULL, &new_time_series);
+
+    store_reclaim_memory(store);
+    TEST_ASSERT_NOT_NULL_MESSAGE(store->arena->blocks, "Arena is reset while store has data.");
+
+    store_data_remove(store->high_priority_list, store->high_priority_list->head);
+    store_reclaim_memory(store);
+    TEST_ASSERT_NULL_MESSAGE(store->arena->blocks, "Arena is not reset when store is empty.");
+
+    MCL_FREE(time_series);
+    mcl_store_destroy(&store);
+}
+
 /**
  * GIVEN : Store is initialized.
  * WHEN  : Adding a new custom data to store is called.
@@ -860,3 +925,155 @@ void test_new_file_001()
     TEST_ASSERT_MESSAGE(MCL_TRIGGERED_WITH_NULL == return_code, "mcl_store_new_file() does not return MCL_TRIGGERED_WITH_NULL.");
 }
 
+
+/**
+ * GIVEN : Store is initialized and its priority is set to low.
+ * WHEN  : Adding a new custom data to store is called.
+ * THEN  : Custom data must be added to the low priority list.
+ */
+void test_set_priority_001()
+{
+    mcl_custom_data_t *custom_data = MCL_NULL;
+    MCL_NEW(custom_data);
+
+    // Set up mocks.
+    custom_data_initialize_ExpectAnyArgsAndReturn(MCL_OK);
+    custom_data_initialize_ReturnThruPtr_custom_data(&custom_data);
+    custom_data_destroy_Ignore();
+
+    // Initialize store.
+    mcl_store_t *store = MCL_NULL;
+    mcl_store_initialize(MCL_FALSE, &store);
+
+    // Call test function.
+    E_MCL_ERROR_CODE code = mcl_store_set_priority(store, MCL_STORE_PRIORITY_LOW);
+    TEST_ASSERT_MESSAGE(MCL_OK == code, "Expected code not returned from mcl_store_set_priority()!");
+
+    mcl_custom_data_t *new_custom_data = MCL_NULL;
+    code = mcl_store_new_custom_data(store, version, type, routing, &new_custom_data);
+    TEST_ASSERT_MESSAGE(MCL_OK == code, "Expected code not returned from mcl_store_new_custom_data()!");
+
+    TEST_ASSERT_EQUAL_MESSAGE(0, store->high_priority_list->count, "Low priority data is added to the high priority list.");
+    TEST_ASSERT_EQUAL_MESSAGE(1, store->low_priority_list->count, "Low priority data is not added to the low priority list.");
+    TEST_ASSERT_EQUAL_PTR(custom_data, ((store_data_t *)store->low_priority_list->head->data)->data);
+
+    // Clean up.
+    MCL_FREE(custom_data);
+    mcl_store_destroy(&store);
+}
+
+/**
+ * GIVEN : Store is initialized.
+ * WHEN  : mcl_store_set_priority() is called with an invalid priority or NULL store.
+ * THEN  : MCL_INVALID_PARAMETER and MCL_TRIGGERED_WITH_NULL must be returned respectively.
+ */
+void test_set_priority_002()
+{
+    mcl_store_t *store = MCL_NULL;
+    mcl_store_initialize(MCL_FALSE, &store);
+
+    TEST_ASSERT_EQUAL(MCL_INVALID_PARAMETER, mcl_store_set_priority(store, MCL_STORE_PRIORITY_END));
+    TEST_ASSERT_EQUAL(MCL_TRIGGERED_WITH_NULL, mcl_store_set_priority(MCL_NULL, MCL_STORE_PRIORITY_LOW));
+    TEST_ASSERT_EQUAL_MESSAGE(MCL_STORE_PRIORITY_HIGH, store->priority, "Priority is changed by an invalid call.");
+
+    mcl_store_destroy(&store);
+}
+
+/**
+ * GIVEN : Store with a low priority custom data waiting to be written.
+ * WHEN  : Low priority data in store is aged once less and then exactly as many times as the limit.
+ * THEN  : Custom data is kept in the low priority list at first and moved to the end of the high priority list at the end.
+ */
+void test_age_low_priority_data_001()
+{
+    mcl_custom_data_t *high_custom_data = MCL_NULL;
+    mcl_custom_data_t *low_custom_data = MCL_NULL;
+    mcl_custom_data_t *new_custom_data = MCL_NULL;
+    mcl_size_t index;
+    MCL_NEW(high_custom_data);
+    MCL_NEW(low_custom_data);
+
+    // Set up mocks.
+    custom_data_initialize_ExpectAnyArgsAndReturn(MCL_OK);
+    custom_data_initialize_ReturnThruPtr_custom_data(&low_custom_data);
+    custom_data_initialize_ExpectAnyArgsAndReturn(MCL_OK);
+    custom_data_initialize_ReturnThruPtr_custom_data(&high_custom_data);
+    custom_data_destroy_Ignore();
+
+    mcl_store_t *store = MCL_NULL;
+    mcl_store_initialize(MCL_FALSE, &store);
+    mcl_store_set_priority(store, MCL_STORE_PRIORITY_LOW);
+    mcl_store_new_custom_data(store, version, type, routing, &new_custom_data);
+    mcl_store_set_priority(store, MCL_STORE_PRIORITY_HIGH);
+    mcl_store_new_custom_data(store, version, type, routing, &new_custom_data);
+
+    for (index = 1; index < DEFAULT_STORE_LOW_PRIORITY_MAX_AGE; index++)
+    {
+        store_age_low_priority_data(store);
+    }
+    TEST_ASSERT_EQUAL_MESSAGE(1, store->low_priority_list->count, "Low priority data is moved before its age reaches the limit.");
+
+    // Call test function.
+    store_age_low_priority_data(store);
+
+    TEST_ASSERT_EQUAL_MESSAGE(0, store->low_priority_list->count, "Low priority data is not moved when its age reaches the limit.");
+    TEST_ASSERT_EQUAL(2, store->high_priority_list->count);
+    TEST_ASSERT_EQUAL_PTR(high_custom_data, ((store_data_t *)store->high_priority_list->head->data)->data);
+    TEST_ASSERT_EQUAL_PTR(low_custom_data, ((store_data_t *)store->high_priority_list->last->data)->data);
+
+    // Clean up.
+    MCL_FREE(high_custom_data);
+    MCL_FREE(low_custom_data);
+    mcl_store_destroy(&store);
+}
+
+/**
+ * GIVEN : Store with two prepared custom data of different sizes.
+ * WHEN  : store_index_find_prepared_data() is called with decreasing size class limits.
+ * THEN  : The largest prepared data below the limit is returned each time and NULL is returned when there is none left.
+ */
+void test_find_prepared_data_001()
+{
+    mcl_custom_data_t *small_custom_data = MCL_NULL;
+    mcl_custom_data_t *large_custom_data = MCL_NULL;
+    mcl_custom_data_t *new_custom_data = MCL_NULL;
+    store_data_t *small_store_data;
+    store_data_t *large_store_data;
+    MCL_NEW(small_custom_data);
+    MCL_NEW(large_custom_data);
+
+    // Set up mocks.
+    custom_data_initialize_ExpectAnyArgsAndReturn(MCL_OK);
+    custom_data_initialize_ReturnThruPtr_custom_data(&small_custom_data);
+    custom_data_initialize_ExpectAnyArgsAndReturn(MCL_OK);
+    custom_data_initialize_ReturnThruPtr_custom_data(&large_custom_data);
+    custom_data_destroy_Ignore();
+
+    mcl_store_t *store = MCL_NULL;
+    mcl_store_initialize(MCL_FALSE, &store);
+    mcl_store_new_custom_data(store, version, type, routing, &new_custom_data);
+    mcl_store_new_custom_data(store, version, type, routing, &new_custom_data);
+
+    small_store_data = (store_data_t *)store->high_priority_list->head->data;
+    large_store_data = (store_data_t *)store->high_priority_list->last->data;
+    TEST_ASSERT_NULL_MESSAGE(store_index_find_prepared_data(&store->high_priority_index, STORE_SIZE_CLASS_COUNT), "Data which is not prepared is found.");
+
+    small_store_data->payload_size = 100;
+    store_data_set_state(small_store_data, DATA_STATE_PREPARED);
+    large_store_data->payload_size = 1000;
+    store_data_set_state(large_store_data, DATA_STATE_PREPARED);
+
+    // Call test function.
+    TEST_ASSERT_EQUAL_PTR(large_store_data, store_index_find_prepared_data(&store->high_priority_index, STORE_SIZE_CLASS_COUNT));
+    TEST_ASSERT_EQUAL_PTR(small_store_data, store_index_find_prepared_data(&store->high_priority_index, store_data_get_size_class(large_store_data)));
+    TEST_ASSERT_NULL(store_index_find_prepared_data(&store->high_priority_index, store_data_get_size_class(small_store_data)));
+
+    store_data_set_state(large_store_data, DATA_STATE_WRITTEN);
+    TEST_ASSERT_EQUAL_PTR_MESSAGE(small_store_data, store_index_find_prepared_data(&store->high_priority_index, STORE_SIZE_CLASS_COUNT), "Written data is still indexed as prepared.");
+    TEST_ASSERT_EQUAL_PTR(large_store_data, store->in_flight.head);
+
+    // Clean up.
+    MCL_FREE(small_custom_data);
+    MCL_FREE(large_custom_data);
+    mcl_store_destroy(&store);
+}
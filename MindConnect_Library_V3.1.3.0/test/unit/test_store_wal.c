@@ -0,0 +1,361 @@
+/*!**********************************************************************
+*
+* @copyright Copyright (C) 2016 Siemens Aktiengesellschaft.\n
+*            All rights reserved.
+*
+*************************************************************************
+*
+* @file     test_store_wal.c
+* @date     Oct 17, 2026
+* @brief    Unit test cases for store_wal module.
+*
+************************************************************************/
+
+#include "mcl/mcl_common.h"
+#include "store_wal.h"
+#include "file_util.h"
+#include "string_util.h"
+#include "definitions.h"
+#include "memory.h"
+#include "unity.h"
+#include "string_type.h"
+
+#if !(defined(WIN32) || defined(WIN64))
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+#define REPLAYED_RECORD_MAX_COUNT 4
+#define FILE_NAME_SIZE 32
+
+store_wal_t *store_wal = MCL_NULL;
+store_wal_record_t *replayed_records[REPLAYED_RECORD_MAX_COUNT];
+string_t *replayed_metas[REPLAYED_RECORD_MAX_COUNT];
+mcl_size_t replayed_count = 0;
+
+static E_MCL_ERROR_CODE _replay_callback(store_wal_record_t *record, string_t *meta, void *user_context);
+static void _clear_replayed_records(void);
+static mcl_bool_t _file_exists(const char *file_name);
+
+void setUp(void)
+{
+    store_wal_initialize(".", &store_wal);
+}
+
+void tearDown(void)
+{
+    mcl_uint32_t index;
+    char file_name[FILE_NAME_SIZE];
+
+    _clear_replayed_records();
+    store_wal_destroy(&store_wal);
+
+    for (index = 0; index < 8; index++)
+    {
+        string_util_snprintf(file_name, FILE_NAME_SIZE, "./mcl_store_%u.wal", (unsigned int)index);
+        remove(file_name);
+    }
+    remove("./mcl_store.head");
+    remove("./mcl_store.lock");
+}
+
+/**
+ * GIVEN : Write-ahead log initialized by this process.
+ * WHEN  : Another process initializes a write-ahead log in the same directory.
+ * THEN  : MCL_PATH_NOT_ACCESSIBLE is returned to the other process.
+ */
+void test_initialize_001(void)
+{
+#if defined(WIN32) || defined(WIN64)
+    TEST_IGNORE_MESSAGE("Write-ahead log lock test needs fork().");
+#else
+    pid_t pid;
+    int status = -1;
+
+    TEST_ASSERT_NOT_NULL_RETURN(store_wal);
+
+    pid = fork();
+    TEST_ASSERT_TRUE(0 <= pid);
+
+    if (0 == pid)
+    {
+        store_wal_t *other_store_wal = MCL_NULL;
+        E_MCL_ERROR_CODE code = store_wal_initialize(".", &other_store_wal);
+
+        _exit(((MCL_PATH_NOT_ACCESSIBLE == code) && (MCL_NULL == other_store_wal)) ? 0 : 1);
+    }
+
+    waitpid(pid, &status, 0);
+    TEST_ASSERT_TRUE_MESSAGE(WIFEXITED(status) && (0 == WEXITSTATUS(status)), "Directory of write-ahead log is not locked against another process.");
+#endif
+}
+
+/**
+ * GIVEN : Empty write-ahead log.
+ * WHEN  : Two store data, one with a content id, are appended and the log is replayed by a new handle.
+ * THEN  : Both store data are replayed in order with their content id, meta and payload.
+ */
+void test_replay_001(void)
+{
+    string_t *content_id = MCL_NULL;
+    string_t *meta_1 = MCL_NULL;
+    string_t *meta_2 = MCL_NULL;
+    store_wal_record_t *record_1 = MCL_NULL;
+    store_wal_record_t *record_2 = MCL_NULL;
+    char payload[16];
+
+    TEST_ASSERT_NOT_NULL_RETURN(store_wal);
+
+    string_initialize_static("content-1", 0, &content_id);
+    string_initialize_static("{\"meta\":1}", 0, &meta_1);
+    string_initialize_static("{\"meta\":2}", 0, &meta_2);
+
+    TEST_ASSERT_EQUAL(MCL_OK, store_wal_replay(store_wal, _replay_callback, MCL_NULL));
+    TEST_ASSERT_EQUAL(MCL_OK, store_wal_append(store_wal, 3, content_id, meta_1, (const mcl_uint8_t *)"payload-1", 9, &record_1));
+    TEST_ASSERT_EQUAL(MCL_OK, store_wal_append(store_wal, 5, MCL_NULL, meta_2, (const mcl_uint8_t *)"payload-22", 10, &record_2));
+
+    TEST_ASSERT_EQUAL_STRING("content-1", record_1->content_id->buffer);
+
+    store_wal_record_destroy(&record_1);
+    store_wal_record_destroy(&record_2);
+    string_destroy(&content_id);
+    string_destroy(&meta_1);
+    string_destroy(&meta_2);
+    store_wal_destroy(&store_wal);
+
+    TEST_ASSERT_EQUAL(MCL_OK, store_wal_initialize(".", &store_wal));
+    TEST_ASSERT_EQUAL(MCL_OK, store_wal_replay(store_wal, _replay_callback, MCL_NULL));
+
+    TEST_ASSERT_EQUAL_MESSAGE(2, replayed_count, "Replayed record count is wrong.");
+    TEST_ASSERT_EQUAL(3, replayed_records[0]->data_type);
+    TEST_ASSERT_EQUAL(5, replayed_records[1]->data_type);
+    TEST_ASSERT_NOT_NULL_RETURN(replayed_records[0]->content_id);
+    TEST_ASSERT_EQUAL_STRING("content-1", replayed_records[0]->content_id->buffer);
+    TEST_ASSERT_NULL(replayed_records[1]->content_id);
+    TEST_ASSERT_EQUAL_STRING("{\"meta\":1}", replayed_metas[0]->buffer);
+    TEST_ASSERT_EQUAL_STRING("{\"meta\":2}", replayed_metas[1]->buffer);
+    TEST_ASSERT_EQUAL(10, replayed_records[1]->payload_size);
+
+    TEST_ASSERT_EQUAL(10, store_wal_read_payload(replayed_records[1], 0, payload, replayed_records[1]->payload_size));
+    TEST_ASSERT_EQUAL_MEMORY("payload-22", payload, 10);
+    TEST_ASSERT_EQUAL(4, store_wal_read_payload(replayed_records[0], 5, payload, 4));
+    TEST_ASSERT_EQUAL_MEMORY("ad-1", payload, 4);
+}
+
+/**
+ * GIVEN : Write-ahead log with two store data, the last one is followed by a partially written record.
+ * WHEN  : The log is replayed.
+ * THEN  : Only the complete records are replayed.
+ */
+void test_replay_002(void)
+{
+    string_t *meta = MCL_NULL;
+    store_wal_record_t *record = MCL_NULL;
+    void *file_descriptor = MCL_NULL;
+
+    TEST_ASSERT_NOT_NULL_RETURN(store_wal);
+
+    string_initialize_static("{}", 0, &meta);
+
+    TEST_ASSERT_EQUAL(MCL_OK, store_wal_replay(store_wal, _replay_callback, MCL_NULL));
+    TEST_ASSERT_EQUAL(MCL_OK, store_wal_append(store_wal, 0, MCL_NULL, meta, (const mcl_uint8_t *)"[]", 2, &record));
+    store_wal_record_destroy(&record);
+    TEST_ASSERT_EQUAL(MCL_OK, store_wal_append(store_wal, 0, MCL_NULL, meta, (const mcl_uint8_t *)"[1]", 3, &record));
+    store_wal_record_destroy(&record);
+    string_destroy(&meta);
+    store_wal_destroy(&store_wal);
+
+    // Append the beginning of a record as if the agent is stopped while writing it.
+    TEST_ASSERT_EQUAL(MCL_OK, file_util_fopen("./mcl_store_0.wal", "ab", &file_descriptor));
+    TEST_ASSERT_EQUAL(MCL_OK, file_util_fwrite("WLCM\001\000", 1, 6, file_descriptor));
+    file_util_fclose(file_descriptor);
+
+    TEST_ASSERT_EQUAL(MCL_OK, store_wal_initialize(".", &store_wal));
+    TEST_ASSERT_EQUAL(MCL_OK, store_wal_replay(store_wal, _replay_callback, MCL_NULL));
+
+    TEST_ASSERT_EQUAL_MESSAGE(2, replayed_count, "Replayed record count is wrong.");
+    TEST_ASSERT_EQUAL(3, replayed_records[1]->payload_size);
+}
+
+/**
+ * GIVEN : Write-ahead log with a store data followed by a record header whose content id size exceeds the segment.
+ * WHEN  : The log is replayed.
+ * THEN  : Replay stops at the corrupt record without reading it, the store data before it is replayed.
+ */
+void test_replay_003(void)
+{
+    string_t *meta = MCL_NULL;
+    store_wal_record_t *record = MCL_NULL;
+    void *file_descriptor = MCL_NULL;
+
+    // Magic, data kind, data type, content id size, meta size, payload size and checksum followed by a few bytes of content.
+    mcl_uint32_t header[7] = {0x4D434C57u, 1, 0, 0xFFFFFFFFu, 2, 2, 0};
+
+    TEST_ASSERT_NOT_NULL_RETURN(store_wal);
+
+    string_initialize_static("{}", 0, &meta);
+
+    TEST_ASSERT_EQUAL(MCL_OK, store_wal_replay(store_wal, _replay_callback, MCL_NULL));
+    TEST_ASSERT_EQUAL(MCL_OK, store_wal_append(store_wal, 0, MCL_NULL, meta, (const mcl_uint8_t *)"[1]", 3, &record));
+    store_wal_record_destroy(&record);
+    string_destroy(&meta);
+    store_wal_destroy(&store_wal);
+
+    TEST_ASSERT_EQUAL(MCL_OK, file_util_fopen("./mcl_store_0.wal", "ab", &file_descriptor));
+    TEST_ASSERT_EQUAL(MCL_OK, file_util_fwrite(header, sizeof(header), 1, file_descriptor));
+    TEST_ASSERT_EQUAL(MCL_OK, file_util_fwrite("{}[]", 1, 4, file_descriptor));
+    file_util_fclose(file_descriptor);
+
+    TEST_ASSERT_EQUAL(MCL_OK, store_wal_initialize(".", &store_wal));
+    TEST_ASSERT_EQUAL(MCL_OK, store_wal_replay(store_wal, _replay_callback, MCL_NULL));
+
+    TEST_ASSERT_EQUAL_MESSAGE(1, replayed_count, "Replayed record count is wrong.");
+    TEST_ASSERT_EQUAL(3, replayed_records[0]->payload_size);
+}
+
+/**
+ * GIVEN : Write-ahead log with two store data replayed from a previous run.
+ * WHEN  : First store data is acknowledged and the log is replayed again.
+ * THEN  : Only the second store data is replayed.
+ */
+void test_acknowledge_001(void)
+{
+    string_t *meta = MCL_NULL;
+    store_wal_record_t *record = MCL_NULL;
+
+    TEST_ASSERT_NOT_NULL_RETURN(store_wal);
+
+    string_initialize_static("{}", 0, &meta);
+
+    TEST_ASSERT_EQUAL(MCL_OK, store_wal_replay(store_wal, _replay_callback, MCL_NULL));
+    TEST_ASSERT_EQUAL(MCL_OK, store_wal_append(store_wal, 0, MCL_NULL, meta, (const mcl_uint8_t *)"[1]", 3, &record));
+    TEST_ASSERT_EQUAL(MCL_OK, store_wal_acknowledge(record));
+    store_wal_record_destroy(&record);
+    TEST_ASSERT_EQUAL(MCL_OK, store_wal_append(store_wal, 0, MCL_NULL, meta, (const mcl_uint8_t *)"[22]", 4, &record));
+    store_wal_record_destroy(&record);
+    TEST_ASSERT_EQUAL(MCL_OK, store_wal_trim(store_wal));
+    string_destroy(&meta);
+    store_wal_destroy(&store_wal);
+
+    TEST_ASSERT_EQUAL(MCL_OK, store_wal_initialize(".", &store_wal));
+    TEST_ASSERT_EQUAL(MCL_OK, store_wal_replay(store_wal, _replay_callback, MCL_NULL));
+
+    TEST_ASSERT_EQUAL_MESSAGE(1, replayed_count, "Acknowledged record is replayed.");
+    TEST_ASSERT_EQUAL(4, replayed_records[0]->payload_size);
+}
+
+/**
+ * GIVEN : Write-ahead log with two store data.
+ * WHEN  : First store data is acknowledged and the agent stops without trimming the log.
+ * THEN  : Only the second store data is replayed after a restart.
+ */
+void test_acknowledge_002(void)
+{
+#if defined(WIN32) || defined(WIN64)
+    TEST_IGNORE_MESSAGE("Write-ahead log acknowledgement test needs fork().");
+#else
+    pid_t pid;
+    int status = -1;
+
+    TEST_ASSERT_NOT_NULL_RETURN(store_wal);
+    TEST_ASSERT_EQUAL(MCL_OK, store_wal_replay(store_wal, _replay_callback, MCL_NULL));
+
+    pid = fork();
+    TEST_ASSERT_TRUE(0 <= pid);
+
+    if (0 == pid)
+    {
+        string_t *meta = MCL_NULL;
+        store_wal_record_t *record_1 = MCL_NULL;
+        store_wal_record_t *record_2 = MCL_NULL;
+        E_MCL_ERROR_CODE code = string_initialize_static("{}", 0, &meta);
+
+        (MCL_OK == code) && (code = store_wal_append(store_wal, 0, MCL_NULL, meta, (const mcl_uint8_t *)"[1]", 3, &record_1));
+        (MCL_OK == code) && (code = store_wal_append(store_wal, 0, MCL_NULL, meta, (const mcl_uint8_t *)"[22]", 4, &record_2));
+        (MCL_OK == code) && (code = store_wal_acknowledge(record_1));
+
+        // Exit without flushing any stream as if the agent is stopped.
+        _exit((MCL_OK == code) ? 0 : 1);
+    }
+
+    waitpid(pid, &status, 0);
+    TEST_ASSERT_TRUE(WIFEXITED(status) && (0 == WEXITSTATUS(status)));
+
+    store_wal_destroy(&store_wal);
+    TEST_ASSERT_EQUAL(MCL_OK, store_wal_initialize(".", &store_wal));
+    TEST_ASSERT_EQUAL(MCL_OK, store_wal_replay(store_wal, _replay_callback, MCL_NULL));
+
+    TEST_ASSERT_EQUAL_MESSAGE(1, replayed_count, "Acknowledgement is not written before the log is trimmed.");
+    TEST_ASSERT_EQUAL(4, replayed_records[0]->payload_size);
+#endif
+}
+
+/**
+ * GIVEN : Write-ahead log with a store data replayed from a previous run.
+ * WHEN  : The store data is acknowledged and the log is trimmed.
+ * THEN  : Segment of the store data is removed and the log is empty after a restart.
+ */
+void test_trim_001(void)
+{
+    string_t *meta = MCL_NULL;
+    store_wal_record_t *record = MCL_NULL;
+
+    TEST_ASSERT_NOT_NULL_RETURN(store_wal);
+
+    string_initialize_static("{}", 0, &meta);
+
+    TEST_ASSERT_EQUAL(MCL_OK, store_wal_replay(store_wal, _replay_callback, MCL_NULL));
+    TEST_ASSERT_EQUAL(MCL_OK, store_wal_append(store_wal, 0, MCL_NULL, meta, (const mcl_uint8_t *)"[1]", 3, &record));
+    store_wal_record_destroy(&record);
+    string_destroy(&meta);
+    store_wal_destroy(&store_wal);
+
+    TEST_ASSERT_EQUAL(MCL_OK, store_wal_initialize(".", &store_wal));
+    TEST_ASSERT_EQUAL(MCL_OK, store_wal_replay(store_wal, _replay_callback, MCL_NULL));
+    TEST_ASSERT_EQUAL(1, replayed_count);
+
+    TEST_ASSERT_EQUAL(MCL_OK, store_wal_acknowledge(replayed_records[0]));
+    TEST_ASSERT_EQUAL(MCL_OK, store_wal_trim(store_wal));
+    TEST_ASSERT_FALSE_MESSAGE(_file_exists("./mcl_store_0.wal"), "Acknowledged segment is not removed.");
+    TEST_ASSERT_EQUAL(1, store_wal->segment_count);
+
+    _clear_replayed_records();
+    store_wal_destroy(&store_wal);
+
+    TEST_ASSERT_EQUAL(MCL_OK, store_wal_initialize(".", &store_wal));
+    TEST_ASSERT_EQUAL(MCL_OK, store_wal_replay(store_wal, _replay_callback, MCL_NULL));
+    TEST_ASSERT_EQUAL_MESSAGE(0, replayed_count, "Acknowledged record is replayed.");
+    TEST_ASSERT_EQUAL_MESSAGE(0, store_wal->segment_count, "Segment without pending data is not removed.");
+}
+
+static E_MCL_ERROR_CODE _replay_callback(store_wal_record_t *record, string_t *meta, void *user_context)
+{
+    TEST_ASSERT_TRUE(REPLAYED_RECORD_MAX_COUNT > replayed_count);
+
+    replayed_records[replayed_count] = record;
+    replayed_metas[replayed_count] = meta;
+    replayed_count++;
+
+    return MCL_OK;
+}
+
+static void _clear_replayed_records(void)
+{
+    mcl_size_t index;
+
+    for (index = 0; index < replayed_count; index++)
+    {
+        store_wal_record_destroy(&replayed_records[index]);
+        string_destroy(&replayed_metas[index]);
+    }
+    replayed_count = 0;
+}
+
+static mcl_bool_t _file_exists(const char *file_name)
+{
+    void *file_descriptor = MCL_NULL;
+    mcl_bool_t exists = (MCL_OK == file_util_fopen_without_log(file_name, "rb", &file_descriptor)) ? MCL_TRUE : MCL_FALSE;
+
+    file_util_fclose(file_descriptor);
+    return exists;
+}
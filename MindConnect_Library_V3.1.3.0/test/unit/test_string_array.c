@@ -544,3 +544,53 @@ void test_to_string_003(void)
     string_array_destroy(&array);
     string_destroy(&final_string);
 }
+
+/**
+ * GIVEN : User requests initialization of an string_array for 2 strings and adds 3 strings.
+ * WHEN  : User truncates the array to 1 string and adds another string.
+ * THEN  : User expects the array keeps its memory and holds the first and the last strings.
+ */
+void test_truncate_001(void)
+{
+    string_array_t *array;
+
+    mcl_size_t count = 2;
+    E_MCL_ERROR_CODE result = string_array_initialize(count, &array);
+    TEST_ASSERT_MESSAGE(MCL_OK == result, "MCL_OK expected as return code!");
+
+    string_t *s1, *s2, *s3, *s4;
+    string_initialize_new("firstpart", 0, &s1);
+    string_initialize_new("secondpart", 0, &s2);
+    string_initialize_new("thirdpart", 0, &s3);
+    string_initialize_new("fourthpart", 0, &s4);
+
+    result = string_array_add(array, s1, MCL_FALSE);
+    TEST_ASSERT_MESSAGE(MCL_OK == result, "MCL_OK expected as return code!");
+
+    result = string_array_add(array, s2, MCL_TRUE);
+    TEST_ASSERT_MESSAGE(MCL_OK == result, "MCL_OK expected as return code!");
+
+    result = string_array_add(array, s3, MCL_TRUE);
+    TEST_ASSERT_MESSAGE(MCL_OK == result, "MCL_OK expected as return code!");
+
+    mcl_size_t array_count = array->count;
+    string_array_truncate(array, 1);
+
+    TEST_ASSERT_EQUAL_INT(1, array->index);
+    TEST_ASSERT_EQUAL_INT(array_count, array->count);
+    TEST_ASSERT_EQUAL_INT(s1->length, array->total_length);
+
+    result = string_array_add(array, s4, MCL_TRUE);
+    TEST_ASSERT_MESSAGE(MCL_OK == result, "MCL_OK expected as return code!");
+    TEST_ASSERT_EQUAL_INT(array_count, array->count);
+
+    string_t *final_string = string_array_to_string(array);
+    TEST_ASSERT_NOT_NULL(final_string);
+    TEST_ASSERT_EQUAL_STRING("firstpartfourthpart", final_string->buffer);
+
+    string_array_destroy(&array);
+    string_destroy(&final_string);
+
+    TEST_ASSERT_EQUAL_STRING("firstpart", s1->buffer);
+	string_destroy(&s1);
+}
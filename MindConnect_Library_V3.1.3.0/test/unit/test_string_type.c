@@ -1519,3 +1519,69 @@ void test_replace_001()
 
     string_destroy(&result);
 }
+
+/**
+ * GIVEN : One short and one long string object are successfully initialized.
+ * WHEN  : User requests to detach the buffers of the strings.
+ * THEN  : User expects the buffers with the content of the strings and the string handles are NULL.
+ */
+void test_detach_001(void)
+{
+    const char *long_value = "0123456789012345678901234567890123456789012345678901234567890123456789";
+    string_t *string = MCL_NULL;
+    string_t *long_string = MCL_NULL;
+    char *buffer = MCL_NULL;
+    char *long_buffer = MCL_NULL;
+    char *long_string_buffer;
+
+    string_initialize_new("test", 0, &string);
+    string_initialize_new(long_value, 0, &long_string);
+    long_string_buffer = long_string->buffer;
+
+    TEST_ASSERT_EQUAL_INT_MESSAGE(MCL_OK, string_detach(&string, &buffer), "Short string could not be detached.");
+    TEST_ASSERT_EQUAL_INT_MESSAGE(MCL_OK, string_detach(&long_string, &long_buffer), "Long string could not be detached.");
+
+    TEST_ASSERT_NULL_MESSAGE(string, "String handle is not NULL after detach.");
+    TEST_ASSERT_NULL_MESSAGE(long_string, "Long string handle is not NULL after detach.");
+    TEST_ASSERT_EQUAL_STRING_MESSAGE("test", buffer, "Detached buffer doesn't have the right content!");
+    TEST_ASSERT_EQUAL_STRING_MESSAGE(long_value, long_buffer, "Detached long buffer doesn't have the right content!");
+    TEST_ASSERT_EQUAL_PTR_MESSAGE(long_string_buffer, long_buffer, "Buffer of long string is copied while detaching.");
+
+    MCL_FREE(buffer);
+    MCL_FREE(long_buffer);
+}
+
+/**
+ * GIVEN : Strings are initialized with values of different lengths.
+ * WHEN  : Strings are set to values of different lengths.
+ * THEN  : Short contents are stored inside the string handle, long contents in a buffer of their own.
+ */
+void test_inline_buffer_001(void)
+{
+    const char *guid = "e50ab7ca-fd5d-11e5-8000-001b1bc10000";
+    const char *long_value = "0123456789012345678901234567890123456789012345678901234567890123456789";
+    string_t *string = MCL_NULL;
+    string_t *copy = MCL_NULL;
+
+    string_initialize_new(guid, 0, &string);
+    TEST_ASSERT_EQUAL_PTR_MESSAGE(string->inline_buffer, string->buffer, "GUID is not stored inline.");
+    TEST_ASSERT_EQUAL_STRING_MESSAGE(guid, string->buffer, "Inline buffer doesn't have the right content!");
+
+    string_initialize(string, &copy);
+    TEST_ASSERT_EQUAL_PTR_MESSAGE(copy->inline_buffer, copy->buffer, "Copy of GUID is not stored inline.");
+    TEST_ASSERT_EQUAL_STRING_MESSAGE(guid, copy->buffer, "Copy doesn't have the right content!");
+
+    string_set(string, long_value, 0);
+    TEST_ASSERT_NOT_EQUAL_MESSAGE(string->inline_buffer, string->buffer, "Long value is stored inline.");
+    TEST_ASSERT_EQUAL_STRING_MESSAGE(long_value, string->buffer, "Buffer doesn't have the right content!");
+
+    string_set(string, "1000", 0);
+    TEST_ASSERT_EQUAL_PTR_MESSAGE(string->inline_buffer, string->buffer, "Short value is not stored inline after long value.");
+    TEST_ASSERT_EQUAL_INT_MESSAGE(4, string->length, "Length of short value is wrong!");
+
+    string_release(string);
+    TEST_ASSERT_NULL_MESSAGE(string->buffer, "After release string->buffer is not NULL");
+
+    string_destroy(&copy);
+    string_destroy(&string);
+}
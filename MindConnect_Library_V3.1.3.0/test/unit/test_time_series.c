@@ -26,9 +26,11 @@
 #include "security.h"
 #include "security_libcrypto.h"
 #include "time_util.h"
+#include "intern_table.h"
 
 mcl_time_series_t *time_series;
 mcl_time_series_value_set_t *value_set;
+intern_table_t *intern_table;
 
 E_MCL_ERROR_CODE code;
 
@@ -47,13 +49,17 @@ char *routing = "vnd.kuka.FingerprintAnalizer";
 
 void setUp(void)
 {
-    E_MCL_ERROR_CODE return_code = time_series_initialize(payload_version, configuration_id, routing, &time_series);
+    E_MCL_ERROR_CODE return_code = intern_table_initialize(&intern_table);
+    TEST_ASSERT_MESSAGE(MCL_OK == return_code, "Initialization failed for intern_table.");
+
+    return_code = time_series_initialize(payload_version, configuration_id, routing, intern_table, &time_series);
     TEST_ASSERT_MESSAGE(MCL_OK == return_code, "Initialization failed for time_series.");
 }
 
 void tearDown(void)
 {
     time_series_destroy(&time_series);
+    intern_table_destroy(&intern_table);
 }
 
 /**
@@ -143,11 +149,11 @@ void test_add_value_001(void)
     code = mcl_time_series_add_value(value_set, data_point_id, value, quality_code);
     TEST_ASSERT_MESSAGE(MCL_OK == code, "Adding value failed.");
 
-    time_series_value_t *value_local = (time_series_value_t *)((time_series_value_set_t *)time_series->payload.value_sets->current->data)->values->current->data;
-
-    TEST_ASSERT_EQUAL_STRING_MESSAGE(data_point_id, value_local->data_point_id->buffer, "data_point_id fail");
-    TEST_ASSERT_EQUAL_STRING_MESSAGE(value, value_local->value->buffer, "value fail");
-    TEST_ASSERT_EQUAL_STRING_MESSAGE(quality_code, value_local->quality_code->buffer, "quality_code fail");
+    TEST_ASSERT_EQUAL_INT_MESSAGE(1, value_set->value_count, "value_count fail");
+    TEST_ASSERT_EQUAL_INT_MESSAGE(TIME_SERIES_VALUE_TYPE_STRING, value_set->value_types[0], "value type fail");
+    TEST_ASSERT_EQUAL_STRING_MESSAGE(data_point_id, intern_table_get(intern_table, value_set->data_point_ids[0])->buffer, "data_point_id fail");
+    TEST_ASSERT_EQUAL_STRING_MESSAGE(value, value_set->string_pool + value_set->values[0].string_offset, "value fail");
+    TEST_ASSERT_EQUAL_STRING_MESSAGE(quality_code, value_set->string_pool + value_set->quality_codes[0], "quality_code fail");
 }
 
 /**
@@ -189,24 +195,174 @@ void test_add_value_003(void)
     code = mcl_time_series_add_value(value_set, data_point_id_2, value_2, quality_code_2);
     TEST_ASSERT_MESSAGE(MCL_OK == code, "Adding value failed.");
 
-    list_t *values = ((time_series_value_set_t *)time_series->payload.value_sets->current->data)->values;
-    list_reset(values);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(2, value_set->value_count, "value_count fail");
+
+    // First value.
+    TEST_ASSERT_EQUAL_STRING_MESSAGE(data_point_id, intern_table_get(intern_table, value_set->data_point_ids[0])->buffer, "data_point_id fail");
+    TEST_ASSERT_EQUAL_STRING_MESSAGE(value, value_set->string_pool + value_set->values[0].string_offset, "value fail");
+    TEST_ASSERT_EQUAL_STRING_MESSAGE(quality_code, value_set->string_pool + value_set->quality_codes[0], "quality_code fail");
+
+    // Second value.
+    TEST_ASSERT_EQUAL_STRING_MESSAGE(data_point_id_2, intern_table_get(intern_table, value_set->data_point_ids[1])->buffer, "data_point_id fail");
+    TEST_ASSERT_EQUAL_STRING_MESSAGE(value_2, value_set->string_pool + value_set->values[1].string_offset, "value fail");
+    TEST_ASSERT_EQUAL_STRING_MESSAGE(quality_code_2, value_set->string_pool + value_set->quality_codes[1], "quality_code fail");
+}
+
+/**
+ * GIVEN : Initialized time_series.
+ * WHEN  : More values than the initial column capacity are added.
+ * THEN  : Columns grow and all values are kept in order.
+ */
+void test_add_value_004(void)
+{
+    char data_point_id_buffer[16];
+    mcl_size_t index;
+
+    TEST_ASSERT_NOT_NULL_RETURN(time_series);
+
+    code = mcl_time_series_new_value_set(time_series, timestamp, &value_set);
+    TEST_ASSERT_MESSAGE(MCL_OK == code, "New payload failed.");
+
+    for (index = 0; index < 4 * DEFAULT_VALUES_COUNT; index++)
+    {
+        string_util_snprintf(data_point_id_buffer, sizeof(data_point_id_buffer), "%u", (unsigned int)index);
+        code = mcl_time_series_add_int64(value_set, data_point_id_buffer, (mcl_int64_t)index, quality_code);
+        TEST_ASSERT_MESSAGE(MCL_OK == code, "Adding value failed.");
+    }
+
+    TEST_ASSERT_EQUAL_INT_MESSAGE(4 * DEFAULT_VALUES_COUNT, value_set->value_count, "value_count fail");
+
+    for (index = 0; index < 4 * DEFAULT_VALUES_COUNT; index++)
+    {
+        string_util_snprintf(data_point_id_buffer, sizeof(data_point_id_buffer), "%u", (unsigned int)index);
+        TEST_ASSERT_EQUAL_STRING_MESSAGE(data_point_id_buffer, intern_table_get(intern_table, value_set->data_point_ids[index])->buffer, "data_point_id fail");
+        TEST_ASSERT_MESSAGE((mcl_int64_t)index == value_set->values[index].int64_value, "value fail");
+        TEST_ASSERT_EQUAL_STRING_MESSAGE(quality_code, value_set->string_pool + value_set->quality_codes[index], "quality_code fail");
+    }
+}
+
+/**
+ * GIVEN : Initialized time_series.
+ * WHEN  : User adds a double, an int64 and a bool value.
+ * THEN  : Values are stored with their types without being converted to string.
+ */
+void test_add_typed_value_001(void)
+{
+    TEST_ASSERT_NOT_NULL_RETURN(time_series);
 
-    // Get the first node.
-    time_series_value_t *value_local = (time_series_value_t *)(values->current->data);
+    code = mcl_time_series_new_value_set(time_series, timestamp, &value_set);
+    TEST_ASSERT_MESSAGE(MCL_OK == code, "New payload failed.");
 
-    // First value node.
-    TEST_ASSERT_EQUAL_STRING_MESSAGE(data_point_id, value_local->data_point_id->buffer, "data_point_id fail");
-    TEST_ASSERT_EQUAL_STRING_MESSAGE(value, value_local->value->buffer, "value fail");
-    TEST_ASSERT_EQUAL_STRING_MESSAGE(quality_code, value_local->quality_code->buffer, "quality_code fail");
+    code = mcl_time_series_add_double(value_set, data_point_id, 12.5, quality_code);
+    TEST_ASSERT_MESSAGE(MCL_OK == code, "Adding double value failed.");
 
-    // Get the second node.
-    value_local = ((time_series_value_t *)(list_next(values)->data));
+    code = mcl_time_series_add_int64(value_set, data_point_id, -9000000000LL, quality_code);
+    TEST_ASSERT_MESSAGE(MCL_OK == code, "Adding int64 value failed.");
 
-    // Second value node.
-    TEST_ASSERT_EQUAL_STRING_MESSAGE(data_point_id_2, value_local->data_point_id->buffer, "data_point_id fail");
-    TEST_ASSERT_EQUAL_STRING_MESSAGE(value_2, value_local->value->buffer, "value fail");
-    TEST_ASSERT_EQUAL_STRING_MESSAGE(quality_code_2, value_local->quality_code->buffer, "quality_code fail");
+    code = mcl_time_series_add_bool(value_set, data_point_id, MCL_TRUE, quality_code);
+    TEST_ASSERT_MESSAGE(MCL_OK == code, "Adding bool value failed.");
+
+    TEST_ASSERT_EQUAL_INT_MESSAGE(3, value_set->value_count, "value_count fail");
+    TEST_ASSERT_EQUAL_INT_MESSAGE(TIME_SERIES_VALUE_TYPE_DOUBLE, value_set->value_types[0], "double type fail");
+    TEST_ASSERT_MESSAGE(12.5 == value_set->values[0].double_value, "double value fail");
+    TEST_ASSERT_EQUAL_INT_MESSAGE(TIME_SERIES_VALUE_TYPE_INT64, value_set->value_types[1], "int64 type fail");
+    TEST_ASSERT_MESSAGE(-9000000000LL == value_set->values[1].int64_value, "int64 value fail");
+    TEST_ASSERT_EQUAL_INT_MESSAGE(TIME_SERIES_VALUE_TYPE_BOOL, value_set->value_types[2], "bool type fail");
+    TEST_ASSERT_EQUAL_INT_MESSAGE(MCL_TRUE, value_set->values[2].bool_value, "bool value fail");
+}
+
+/**
+ * GIVEN : Initialized time_series.
+ * WHEN  : User adds a double value which is not a finite number.
+ * THEN  : MCL_INVALID_PARAMETER is returned and the value is not added.
+ */
+void test_add_typed_value_002(void)
+{
+    volatile double zero = 0.0;
+
+    TEST_ASSERT_NOT_NULL_RETURN(time_series);
+
+    code = mcl_time_series_new_value_set(time_series, timestamp, &value_set);
+    TEST_ASSERT_MESSAGE(MCL_OK == code, "New payload failed.");
+
+    code = mcl_time_series_add_double(value_set, data_point_id, zero / zero, quality_code);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(MCL_INVALID_PARAMETER, code, "NaN should have been rejected.");
+
+    code = mcl_time_series_add_double(value_set, data_point_id, 1.0 / zero, quality_code);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(MCL_INVALID_PARAMETER, code, "Infinity should have been rejected.");
+
+    TEST_ASSERT_EQUAL_INT_MESSAGE(0, value_set->value_count, "value_count fail");
+}
+
+/**
+ * GIVEN : Initialized time_series.
+ * WHEN  : User adds a frame of values at once.
+ * THEN  : A new value set is created with all values of the frame in order.
+ */
+void test_add_frame_001(void)
+{
+    const char *data_point_ids[] = {data_point_id, "id_2", "id_3"};
+    const char *values[] = {value, "66", "67"};
+    const char *quality_codes[] = {quality_code, "1", "2"};
+    mcl_size_t index;
+
+    TEST_ASSERT_NOT_NULL_RETURN(time_series);
+
+    code = mcl_time_series_add_frame(time_series, timestamp, 3, data_point_ids, values, quality_codes, &value_set);
+    TEST_ASSERT_MESSAGE(MCL_OK == code, "Adding frame failed.");
+
+    TEST_ASSERT_EQUAL_INT_MESSAGE(1, time_series->payload.value_sets->count, "Value set count fail");
+    TEST_ASSERT_EQUAL_STRING_MESSAGE(timestamp, value_set->timestamp->buffer, "timestamp fail");
+    TEST_ASSERT_EQUAL_INT_MESSAGE(3, value_set->value_count, "value_count fail");
+
+    for (index = 0; index < 3; index++)
+    {
+        TEST_ASSERT_EQUAL_STRING_MESSAGE(data_point_ids[index], intern_table_get(intern_table, value_set->data_point_ids[index])->buffer, "data_point_id fail");
+        TEST_ASSERT_EQUAL_STRING_MESSAGE(values[index], value_set->string_pool + value_set->values[index].string_offset, "value fail");
+        TEST_ASSERT_EQUAL_STRING_MESSAGE(quality_codes[index], value_set->string_pool + value_set->quality_codes[index], "quality_code fail");
+    }
+}
+
+/**
+ * GIVEN : Initialized time_series.
+ * WHEN  : User adds a frame with a NULL value.
+ * THEN  : MCL_TRIGGERED_WITH_NULL is returned and no value set is added.
+ */
+void test_add_frame_002(void)
+{
+    const char *data_point_ids[] = {data_point_id, "id_2"};
+    const char *values[] = {value, MCL_NULL};
+    const char *quality_codes[] = {quality_code, "1"};
+
+    TEST_ASSERT_NOT_NULL_RETURN(time_series);
+
+    code = mcl_time_series_add_frame(time_series, timestamp, 2, data_point_ids, values, quality_codes, &value_set);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(MCL_TRIGGERED_WITH_NULL, code, "NULL value should have been detected.");
+    TEST_ASSERT_EQUAL_INT_MESSAGE(0, time_series->payload.value_sets->count, "No value set should have been added.");
+}
+
+/**
+ * GIVEN : Initialized time_series.
+ * WHEN  : The same data point id is added in different value sets.
+ * THEN  : Data point id is interned once and all values refer to the same id.
+ */
+void test_add_value_005(void)
+{
+    mcl_time_series_value_set_t *value_set_2;
+
+    TEST_ASSERT_NOT_NULL_RETURN(time_series);
+
+    code = mcl_time_series_new_value_set(time_series, timestamp, &value_set);
+    (MCL_OK == code) && (code = mcl_time_series_add_value(value_set, data_point_id, value, quality_code));
+    (MCL_OK == code) && (code = mcl_time_series_new_value_set(time_series, timestamp, &value_set_2));
+    (MCL_OK == code) && (code = mcl_time_series_add_value(value_set_2, data_point_id, value_2, quality_code_2));
+    TEST_ASSERT_MESSAGE(MCL_OK == code, "Adding values failed.");
+
+    // Configuration id and data point id are interned.
+    TEST_ASSERT_EQUAL_INT_MESSAGE(2, intern_table->count, "Interned string count fail");
+    TEST_ASSERT_EQUAL_INT_MESSAGE(value_set->data_point_ids[0], value_set_2->data_point_ids[0], "Data point id is not shared.");
+    TEST_ASSERT_EQUAL_PTR_MESSAGE(intern_table_get(intern_table, 0)->buffer, time_series->meta.payload.details.time_series_details.configuration_id->buffer,
+                                  "Configuration id is not interned.");
 }
 
 /**
@@ -230,9 +386,7 @@ void test_destroy_001(void)
     code = mcl_time_series_add_value(value_set, data_point_id_2, value_2, quality_code_2);
     TEST_ASSERT_MESSAGE(MCL_OK == code, "Adding value failed.");
 
-    list_t *values = ((time_series_value_set_t *)time_series->payload.value_sets->current->data)->values;
-
-    TEST_ASSERT_EQUAL_INT_MESSAGE(2, values->count, "Count of values list is not as expected!");
+    TEST_ASSERT_EQUAL_INT_MESSAGE(2, value_set->value_count, "Count of values is not as expected!");
 
     time_series_destroy(&time_series);
 